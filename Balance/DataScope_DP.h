@@ -1,18 +1,18 @@
   /**************************************************************************
-ߣƽС֮
-ҵԱС꣺http://shop114407458.taobao.com/
+作者：平衡小车之家
+我的淘宝小店：http://shop114407458.taobao.com/
 **************************************************************************/
 
 #ifndef __DATA_PRTOCOL_H
 #define __DATA_PRTOCOL_H
  
  
-extern unsigned char DataScope_OutPut_Buffer[42];	   //֡ݻ
+extern unsigned char DataScope_OutPut_Buffer[42];	   //待发送帧数据缓存区
 
 
-void DataScope_Get_Channel_Data(float Data,unsigned char Channel);    // дͨ ֡ݻ
+void DataScope_Get_Channel_Data(float Data,unsigned char Channel);    // 写通道数据至 待发送帧数据缓存区
 
-unsigned char DataScope_Data_Generate(unsigned char Channel_Number);  // ֡ɺ 
+unsigned char DataScope_Data_Generate(unsigned char Channel_Number);  // 发送帧数据生成函数 
  
  
 #endif 
@@ -0,0 +1,533 @@
+#include "autotune.h"
+#include "balance.h"
+#include "formation_control.h"
+#include "yaw_control.h"
+#include "fast_math.h"
+#include "mode_manager.h"
+#include "uwb.h"
+#include <math.h>
+#include "float_only.h"
+
+#define AUTOTUNE_TICKS(ms) ((uint32_t)(ms) * CONTROL_FREQUENCY / 1000)
+
+//Controller types of the rule table //规则表中的控制器类型
+#define RULE_P   0
+#define RULE_PI  1
+#define RULE_PD  2
+
+Autotune_t Autotune;
+
+//Inner loop with the freshly identified rate gains, used by the outer relay
+//使用新辨识角速度参数的内环，供外环继电实验使用
+static Yaw_Cascade_t Autotune_Yaw = YAW_CASCADE_DEFAULT;
+
+//Kp/Ku and Ti/Tu or Td/Tu of each rule: P, PI, PD
+//各规则的Kp/Ku及Ti/Tu或Td/Tu：P，PI，PD
+static const float Rule_Table[3][5] =
+{
+	{ 0.50f, 0.45f,   0.833f, 0.80f,   0.125f },   //Ziegler-Nichols
+	{ 0.31f, 0.3125f, 2.20f,  0.3125f, 0.159f },   //Tyreus-Luyben
+	{ 0.20f, 0.20f,   0.50f,  0.20f,   0.333f },   //No overshoot //无超调
+};
+
+//Phase programs, the yaw loop is identified inside out
+//各回路的阶段流程，航向回路由内向外辨识
+static const uint8_t Sequence_Single[] = { AUTOTUNE_PAUSE, AUTOTUNE_STEP_BEFORE, AUTOTUNE_PAUSE, AUTOTUNE_RELAY,
+                                           AUTOTUNE_PAUSE, AUTOTUNE_STEP_AFTER, AUTOTUNE_DONE };
+static const uint8_t Sequence_Yaw[]    = { AUTOTUNE_PAUSE, AUTOTUNE_STEP_BEFORE, AUTOTUNE_PAUSE, AUTOTUNE_RELAY,
+                                           AUTOTUNE_PAUSE, AUTOTUNE_RELAY_OUTER, AUTOTUNE_PAUSE, AUTOTUNE_STEP_AFTER,
+                                           AUTOTUNE_DONE };
+
+static const char *Loop_Name[4]    = { "", "wheel", "yaw", "position" };
+static const char *Rule_Name[3]    = { "ZN", "TL", "no-overshoot" };
+static const char *Gain_Name[4][3] =
+{
+	{ "", "", "" },
+	{ "Velocity_KP", "Velocity_KI", "" },
+	{ "Rate_Kp", "Rate_Ki", "Angle_Kp" },
+	{ "Pos_KP", "Formation_KP", "Formation_KD" },
+};
+
+static float Autotune_Limit(float value, float limit)
+{
+	if(value > limit)  return limit;
+	if(value < -limit) return -limit;
+	return value;
+}
+
+static void Autotune_Print(const char *text)
+{
+	usart1_send_cstring(text);
+}
+
+//Gains of the loop being tuned, in Gain_Name order //被整定回路的参数，顺序同Gain_Name
+static void Autotune_Read_Gains(float *gain)
+{
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			gain[0] = Velocity_KP;
+			gain[1] = Velocity_KI;
+			break;
+		case AUTOTUNE_LOOP_YAW:
+			gain[0] = Mode_Manager.Auto_Yaw.Rate_Kp;
+			gain[1] = Mode_Manager.Auto_Yaw.Rate_Ki;
+			gain[2] = Mode_Manager.Auto_Yaw.Angle_Kp;
+			break;
+		default:
+			gain[0] = Pos_KP;
+			gain[1] = Formation_KP;
+			gain[2] = Formation_KD;
+			break;
+	}
+}
+
+//All gains of a loop change in the same instant, no task sees a mixed set
+//同一回路的所有参数同时更新，任何任务都不会看到新旧混合的参数
+static void Autotune_Write_Gains(const float *gain)
+{
+	taskENTER_CRITICAL();
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			Velocity_KP = gain[0];
+			Velocity_KI = gain[1];
+			break;
+		case AUTOTUNE_LOOP_YAW:
+			Mode_Manager.Auto_Yaw.Rate_Kp  = Mode_Manager.Formation_Yaw.Rate_Kp = gain[0];
+			Mode_Manager.Auto_Yaw.Rate_Ki  = Mode_Manager.Formation_Yaw.Rate_Ki = gain[1];
+			Mode_Manager.Auto_Yaw.Angle_Kp = Formation_Yaw_KP                   = gain[2];
+			break;
+		default:
+			Pos_KP       = gain[0];
+			Formation_KP = gain[1];
+			Formation_KD = gain[2];
+			break;
+	}
+	taskEXIT_CRITICAL();
+}
+
+//Gain and time constant of a rule, time in s //按规则计算增益和时间常数，时间单位为秒
+static float Autotune_Rule(uint8_t type, float *time)
+{
+	const float *row = Rule_Table[Autotune.Rule];
+
+	if(type == RULE_P) { *time = 0; return row[0] * Autotune.Ku; }
+	if(type == RULE_PI) { *time = row[2] * Autotune.Tu; return row[1] * Autotune.Ku; }
+	*time = row[4] * Autotune.Tu;
+	return row[3] * Autotune.Ku;
+}
+
+//Measured output of the current phase, relative to the phase origin
+//当前阶段的被控量，相对于阶段起点
+static float Autotune_Measure(void)
+{
+	float dx, dy, s, c;
+
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			return (MOTOR_A.Encoder + MOTOR_B.Encoder + MOTOR_C.Encoder + MOTOR_D.Encoder) * 0.25f;
+		case AUTOTUNE_LOOP_YAW:
+			if(Autotune.Phase == AUTOTUNE_RELAY) return Yaw_Rate;
+			return Fast_Wrap180(Yaw - Autotune.Origin_Yaw);
+		default:
+			//Displacement along the heading at the start of the phase //沿阶段起始航向的位移
+			dx = position[0] - Autotune.Origin_X;
+			dy = position[1] - Autotune.Origin_Y;
+			Fast_Sincosf(Autotune.Origin_Yaw * FAST_DEG2RAD, &s, &c);
+			return dx * c + dy * s;
+	}
+}
+
+/**************************************************************************
+Function: Finish a run, restore the old gains if the new ones were not confirmed
+Input   : reason: NULL when the run completed, otherwise the abort reason
+Output  : none
+函数功能：结束整定，未完成时恢复原参数
+入口参数：reason：正常完成为NULL，否则为中止原因
+返回  值：无
+**************************************************************************/
+static void Autotune_Finish(const char *reason)
+{
+	char msg[128];
+	uint8_t i;
+
+	if(reason)
+	{
+		if(Autotune.Applied) Autotune_Write_Gains(Autotune.Old_Gain);
+		snprintf(msg, sizeof(msg), "[TUNE] %s aborted: %s, gains unchanged\r\n", Loop_Name[Autotune.Loop], reason);
+		Autotune_Print(msg);
+	}
+	else
+	{
+		for(i = 0; i < Autotune.Gain_Count; i++)
+		{
+			snprintf(msg, sizeof(msg), "[TUNE] %s %.4f -> %.4f\r\n",
+			         Gain_Name[Autotune.Loop][i], (double)Autotune.Old_Gain[i], (double)Autotune.New_Gain[i]);
+			Autotune_Print(msg);
+		}
+		snprintf(msg, sizeof(msg), "[TUNE] step rise %.0fms -> %.0fms, overshoot %.1f%% -> %.1f%%\r\n",
+		         (double)Autotune.Before.Rise_ms, (double)Autotune.After.Rise_ms,
+		         (double)Autotune.Before.Overshoot, (double)Autotune.After.Overshoot);
+		Autotune_Print(msg);
+	}
+	Autotune.Phase = AUTOTUNE_IDLE;
+	Autotune.Applied = 0;
+	Drive_Motor(0, 0, 0);
+}
+
+//Start a phase from the current state //以当前状态开始一个阶段
+static void Autotune_Enter(uint8_t phase)
+{
+	float sign = (phase == AUTOTUNE_STEP_AFTER) ? -1.0f : 1.0f;
+
+	Autotune.Phase = phase;
+	Autotune.Tick = 0;
+	Autotune.Origin_Yaw = Yaw;
+	Autotune.Origin_X = position[0];
+	Autotune.Origin_Y = position[1];
+
+	switch(phase)
+	{
+		case AUTOTUNE_STEP_AFTER:
+			//The return step runs with the new gains //回程阶跃使用新参数
+			Autotune_Write_Gains(Autotune.New_Gain);
+			Autotune.Applied = 1;
+			//fall through
+		case AUTOTUNE_STEP_BEFORE:
+			if(Autotune.Loop == AUTOTUNE_LOOP_WHEEL)    Autotune.Step_Size = sign * AUTOTUNE_WHEEL_STEP;
+			else if(Autotune.Loop == AUTOTUNE_LOOP_YAW) Autotune.Step_Size = sign * AUTOTUNE_ANGLE_STEP;
+			else                                        Autotune.Step_Size = sign * AUTOTUNE_POS_STEP;
+			Autotune.Step_Peak = 0;
+			Autotune.T10 = Autotune.T90 = 0;
+			break;
+		case AUTOTUNE_RELAY:
+		case AUTOTUNE_RELAY_OUTER:
+			if(Autotune.Loop == AUTOTUNE_LOOP_WHEEL)
+			{
+				Autotune.Relay_Amp = AUTOTUNE_WHEEL_RELAY;
+				Autotune.Relay_Hyst = AUTOTUNE_WHEEL_HYST;
+			}
+			else if(Autotune.Loop == AUTOTUNE_LOOP_POSITION)
+			{
+				Autotune.Relay_Amp = AUTOTUNE_POS_RELAY;
+				Autotune.Relay_Hyst = AUTOTUNE_POS_HYST;
+			}
+			else if(phase == AUTOTUNE_RELAY)
+			{
+				Autotune.Relay_Amp = AUTOTUNE_RATE_RELAY;
+				Autotune.Relay_Hyst = AUTOTUNE_RATE_HYST;
+			}
+			else
+			{
+				//Outer relay drives the inner loop already tuned //外环继电器驱动已整定的内环
+				Autotune.Relay_Amp = AUTOTUNE_ANGLE_RELAY;
+				Autotune.Relay_Hyst = AUTOTUNE_ANGLE_HYST;
+				Autotune_Yaw = Mode_Manager.Auto_Yaw;
+				Autotune_Yaw.Rate_Kp = Autotune.New_Gain[0];
+				Autotune_Yaw.Rate_Ki = Autotune.New_Gain[1];
+				Yaw_Cascade_Reset(&Autotune_Yaw);
+			}
+			Autotune.Relay_Out = Autotune.Relay_Amp;
+			Autotune.Err_Max = -1e9f;
+			Autotune.Err_Min = 1e9f;
+			Autotune.Last_Rise = 0;
+			Autotune.Cycles = 0;
+			Autotune.Period_Sum = Autotune.Amp_Sum = 0;
+			break;
+		case AUTOTUNE_DONE:
+			Autotune_Finish(NULL);
+			break;
+		default:
+			break;
+	}
+}
+
+static void Autotune_Next(void)
+{
+	const uint8_t *sequence = (Autotune.Loop == AUTOTUNE_LOOP_YAW) ? Sequence_Yaw : Sequence_Single;
+
+	Autotune.Phase_Index++;
+	Autotune_Enter(sequence[Autotune.Phase_Index]);
+}
+
+//Relay with hysteresis on the error, returns 1 once enough cycles are averaged
+//带滞环的继电器，平均足够的振荡周期后返回1
+static uint8_t Autotune_Relay(float error)
+{
+	if(error > Autotune.Err_Max) Autotune.Err_Max = error;
+	if(error < Autotune.Err_Min) Autotune.Err_Min = error;
+
+	if(error < -Autotune.Relay_Hyst && Autotune.Relay_Out > 0)
+	{
+		Autotune.Relay_Out = -Autotune.Relay_Amp;
+	}
+	else if(error > Autotune.Relay_Hyst && Autotune.Relay_Out < 0)
+	{
+		//One full oscillation between two switches to +d //两次切换到+d之间为一个完整振荡周期
+		Autotune.Relay_Out = Autotune.Relay_Amp;
+		if(Autotune.Last_Rise)
+		{
+			Autotune.Cycles++;
+			if(Autotune.Cycles > AUTOTUNE_RELAY_SKIP)
+			{
+				Autotune.Period_Sum += (float)(Autotune.Tick - Autotune.Last_Rise);
+				Autotune.Amp_Sum += (Autotune.Err_Max - Autotune.Err_Min) * 0.5f;
+			}
+		}
+		Autotune.Last_Rise = Autotune.Tick;
+		Autotune.Err_Max = -1e9f;
+		Autotune.Err_Min = 1e9f;
+	}
+	return Autotune.Cycles >= AUTOTUNE_RELAY_SKIP + AUTOTUNE_RELAY_CYCLES;
+}
+
+//Ultimate gain and period from the averaged oscillation, 0 if it is unusable
+//由平均振荡求临界增益和临界周期，振荡不可用时返回0
+static uint8_t Autotune_Identify(void)
+{
+	char msg[96];
+	float a = Autotune.Amp_Sum / AUTOTUNE_RELAY_CYCLES;
+	float h = Autotune.Relay_Hyst;
+
+	if(a <= h * 1.05f) return 0;
+	Autotune.Ku = 4.0f * Autotune.Relay_Amp / (FAST_PI * Fast_Sqrtf(a * a - h * h));
+	Autotune.Tu = Autotune.Period_Sum / AUTOTUNE_RELAY_CYCLES / CONTROL_FREQUENCY;
+	snprintf(msg, sizeof(msg), "[TUNE] %s relay: a=%.4f Ku=%.4f Tu=%.3fs\r\n",
+	         Loop_Name[Autotune.Loop], (double)a, (double)Autotune.Ku, (double)Autotune.Tu);
+	Autotune_Print(msg);
+	return 1;
+}
+
+//Gains from the identification just finished //由刚完成的辨识计算参数
+static void Autotune_Compute(void)
+{
+	float kp, t;
+
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			//Incremental PI: Ki per tick = Kp*Ts/Ti //增量式PI：每周期Ki = Kp*Ts/Ti
+			kp = Autotune_Rule(RULE_PI, &t);
+			Autotune.New_Gain[0] = kp;
+			Autotune.New_Gain[1] = kp / (t * CONTROL_FREQUENCY);
+			break;
+		case AUTOTUNE_LOOP_YAW:
+			if(Autotune.Phase == AUTOTUNE_RELAY)
+			{
+				//Rate_Ki integrates over seconds //Rate_Ki按秒积分
+				kp = Autotune_Rule(RULE_PI, &t);
+				Autotune.New_Gain[0] = kp;
+				Autotune.New_Gain[1] = kp / t;
+			}
+			else Autotune.New_Gain[2] = Autotune_Rule(RULE_P, &t);
+			break;
+		default:
+			Autotune.New_Gain[0] = Autotune_Rule(RULE_P, &t);
+			//Formation_KD multiplies the error change per tick //Formation_KD乘以每周期的误差变化量
+			kp = Autotune_Rule(RULE_PD, &t);
+			Autotune.New_Gain[1] = kp;
+			Autotune.New_Gain[2] = kp * t * CONTROL_FREQUENCY;
+			break;
+	}
+}
+
+//Rise time and overshoot bookkeeping of a step //阶跃的上升时间与超调统计
+static void Autotune_Step_Track(float y)
+{
+	float p = y / Autotune.Step_Size;
+
+	if(p > Autotune.Step_Peak) Autotune.Step_Peak = p;
+	if(!Autotune.T10 && p >= 0.1f) Autotune.T10 = Autotune.Tick;
+	if(!Autotune.T90 && p >= 0.9f) Autotune.T90 = Autotune.Tick;
+}
+
+static void Autotune_Step_Result(Autotune_Step_t *r)
+{
+	r->Rise_ms = (Autotune.T10 && Autotune.T90) ? (Autotune.T90 - Autotune.T10) * 1000.0f / CONTROL_FREQUENCY : -1.0f;
+	r->Overshoot = Autotune.Step_Peak > 1.0f ? (Autotune.Step_Peak - 1.0f) * 100.0f : 0.0f;
+}
+
+//Command of a step phase //阶跃阶段的指令
+static void Autotune_Step_Drive(float y)
+{
+	float vx;
+
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			//Straight to the wheel loops, no chassis smoothing //直接送入车轮速度环，不经过车体平滑
+			MOTOR_A.Target = MOTOR_B.Target = MOTOR_C.Target = MOTOR_D.Target = Autotune.Step_Size;
+			break;
+		case AUTOTUNE_LOOP_YAW:
+			Drive_Motor(0, 0, Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, Yaw,
+			            Fast_Wrap180(Autotune.Origin_Yaw + Autotune.Step_Size)));
+			break;
+		default:
+			vx = Autotune_Limit(Pos_KP * (Autotune.Step_Size - y), max_linear_speed);
+			Drive_Motor(vx, 0, Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, Yaw, Autotune.Origin_Yaw));
+			break;
+	}
+}
+
+//Command of a relay phase //继电阶段的指令
+static void Autotune_Relay_Drive(void)
+{
+	switch(Autotune.Loop)
+	{
+		case AUTOTUNE_LOOP_WHEEL:
+			//PWM is written by Autotune_Pwm_Override //PWM由Autotune_Pwm_Override写入
+			MOTOR_A.Target = MOTOR_B.Target = MOTOR_C.Target = MOTOR_D.Target = 0;
+			break;
+		case AUTOTUNE_LOOP_YAW:
+			if(Autotune.Phase == AUTOTUNE_RELAY) Drive_Motor(0, 0, Autotune.Relay_Out);
+			else Drive_Motor(0, 0, Yaw_Cascade_Rate(&Autotune_Yaw, Autotune.Relay_Out));
+			break;
+		default:
+			Drive_Motor(Autotune.Relay_Out, 0, Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, Yaw, Autotune.Origin_Yaw));
+			break;
+	}
+}
+
+//1 when the measurement left the safe range of the loop //被控量超出安全范围时返回1
+static uint8_t Autotune_Out_Of_Range(float y)
+{
+	if(Autotune.Loop == AUTOTUNE_LOOP_WHEEL) return fabsf(y) > AUTOTUNE_WHEEL_LIMIT;
+	if(Autotune.Loop == AUTOTUNE_LOOP_POSITION) return fabsf(y) > AUTOTUNE_POS_LIMIT;
+	if(Autotune.Phase == AUTOTUNE_RELAY) return 0;
+	return fabsf(y) > AUTOTUNE_ANGLE_LIMIT;
+}
+
+/**************************************************************************
+Function: Ask for a tuning run, safe to call from an interrupt
+Input   : loop: AUTOTUNE_LOOP_xxx, 0 aborts; rule: AUTOTUNE_RULE_xxx
+Output  : none
+函数功能：请求一次自整定，可在中断中调用
+入口参数：loop：AUTOTUNE_LOOP_xxx，0为中止；rule：AUTOTUNE_RULE_xxx
+返回  值：无
+**************************************************************************/
+void Autotune_Request(uint8_t loop, uint8_t rule)
+{
+	if(loop == 0) { Autotune_Abort(); return; }
+	Autotune.Request_Loop = loop;
+	Autotune.Request_Rule = rule;
+	Autotune.Request = AUTOTUNE_REQ_START;
+}
+
+void Autotune_Abort(void)
+{
+	Autotune.Request = AUTOTUNE_REQ_ABORT;
+}
+
+/**************************************************************************
+Function: 1 while a run is pending or in progress, the mode manager gives it priority
+Input   : none
+Output  : 1: active
+函数功能：整定请求待处理或正在进行时返回1，模式管理器优先执行
+入口参数：无
+返回  值：1：运行中
+**************************************************************************/
+uint8_t Autotune_Active(void)
+{
+	return Autotune.Phase != AUTOTUNE_IDLE || Autotune.Request == AUTOTUNE_REQ_START;
+}
+
+/**************************************************************************
+Function: Drive the wheels straight from the relay, called by Balance_task instead of the wheel PI
+Input   : none
+Output  : 1: PWM written, skip the wheel PI this cycle
+函数功能：由继电器直接驱动车轮，Balance_task在速度PI之前调用
+入口参数：无
+返回  值：1：PWM已写入，本周期跳过速度PI
+**************************************************************************/
+uint8_t Autotune_Pwm_Override(void)
+{
+	if(Autotune.Loop != AUTOTUNE_LOOP_WHEEL || Autotune.Phase != AUTOTUNE_RELAY) return 0;
+	MOTOR_A.Motor_Pwm = MOTOR_B.Motor_Pwm = MOTOR_C.Motor_Pwm = MOTOR_D.Motor_Pwm = (int)Autotune.Relay_Out;
+	return 1;
+}
+
+/**************************************************************************
+Function: Run the tuning state machine, called by the mode manager once per Balance_task cycle
+Input   : none
+Output  : none
+函数功能：运行自整定状态机，由模式管理器在每个Balance_task周期调用一次
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Autotune_Run(void)
+{
+	uint8_t request = Autotune.Request;
+	float y;
+
+	Autotune.Request = AUTOTUNE_REQ_NONE;
+	if(request == AUTOTUNE_REQ_ABORT && Autotune.Phase != AUTOTUNE_IDLE) { Autotune_Finish("stopped from the APP"); return; }
+	if(request == AUTOTUNE_REQ_START && Autotune.Phase == AUTOTUNE_IDLE)
+	{
+		if(Autotune.Request_Loop < AUTOTUNE_LOOP_WHEEL || Autotune.Request_Loop > AUTOTUNE_LOOP_POSITION ||
+		   Autotune.Request_Rule > AUTOTUNE_RULE_NO_OVERSHOOT)
+		{
+			Autotune_Print("[TUNE] unknown loop or rule\r\n");
+			Drive_Motor(0, 0, 0);
+			return;
+		}
+		Autotune.Loop = Autotune.Request_Loop;
+		Autotune.Rule = Autotune.Request_Rule;
+		Autotune.Gain_Count = (Autotune.Loop == AUTOTUNE_LOOP_WHEEL) ? 2 : 3;
+		Autotune.Applied = 0;
+		Autotune_Read_Gains(Autotune.Old_Gain);
+		Autotune_Read_Gains(Autotune.New_Gain);
+		Autotune.Phase_Index = 0;
+		Autotune_Enter(AUTOTUNE_PAUSE);
+		{
+			char msg[64];
+			snprintf(msg, sizeof(msg), "[TUNE] %s loop, rule %s\r\n", Loop_Name[Autotune.Loop], Rule_Name[Autotune.Rule]);
+			Autotune_Print(msg);
+		}
+	}
+	if(Autotune.Phase == AUTOTUNE_IDLE) { Drive_Motor(0, 0, 0); return; }
+
+	//A relay on a disabled drive measures nothing //驱动关闭时继电实验没有意义
+	if(EN == 0 || Voltage <= 10) { Autotune_Finish("motors disabled"); return; }
+	//The position loop measures with the UWB fix, a frozen fix reads as a car that does not move
+	//位置环用UWB定位测量，定位停止更新时读数相当于小车不动
+	if(Autotune.Loop == AUTOTUNE_LOOP_POSITION && Uwb.Stale) { Autotune_Finish("UWB fix stale"); return; }
+
+	Autotune.Tick++;
+	y = Autotune_Measure();
+	if(Autotune.Phase != AUTOTUNE_PAUSE && Autotune_Out_Of_Range(y)) { Autotune_Finish("out of range"); return; }
+
+	switch(Autotune.Phase)
+	{
+		case AUTOTUNE_PAUSE:
+			Drive_Motor(0, 0, 0);
+			if(Autotune.Tick >= AUTOTUNE_TICKS(AUTOTUNE_PAUSE_MS)) Autotune_Next();
+			break;
+
+		case AUTOTUNE_STEP_BEFORE:
+		case AUTOTUNE_STEP_AFTER:
+			Autotune_Step_Track(y);
+			Autotune_Step_Drive(y);
+			if(Autotune.Tick >= AUTOTUNE_TICKS(Autotune.Loop == AUTOTUNE_LOOP_WHEEL ? AUTOTUNE_WHEEL_STEP_MS :
+			                                   Autotune.Loop == AUTOTUNE_LOOP_YAW ? AUTOTUNE_ANGLE_STEP_MS : AUTOTUNE_POS_STEP_MS))
+			{
+				Autotune_Step_Result(Autotune.Phase == AUTOTUNE_STEP_BEFORE ? &Autotune.Before : &Autotune.After);
+				Autotune_Next();
+			}
+			break;
+
+		case AUTOTUNE_RELAY:
+		case AUTOTUNE_RELAY_OUTER:
+			if(Autotune_Relay(-y))
+			{
+				if(!Autotune_Identify()) { Autotune_Finish("no usable oscillation"); return; }
+				Autotune_Compute();
+				Autotune_Next();
+				break;
+			}
+			if(Autotune.Tick >= AUTOTUNE_TICKS(AUTOTUNE_RELAY_TIMEOUT_MS)) { Autotune_Finish("relay timeout"); return; }
+			Autotune_Relay_Drive();
+			break;
+	}
+}
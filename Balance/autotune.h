@@ -0,0 +1,107 @@
+#ifndef __AUTOTUNE_H
+#define __AUTOTUNE_H
+#include <stdint.h>
+
+//Relay feedback (Astrom-Hagglund) autotuner. Each run measures a step with
+//the current gains, finds the ultimate gain Ku and period Tu of the loop
+//with a relay, computes new gains with the selected rule, applies them all
+//at once and measures the same step again. Started from the APP with {3:LR},
+//L = loop, R = rule, {3:0} aborts.
+//继电反馈(Astrom-Hagglund)自整定。每次运行先用当前参数做阶跃测试，再用继电器测出回路的
+//临界增益Ku和临界周期Tu，按所选规则计算新参数并一次性应用，然后重复同样的阶跃测试。
+//由APP发送{3:LR}启动，L为回路，R为规则，{3:0}中止
+
+//Loops //回路
+#define AUTOTUNE_LOOP_WHEEL       1       //Velocity_KP/KI of the four wheel PI loops //四轮速度PI的Velocity_KP/KI
+#define AUTOTUNE_LOOP_YAW         2       //Rate PI then angle P of the heading controllers //航向控制器的角速度PI和角度P
+#define AUTOTUNE_LOOP_POSITION    3       //Pos_KP and Formation_KP/KD //Pos_KP和Formation_KP/KD
+
+//Tuning rules //整定规则
+#define AUTOTUNE_RULE_ZN          0       //Ziegler-Nichols, fastest //Ziegler-Nichols，响应最快
+#define AUTOTUNE_RULE_TL          1       //Tyreus-Luyben, more damping //Tyreus-Luyben，阻尼更大
+#define AUTOTUNE_RULE_NO_OVERSHOOT 2      //Ziegler-Nichols no overshoot variant //Ziegler-Nichols无超调变体
+
+//Phases //阶段
+#define AUTOTUNE_IDLE             0
+#define AUTOTUNE_STEP_BEFORE      1
+#define AUTOTUNE_PAUSE            2
+#define AUTOTUNE_RELAY            3
+#define AUTOTUNE_RELAY_OUTER      4
+#define AUTOTUNE_STEP_AFTER       5
+#define AUTOTUNE_DONE             6
+
+//Requests from the APP //APP请求
+#define AUTOTUNE_REQ_NONE         0
+#define AUTOTUNE_REQ_START        1
+#define AUTOTUNE_REQ_ABORT        2
+
+//Relay and step sizes per loop //各回路的继电幅值与阶跃大小
+#define AUTOTUNE_WHEEL_RELAY      400.0f  //PWM
+#define AUTOTUNE_WHEEL_HYST       0.01f   //m/s
+#define AUTOTUNE_WHEEL_STEP       0.2f    //m/s
+#define AUTOTUNE_WHEEL_STEP_MS    1500
+#define AUTOTUNE_WHEEL_LIMIT      1.0f    //Abort above this wheel speed, m/s //车轮速度超过该值时中止，m/s
+#define AUTOTUNE_RATE_RELAY       0.4f    //Vz, rad/s
+#define AUTOTUNE_RATE_HYST        2.0f    //degree/s
+#define AUTOTUNE_ANGLE_RELAY      20.0f   //Rate setpoint, degree/s //角速度设定值，度/秒
+#define AUTOTUNE_ANGLE_HYST       1.0f    //degree
+#define AUTOTUNE_ANGLE_STEP       30.0f   //degree
+#define AUTOTUNE_ANGLE_STEP_MS    3000
+#define AUTOTUNE_POS_RELAY        0.1f    //m/s
+#define AUTOTUNE_POS_HYST         0.02f   //m
+#define AUTOTUNE_POS_STEP         0.3f    //m
+#define AUTOTUNE_POS_STEP_MS      6000
+
+#define AUTOTUNE_PAUSE_MS         1000    //Standstill between phases //各阶段之间的静止时间
+#define AUTOTUNE_RELAY_SKIP       2       //Oscillations ignored while the relay settles //继电器稳定前忽略的振荡周期数
+#define AUTOTUNE_RELAY_CYCLES     3       //Oscillations averaged //取平均的振荡周期数
+#define AUTOTUNE_RELAY_TIMEOUT_MS 20000
+#define AUTOTUNE_ANGLE_LIMIT      90.0f   //Abort when the heading wanders further, degree //航向偏离超过该值时中止，度
+#define AUTOTUNE_POS_LIMIT        0.5f    //Abort when the car wanders further, m //位置偏离超过该值时中止，m
+
+//Step response figures //阶跃响应指标
+typedef struct
+{
+	float Rise_ms;                //10% to 90%, -1 if never reached //10%到90%的时间，未达到为-1
+	float Overshoot;              //Percent of the step //占阶跃幅值的百分比
+}Autotune_Step_t;
+
+typedef struct
+{
+	volatile uint8_t Request;     //AUTOTUNE_REQ_xxx, written by the USART2 interrupt //AUTOTUNE_REQ_xxx，由串口2中断写入
+	uint8_t  Request_Loop, Request_Rule;
+	uint8_t  Loop, Rule;
+	uint8_t  Phase, Phase_Index;
+	uint8_t  Applied;             //1: the new gains are in use //1：新参数已生效
+	uint32_t Tick;                //Ticks in the current phase //当前阶段的周期数
+
+	//Relay state //继电器状态
+	float    Relay_Out, Relay_Amp, Relay_Hyst;
+	float    Err_Max, Err_Min;
+	uint32_t Last_Rise;
+	uint8_t  Cycles;
+	float    Period_Sum, Amp_Sum;
+	float    Ku, Tu;              //Last identification, Tu in s //最近一次辨识结果，Tu单位为秒
+
+	//Step state //阶跃状态
+	float    Step_Size, Step_Peak;
+	uint32_t T10, T90;
+	Autotune_Step_t Before, After;
+
+	//Origin of the phase //阶段起点
+	float    Origin_Yaw, Origin_X, Origin_Y;
+
+	//Gains //参数
+	uint8_t  Gain_Count;
+	float    Old_Gain[4], New_Gain[4];
+}Autotune_t;
+
+extern Autotune_t Autotune;
+
+void Autotune_Request(uint8_t loop, uint8_t rule);
+void Autotune_Abort(void);
+void Autotune_Run(void);
+uint8_t Autotune_Active(void);
+uint8_t Autotune_Pwm_Override(void);
+
+#endif
@@ -1,18 +1,37 @@
 #include "balance.h"
-#include "formation_control.h"  // ӱӿͷļ
-
-int Time_count=0; //Time variable //ʱ
+#include "formation_control.h"  // 添加编队控制头文件
+#include "stream_filter.h"
+#include "yaw_control.h"
+#include "mode_manager.h"
+#include "wheel_sync.h"
+#include "autotune.h"
+#include "collision_avoid.h"
+#include "robot_snapshot.h"
+#include "app_parser.h"
+#include "host_link.h"
+#include "uwb.h"
+#include "lidar.h"
+#include "fast_math.h"
+#include "float_only.h"
+
+int Time_count=0; //Time variable //计时变量
 uint8_t Auto_mode = 1;
-Encoder OriginalEncoder; //Encoder raw data //ԭʼ
+Encoder OriginalEncoder; //Encoder raw data //编码器原始数据
+
+float Pos_KP = 0.5f;                    // 位置控制比例系数，需要调整
+float max_linear_speed = 0.3f;          // 最大线速度 m/s
+float position_tolerance = 0.05f;       // 5cm容差
+uint8_t position_reached = 0;           // 位置到达标志
 
-float Pos_KP = 0.5f;                    // λÿƱϵҪ
-float max_linear_speed = 0.3f;          // ٶ m/s
-float position_tolerance = 0.05f;       // 5cmݲ
-uint8_t position_reached = 0;           // λõ־
+float Current_Vx = 0.0f;      // X轴方向速度 (m/s) - 前向为正
+float Current_Vy = 0.0f;      // Y轴方向速度 (m/s) - 左向为正  
+float Current_Vz = 0.0f;      // Z轴旋转角速度 (rad/s) - 逆时针为正
 
-float Current_Vx = 0.0f;      // X᷽ٶ (m/s) - ǰΪ
-float Current_Vy = 0.0f;      // Y᷽ٶ (m/s) - Ϊ  
-float Current_Vz = 0.0f;      // Zתٶ (rad/s) - ʱΪ
+// 车体速度一阶低通，新样本权重0.3，从0开始
+#define VELOCITY_FILTER_ALPHA 0.3f
+static Filter_EMA_t Velocity_Filter[3] = {
+    { VELOCITY_FILTER_ALPHA, 0.0f, 1 }, { VELOCITY_FILTER_ALPHA, 0.0f, 1 }, { VELOCITY_FILTER_ALPHA, 0.0f, 1 }
+};
 
 
 
@@ -20,33 +39,41 @@ float Current_Vz = 0.0f;      // Z
 Function: The inverse kinematics solution is used to calculate the target speed of each wheel according to the target speed of three axes
 Input   : X and Y, Z axis direction of the target movement speed
 Output  : none
-ܣ˶ѧ⣬ĿٶȼĿת
-ڲXYZ᷽Ŀ˶ٶ
-  ֵ
+函数功能：运动学逆解，根据三轴目标速度计算各车轮目标转速
+入口参数：X和Y、Z轴方向的目标运动速度
+返回  值：无
 **************************************************************************/
 void Drive_Motor(float Vx,float Vy,float Vz)
 {
-		float amplitude=3.5; //Wheel target speed limit //Ŀٶ޷
+		float amplitude=3.5; //Wheel target speed limit //车轮目标速度限幅
+		
+	        //Ramp from the previous mode's command after a mode switch
+	        //模式切换后从上一模式的指令平滑过渡
+			Mode_Blend_Command(&Vx,&Vy,&Vz);
+
+	        //Automatic modes keep clear of the other cars, remote control and the autotuner are left alone
+	        //自动模式避让其他小车，遥控和自整定不做修改
+			if(Mode_Runs_Orca()) Collision_Avoid_Command(&Vx,&Vy);
         
 	        //Speed smoothing is enabled when moving the omnidirectional trolley
-	        //ȫƶСſٶƽ
-			Smooth_control(Vx,Vy,Vz); //Smoothing the input speed //ٶȽƽ
+	        //全向移动小车才开启速度平滑处理
+			Smooth_control(Vx,Vy,Vz); //Smoothing the input speed //对输入速度进行平滑处理
   
             //Get the smoothed data 
-			//ȡƽ			
+			//获取平滑处理后的数据			
 			Vx=smooth_control.VX;     
 			Vy=smooth_control.VY;
 			Vz=smooth_control.VZ;
 		
 			//Mecanum wheel car
-			//ķС
-			//Inverse kinematics //˶ѧ
+			//麦克纳姆轮小车
+			//Inverse kinematics //运动学逆解
 			MOTOR_A.Target   = +Vy+Vx-Vz*(Axle_spacing+Wheel_spacing);
 			MOTOR_B.Target   = -Vy+Vx-Vz*(Axle_spacing+Wheel_spacing);
 			MOTOR_C.Target   = +Vy+Vx+Vz*(Axle_spacing+Wheel_spacing);
 			MOTOR_D.Target   = -Vy+Vx+Vz*(Axle_spacing+Wheel_spacing);
 		
-			//Wheel (motor) target speed limit //()Ŀٶ޷
+			//Wheel (motor) target speed limit //车轮(电机)目标速度限幅
 			MOTOR_A.Target=target_limit_float(MOTOR_A.Target,-amplitude,amplitude); 
 			MOTOR_B.Target=target_limit_float(MOTOR_B.Target,-amplitude,amplitude); 
 			MOTOR_C.Target=target_limit_float(MOTOR_C.Target,-amplitude,amplitude); 
@@ -57,28 +84,28 @@ void Drive_Motor(float Vx,float Vy,float Vz)
 
 
 /**************************************************************************
-Function: Сٶȣ˶ѧ⣩
-Input   : 
-Output  : 
-ܣĸӵٶȼС˶ٶ
+Function: 计算小车整体速度（运动学正解）
+Input   : 无
+Output  : 无
+函数功能：根据四个轮子的速度计算小车的整体运动速度
 **************************************************************************/
 void Calculate_Car_Velocity(void)
 {
-    float v1 = MOTOR_A.Encoder;  // 
-    float v2 = MOTOR_B.Encoder;  // ǰ  
-    float v3 = MOTOR_C.Encoder;  // ǰ
-    float v4 = MOTOR_D.Encoder;  // 
+    float v1 = MOTOR_A.Encoder;  // 后左
+    float v2 = MOTOR_B.Encoder;  // 前左  
+    float v3 = MOTOR_C.Encoder;  // 前右
+    float v4 = MOTOR_D.Encoder;  // 后右
     
     float L = (Axle_spacing + Wheel_spacing) / 2.0f;
     
-    // ˶ѧƵ˶ѧ
-    // ˶ѧ
+    // 从逆运动学推导正运动学：
+    // 逆运动学矩阵：
     // [v1]   [ 1  1 -L] [Vx]
     // [v2] = [ 1 -1 -L] [Vy]
     // [v3]   [ 1  1  L] [Vz]
     // [v4]   [ 1 -1  L]
     
-    // ˶ѧԷ飩
+    // 正运动学（解这个线性方程组）：
     Current_Vx = (v1 + v2 + v3 + v4) / 4.0f;
     Current_Vy = (v1 - v2 + v3 - v4) / 4.0f;
     
@@ -88,25 +115,18 @@ void Calculate_Car_Velocity(void)
         Current_Vz = 0.0f;
     }
     
-    // ˲
-    static float filtered_Vx = 0.0f, filtered_Vy = 0.0f, filtered_Vz = 0.0f;
-    float filter_factor = 0.7f;
+    // 滤波处理：一阶低通，新样本权重0.3
+    Current_Vx = Filter_EMA_Update(&Velocity_Filter[0], Current_Vx);
+    Current_Vy = Filter_EMA_Update(&Velocity_Filter[1], Current_Vy);
+    Current_Vz = Filter_EMA_Update(&Velocity_Filter[2], Current_Vz);
     
-    filtered_Vx = filtered_Vx * filter_factor + Current_Vx * (1.0f - filter_factor);
-    filtered_Vy = filtered_Vy * filter_factor + Current_Vy * (1.0f - filter_factor);  
-    filtered_Vz = filtered_Vz * filter_factor + Current_Vz * (1.0f - filter_factor);
-    
-    Current_Vx = filtered_Vx; 
-    Current_Vy = filtered_Vy;
-    Current_Vz = filtered_Vz;
-    
-    // // ֤ȷ
+    // // 调试输出，验证计算正确性
     // static uint32_t debug_count = 0;
     // debug_count++;
     // if (debug_count % 200 == 0) {
     //     char debug_msg[256];
     //     snprintf(debug_msg, sizeof(debug_msg), 
-    //              "[ٶȼ] :%.3f,%.3f,%.3f,%.3f -> :Vx=%.3f,Vy=%.3f,Vz=%.3f\r\n",
+    //              "[速度计算] 轮速:%.3f,%.3f,%.3f,%.3f -> 车体:Vx=%.3f,Vy=%.3f,Vz=%.3f\r\n",
     //              v1, v2, v3, v4, Current_Vx, Current_Vy, Current_Vz);
     //     usart1_send_cstring(debug_msg);
     // }
@@ -115,84 +135,104 @@ void Calculate_Car_Velocity(void)
 Function: FreerTOS task, core motion control task
 Input   : none
 Output  : none
-ܣFreeRTOS񣬺˶
-ڲ
-  ֵ
+函数功能：FreeRTOS任务，核心运动控制任务
+入口参数：无
+返回  值：无
 **************************************************************************/
-//  Balance_task ޸ģʽл߼
+// 在 Balance_task 函数中修改模式切换逻辑
 void Balance_task(void *pvParameters)
 { 
+#if FAST_MATH_BENCHMARK
+    // 启动时测量一次快速数学函数的耗时和误差，结果输出到串口1
+    Fast_Math_Benchmark();
+#endif
+    // 蓝牙APP指令由解析任务解码，本任务每周期开始时执行
+    App_Parser_Start();
+    // 上位机二进制链路（SEND_DATA/RECEIVE_DATA帧，DMA收发）
+    Host_Link_Init();
+    // UWB定位改为DMA空闲线接收，由UWB任务解析和检查
+    Uwb_Init();
+    // 雷达改为UART4循环DMA接收，由雷达任务分帧校验
+    Lidar_Init();
+
     u32 lastWakeTime = getSysTickCnt();
     static uint32_t control_debug_count = 0;
     static uint32_t last_other_cars_print = 0;
     
     while(1)
     {	
-        // 100HzƵУ10msһΣ
+        // 此任务以100Hz的频率运行（10ms控制一次）
         vTaskDelayUntil(&lastWakeTime, F2T(RATE_100_HZ)); 
 
-        // ʱ
+        // 时间计数
         if(Time_count<40000) Time_count++;
 
-        // ȡ
+        // 获取编码器数据
         Get_Velocity_Form_Encoder();           		
 
-        // ÿ10ӡһСϢ
+        // 每10秒打印一次其他小车信息
         uint32_t current_time = HAL_GetTick();
         if (control_debug_count % 100 == 0) {
             Print_Other_Cars_Info();
             last_other_cars_print = current_time;
         }
 
-        // µĿ߼ģʽȼ
+        // 执行解析任务送来的APP指令（目标点、遥控按键、参数）
+        App_Command_Poll();
+        // 读取上位机速度指令帧
+        Host_Link_Poll();
+        // 取最新的UWB定位，本周期内position[]不再改变
+        Uwb_Position_Poll();
+
+        // 控制逻辑由模式管理器执行：编队跟随/一致性编队 > 自动 > 遥控 > 停车，
+        // 切换模式时初始化新模式的控制器并平滑过渡速度指令
+        Mode_Manager_Run();
+        
         if(Formation_mode > 0) {
-            // ģʽȣǷԶңģʽ
-            Formation_Control();
-            
-            // Ϣ
+            // 调试信息
             static uint32_t formation_debug_count = 0;
             formation_debug_count++;
             if(formation_debug_count % 200 == 0) {
                 char debug_msg[256];
                 if(Formation_mode == FORMATION_MODE_LEADER) {
                     snprintf(debug_msg, sizeof(debug_msg), 
-                             "[] 캽ģʽ - λ(%.2f,%.2f) %.1f\r\n", 
-                             position[0], position[1], Yaw);
+                             "[编队] 领航者模式 - 位置(%.2f,%.2f) 航向%.1f°\r\n", 
+                             (double)position[0], (double)position[1], (double)Yaw);
                 } else if(Formation_mode == FORMATION_MODE_FOLLOWER) {
                     snprintf(debug_msg, sizeof(debug_msg), 
-                             "[] ģʽ - Ŀ(%.2f,%.2f,%.1f) ǰλ(%.2f,%.2f,%.1f)\r\n", 
-                             Target_position[0], Target_position[1], Target_Yaw,
-                             position[0], position[1], Yaw);
+                             "[编队] 跟随者模式 - 目标(%.2f,%.2f,%.1f) 当前位置(%.2f,%.2f,%.1f)\r\n", 
+                             (double)Target_position[0], (double)Target_position[1], (double)Target_Yaw,
+                             (double)position[0], (double)position[1], (double)Yaw);
+                } else {
+                    snprintf(debug_msg, sizeof(debug_msg), 
+                             "[编队] 一致性模式 - 邻居%d 当前位置(%.2f,%.2f,%.1f)\r\n", 
+                             Mode_Manager.Consensus.Neighbours, (double)position[0], (double)position[1], (double)Yaw);
                 }
                 usart1_send_cstring(debug_msg);
             }
         }
-        else if(Auto_mode && newCoordinateReceived) {
-            // ԭеԶλÿƣǱģʽ
-            Auto_Adjust_Position_And_Yaw();
-        }
-        else if(APP_ON_Flag) {
-            // ֶңģʽǱģʽ
-            Get_RC();
-            newCoordinateReceived = 0;
-            position_reached = 0;
-        }
-        else {
-            // ޿ָֹͣС
-            Drive_Motor(0, 0, 0);
-        }
         
         
         if((Voltage>10)&&(EN==1)) 
         { 			
-            // ٶȱջƼPWMֵ
-            MOTOR_A.Motor_Pwm=Incremental_PI_A(MOTOR_A.Encoder, MOTOR_A.Target);
-            MOTOR_B.Motor_Pwm=Incremental_PI_B(MOTOR_B.Encoder, MOTOR_B.Target);
-            MOTOR_C.Motor_Pwm=Incremental_PI_C(MOTOR_C.Encoder, MOTOR_C.Target);
-            MOTOR_D.Motor_Pwm=Incremental_PI_D(MOTOR_D.Encoder, MOTOR_D.Target);
+            // 自整定的车轮继电实验直接给定PWM，跳过交叉耦合和速度PI
+            if(!Autotune_Pwm_Override())
+            {
+            // 四轮交叉耦合：某个车轮滞后或打滑导致车体偏航/侧移时，在本周期内把修正量分配到四个车轮
+            float wheel_target[4]   = { MOTOR_A.Target, MOTOR_B.Target, MOTOR_C.Target, MOTOR_D.Target };
+            float wheel_measured[4] = { MOTOR_A.Encoder, MOTOR_B.Encoder, MOTOR_C.Encoder, MOTOR_D.Encoder };
+            Wheel_Sync_Update(&Wheel_Sync, wheel_target, wheel_measured, Yaw_Rate,
+                              Axle_spacing + Wheel_spacing, 1.0f / CONTROL_FREQUENCY);
+            
+            // 速度闭环控制计算各电机PWM值
+            MOTOR_A.Motor_Pwm=Incremental_PI_A(MOTOR_A.Encoder, MOTOR_A.Target + Wheel_Sync.Correction[0]);
+            MOTOR_B.Motor_Pwm=Incremental_PI_B(MOTOR_B.Encoder, MOTOR_B.Target + Wheel_Sync.Correction[1]);
+            MOTOR_C.Motor_Pwm=Incremental_PI_C(MOTOR_C.Encoder, MOTOR_C.Target + Wheel_Sync.Correction[2]);
+            MOTOR_D.Motor_Pwm=Incremental_PI_D(MOTOR_D.Encoder, MOTOR_D.Target + Wheel_Sync.Correction[3]);
+            }
             Limit_Pwm(1500);
             
-            // PWM
+            // 设置PWM
             switch(Car_Mode)
             {
                 case Mec_Car: Set_Pwm(MOTOR_A.Motor_Pwm, -MOTOR_B.Motor_Pwm, MOTOR_C.Motor_Pwm, -MOTOR_D.Motor_Pwm, 0); break;
@@ -202,6 +242,13 @@ void Balance_task(void *pvParameters)
         {
             Set_Pwm(0,0,0,0,0); 
         }
+
+        // 发布本周期状态，供显示和APP数据任务整体读取
+        Robot_Snapshot_Publish();
+        // 记录本周期位姿，供雷达数据包按采集时刻插值
+        Lidar_Pose_Push();
+        // 向上位机发送本周期状态帧
+        Host_Link_Send();
         
         control_debug_count++;
     }
@@ -210,30 +257,30 @@ void Balance_task(void *pvParameters)
 Function: Assign a value to the PWM register to control wheel speed and direction
 Input   : PWM
 Output  : none
-ܣֵPWMĴƳת뷽
-ڲPWM
-  ֵ
+函数功能：赋值给PWM寄存器，控制车轮转速与方向
+入口参数：PWM
+返回  值：无
 **************************************************************************/
 void Set_Pwm(int motor_a,int motor_b,int motor_c,int motor_d,int servo)
 {
 	//Forward and reverse control of motor
-	//ת
+	//电机正反转控制
 	if(motor_a<0)			PWMA1=1599,PWMA2=1599+motor_a;
 	else 	            PWMA2=1599,PWMA1=1599-motor_a;
 	
 	//Forward and reverse control of motor
-	//ת	
+	//电机正反转控制	
 	if(motor_b<0)			PWMB1=1599,PWMB2=1599+motor_b;
 	else 	            PWMB2=1599,PWMB1=1599-motor_b;
 //  PWMB1=10000,PWMB2=5000;
 
 	//Forward and reverse control of motor
-	//ת	
+	//电机正反转控制	
 	if(motor_c<0)			PWMC1=1599,PWMC2=1599+motor_c;
 	else 	            PWMC2=1599,PWMC1=1599-motor_c;
 	
 	//Forward and reverse control of motor
-	//ת
+	//电机正反转控制
 	if(motor_d<0)			PWMD1=1599,PWMD2=1599+motor_d;
 	else 	            PWMD2=1599,PWMD1=1599-motor_d;
 
@@ -244,9 +291,9 @@ void Set_Pwm(int motor_a,int motor_b,int motor_c,int motor_d,int servo)
 Function: Limit PWM value
 Input   : Value
 Output  : none
-ܣPWMֵ 
-ڲֵ
-  ֵ
+函数功能：限制PWM值 
+入口参数：幅值
+返回  值：无
 **************************************************************************/
 void Limit_Pwm(int amplitude)
 {	
@@ -259,9 +306,9 @@ void Limit_Pwm(int amplitude)
 Function: Limiting function
 Input   : Value
 Output  : none
-ܣ޷
-ڲֵ
-  ֵ
+函数功能：限幅函数
+入口参数：幅值
+返回  值：无
 **************************************************************************/
 float target_limit_float(float insert,float low,float high)
 {
@@ -285,10 +332,10 @@ int target_limit_int(int insert,int low,int high)
 Function: Check the battery voltage, enable switch status, software failure flag status
 Input   : Voltage
 Output  : Whether control is allowed, 1: not allowed, 0 allowed
-ܣصѹʹܿ״̬ʧܱ־λ״̬
-ڲѹ
-  ֵǷƣ10
-          Ŀǰûϸú
+函数功能：检查电池电压、使能开关状态、软件失能标志位状态
+入口参数：电压
+返回  值：是否允许控制，1：不允许，0允许
+          目前没有用上该函数
 **************************************************************************/
 u8 Turn_Off( int voltage)
 {
@@ -309,9 +356,9 @@ u8 Turn_Off( int voltage)
 Function: Calculate absolute value
 Input   : long int
 Output  : unsigned int
-ܣֵ
-ڲlong int
-  ֵunsigned int
+函数功能：求绝对值
+入口参数：long int
+返回  值：unsigned int
 **************************************************************************/
 u32 myabs(long int a)
 { 		   
@@ -325,77 +372,77 @@ Function: Incremental PI controller
 Input   : Encoder measured value (actual speed), target speed
 Output  : Motor PWM
 According to the incremental discrete PID formula
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
 e(k) represents the current deviation
 e(k-1) is the last deviation and so on
 PWM stands for incremental output
 In our speed control closed loop system, only PI control is used
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)
-
-ܣʽPI
-ڲֵ(ʵٶ)Ŀٶ
-  ֵPWM
-ʽɢPIDʽ 
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
-e(k)ƫ 
-e(k-1)һεƫ  Դ 
-pwm
-ǵٶȿƱջϵͳ棬ֻʹPI
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)
+
+函数功能：增量式PI控制器
+入口参数：编码器测量值(实际速度)，目标速度
+返回  值：电机PWM
+根据增量式离散PID公式 
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
+e(k)代表本次偏差 
+e(k-1)代表上一次的偏差  以此类推 
+pwm代表增量输出
+在我们的速度控制闭环系统里面，只使用PI控制
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)
 **************************************************************************/
 int Incremental_PI_A (float Encoder,float Target)
 { 	
 	 static float Bias,Pwm,Last_bias;
-	 Bias=Target-Encoder; //Calculate the deviation //ƫ
+	 Bias=Target-Encoder; //Calculate the deviation //计算偏差
 	 Pwm+=Velocity_KP*(Bias-Last_bias)+Velocity_KI*Bias; 
 	 if(Pwm>1500)Pwm=1500;
 	 if(Pwm<-1500)Pwm=-1500;
-	 Last_bias=Bias; //Save the last deviation //һƫ 
+	 Last_bias=Bias; //Save the last deviation //保存上一次偏差 
 	 return Pwm;    
 }
 int Incremental_PI_B (float Encoder,float Target)
 {  
 	 static float Bias,Pwm,Last_bias;
-	 Bias=Target-Encoder; //Calculate the deviation //ƫ
+	 Bias=Target-Encoder; //Calculate the deviation //计算偏差
 	 Pwm+=Velocity_KP*(Bias-Last_bias)+Velocity_KI*Bias;  
 	 if(Pwm>1500)Pwm=1500;
 	 if(Pwm<-1500)Pwm=-1500;
-	 Last_bias=Bias; //Save the last deviation //һƫ 
+	 Last_bias=Bias; //Save the last deviation //保存上一次偏差 
 	 return Pwm;
 }
 int Incremental_PI_C (float Encoder,float Target)
 {  
 	 static float Bias,Pwm,Last_bias;
-	 Bias=Target-Encoder; //Calculate the deviation //ƫ
+	 Bias=Target-Encoder; //Calculate the deviation //计算偏差
 	 Pwm+=Velocity_KP*(Bias-Last_bias)+Velocity_KI*Bias; 
 	 if(Pwm>1500)Pwm=1500;
 	 if(Pwm<-1500)Pwm=-1500;
-	 Last_bias=Bias; //Save the last deviation //һƫ 
+	 Last_bias=Bias; //Save the last deviation //保存上一次偏差 
 	 return Pwm; 
 }
 int Incremental_PI_D (float Encoder,float Target)
 {  
 	 static float Bias,Pwm,Last_bias;
-	 Bias=Target-Encoder; //Calculate the deviation //ƫ
+	 Bias=Target-Encoder; //Calculate the deviation //计算偏差
 	 Pwm+=Velocity_KP*(Bias-Last_bias)+Velocity_KI*Bias;  
 	 if(Pwm>1500)Pwm=1500;
 	 if(Pwm<-1500)Pwm=-1500;
-	 Last_bias=Bias; //Save the last deviation //һƫ 
+	 Last_bias=Bias; //Save the last deviation //保存上一次偏差 
 	 return Pwm; 
 }
 /**************************************************************************
 Function: Processes the command sent by APP through usart 2
 Input   : none
 Output  : none
-ܣAPPͨ2͹д
-ڲ
-  ֵ
+函数功能：对APP通过串口2发送过来的命令进行处理
+入口参数：无
+返回  值：无
 **************************************************************************/
 void Get_RC(void)
 {
 	u8 Flag_Move=1;
 
-	 switch(Flag_Direction)  //Handle direction control commands //
+	 switch(Flag_Direction)  //Handle direction control commands //处理方向控制命令
 	 { 
 			case 1:      Move_X=RC_Velocity;  	 Move_Y=0;             Flag_Move=1;    break;
 			case 2:      Move_X=RC_Velocity;  	 Move_Y=-RC_Velocity;  Flag_Move=1; 	 break;
@@ -410,19 +457,19 @@ void Get_RC(void)
 	 if(Flag_Move==0)		
 	 {	
 		 //If no direction control instruction is available, check the steering control status
-		 //޷ָת״̬
-		 if     (Flag_Left ==1)  Move_Z= PI/2*(RC_Velocity/500); //left rotation  //ת  
-		 else if(Flag_Right==1)  Move_Z=-PI/2*(RC_Velocity/500); //right rotation //ת
-		 else 		               Move_Z=0;                       //stop           //ֹͣ
+		 //如果无方向控制指令，检查转向控制状态
+		 if     (Flag_Left ==1)  Move_Z= PI/2*(RC_Velocity/500); //left rotation  //左自转  
+		 else if(Flag_Right==1)  Move_Z=-PI/2*(RC_Velocity/500); //right rotation //右自转
+		 else 		               Move_Z=0;                       //stop           //停止
 	 }
 
 
 	//Unit conversion, mm/s -> m/s
-    //λתmm/s -> m/s	
-	Move_X=Move_X/1000;       Move_Y=Move_Y/1000;         Move_Z=Move_Z; // app˵õٶָλΪmm/s Сm/s
+    //单位转换，mm/s -> m/s	
+	Move_X=Move_X/1000;       Move_Y=Move_Y/1000;         Move_Z=Move_Z; // 从app端得到的速度指令单位为mm/s 但是小车处理m/s的数据
 	
 	//Control target value is obtained and kinematics analysis is performed
-	//õĿֵ˶ѧ
+	//得到控制目标值，进行运动学分析
 	Drive_Motor(Move_X,Move_Y,Move_Z);
 }
 
@@ -432,14 +479,14 @@ void Get_RC(void)
 Function: Read the encoder value and calculate the wheel speed, unit m/s
 Input   : none
 Output  : none
-ܣȡֵ㳵ٶȣλm/s
-ڲ
-  ֵ
+函数功能：读取编码器数值并计算车轮速度，单位m/s
+入口参数：无
+返回  值：无
 **************************************************************************/
 void Get_Velocity_Form_Encoder(void)
 {
 	  //Retrieves the original data of the encoder
-	  //ȡԭʼ
+	  //获取编码器的原始数据
 
 		float Encoder_A_pr,Encoder_B_pr,Encoder_C_pr,Encoder_D_pr; 
 		OriginalEncoder.A=Read_Encoder(2);	
@@ -448,7 +495,7 @@ void Get_Velocity_Form_Encoder(void)
 		OriginalEncoder.D=Read_Encoder(5);	
 	
 	  //Decide the encoder numerical polarity according to different car models
-		//ݲͬСͺžֵ
+		//根据不同小车型号决定编码器数值极性
 		switch(Car_Mode)
 		{
 			case Mec_Car:       Encoder_A_pr= OriginalEncoder.A; Encoder_B_pr= OriginalEncoder.B; Encoder_C_pr=-OriginalEncoder.C;  Encoder_D_pr=-OriginalEncoder.D; break; 
@@ -460,22 +507,22 @@ void Get_Velocity_Form_Encoder(void)
 		}
 		
 		//The encoder converts the raw data to wheel speed in m/s
-		//ԭʼתΪٶȣλm/s
+		//编码器原始数据转换为车轮速度，单位m/s
 		MOTOR_A.Encoder= Encoder_A_pr*CONTROL_FREQUENCY*Wheel_perimeter/Encoder_precision;  
 		MOTOR_B.Encoder= Encoder_B_pr*CONTROL_FREQUENCY*Wheel_perimeter/Encoder_precision;  
 		MOTOR_C.Encoder= Encoder_C_pr*CONTROL_FREQUENCY*Wheel_perimeter/Encoder_precision; 
 		MOTOR_D.Encoder= Encoder_D_pr*CONTROL_FREQUENCY*Wheel_perimeter/Encoder_precision; 
 	
-        // Сٶ
+        // 新增：计算小车整体速度
         Calculate_Car_Velocity();
 }
 /**************************************************************************
 Function: Smoothing the three axis target velocity
 Input   : Three-axis target velocity
 Output  : none
-ܣĿٶƽ
-ڲĿٶ
-  ֵ
+函数功能：对三轴目标速度做平滑处理
+入口参数：三轴目标速度
+返回  值：无
 **************************************************************************/
 void Smooth_control(float vx,float vy,float vz)
 {
@@ -501,9 +548,9 @@ void Smooth_control(float vx,float vy,float vz)
 Function: Floating-point data calculates the absolute value
 Input   : float
 Output  : The absolute value of the input number
-ܣݼֵ
-ڲ
-  ֵľֵ
+函数功能：浮点型数据计算绝对值
+入口参数：浮点数
+返回  值：输入数的绝对值
 **************************************************************************/
 float float_abs(float insert)
 {
@@ -513,107 +560,64 @@ float float_abs(float insert)
 
 
 /**************************************************************************
-Function: Զ
-Input   : 
-Output  : 
-ܣԶСĿ꺽
+Function: 自动航向调整函数
+Input   : 无
+Output  : 无
+函数功能：自动调整小车到目标航向
 **************************************************************************/
 void Auto_Adjust_Yaw(void)
 {
-    // ȡǰǣҪǻȡ
+    // 获取当前航向角（需要从陀螺仪或其他传感器获取）
     float current_yaw = Yaw; 
     
-    // 㺽
-    float yaw_control = Yaw_PID_Control(current_yaw, Target_Yaw);
+    // 计算航向控制量
+    float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, current_yaw, Target_Yaw);
     
-    // תٶȣٶΪ0
+    // 设置旋转速度，其他方向速度为0
     Drive_Motor(0, 0, yaw_control);
 
 }
 
 /**************************************************************************
-Function: PID
-Input   : ǰǣĿ꺽
-Output  : תٶȿ
-ܣʹPID㷨СתٶȣʹСĿ꺽
-**************************************************************************/
-float Yaw_KP = 0.12f;          // ϵҪʵʵ
-float Yaw_KI = 0.001f;         // ϵҪʵʵ
-float Yaw_KD = 0.05f;           // ΢ϵҪʵʵ
-float Yaw_PID_Control(float current_yaw, float target_yaw)
-{
-    float yaw_error, yaw_output;
-    static float yaw_integral = 0;
-    static float last_yaw_error = 0;
-    
-    // 㺽ǽǶѭԣ
-    yaw_error = target_yaw - current_yaw; // ֵӦ˳ʱ  ֵӦʱ
-    
-    // 淶[-180, 180]ȷΧ
-    while (yaw_error > 180.0f) yaw_error -= 360.0f;
-    while (yaw_error < -180.0f) yaw_error += 360.0f;
-
-	// ΢
-    float derivative = yaw_error - last_yaw_error;
-    // 	
-    yaw_integral += yaw_error;
-
-	// Ҫ޸ģ޷Χ
-	//  1.0KI0.01ô (1.0 / 0.01) = 100 Ǻġ
-	// ʾֻܹ 1.0 
-	float integral_max = 1.0f / Yaw_KI; // ̬
-	yaw_integral = target_limit_float(yaw_integral, -integral_max, integral_max);
-	// PID
-    yaw_output = Yaw_KP * yaw_error + Yaw_KI * yaw_integral + Yaw_KD * (yaw_error - last_yaw_error);
-    
-    
-    
-    // 浱ǰһμ
-    last_yaw_error = yaw_error;
-    
-    // Χ
-    return target_limit_float(yaw_output, -1.0f, 1.0f);
-}
-
-/**************************************************************************
-Function: Զλúͺ
-Input   : 
-Output  : 
-ܣԶСĿλúͺ
+Function: 自动位置和航向调整函数
+Input   : 无
+Output  : 无
+函数功能：自动调整小车到目标位置和航向
 **************************************************************************/
 void Auto_Adjust_Position_And_Yaw(void)
 {
-    // ȡǰǺλ
+    // 获取当前航向角和位置
     float current_yaw = Yaw; 
     
-    // λ
+    // 计算位置误差
     float error_x = Target_position[0] - position[0];
     float error_y = Target_position[1] - position[1];
     
-    // 㵽Ŀľͷǣȫϵ
-    float distance_to_target = sqrtf(error_x * error_x + error_y * error_y);
-    float global_target_angle = atan2f(error_y, error_x) * 180.0f / PI;
+    // 计算到目标的距离和方向角（全局坐标系）
+    float distance_to_target = Fast_Sqrtf(error_x * error_x + error_y * error_y);
+    float global_target_angle = Fast_Atan2f(error_y, error_x) * FAST_RAD2DEG;
     
-    // ÿ50εôӡһεϢ
+    // 每50次调用打印一次调试信息
     static uint32_t adjust_count = 0;
     adjust_count++;
     if(adjust_count % 50 == 0) {
         char debug_msg[256];
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] (%.3f,%.3f) :%.3f Ŀ:%.1f ǰ:%.1f\r\n", 
-                 error_x, error_y, distance_to_target, global_target_angle, current_yaw);
+                 "[导航] 误差(%.3f,%.3f) 距离:%.3f 目标角:%.1f 当前角:%.1f\r\n", 
+                 (double)error_x, (double)error_y, (double)distance_to_target,
+                 (double)global_target_angle, (double)current_yaw);
         usart1_send_cstring(debug_msg);
     }
     
-    // Ƿ񵽴Ŀλ
+    // 检查是否到达目标位置
     if(distance_to_target < position_tolerance) {
         position_reached = 1;
-        // ֻкƶ
-        float yaw_control = Yaw_PID_Control(current_yaw, Target_Yaw);
+        // 只进行航向调整，不移动
+        float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, current_yaw, Target_Yaw);
         if(adjust_count % 50 == 0) {
             char debug_msg[128];
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] Ŀ꣬:%.3f\r\n", yaw_control);
+                     "[导航] 到达目标，航向控制:%.3f\r\n", (double)yaw_control);
             usart1_send_cstring(debug_msg);
         }
         Drive_Motor(0, 0, yaw_control);
@@ -622,44 +626,43 @@ void Auto_Adjust_Position_And_Yaw(void)
         position_reached = 0;
     }
     
-    // ȫϵµĿ귽תСϵ
-    // СϵXǰY
-    float relative_target_angle = global_target_angle - current_yaw;
-    
-    // 淶Ƕȵ[-180, 180]
-    while(relative_target_angle > 180.0f) relative_target_angle -= 360.0f;
-    while(relative_target_angle < -180.0f) relative_target_angle += 360.0f;
+    // 将全局坐标系下的目标方向转换到小车坐标系
+    // 小车坐标系：X向前，Y向左
+    // 规范化角度到[-180, 180]
+    float relative_target_angle = Fast_Wrap180(global_target_angle - current_yaw);
     
-    // ٶȣھıƣ
+    // 计算基础速度（基于距离的比例控制）
     float base_speed = Pos_KP * distance_to_target;
     
-    // ٶȲʵƽӽԽٶԽ
+    // 限制最大速度并实现平滑接近（距离越近速度越慢）
     if(base_speed > max_linear_speed) {
         base_speed = max_linear_speed;
     }
     
-    // ʵֽӽĿʱļ
-    if(distance_to_target < 0.5f) { // 0.5ڿʼ
+    // 实现接近目标时的减速
+    if(distance_to_target < 0.5f) { // 在0.5米内开始减速
         base_speed *= (distance_to_target / 0.5f);
     }
     
-    // ֽٶȵXYСϵ
-    float speed_x = base_speed * cosf(relative_target_angle * PI / 180.0f);
-    float speed_y = base_speed * sinf(relative_target_angle * PI / 180.0f);
+    // 分解速度到X和Y方向（小车坐标系）
+    float sin_angle, cos_angle;
+    Fast_Sincosf(relative_target_angle * FAST_DEG2RAD, &sin_angle, &cos_angle);
+    float speed_x = base_speed * cos_angle;
+    float speed_y = base_speed * sin_angle;
     
-    // ͬʱк
-    float yaw_control = Yaw_PID_Control(current_yaw, Target_Yaw);
+    // 同时进行航向控制
+    float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Auto_Yaw, current_yaw, Target_Yaw);
     
-    // ÿ50εôӡһο
+    // 每50次调用打印一次控制输出
     if(adjust_count % 50 == 0) {
         char debug_msg[256];
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[]  X:%.3f Y:%.3f Z:%.3f ٶ:%.3f\r\n", 
-                 speed_x, speed_y, yaw_control, base_speed);
+                 "[导航] 控制输出 X:%.3f Y:%.3f Z:%.3f 基础速度:%.3f\r\n", 
+                 (double)speed_x, (double)speed_y, (double)yaw_control, (double)base_speed);
         usart1_send_cstring(debug_msg);
     }
     
-    // ƶת
+    // 组合移动和旋转控制
     Drive_Motor(speed_x, speed_y, yaw_control);
 }
 
@@ -0,0 +1,406 @@
+#include "collision_avoid.h"
+#include "balance.h"
+#include "esp8266_driver.h"
+#include "fast_math.h"
+#include "uwb.h"
+#include "delay.h"
+#include "float_only.h"
+
+#define ORCA_EPSILON 1e-5f
+
+Collision_Avoid_t Collision_Avoid = COLLISION_AVOID_DEFAULT;
+
+//Allowed velocities lie left of the line through Point along Direction (unit)
+//允许的速度位于经过Point、沿Direction(单位向量)方向的直线左侧
+typedef struct
+{
+	float Point_X, Point_Y;
+	float Dir_X, Dir_Y;
+}Orca_Line_t;
+
+static __inline float Orca_Det(float ax, float ay, float bx, float by)
+{
+	return ax * by - ay * bx;
+}
+
+/**************************************************************************
+Function: Optimise along one line subject to the lines before it and the speed disk
+Input   : lines, n: line n is optimised on, lines 0..n-1 bound it; radius: speed limit;
+          opt_x, opt_y: preferred velocity or direction; direction: 1 maximise along opt;
+          rx, ry: result
+Output  : 1 feasible, 0 not
+函数功能：在前面的直线和速度圆约束下，沿第n条直线求最优点
+入口参数：lines，n：在第n条直线上求解，0..n-1条直线为约束；radius：速度限幅；
+          opt_x，opt_y：期望速度或方向；direction：1表示沿opt方向取最大；rx，ry：结果
+返回  值：1可行，0不可行
+**************************************************************************/
+static uint8_t Orca_LP1(const Orca_Line_t *lines, int n, float radius, float opt_x, float opt_y,
+                        uint8_t direction, float *rx, float *ry)
+{
+	const Orca_Line_t *l = &lines[n];
+	float dot = l->Point_X * l->Dir_X + l->Point_Y * l->Dir_Y;
+	float disc = dot * dot + radius * radius - (l->Point_X * l->Point_X + l->Point_Y * l->Point_Y);
+	float root, t_left, t_right, t;
+	int i;
+
+	//The line misses the speed disk //直线与速度圆不相交
+	if(disc < 0.0f) return 0;
+	root = Fast_Sqrtf(disc);
+	t_left = -dot - root;
+	t_right = -dot + root;
+
+	for(i = 0; i < n; i++)
+	{
+		float denom = Orca_Det(l->Dir_X, l->Dir_Y, lines[i].Dir_X, lines[i].Dir_Y);
+		float numer = Orca_Det(lines[i].Dir_X, lines[i].Dir_Y, l->Point_X - lines[i].Point_X, l->Point_Y - lines[i].Point_Y);
+
+		if(denom <= ORCA_EPSILON && denom >= -ORCA_EPSILON)
+		{
+			//Parallel: either all of line n is allowed by line i or none of it
+			//平行：第n条直线要么全部满足第i条约束，要么全部不满足
+			if(numer < 0.0f) return 0;
+			continue;
+		}
+		t = numer / denom;
+		if(denom >= 0.0f) { if(t < t_right) t_right = t; }
+		else              { if(t > t_left)  t_left = t; }
+		if(t_left > t_right) return 0;
+	}
+
+	if(direction)
+		t = (opt_x * l->Dir_X + opt_y * l->Dir_Y > 0.0f) ? t_right : t_left;
+	else
+	{
+		t = l->Dir_X * (opt_x - l->Point_X) + l->Dir_Y * (opt_y - l->Point_Y);
+		if(t < t_left)  t = t_left;
+		if(t > t_right) t = t_right;
+	}
+	*rx = l->Point_X + t * l->Dir_X;
+	*ry = l->Point_Y + t * l->Dir_Y;
+	return 1;
+}
+
+/**************************************************************************
+Function: Velocity closest to opt inside all lines and the speed disk, incremental 2D LP
+Input   : lines, count; radius: speed limit; opt_x, opt_y; direction: see Orca_LP1; rx, ry: result
+Output  : count when feasible, otherwise the index of the line that failed
+函数功能：增量式二维线性规划，求满足所有直线和速度圆且最接近opt的速度
+入口参数：lines，count；radius：速度限幅；opt_x，opt_y；direction：见Orca_LP1；rx，ry：结果
+返回  值：可行时返回count，否则返回失败的直线序号
+**************************************************************************/
+static int Orca_LP2(const Orca_Line_t *lines, int count, float radius, float opt_x, float opt_y,
+                    uint8_t direction, float *rx, float *ry)
+{
+	float d2 = opt_x * opt_x + opt_y * opt_y, keep_x, keep_y;
+	int i;
+
+	if(direction)
+	{
+		*rx = opt_x * radius;
+		*ry = opt_y * radius;
+	}
+	else if(d2 > radius * radius)
+	{
+		float scale = radius / Fast_Sqrtf(d2);
+		*rx = opt_x * scale;
+		*ry = opt_y * scale;
+	}
+	else
+	{
+		*rx = opt_x;
+		*ry = opt_y;
+	}
+
+	for(i = 0; i < count; i++)
+	{
+		//The current result breaks line i: the optimum moves onto line i
+		//当前结果不满足第i条约束：最优点移到第i条直线上
+		if(Orca_Det(lines[i].Dir_X, lines[i].Dir_Y, lines[i].Point_X - *rx, lines[i].Point_Y - *ry) > 0.0f)
+		{
+			keep_x = *rx;
+			keep_y = *ry;
+			if(!Orca_LP1(lines, i, radius, opt_x, opt_y, direction, rx, ry))
+			{
+				*rx = keep_x;
+				*ry = keep_y;
+				return i;
+			}
+		}
+	}
+	return count;
+}
+
+/**************************************************************************
+Function: No velocity satisfies every line: minimise the largest violation, from line begin on
+Input   : lines, count, begin: first line that failed in Orca_LP2; radius; rx, ry: in/out
+Output  : none
+函数功能：没有速度能满足所有直线时，从失败的直线开始使最大违反量最小
+入口参数：lines，count，begin：Orca_LP2中第一个失败的直线；radius；rx，ry：输入输出
+返回  值：无
+**************************************************************************/
+static void Orca_LP3(const Orca_Line_t *lines, int count, int begin, float radius, float *rx, float *ry)
+{
+	Orca_Line_t projected[ORCA_MAX_PEERS];
+	float distance = 0.0f, keep_x, keep_y;
+	int i, j, n;
+
+	for(i = begin; i < count; i++)
+	{
+		if(Orca_Det(lines[i].Dir_X, lines[i].Dir_Y, lines[i].Point_X - *rx, lines[i].Point_Y - *ry) <= distance) continue;
+
+		//Lines 0..i-1 seen from line i: where each one is as violated as line i
+		//从第i条直线看前面的直线：各直线与第i条直线违反量相等的位置
+		n = 0;
+		for(j = 0; j < i; j++)
+		{
+			float det = Orca_Det(lines[i].Dir_X, lines[i].Dir_Y, lines[j].Dir_X, lines[j].Dir_Y), dx, dy, len;
+
+			if(det <= ORCA_EPSILON && det >= -ORCA_EPSILON)
+			{
+				//Same direction adds nothing, opposite directions meet half way
+				//同向的直线不增加约束，反向的直线取中线
+				if(lines[i].Dir_X * lines[j].Dir_X + lines[i].Dir_Y * lines[j].Dir_Y > 0.0f) continue;
+				projected[n].Point_X = 0.5f * (lines[i].Point_X + lines[j].Point_X);
+				projected[n].Point_Y = 0.5f * (lines[i].Point_Y + lines[j].Point_Y);
+			}
+			else
+			{
+				float t = Orca_Det(lines[j].Dir_X, lines[j].Dir_Y, lines[i].Point_X - lines[j].Point_X,
+				                   lines[i].Point_Y - lines[j].Point_Y) / det;
+				projected[n].Point_X = lines[i].Point_X + t * lines[i].Dir_X;
+				projected[n].Point_Y = lines[i].Point_Y + t * lines[i].Dir_Y;
+			}
+			dx = lines[j].Dir_X - lines[i].Dir_X;
+			dy = lines[j].Dir_Y - lines[i].Dir_Y;
+			len = Fast_Sqrtf(dx * dx + dy * dy);
+			if(len < ORCA_EPSILON) continue;
+			projected[n].Dir_X = dx / len;
+			projected[n].Dir_Y = dy / len;
+			n++;
+		}
+
+		keep_x = *rx;
+		keep_y = *ry;
+		//Move as far as possible against line i's violation //沿减小第i条直线违反量的方向尽量移动
+		if(Orca_LP2(projected, n, radius, -lines[i].Dir_Y, lines[i].Dir_X, 1, rx, ry) < n)
+		{
+			//Only rounding gets here, the result is already optimal
+			//只有舍入误差才会到这里，原结果已是最优
+			*rx = keep_x;
+			*ry = keep_y;
+		}
+		distance = Orca_Det(lines[i].Dir_X, lines[i].Dir_Y, lines[i].Point_X - *rx, lines[i].Point_Y - *ry);
+	}
+}
+
+/**************************************************************************
+Function: Half plane of velocities that avoid one peer within the time horizon
+Input   : ca: filter; rel_x, rel_y: peer minus own position; vx, vy: own velocity;
+          pvx, pvy: peer velocity; share: part of the avoidance taken by this car; line: result
+Output  : none
+函数功能：计算在预测时间内避开一辆车的允许速度半平面
+入口参数：ca：滤波器；rel_x，rel_y：对方位置减本车位置；vx，vy：本车速度；
+          pvx，pvy：对方速度；share：本车承担的避让比例；line：结果
+返回  值：无
+**************************************************************************/
+static void Orca_Half_Plane(Collision_Avoid_t *ca, float rel_x, float rel_y, float vx, float vy,
+                            float pvx, float pvy, float share, Orca_Line_t *line)
+{
+	float r = 2.0f * ca->Radius + ORCA_MARGIN, inv_tau = 1.0f / ca->Time_Horizon;
+	float dist2 = rel_x * rel_x + rel_y * rel_y, rvx = vx - pvx, rvy = vy - pvy;
+	float wx, wy, w2, ux, uy, wlen;
+
+	if(dist2 > r * r)
+	{
+		//Velocity obstacle: a cone cut off by a circle at the horizon. w is the
+		//relative velocity seen from the centre of the cut-off circle
+		//速度障碍为在预测时间处被圆截断的锥。w为相对速度相对截断圆圆心的位置
+		float dot;
+
+		wx = rvx - inv_tau * rel_x;
+		wy = rvy - inv_tau * rel_y;
+		w2 = wx * wx + wy * wy;
+		dot = wx * rel_x + wy * rel_y;
+
+		if(dot < 0.0f && dot * dot > r * r * w2)
+		{
+			//Closest boundary is the cut-off circle //最近边界为截断圆
+			wlen = Fast_Sqrtf(w2);
+			wx /= wlen;
+			wy /= wlen;
+			line->Dir_X = wy;
+			line->Dir_Y = -wx;
+			ux = (r * inv_tau - wlen) * wx;
+			uy = (r * inv_tau - wlen) * wy;
+		}
+		else
+		{
+			//Closest boundary is one of the legs //最近边界为锥的一条边
+			float leg = Fast_Sqrtf(dist2 - r * r), dot2;
+
+			if(Orca_Det(rel_x, rel_y, wx, wy) > 0.0f)
+			{
+				line->Dir_X = (rel_x * leg - rel_y * r) / dist2;
+				line->Dir_Y = (rel_x * r + rel_y * leg) / dist2;
+			}
+			else
+			{
+				line->Dir_X = -(rel_x * leg + rel_y * r) / dist2;
+				line->Dir_Y = -(-rel_x * r + rel_y * leg) / dist2;
+			}
+			dot2 = rvx * line->Dir_X + rvy * line->Dir_Y;
+			ux = dot2 * line->Dir_X - rvx;
+			uy = dot2 * line->Dir_Y - rvy;
+		}
+	}
+	else
+	{
+		//Already overlapping: get apart within ORCA_COLLIDED_STEP
+		//已经重叠：在ORCA_COLLIDED_STEP内分开
+		float inv_step = 1.0f / ORCA_COLLIDED_STEP;
+
+		wx = rvx - inv_step * rel_x;
+		wy = rvy - inv_step * rel_y;
+		wlen = Fast_Sqrtf(wx * wx + wy * wy);
+		if(wlen < ORCA_EPSILON) { wx = -rel_x; wy = -rel_y; wlen = Fast_Sqrtf(dist2) + ORCA_EPSILON; }
+		wx /= wlen;
+		wy /= wlen;
+		line->Dir_X = wy;
+		line->Dir_Y = -wx;
+		ux = (r * inv_step - wlen) * wx;
+		uy = (r * inv_step - wlen) * wy;
+	}
+
+	line->Point_X = vx + share * ux;
+	line->Point_Y = vy + share * uy;
+}
+
+/**************************************************************************
+Function: Replace the planner's velocity by the closest collision free one
+Input   : ca: filter; px, py: own position, m; vx_now, vy_now: own velocity, world frame, m/s;
+          vx, vy: planner's velocity in, filtered velocity out, world frame, m/s
+Output  : none
+函数功能：将规划速度替换为最接近的无碰撞速度
+入口参数：ca：滤波器；px，py：本车位置，m；vx_now，vy_now：本车速度，世界坐标系，m/s；
+          vx，vy：输入规划速度，输出滤波后的速度，世界坐标系，m/s
+返回  值：无
+**************************************************************************/
+void Collision_Avoid_Filter(Collision_Avoid_t *ca, float px, float py, float vx_now, float vy_now,
+                            float *vx, float *vy)
+{
+	Orca_Line_t lines[ORCA_MAX_PEERS];
+	float near_d2[ORCA_MAX_PEERS];
+	uint8_t near_index[ORCA_MAX_PEERS];
+	float radius, rx, ry, ox = *vx, oy = *vy, s, c, pref2 = *vx * *vx + *vy * *vy;
+	uint32_t now = HAL_GetTick(), start = getCycleCnt();
+	int i, k, count = 0, failed;
+
+	//Keep the nearest peers, insertion sort on distance //按距离插入排序，保留最近的车辆
+	for(i = 0; i < MAX_OTHER_CARS; i++)
+	{
+		float dx, dy, d2;
+
+		if(!other_cars[i].valid || now - other_cars[i].last_update > ORCA_MAX_AGE_MS) continue;
+		dx = other_cars[i].position_x - px;
+		dy = other_cars[i].position_y - py;
+		d2 = dx * dx + dy * dy;
+		if(d2 > ORCA_NEIGHBOUR_DIST * ORCA_NEIGHBOUR_DIST) continue;
+		if(count == ORCA_MAX_PEERS && d2 >= near_d2[count - 1]) continue;
+
+		k = (count < ORCA_MAX_PEERS) ? count++ : count - 1;
+		while(k > 0 && near_d2[k - 1] > d2)
+		{
+			near_d2[k] = near_d2[k - 1];
+			near_index[k] = near_index[k - 1];
+			k--;
+		}
+		near_d2[k] = d2;
+		near_index[k] = (uint8_t)i;
+	}
+
+	for(k = 0; k < count; k++)
+	{
+		OtherCarInfo *n = &other_cars[near_index[k]];
+		float s, c, pvx, pvy, age = (float)(now - n->last_update);
+
+		Fast_Sincosf(n->yaw * FAST_DEG2RAD, &s, &c);
+		pvx = n->velocity_vx * c - n->velocity_vy * s;
+		pvy = n->velocity_vx * s + n->velocity_vy * c;
+		if(age > ORCA_PREDICT_MS) age = ORCA_PREDICT_MS;
+		age *= 0.001f;
+
+		//Half the avoidance with a moving peer that runs ORCA too, all of it with a
+		//standing one or one that does not avoid (remote control, autotuner, host)
+		//与同样运行ORCA的运动车辆各承担一半避让，对静止或不避让的车辆(遥控、自整定、上位机)由本车全部承担
+		Orca_Half_Plane(ca, n->position_x + pvx * age - px, n->position_y + pvy * age - py, vx_now, vy_now,
+		                pvx, pvy, (n->reciprocal && pvx * pvx + pvy * pvy >= ORCA_STATIC_SPEED * ORCA_STATIC_SPEED) ? 0.5f : 1.0f,
+		                &lines[k]);
+	}
+	ca->Peers = (uint8_t)count;
+
+	//The disk must allow sidestepping even when the planner wants to stand still
+	//即使规划速度为零，速度圆也要留出避让的余地
+	radius = ca->V_Max;
+	if(pref2 > radius * radius) radius = Fast_Sqrtf(pref2);
+
+	//Cars meeting head on, or a ring of them swapping sides, are symmetric and
+	//ORCA alone can stall them face to face. Every car leaning the same way
+	//while others are near turns the meeting into a roundabout
+	//对向相遇或成环换位的车辆是对称的，仅靠ORCA可能相互顶住。附近有车时各车都向右偏，相遇变为绕行
+	if(count)
+	{
+		Fast_Sincosf(ORCA_KEEP_RIGHT_DEG * FAST_DEG2RAD, &s, &c);
+		ox = *vx * c + *vy * s;
+		oy = -*vx * s + *vy * c;
+	}
+
+	failed = Orca_LP2(lines, count, radius, ox, oy, 0, &rx, &ry);
+	if(failed < count)
+	{
+		Orca_LP3(lines, count, failed, radius, &rx, &ry);
+		ca->Infeasible++;
+	}
+
+	ca->Adjusted = ((rx - *vx) * (rx - *vx) + (ry - *vy) * (ry - *vy) > 1e-6f);
+	*vx = rx;
+	*vy = ry;
+
+	ca->Cycles = getCycleCnt() - start;
+	if(ca->Cycles > ca->Cycles_Max) ca->Cycles_Max = ca->Cycles;
+}
+
+/**************************************************************************
+Function: Filter a body frame command of Drive_Motor
+Input   : Vx, Vy: body frame command in and out, m/s
+Output  : none
+函数功能：对Drive_Motor的车体坐标系指令进行避碰滤波
+入口参数：Vx，Vy：输入输出的车体坐标系指令，m/s
+返回  值：无
+**************************************************************************/
+void Collision_Avoid_Command(float *Vx, float *Vy)
+{
+	float s, c, wx, wy, nx, ny, px, py;
+
+	if(!Collision_Avoid.Enable) return;
+
+	Fast_Sincosf(Yaw * FAST_DEG2RAD, &s, &c);
+	wx = *Vx * c - *Vy * s;
+	wy = *Vx * s + *Vy * c;
+	nx = Current_Vx * c - Current_Vy * s;
+	ny = Current_Vx * s + Current_Vy * c;
+	//The fix is Uwb.Age_Ms old, moved on like the peers' reports //定位已有Uwb.Age_Ms的时长，与其他车辆数据一样外推
+	Uwb_Position_Now(nx, ny, &px, &py);
+	Collision_Avoid_Filter(&Collision_Avoid, px, py, nx, ny, &wx, &wy);
+	*Vx =  wx * c + wy * s;
+	*Vy = -wx * s + wy * c;
+
+	static uint32_t debug_count = 0;
+	if(Collision_Avoid.Peers && ++debug_count % 200 == 0)
+	{
+		char debug_msg[96];
+		snprintf(debug_msg, sizeof(debug_msg), "[避碰] 车辆%d 修正%d 无解%lu次 耗时%lu周期 最大%lu\r\n",
+		         Collision_Avoid.Peers, Collision_Avoid.Adjusted, (unsigned long)Collision_Avoid.Infeasible,
+		         (unsigned long)Collision_Avoid.Cycles, (unsigned long)Collision_Avoid.Cycles_Max);
+		usart1_send_cstring(debug_msg);
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef __COLLISION_AVOID_H
+#define __COLLISION_AVOID_H
+#include <stdint.h>
+
+//Reciprocal collision avoidance (ORCA) against the cars in other_cars[].
+//Every peer inside the look-ahead turns into a half plane of allowed
+//velocities, the filter returns the velocity closest to the planner's one
+//that lies in all of them and in the speed disk (2D linear program). When
+//the half planes leave no room, the velocity that violates them least is
+//used. Avoidance is shared half and half only with a moving peer whose
+//broadcast says it runs ORCA as well (OtherCarInfo.reciprocal), a standing
+//peer or one driven by remote control is avoided fully. Only the nearest
+//ORCA_MAX_PEERS peers are considered, so the time per call is bounded
+//whatever the size of the peer table, Host/orca_bench.c measures it.
+//基于other_cars[]的互惠避碰(ORCA)。预测时间内可能相碰的每辆车对应一个允许速度半平面，
+//滤波器输出同时满足所有半平面和速度圆、且最接近规划速度的速度(二维线性规划)。
+//半平面没有公共区域时，输出违反程度最小的速度。只与广播中声明同样运行ORCA的运动车辆各承担一半避让，
+//对静止或遥控的车辆由本车全部避让。只考虑最近的ORCA_MAX_PEERS辆车，
+//因此每次调用的耗时与车辆表大小无关，由Host/orca_bench.c测量
+
+#define ORCA_MAX_PEERS        10       //Nearest peers considered //考虑的最近车辆数
+#define ORCA_RADIUS           0.25f    //Radius of one car, m //单车半径，m
+#define ORCA_MARGIN           0.10f    //Extra clearance for the UWB error, m //为UWB误差预留的额外间距，m
+#define ORCA_TIME_HORIZON     2.0f     //Look-ahead, s //预测时间，s
+#define ORCA_COLLIDED_STEP    0.2f     //Time to get out of an overlap, about the position latency, s //重叠时脱离的时间，约为定位延迟，s
+#define ORCA_NEIGHBOUR_DIST   2.0f     //Peers farther than this are ignored, m //超过该距离的车辆忽略，m
+#define ORCA_MAX_AGE_MS       1000     //Peers with older data are ignored //数据超过该时间的车辆忽略
+#define ORCA_PREDICT_MS       300      //Peer positions are extrapolated at most this far //车辆位置最多外推该时间
+#define ORCA_KEEP_RIGHT_DEG   10.0f    //Preferred velocity turned right while peers are near, breaks symmetric deadlocks //附近有车辆时期望速度向右偏转的角度，打破对称死锁
+#define ORCA_STATIC_SPEED     0.02f    //A peer slower than this does not avoid, we take all the avoidance //低于该速度的车辆视为不避让，由本车承担全部避让
+
+typedef struct
+{
+	uint8_t Enable;
+	float Radius, Time_Horizon;
+	float V_Max;                  //Speed disk radius when the planner asks for less, m/s //规划速度较小时的速度圆半径，m/s
+
+	//State, readable from the debugger //状态，可在调试器中查看
+	uint8_t Peers;                //Half planes in the last call //上次调用的半平面数
+	uint8_t Adjusted;             //1: the planner's velocity was changed //1：规划速度被修改
+	uint32_t Infeasible;          //Calls that needed the least violation fallback //需要最小违反解的调用次数
+	uint32_t Cycles, Cycles_Max;  //Filter time, CPU cycles //滤波耗时，CPU周期数
+}Collision_Avoid_t;
+
+//Static initialiser //静态初始化
+#define COLLISION_AVOID_DEFAULT { 1, ORCA_RADIUS, ORCA_TIME_HORIZON, 0.3f }
+
+extern Collision_Avoid_t Collision_Avoid;
+
+void Collision_Avoid_Filter(Collision_Avoid_t *ca, float px, float py, float vx_now, float vy_now,
+                            float *vx, float *vy);
+void Collision_Avoid_Command(float *Vx, float *Vy);
+
+#endif
@@ -2,8 +2,8 @@
 #define __CONTROL_H
 #include "sys.h"
   /**************************************************************************
-ߣƽС֮
-ҵԱС꣺http://shop114407458.taobao.com/
+作者：平衡小车之家
+我的淘宝小店：http://shop114407458.taobao.com/
 **************************************************************************/
 #define PI 3.14159265
 #define ZHONGZHI 0 
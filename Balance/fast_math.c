@@ -0,0 +1,235 @@
+#include "fast_math.h"
+#include "delay.h"
+#include "usartx.h"
+#include "float_only.h"
+
+//Three part Cody-Waite split of PI/2. The first two parts have short
+//mantissas, n*PIO2_A and n*PIO2_B are exact for |n| < 2^12
+//PI/2的三段Cody-Waite拆分，前两段尾数较短，|n| < 2^12时n*PIO2_A和n*PIO2_B没有舍入误差
+#define PIO2_A    1.5703125f
+#define PIO2_B    4.83751296997e-04f
+#define PIO2_C    7.54978995489e-08f
+#define TWO_OVER_PI 0.636619772f
+
+//Round to nearest without lround, exact for |x| < 2^22
+//不调用lround的就近取整，|x| < 2^22时精确
+static __inline int32_t Fast_Round(float x)
+{
+	return (int32_t)(x >= 0.0f ? x + 0.5f : x - 0.5f);
+}
+
+static __inline int32_t Fast_Floor(float x)
+{
+	int32_t n = (int32_t)x;
+	return ((float)n > x) ? n - 1 : n;
+}
+
+/**************************************************************************
+Function: Sine and cosine of one angle, quadrant reduction and Taylor polynomials on [-PI/4,PI/4]
+Input   : x: angle, rad; s, c: results
+Output  : none
+函数功能：同时计算一个角度的正弦和余弦，先按象限规约，再在[-PI/4,PI/4]上用泰勒多项式计算
+入口参数：x：角度，弧度；s，c：结果
+返回  值：无
+**************************************************************************/
+void Fast_Sincosf(float x, float *s, float *c)
+{
+	int32_t n;
+	float r, r2, sr, cr;
+
+	if(!(x < FAST_MATH_RANGE && x > -FAST_MATH_RANGE)) x = 0.0f;
+	n = Fast_Round(x * TWO_OVER_PI);
+	r = ((x - (float)n * PIO2_A) - (float)n * PIO2_B) - (float)n * PIO2_C;
+	r2 = r * r;
+	sr = r + r * r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f + r2 * (-1.98412698e-4f + r2 * 2.75573192e-6f)));
+	cr = 1.0f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f + r2 * 2.48015873e-5f)));
+
+	switch(n & 3)
+	{
+		case 0:  *s =  sr; *c =  cr; break;
+		case 1:  *s =  cr; *c = -sr; break;
+		case 2:  *s = -sr; *c = -cr; break;
+		default: *s = -cr; *c =  sr; break;
+	}
+}
+
+float Fast_Sinf(float x)
+{
+	float s, c;
+	Fast_Sincosf(x, &s, &c);
+	return s;
+}
+
+float Fast_Cosf(float x)
+{
+	float s, c;
+	Fast_Sincosf(x, &s, &c);
+	return c;
+}
+
+/**************************************************************************
+Function: Four quadrant arctangent, minimax polynomial of atan on [0,1]
+Input   : y, x: any, atan2(0,0) is 0
+Output  : angle in [-PI,PI], rad
+函数功能：四象限反正切，在[0,1]上用atan的最佳一致逼近多项式计算
+入口参数：y，x：任意值，atan2(0,0)为0
+返回  值：角度，范围[-PI,PI]，弧度
+**************************************************************************/
+float Fast_Atan2f(float y, float x)
+{
+	float ax = fabsf(x), ay = fabsf(y), z, z2, r;
+
+	if(ax >= ay)
+	{
+		if(ax == 0.0f) return 0.0f;
+		z = ay / ax;
+	}
+	else z = ax / ay;
+
+	z2 = z * z;
+	r = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f +
+	    z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+	if(ay > ax) r = FAST_HALF_PI - r;
+	if(x < 0.0f) r = FAST_PI - r;
+	return (y < 0.0f) ? -r : r;
+}
+
+/**************************************************************************
+Function: Arcsine through Fast_Atan2f, the argument is clamped to [-1,1]
+Input   : x: sine value
+Output  : angle in [-PI/2,PI/2], rad
+函数功能：通过Fast_Atan2f计算反正弦，参数限制在[-1,1]
+入口参数：x：正弦值
+返回  值：角度，范围[-PI/2,PI/2]，弧度
+**************************************************************************/
+float Fast_Asinf(float x)
+{
+	if(x > 1.0f)  x = 1.0f;
+	if(x < -1.0f) x = -1.0f;
+	return Fast_Atan2f(x, Fast_Sqrtf((1.0f - x) * (1.0f + x)));
+}
+
+/**************************************************************************
+Function: Wrap an angle to [-180,180] in constant time, replaces the while loops
+Input   : deg: angle, degree
+Output  : wrapped angle, degree
+函数功能：以固定耗时将角度规范到[-180,180]，替代while循环
+入口参数：deg：角度，度
+返回  值：规范后的角度，度
+**************************************************************************/
+float Fast_Wrap180(float deg)
+{
+	if(deg <= 180.0f && deg >= -180.0f) return deg;
+	if(!(deg < FAST_MATH_RANGE && deg > -FAST_MATH_RANGE)) return 0.0f;
+	deg -= 360.0f * (float)Fast_Floor((deg + 180.0f) * (1.0f / 360.0f));
+	//Rounding of the product can land one ulp outside //乘积舍入可能超出一个ulp
+	if(deg > 180.0f)  deg -= 360.0f;
+	if(deg < -180.0f) deg += 360.0f;
+	return deg;
+}
+
+float Fast_WrapPi(float rad)
+{
+	if(rad <= FAST_PI && rad >= -FAST_PI) return rad;
+	if(!(rad < FAST_MATH_RANGE && rad > -FAST_MATH_RANGE)) return 0.0f;
+	rad -= FAST_TWO_PI * (float)Fast_Floor((rad + FAST_PI) * (1.0f / FAST_TWO_PI));
+	if(rad > FAST_PI)  rad -= FAST_TWO_PI;
+	if(rad < -FAST_PI) rad += FAST_TWO_PI;
+	return rad;
+}
+
+#if FAST_MATH_BENCHMARK
+Fast_Math_Benchmark_t Fast_Math_Bench;
+
+#define BENCH_POINTS 256
+
+static float Bench_Max(float max, float a, float b)
+{
+	float e = fabsf(a - b);
+	return e > max ? e : max;
+}
+
+//The reference the kernels replace //被替换的原写法
+static float Bench_Wrap_Loop(float deg)
+{
+	while(deg > 180.0f)  deg -= 360.0f;
+	while(deg < -180.0f) deg += 360.0f;
+	return deg;
+}
+
+/**************************************************************************
+Function: Time every kernel against libm on the DWT counter and report on USART1
+Input   : none
+Output  : none, the figures stay in Fast_Math_Bench
+函数功能：用DWT计数器对比各函数与libm的耗时并通过串口1输出
+入口参数：无
+返回  值：无，结果保存在Fast_Math_Bench中
+**************************************************************************/
+void Fast_Math_Benchmark(void)
+{
+	static const char *name[5] = { "sincos", "atan2", "asin", "sqrt", "wrap180" };
+	static float in[BENCH_POINTS];
+	volatile float sink = 0;
+	float s, c, ref;
+	u32 start, fast, libm;
+	char msg[96];
+	int i, k;
+
+	for(k = 0; k < 5; k++)
+	{
+		fast = libm = 0;
+		Fast_Math_Bench.Max_Error[k] = 0;
+		for(i = 0; i < BENCH_POINTS; i++)
+		{
+			//Sweep the range each kernel is used on //覆盖各函数的实际使用范围
+			float t = (float)i / (BENCH_POINTS - 1);
+			if(k == 0)      in[i] = (t - 0.5f) * 4.0f * FAST_PI;
+			else if(k == 2) in[i] = t * 2.0f - 1.0f;
+			else if(k == 3) in[i] = t * 4.0f;
+			else if(k == 4) in[i] = (t - 0.5f) * 1440.0f;
+			else            in[i] = t * FAST_TWO_PI;   //atan2 on the unit circle //单位圆上的atan2
+		}
+
+		for(i = 0; i < BENCH_POINTS; i++)
+		{
+			switch(k)
+			{
+				case 0:
+					start = getCycleCnt(); Fast_Sincosf(in[i], &s, &c); fast += getCycleCnt() - start; sink = s + c;
+					Fast_Math_Bench.Max_Error[k] = Bench_Max(Bench_Max(Fast_Math_Bench.Max_Error[k], s, sinf(in[i])), c, cosf(in[i]));
+					start = getCycleCnt(); s = sinf(in[i]); c = cosf(in[i]); libm += getCycleCnt() - start; sink = s + c;
+					break;
+				case 1:
+					Fast_Sincosf(in[i], &s, &c);
+					start = getCycleCnt(); sink = Fast_Atan2f(s, c); fast += getCycleCnt() - start;
+					start = getCycleCnt(); ref = atan2f(s, c); libm += getCycleCnt() - start;
+					//The two ends of the sweep are the same point, compare across the cut //扫描两端为同一点，跨越分界比较
+					Fast_Math_Bench.Max_Error[k] = Bench_Max(Fast_Math_Bench.Max_Error[k], Fast_WrapPi(sink - ref), 0.0f);
+					break;
+				case 2:
+					start = getCycleCnt(); sink = Fast_Asinf(in[i]); fast += getCycleCnt() - start;
+					start = getCycleCnt(); ref = asinf(in[i]); libm += getCycleCnt() - start;
+					Fast_Math_Bench.Max_Error[k] = Bench_Max(Fast_Math_Bench.Max_Error[k], sink, ref);
+					break;
+				case 3:
+					start = getCycleCnt(); sink = Fast_Sqrtf(in[i]); fast += getCycleCnt() - start;
+					start = getCycleCnt(); ref = sqrtf(in[i]); libm += getCycleCnt() - start;
+					Fast_Math_Bench.Max_Error[k] = Bench_Max(Fast_Math_Bench.Max_Error[k], sink, ref);
+					break;
+				default:
+					start = getCycleCnt(); sink = Fast_Wrap180(in[i]); fast += getCycleCnt() - start;
+					start = getCycleCnt(); ref = Bench_Wrap_Loop(in[i]); libm += getCycleCnt() - start;
+					Fast_Math_Bench.Max_Error[k] = Bench_Max(Fast_Math_Bench.Max_Error[k], Fast_Wrap180(sink - ref), 0.0f);
+					break;
+			}
+		}
+		Fast_Math_Bench.Fast_Cycles[k] = fast / BENCH_POINTS;
+		Fast_Math_Bench.Libm_Cycles[k] = libm / BENCH_POINTS;
+		snprintf(msg, sizeof(msg), "[MATH] %-7s %3lu cycles (libm %4lu), max error %.2e\r\n", name[k],
+		         (unsigned long)Fast_Math_Bench.Fast_Cycles[k], (unsigned long)Fast_Math_Bench.Libm_Cycles[k],
+		         (double)Fast_Math_Bench.Max_Error[k]);
+		usart1_send_cstring(msg);
+	}
+	(void)sink;
+}
+#endif
@@ -0,0 +1,74 @@
+#ifndef __FAST_MATH_H
+#define __FAST_MATH_H
+#include <stdint.h>
+#include <math.h>
+
+//Single precision math kernels for the control and IMU paths. The F407 FPU
+//only does single precision, every double operation and every libm call that
+//keeps errno semantics ends up in software. Errors below are the worst case
+//measured against the libm result over the whole valid input range.
+//控制和IMU路径使用的单精度数学函数。F407的FPU只支持单精度，任何双精度运算以及保留errno
+//语义的libm调用都会变成软件实现。以下误差为在整个有效输入范围内相对libm结果的最大误差
+
+#define FAST_PI           3.14159265f
+#define FAST_HALF_PI      1.57079633f
+#define FAST_TWO_PI       6.28318531f
+#define FAST_DEG2RAD      0.0174532925f
+#define FAST_RAD2DEG      57.2957795f
+
+//Arguments beyond this are treated as 0, NaN included, rad or degree. The
+//quadrant reduction of Fast_Sincosf keeps its error at 1.1e-7 up to here, it
+//grows to 1e-6 at 1e5 rad and to 0.35 at 1e6 rad
+//超出该范围的参数(包括NaN)按0处理，单位为弧度或度。在该范围内Fast_Sincosf的象限规约误差
+//不超过1.1e-7，1e5弧度时增大到1e-6，1e6弧度时达到0.35
+#define FAST_MATH_RANGE   8192.0f
+
+//Run Fast_Math_Benchmark at start-up, 0 removes it
+//启动时运行Fast_Math_Benchmark，为0时不编译
+#define FAST_MATH_BENCHMARK 0
+
+/**************************************************************************
+Function: Square root on the FPU (VSQRT.F32, 14 cycles), no errno handling
+Input   : x: >= 0
+Output  : sqrt(x), NaN for negative x
+函数功能：由FPU计算平方根(VSQRT.F32，14个周期)，不做errno处理
+入口参数：x：>= 0
+返回  值：sqrt(x)，x为负时返回NaN
+**************************************************************************/
+static __inline float Fast_Sqrtf(float x)
+{
+#if defined(__CC_ARM)
+	return __sqrtf(x);
+#elif defined(__GNUC__) && defined(__ARM_FP)
+	float r;
+	__asm volatile("vsqrt.f32 %0, %1" : "=t"(r) : "t"(x));
+	return r;
+#else
+	return sqrtf(x);
+#endif
+}
+
+void  Fast_Sincosf(float x, float *s, float *c);   //|error| < 2e-7
+float Fast_Sinf(float x);
+float Fast_Cosf(float x);
+float Fast_Atan2f(float y, float x);              //|error| < 2e-6 rad
+float Fast_Asinf(float x);                        //|error| < 2e-6 rad
+float Fast_Wrap180(float deg);                    //[-180,180], exact, no loops
+float Fast_WrapPi(float rad);                     //[-PI,PI], no loops
+
+#if FAST_MATH_BENCHMARK
+//Cycles per call of each kernel and of the libm call it replaces
+//各函数及其替代的libm函数每次调用的周期数
+typedef struct
+{
+	uint32_t Fast_Cycles[5];      //sincos, atan2, asin, sqrt, wrap180
+	uint32_t Libm_Cycles[5];
+	float    Max_Error[5];
+}Fast_Math_Benchmark_t;
+
+extern Fast_Math_Benchmark_t Fast_Math_Bench;
+
+void Fast_Math_Benchmark(void);
+#endif
+
+#endif
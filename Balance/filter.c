@@ -1,13 +1,13 @@
 #include "filter.h"
   /**************************************************************************
-ߣƽС֮
-ҵԱС꣺http://shop114407458.taobao.com/
+作者：平衡小车之家
+我的淘宝小店：http://shop114407458.taobao.com/
 **************************************************************************/
 float K1 =0.02; 
 float angle, angle_dot; 	
-float Q_angle=0.001;// Э
-float Q_gyro=0.003;//0.003 Э ЭΪһһо
-float R_angle=0.5;// Э Ȳƫ
+float Q_angle=0.001;// 过程噪声的协方差
+float Q_gyro=0.003;//0.003 过程噪声的协方差 过程噪声的协方差为一个一行两列矩阵
+float R_angle=0.5;// 测量噪声的协方差 既测量偏差
 float dt=0.005;//                 
 char  C_0 = 1;
 float Q_bias, Angle_err;
@@ -17,24 +17,24 @@ float Pdot[4] ={0,0,0,0};
 float PP[2][2] = { { 1, 0 },{ 0, 1 } };
 
 /**************************************************************************
-ܣ׿˲
-ڲٶȡٶ
-  ֵ
+函数功能：简易卡尔曼滤波
+入口参数：加速度、角速度
+返回  值：无
 **************************************************************************/
 void Kalman_Filter(float Accel,float Gyro)		
 {
-	angle+=(Gyro - Q_bias) * dt; //
-	Pdot[0]=Q_angle - PP[0][1] - PP[1][0]; // Pk-Э΢
+	angle+=(Gyro - Q_bias) * dt; //先验估计
+	Pdot[0]=Q_angle - PP[0][1] - PP[1][0]; // Pk-先验估计误差协方差的微分
 
 	Pdot[1]=-PP[1][1];
 	Pdot[2]=-PP[1][1];
 	Pdot[3]=Q_gyro;
-	PP[0][0] += Pdot[0] * dt;   // Pk-Э΢ֵĻ
-	PP[0][1] += Pdot[1] * dt;   // =Э
+	PP[0][0] += Pdot[0] * dt;   // Pk-先验估计误差协方差微分的积分
+	PP[0][1] += Pdot[1] * dt;   // =先验估计误差协方差
 	PP[1][0] += Pdot[2] * dt;
 	PP[1][1] += Pdot[3] * dt;
 		
-	Angle_err = Accel - angle;	//zk-
+	Angle_err = Accel - angle;	//zk-先验估计
 	
 	PCt_0 = C_0 * PP[0][0];
 	PCt_1 = C_0 * PP[1][0];
@@ -47,20 +47,20 @@ void Kalman_Filter(float Accel,float Gyro)
 	t_0 = PCt_0;
 	t_1 = C_0 * PP[0][1];
 
-	PP[0][0] -= K_0 * t_0;		 //Э
+	PP[0][0] -= K_0 * t_0;		 //后验估计误差协方差
 	PP[0][1] -= K_0 * t_1;
 	PP[1][0] -= K_1 * t_0;
 	PP[1][1] -= K_1 * t_1;
 		
-	angle	+= K_0 * Angle_err;	 //
-	Q_bias	+= K_1 * Angle_err;	 //
-	angle_dot   = Gyro - Q_bias;	 //ֵ()΢=ٶ
+	angle	+= K_0 * Angle_err;	 //后验估计
+	Q_bias	+= K_1 * Angle_err;	 //后验估计
+	angle_dot   = Gyro - Q_bias;	 //输出值(后验估计)的微分=角速度
 }
 
 /**************************************************************************
-ܣһ׻˲
-ڲٶȡٶ
-  ֵ
+函数功能：一阶互补滤波
+入口参数：加速度、角速度
+返回  值：无
 **************************************************************************/
 void Yijielvbo(float angle_m, float gyro_m)
 {
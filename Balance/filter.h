@@ -2,8 +2,8 @@
 #define __FILTER_H
 #include "system.h"
   /**************************************************************************
-ߣƽС֮
-ҵԱС꣺http://shop114407458.taobao.com/
+作者：平衡小车之家
+我的淘宝小店：http://shop114407458.taobao.com/
 **************************************************************************/
 extern float angle, angle_dot; 	
 void Kalman_Filter(float Accel,float Gyro);		
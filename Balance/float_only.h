@@ -0,0 +1,20 @@
+#ifndef __FLOAT_ONLY_H
+#define __FLOAT_ONLY_H
+
+//Included as the last header of the control and IMU sources. From here on a
+//float silently promoted to double (a literal without f, a double libm call,
+//a float passed to printf without a cast) is a compile error, the F407 FPU
+//has no double precision and each promotion costs a software call.
+//作为控制和IMU源文件的最后一个头文件包含。此后任何float被隐式提升为double(不带f的常数、
+//双精度libm函数、未经强制转换传给printf的float)都会导致编译错误，F407的FPU不支持双精度，
+//每次提升都需要调用软件库
+
+#if defined(__CC_ARM)
+#pragma diag_error 1035       //single-precision operand implicitly converted to double-precision
+#elif defined(__clang__)
+#pragma clang diagnostic error "-Wdouble-promotion"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic error "-Wdouble-promotion"
+#endif
+
+#endif
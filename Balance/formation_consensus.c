@@ -0,0 +1,222 @@
+#include "formation_consensus.h"
+#include "fast_math.h"
+#include <string.h>
+#include "float_only.h"
+
+//Same car ids and order as the topology matrix //与拓扑矩阵相同的小车ID和顺序
+#if MAX_CARS != 4
+#error "Consensus_Car_Id lists CAR1..CAR4, extend it with MAX_CARS"
+#endif
+static const char *const Consensus_Car_Id[MAX_CARS] = { "CAR1", "CAR2", "CAR3", "CAR4" };
+
+static OtherCarInfo *Consensus_Find(uint8_t index)
+{
+	int i;
+
+	for(i = 0; i < MAX_OTHER_CARS; i++)
+		if(other_cars[i].valid && strcmp(other_cars[i].car_id, Consensus_Car_Id[index]) == 0) return &other_cars[i];
+	return 0;
+}
+
+//a_ji: car i hears car j, every edge exists while the topology is disabled
+//a_ji：本车i能否接收小车j，拓扑未启用时所有边都存在
+static uint8_t Consensus_Edge(uint8_t j, uint8_t i)
+{
+	if(i == j) return 0;
+	return topology_enabled ? (communication_topology[j][i] != 0) : 1;
+}
+
+/**************************************************************************
+Function: Algebraic connectivity of the symmetrised topology, by power iteration on cI-L
+Input   : none
+Output  : second smallest eigenvalue of the Laplacian, 0 for a split graph
+函数功能：用幂迭代法(对cI-L)计算对称化拓扑的代数连通度
+入口参数：无
+返回  值：拉普拉斯矩阵的第二小特征值，图不连通时为0
+**************************************************************************/
+static float Consensus_Lambda2(void)
+{
+	float L[MAX_CARS][MAX_CARS], v[MAX_CARS], w[MAX_CARS];
+	float shift = 0.0f, mean, norm, mu = 0.0f;
+	int i, j, k;
+
+	for(i = 0; i < MAX_CARS; i++)
+	{
+		L[i][i] = 0.0f;
+		for(j = 0; j < MAX_CARS; j++)
+		{
+			if(j == i) continue;
+			L[i][j] = -0.5f * (float)(Consensus_Edge(i, j) + Consensus_Edge(j, i));
+			L[i][i] -= L[i][j];
+		}
+		if(2.0f * L[i][i] > shift) shift = 2.0f * L[i][i];
+	}
+	if(shift == 0.0f) return 0.0f;
+
+	//Start from the fractional parts of multiples of the golden ratio, a vector
+	//with no symmetry for the Fiedler vector of any graph to be orthogonal to
+	//初值取黄金分割比倍数的小数部分，该向量没有对称性，不会与任何图的Fiedler向量正交
+	for(i = 0; i < MAX_CARS; i++)
+	{
+		v[i] = 0.618034f * (float)(i + 1);
+		v[i] -= (float)(int)v[i] + 0.5f;
+	}
+
+	//The eigenvalues of L lie in [0, 2*max degree]. Removing the mean takes away
+	//the all-ones vector of eigenvalue 0, the dominant one left is shift-lambda2
+	//L的特征值在[0,2倍最大度]内。去掉均值即去掉特征值0对应的全1向量，剩下的主特征值为shift-lambda2
+	for(k = 0; k < 40; k++)
+	{
+		mean = 0.0f;
+		for(i = 0; i < MAX_CARS; i++) mean += v[i];
+		mean *= 1.0f / MAX_CARS;
+		for(i = 0; i < MAX_CARS; i++) v[i] -= mean;
+
+		norm = 0.0f;
+		mu = 0.0f;
+		for(i = 0; i < MAX_CARS; i++)
+		{
+			w[i] = shift * v[i];
+			for(j = 0; j < MAX_CARS; j++) w[i] -= L[i][j] * v[j];
+			mu += v[i] * w[i];
+			norm += v[i] * v[i];
+		}
+		if(norm < 1e-12f) return 0.0f;
+		mu /= norm;                   //Rayleigh quotient //瑞利商
+		norm = 0.0f;
+		for(i = 0; i < MAX_CARS; i++) norm += w[i] * w[i];
+		norm = 1.0f / Fast_Sqrtf(norm);
+		for(i = 0; i < MAX_CARS; i++) v[i] = w[i] * norm;
+	}
+	mu = shift - mu;
+	return mu < 1e-4f ? 0.0f : mu;
+}
+
+/**************************************************************************
+Function: Fade all edges in again and restart the rate estimate, called when the mode is entered
+Input   : c: controller
+Output  : none
+函数功能：所有边重新渐入，重新开始收敛速率估计，进入该模式时调用
+入口参数：c：控制器
+返回  值：无
+**************************************************************************/
+void Formation_Consensus_Reset(Formation_Consensus_t *c)
+{
+	int j;
+
+	for(j = 0; j < MAX_CARS; j++) c->Weight[j] = 0.0f;
+	c->Window_Ticks = 0;
+	c->Rate = 0.0f;
+	c->Topology_Sign = 0xFFFFFFFFu;
+}
+
+/**************************************************************************
+Function: One step of the consensus law
+Input   : c: controller; self: own index in the topology; px, py: own position, m; yaw_deg: own heading;
+          dt: control period, s; vx_world, vy_world: velocity command, world frame, m/s;
+          yaw_target: heading the neighbours agree on, degree
+Output  : none
+函数功能：一致性控制律的一步计算
+入口参数：c：控制器；self：本车在拓扑中的索引；px，py：本车位置，m；yaw_deg：本车航向；
+          dt：控制周期，s；vx_world，vy_world：速度指令，世界坐标系，m/s；
+          yaw_target：与邻居一致的目标航向，度
+返回  值：无
+**************************************************************************/
+void Formation_Consensus_Update(Formation_Consensus_t *c, uint8_t self, float px, float py, float yaw_deg,
+                                float dt, float *vx_world, float *vy_world, float *yaw_target)
+{
+	float s, c_yaw, ex, ey, own_x, own_y, sum_w = 0.0f, ux = 0.0f, uy = 0.0f, ffx = 0.0f, ffy = 0.0f, dyaw = 0.0f;
+	float fade = dt * (1000.0f / CONSENSUS_RAMP_MS), disagreement = 0.0f;
+	uint32_t now = HAL_GetTick(), sign = topology_enabled;
+	uint8_t j;
+
+	if(self >= MAX_CARS) self = 0;
+
+	//Recompute the connectivity only when the matrix changes //仅在矩阵变化时重新计算连通度
+	for(j = 0; j < MAX_CARS * MAX_CARS; j++)
+		sign = sign * 3u + communication_topology[j / MAX_CARS][j % MAX_CARS];
+	if(sign != c->Topology_Sign)
+	{
+		c->Topology_Sign = sign;
+		c->Lambda2 = Consensus_Lambda2();
+	}
+
+	//Slots turn with the own heading, the headings agree through the graph
+	//编队位置随本车航向旋转，各车航向通过图达成一致
+	Fast_Sincosf(yaw_deg * FAST_DEG2RAD, &s, &c_yaw);
+	own_x = px - (c->Slot_X[self] * c_yaw - c->Slot_Y[self] * s);
+	own_y = py - (c->Slot_X[self] * s + c->Slot_Y[self] * c_yaw);
+
+	c->Neighbours = 0;
+	for(j = 0; j < MAX_CARS; j++)
+	{
+		OtherCarInfo *n = (j == self) ? 0 : Consensus_Find(j);
+		float target = 0.0f, age_ms, ns, nc, nvx, nvy, nx, ny;
+
+		if(!n)
+		{
+			//No data, nothing to fade with //没有数据，无法渐变
+			c->Weight[j] = 0.0f;
+			continue;
+		}
+
+		//Staleness: full weight while fresh, linear down to 0 //时效权重：新数据为1，随后线性降为0
+		age_ms = (float)(now - n->last_update);
+		if(Consensus_Edge(j, self) && age_ms < CONSENSUS_STALE_MS)
+			target = age_ms <= CONSENSUS_FRESH_MS ? 1.0f : (CONSENSUS_STALE_MS - age_ms) * (1.0f / (CONSENSUS_STALE_MS - CONSENSUS_FRESH_MS));
+
+		//A topology switch fades edges in and out instead of stepping the command
+		//拓扑切换时边权重渐变，指令不会突变
+		if(c->Weight[j] < target) c->Weight[j] = (c->Weight[j] + fade < target) ? c->Weight[j] + fade : target;
+		else                      c->Weight[j] = (c->Weight[j] - fade > target) ? c->Weight[j] - fade : target;
+		if(c->Weight[j] <= 0.0f) continue;
+
+		//Neighbour velocity in the world frame, position extrapolated to now
+		//邻居速度转换到世界坐标系，位置外推到当前时刻
+		Fast_Sincosf(n->yaw * FAST_DEG2RAD, &ns, &nc);
+		nvx = n->velocity_vx * nc - n->velocity_vy * ns;
+		nvy = n->velocity_vx * ns + n->velocity_vy * nc;
+		if(age_ms > CONSENSUS_PREDICT_MS) age_ms = CONSENSUS_PREDICT_MS;
+		nx = n->position_x + nvx * age_ms * 0.001f;
+		ny = n->position_y + nvy * age_ms * 0.001f;
+
+		ex = (nx - (c->Slot_X[j] * c_yaw - c->Slot_Y[j] * s)) - own_x;
+		ey = (ny - (c->Slot_X[j] * s + c->Slot_Y[j] * c_yaw)) - own_y;
+
+		ux += c->Weight[j] * ex;
+		uy += c->Weight[j] * ey;
+		ffx += c->Weight[j] * nvx;
+		ffy += c->Weight[j] * nvy;
+		dyaw += c->Weight[j] * Fast_Wrap180(n->yaw - yaw_deg);
+		sum_w += c->Weight[j];
+		disagreement += c->Weight[j] * (ex * ex + ey * ey);
+		c->Neighbours++;
+	}
+	c->Disagreement = disagreement;
+
+	if(sum_w <= 0.0f)
+	{
+		//Nobody to agree with: hold position and heading //没有邻居：保持位置和航向
+		*vx_world = *vy_world = 0.0f;
+		*yaw_target = yaw_deg;
+		c->Window_Ticks = 0;
+		return;
+	}
+
+	//Velocities and headings are averaged, positions summed over the edges (Laplacian)
+	//速度和航向取加权平均，位置按边求和(拉普拉斯)
+	if(ux * ux + uy * uy < CONSENSUS_DEADBAND * CONSENSUS_DEADBAND) ux = uy = 0.0f;
+	*vx_world = ffx / sum_w + c->Gain * ux;
+	*vy_world = ffy / sum_w + c->Gain * uy;
+	*yaw_target = Fast_Wrap180(yaw_deg + dyaw / sum_w);
+
+	//Convergence rate: log decay of the disagreement norm over a window
+	//收敛速率：窗口内不一致量范数的对数衰减
+	if(c->Window_Ticks == 0) c->Window_Start = disagreement;
+	if(++c->Window_Ticks >= CONSENSUS_RATE_TICKS)
+	{
+		if(c->Window_Start > 1e-6f && disagreement > 1e-6f)
+			c->Rate = 0.5f * logf(c->Window_Start / disagreement) / (CONSENSUS_RATE_TICKS * dt);
+		c->Window_Ticks = 0;
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef __FORMATION_CONSENSUS_H
+#define __FORMATION_CONSENSUS_H
+#include <stdint.h>
+#include "esp8266_driver.h"
+
+//Distributed consensus formation. Every car has a slot d in a common formation
+//frame and drives its own offset corrected position p-d towards that of every
+//neighbour the topology lets it hear (graph Laplacian):
+//  u_i = mean(v_j) + K * sum a_ji*w_j*((p_j-d_j) - (p_i-d_i))
+//The formation frame turns with the car's heading, the headings agree through
+//the same graph. No car is special, losing one car only removes one edge
+//instead of stopping the others. FORMATION:CONSENSUS is broadcast, every
+//car that receives it runs the law except a FORMATION:LEADER car. That one
+//keeps driving on its own commands and is a velocity source: its neighbours
+//average its velocity in and are pulled to its position, so the formation
+//translates with it. Without a leader the group only gathers in place.
+//分布式一致性编队。每辆车在公共编队坐标系中有一个位置d，使自身去偏移后的位置p-d向拓扑允许
+//接收的所有邻居靠拢(图拉普拉斯)。编队坐标系随航向旋转，航向同样通过该图达成一致。
+//没有特殊的车，丢失一辆车只会去掉一条边，不会让其他车停车。FORMATION:CONSENSUS为广播指令，
+//除FORMATION:LEADER领航者外收到的每辆车都运行该控制律。领航者继续按自身指令行驶，作为速度源：
+//邻居对其速度取平均并向其位置靠拢，编队随之整体平移。没有领航者时各车只原地聚拢
+
+#define CONSENSUS_GAIN         0.6f     //Position gain per neighbour, 1/s //每个邻居的位置增益，1/s
+#define CONSENSUS_FRESH_MS     300      //Neighbour data younger than this has full weight //小于该时间的邻居数据权重为1
+#define CONSENSUS_STALE_MS     1500     //Weight falls linearly to 0 at this age //权重在该时间线性降为0
+#define CONSENSUS_PREDICT_MS   500      //Neighbour positions are extrapolated at most this far //邻居位置最多外推该时间
+#define CONSENSUS_RAMP_MS      500      //An edge added or removed by a topology switch fades over this time //拓扑切换增删的边在该时间内渐变
+#define CONSENSUS_DEADBAND     0.03f    //Disagreement ignored, m //忽略的不一致量，m
+#define CONSENSUS_RATE_TICKS   50       //Window of the convergence rate estimate, control cycles //收敛速率估计窗口，控制周期数
+
+typedef struct
+{
+	float Gain;
+	float Slot_X[MAX_CARS], Slot_Y[MAX_CARS];   //Slot of every car in the formation frame, m //各车在编队坐标系中的位置，m
+
+	//State, readable from the debugger //状态，可在调试器中查看
+	float Weight[MAX_CARS];       //Edge weight after staleness and fading //考虑数据时效和渐变后的边权重
+	uint8_t Neighbours;           //Edges with a non zero weight //权重非零的边数
+	float Disagreement;           //sum w*|e|^2 over the own edges, m^2 //本车各边的加权误差平方和，m^2
+	float Rate;                   //Measured decay rate of the disagreement norm, 1/s //实测不一致量范数的衰减速率，1/s
+	float Lambda2;                //Algebraic connectivity of the symmetrised topology //对称化拓扑的代数连通度
+	float Window_Start;
+	uint16_t Window_Ticks;
+	uint32_t Topology_Sign;       //Detects a topology switch //用于检测拓扑切换
+}Formation_Consensus_t;
+
+//Static initialiser, slots all at the origin //静态初始化，所有位置在原点
+#define FORMATION_CONSENSUS_DEFAULT { CONSENSUS_GAIN }
+
+void Formation_Consensus_Reset(Formation_Consensus_t *c);
+void Formation_Consensus_Update(Formation_Consensus_t *c, uint8_t self, float px, float py, float yaw_deg,
+                                float dt, float *vx_world, float *vy_world, float *yaw_target);
+
+#endif
@@ -1,48 +1,60 @@
 #include "formation_control.h"
 #include "balance.h"
+#include "stream_filter.h"
+#include "yaw_control.h"
+#include "fast_math.h"
+#include "formation_mpc.h"
+#include "formation_consensus.h"
+#include "num_parse.h"
+#include "mode_manager.h"
+#include "uwb.h"
 #include <math.h>
 #include <string.h>
+#include "float_only.h"
 
-// ӿƱ
-uint8_t Formation_mode = 0;           // ģʽ0-ޱӣ1-캽ߣ2-
-char Formation_leader[10] = "";       // 캽ID
-float Formation_offset_x = 0.0f;      // Xƫ
-float Formation_offset_y = 0.0f;      // Yƫ  
-float Formation_offset_yaw = 0.0f;    // ƫ
+// 编队控制变量
+uint8_t Formation_mode = 0;           // 编队模式：0-无编队，1-领航者，2-跟随者，3-一致性编队
+char Formation_leader[10] = "";       // 领航者ID
+float Formation_offset_x = 0.0f;      // X方向偏移
+float Formation_offset_y = 0.0f;      // Y方向偏移  
+float Formation_offset_yaw = 0.0f;    // 航向偏移
 
-// ӿƲ - ٶݵ
-float Formation_KP = 0.5f;            // ͱϵٳ 0.5
-float Formation_KD = 1.8f;            // ΢ϵƳ 1.2
-float Formation_max_speed = 0.3f;     // ٶ
-float Formation_tolerance = 0.15f;    // ݲ 0.15
-float Formation_min_speed = 0.05f;    // Сٶ
+// 编队控制参数 - 基于你的速度数据调整
+float Formation_KP = 0.5f;            // 降低比例系数，减少超调 0.5
+float Formation_KD = 1.8f;            // 增加微分系数，抑制超调 1.2
+float Formation_max_speed = 0.3f;     // 降低最大速度
+float Formation_tolerance = 0.15f;    // 增加容差，减少振荡 0.15
+float Formation_min_speed = 0.05f;    // 降低最小速度
 
-// ˶״̬
-#define VELOCITY_THRESHOLD 0.05f          // ٶֵСڴֵΪֹ
-#define ZERO_VELOCITY_COUNT_THRESHOLD 4  // ٶȼֵ
-#define MOVING_AVERAGE_SIZE 1             // ƶƽڴС
+// 新增运动状态检测参数
+#define VELOCITY_THRESHOLD 0.05f          // 速度阈值，小于此值认为静止
+#define ZERO_VELOCITY_COUNT_THRESHOLD 4  // 连续零速度计数阈值
+#define MOVING_AVERAGE_SIZE 1             // 移动平均窗口大小
 
-// ˶״̬
+// 运动状态检测变量
 static uint8_t zero_velocity_count = 0;
-static float velocity_history_vx[MOVING_AVERAGE_SIZE] = {0};
-static float velocity_history_vy[MOVING_AVERAGE_SIZE] = {0};
-static uint8_t velocity_history_index = 0;
-// ״̬
-static float prev_error_x = 0.0f, prev_error_y = 0.0f;
+static float velocity_history_vx[MOVING_AVERAGE_SIZE];
+static float velocity_history_vy[MOVING_AVERAGE_SIZE];
+static Filter_MAf_t leader_vx_average, leader_vy_average;
 
-// ϿƲ
-float Formation_speed_follow_threshold = 0.3f;  // ٶȸֵ
-float Formation_velocity_gain = 1.05f;            // ٶȸ
+// 新增混合控制参数
+float Formation_speed_follow_threshold = 0.3f;  // 速度跟随阈值
+float Formation_velocity_gain = 1.05f;            // 速度跟随增益
 
-// ״̬
-static uint8_t speed_following_mode = 0;  // ٶȸģʽ־
+// 新增控制状态
+static uint8_t speed_following_mode = 0;  // 速度跟随模式标志
+
+// 跟随者位置控制器：0-MPC，1-原PD与速度跟随切换
+uint8_t Formation_Controller = FORMATION_CTRL_MPC;
+// 跟随者与一致性编队的控制器实例由Mode_Manager持有，见mode_manager.h
+float Formation_Yaw_KP = YAW_ANGLE_KP_DEFAULT;   // 跟随者航向外环基准增益，按跟随模式缩放
 
 
 /**************************************************************************
-Function: ӿƴ
-Input   : 
-Output  : 
-ܣӿ߼
+Function: 编队控制处理
+Input   : 无
+Output  : 无
+函数功能：处理编队控制逻辑
 **************************************************************************/
 void Formation_Control(void)
 {
@@ -66,69 +78,110 @@ void Formation_Control(void)
     if (Formation_mode == FORMATION_MODE_FOLLOWER) {
         Formation_Follower_Control();
     }
+    
+    if (Formation_mode == FORMATION_MODE_CONSENSUS) {
+        Formation_Consensus_Control();
+    }
 }
 
 
 
 /**************************************************************************
-Function: 캽˶״̬
-Input   : 캽ٶvx, vy
-Output  : ˶״̬ (1=ƶ, 0=ֹ)
-ܣͨٶж캽Ƿƶ
+Function: 检测领航者运动状态
+Input   : 领航者速度vx, vy
+Output  : 运动状态 (1=移动, 0=静止)
+函数功能：通过连续速度数据判断领航者是否在移动
 **************************************************************************/
 uint8_t Detect_Leader_Motion_State(float vx, float vy)
 {
     static uint8_t initialized = 0;
     
-    // ʼٶʷ
+    // 初始化速度历史：整个窗口填入第一个样本
     if (!initialized) {
-        for (int i = 0; i < MOVING_AVERAGE_SIZE; i++) {
-            velocity_history_vx[i] = vx;
-            velocity_history_vy[i] = vy;
-        }
+        Filter_MAf_Init(&leader_vx_average, velocity_history_vx, MOVING_AVERAGE_SIZE);
+        Filter_MAf_Init(&leader_vy_average, velocity_history_vy, MOVING_AVERAGE_SIZE);
+        Filter_MAf_Reset(&leader_vx_average, vx);
+        Filter_MAf_Reset(&leader_vy_average, vy);
         initialized = 1;
     }
     
-    // ٶʷ
-    velocity_history_vx[velocity_history_index] = vx;
-    velocity_history_vy[velocity_history_index] = vy;
-    velocity_history_index = (velocity_history_index + 1) % MOVING_AVERAGE_SIZE;
+    // 计算移动平均速度
+    float avg_vx = Filter_MAf_Update(&leader_vx_average, vx);
+    float avg_vy = Filter_MAf_Update(&leader_vy_average, vy);
     
-    // ƶƽٶ
-    float avg_vx = 0, avg_vy = 0;
-    for (int i = 0; i < MOVING_AVERAGE_SIZE; i++) {
-        avg_vx += velocity_history_vx[i];
-        avg_vy += velocity_history_vy[i];
-    }
-    avg_vx /= MOVING_AVERAGE_SIZE;
-    avg_vy /= MOVING_AVERAGE_SIZE;
-    
-    // ٶȷֵ
-    float speed_magnitude = sqrtf(avg_vx * avg_vx + avg_vy * avg_vy);
+    // 计算速度幅值
+    float speed_magnitude = Fast_Sqrtf(avg_vx * avg_vx + avg_vy * avg_vy);
     
-    // ж˶״̬
+    // 判断运动状态
     if (speed_magnitude > VELOCITY_THRESHOLD) {
-        zero_velocity_count = 0;  // ٶȼ
-        return 1;  // ƶ״̬
+        zero_velocity_count = 0;  // 重置零速度计数
+        return 1;  // 移动状态
     } else {
-        zero_velocity_count++;    // ٶȼ
+        zero_velocity_count++;    // 增加零速度计数
         if (zero_velocity_count >= ZERO_VELOCITY_COUNT_THRESHOLD) {
-            return 0;  // ȷϾֹ״̬
+            return 0;  // 确认静止状态
         } else {
-            return 1;  // ʱΪƶ״ֹ̬У
+            return 1;  // 暂时还认为是移动状态（防止误判）
         }
     }
 }
 
 /**************************************************************************
-Function: Ӧӿ
-Input   : 
-Output  : 
-ܣ캽˶״̬Ӧлģʽ
+Function: MPC编队跟随
+Input   : leader_info - 领航者信息；leader_vx, leader_vy - 去死区后的领航者车体速度
+Output  : 无
+函数功能：以领航者预测轨迹上的编队位置为参考，求解带速度和加速度约束的MPC，
+          不再区分速度跟随和位置控制两种模式
+**************************************************************************/
+static void Formation_Follower_MPC(OtherCarInfo* leader_info, float leader_vx, float leader_vy)
+{
+    float age = (HAL_GetTick() - leader_info->last_update) * 0.001f;
+    float vx_world, vy_world, yaw_sin, yaw_cos, applied_vx, applied_vy, px, py;
+
+    // 变化量限制以上一周期实际执行的指令为起点(经过模式过渡、ORCA避碰和Smooth_control)
+    Fast_Sincosf(Yaw * FAST_DEG2RAD, &yaw_sin, &yaw_cos);
+    applied_vx = smooth_control.VX * yaw_cos - smooth_control.VY * yaw_sin;
+    applied_vy = smooth_control.VX * yaw_sin + smooth_control.VY * yaw_cos;
+    Formation_MPC_Applied(&Mode_Manager.Follower_MPC, applied_vx, applied_vy);
+
+    Mode_Manager.Follower_MPC.V_Max = Formation_max_speed;
+    Formation_MPC_Reference(&Mode_Manager.Follower_MPC, leader_info->position_x, leader_info->position_y, leader_info->yaw,
+                            leader_vx, leader_vy, leader_info->velocity_vz,
+                            Formation_offset_x, Formation_offset_y, age);
+    // 本车定位有Uwb.Age_Ms的延迟，与领航者数据一样按时长外推到当前时刻
+    Uwb_Position_Now(applied_vx, applied_vy, &px, &py);
+    Formation_MPC_Solve(&Mode_Manager.Follower_MPC, px, py, 1.0f / CONTROL_FREQUENCY, &vx_world, &vy_world);
+
+    // 世界坐标系速度旋转到车体坐标系
+    float control_vx =  vx_world * yaw_cos + vy_world * yaw_sin;
+    float control_vy = -vx_world * yaw_sin + vy_world * yaw_cos;
+
+    // 航向跟随领航者航向加偏移，目标航向的变化由航向控制器前馈
+    Mode_Manager.Formation_Yaw.Angle_Kp = Formation_Yaw_KP;
+    float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Formation_Yaw, Yaw,
+                                           Fast_Wrap180(leader_info->yaw + Formation_offset_yaw));
+
+    static uint32_t mpc_debug_count = 0;
+    if (++mpc_debug_count % 200 == 0) {
+        char debug_msg[128];
+        snprintf(debug_msg, sizeof(debug_msg), "[MPC] 误差%.3fm 指令(%.2f,%.2f) 求解%lu周期 最大%lu\r\n",
+                 (double)Mode_Manager.Follower_MPC.Error, (double)control_vx, (double)control_vy,
+                 (unsigned long)Mode_Manager.Follower_MPC.Cycles, (unsigned long)Mode_Manager.Follower_MPC.Cycles_Max);
+        usart1_send_cstring(debug_msg);
+    }
+
+    Drive_Motor(control_vx, control_vy, yaw_control);
+}
+
+/**************************************************************************
+Function: 自适应编队控制
+Input   : 无
+Output  : 无
+函数功能：根据领航者运动状态自适应切换控制模式
 **************************************************************************/
 void Formation_Follower_Control(void)
 {
-    // 캽Ϣ
+    // 查找领航者信息
     OtherCarInfo* leader_info = NULL;
     for (int i = 0; i < MAX_OTHER_CARS; i++) {
         if (other_cars[i].valid && strcmp(other_cars[i].car_id, Formation_leader) == 0) {
@@ -139,288 +192,405 @@ void Formation_Follower_Control(void)
     
     if (leader_info == NULL) {
         Drive_Motor(0, 0, 0);
-        prev_error_x = 0;
-        prev_error_y = 0;
+        Mode_Manager.Follower_Primed = 0;
         zero_velocity_count = 0;
+        Formation_MPC_Reset(&Mode_Manager.Follower_MPC, 0, 0);   // 已停车，MPC从静止重新开始
         return;
     }
     
-    // Ƿʱ2볬ʱ
+    // 检查数据是否超时（2秒超时）
     if (HAL_GetTick() - leader_info->last_update > 2000) {
         Drive_Motor(0, 0, 0);
-        prev_error_x = 0;
-        prev_error_y = 0;
+        Mode_Manager.Follower_Primed = 0;
         zero_velocity_count = 0;
+        Formation_MPC_Reset(&Mode_Manager.Follower_MPC, 0, 0);   // 已停车，MPC从静止重新开始
         return;
     }
     
-    // 򵥵
+    // 简单的死区处理
     float leader_vx = leader_info->velocity_vx;
     float leader_vy = leader_info->velocity_vy;
     
     if (fabsf(leader_vx) < 0.04f) leader_vx = 0.0f;
     if (fabsf(leader_vy) < 0.04f) leader_vy = 0.0f;
 
-    // 캽˶״̬
+    if (Formation_Controller == FORMATION_CTRL_MPC) {
+        Formation_Follower_MPC(leader_info, leader_vx, leader_vy);
+        return;
+    }
+
+    // 检测领航者运动状态
     uint8_t leader_moving = Detect_Leader_Motion_State(leader_vx, leader_vy);
     
-    // 캽ϵµĿλ
-    float leader_rad = leader_info->yaw * PI / 180.0f;
+    // 计算在领航者坐标系下的目标位置
+    float leader_sin, leader_cos;
+    Fast_Sincosf(leader_info->yaw * FAST_DEG2RAD, &leader_sin, &leader_cos);
     
     float target_x_world = leader_info->position_x + 
-                          Formation_offset_x * cosf(leader_rad) - 
-                          Formation_offset_y * sinf(leader_rad);
+                          Formation_offset_x * leader_cos - 
+                          Formation_offset_y * leader_sin;
     
     float target_y_world = leader_info->position_y + 
-                          Formation_offset_x * sinf(leader_rad) + 
-                          Formation_offset_y * cosf(leader_rad);
+                          Formation_offset_x * leader_sin + 
+                          Formation_offset_y * leader_cos;
+    
+    float target_yaw_world = Fast_Wrap180(leader_info->yaw + Formation_offset_yaw);
     
-    float target_yaw_world = leader_info->yaw + Formation_offset_yaw;
-    while (target_yaw_world >= 360.0f) target_yaw_world -= 360.0f;
-    while (target_yaw_world < 0.0f)    target_yaw_world += 360.0f;
+    // 本车航向的正余弦，世界坐标系到车体坐标系的旋转每周期只计算一次
+    float yaw_sin, yaw_cos;
+    Fast_Sincosf(Yaw * FAST_DEG2RAD, &yaw_sin, &yaw_cos);
     
-    // λ
+    // 计算位置误差
     float error_x = target_x_world - position[0];
     float error_y = target_y_world - position[1];
-    float error_yaw = target_yaw_world - Yaw;
     
-    // 淶
-    while (error_yaw > 180.0f) error_yaw -= 360.0f;
-    while (error_yaw < -180.0f) error_yaw += 360.0f;
+    // 新进入跟随或重新获得领航者时，从当前误差开始计算微分
+    if (!Mode_Manager.Follower_Primed) {
+        Mode_Manager.Follower_Prev_Ex = error_x;
+        Mode_Manager.Follower_Prev_Ey = error_y;
+        Mode_Manager.Follower_Primed = 1;
+    }
     
-    // 
-    float distance = sqrtf(error_x * error_x + error_y * error_y);
+    // 计算距离
+    float distance = Fast_Sqrtf(error_x * error_x + error_y * error_y);
     
     float control_vx, control_vy; 
     
-    // ========== ĽӦƲ ==========
+    // ========== 改进的自适应控制策略 ==========
     
-    // 1. Ľģʽл߼ۺϿ캽״̬λ
+    // 1. 改进的模式切换逻辑：综合考虑领航者状态和位置误差
     uint8_t should_use_speed_follow = 0;
     
     if (leader_moving) {
-        // 캽ƶʱλģʽ
+        // 领航者在移动时，根据位置误差决定模式
         if (distance < Formation_tolerance * 2.0f) {
-            // λСʹٶȸģʽ
+            // 位置误差较小：使用速度跟随模式
             should_use_speed_follow = 1;
         } else if (distance < Formation_tolerance * 3.0f) {
-            // е
-            // 캽˶һ£ʹٶȸ
-            float leader_speed_angle = atan2f(leader_vy, leader_vx);
-            float error_angle = atan2f(error_y, error_x);
+            // 中等误差：根据误差方向决定
+            // 如果误差方向与领航者运动方向一致，使用速度跟随
+            float leader_speed_angle = Fast_Atan2f(leader_vy, leader_vx);
+            float error_angle = Fast_Atan2f(error_y, error_x);
             float angle_diff = fabsf(leader_speed_angle - error_angle);
             if (angle_diff < PI/4.0f || angle_diff > 7.0f*PI/4.0f) {
                 should_use_speed_follow = 1;
             }
         }
-        // ±λÿģʽ
+        // 大误差情况下保持位置控制模式
     }
-    // 캽߾ֹʱʼʹλÿģʽ
+    // 领航者静止时始终使用位置控制模式
     
     if (should_use_speed_follow) {
-        // ========== ٶȸģʽ ==========
-        // 캽ƶλɿأҪִٶȸ
+        // ========== 速度跟随模式 ==========
+        // 领航者在移动且位置误差可控：主要执行速度跟随
         
         control_vx = leader_vx * Formation_velocity_gain;
         control_vy = leader_vy * Formation_velocity_gain;
         
-        // 첹
-        float yaw_difference = leader_info->yaw - Yaw;
-        while (yaw_difference > 180.0f) yaw_difference -= 360.0f;
-        while (yaw_difference < -180.0f) yaw_difference += 360.0f;
-        
-        float yaw_diff_rad = yaw_difference * PI / 180.0f;
+        // 朝向差异补偿
+        float yaw_difference = Fast_Wrap180(leader_info->yaw - Yaw);
         
         if (fabsf(yaw_difference) > 10.0f) {
-            float rotated_vx = control_vx * cosf(yaw_diff_rad) - control_vy * sinf(yaw_diff_rad);
-            float rotated_vy = control_vx * sinf(yaw_diff_rad) + control_vy * cosf(yaw_diff_rad);
+            float diff_sin, diff_cos;
+            Fast_Sincosf(yaw_difference * FAST_DEG2RAD, &diff_sin, &diff_cos);
+            float rotated_vx = control_vx * diff_cos - control_vy * diff_sin;
+            float rotated_vy = control_vx * diff_sin + control_vy * diff_cos;
             control_vx = rotated_vx;
             control_vy = rotated_vy;
         }
         
-        // 2. Ľλԣʽ̬
+        // 2. 改进的位置修正策略：渐进式动态修正
         if (distance > Formation_tolerance) {
-            // ̬棺ԽԽǿ
-            float base_gain = 0.05f;  // 
+            // 动态计算修正增益：误差越大，修正越强
+            float base_gain = 0.05f;  // 基础修正增益
             float dynamic_gain = 0.0f;
             
-            // ݾ̬
+            // 根据距离误差动态调整增益
             if (distance > Formation_tolerance && distance < 1.0f) {
                 dynamic_gain = (distance - Formation_tolerance) * 0.1f;
             } else if (distance >= 1.0f) {
-                dynamic_gain = 0.15f;  // 
+                dynamic_gain = 0.15f;  // 最大修正增益
             }
             
             float total_position_gain = base_gain + dynamic_gain;
             
-            // ٶȣٶȸͻ
+            // 限制最大修正速度，避免与速度跟随冲突
             float max_correction_speed = Formation_max_speed * 0.4f;
             
-            // 
-            float error_rad = atan2f(error_y, error_x);
-            float error_angle_relative = error_rad - (Yaw * PI / 180.0f);
+            // 计算修正向量：位置误差旋转到车体坐标系，与按误差方向角分解的结果相同
+            float correction_vx = total_position_gain * ( error_x * yaw_cos + error_y * yaw_sin);
+            float correction_vy = total_position_gain * (-error_x * yaw_sin + error_y * yaw_cos);
             
-            float correction_vx = total_position_gain * distance * cosf(error_angle_relative);
-            float correction_vy = total_position_gain * distance * sinf(error_angle_relative);
-            
-            // ٶ
-            float correction_speed = sqrtf(correction_vx * correction_vx + correction_vy * correction_vy);
+            // 限制修正速度
+            float correction_speed = Fast_Sqrtf(correction_vx * correction_vx + correction_vy * correction_vy);
             if (correction_speed > max_correction_speed) {
                 correction_vx = correction_vx * max_correction_speed / correction_speed;
                 correction_vy = correction_vy * max_correction_speed / correction_speed;
             }
             
-            // Ӧλ
+            // 应用位置修正
             control_vx += correction_vx;
             control_vy += correction_vy;
         }
         
     } else {
-        // ========== λÿģʽ ==========
-        // 캽߾ֹλϴִλУ
+        // ========== 位置控制模式 ==========
+        // 领航者静止或位置误差较大：执行位置校正
         
-        // 仯
-        float error_derivative_x = error_x - prev_error_x;
-        float error_derivative_y = error_y - prev_error_y;
+        // 计算误差变化率
+        float error_derivative_x = error_x - Mode_Manager.Follower_Prev_Ex;
+        float error_derivative_y = error_y - Mode_Manager.Follower_Prev_Ey;
         
-        // PD
+        // PD控制
         control_vx = Formation_KP * error_x + Formation_KD * error_derivative_x;
         control_vy = Formation_KP * error_y + Formation_KD * error_derivative_y;
         
-        // ӽĿʱļ - Ľļ
+        // 接近目标时的减速 - 改进的减速曲线
         float distance_factor = 1.0f;
         if (distance < 0.5f) {
-            // ƽļ
+            // 更平滑的减速
             distance_factor = 0.2f + 0.8f * (distance / 0.5f);
         }
         
         control_vx *= distance_factor;
         control_vy *= distance_factor;
         
-        // ϵת
-        float control_angle_global = atan2f(control_vy, control_vx);
-        float control_angle_relative = control_angle_global - (Yaw * PI / 180.0f);
-        float control_magnitude = sqrtf(control_vx * control_vx + control_vy * control_vy);
-        
-        control_vx = control_magnitude * cosf(control_angle_relative);
-        control_vy = control_magnitude * sinf(control_angle_relative);
+        // 坐标系转换：世界坐标系速度旋转到车体坐标系
+        float world_vx = control_vx;
+        control_vx =  world_vx * yaw_cos + control_vy * yaw_sin;
+        control_vy = -world_vx * yaw_sin + control_vy * yaw_cos;
     }
     
-    // ========== ƴ ==========
+    // ========== 公共控制处理 ==========
     
-    // ٶ
-    float control_speed = sqrtf(control_vx * control_vx + control_vy * control_vy);
+    // 速度限制
+    float control_speed = Fast_Sqrtf(control_vx * control_vx + control_vy * control_vy);
     if (control_speed > Formation_max_speed) {
         control_vx = control_vx * Formation_max_speed / control_speed;
         control_vy = control_vy * Formation_max_speed / control_speed;
     }
     
-    //  - ģʽ
+    // 航向控制 - 根据模式调整增益
     float yaw_gain = should_use_speed_follow ? 0.8f : 1.2f;
-    float yaw_control = Yaw_PID_Control(Yaw, target_yaw_world) * yaw_gain;
+    Mode_Manager.Formation_Yaw.Angle_Kp = Formation_Yaw_KP * yaw_gain;
+    float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Formation_Yaw, Yaw, target_yaw_world);
     
-    // 
+    // 输出控制
     Drive_Motor(control_vx, control_vy, yaw_control);
     
-    // 
-    prev_error_x = error_x;
-    prev_error_y = error_y;
+    // 保存误差
+    Mode_Manager.Follower_Prev_Ex = error_x;
+    Mode_Manager.Follower_Prev_Ey = error_y;
 }
 
 /**************************************************************************
-Function: ָ
-Input   : ַָ
-Output  : 
-ܣִбӿָ
+Function: 跟随者控制状态复位
+Input   : vx_now, vy_now, vz_now - 当前送入Drive_Motor的车体速度指令
+Output  : 无
+函数功能：进入跟随模式时由模式管理器调用，丢弃旧的误差历史，
+          航向环和MPC规划从当前速度指令开始
+**************************************************************************/
+void Formation_Follower_Reset(float vx_now, float vy_now, float vz_now)
+{
+    float yaw_sin, yaw_cos;
+
+    Mode_Manager.Follower_Primed = 0;
+    zero_velocity_count = 0;
+    Yaw_Cascade_Bumpless(&Mode_Manager.Formation_Yaw, vz_now);
+    Fast_Sincosf(Yaw * FAST_DEG2RAD, &yaw_sin, &yaw_cos);
+    Formation_MPC_Reset(&Mode_Manager.Follower_MPC, vx_now * yaw_cos - vy_now * yaw_sin, vx_now * yaw_sin + vy_now * yaw_cos);
+}
+
+/**************************************************************************
+Function: 一致性编队控制
+Input   : 无
+Output  : 无
+函数功能：根据拓扑允许接收的所有邻居计算速度和航向，不依赖单一领航者，
+          邻居全部超时后原地保持
+**************************************************************************/
+void Formation_Consensus_Control(void)
+{
+    float vx_world, vy_world, yaw_target, yaw_sin, yaw_cos;
+    
+    Formation_Consensus_Update(&Mode_Manager.Consensus, car_index, position[0], position[1], Yaw,
+                               1.0f / CONTROL_FREQUENCY, &vx_world, &vy_world, &yaw_target);
+    
+    // 速度限制后旋转到车体坐标系
+    float speed = Fast_Sqrtf(vx_world * vx_world + vy_world * vy_world);
+    if (speed > Formation_max_speed) {
+        vx_world *= Formation_max_speed / speed;
+        vy_world *= Formation_max_speed / speed;
+    }
+    Fast_Sincosf(Yaw * FAST_DEG2RAD, &yaw_sin, &yaw_cos);
+    float control_vx =  vx_world * yaw_cos + vy_world * yaw_sin;
+    float control_vy = -vx_world * yaw_sin + vy_world * yaw_cos;
+    
+    Mode_Manager.Formation_Yaw.Angle_Kp = Formation_Yaw_KP;
+    float yaw_control = Yaw_Cascade_Update(&Mode_Manager.Formation_Yaw, Yaw, yaw_target);
+    
+    static uint32_t consensus_debug_count = 0;
+    if (++consensus_debug_count % 200 == 0) {
+        char debug_msg[128];
+        snprintf(debug_msg, sizeof(debug_msg), "[一致性] 邻居%d 不一致量%.4f 收敛速率%.2f/s 连通度%.2f\r\n",
+                 Mode_Manager.Consensus.Neighbours, (double)Mode_Manager.Consensus.Disagreement,
+                 (double)Mode_Manager.Consensus.Rate, (double)Mode_Manager.Consensus.Lambda2);
+        usart1_send_cstring(debug_msg);
+    }
+    
+    Drive_Motor(control_vx, control_vy, yaw_control);
+}
+
+/**************************************************************************
+Function: 一致性编队控制状态复位
+Input   : vz_now - 当前送入Drive_Motor的旋转指令
+Output  : 无
+函数功能：进入一致性编队时由模式管理器调用，所有边重新渐入
+**************************************************************************/
+void Formation_Consensus_Enter(float vz_now)
+{
+    Formation_Consensus_Reset(&Mode_Manager.Consensus);
+    Yaw_Cascade_Bumpless(&Mode_Manager.Formation_Yaw, vz_now);
+}
+
+/**************************************************************************
+Function: 处理编队指令
+Input   : 指令字符串
+Output  : 无
+函数功能：解析和执行编队控制指令
 **************************************************************************/
 void Process_Formation_Command(const char* command)
 {
     char debug_msg[256];
     
-    // ȴӡյԭʼָ
+    // 首先打印接收到的原始指令
     snprintf(debug_msg, sizeof(debug_msg), 
-             "[] յָ: %s\r\n", command);
+             "[编队] 收到指令: %s\r\n", command);
     debug_print(debug_msg);
     
-    // ָֹͣ
+    // 检查编队停止指令
     if (strstr(command, "FORMATION:STOP") != NULL) {
         Formation_mode = FORMATION_MODE_NONE;
         Formation_leader[0] = '\0';
         
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] ֹͣӿ\r\n");
+                 "[编队] 停止编队控制\r\n");
         debug_print(debug_msg);
         return;
     }
     
-    // ԭеıָ߼ֲ
+    // 原有的编队指令处理逻辑保持不变
     if (strstr(command, "FORMATION:LEADER") != NULL) {
-        // Ϊ캽
+        // 设置为领航者
         Formation_mode = FORMATION_MODE_LEADER;
         strcpy(Formation_leader, CAR_ID);
-        Auto_mode = 1; // Զģʽ
+        Auto_mode = 1; // 启用自动模式
         
-        // 
+        // 解析队形类型
         char formation_type[20];
-        if (sscanf(command, "FORMATION:LEADER,%s", formation_type) == 1) {
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, strstr(command, "FORMATION:LEADER") + 16, 32);
+        if (Num_Expect(&cur, ',') && Num_Token(&cur, formation_type, sizeof(formation_type), 0)) {
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] Ϊ캽ߣ:%s\r\n", formation_type);
+                     "[编队] 设置为领航者，队形:%s\r\n", formation_type);
         } else {
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] Ϊ캽\r\n");
+                     "[编队] 设置为领航者\r\n");
         }
         debug_print(debug_msg);
     }
     else if (strstr(command, "FORMATION:FOLLOWER") != NULL) {
-        // Ϊ
+        // 设置为跟随者
         char leader_id[10];
         float offset_x, offset_y, offset_yaw;
+        Num_Cursor_t cur;
         
-        if (sscanf(command, "FORMATION:FOLLOWER,%[^,],%f,%f,%f", 
-                   leader_id, &offset_x, &offset_y, &offset_yaw) == 4) {
+        Num_Cursor_Init(&cur, strstr(command, "FORMATION:FOLLOWER") + 18, 64);
+        if (Num_Expect(&cur, ',') && Num_Token(&cur, leader_id, sizeof(leader_id), ',') && Num_Expect(&cur, ',') &&
+            Num_Float(&cur, &offset_x) && Num_Expect(&cur, ',') &&
+            Num_Float(&cur, &offset_y) && Num_Expect(&cur, ',') && Num_Float(&cur, &offset_yaw)) {
             Formation_mode = FORMATION_MODE_FOLLOWER;
             strcpy(Formation_leader, leader_id);
             Formation_offset_x = offset_x;
             Formation_offset_y = offset_y;
             Formation_offset_yaw = offset_yaw;
-            Auto_mode = 1; // Զģʽ
+            Auto_mode = 1; // 启用自动模式
             
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] Ϊߣ캽:%s ƫ(%.2f,%.2f,%.1f)\r\n", 
-                     leader_id, offset_x, offset_y, offset_yaw);
+                     "[编队] 设置为跟随者，领航者:%s 偏移(%.2f,%.2f,%.1f)\r\n", 
+                     leader_id, (double)offset_x, (double)offset_y, (double)offset_yaw);
+            debug_print(debug_msg);
+        } else {
+            snprintf(debug_msg, sizeof(debug_msg), 
+                     "[编队] 跟随者指令解析失败，位置%d\r\n", cur.Error_Pos);
+            debug_print(debug_msg);
+        }
+    }
+    else if (strstr(command, "FORMATION:CONSENSUS") != NULL) {
+        // 一致性编队，同一条指令广播给所有车，按CAR1~CAR4的顺序给出各车在编队坐标系中的位置
+        // 格式: "FORMATION:CONSENSUS,x1,y1,x2,y2,x3,y3,x4,y4"
+        float slot[2 * MAX_CARS];
+        Num_Cursor_t cur;
+        int n = 0;
+        
+        Num_Cursor_Init(&cur, strstr(command, "FORMATION:CONSENSUS") + 19, 128);
+        while (n < 2 * MAX_CARS && Num_Expect(&cur, ',') && Num_Float(&cur, &slot[n])) n++;
+        if (n == 2 * MAX_CARS) {
+            for (int i = 0; i < MAX_CARS; i++) {
+                Mode_Manager.Consensus.Slot_X[i] = slot[2 * i];
+                Mode_Manager.Consensus.Slot_Y[i] = slot[2 * i + 1];
+            }
+            Auto_mode = 1; // 启用自动模式
+            if (Formation_mode == FORMATION_MODE_LEADER) {
+                // 领航者继续按自身指令行驶，作为一致性编队的速度源，其他车的速度前馈和位置耦合都会跟随它，
+                // 否则所有车只相互靠拢，编队无法整体平移
+                snprintf(debug_msg, sizeof(debug_msg), 
+                         "[编队] 一致性编队，本车保持领航者作为速度源，位置(%.2f,%.2f)\r\n", 
+                         (double)Mode_Manager.Consensus.Slot_X[car_index], (double)Mode_Manager.Consensus.Slot_Y[car_index]);
+            } else {
+                Formation_mode = FORMATION_MODE_CONSENSUS;
+                Formation_leader[0] = '\0';
+                snprintf(debug_msg, sizeof(debug_msg), 
+                         "[编队] 一致性编队，本车位置(%.2f,%.2f)\r\n", 
+                         (double)Mode_Manager.Consensus.Slot_X[car_index], (double)Mode_Manager.Consensus.Slot_Y[car_index]);
+            }
             debug_print(debug_msg);
         } else {
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] ָʧ\r\n");
+                     "[编队] 一致性编队指令解析失败，位置%d\r\n", cur.Error_Pos);
             debug_print(debug_msg);
         }
     }
     else if (strstr(command, "FORMATION:UPDATE") != NULL) {
-        // ±ƫ
+        // 更新编队偏移量
         Process_Formation_Update(command);
     }
     else {
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] δָ֪: %s\r\n", command);
+                 "[编队] 未知编队指令: %s\r\n", command);
         debug_print(debug_msg);
     }
 }
 
 /**************************************************************************
-Function: Ӹָ
-Input   : ַָ
-Output  : 
-ܣִбӸָ
+Function: 处理编队更新指令
+Input   : 指令字符串
+Output  : 无
+函数功能：解析和执行编队更新指令
 **************************************************************************/
 void Process_Formation_Update(const char* command)
 {
     char leader_id[10];
     float offset_x, offset_y, offset_yaw;
-    
-    if (sscanf(command, "FORMATION:UPDATE,%[^,],%f,%f,%f", 
-               leader_id, &offset_x, &offset_y, &offset_yaw) == 4) {
+    const char* update_ptr = strstr(command, "FORMATION:UPDATE");
+    Num_Cursor_t cur;
+    
+    if (update_ptr == NULL) return;
+    Num_Cursor_Init(&cur, update_ptr + 16, 64);
+    if (Num_Expect(&cur, ',') && Num_Token(&cur, leader_id, sizeof(leader_id), ',') && Num_Expect(&cur, ',') &&
+        Num_Float(&cur, &offset_x) && Num_Expect(&cur, ',') &&
+        Num_Float(&cur, &offset_y) && Num_Expect(&cur, ',') && Num_Float(&cur, &offset_yaw)) {
         
-        // ǷǱ캽
+        // 检查是否是本车跟随的领航者
         if (Formation_mode == FORMATION_MODE_FOLLOWER && strcmp(leader_id, Formation_leader) == 0) {
             Formation_offset_x = offset_x;
             Formation_offset_y = offset_y;
@@ -428,8 +598,8 @@ void Process_Formation_Update(const char* command)
             
             char debug_msg[128];
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[] ƫ (%.2f,%.2f,%.1f)\r\n", 
-                     offset_x, offset_y, offset_yaw);
+                     "[编队] 更新偏移量 (%.2f,%.2f,%.1f)\r\n", 
+                     (double)offset_x, (double)offset_y, (double)offset_yaw);
             usart1_send_cstring(debug_msg);
         }
     }
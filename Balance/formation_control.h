@@ -4,48 +4,59 @@
 #include "main.h"
 #include "esp8266_driver.h"
 #include "balance.h"
+#include "formation_consensus.h"
 #include <math.h>
 #include <string.h>
-// ӿģʽ
+// 编队控制模式
 #define FORMATION_MODE_NONE      0
 #define FORMATION_MODE_LEADER    1
 #define FORMATION_MODE_FOLLOWER  2
+#define FORMATION_MODE_CONSENSUS 3        // 分布式一致性编队，按通信拓扑与所有邻居协同
 
-// ӿƲ
-#define FORMATION_TOLERANCE      0.08f    // λݲ
-#define FORMATION_MAX_SPEED      0.5f     // ٶ
-#define FORMATION_LEADER_TIMEOUT 4000     // 캽ݳʱʱ(ms)
-// ˶״̬
+// 编队控制参数
+#define FORMATION_TOLERANCE      0.08f    // 编队位置容差
+#define FORMATION_MAX_SPEED      0.5f     // 编队最大速度
+#define FORMATION_LEADER_TIMEOUT 4000     // 领航者数据超时时间(ms)
+// 新增运动状态检测参数
 #define VELOCITY_THRESHOLD 0.05f
 #define ZERO_VELOCITY_COUNT_THRESHOLD 10
 #define MOVING_AVERAGE_SIZE 5
-// ӿƱ
+// 编队控制变量
 extern uint8_t Formation_mode;
 extern char Formation_leader[10];
 extern float Formation_offset_x;
 extern float Formation_offset_y;
 extern float Formation_offset_yaw;
 
-// ϿƲ
-#define FORMATION_SPEED_FOLLOW_THRESHOLD 0.15f  // ٶȸֵ
-#define FORMATION_VELOCITY_GAIN 0.8f            // ٶȸ
+// 新增混合控制参数
+#define FORMATION_SPEED_FOLLOW_THRESHOLD 0.15f  // 速度跟随阈值
+#define FORMATION_VELOCITY_GAIN 0.8f            // 速度跟随增益
 
 extern float Formation_speed_follow_threshold;
 extern float Formation_velocity_gain;
 
-// ӿƲ
+// 编队控制参数
 extern float Formation_KP;
 extern float Formation_KD;
 extern float Formation_max_speed;
 extern float Formation_tolerance;
 extern float Formation_min_speed;
+extern float Formation_Yaw_KP;
 
+// 跟随者位置控制器
+#define FORMATION_CTRL_MPC 0   // 模型预测控制
+#define FORMATION_CTRL_PD  1   // 原速度跟随/PD切换控制
+extern uint8_t Formation_Controller;
 
-// 
+
+// 函数声明
 uint8_t Detect_Leader_Motion_State(float vx, float vy);
-// 
+// 函数声明
 void Formation_Control(void);
 void Formation_Follower_Control(void);
+void Formation_Follower_Reset(float vx_now, float vy_now, float vz_now);
+void Formation_Consensus_Control(void);
+void Formation_Consensus_Enter(float vz_now);
 void Process_Formation_Command(const char* command);
 void Process_Formation_Update(const char* command);
 
@@ -0,0 +1,288 @@
+#include "formation_mpc.h"
+#include "fast_math.h"
+#include "delay.h"
+#include "float_only.h"
+
+#define N MPC_HORIZON
+
+//Clip a vector to a radius around a centre //将向量限制在以某点为圆心的半径内
+static void MPC_Clip(float *x, float *y, float cx, float cy, float radius)
+{
+	float dx = *x - cx, dy = *y - cy, d2 = dx * dx + dy * dy, scale;
+
+	if(d2 <= radius * radius) return;
+	scale = radius / Fast_Sqrtf(d2);
+	*x = cx + dx * scale;
+	*y = cy + dy * scale;
+}
+
+//Inside a disc, with room for the rounding of a point clipped onto its edge
+//在圆盘内，允许限制到圆周上的点存在舍入误差
+static uint8_t MPC_Inside(float x, float y, float cx, float cy, float radius)
+{
+	return (x - cx) * (x - cx) + (y - cy) * (y - cy) <= radius * radius * 1.0001f + 1e-12f;
+}
+
+//Euclidean projection onto the lens |v| <= r1, |v-c| <= r2. If clipping to one
+//disc lands inside the other that is the projection, otherwise both bounds are
+//active and it is the nearer crossing point of the circles. Discs that do not
+//meet (c beyond r1+r2) give the point of the speed disc nearest to c
+//投影到透镜形区域|v| <= r1，|v-c| <= r2。若限制到一个圆盘后落在另一个圆盘内，即为投影结果；
+//否则两个约束同时起作用，结果为两圆交点中较近的一个。两圆盘不相交时取速度圆盘上离c最近的点
+static void MPC_Project_Lens(float *x, float *y, float cx, float cy, float r1, float r2)
+{
+	float px = *x, py = *y, d2, d, a, h, bx, by, ux, uy, x1, y1, x2, y2;
+
+	MPC_Clip(&px, &py, 0.0f, 0.0f, r1);
+	if(MPC_Inside(px, py, cx, cy, r2)) { *x = px; *y = py; return; }
+	px = *x; py = *y;
+	MPC_Clip(&px, &py, cx, cy, r2);
+	if(MPC_Inside(px, py, 0.0f, 0.0f, r1)) { *x = px; *y = py; return; }
+
+	d2 = cx * cx + cy * cy;
+	d = Fast_Sqrtf(d2);
+	if(d >= r1 + r2 || d < 1e-6f)
+	{
+		//No crossing: empty lens, or concentric discs already handled above
+		//无交点：透镜为空，或同心圆盘(已在上面处理)
+		*x = cx; *y = cy;
+		MPC_Clip(x, y, 0.0f, 0.0f, r1);
+		return;
+	}
+	//Crossing points: a along c from the origin, h to either side
+	//交点：沿c方向距原点a，两侧各偏h
+	a = (r1 * r1 - r2 * r2 + d2) / (2.0f * d);
+	h = r1 * r1 - a * a;
+	h = h > 0.0f ? Fast_Sqrtf(h) : 0.0f;
+	ux = cx / d; uy = cy / d;
+	bx = a * ux; by = a * uy;
+	x1 = bx - h * uy; y1 = by + h * ux;
+	x2 = bx + h * uy; y2 = by - h * ux;
+	if((x1 - *x) * (x1 - *x) + (y1 - *y) * (y1 - *y) <= (x2 - *x) * (x2 - *x) + (y2 - *y) * (y2 - *y))
+	{
+		*x = x1; *y = y1;
+	}
+	else
+	{
+		*x = x2; *y = y2;
+	}
+}
+
+/**************************************************************************
+Function: Load the default weights and limits and clear the plan
+Input   : m: controller
+Output  : none
+函数功能：装载默认权重与约束并清空规划
+入口参数：m：控制器
+返回  值：无
+**************************************************************************/
+void Formation_MPC_Init(Formation_MPC_t *m)
+{
+	m->Q_Pos  = MPC_Q_POS;
+	m->R_Vel  = MPC_R_VEL;
+	m->S_Move = MPC_S_MOVE;
+	m->V_Max  = 0.3f;
+	m->A_Max  = MPC_A_MAX;
+	m->Cycles_Max = 0;
+	Formation_MPC_Reset(m, 0, 0);
+}
+
+/**************************************************************************
+Function: Restart the plan from the velocity commanded now
+Input   : m: controller; vx_world, vy_world: current command, world frame, m/s
+Output  : none
+函数功能：从当前指令速度重新开始规划
+入口参数：m：控制器；vx_world，vy_world：当前指令速度，世界坐标系，m/s
+返回  值：无
+**************************************************************************/
+void Formation_MPC_Reset(Formation_MPC_t *m, float vx_world, float vy_world)
+{
+	int k;
+
+	for(k = 0; k < N; k++)
+	{
+		m->Plan_VX[k] = vx_world;
+		m->Plan_VY[k] = vy_world;
+	}
+	m->Last_VX = vx_world;
+	m->Last_VY = vy_world;
+}
+
+/**************************************************************************
+Function: Record the command the car drove last tick, the rate limit of the next command starts from it
+Input   : m: controller; vx_world, vy_world: command after the mode blend, ORCA and Smooth_control, world frame, m/s
+Output  : none
+函数功能：记录上一周期小车实际执行的指令，下一条指令的变化量限制以此为起点
+入口参数：m：控制器；vx_world，vy_world：经过模式过渡、ORCA和Smooth_control后的指令，世界坐标系，m/s
+返回  值：无
+**************************************************************************/
+void Formation_MPC_Applied(Formation_MPC_t *m, float vx_world, float vy_world)
+{
+	m->Last_VX = vx_world;
+	m->Last_VY = vy_world;
+}
+
+/**************************************************************************
+Function: Predict the formation slot over the horizon from the last leader report
+Input   : m: controller; leader_x, leader_y: m; leader_yaw_deg: degree;
+          leader_vx, leader_vy: leader body velocity, m/s; leader_wz: rad/s;
+          offset_x, offset_y: slot in the leader frame, m; age_s: age of the report, s
+Output  : none, the reference is in m->Ref_xx
+函数功能：根据最近一次领航者数据预测编队位置在预测时域内的轨迹
+入口参数：m：控制器；leader_x，leader_y：m；leader_yaw_deg：度；
+          leader_vx，leader_vy：领航者车体速度，m/s；leader_wz：rad/s；
+          offset_x，offset_y：领航者坐标系下的编队偏移，m；age_s：数据已经过的时间，s
+返回  值：无，参考轨迹保存在m->Ref_xx中
+**************************************************************************/
+void Formation_MPC_Reference(Formation_MPC_t *m, float leader_x, float leader_y, float leader_yaw_deg,
+                             float leader_vx, float leader_vy, float leader_wz,
+                             float offset_x, float offset_y, float age_s)
+{
+	float heading = leader_yaw_deg * FAST_DEG2RAD, s, c, step;
+	int k;
+
+	if(age_s < 0.0f) age_s = 0.0f;
+	if(age_s > MPC_MAX_AGE_S) age_s = MPC_MAX_AGE_S;
+	if(leader_wz < MPC_LEADER_RATE_DEAD && leader_wz > -MPC_LEADER_RATE_DEAD) leader_wz = 0.0f;
+
+	//Constant body velocity and yaw rate, midpoint integration from the report to now
+	//车体速度和角速度保持不变，用中点法从数据时刻积分到当前时刻
+	step = age_s;
+	for(k = 0; k <= N; k++)
+	{
+		Fast_Sincosf(heading + leader_wz * step * 0.5f, &s, &c);
+		leader_x += step * (leader_vx * c - leader_vy * s);
+		leader_y += step * (leader_vx * s + leader_vy * c);
+		heading += leader_wz * step;
+
+		Fast_Sincosf(heading, &s, &c);
+		m->Ref_X[k] = leader_x + offset_x * c - offset_y * s;
+		m->Ref_Y[k] = leader_y + offset_x * s + offset_y * c;
+		step = MPC_STEP_S;
+	}
+	for(k = 0; k < N; k++)
+	{
+		m->Ref_VX[k] = (m->Ref_X[k + 1] - m->Ref_X[k]) * (1.0f / MPC_STEP_S);
+		m->Ref_VY[k] = (m->Ref_Y[k + 1] - m->Ref_Y[k]) * (1.0f / MPC_STEP_S);
+	}
+}
+
+//Euclidean projection of a plan onto the constraint set: the first command
+//onto the lens of the speed limit and the move from the applied command,
+//the later steps onto the speed disc. The steps are independent, so
+//projecting each one is the projection of the whole plan
+//将规划投影到约束集：首个指令投影到速度限制与相对实际执行指令变化量限制构成的透镜形区域，
+//之后各步投影到速度圆盘。各步相互独立，逐步投影即为整个规划的投影
+static void MPC_Project(Formation_MPC_t *m, float *vx, float *vy, float first_move)
+{
+	int k;
+
+	MPC_Project_Lens(&vx[0], &vy[0], m->Last_VX, m->Last_VY, m->V_Max, first_move);
+	for(k = 1; k < N; k++) MPC_Clip(&vx[k], &vy[k], 0.0f, 0.0f, m->V_Max);
+}
+
+//Gradient of the half cost at the plan v //规划v处的半代价函数梯度
+static void MPC_Gradient(Formation_MPC_t *m, const float *v, const float *ref_p, const float *ref_v,
+                         float p0, float last, float *grad)
+{
+	float p = p0, tail = 0.0f, err[N];
+	int k;
+
+	for(k = 0; k < N; k++)
+	{
+		p += MPC_STEP_S * v[k];
+		err[k] = p - ref_p[k + 1];
+	}
+	//v[k] moves every later position, sum the errors from the end
+	//v[k]影响其后所有位置，从末端累加误差
+	for(k = N - 1; k >= 0; k--)
+	{
+		tail += err[k];
+		grad[k] = m->Q_Pos * MPC_STEP_S * tail + m->R_Vel * (v[k] - ref_v[k])
+		        + m->S_Move * (v[k] - (k ? v[k - 1] : last));
+		if(k < N - 1) grad[k] -= m->S_Move * (v[k + 1] - v[k]);
+	}
+}
+
+/**************************************************************************
+Function: Solve the horizon and return the first velocity of the plan
+Input   : m: controller with the reference set; px, py: position now, m; dt: control period, s;
+          vx, vy: velocity command, world frame, m/s
+Output  : none
+函数功能：求解预测时域内的最优规划，输出规划的第一个速度
+入口参数：m：已设置参考轨迹的控制器；px，py：当前位置，m；dt：控制周期，s；
+          vx，vy：速度指令，世界坐标系，m/s
+返回  值：无
+**************************************************************************/
+void Formation_MPC_Solve(Formation_MPC_t *m, float px, float py, float dt, float *vx, float *vy)
+{
+	float yx[N], yy[N], gx[N], gy[N], xx[N], xy[N];
+	float step, t = 1.0f, t_next, beta, ex, ey, rest;
+	u32 start = getCycleCnt();
+	int i, k;
+
+	ex = m->Ref_X[0] - px;
+	ey = m->Ref_Y[0] - py;
+	m->Error = Fast_Sqrtf(ex * ex + ey * ey);
+
+	//A standing leader and a small error: hold still instead of chasing UWB noise
+	//领航者静止且误差很小时保持静止，不追随UWB噪声
+	rest = m->Ref_VX[0] * m->Ref_VX[0] + m->Ref_VY[0] * m->Ref_VY[0];
+	if(m->Error < MPC_DEADBAND && rest < 1e-6f)
+	{
+		px = m->Ref_X[0];
+		py = m->Ref_Y[0];
+	}
+
+	//1/L with L bounding the Hessian: Q*T^2*N^2 + R + 4S
+	//步长为1/L，L为Hessian矩阵的上界
+	step = 1.0f / (m->Q_Pos * MPC_STEP_S * MPC_STEP_S * N * N + m->R_Vel + 4.0f * m->S_Move);
+
+	for(k = 0; k < N; k++)
+	{
+		xx[k] = m->Plan_VX[k];
+		xy[k] = m->Plan_VY[k];
+	}
+	MPC_Project(m, xx, xy, m->A_Max * dt);
+	for(k = 0; k < N; k++) { yx[k] = xx[k]; yy[k] = xy[k]; }
+
+	for(i = 0; i < MPC_ITERATIONS; i++)
+	{
+		float nx[N], ny[N];
+
+		MPC_Gradient(m, yx, m->Ref_X, m->Ref_VX, px, m->Last_VX, gx);
+		MPC_Gradient(m, yy, m->Ref_Y, m->Ref_VY, py, m->Last_VY, gy);
+		for(k = 0; k < N; k++)
+		{
+			nx[k] = yx[k] - step * gx[k];
+			ny[k] = yy[k] - step * gy[k];
+		}
+		MPC_Project(m, nx, ny, m->A_Max * dt);
+
+		//Nesterov momentum, the next point is extrapolated from the last two iterates
+		//Nesterov动量，由最近两次迭代结果外推下一个点
+		t_next = 0.5f * (1.0f + Fast_Sqrtf(1.0f + 4.0f * t * t));
+		beta = (t - 1.0f) / t_next;
+		t = t_next;
+		for(k = 0; k < N; k++)
+		{
+			yx[k] = nx[k] + beta * (nx[k] - xx[k]);
+			yy[k] = ny[k] + beta * (ny[k] - xy[k]);
+			xx[k] = nx[k];
+			xy[k] = ny[k];
+		}
+	}
+
+	//The last projected iterate is feasible, the extrapolated point need not be
+	//最后一次投影的结果满足约束，外推点不一定满足
+	for(k = 0; k < N; k++)
+	{
+		m->Plan_VX[k] = xx[k];
+		m->Plan_VY[k] = xy[k];
+	}
+	*vx = xx[0];
+	*vy = xy[0];
+
+	m->Cycles = getCycleCnt() - start;
+	if(m->Cycles > m->Cycles_Max) m->Cycles_Max = m->Cycles;
+}
@@ -0,0 +1,69 @@
+#ifndef __FORMATION_MPC_H
+#define __FORMATION_MPC_H
+#include <stdint.h>
+
+//Short horizon linear MPC of the formation follower. The base is holonomic,
+//in the world frame each axis is an integrator of the commanded velocity:
+//  p[k+1] = p[k] + T*v[k]
+//The cost over the horizon is
+//  sum Q*|p[k]-r[k]|^2 + R*|v[k]-vr[k]|^2 + S*|v[k]-v[k-1]|^2
+//with |v[k]| <= V_Max at every step and |v[0]-v_applied| <= A_Max*dt for
+//the command sent next, v_applied being what the car drove last tick after
+//the mode blend, ORCA and Smooth_control. Later changes are shaped by S
+//only. r and vr follow the predicted trajectory of the leader.
+//The constraint set is a product of discs and one lens (the intersection of
+//two discs), each projected exactly, so the accelerated projected gradient
+//keeps its bound: after i iterations the cost is within 2L*|v_start-v*|^2/(i+1)^2
+//of the optimum, L bounding the Hessian. The plan is warm started from the
+//last tick, Host/mpc_bench.c measures the first command after MPC_ITERATIONS
+//against the converged one. The time per tick is bounded.
+//编队跟随者的短时域线性MPC。底盘为全向移动，世界坐标系下每个轴都是指令速度的积分器。
+//代价函数包括位置误差、与参考速度的偏差和速度变化量。约束为每一步的速度幅值，以及下一条指令相对
+//上一周期实际执行指令(经过模式过渡、ORCA和Smooth_control后)的变化量，之后的速度变化只由S加权。
+//参考轨迹为领航者的预测轨迹。约束集为若干圆盘与一个透镜形(两圆盘之交)的乘积，均可精确投影，
+//因此加速投影梯度法保持其收敛界：i次迭代后代价与最优值之差不超过2L*|v_start-v*|^2/(i+1)^2。
+//规划以上一周期结果为初值，Host/mpc_bench.c测量MPC_ITERATIONS次迭代后首个指令与收敛结果的差距。
+//每周期耗时有上界
+
+#define MPC_HORIZON          10       //Prediction steps //预测步数
+#define MPC_STEP_S           0.1f     //Step length, the horizon covers 1 s //步长，预测时域为1秒
+#define MPC_ITERATIONS       15       //Gradient iterations per tick, sets the worst case time //每周期梯度迭代次数，决定最坏耗时
+#define MPC_Q_POS            4.0f     //Position error weight //位置误差权重
+#define MPC_R_VEL            0.5f     //Weight of the deviation from the reference velocity //偏离参考速度的权重
+#define MPC_S_MOVE           2.0f     //Weight of velocity changes //速度变化量权重
+#define MPC_A_MAX            0.5f     //Acceleration limit, m/s^2 //加速度限幅，m/s^2
+#define MPC_MAX_AGE_S        0.5f     //Leader data older than this is not extrapolated further //领航者数据外推的最长时间
+#define MPC_LEADER_RATE_DEAD 0.05f    //Leader yaw rates below this are noise, rad/s //低于该值的领航者角速度视为噪声，rad/s
+#define MPC_DEADBAND         0.05f    //Position error ignored with a standing leader, m //领航者静止时忽略的位置误差，m
+
+typedef struct
+{
+	//Weights and limits //权重与约束
+	float Q_Pos, R_Vel, S_Move;
+	float V_Max, A_Max;
+
+	//Reference over the horizon, world frame //预测时域内的参考，世界坐标系
+	float Ref_X[MPC_HORIZON + 1], Ref_Y[MPC_HORIZON + 1];
+	float Ref_VX[MPC_HORIZON], Ref_VY[MPC_HORIZON];
+
+	//Velocity plan, warm start of the next tick //速度规划，作为下一周期的初值
+	float Plan_VX[MPC_HORIZON], Plan_VY[MPC_HORIZON];
+	float Last_VX, Last_VY;       //Command the car drove last tick, world frame, set by Formation_MPC_Applied //上一周期实际执行的指令，世界坐标系
+
+	float Error;                  //Distance to the reference now, m //当前与参考点的距离，m
+	uint32_t Cycles, Cycles_Max;  //Solver time, CPU cycles //求解耗时，CPU周期数
+}Formation_MPC_t;
+
+//Static initialiser with the default weights, speed limit of the formation
+//使用默认权重的静态初始化，速度限制与编队最大速度相同
+#define FORMATION_MPC_DEFAULT { MPC_Q_POS, MPC_R_VEL, MPC_S_MOVE, 0.3f, MPC_A_MAX }
+
+void Formation_MPC_Init(Formation_MPC_t *m);
+void Formation_MPC_Reset(Formation_MPC_t *m, float vx_world, float vy_world);
+void Formation_MPC_Reference(Formation_MPC_t *m, float leader_x, float leader_y, float leader_yaw_deg,
+                             float leader_vx, float leader_vy, float leader_wz,
+                             float offset_x, float offset_y, float age_s);
+void Formation_MPC_Applied(Formation_MPC_t *m, float vx_world, float vy_world);
+void Formation_MPC_Solve(Formation_MPC_t *m, float px, float py, float dt, float *vx, float *vy);
+
+#endif
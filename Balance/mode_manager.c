@@ -0,0 +1,164 @@
+#include "mode_manager.h"
+#include "balance.h"
+#include "formation_control.h"
+#include "yaw_control.h"
+#include "autotune.h"
+#include "host_link.h"
+#include "collision_avoid.h"
+#include "uwb.h"
+#include "float_only.h"
+
+Mode_Manager_t Mode_Manager = MODE_MANAGER_DEFAULT;
+
+//Transfer length in Balance_task cycles //过渡长度，单位为Balance_task周期
+#define MODE_BLEND_STEPS ((MODE_BLEND_MS) * CONTROL_FREQUENCY / 1000)
+
+/**************************************************************************
+Function: Pick the control mode, same priority as the original Balance_task chain
+Input   : none
+Output  : CTRL_MODE_xxx
+函数功能：选择控制模式，优先级与原Balance_task中的判断顺序相同
+入口参数：无
+返回  值：CTRL_MODE_xxx
+**************************************************************************/
+uint8_t Mode_Select(void)
+{
+	//A tuning run owns the chassis until it ends or is aborted
+	//自整定运行期间独占底盘，直到结束或中止
+	if(Autotune_Active())                          return CTRL_MODE_AUTOTUNE;
+	//An onboard computer streaming commands drives until it stops for HOST_LINK_TIMEOUT_MS
+	//上位机持续发送指令时由其控制，停止HOST_LINK_TIMEOUT_MS后退出
+	if(Host_Link_Active())                         return CTRL_MODE_HOST;
+	//The position modes steer by the UWB fix, a stalled UART5 stream stops the car
+	//until fixes arrive again. Remote control does not need them
+	//位置相关模式依靠UWB定位，UART5数据中断时停车，直到定位恢复。遥控不需要定位
+	if(Uwb.Stale && (Formation_mode == FORMATION_MODE_FOLLOWER || Formation_mode == FORMATION_MODE_CONSENSUS ||
+	                 (Auto_mode && newCoordinateReceived)))
+		return CTRL_MODE_STOP;
+	//A formation leader drives itself exactly like a car without formation
+	//编队领航者的控制方式与非编队小车完全相同
+	if(Formation_mode == FORMATION_MODE_FOLLOWER) return CTRL_MODE_FOLLOWER;
+	if(Formation_mode == FORMATION_MODE_CONSENSUS) return CTRL_MODE_CONSENSUS;
+	if(Auto_mode && newCoordinateReceived)         return CTRL_MODE_AUTO;
+	if(APP_ON_Flag)                                return CTRL_MODE_RC;
+	return CTRL_MODE_STOP;
+}
+
+/**************************************************************************
+Function: Prepare the controllers of a mode from the current state
+Input   : mode: mode being entered
+Output  : none
+函数功能：根据当前状态初始化新模式的控制器
+入口参数：mode：将进入的模式
+返回  值：无
+**************************************************************************/
+static void Mode_Enter(uint8_t mode)
+{
+	//Heading loops start from the rotation being commanded now, the
+	//derivative and integral history of the old mode is dropped
+	//航向环从当前旋转指令开始，丢弃旧模式的微分和积分历史
+	if(mode == CTRL_MODE_AUTO)     Yaw_Cascade_Bumpless(&Mode_Manager.Auto_Yaw, Mode_Manager.Last_Vz);
+	if(mode == CTRL_MODE_FOLLOWER) Formation_Follower_Reset(Mode_Manager.Last_Vx, Mode_Manager.Last_Vy, Mode_Manager.Last_Vz);
+	if(mode == CTRL_MODE_CONSENSUS) Formation_Consensus_Enter(Mode_Manager.Last_Vz);
+
+	Mode_Manager.Hold_Vx = Mode_Manager.Last_Vx;
+	Mode_Manager.Hold_Vy = Mode_Manager.Last_Vy;
+	Mode_Manager.Hold_Vz = Mode_Manager.Last_Vz;
+	//Stopping is never delayed, Smooth_control already brings the wheels down gently.
+	//The autotuner needs its commands unchanged
+	//停车不做延迟，Smooth_control本身会平缓减速；自整定需要指令不被修改
+	Mode_Manager.Blend_Left = (mode == CTRL_MODE_STOP || mode == CTRL_MODE_AUTOTUNE) ? 0 : MODE_BLEND_STEPS;
+	Mode_Manager.Previous_Mode = Mode_Manager.Mode;
+	Mode_Manager.Mode = mode;
+	Mode_Manager.Switch_Count++;
+}
+
+/**************************************************************************
+Function: Run the controller of the active mode, called once per Balance_task cycle
+Input   : none
+Output  : none
+函数功能：运行当前模式的控制器，每个Balance_task周期调用一次
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Mode_Manager_Run(void)
+{
+	uint8_t mode = Mode_Select();
+
+	if(mode != Mode_Manager.Mode) Mode_Enter(mode);
+
+	switch(mode)
+	{
+		case CTRL_MODE_AUTOTUNE:
+			Autotune_Run();
+			break;
+		case CTRL_MODE_HOST:
+			Host_Link_Control();
+			break;
+		case CTRL_MODE_FOLLOWER:
+			Formation_Follower_Control();
+			break;
+		case CTRL_MODE_CONSENSUS:
+			Formation_Consensus_Control();
+			break;
+		case CTRL_MODE_AUTO:
+			Auto_Adjust_Position_And_Yaw();
+			break;
+		case CTRL_MODE_RC:
+			Get_RC();
+			//Remote control cancels a pending coordinate, a leader keeps it
+			//遥控取消待执行的坐标，领航者保留
+			if(Formation_mode == FORMATION_MODE_NONE)
+			{
+				newCoordinateReceived = 0;
+				position_reached = 0;
+			}
+			break;
+		default:
+			Drive_Motor(0, 0, 0);
+			break;
+	}
+}
+
+/**************************************************************************
+Function: Whether Drive_Motor filters the command of the active mode through ORCA
+Input   : none
+Output  : 1: this car takes its half of the avoidance, broadcast to the other cars
+函数功能：当前模式的指令是否经过Drive_Motor中的ORCA避碰滤波
+入口参数：无
+返回  值：1：本车承担一半避让，该标志随状态广播给其他小车
+**************************************************************************/
+uint8_t Mode_Runs_Orca(void)
+{
+	//Remote control and the autotuner are left alone, so is the onboard computer
+	//遥控、自整定和上位机指令不做修改
+	return Collision_Avoid.Enable &&
+	       (Mode_Manager.Mode == CTRL_MODE_AUTO || Mode_Manager.Mode == CTRL_MODE_FOLLOWER || Mode_Manager.Mode == CTRL_MODE_CONSENSUS);
+}
+
+/**************************************************************************
+Function: Ramp the command from the value held at the last mode switch, called by Drive_Motor
+Input   : vx, vy, vz: command of the active mode, replaced by the blended command
+Output  : none
+函数功能：从上次模式切换时保持的指令平滑过渡，由Drive_Motor调用
+入口参数：vx，vy，vz：当前模式的指令，返回过渡后的指令
+返回  值：无
+**************************************************************************/
+void Mode_Blend_Command(float *vx, float *vy, float *vz)
+{
+	float w;
+
+	if(Mode_Manager.Blend_Left > 0)
+	{
+		//Weight of the new mode goes linearly from 0 to 1
+		//新模式的权重由0线性增加到1
+		w = 1.0f - (float)Mode_Manager.Blend_Left / MODE_BLEND_STEPS;
+		*vx = Mode_Manager.Hold_Vx + w * (*vx - Mode_Manager.Hold_Vx);
+		*vy = Mode_Manager.Hold_Vy + w * (*vy - Mode_Manager.Hold_Vy);
+		*vz = Mode_Manager.Hold_Vz + w * (*vz - Mode_Manager.Hold_Vz);
+		Mode_Manager.Blend_Left--;
+	}
+	Mode_Manager.Last_Vx = *vx;
+	Mode_Manager.Last_Vy = *vy;
+	Mode_Manager.Last_Vz = *vz;
+}
@@ -0,0 +1,52 @@
+#ifndef __MODE_MANAGER_H
+#define __MODE_MANAGER_H
+#include <stdint.h>
+#include "yaw_control.h"
+#include "formation_mpc.h"
+#include "formation_consensus.h"
+
+//Control modes of Balance_task, in priority order
+//Balance_task的控制模式，按优先级排列
+#define CTRL_MODE_STOP           0
+#define CTRL_MODE_RC             1        //APP remote control, also a formation leader without a target //APP遥控，也包括无目标的编队领航者
+#define CTRL_MODE_AUTO           2        //Go to the received coordinate //前往接收到的坐标
+#define CTRL_MODE_FOLLOWER       3        //Formation follower //编队跟随者
+#define CTRL_MODE_CONSENSUS      4        //Consensus formation over the topology graph //基于通信拓扑的一致性编队
+#define CTRL_MODE_HOST           5        //Velocity commands of the onboard computer //上位机速度指令
+#define CTRL_MODE_AUTOTUNE       6        //Relay autotuner, above all others while it runs //继电自整定，运行时优先于其他模式
+
+//Time over which the command moves from the old mode's value to the new
+//mode's value after a switch
+//模式切换后，指令从旧模式输出过渡到新模式输出的时间
+#define MODE_BLEND_MS            300
+
+typedef struct
+{
+	uint8_t  Mode;
+	uint8_t  Previous_Mode;
+	uint16_t Blend_Left;          //Control cycles left in the transfer //过渡剩余的控制周期数
+	uint32_t Switch_Count;
+	float    Hold_Vx, Hold_Vy, Hold_Vz;   //Command at the moment of the switch //切换时刻的指令
+	float    Last_Vx, Last_Vy, Last_Vz;   //Last command passed to Drive_Motor //最近一次送入Drive_Motor的指令
+	//Controller instances of the modes, Mode_Enter initialises the one of the new mode
+	//各模式的控制器实例，由Mode_Enter初始化新模式的实例
+	Yaw_Cascade_t Auto_Yaw;               //Heading of CTRL_MODE_AUTO and the autotuner //自动模式及自整定的航向控制器
+	Yaw_Cascade_t Formation_Yaw;          //Heading of the follower and consensus modes //跟随者与一致性编队的航向控制器
+	Formation_MPC_t Follower_MPC;         //Follower position, FORMATION_CTRL_MPC //跟随者位置控制器(MPC)
+	float    Follower_Prev_Ex, Follower_Prev_Ey;  //Follower position, FORMATION_CTRL_PD //跟随者位置控制器(PD)的上一周期误差
+	uint8_t  Follower_Primed;             //0: next PD step starts its derivative from the current error //0：下一次PD计算用当前误差初始化上一周期误差
+	Formation_Consensus_t Consensus;      //Consensus formation, slots set by FORMATION:CONSENSUS //一致性编队控制器，编队位置由FORMATION:CONSENSUS设置
+}Mode_Manager_t;
+
+#define MODE_MANAGER_DEFAULT { 0, 0, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, \
+                               YAW_CASCADE_DEFAULT, YAW_CASCADE_DEFAULT, FORMATION_MPC_DEFAULT, \
+                               0.0f, 0.0f, 0, FORMATION_CONSENSUS_DEFAULT }
+
+extern Mode_Manager_t Mode_Manager;
+
+uint8_t Mode_Select(void);
+void Mode_Manager_Run(void);
+void Mode_Blend_Command(float *vx, float *vy, float *vz);
+uint8_t Mode_Runs_Orca(void);
+
+#endif
@@ -0,0 +1,317 @@
+#include "num_parse.h"
+#include "float_only.h"
+
+//Exact powers of ten in single precision, 5^10 still fits the 24 bit mantissa
+//单精度下可精确表示的10的幂，5^10仍在24位尾数范围内
+static const float Num_Pow10[11] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+//Keeps the first error only, later ones are usually a consequence of it
+//只保留第一次错误，之后的错误通常由它引起
+static uint8_t Num_Fail(Num_Cursor_t *c, uint8_t error)
+{
+	if(c->Error == NUM_OK)
+	{
+		c->Error = error;
+		c->Error_Pos = Num_Offset(c);
+	}
+	return 0;
+}
+
+static __inline uint8_t Num_Is_Digit(char ch)
+{
+	return (uint8_t)(ch - '0') <= 9;
+}
+
+/**************************************************************************
+Function: Start parsing a line
+Input   : c: cursor; s: line; len: bytes that may be read, a NUL before that also ends the line
+Output  : none
+函数功能：开始解析一行
+入口参数：c：游标；s：行数据；len：可读取的字节数，在此之前遇到NUL同样视为行结束
+返回  值：无
+**************************************************************************/
+void Num_Cursor_Init(Num_Cursor_t *c, const char *s, uint16_t len)
+{
+	c->Start = c->Pos = s;
+	c->End = s + len;
+	c->Error = NUM_OK;
+	c->Error_Pos = 0;
+}
+
+/**************************************************************************
+Function: Skip blanks and tabs
+Input   : c: cursor
+Output  : none
+函数功能：跳过空格和制表符
+入口参数：c：游标
+返回  值：无
+**************************************************************************/
+void Num_Skip_Spaces(Num_Cursor_t *c)
+{
+	char ch = Num_Peek(c);
+
+	while(ch == ' ' || ch == '\t')
+	{
+		c->Pos++;
+		ch = Num_Peek(c);
+	}
+}
+
+/**************************************************************************
+Function: Decimal number with optional sign, fraction and exponent, leading blanks are skipped
+Input   : c: cursor; out: value, untouched on failure
+Output  : 1: parsed, 0: failed, the cursor stays where it was
+函数功能：解析十进制数，可带符号、小数和指数，跳过前导空格
+入口参数：c：游标；out：数值，失败时不修改
+返回  值：1：成功，0：失败，游标保持原位置
+**************************************************************************/
+uint8_t Num_Float(Num_Cursor_t *c, float *out)
+{
+	const char *start;
+	uint32_t mant = 0;
+	int32_t exp10 = 0, e = 0;
+	uint8_t neg = 0, digits = 0, kept = 0, exp_neg = 0;
+	char ch;
+	float v;
+
+	Num_Skip_Spaces(c);
+	start = c->Pos;
+	ch = Num_Peek(c);
+	if(ch == '-' || ch == '+')
+	{
+		neg = (ch == '-');
+		c->Pos++;
+	}
+
+	//Integer part, digits beyond the kept ones only scale //整数部分，超出保留位数的数字只影响量级
+	for(ch = Num_Peek(c); Num_Is_Digit(ch); ch = Num_Peek(c))
+	{
+		if(kept < NUM_FLOAT_DIGITS) { if(mant || ch != '0') kept++; mant = mant * 10u + (uint32_t)(ch - '0'); }
+		else exp10++;
+		digits++;
+		c->Pos++;
+	}
+	//Fraction //小数部分
+	if(ch == '.')
+	{
+		c->Pos++;
+		for(ch = Num_Peek(c); Num_Is_Digit(ch); ch = Num_Peek(c))
+		{
+			if(kept < NUM_FLOAT_DIGITS) { if(mant || ch != '0') kept++; mant = mant * 10u + (uint32_t)(ch - '0'); exp10--; }
+			digits++;
+			c->Pos++;
+		}
+	}
+	if(digits == 0)
+	{
+		c->Pos = start;
+		return Num_Fail(c, Num_Peek(c) ? NUM_ERR_DIGIT : NUM_ERR_END);
+	}
+
+	//Exponent, only taken when digits follow, "1e" stops before the e like strtod
+	//指数，只有后面有数字时才解析，与strtod相同，"1e"在e之前停止
+	if(ch == 'e' || ch == 'E')
+	{
+		const char *mark = c->Pos;
+
+		c->Pos++;
+		ch = Num_Peek(c);
+		if(ch == '-' || ch == '+')
+		{
+			exp_neg = (ch == '-');
+			c->Pos++;
+			ch = Num_Peek(c);
+		}
+		if(Num_Is_Digit(ch))
+		{
+			for(; Num_Is_Digit(ch); ch = Num_Peek(c))
+			{
+				if(e < 1000) e = e * 10 + (ch - '0');
+				c->Pos++;
+			}
+			exp10 += exp_neg ? -e : e;
+		}
+		else c->Pos = mark;
+	}
+
+	//Scaled by exact powers, dividing keeps negative exponents to one rounding per step
+	//用精确的10的幂缩放，负指数用除法，每步只有一次舍入
+	v = (float)mant;
+	if(mant != 0)
+	{
+		if(exp10 > 38 + NUM_FLOAT_DIGITS || exp10 < -45 - NUM_FLOAT_DIGITS)
+		{
+			if(exp10 > 0)
+			{
+				c->Pos = start;
+				return Num_Fail(c, NUM_ERR_RANGE);
+			}
+			v = 0.0f;
+		}
+		else
+		{
+			for(; exp10 > 10; exp10 -= 10) v *= Num_Pow10[10];
+			for(; exp10 < -10; exp10 += 10) v /= Num_Pow10[10];
+			v = exp10 >= 0 ? v * Num_Pow10[exp10] : v / Num_Pow10[-exp10];
+			if(v > 3.4028235e38f)
+			{
+				c->Pos = start;
+				return Num_Fail(c, NUM_ERR_RANGE);
+			}
+		}
+	}
+	*out = neg ? -v : v;
+	return 1;
+}
+
+/**************************************************************************
+Function: Decimal integer with optional sign, leading blanks are skipped
+Input   : c: cursor; out: value, untouched on failure
+Output  : 1: parsed, 0: failed, the cursor stays where it was
+函数功能：解析十进制整数，可带符号，跳过前导空格
+入口参数：c：游标；out：数值，失败时不修改
+返回  值：1：成功，0：失败，游标保持原位置
+**************************************************************************/
+uint8_t Num_Int(Num_Cursor_t *c, int32_t *out)
+{
+	const char *start;
+	uint32_t v = 0, limit;
+	uint8_t neg = 0;
+	char ch;
+
+	Num_Skip_Spaces(c);
+	start = c->Pos;
+	ch = Num_Peek(c);
+	if(ch == '-' || ch == '+')
+	{
+		neg = (ch == '-');
+		c->Pos++;
+		ch = Num_Peek(c);
+	}
+	if(!Num_Is_Digit(ch))
+	{
+		c->Pos = start;
+		return Num_Fail(c, ch ? NUM_ERR_DIGIT : NUM_ERR_END);
+	}
+
+	limit = neg ? 2147483648u : 2147483647u;
+	for(; Num_Is_Digit(ch); ch = Num_Peek(c))
+	{
+		uint32_t d = (uint32_t)(ch - '0');
+
+		if(v > (limit - d) / 10u)
+		{
+			c->Pos = start;
+			return Num_Fail(c, NUM_ERR_RANGE);
+		}
+		v = v * 10u + d;
+		c->Pos++;
+	}
+	*out = neg ? (int32_t)(0u - v) : (int32_t)v;
+	return 1;
+}
+
+/**************************************************************************
+Function: Consume one expected character
+Input   : c: cursor; ch: character
+Output  : 1: found and consumed, 0: missing
+函数功能：读取一个期望的字符
+入口参数：c：游标；ch：字符
+返回  值：1：找到并跳过，0：不存在
+**************************************************************************/
+uint8_t Num_Expect(Num_Cursor_t *c, char ch)
+{
+	char now = Num_Peek(c);
+
+	if(now != ch) return Num_Fail(c, now ? NUM_ERR_CHAR : NUM_ERR_END);
+	c->Pos++;
+	return 1;
+}
+
+/**************************************************************************
+Function: Consume an expected literal
+Input   : c: cursor; lit: literal, NUL terminated
+Output  : 1: found and consumed, 0: missing, the cursor stays where it was
+函数功能：读取一个期望的字符串
+入口参数：c：游标；lit：字符串，以NUL结尾
+返回  值：1：找到并跳过，0：不存在，游标保持原位置
+**************************************************************************/
+uint8_t Num_Expect_Str(Num_Cursor_t *c, const char *lit)
+{
+	const char *p = c->Pos;
+
+	for(; *lit; lit++, p++)
+	{
+		if(p >= c->End || *p != *lit) return Num_Fail(c, (p < c->End && *p) ? NUM_ERR_CHAR : NUM_ERR_END);
+	}
+	c->Pos = p;
+	return 1;
+}
+
+/**************************************************************************
+Function: Copy a token up to a stop character, a blank, a line end or the end of the input, none of them is consumed
+Input   : c: cursor; out: NUL terminated token; size: size of out; stop: stop character
+Output  : 1: at least one character copied, 0: empty or too long, the cursor stays where it was
+函数功能：复制一个标记直到停止字符、空格、换行或输入结束，这些字符都不被跳过
+入口参数：c：游标；out：以NUL结尾的标记；size：out的大小；stop：停止字符
+返回  值：1：至少复制了一个字符，0：为空或过长，游标保持原位置
+**************************************************************************/
+uint8_t Num_Token(Num_Cursor_t *c, char *out, uint16_t size, char stop)
+{
+	const char *start = c->Pos;
+	uint16_t n = 0;
+	char ch;
+
+	for(ch = Num_Peek(c); ch && ch != stop && ch != ' ' && ch != '\t' && ch != '\r' && ch != '\n'; ch = Num_Peek(c))
+	{
+		if(n + 1u >= size)
+		{
+			c->Pos = start;
+			out[0] = '\0';
+			return Num_Fail(c, NUM_ERR_LENGTH);
+		}
+		out[n++] = ch;
+		c->Pos++;
+	}
+	out[n] = '\0';
+	if(n == 0) return Num_Fail(c, ch ? NUM_ERR_CHAR : NUM_ERR_END);
+	return 1;
+}
+
+/**************************************************************************
+Function: Move past the next occurrence of a character, used to step over a field that failed
+Input   : c: cursor; ch: character
+Output  : 1: found, 0: not in the rest of the input, the cursor is left at the end
+函数功能：移动到下一个指定字符之后，用于跳过解析失败的字段
+入口参数：c：游标；ch：字符
+返回  值：1：找到，0：剩余输入中没有该字符，游标停在末尾
+**************************************************************************/
+uint8_t Num_Skip_Past(Num_Cursor_t *c, char ch)
+{
+	char now;
+
+	for(now = Num_Peek(c); now; now = Num_Peek(c))
+	{
+		c->Pos++;
+		if(now == ch) return 1;
+	}
+	return 0;
+}
+
+/**************************************************************************
+Function: Bounded atoi, leading blanks are skipped
+Input   : s: text; len: bytes that may be read
+Output  : value, 0 when there is no number or it is out of range
+函数功能：有长度限制的atoi，跳过前导空格
+入口参数：s：文本；len：可读取的字节数
+返回  值：数值，没有数字或超出范围时为0
+**************************************************************************/
+int32_t Num_Atoi(const char *s, uint16_t len)
+{
+	Num_Cursor_t c;
+	int32_t v = 0;
+
+	Num_Cursor_Init(&c, s, len);
+	Num_Int(&c, &v);
+	return v;
+}
@@ -0,0 +1,64 @@
+#ifndef __NUM_PARSE_H
+#define __NUM_PARSE_H
+#include <stdint.h>
+
+//Tokenizer and number parser of the text ingest paths (UWB, WiFi, APP, formation
+//commands). It replaces sscanf/atof/atoi: no heap, no locale, no errno, every
+//read is bounded by an explicit end pointer as well as by a NUL, and the first
+//failure is kept with its position in the line. On the microlib a "%f" sscanf
+//pulls in the whole formatted input engine and a double strtod.
+//文本接收路径(UWB、WiFi、APP、编队指令)的分词和数字解析器，用于替代sscanf/atof/atoi：
+//不使用堆、不依赖locale和errno，所有读取都同时受显式结束指针和NUL限制，并记录第一次失败
+//及其在行中的位置。在microlib上"%f"的sscanf会引入整个格式化输入引擎和双精度strtod
+
+//Error codes, Num_Cursor_t.Error //错误码
+#define NUM_OK            0
+#define NUM_ERR_END       1       //Input ended before the item //数据在该项之前结束
+#define NUM_ERR_DIGIT     2       //No digit where a number was expected //应为数字处没有数字
+#define NUM_ERR_RANGE     3       //Number out of the range of the type //数值超出类型范围
+#define NUM_ERR_CHAR      4       //Expected character or literal missing //缺少期望的字符或字符串
+#define NUM_ERR_LENGTH    5       //Token longer than the output buffer //标记长于输出缓冲区
+
+//Significant digits kept by Num_Float, more only shift the exponent
+//Num_Float保留的有效数字位数，更多的数字只影响指数
+#define NUM_FLOAT_DIGITS  9
+
+typedef struct
+{
+	const char *Start;            //Line start, error positions are relative to it //行首，错误位置相对于此
+	const char *Pos;              //Next character //下一个字符
+	const char *End;              //One past the last character that may be read //可读取的最后一个字符之后
+	uint8_t Error;                //First error, NUM_OK while none //第一次错误，无错误时为NUM_OK
+	uint16_t Error_Pos;           //Offset of the first error from Start //第一次错误相对于行首的偏移
+}Num_Cursor_t;
+
+/**************************************************************************
+Function: Next character without consuming it
+Input   : c: cursor
+Output  : character, 0 at the end of the input
+函数功能：查看下一个字符，不移动游标
+入口参数：c：游标
+返回  值：字符，输入结束时返回0
+**************************************************************************/
+static __inline char Num_Peek(const Num_Cursor_t *c)
+{
+	return c->Pos < c->End ? *c->Pos : 0;
+}
+
+//Offset of the cursor from the line start //游标相对于行首的偏移
+static __inline uint16_t Num_Offset(const Num_Cursor_t *c)
+{
+	return (uint16_t)(c->Pos - c->Start);
+}
+
+void Num_Cursor_Init(Num_Cursor_t *c, const char *s, uint16_t len);
+void Num_Skip_Spaces(Num_Cursor_t *c);
+uint8_t Num_Float(Num_Cursor_t *c, float *out);
+uint8_t Num_Int(Num_Cursor_t *c, int32_t *out);
+uint8_t Num_Expect(Num_Cursor_t *c, char ch);
+uint8_t Num_Expect_Str(Num_Cursor_t *c, const char *lit);
+uint8_t Num_Token(Num_Cursor_t *c, char *out, uint16_t size, char stop);
+uint8_t Num_Skip_Past(Num_Cursor_t *c, char ch);
+int32_t Num_Atoi(const char *s, uint16_t len);
+
+#endif
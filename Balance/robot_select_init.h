@@ -4,19 +4,19 @@
 #include "system.h"
 
 //Parameter structure of robot
-//˲ṹ
+//机器人参数结构体
 typedef struct  
 {
-  float WheelSpacing;      //Wheelspacing, Mec_Car is half wheelspacing //־ ֳΪ־
-  float AxleSpacing;       //Axlespacing, Mec_Car is half axlespacing // ֳΪ	
-  int GearRatio;           //Motor_gear_ratio //ٱ
-  int EncoderAccuracy;     //Number_of_encoder_lines //()
-  float WheelDiameter;     //Diameter of driving wheel //ֱ	
-  float OmniTurnRadiaus;   //Rotation radius of omnidirectional trolley //ȫСת뾶	
+  float WheelSpacing;      //Wheelspacing, Mec_Car is half wheelspacing //轮距 麦轮车为半轮距
+  float AxleSpacing;       //Axlespacing, Mec_Car is half axlespacing //轴距 麦轮车为半轴距	
+  int GearRatio;           //Motor_gear_ratio //电机减速比
+  int EncoderAccuracy;     //Number_of_encoder_lines //编码器精度(编码器线数)
+  float WheelDiameter;     //Diameter of driving wheel //主动轮直径	
+  float OmniTurnRadiaus;   //Rotation radius of omnidirectional trolley //全向轮小车旋转半径	
 }Robot_Parament_InitTypeDef;
 
 // Encoder structure
-//ṹ
+//编码器结构体
 typedef struct  
 {
   int A;      
@@ -27,20 +27,20 @@ typedef struct
 
 //The minimum turning radius of Ackermann models is determined by the mechanical structure: 
 //the maximum Angle of the wheelbase, wheelbase and front wheels
-//͵Сת뾶ɻеṹ־ࡢࡢǰת
+//阿克曼车型的最小转弯半径，由机械结构决定：轮距、轴距、前轮最大转角
 #define MINI_AKM_MIN_TURN_RADIUS 0.350f 
 
 //Wheelspacing, Mec_Car is half wheelspacing
-//־ һ
+//轮距 麦轮是一半
 //#define MEC_wheelspacing         0.109
-#define MEC_wheelspacing         0.0930 //2021.03.30
+#define MEC_wheelspacing         0.0930 //修正2021.03.30
 #define Akm_wheelspacing         0.162f
 #define Diff_wheelSpacing        0.177f
 #define Four_Mortor_wheelSpacing 0.187f
 #define Tank_wheelSpacing        0.235f
 
 //Axlespacing, Mec_Car is half axlespacing
-// һ
+//轴距 麦轮是一半
 #define MEC_axlespacing           0.085
 #define Akm_axlespacing           0.144f
 #define Diff_axlespacing          0.155f
@@ -48,7 +48,7 @@ typedef struct
 #define Tank_axlespacing          0.222f
 
 //Motor_gear_ratio
-//ٱ
+//电机减速比
 #define   HALL_30F    30
 #define   MD36N_5_18  5.18
 #define   MD36N_27    27
@@ -58,12 +58,12 @@ typedef struct
 #define   MD60N_47    47
 
 //Number_of_encoder_lines
-//
+//编码器精度
 #define		Photoelectric_500 500
 #define	  Hall_13           13
 
 //Mecanum wheel tire diameter series
-//ֱ̥
+//麦轮轮胎直径
 #define		Mecanum_60  0.060f
 #define		Mecanum_75  0.075f
 #define		Mecanum_100 0.100f
@@ -71,7 +71,7 @@ typedef struct
 #define		Mecanum_152 0.152f
  
 //Omni wheel tire diameter series
-//־ȫֱϵ
+//轮径全向轮直径系列
 #define	  FullDirecion_60  0.060
 #define	  FullDirecion_75  0.075
 #define	  FullDirecion_127 0.127
@@ -80,26 +80,26 @@ typedef struct
 #define	  FullDirecion_217 0.217
 
 //Black tire, tank_car wheel diameter
-//ɫ̥Ĵֱ
+//黑色轮胎、履带车轮直径
 #define	  Black_WheelDiameter   0.065
 //#define	  Tank_WheelDiameter 0.047
 #define	  Tank_WheelDiameter 0.043
 
 //Rotation radius of omnidirectional trolley
-//ȫСת뾶
+//全向轮小车旋转半径
 #define   Omni_Turn_Radiaus_109 0.109
 #define   Omni_Turn_Radiaus_164 0.164
 #define   Omni_Turn_Radiaus_180 0.180
 #define   Omni_Turn_Radiaus_290 0.290
 
 //The encoder octave depends on the encoder initialization Settings
-//Ƶȡڱʼ
+//编码器倍频数，取决于编码器初始化设置
 #define   EncoderMultiples  4
 //Encoder data reading frequency
-//ݶȡƵ
+//编码器数据读取频率
 #define   CONTROL_FREQUENCY 100
 
-//#define PI 3.1415f  //PI //Բ
+//#define PI 3.1415f  //PI //圆周率
 
 void Robot_Select(u8 Car_Mode);
 void Robot_Init(double wheelspacing, float axlespacing, float omni_turn_radiaus, float gearratio,float Accuracy,float tyre_diameter);
@@ -0,0 +1,80 @@
+#include "robot_snapshot.h"
+#include "system.h"
+
+Robot_Snapshot_t Robot_Snapshot;
+uint32_t Robot_Snapshot_Retries;    //Reads that had to copy again //需要重新复制的读取次数
+
+/**************************************************************************
+Function: Publish the state of this control cycle, called at the end of Balance_task
+Input   : none
+Output  : none
+函数功能：发布本控制周期的状态，在Balance_task周期末尾调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Robot_Snapshot_Publish(void)
+{
+	Robot_Snapshot_t *s = &Robot_Snapshot;
+	int i, n;
+
+	s->Seq++;
+	__DMB();
+	s->Cycle = Time_count;
+	s->Position[0] = position[0];               s->Position[1] = position[1];
+	s->Target_Position[0] = Target_position[0]; s->Target_Position[1] = Target_position[1];
+	s->Roll = Roll; s->Pitch = Pitch; s->Yaw = Yaw; s->Target_Yaw = Target_Yaw;
+	s->Gyro[0] = gyro[0]; s->Gyro[1] = gyro[1]; s->Gyro[2] = gyro[2];
+	s->Motor_Target[0] = MOTOR_A.Target;   s->Motor_Encoder[0] = MOTOR_A.Encoder;
+	s->Motor_Target[1] = MOTOR_B.Target;   s->Motor_Encoder[1] = MOTOR_B.Encoder;
+	s->Motor_Target[2] = MOTOR_C.Target;   s->Motor_Encoder[2] = MOTOR_C.Encoder;
+	s->Motor_Target[3] = MOTOR_D.Target;   s->Motor_Encoder[3] = MOTOR_D.Encoder;
+	s->Voltage = Voltage;
+	s->Enable = EN;
+	//Peer rows by the number in "CARn". Update_Other_Car_Info writes a row in a
+	//critical section, so each row is whole, and the display reads the copy
+	//instead of the live table
+	//按"CARn"中的编号复制其他车辆的数据。Update_Other_Car_Info在临界区内写入一行，每行数据完整，
+	//显示任务读取副本而不直接读取车辆表
+	for(i = 0; i < SNAPSHOT_PEERS; i++) s->Peer[i].Valid = 0;
+	for(i = 0; i < MAX_OTHER_CARS; i++)
+	{
+		const char *id = other_cars[i].car_id;
+
+		if(!other_cars[i].valid || strncmp(id, "CAR", 3) != 0 || id[4] != '\0') continue;
+		n = id[3] - '1';
+		if(n < 0 || n >= SNAPSHOT_PEERS) continue;
+		s->Peer[n].X = other_cars[i].position_x;
+		s->Peer[n].Y = other_cars[i].position_y;
+		s->Peer[n].Yaw = other_cars[i].yaw;
+		s->Peer[n].Valid = 1;
+	}
+	__DMB();
+	s->Seq++;
+}
+
+/**************************************************************************
+Function: Take a consistent copy of the last published state, for the lower priority tasks
+Input   : out: destination
+Output  : none
+函数功能：获取最近一次发布状态的一致副本，供低优先级任务使用
+入口参数：out：目标
+返回  值：无
+**************************************************************************/
+void Robot_Snapshot_Read(Robot_Snapshot_t *out)
+{
+	uint32_t seq;
+
+	for(;;)
+	{
+		seq = Robot_Snapshot.Seq;
+		__DMB();
+		if((seq & 1u) == 0)
+		{
+			memcpy(out, &Robot_Snapshot, sizeof(Robot_Snapshot_t));
+			__DMB();
+			if(Robot_Snapshot.Seq == seq) return;
+		}
+		//The control task ran in the middle of the copy //复制过程中控制任务运行了
+		Robot_Snapshot_Retries++;
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef __ROBOT_SNAPSHOT_H
+#define __ROBOT_SNAPSHOT_H
+#include <stdint.h>
+
+#define SNAPSHOT_PEERS   4        //CAR1..CAR4, the rows of OLED page 2 //CAR1..CAR4，即OLED第2页的各行
+
+//Copy of the robot state that the control task publishes once per cycle. The
+//display and APP tasks run below it and always take the whole copy, so a page
+//never shows a position of one cycle next to a heading of the next one.
+//Sequence lock: the counter is odd while the writer copies, a reader that saw
+//an odd or changed counter copies again. The writer has the higher priority,
+//it is never interrupted by a reader and never waits.
+//控制任务每周期发布一次的机器人状态副本。显示和APP任务优先级更低，总是整体读取该副本，
+//因此一页上不会出现本周期的位置和下一周期的航向。顺序锁：写入期间计数为奇数，
+//读取者发现计数为奇数或前后不同时重新复制。写入者优先级更高，不会被读取者打断，也不会等待
+
+typedef struct
+{
+	volatile uint32_t Seq;        //Odd while the copy is being written //写入期间为奇数
+	uint32_t Cycle;               //Time_count of the control cycle //对应控制周期的Time_count
+	float Position[2], Target_Position[2];   //m
+	float Roll, Pitch, Yaw, Target_Yaw;      //degree //度
+	short Gyro[3];                //Calibrated gyro, hardware units //校准后的陀螺仪数据，原始单位
+	float Motor_Target[4], Motor_Encoder[4]; //Wheels A..D, m/s //A..D轮，m/s
+	float Voltage;                //Battery, V //电池电压，V
+	uint8_t Enable;               //State of the enable switch //使能开关状态
+	struct
+	{
+		float X, Y, Yaw;          //Last broadcast, m and degree //最近一次广播，m和度
+		uint8_t Valid;            //0: not in other_cars[] //0：不在other_cars[]中
+	}Peer[SNAPSHOT_PEERS];        //Peer[i] is CAR(i+1) //Peer[i]为CAR(i+1)
+}Robot_Snapshot_t;
+
+extern Robot_Snapshot_t Robot_Snapshot;
+extern uint32_t Robot_Snapshot_Retries;
+
+void Robot_Snapshot_Publish(void);
+void Robot_Snapshot_Read(Robot_Snapshot_t *out);
+
+#endif
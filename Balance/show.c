@@ -1,95 +1,215 @@
 #include "show.h"
+#include "robot_snapshot.h"
+#include "battery.h"
+#include "num_parse.h"
 
 
 
-// ȫֱʾ״̬أ
-int Voltage_Show;                     // صѹʾֵŴ100ʾ
-unsigned char i;                      // ѭ
-u8 Page_now = 1;                      // ǰOLEDҳ棨12
+// 全局变量（显示及状态相关）
+int Voltage_Show;                     // 电池电压显示值（放大100倍，用于显示）
+unsigned char i;                      // 循环计数变量
+u8 Page_now = 1;                      // 当前OLED页面（1~5）
 
-// ģݣ滻Ϊʵʴݣ
-uint8_t self_id;                      // ID
-int16_t current_angle = 135;          // ǰǣ㣩
-int16_t target_angle = 140;           // Ŀ꺽ǣ㣩
-uint8_t current_speed = 45;           // ǰٶȣλʵʶ壩
-uint8_t target_speed = 50;            // Ŀٶȣλʵʶ壩
+// 模拟数据（需替换为实际传感器数据）
+uint8_t self_id;                      // 本车ID
+int16_t current_angle = 135;          // 当前航向角（°）
+int16_t target_angle = 140;           // 目标航向角（°）
+uint8_t current_speed = 45;           // 当前速度（单位根据实际定义）
+uint8_t target_speed = 50;            // 目标速度（单位根据实际定义）
 
+// 各页面完整绘制一次的CPU周期数（最近一次/最大值）
+u32 Page_Render_Cycles[5], Page_Render_Max[5];
+
+// 显示和APP数据使用的状态快照，每次绘制/发送前整体读取一次
+static Robot_Snapshot_t Show_Snap, Telemetry_Snap;
+
+// 各任务的时间预算和耗时统计
+Task_Budget_t Show_Budget      = TASK_BUDGET("UI",  SHOW_PERIOD_MS,      SHOW_BUDGET_US);
+Task_Budget_t Telemetry_Budget = TASK_BUDGET("APP", TELEMETRY_PERIOD_MS, TELEMETRY_BUDGET_US);
+Task_Budget_t Battery_Budget   = TASK_BUDGET("BAT", BATTERY_PERIOD_MS,   BATTERY_BUDGET_US);
+
+
+/**************************************************************************
+Function: 任务单次运行开始计时
+Input   : b - 任务耗时统计
+Output  : none
+**************************************************************************/
+void Task_Budget_Begin(Task_Budget_t *b)
+{
+    b->Start_Us = getMicros();
+    if (b->Runs == 0) b->Window_Start_Us = b->Start_Us;
+}
+
+/**************************************************************************
+Function: 任务单次运行结束：更新最近/最大耗时、超时次数和每秒占用率
+Input   : b - 任务耗时统计
+Output  : none
+**************************************************************************/
+void Task_Budget_End(Task_Budget_t *b)
+{
+    u32 now = getMicros();
+
+    b->Last_Us = now - b->Start_Us;
+    if (b->Last_Us > b->Max_Us) b->Max_Us = b->Last_Us;
+    if (b->Last_Us > b->Budget_Us || b->Last_Us > (u32)b->Period_Ms * 1000u)
+        b->Overruns++;
+    b->Runs++;
+
+    b->Busy_Us += b->Last_Us;
+    if (now - b->Window_Start_Us >= 1000000u)
+    {
+        b->Load_Permille = b->Busy_Us / ((now - b->Window_Start_Us) / 1000u);
+        b->Busy_Us = 0;
+        b->Window_Start_Us = now;
+    }
+}
 
 /**************************************************************************
-Function: ʾ񣺶ȡصѹơOLEDʾAPPݷ
-Input   : pvParameters - δʹã
+Function: 显示任务：蜂鸣器控制、按键检测和OLED显示。启动时创建APP数据任务和电池采样任务
+Input   : pvParameters - 任务参数（未使用）
 Output  : none
 **************************************************************************/
-int Buzzer_count = 25;                // ʱ
+int Buzzer_count = 25;                // 蜂鸣器计数（控制响铃时长）
 void show_task(void *pvParameters)
 {
-    // ʼڣ10msִһΣ100HzƵʣ
-    TickType_t xLastWakeTime = xTaskGetTickCount();  // ¼ʼʱ
-    const TickType_t xFrequency = pdMS_TO_TICKS(10); // ڣ10ms
+    // 创建该任务时可能使用的是原来的优先级，这里确保低于控制任务
+    vTaskPrioritySet(NULL, SHOW_TASK_PRIO);
+
+    // 启动ADC连续DMA采样，电压先读取一次，Balance_task不必等待电池任务
+    Battery_Init();
+    Voltage = Battery.Volt;
+    Voltage_Show = Voltage * 100;
+
+    // FreeRTOS堆(configTOTAL_HEAP_SIZE)不足时任务创建失败：不发送APP数据/电压停留在开机时的读数，通过串口1报告
+    if (xTaskCreate(telemetry_task, "telemetry_task", TELEMETRY_STK_SIZE, NULL, TELEMETRY_TASK_PRIO, NULL) != pdPASS)
+        usart1_send_cstring("[TASK] 创建APP数据任务失败\r\n");
+    if (xTaskCreate(battery_task, "battery_task", BATTERY_STK_SIZE, NULL, BATTERY_TASK_PRIO, NULL) != pdPASS)
+        usart1_send_cstring("[TASK] 创建电池采样任务失败\r\n");
+
+    TickType_t xLastWakeTime = xTaskGetTickCount();            // 记录初始唤醒时间
+    const TickType_t xFrequency = pdMS_TO_TICKS(SHOW_PERIOD_MS);
 
     while(1)
     {
-        // ̶ִȷʱ侫ȣ
+        // 按固定周期执行任务（确保时间精度）
         vTaskDelayUntil(&xLastWakeTime, xFrequency);
-        
-        // ʾǰ500ms죩
+        Task_Budget_Begin(&Show_Budget);
+
+        // 开机蜂鸣器提示（前500ms响）
         if (Time_count < 50)
-            Buzzer_work();          // 
+            Buzzer_work();          // 蜂鸣器工作
         else if (Time_count >= 51 && Time_count < 100)
-            Buzzer_silence();       // 
-        
-        // ȡصѹ10βƽͲ
-        for (i = 0; i < 10; i++)
-            Voltage_All += Get_battery_volt();  // ۼӵѹֵ
-        Voltage = Voltage_All / 10.0;          // ƽֵ
-        Voltage_All = 0;                       // ۼ
-        Voltage_Show = Voltage * 100;          // תΪ2λС
+            Buzzer_silence();       // 蜂鸣器静音
 
-        APP_Show();      // APP
-        oled_show();     // OLEDʾ
+        oled_show();     // 更新OLED显示
+
+        Task_Budget_End(&Show_Budget);
     }
 }
 
 /**************************************************************************
-Function: OLEDʾҳлˢ¶Ӧҳ
+Function: APP数据任务：按TELEMETRY_PERIOD_MS向APP发送状态数据
+Input   : pvParameters - 任务参数（未使用）
+Output  : none
+**************************************************************************/
+void telemetry_task(void *pvParameters)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    const TickType_t xFrequency = pdMS_TO_TICKS(TELEMETRY_PERIOD_MS);
+
+    while(1)
+    {
+        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        Task_Budget_Begin(&Telemetry_Budget);
+        APP_Show();      // 向APP发送数据
+        Task_Budget_End(&Telemetry_Budget);
+    }
+}
+
+/**************************************************************************
+Function: 电池采样任务：按BATTERY_PERIOD_MS从DMA缓冲区计算电池电压（低通+压降检测）
+Input   : pvParameters - 任务参数（未使用）
+Output  : none
+**************************************************************************/
+void battery_task(void *pvParameters)
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    const TickType_t xFrequency = pdMS_TO_TICKS(BATTERY_PERIOD_MS);
+
+    while(1)
+    {
+        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+        Task_Budget_Begin(&Battery_Budget);
+        Voltage = Battery_Read();
+        Voltage_Show = Voltage * 100;          // 转换为整数（保留2位小数）
+        Task_Budget_End(&Battery_Budget);
+
+        // 完整校准的结果在小车静止时写入Flash（擦除扇区会使整机停顿）
+        IMU_Calib_Save_Idle();
+
+        // 压降次数变化时输出一次
+        static uint32_t reported_sags = 0;
+        if (Battery.Sag_Events != reported_sags)
+        {
+            char msg[128];
+            reported_sags = Battery.Sag_Events;
+            snprintf(msg, sizeof(msg), "[电池] 第%lu次压降 最大%.2fV 最低%.2fV 节省%luus/s\r\n",
+                     (unsigned long)Battery.Sag_Events, (double)Battery.Sag_Max, (double)Battery.Volt_Min,
+                     (unsigned long)Battery.Freed_Us_Per_Second);
+            usart1_send_cstring(msg);
+        }
+    }
+}
+
+/**************************************************************************
+Function: OLED显示管理：处理页面切换并刷新对应页面
 Input   : none
 Output  : none
 **************************************************************************/
 void oled_show(void)
 {
-    // ҳл߼
-    static uint8_t last_click = 0;    // һΰ״̬
-    uint8_t click_status = click();   // ǰ״̬
+    // 页面切换逻辑（按键防抖）
+    static uint8_t last_click = 0;    // 上一次按键状态
+    uint8_t click_status = click();   // 当前按键状态
 
-    // شҳл
+    // 按键上升沿触发页面切换（防抖）
     if (click_status && !last_click)
     {
         Page_now++;
-        if (Page_now > 4) Page_now = 1;  // ѭл121
-        OLED_Clear();                    // лҳʱ
+        if (Page_now > 5) Page_now = 1;  // 循环切换（1→5→1）
+        OLED_Clear();                    // 切换页面时清屏
     }
-    last_click = click_status;  // һΰ״̬
+    last_click = click_status;  // 更新上一次按键状态
 
-    // ¼Ƿ״νԼ״̬
+    // 按键每个显示任务周期(50ms)检测，页面绘制和屏幕刷新按OLED_Refresh_Ms(100ms)进行
+    static TickType_t last_refresh = 0;
+    TickType_t now = xTaskGetTickCount();
+    if ((now - last_refresh) < pdMS_TO_TICKS(OLED_Refresh_Ms))
+        return;
+    last_refresh = now;
+
+    // 新增：记录是否首次进入自检完成状态（用于清屏）
     static bool first_enter_ready = true;
 
     if((angle_calibrated==1)&&(gyro_bias_captured==1))
     {
-        // Լɣ״νʱ"Calibrating..."
+        // 自检完成：首次进入时清屏（避免残留"Calibrating..."）
         if (first_enter_ready)
         {
-            OLED_Clear();          // 
-            first_enter_ready = false;  // ñ־ֻһ
+            OLED_Clear();          // 清屏
+            first_enter_ready = false;  // 重置标志，只清屏一次
         }
 
-        // ʾǰҳ
+        // 显示当前页面内容，记录每页完整绘制一次的CPU周期数
+        u32 render_start = getCycleCnt();
+        Robot_Snapshot_Read(&Show_Snap);
         switch (Page_now)
         {
             case 1:
-                    display_page1();    // 1ҳ
+                    display_page1();    // 第1页：电机数据
                     break;
             case 2:
-                    display_page2();    // 2ҳ״̬
+                    display_page2();    // 第2页：基础状态
                     break;
 			case 3:
 					display_page3();
@@ -97,65 +217,92 @@ void oled_show(void)
 			case 4:
 					display_page4();
 					break;
+			case 5:
+					display_page5();
+					break;
             default:
-                Page_now = 1;       // 쳣ʱΪ1ҳ
+                Page_now = 1;       // 异常时重置为第1页
                 break;
         }
+        if (Page_now >= 1 && Page_now <= 5) {
+            Page_Render_Cycles[Page_now - 1] = getCycleCnt() - render_start;
+            if (Page_Render_Cycles[Page_now - 1] > Page_Render_Max[Page_now - 1])
+                Page_Render_Max[Page_now - 1] = Page_Render_Cycles[Page_now - 1];
+        }
     }
     else
     {
-        // ԼУʾУ׼ʾͬʱ״ν־´ʱ
+        // 自检中：显示校准提示，同时重置首次进入标志（下次完成时重新清屏）
         first_enter_ready = true;
         OLED_ShowString(5, 30, "Calibrating... ");
     }
 
-    OLED_Refresh_Gram();  // ˢOLEDԴ棨ʾЧ
+    OLED_Refresh_Gram();  // 刷新OLED显存（只发送变化的区域）
+
+    // 每10秒输出一次屏幕数据量统计
+    static uint32_t stats_count = 0;
+    if (++stats_count % (10000 / OLED_REFRESH_MS_DEFAULT) == 0)
+    {
+        char debug_msg[192];
+        snprintf(debug_msg, sizeof(debug_msg), "[OLED] %luB/s 少发%luB/s 节省%luus/s 第%d页绘制%lu周期 最大%lu\r\n",
+                 (unsigned long)OLED_Stats.Bytes_Per_Second, (unsigned long)OLED_Stats.Skipped_Per_Second,
+                 (unsigned long)OLED_Stats.Saved_Us_Per_Second, Page_now,
+                 (unsigned long)Page_Render_Cycles[Page_now - 1], (unsigned long)Page_Render_Max[Page_now - 1]);
+        usart1_send_cstring(debug_msg);
+        snprintf(debug_msg, sizeof(debug_msg), "[TASK] UI %lu/%luus 超时%lu APP %lu/%luus 超时%lu BAT %lu/%luus 超时%lu\r\n",
+                 (unsigned long)Show_Budget.Last_Us, (unsigned long)Show_Budget.Max_Us, (unsigned long)Show_Budget.Overruns,
+                 (unsigned long)Telemetry_Budget.Last_Us, (unsigned long)Telemetry_Budget.Max_Us, (unsigned long)Telemetry_Budget.Overruns,
+                 (unsigned long)Battery_Budget.Last_Us, (unsigned long)Battery_Budget.Max_Us, (unsigned long)Battery_Budget.Overruns);
+        usart1_send_cstring(debug_msg);
+    }
 }
 
 /**************************************************************************
-Function: OLED2ҳʾСIDꡢǶȡٶȡصѹȻ״̬
+Function: OLED第2页显示：小车ID、坐标、角度、速度、电池电压等基础状态
 Input   : none
 Output  : none
 **************************************************************************/
 void display_page4(void)
 {
-    // ʾСID
+    // 显示小车ID
     OLED_ShowString(0, 0, "ID :    ");
     OLED_ShowString(40, 0, "#");
-    OLED_ShowNumber(45, 0, self_id, 2, 12);  // ʾID2λ
+    OLED_ShowNumber(45, 0, self_id, 2, 12);  // 显示ID（2位）
 
-    // ʾʹ״̬ON/OFF
-    if (EN == 1)
+    // 显示使能状态（ON/OFF）
+    if (Show_Snap.Enable == 1)
         OLED_ShowString(90, 0, "O N");
-    else if (EN == 0)
+    else if (Show_Snap.Enable == 0)
         OLED_ShowString(90, 0, "OFF");
 
-    // ʾǰ꣨2λС
-    char title[16];
-    sprintf(title, "x,y:(%1.2f,%1.2f)", position[0], position[1]);
-    OLED_ShowString(0, 12, title);
-
-    // ʾĿ꣨2λС
-    char target_pos[20];
-    sprintf(target_pos, "X,Y:(%1.2f,%1.2f)", Target_position[0], Target_position[1]);
-    OLED_ShowString(0, 24, target_pos);
-
-    // ʾǣǰYaw/ĿǶȣ - һ
+    // 显示当前坐标和目标坐标（保留2位小数），数值不变时不重新格式化和绘制
+    static OLED_Field_t pos_x = OLED_FIELD(32, 12, 5, 2, 0), pos_y = OLED_FIELD(80, 12, 5, 2, 0);
+    static OLED_Field_t target_x = OLED_FIELD(32, 24, 5, 2, 0), target_y = OLED_FIELD(80, 24, 5, 2, 0);
+    OLED_ShowString(0, 12, "x,y:");
+    OLED_ShowField(&pos_x, Show_Snap.Position[0]);
+    OLED_ShowString(72, 12, ",");
+    OLED_ShowField(&pos_y, Show_Snap.Position[1]);
+    OLED_ShowString(0, 24, "X,Y:");
+    OLED_ShowField(&target_x, Show_Snap.Target_Position[0]);
+    OLED_ShowString(72, 24, ",");
+    OLED_ShowField(&target_y, Show_Snap.Target_Position[1]);
+
+    // 显示航向角（当前Yaw/目标角度） - 下移一行
     OLED_ShowString(0, 36, "YAW:  ");
-    if (Yaw > 0)
-        OLED_ShowString(38, 36, "+");  // ű
+    if (Show_Snap.Yaw > 0)
+        OLED_ShowString(38, 36, "+");  // 正号标记
     else
-        OLED_ShowString(40, 36, "-");  // ű
-    OLED_ShowNumber(43, 36, float_abs(Yaw), 3, 12);  // ʾǶȾֵ
+        OLED_ShowString(40, 36, "-");  // 负号标记
+    OLED_ShowNumber(43, 36, float_abs(Show_Snap.Yaw), 3, 12);  // 显示角度绝对值
 
     OLED_ShowString(65, 36, ",");
-    if (Target_Yaw > 0)
+    if (Show_Snap.Target_Yaw > 0)
         OLED_ShowString(72, 36, "+ ");
     else
         OLED_ShowString(75, 36, "-");
-    OLED_ShowNumber(80, 36, float_abs(Target_Yaw), 3, 12);  // ʾĿǶȾֵ
+    OLED_ShowNumber(80, 36, float_abs(Show_Snap.Target_Yaw), 3, 12);  // 显示目标角度绝对值
 
-    // ʾٶȣǰٶ/Ŀٶȣ - һ
+    // 显示速度（当前速度/目标速度） - 下移一行
     OLED_ShowString(0, 48, "SPD:   ");
     OLED_ShowNumber(45, 48, current_speed, 2, 12);
     OLED_ShowString(65, 48, ",");
@@ -163,368 +310,390 @@ void display_page4(void)
 }
 
 /**************************************************************************
-Function: OLED1ҳʾٶȡYawǡصѹϸ
+Function: OLED第1页显示：电机速度、Yaw角、电池电压等详细数据
 Input   : none
 Output  : none
 **************************************************************************/
 void display_page1(void)
 {
-    // CAR_IDȡ֣CAR_IDʽΪ"CAR1", "CAR2"ȣ
+    // 从CAR_ID中提取数字（假设CAR_ID格式为"CAR1", "CAR2"等）
     if (strlen(CAR_ID) >= 4 && strncmp(CAR_ID, "CAR", 3) == 0) {
-        self_id = atoi(CAR_ID + 3);  // ȡCAR
+        self_id = Num_Atoi(CAR_ID + 3, 4);  // 提取CAR后面的数字
     }
 
     if (self_id < 1 || self_id > 4) {
-        self_id = 2;  // ĬϱIDΪ2
+        self_id = 2;  // 默认本车ID为2
     }
 
-    // 1УСIDZٶ
+    // 第1行：小车ID及Z轴角速度
     OLED_ShowString(0, 0, "#");
-    OLED_ShowNumber(10, 0, self_id, 2, 12);  // ʾID
-    OLED_ShowString(55, 0, "GZ");          // Zٶ
-    if (gyro[2] < 0)
+    OLED_ShowNumber(10, 0, self_id, 2, 12);  // 显示ID
+    OLED_ShowString(55, 0, "GZ");          // 标记Z轴角速度
+    if (Show_Snap.Gyro[2] < 0)
     {
         OLED_ShowString(80, 0, "-");
-        OLED_ShowNumber(90, 0, -gyro[2], 5, 12);  // ʾٶȾֵ
+        OLED_ShowNumber(90, 0, -Show_Snap.Gyro[2], 5, 12);  // 显示负角速度绝对值
     }
     else
     {
         OLED_ShowString(80, 0, "+");
-        OLED_ShowNumber(90, 0, gyro[2], 5, 12);   // ʾٶ
+        OLED_ShowNumber(90, 0, Show_Snap.Gyro[2], 5, 12);   // 显示正角速度
     }
 
-    // 2УAĿٶ/ʵٶ
-    OLED_ShowString(0, 10, "A");  // ǵA
-    // Ŀٶ
-    if (MOTOR_A.Target < 0)
+    // 第2行：电机A目标速度/实际速度
+    OLED_ShowString(0, 10, "A");  // 标记电机A
+    // 目标速度
+    if (Show_Snap.Motor_Target[0] < 0)
     {
         OLED_ShowString(15, 10, "-");
-        OLED_ShowNumber(20, 10, -MOTOR_A.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 10, -Show_Snap.Motor_Target[0] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(15, 10, "+");
-        OLED_ShowNumber(20, 10, MOTOR_A.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 10, Show_Snap.Motor_Target[0] * 1000, 5, 12);
     }
-    // ʵٶȣֵ
-    if (MOTOR_A.Encoder < 0)
+    // 实际速度（编码器值）
+    if (Show_Snap.Motor_Encoder[0] < 0)
     {
         OLED_ShowString(60, 10, "-");
-        OLED_ShowNumber(75, 10, -MOTOR_A.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 10, -Show_Snap.Motor_Encoder[0] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(60, 10, "+");
-        OLED_ShowNumber(75, 10, MOTOR_A.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 10, Show_Snap.Motor_Encoder[0] * 1000, 5, 12);
     }
 
-    // 3УBĿٶ/ʵٶ
-    OLED_ShowString(0, 20, "B");  // ǵB
-    // Ŀٶ
-    if (MOTOR_B.Target < 0)
+    // 第3行：电机B目标速度/实际速度
+    OLED_ShowString(0, 20, "B");  // 标记电机B
+    // 目标速度
+    if (Show_Snap.Motor_Target[1] < 0)
     {
         OLED_ShowString(15, 20, "-");
-        OLED_ShowNumber(20, 20, -MOTOR_B.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 20, -Show_Snap.Motor_Target[1] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(15, 20, "+");
-        OLED_ShowNumber(20, 20, MOTOR_B.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 20, Show_Snap.Motor_Target[1] * 1000, 5, 12);
     }
-    // ʵٶ
-    if (MOTOR_B.Encoder < 0)
+    // 实际速度
+    if (Show_Snap.Motor_Encoder[1] < 0)
     {
         OLED_ShowString(60, 20, "-");
-        OLED_ShowNumber(75, 20, -MOTOR_B.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 20, -Show_Snap.Motor_Encoder[1] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(60, 20, "+");
-        OLED_ShowNumber(75, 20, MOTOR_B.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 20, Show_Snap.Motor_Encoder[1] * 1000, 5, 12);
     }
 
-    // 4УCĿٶ/ʵٶ
-    OLED_ShowString(0, 30, "C");  // ǵC
-    // Ŀٶ
-    if (MOTOR_C.Target < 0)
+    // 第4行：电机C目标速度/实际速度
+    OLED_ShowString(0, 30, "C");  // 标记电机C
+    // 目标速度
+    if (Show_Snap.Motor_Target[2] < 0)
     {
         OLED_ShowString(15, 30, "-");
-        OLED_ShowNumber(20, 30, -MOTOR_C.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 30, -Show_Snap.Motor_Target[2] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(15, 30, "+");
-        OLED_ShowNumber(20, 30, MOTOR_C.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 30, Show_Snap.Motor_Target[2] * 1000, 5, 12);
     }
-    // ʵٶ
-    if (MOTOR_C.Encoder < 0)
+    // 实际速度
+    if (Show_Snap.Motor_Encoder[2] < 0)
     {
         OLED_ShowString(60, 30, "-");
-        OLED_ShowNumber(75, 30, -MOTOR_C.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 30, -Show_Snap.Motor_Encoder[2] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(60, 30, "+");
-        OLED_ShowNumber(75, 30, MOTOR_C.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 30, Show_Snap.Motor_Encoder[2] * 1000, 5, 12);
     }
 
-    // 5УDĿٶ/ʵٶ
-    OLED_ShowString(0, 40, "D");  // ǵD
-    // Ŀٶ
-    if (MOTOR_D.Target < 0)
+    // 第5行：电机D目标速度/实际速度
+    OLED_ShowString(0, 40, "D");  // 标记电机D
+    // 目标速度
+    if (Show_Snap.Motor_Target[3] < 0)
     {
         OLED_ShowString(15, 40, "-");
-        OLED_ShowNumber(20, 40, -MOTOR_D.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 40, -Show_Snap.Motor_Target[3] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(15, 40, "+");
-        OLED_ShowNumber(20, 40, MOTOR_D.Target * 1000, 5, 12);
+        OLED_ShowNumber(20, 40, Show_Snap.Motor_Target[3] * 1000, 5, 12);
     }
-    // ʵٶ
-    if (MOTOR_D.Encoder < 0)
+    // 实际速度
+    if (Show_Snap.Motor_Encoder[3] < 0)
     {
         OLED_ShowString(60, 40, "-");
-        OLED_ShowNumber(75, 40, -MOTOR_D.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 40, -Show_Snap.Motor_Encoder[3] * 1000, 5, 12);
     }
     else
     {
         OLED_ShowString(60, 40, "+");
-        OLED_ShowNumber(75, 40, MOTOR_D.Encoder * 1000, 5, 12);
+        OLED_ShowNumber(75, 40, Show_Snap.Motor_Encoder[3] * 1000, 5, 12);
     }
 
-    // 6УYawǼصѹ
-    // Yawǣţ
-    if (Yaw > 0)
+    // 第6行：Yaw角及电池电压
+    // Yaw角（带正负号）
+    if (Show_Snap.Yaw > 0)
         OLED_ShowString(0, 50, "+");
     else
         OLED_ShowString(0, 50, "-");
-    OLED_ShowNumber(10, 50, myabs(Yaw), 3, 12);  // ʾYawǾֵ
+    OLED_ShowNumber(10, 50, myabs(Show_Snap.Yaw), 3, 12);  // 显示Yaw角绝对值
 
-    // صѹС
-    OLED_ShowNumber(75, 50, Voltage_Show / 100, 2, 12);    // 
+    // 电池电压（带小数）
+    OLED_ShowNumber(75, 50, Voltage_Show / 100, 2, 12);    // 整数部分
     OLED_ShowString(88, 50, ".");
-    OLED_ShowNumber(98, 50, Voltage_Show % 100, 2, 12);    // С
+    OLED_ShowNumber(98, 50, Voltage_Show % 100, 2, 12);    // 小数部分
     OLED_ShowString(110, 50, "V");
-    // Сֲ㣨ȷ2λʾ
+    // 小数部分补零（确保2位显示）
     if (Voltage_Show % 100 < 10)
         OLED_ShowNumber(92, 50, 0, 2, 12);
 }
 
-// ʾٶȡǶȡ꣨ȷʾţ5С12أ
+// 显示三轴角速度、角度、坐标（明确显示正负号，适配5行×12像素）
 void display_page3(void)
 {
-    // -------------------------- һУ0GxGyٶ --------------------------
-    // ࣺGxٶȣţ
+    // -------------------------- 第一行（行0）：Gx和Gy角速度 --------------------------
+    // 左侧：Gx角速度（带正负号）
     OLED_ShowString(0, 0, "Gx:");
-    if (gyro[0] < 0)
+    if (Show_Snap.Gyro[0] < 0)
     {
-        OLED_ShowString(24, 0, "-");  // 
-        OLED_ShowNumber(34, 0, -gyro[0], 4, 12);  // ʾֵ4λ
+        OLED_ShowString(24, 0, "-");  // 负号
+        OLED_ShowNumber(34, 0, -Show_Snap.Gyro[0], 4, 12);  // 显示绝对值（4位）
     }
     else
     {
-        OLED_ShowString(24, 0, "+");  // 
-        OLED_ShowNumber(34, 0, gyro[0], 4, 12);   // ʾֵ4λ
+        OLED_ShowString(24, 0, "+");  // 正号
+        OLED_ShowNumber(34, 0, Show_Snap.Gyro[0], 4, 12);   // 显示正值（4位）
     }
 
-    // ҲࣺGyٶȣţ
+    // 右侧：Gy角速度（带正负号）
     OLED_ShowString(72, 0, "Gy:");
-    if (gyro[1] < 0)
+    if (Show_Snap.Gyro[1] < 0)
     {
-        OLED_ShowString(96, 0, "-");  // 
-        OLED_ShowNumber(106, 0, -gyro[1], 4, 12);  // ʾֵ4λ
+        OLED_ShowString(96, 0, "-");  // 负号
+        OLED_ShowNumber(106, 0, -Show_Snap.Gyro[1], 4, 12);  // 显示绝对值（4位）
     }
     else
     {
-        OLED_ShowString(96, 0, "+");  // 
-        OLED_ShowNumber(106, 0, gyro[1], 4, 12);   // ʾֵ4λ
+        OLED_ShowString(96, 0, "+");  // 正号
+        OLED_ShowNumber(106, 0, Show_Snap.Gyro[1], 4, 12);   // 显示正值（4位）
     }
 
 
-    // -------------------------- ڶУ12Gzٶ --------------------------
+    // -------------------------- 第二行（行12）：Gz角速度 --------------------------
     OLED_ShowString(0, 12, "Gz:");
-    if (gyro[2] < 0)
+    if (Show_Snap.Gyro[2] < 0)
     {
-        OLED_ShowString(24, 12, "-");  // 
-        OLED_ShowNumber(34, 12, -gyro[2], 4, 12);  // ʾֵ4λ
+        OLED_ShowString(24, 12, "-");  // 负号
+        OLED_ShowNumber(34, 12, -Show_Snap.Gyro[2], 4, 12);  // 显示绝对值（4位）
     }
     else
     {
-        OLED_ShowString(24, 12, "+");  // 
-        OLED_ShowNumber(34, 12, gyro[2], 4, 12);   // ʾֵ4λ
+        OLED_ShowString(24, 12, "+");  // 正号
+        OLED_ShowNumber(34, 12, Show_Snap.Gyro[2], 4, 12);   // 显示正值（4位）
     }
 
 
-    // -------------------------- У24RollPitch --------------------------
-    // ࣺRollǣţ1λС
+    // -------------------------- 第三行（行24）：Roll和Pitch角 --------------------------
+    // 左侧：Roll角（带正负号，保留1位小数）
     OLED_ShowString(0, 24, "R:");
-    int roll_val = (int)(Roll * 10);  // 1λС10
+    int roll_val = (int)(Show_Snap.Roll * 10);  // 保留1位小数（×10）
     if (roll_val < 0)
     {
-        OLED_ShowString(20, 24, "-");  // 
-        OLED_ShowNumber(30, 24, -roll_val / 10, 3, 12);  // 
+        OLED_ShowString(20, 24, "-");  // 负号
+        OLED_ShowNumber(30, 24, -roll_val / 10, 3, 12);  // 整数部分
         OLED_ShowString(54, 24, ".");
-        OLED_ShowNumber(60, 24, -roll_val % 10, 1, 12);  // С
+        OLED_ShowNumber(60, 24, -roll_val % 10, 1, 12);  // 小数部分
     }
     else
     {
-        OLED_ShowString(20, 24, "+");  // 
-        OLED_ShowNumber(30, 24, roll_val / 10, 3, 12);   // 
+        OLED_ShowString(20, 24, "+");  // 正号
+        OLED_ShowNumber(30, 24, roll_val / 10, 3, 12);   // 整数部分
         OLED_ShowString(54, 24, ".");
-        OLED_ShowNumber(60, 24, roll_val % 10, 1, 12);   // С
+        OLED_ShowNumber(60, 24, roll_val % 10, 1, 12);   // 小数部分
     }
 
-    // ҲࣺPitchǣţ1λС
+    // 右侧：Pitch角（带正负号，保留1位小数）
     OLED_ShowString(72, 24, "P:");
-    int pitch_val = (int)(Pitch * 10);
+    int pitch_val = (int)(Show_Snap.Pitch * 10);
     if (pitch_val < 0)
     {
-        OLED_ShowString(92, 24, "-");  // 
-        OLED_ShowNumber(102, 24, -pitch_val / 10, 3, 12);  // 
-        OLED_ShowString(126, 24, ".");  // 110أʾ
-        OLED_ShowNumber(132, 24, -pitch_val % 10, 1, 12);  // СλܳӰ
+        OLED_ShowString(92, 24, "-");  // 负号
+        OLED_ShowNumber(102, 24, -pitch_val / 10, 3, 12);  // 整数部分
+        OLED_ShowString(126, 24, ".");  // 不超过110像素，完整显示
+        OLED_ShowNumber(132, 24, -pitch_val % 10, 1, 12);  // 仅小数位可能超，不影响
     }
     else
     {
-        OLED_ShowString(92, 24, "+");  // 
-        OLED_ShowNumber(102, 24, pitch_val / 10, 3, 12);   // 
+        OLED_ShowString(92, 24, "+");  // 正号
+        OLED_ShowNumber(102, 24, pitch_val / 10, 3, 12);   // 整数部分
         OLED_ShowString(126, 24, ".");
         OLED_ShowNumber(132, 24, pitch_val % 10, 1, 12);
     }
 
 
-    // -------------------------- У36Yaw --------------------------
+    // -------------------------- 第四行（行36）：Yaw角 --------------------------
     OLED_ShowString(0, 36, "Y:");
-    int yaw_val = (int)(Yaw * 10);  // 1λС10
+    int yaw_val = (int)(Show_Snap.Yaw * 10);  // 保留1位小数（×10）
     if (yaw_val < 0)
     {
-        OLED_ShowString(20, 36, "-");  // 
-        OLED_ShowNumber(30, 36, -yaw_val / 10, 3, 12);  // 
+        OLED_ShowString(20, 36, "-");  // 负号
+        OLED_ShowNumber(30, 36, -yaw_val / 10, 3, 12);  // 整数部分
         OLED_ShowString(54, 36, ".");
-        OLED_ShowNumber(60, 36, -yaw_val % 10, 1, 12);  // С
+        OLED_ShowNumber(60, 36, -yaw_val % 10, 1, 12);  // 小数部分
     }
     else
     {
-        OLED_ShowString(20, 36, "+");  // 
-        OLED_ShowNumber(30, 36, yaw_val / 10, 3, 12);   // 
+        OLED_ShowString(20, 36, "+");  // 正号
+        OLED_ShowNumber(30, 36, yaw_val / 10, 3, 12);   // 整数部分
         OLED_ShowString(54, 36, ".");
-        OLED_ShowNumber(60, 36, yaw_val % 10, 1, 12);   // С
-    }
-
-
-    // -------------------------- У48Ŀλ --------------------------
-    // ţ1λС
-    char pos_str[16];
-    // X
-    char x_sign = (Target_position[0] >= 0) ? '+' : '-';
-    float x_abs = (Target_position[0] >= 0) ? Target_position[0] : -Target_position[0];
-    // Y
-    char y_sign = (Target_position[1] >= 0) ? '+' : '-';
-    float y_abs = (Target_position[1] >= 0) ? Target_position[1] : -Target_position[1];
-    // ƴַ"X+1.2 Y-3.4"
-    sprintf(pos_str, "X%c%1.1f Y%c%1.1f", x_sign, x_abs, y_sign, y_abs);
-    OLED_ShowString(0, 48, pos_str);  // ʾ
+        OLED_ShowNumber(60, 36, yaw_val % 10, 1, 12);   // 小数部分
+    }
+
+
+    // -------------------------- 第五行（行48）：目标位置坐标 --------------------------
+    // 坐标带正负号，保留1位小数（如"X +1.2 Y  -3.4"）
+    static OLED_Field_t target_x = OLED_FIELD(8, 48, 5, 1, OLED_FIELD_SIGN);
+    static OLED_Field_t target_y = OLED_FIELD(72, 48, 5, 1, OLED_FIELD_SIGN);
+    OLED_ShowString(0, 48, "X");
+    OLED_ShowField(&target_x, Show_Snap.Target_Position[0]);
+    OLED_ShowString(64, 48, "Y");
+    OLED_ShowField(&target_y, Show_Snap.Target_Position[1]);
 }
 
-// ޸page4ʾڶʾа#1~#4˳ʾ
+// 修复后的page4显示：第二行显示本车，其他行按#1~#4顺序显示
 void display_page2(void)
 {
-    const int LINE_HEIGHT = 12;  // и12
-    char line_text[32];          // ÿʾı
-    // -------------------------- һУ --------------------------
+    const int LINE_HEIGHT = 12;  // 行高12像素
+    // 每行：ID(2字符) X(5字符) Y(5字符) YAW(4字符)，共16字符，数值字段右对齐
+    static OLED_Field_t row_x[6], row_y[6], row_yaw[6];
+    static uint8_t rows_ready = 0;
+    if (!rows_ready) {
+        for (int r = 1; r < 6; r++) {
+            OLED_Field_t fx = OLED_FIELD(16, r * LINE_HEIGHT, 5, 2, 0);
+            OLED_Field_t fy = OLED_FIELD(56, r * LINE_HEIGHT, 5, 2, 0);
+            OLED_Field_t fyaw = OLED_FIELD(96, r * LINE_HEIGHT, 4, 0, 0);
+            row_x[r] = fx; row_y[r] = fy; row_yaw[r] = fyaw;
+        }
+        rows_ready = 1;
+    }
+    // -------------------------- 第一行：标题行 --------------------------
     OLED_ShowString(0, 0 * LINE_HEIGHT, "ID   X    Y  YAW");
     
-    // -------------------------- ڶУϢ --------------------------
-    // ʽ#4,1.24,-2.34,-78.0豾#4
-    sprintf(line_text, "#%1d %1.2f %1.2f%4d", 
-            self_id,
-            position[0],         // X
-            position[1],         // Y  
-            (int)Yaw);                // 
-    OLED_ShowString(0, 1 * LINE_HEIGHT, line_text);
+    // -------------------------- 第二行：本车信息 --------------------------
+    // 格式：#4 1.24-2.34 -78（假设本车是#4）
+    OLED_ShowString(0, 1 * LINE_HEIGHT, "#");
+    OLED_ShowNumber(8, 1 * LINE_HEIGHT, self_id, 1, 12);
+    OLED_ShowField(&row_x[1], Show_Snap.Position[0]);     // X坐标
+    OLED_ShowField(&row_y[1], Show_Snap.Position[1]);     // Y坐标
+    OLED_ShowField(&row_yaw[1], (int)Show_Snap.Yaw);      // 航向角
     
-    // -------------------------- мԺ#1~#4 --------------------------
-    int display_line = 2;  // ӵпʼʾ
+    // -------------------------- 第三行及以后：#1~#4（跳过本车） --------------------------
+    int display_line = 2;  // 从第三行开始显示
     
     for (int i = 1; i <= 4; i++) {
-        // ΪѾڵڶʾ
+        // 跳过本车，因为本车已经在第二行显示了
         if (i == self_id) {
             continue;
         }
         
-        if (display_line >= 6) break;  // ĻΧ
-        
-        char target_id[8];
-        snprintf(target_id, sizeof(target_id), "CAR%d", i);
+        if (display_line >= 6) break;  // 超出屏幕范围
         
-        // ҵǰСǷ
-        int car_index = -1;
-        for (int j = 0; j < MAX_OTHER_CARS; j++) {
-            if (other_cars[j].valid && strcmp(other_cars[j].car_id, target_id) == 0) {
-                car_index = j;
-                break;
-            }
-        }
+        // 快照中的其他车辆数据（由控制任务从other_cars[]复制，不直接读取车辆表）
+        const int car_index = i - 1;
         
-        // ߣʾʵݣߣʾʼֵ (0.00, 0.00, 0.0)
-        if (car_index != -1) {
-            // ʾʵʽյ
-            sprintf(line_text, "#%1d %1.2f %1.2f%4d",
-                    i,
-                    other_cars[car_index].position_x,
-                    other_cars[car_index].position_y, 
-                     (int)(other_cars[car_index].yaw));
+        // 在线：显示实际数据；不在线：显示初始化值 (0.00, 0.00, 0)
+        OLED_ShowString(0, display_line * LINE_HEIGHT, "#");
+        OLED_ShowNumber(8, display_line * LINE_HEIGHT, i, 1, 12);
+        if (car_index < SNAPSHOT_PEERS && Show_Snap.Peer[car_index].Valid) {
+            // 显示实际接收到的数据
+            OLED_ShowField(&row_x[display_line], Show_Snap.Peer[car_index].X);
+            OLED_ShowField(&row_y[display_line], Show_Snap.Peer[car_index].Y);
+            OLED_ShowField(&row_yaw[display_line], (int)(Show_Snap.Peer[car_index].Yaw));
         } else {
-            // ߣʾʼֵ (0.00, 0.00, 0.0)
-            sprintf(line_text, "#%1d %1.2f %1.2f%4d", 
-                    i, 0.00f, 0.00f, 0.0f);
+            OLED_ShowField(&row_x[display_line], 0.0f);
+            OLED_ShowField(&row_y[display_line], 0.0f);
+            OLED_ShowField(&row_yaw[display_line], 0.0f);
         }
-        
-        OLED_ShowString(0, display_line * LINE_HEIGHT, line_text);
         display_line++;
     }
     
 }
 
 /**************************************************************************
-Function: APPݣ״̬ȣ
+Function: OLED第5页显示：各任务最近/最大耗时(us)、超时次数和占用率(千分比)
+Input   : none
+Output  : none
+**************************************************************************/
+void display_page5(void)
+{
+    Task_Budget_t *const tasks[3] = { &Show_Budget, &Telemetry_Budget, &Battery_Budget };
+
+    OLED_ShowString(0, 0, "TSK LAST  MAX  OVR");
+    for (int t = 0; t < 3; t++) {
+        u8 y = (t + 1) * 12;
+        OLED_ShowString(0, y, tasks[t]->Name);
+        OLED_ShowNumber(24, y, tasks[t]->Last_Us, 5, 12);
+        OLED_ShowNumber(60, y, tasks[t]->Max_Us, 5, 12);
+        OLED_ShowNumber(96, y, tasks[t]->Overruns, 5, 12);
+    }
+
+    // 最后一行：显示任务占用率和快照重读次数
+    OLED_ShowString(0, 48, "LOAD");
+    OLED_ShowNumber(30, 48, Show_Budget.Load_Permille, 3, 12);
+    OLED_ShowString(60, 48, "RTY");
+    OLED_ShowNumber(84, 48, Robot_Snapshot_Retries, 6, 12);
+}
+
+/**************************************************************************
+Function: 向APP发送数据（状态、参数等）
 Input   : none
 Output  : none
 **************************************************************************/
 void APP_Show(void)
 {    
-    static u8 flag_show;  // 淢ͱǣ̬
+    static u8 flag_show;  // 交替发送标记（静态变量）
     int Left_Figure, Right_Figure, Voltage_Show;
 
-    // صѹתΪٷֱȣ10-12.7VӦ0-100%
-    Voltage_Show = (Voltage * 1000 - 10000) / 27;
-    if (Voltage_Show > 100) Voltage_Show = 100;  // ޱ
+    Robot_Snapshot_Read(&Telemetry_Snap);  // 同一控制周期的状态
+
+    // 电池电压转换为百分比（10-12.7V对应0-100%）
+    Voltage_Show = (Telemetry_Snap.Voltage * 1000 - 10000) / 27;
+    if (Voltage_Show > 100) Voltage_Show = 100;  // 上限保护
 
-    // ٶתλ0.01m/sAPPʾ
-    Left_Figure = MOTOR_A.Encoder * 100;
-    if (Left_Figure < 0) Left_Figure = -Left_Figure;  // ȡֵ
-    Right_Figure = MOTOR_B.Encoder * 100;
+    // 电机速度转换（单位：0.01m/s，便于APP显示）
+    Left_Figure = Telemetry_Snap.Motor_Encoder[0] * 100;
+    if (Left_Figure < 0) Left_Figure = -Left_Figure;  // 取绝对值
+    Right_Figure = Telemetry_Snap.Motor_Encoder[1] * 100;
     if (Right_Figure < 0) Right_Figure = -Right_Figure;
 
-    // 淢ݣAPP/ݣ
+    // 交替发送数据（APP数据/波形数据）
     flag_show = !flag_show;
 
-    // PIDAPPԽʾ
+    // 发送PID参数（APP调试界面显示）
     if (PID_Send == 1)
     {
         printf("{C%d:%d:%d}$", (int)RC_Velocity, (int)Velocity_KP, (int)Velocity_KI);
-        PID_Send = 0;  // ͺ
+        PID_Send = 0;  // 发送后清零标记
     }
-    // ״̬ݣAPPҳʾ
+    // 发送状态数据（APP首页显示）
     else if (flag_show == 0)
     {
-        printf("{A%d:%d:%d:%d}$", (u8)Left_Figure, (u8)Right_Figure, Voltage_Show, Yaw);
+        printf("{A%d:%d:%d:%d}$", (u8)Left_Figure, (u8)Right_Figure, Voltage_Show, (int)Telemetry_Snap.Yaw);
     }
-    // ͲݣAPPνʾ
+    // 发送波形数据（APP波形界面显示）
     else
     {
-        printf("{B%d:%d:%d}$", (int)gyro[0], (int)gyro[1], (int)gyro[2]);
+        printf("{B%d:%d:%d}$", (int)Telemetry_Snap.Gyro[0], (int)Telemetry_Snap.Gyro[1], (int)Telemetry_Snap.Gyro[2]);
     }
 }
 
@@ -2,24 +2,64 @@
 #define __SHOW_H
 #include "system.h"
 
-// ʾ
-#define SHOW_TASK_PRIO		3       // ʾȼ
-#define SHOW_STK_SIZE 		512     // ʾջС
-
-static u32 sysTickCnt = 0;          // ϵͳδ̬
-
-// 
-void show_task(void *pvParameters);     // OLEDʾ
-void oled_show(void);                   // OLEDʾҳл+ˢ£
-void oled2_show(void);                  // ԤOLEDʾ
-void display_page1(void);               // OLED1ҳʾݣ
-void display_page2(void);               // OLED2ҳʾ״̬ݣ
-void display_page3(void);               // OLED3ҳʾ
-void display_page4(void);               // OLED4ҳʾ
-void OLED_ShowCheckConfirming(void);    // OLEDʾԼȷ
-void OLED_ShowChecking(void);           // OLEDʾԼ
-void OLED_ShowCheckResult(void);        // OLEDʾԼ
-void APP_Show(void);                    // APP
+// 显示任务配置：显示、APP数据和电池采样都低于控制任务(优先级3)，不会推迟控制周期
+// show_task由main.c创建，启动后再创建APP数据任务和电池采样任务
+#define SHOW_TASK_PRIO		2       // 显示任务优先级
+#define SHOW_STK_SIZE 		512     // 显示任务堆栈大小
+#define SHOW_PERIOD_MS		50      // 显示任务周期：按键检测和蜂鸣器，页面按OLED_Refresh_Ms(100ms)绘制
+#define SHOW_BUDGET_US		15000   // 显示任务每次运行的时间预算（含整屏刷新）
+
+#define TELEMETRY_TASK_PRIO	2       // APP数据任务优先级
+#define TELEMETRY_STK_SIZE	256     // APP数据任务堆栈大小
+#define TELEMETRY_PERIOD_MS	50      // APP数据周期，A帧和B帧交替，各10Hz
+#define TELEMETRY_BUDGET_US	3000    // APP数据任务时间预算（printf逐字节等待发送完成）
+
+#define BATTERY_TASK_PRIO	1       // 电池采样任务优先级（仅高于空闲任务）
+#define BATTERY_STK_SIZE	256     // 电池采样任务堆栈大小（含snprintf）
+#define BATTERY_PERIOD_MS	50      // 电池采样周期
+#define BATTERY_BUDGET_US	100     // 电池采样任务时间预算（DMA缓冲区求平均）
+
+// 任务耗时统计。用getMicros测量从开始到结束的时间，包含被更高优先级任务抢占的时间，
+// 因此是CPU占用的上界。单次超过预算或超过周期都计为一次超时
+typedef struct
+{
+    const char *Name;
+    u16 Period_Ms;          // 任务周期
+    u16 Budget_Us;          // 单次运行时间预算
+    u32 Start_Us;
+    u32 Last_Us, Max_Us;    // 最近一次/最大运行时间，us
+    u32 Runs, Overruns;     // 运行次数/超时次数
+    u32 Busy_Us;            // 当前1秒窗口内的累计运行时间
+    u32 Window_Start_Us;
+    u16 Load_Permille;      // 上一个1秒窗口的占用率，千分比
+}Task_Budget_t;
+
+#define TASK_BUDGET(name, period_ms, budget_us) { name, period_ms, budget_us }
+
+extern Task_Budget_t Show_Budget, Telemetry_Budget, Battery_Budget;
+
+static u32 sysTickCnt = 0;          // 系统滴答计数（静态变量）
+
+// 各页面完整绘制一次的CPU周期数（最近一次/最大值）
+extern u32 Page_Render_Cycles[5], Page_Render_Max[5];
+
+// 函数声明
+void show_task(void *pvParameters);     // OLED显示及相关任务（主任务）
+void telemetry_task(void *pvParameters);  // APP数据任务
+void battery_task(void *pvParameters);    // 电池电压采样任务
+void Task_Budget_Begin(Task_Budget_t *b); // 任务单次运行开始计时
+void Task_Budget_End(Task_Budget_t *b);   // 任务单次运行结束，更新耗时和超时统计
+void oled_show(void);                   // OLED显示管理（页面切换+内容刷新）
+void oled2_show(void);                  // 预留OLED显示函数
+void display_page1(void);               // OLED第1页显示（电机数据）
+void display_page2(void);               // OLED第2页显示（基础状态数据）
+void display_page3(void);               // OLED第3页显示
+void display_page4(void);               // OLED第4页显示
+void display_page5(void);               // OLED第5页显示（任务耗时诊断）
+void OLED_ShowCheckConfirming(void);    // OLED显示自检确认
+void OLED_ShowChecking(void);           // OLED显示自检中
+void OLED_ShowCheckResult(void);        // OLED显示自检结果
+void APP_Show(void);                    // 向APP发送数据
 
 #endif
 
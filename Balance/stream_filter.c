@@ -0,0 +1,275 @@
+#include "stream_filter.h"
+#include <math.h>
+#include "float_only.h"
+
+#define FILTER_PI 3.14159265358979f
+
+/**************************************************************************
+Function: Initialise an integer moving average
+Input   : f: filter; buf: window storage of size entries; size: window length
+Output  : none
+函数功能：初始化整数滑动平均滤波器
+入口参数：f：滤波器；buf：size个元素的窗口存储区；size：窗口长度
+返回  值：无
+**************************************************************************/
+void Filter_MA_Init(Filter_MA_t *f, int32_t *buf, uint16_t size)
+{
+	f->Buf = buf;
+	f->Size = size ? size : 1;
+	f->Sum = 0;
+	f->Index = 0;
+	f->Count = 0;
+}
+
+/**************************************************************************
+Function: Push one sample into an integer moving average
+Input   : f: filter; x: new sample
+Output  : Mean of the samples in the window
+函数功能：向整数滑动平均滤波器压入一个样本
+入口参数：f：滤波器；x：新样本
+返回  值：窗口内样本的均值
+**************************************************************************/
+int32_t Filter_MA_Update(Filter_MA_t *f, int32_t x)
+{
+	//The oldest sample leaves the sum as the new one enters
+	//新样本加入累加和的同时移出最旧的样本
+	if(f->Count == f->Size) f->Sum -= f->Buf[f->Index];
+	else f->Count++;
+	f->Buf[f->Index] = x;
+	f->Sum += x;
+	if(++f->Index == f->Size) f->Index = 0;
+	return f->Sum / f->Count;
+}
+
+/**************************************************************************
+Function: Initialise a float moving average
+Input   : f: filter; buf: window storage of size entries; size: window length
+Output  : none
+函数功能：初始化浮点滑动平均滤波器
+入口参数：f：滤波器；buf：size个元素的窗口存储区；size：窗口长度
+返回  值：无
+**************************************************************************/
+void Filter_MAf_Init(Filter_MAf_t *f, float *buf, uint16_t size)
+{
+	f->Buf = buf;
+	f->Size = size ? size : 1;
+	f->Sum = 0;
+	f->Index = 0;
+	f->Count = 0;
+}
+
+/**************************************************************************
+Function: Fill the window of a float moving average with one value
+Input   : f: filter; x: value, as if the input had been steady at x
+Output  : none
+函数功能：用同一个值填满浮点滑动平均的窗口
+入口参数：f：滤波器；x：填充值，相当于输入一直稳定在x
+返回  值：无
+**************************************************************************/
+void Filter_MAf_Reset(Filter_MAf_t *f, float x)
+{
+	uint16_t i;
+
+	for(i = 0; i < f->Size; i++) f->Buf[i] = x;
+	f->Sum = x * (float)f->Size;
+	f->Index = 0;
+	f->Count = f->Size;
+}
+
+/**************************************************************************
+Function: Push one sample into a float moving average
+Input   : f: filter; x: new sample
+Output  : Mean of the samples in the window
+函数功能：向浮点滑动平均滤波器压入一个样本
+入口参数：f：滤波器；x：新样本
+返回  值：窗口内样本的均值
+**************************************************************************/
+float Filter_MAf_Update(Filter_MAf_t *f, float x)
+{
+	uint16_t i;
+
+	if(f->Count == f->Size) f->Sum -= f->Buf[f->Index];
+	else f->Count++;
+	f->Buf[f->Index] = x;
+	f->Sum += x;
+	if(++f->Index == f->Size)
+	{
+		f->Index = 0;
+		//Rebuild the sum once per window, one pass per Size samples keeps it O(1)
+		//每个窗口重新求和一次，摊到每个样本仍为O(1)
+		if(f->Count == f->Size)
+		{
+			f->Sum = 0;
+			for(i = 0; i < f->Size; i++) f->Sum += f->Buf[i];
+		}
+	}
+	return f->Sum / f->Count;
+}
+
+/**************************************************************************
+Function: Load biquad coefficients and clear the state
+Input   : f: filter; b0, b1, b2: numerator; a1, a2: denominator, a0 = 1
+Output  : none
+函数功能：装载二阶节系数并清零状态
+入口参数：f：滤波器；b0，b1，b2：分子系数；a1，a2：分母系数，a0为1
+返回  值：无
+**************************************************************************/
+void Filter_Biquad_Init(Filter_Biquad_t *f, float b0, float b1, float b2, float a1, float a2)
+{
+	f->b0 = b0;
+	f->b1 = b1;
+	f->b2 = b2;
+	f->a1 = a1;
+	f->a2 = a2;
+	f->z1 = 0;
+	f->z2 = 0;
+}
+
+/**************************************************************************
+Function: Design a second order low pass (RBJ cookbook)
+Input   : f: filter; sample_hz: update rate; cutoff_hz: -3dB frequency; q: 0.7071 for Butterworth
+Output  : none
+函数功能：设计二阶低通滤波器(RBJ公式)
+入口参数：f：滤波器；sample_hz：更新频率；cutoff_hz：截止频率；q：巴特沃斯取0.7071
+返回  值：无
+**************************************************************************/
+void Filter_Biquad_Lowpass(Filter_Biquad_t *f, float sample_hz, float cutoff_hz, float q)
+{
+	float w0 = 2.0f * FILTER_PI * cutoff_hz / sample_hz;
+	float cs = cosf(w0);
+	float alpha = sinf(w0) / (2.0f * q);
+	float a0 = 1.0f + alpha;
+
+	Filter_Biquad_Init(f, (1.0f - cs) * 0.5f / a0, (1.0f - cs) / a0, (1.0f - cs) * 0.5f / a0,
+	                   -2.0f * cs / a0, (1.0f - alpha) / a0);
+}
+
+/**************************************************************************
+Function: Design a notch (RBJ cookbook)
+Input   : f: filter; sample_hz: update rate; center_hz: rejected frequency; q: sharpness
+Output  : none
+函数功能：设计陷波滤波器(RBJ公式)
+入口参数：f：滤波器；sample_hz：更新频率；center_hz：陷波频率；q：品质因数
+返回  值：无
+**************************************************************************/
+void Filter_Biquad_Notch(Filter_Biquad_t *f, float sample_hz, float center_hz, float q)
+{
+	float w0 = 2.0f * FILTER_PI * center_hz / sample_hz;
+	float cs = cosf(w0);
+	float alpha = sinf(w0) / (2.0f * q);
+	float a0 = 1.0f + alpha;
+
+	Filter_Biquad_Init(f, 1.0f / a0, -2.0f * cs / a0, 1.0f / a0,
+	                   -2.0f * cs / a0, (1.0f - alpha) / a0);
+}
+
+/**************************************************************************
+Function: Run one sample through a biquad section
+Input   : f: filter; x: new sample
+Output  : Filtered sample
+函数功能：二阶节滤波器处理一个样本
+入口参数：f：滤波器；x：新样本
+返回  值：滤波结果
+**************************************************************************/
+float Filter_Biquad_Update(Filter_Biquad_t *f, float x)
+{
+	float y = f->b0 * x + f->z1;
+	f->z1 = f->b1 * x - f->a1 * y + f->z2;
+	f->z2 = f->b2 * x - f->a2 * y;
+	return y;
+}
+
+/**************************************************************************
+Function: Preload the state as if x had been applied forever, avoids the start up transient
+Input   : f: filter; x: steady input
+Output  : none
+函数功能：按输入x已长期保持来预置状态，避免启动瞬态
+入口参数：f：滤波器；x：稳态输入
+返回  值：无
+**************************************************************************/
+void Filter_Biquad_Reset(Filter_Biquad_t *f, float x)
+{
+	float den = 1.0f + f->a1 + f->a2;
+	float y = (den != 0.0f) ? x * (f->b0 + f->b1 + f->b2) / den : 0.0f;
+	f->z1 = y - f->b0 * x;
+	f->z2 = f->b2 * x - f->a2 * y;
+}
+
+/**************************************************************************
+Function: Initialise a median filter
+Input   : f: filter; size: window length, 1..FILTER_MEDIAN_MAX, odd sizes give a true median
+Output  : none
+函数功能：初始化中值滤波器
+入口参数：f：滤波器；size：窗口长度，1~FILTER_MEDIAN_MAX，奇数时为严格中值
+返回  值：无
+**************************************************************************/
+void Filter_Median_Init(Filter_Median_t *f, uint8_t size)
+{
+	if(size < 1) size = 1;
+	if(size > FILTER_MEDIAN_MAX) size = FILTER_MEDIAN_MAX;
+	f->Size = size;
+	f->Index = 0;
+	f->Count = 0;
+}
+
+/**************************************************************************
+Function: Push one sample into a median filter
+Input   : f: filter; x: new sample
+Output  : Median of the samples in the window
+函数功能：向中值滤波器压入一个样本
+入口参数：f：滤波器；x：新样本
+返回  值：窗口内样本的中值
+**************************************************************************/
+float Filter_Median_Update(Filter_Median_t *f, float x)
+{
+	float sorted[FILTER_MEDIAN_MAX], v;
+	uint8_t i, j;
+
+	f->Buf[f->Index] = x;
+	if(++f->Index == f->Size) f->Index = 0;
+	if(f->Count < f->Size) f->Count++;
+
+	//Insertion sort, at most FILTER_MEDIAN_MAX entries
+	//插入排序，最多FILTER_MEDIAN_MAX个元素
+	for(i = 0; i < f->Count; i++)
+	{
+		v = f->Buf[i];
+		for(j = i; j > 0 && sorted[j - 1] > v; j--) sorted[j] = sorted[j - 1];
+		sorted[j] = v;
+	}
+	return sorted[f->Count / 2];
+}
+
+/**************************************************************************
+Function: Initialise a first order low pass
+Input   : f: filter; alpha: weight of the new sample, 0..1
+Output  : none
+函数功能：初始化一阶低通滤波器
+入口参数：f：滤波器；alpha：新样本的权重，0~1
+返回  值：无
+**************************************************************************/
+void Filter_EMA_Init(Filter_EMA_t *f, float alpha)
+{
+	f->Alpha = alpha;
+	f->Value = 0;
+	f->Primed = 0;
+}
+
+/**************************************************************************
+Function: Push one sample into a first order low pass
+Input   : f: filter; x: new sample
+Output  : Filtered value, the first sample is passed through
+函数功能：向一阶低通滤波器压入一个样本
+入口参数：f：滤波器；x：新样本
+返回  值：滤波结果，第一个样本直接输出
+**************************************************************************/
+float Filter_EMA_Update(Filter_EMA_t *f, float x)
+{
+	if(!f->Primed)
+	{
+		f->Value = x;
+		f->Primed = 1;
+	}
+	else f->Value += f->Alpha * (x - f->Value);
+	return f->Value;
+}
@@ -0,0 +1,86 @@
+#ifndef __STREAM_FILTER_H
+#define __STREAM_FILTER_H
+#include <stdint.h>
+
+//Streaming filters with O(1) work per sample. Each filter keeps its state in
+//a struct so one module can run as many instances as it has signals. Window
+//buffers are supplied by the caller, nothing is allocated.
+//逐样本处理的流式滤波器，每个样本O(1)开销。状态保存在结构体中，一个模块可按信号数建立多个实例。
+//窗口缓冲区由调用者提供，不做动态分配
+
+//Largest median window, the sort is done on a copy of the window
+//中值滤波最大窗口，排序在窗口副本上进行
+#define FILTER_MEDIAN_MAX        9
+
+//Moving average of integer samples, the running sum is exact. Until the window
+//is full the mean is over the samples received so far
+//整数样本的滑动平均，累加和无误差。窗口填满前为已收到样本的均值
+typedef struct
+{
+	int32_t *Buf;                 //Window storage, Size entries //窗口存储区，Size个元素
+	int32_t  Sum;                 //Sum of the samples in the window //窗口内样本和
+	uint16_t Size;
+	uint16_t Index;               //Slot the next sample overwrites //下一个样本写入的位置
+	uint16_t Count;               //Samples in the window, Size once full //窗口内样本数，填满后为Size
+}Filter_MA_t;
+
+//Moving average of float samples. The sum is rebuilt once per window so
+//rounding cannot build up. Warm up as Filter_MA, or fill the window with
+//Filter_MAf_Reset
+//浮点样本的滑动平均。每经过一个窗口重新求和一次，避免舍入误差累积。
+//预热方式与Filter_MA相同，也可用Filter_MAf_Reset填满窗口
+typedef struct
+{
+	float   *Buf;
+	float    Sum;
+	uint16_t Size;
+	uint16_t Index;
+	uint16_t Count;
+}Filter_MAf_t;
+
+//Biquad section, transposed direct form II
+//二阶节(双二阶)滤波器，转置直接II型
+typedef struct
+{
+	float b0, b1, b2, a1, a2;     //Coefficients, a0 normalised to 1 //系数，a0归一化为1
+	float z1, z2;                 //State //状态
+}Filter_Biquad_t;
+
+//Median of the last Size samples, rejects single spikes
+//最近Size个样本的中值，用于剔除单点尖峰
+typedef struct
+{
+	float   Buf[FILTER_MEDIAN_MAX];
+	uint8_t Size;
+	uint8_t Index;
+	uint8_t Count;
+}Filter_Median_t;
+
+//First order low pass, y += Alpha*(x-y)
+//一阶低通，y += Alpha*(x-y)
+typedef struct
+{
+	float   Alpha;                //Weight of the new sample, 0..1 //新样本的权重，0~1
+	float   Value;
+	uint8_t Primed;               //0 until the first sample //收到第一个样本前为0
+}Filter_EMA_t;
+
+void    Filter_MA_Init(Filter_MA_t *f, int32_t *buf, uint16_t size);
+int32_t Filter_MA_Update(Filter_MA_t *f, int32_t x);
+void    Filter_MAf_Init(Filter_MAf_t *f, float *buf, uint16_t size);
+float   Filter_MAf_Update(Filter_MAf_t *f, float x);
+void    Filter_MAf_Reset(Filter_MAf_t *f, float x);
+
+void  Filter_Biquad_Init(Filter_Biquad_t *f, float b0, float b1, float b2, float a1, float a2);
+void  Filter_Biquad_Lowpass(Filter_Biquad_t *f, float sample_hz, float cutoff_hz, float q);
+void  Filter_Biquad_Notch(Filter_Biquad_t *f, float sample_hz, float center_hz, float q);
+float Filter_Biquad_Update(Filter_Biquad_t *f, float x);
+void  Filter_Biquad_Reset(Filter_Biquad_t *f, float x);
+
+void  Filter_Median_Init(Filter_Median_t *f, uint8_t size);
+float Filter_Median_Update(Filter_Median_t *f, float x);
+
+void  Filter_EMA_Init(Filter_EMA_t *f, float alpha);
+float Filter_EMA_Update(Filter_EMA_t *f, float x);
+
+#endif
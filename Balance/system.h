@@ -2,14 +2,14 @@
 #define __SYSTEM_H
 
 // Refer to all header files you need
-//Ҫõͷļ
-//FreeRTOSͷļ 
+//引用所有需要用到的头文件
+//FreeRTOS相关头文件 
 //FreeRTOS related header files
 #include "FreeRTOS.h"
 #include "task.h"
 #include "FreeRTOSConfig.h"
 //The associated header file for the peripheral 
-//ͷļ
+//外设的相关头文件
 #include "main.h"
 #include "led.h"
 #include "oled.h"
@@ -34,7 +34,7 @@
 #include "wifi_task.h"
 #include "esp8266_driver.h"
 // Enumeration of car types
-//Сͺŵöٶ
+//小车型号的枚举定义
 typedef enum 
 {
 	Mec_Car = 0, 
@@ -46,18 +46,18 @@ typedef enum
 } CarMode;
 
 //Motor speed control related parameters of the structure
-//ٶȿزṹ
+//电机速度控制相关参数结构体
 typedef struct  
 {
-	float Encoder;     //Read the real time speed of the motor by encoder //ֵȡʵʱٶ
-	float Motor_Pwm;   //Motor PWM value, control the real-time speed of the motor //PWMֵƵʵʱٶ
-	float Target;      //Control the target speed of the motor //ĿٶֵƵĿٶ
-	float Velocity_KP; //Speed control PID parameters //ٶȿPID
-	float	Velocity_KI; //Speed control PID parameters //ٶȿPID
+	float Encoder;     //Read the real time speed of the motor by encoder //编码器数值，读取电机实时速度
+	float Motor_Pwm;   //Motor PWM value, control the real-time speed of the motor //电机PWM数值，控制电机实时速度
+	float Target;      //Control the target speed of the motor //电机目标速度值，控制电机目标速度
+	float Velocity_KP; //Speed control PID parameters //速度控制PID参数
+	float	Velocity_KI; //Speed control PID parameters //速度控制PID参数
 }Motor_parameter;
 
 //Smoothed the speed of the three axes
-//ƽٶ
+//平滑处理后的三轴速度
 typedef struct  
 {
 	float VX;
@@ -67,7 +67,7 @@ typedef struct
 
 /****** external variable definition. When system.h is referenced in other C files, 
         other C files can also use the variable defined by system.c           ******/
-/****** ⲿ壬cļsystem.hʱҲʹsystem.cı ******/
+/****** 外部变量定义，当其它c文件引用system.h时，也可以使用system.c定义的变量 ******/
 extern u8 Flag_Stop;
 extern int Divisor_Mode;
 extern u8 Car_Mode;
@@ -93,17 +93,20 @@ extern float Omni_Car_ELE_KP,Omni_Car_ELE_KI;
 extern float Tank_Car_CCD_KP,Tank_Car_CCD_KI;
 extern float Tank_Car_ELE_KP,Tank_Car_ELE_KI; 
 void systemInit(void);
-/***Macros define***/ /***궨***/
-//
+/***Macros define***/ /***宏定义***/
+//蜂鸣器控制
 #define Buzzer_work()  HAL_GPIO_WritePin(GPIOA,GPIO_PIN_8,GPIO_PIN_SET)
 #define Buzzer_silence()  HAL_GPIO_WritePin(GPIOA,GPIO_PIN_8,GPIO_PIN_RESET)
 
 
 //After starting the car (1000/100Hz =10) for seconds, it is allowed to control the car to move
-//(CONTROL_DELAY/50hz)С˶
+//开机(CONTROL_DELAY/50hz)秒后才允许控制小车进行运动
+//Deviation_Count is set to this value once the IMU calibration is done, which takes
+//about 1 s with a valid stored calibration, see imu_calib.h
+//IMU校准完成后Deviation_Count被置为该值，Flash中有有效校准数据时约需1秒，见imu_calib.h
 #define CONTROL_DELAY		750
 //The number of robot types to determine the value of Divisor_Mode. There are currently 6 car types
-//ͺDivisor_ModeֵĿǰ6С
+//机器人型号数量，决定Divisor_Mode的值，目前有6种小车类型
 #define CAR_NUMBER    6      
 #define RATE_1_HZ		  1
 #define RATE_5_HZ		  5
@@ -116,10 +119,10 @@ void systemInit(void);
 #define RATE_250_HZ 	250
 #define RATE_500_HZ 	500
 #define RATE_1000_HZ 	1000
-/***Macros define***/ /***궨***/
+/***Macros define***/ /***宏定义***/
 
 //C library function related header file
-//C⺯ͷļ
+//C库函数的相关头文件
 #include <stdio.h> 
 #include <stdint.h>
 #include <stdlib.h>
@@ -0,0 +1,110 @@
+#include "wheel_sync.h"
+#include "fast_math.h"
+#include <math.h>
+#include "float_only.h"
+
+#define WHEEL_SYNC_PI 3.14159265f
+
+Wheel_Sync_t Wheel_Sync;
+
+static float Sync_Limit(float value, float limit)
+{
+	if(value > limit)  return limit;
+	if(value < -limit) return -limit;
+	return value;
+}
+
+//Chassis velocity from wheel speeds, the least squares inverse of Drive_Motor
+//由车轮速度求车体速度，为Drive_Motor运动学的最小二乘逆解
+static void Sync_To_Body(const float w[4], float lever, float body[3])
+{
+	body[0] = ( w[0] + w[1] + w[2] + w[3]) * 0.25f;
+	body[1] = ( w[0] - w[1] + w[2] - w[3]) * 0.25f;
+	body[2] = (-w[0] - w[1] + w[2] + w[3]) * 0.25f / lever;
+}
+
+/**************************************************************************
+Function: Cross coupled correction of the wheel targets and slip detection, once per control tick
+Input   : s: state; target: wheel targets A..D, m/s; measured: wheel speeds A..D, m/s;
+          gyro_rate_dps: z gyro, degree/s; lever: Axle_spacing+Wheel_spacing; dt: tick, s
+Output  : none, the correction is in s->Correction
+函数功能：车轮目标的交叉耦合修正及打滑检测，每个控制周期调用一次
+入口参数：s：状态；target：A~D车轮目标速度，m/s；measured：A~D车轮实际速度，m/s；
+          gyro_rate_dps：z轴角速度，度/秒；lever：Axle_spacing+Wheel_spacing；dt：周期，秒
+返回  值：无，修正量保存在s->Correction中
+**************************************************************************/
+void Wheel_Sync_Update(Wheel_Sync_t *s, const float target[4], const float measured[4],
+                       float gyro_rate_dps, float lever, float dt)
+{
+	float error[4], cmd[3], meas[3], u[4], along, speed, slip_rate, null_meas;
+	uint8_t i, slip;
+
+	if(lever < 0.01f) lever = 0.01f;
+	for(i = 0; i < 4; i++) error[i] = target[i] - measured[i];
+
+	Sync_To_Body(error, lever, s->Error_Body);
+	s->Error_Null = (error[0] - error[1] - error[2] + error[3]) * 0.25f;
+
+	//Slip detection //打滑检测
+	Sync_To_Body(measured, lever, meas);
+	s->Odom_Yaw_Rate = meas[2];
+	s->Gyro_Yaw_Rate = gyro_rate_dps * WHEEL_SYNC_PI / 180.0f;
+	slip_rate = fabsf(s->Odom_Yaw_Rate - s->Gyro_Yaw_Rate);
+	null_meas = fabsf(measured[0] - measured[1] - measured[2] + measured[3]) * 0.25f;
+	slip = (slip_rate > WHEEL_SLIP_RATE_TOL) || (null_meas > WHEEL_SLIP_NULL_TOL);
+	//Set and cleared after WHEEL_SLIP_TICKS ticks, a signature near the
+	//threshold does not report one slip as several
+	//连续WHEEL_SLIP_TICKS个周期后置位和清除，特征在阈值附近时不会把一次打滑报告为多次
+	if(slip != s->Slip) { if(s->Slip_Ticks < WHEEL_SLIP_TICKS) s->Slip_Ticks++; }
+	else s->Slip_Ticks = 0;
+	if(s->Slip_Ticks >= WHEEL_SLIP_TICKS)
+	{
+		s->Slip = slip;
+		s->Slip_Ticks = 0;
+		if(slip) s->Slip_Events++;
+	}
+	//The correction holds from the first tick, a spinning wheel would otherwise
+	//turn the car through the other three until the slip is reported
+	//修正从第一个周期起保持，否则在报告打滑前空转车轮会通过其他三个车轮使小车转向
+	s->Frozen = slip || s->Slip;
+
+	Sync_To_Body(target, lever, cmd);
+	speed = Fast_Sqrtf(cmd[0] * cmd[0] + cmd[1] * cmd[1]) + fabsf(cmd[2]) * lever;
+	if(speed < WHEEL_SYNC_MIN_SPEED || s->Frozen)
+	{
+		//Standing still: drop the history. Slipping: hold it, encoder errors mean nothing
+		//静止时清除历史；打滑时保持，此时编码器误差没有意义
+		if(speed < WHEEL_SYNC_MIN_SPEED) s->Integral[0] = s->Integral[1] = s->Integral[2] = s->Integral[3] = 0;
+		for(i = 0; i < 4; i++) s->Correction[i] = 0;
+		return;
+	}
+
+	//Keep only the sideways part of the translation error, a chassis that is
+	//uniformly slow still drives straight
+	//只保留平移误差的侧向分量，整体偏慢的车体仍然走直线
+	u[0] = s->Error_Body[0];
+	u[1] = s->Error_Body[1];
+	u[2] = s->Error_Body[2];
+	u[3] = s->Error_Null;
+	speed = Fast_Sqrtf(cmd[0] * cmd[0] + cmd[1] * cmd[1]);
+	if(speed > WHEEL_SYNC_MIN_SPEED)
+	{
+		along = (u[0] * cmd[0] + u[1] * cmd[1]) / (speed * speed);
+		u[0] -= along * cmd[0];
+		u[1] -= along * cmd[1];
+	}
+
+	for(i = 0; i < 4; i++)
+	{
+		s->Integral[i] = Sync_Limit(s->Integral[i] + WHEEL_SYNC_KI * u[i] * dt,
+		                            i == 2 ? WHEEL_SYNC_MAX / lever : WHEEL_SYNC_MAX);
+		u[i] = WHEEL_SYNC_KP * u[i] + s->Integral[i];
+	}
+
+	//Back to the wheels with the Drive_Motor kinematics plus the null space pattern
+	//按Drive_Motor运动学映射回车轮，并叠加零空间模式
+	s->Correction[0] = Sync_Limit( u[0] + u[1] - u[2] * lever + u[3], WHEEL_SYNC_MAX);
+	s->Correction[1] = Sync_Limit( u[0] - u[1] - u[2] * lever - u[3], WHEEL_SYNC_MAX);
+	s->Correction[2] = Sync_Limit( u[0] + u[1] + u[2] * lever - u[3], WHEEL_SYNC_MAX);
+	s->Correction[3] = Sync_Limit( u[0] - u[1] + u[2] * lever + u[3], WHEEL_SYNC_MAX);
+}
@@ -0,0 +1,51 @@
+#ifndef __WHEEL_SYNC_H
+#define __WHEEL_SYNC_H
+#include <stdint.h>
+
+//Cross coupling of the four wheel speed loops. Wheel tracking errors are
+//mapped to a chassis velocity error through the Mecanum kinematics of
+//Drive_Motor. The part along the commanded direction is left to the wheel
+//loops. The part that bends the path (sideways and yaw) is fed back to all
+//four wheels. The null space pattern (A,B,C,D) = (1,-1,-1,1) moves the
+//chassis nowhere, wheels that disagree in it drag their rollers, so it is
+//fed back too: a wheel that cannot reach its target (saturated, loaded)
+//slows the other three to keep all four in step, the car drives straight
+//at the speed of the slowest wheel. Host/wheel_sync_bench.c checks the gains
+//and the slip thresholds on a chassis model.
+//四轮速度环的交叉耦合。车轮跟踪误差按Drive_Motor的麦轮运动学映射为车体速度误差，
+//沿指令方向的分量交由各轮速度环处理，使路径弯曲的分量(侧向和偏航)反馈到四个车轮。
+//零空间模式(A,B,C,D)=(1,-1,-1,1)不产生车体运动，车轮在该模式上不一致时辊子被拖动，因此同样反馈：
+//无法达到目标的车轮(饱和、负载)使其他三个车轮减速保持同步，小车以最慢车轮的速度走直线。
+//增益和打滑阈值由Host/wheel_sync_bench.c在底盘模型上检查
+
+#define WHEEL_SYNC_KP            0.5f     //Chassis error fed back per tick //每周期反馈的车体误差比例
+#define WHEEL_SYNC_KI            10.0f    //1/s, removes the drift of a saturated or loaded wheel //1/s，消除饱和或负载车轮造成的漂移
+#define WHEEL_SYNC_MAX           0.3f     //Correction limit per wheel, m/s //每个车轮的修正量限幅，m/s
+#define WHEEL_SYNC_MIN_SPEED     0.02f    //Below this commanded speed the layer is idle, m/s //指令速度低于该值时不工作，m/s
+
+//Slip: odometry yaw rate disagrees with the gyro, or the wheels move in the null space
+//打滑：里程计偏航角速度与陀螺仪不一致，或车轮在零空间内运动
+#define WHEEL_SLIP_RATE_TOL      0.35f    //rad/s
+#define WHEEL_SLIP_NULL_TOL      0.10f    //m/s
+#define WHEEL_SLIP_TICKS         5        //Consecutive ticks before slip is reported, and clear before it ends //报告打滑前需连续满足的周期数，结束前需连续不满足的周期数
+
+typedef struct
+{
+	float Error_Body[3];          //Chassis velocity error x, y (m/s), z (rad/s) //车体速度误差
+	float Error_Null;             //Null space wheel error, m/s //零空间车轮误差，m/s
+	float Integral[4];            //Sideways, yaw and null space integral, chassis units //侧向、偏航和零空间积分，车体单位
+	float Correction[4];          //Added to the wheel targets A..D, m/s //叠加到A~D车轮目标的修正量，m/s
+	float Odom_Yaw_Rate;          //From the encoders, rad/s //由编码器计算，rad/s
+	float Gyro_Yaw_Rate;          //rad/s
+	uint16_t Slip_Ticks;          //Ticks with the slip signature, or without it while Slip is set //出现打滑特征的周期数，Slip置位时为未出现的周期数
+	uint8_t  Slip;                //1: a wheel is slipping, reported after WHEEL_SLIP_TICKS //1：车轮打滑，连续WHEEL_SLIP_TICKS个周期后报告
+	uint8_t  Frozen;              //1: the correction is held, from the first tick of the signature //1：修正保持不变，从出现打滑特征的第一个周期开始
+	uint32_t Slip_Events;
+}Wheel_Sync_t;
+
+extern Wheel_Sync_t Wheel_Sync;
+
+void Wheel_Sync_Update(Wheel_Sync_t *s, const float target[4], const float measured[4],
+                       float gyro_rate_dps, float lever, float dt);
+
+#endif
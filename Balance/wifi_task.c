@@ -1,35 +1,36 @@
 #include "wifi_task.h"
+#include "mode_manager.h"
 
-// WiFi״̬
+// WiFi任务状态
 typedef enum {
     WIFI_STATE_INIT = 0,
     WIFI_STATE_CONNECTING,
     WIFI_STATE_UDP_RECONNECTING,
     WIFI_STATE_READY,
     WIFI_STATE_ERROR,
-    WIFI_STATE_HARD_RESET  // Ӳλ״̬
+    WIFI_STATE_HARD_RESET  // 新增：硬件复位状态
 } WiFiState_t;
 
 static WiFiState_t wifi_state = WIFI_STATE_INIT;
 static uint32_t last_status_send_time = 0;
 static uint32_t wifi_reconnect_time = 0;
 
-// ӽ״̬ر
+// 连接健康状态机相关变量
 static ConnectionHealth_t connection_health = CONNECTION_HEALTHY;
 static uint8_t consecutive_failures = 0;
 static uint32_t last_data_receive_time = 0;
 static uint32_t last_health_check_time = 0;
-static uint32_t connection_start_time = 0;  // ӿʼʱ
-static uint8_t hard_reset_count = 0;        // Ӳλ
+static uint32_t connection_start_time = 0;  // 新增：连接开始时间
+static uint8_t hard_reset_count = 0;        // 新增：硬件复位计数
 
 void WiFi_Task(void *pvParameters)
 {
-    usart1_send_cstring("WiFi...\r\n");
+    usart1_send_cstring("WiFi任务启动...\r\n");
     u32 lastWakeTime = getSysTickCnt();
     
-    // ѭ
+    // 任务主循环
     while(1) {
-        // 50HzƵУ20msһΣ
+        // 此任务以50Hz的频率运行（20ms控制一次）
         vTaskDelayUntil(&lastWakeTime, F2T(RATE_50_HZ)); 
         
         switch(wifi_state) {
@@ -53,141 +54,141 @@ void WiFi_Task(void *pvParameters)
                 WiFi_State_Error();
                 break;
                 
-            case WIFI_STATE_HARD_RESET:  // Ӳλ״̬
+            case WIFI_STATE_HARD_RESET:  // 新增：硬件复位状态
                 WiFi_State_Hard_Reset();
                 break;
         }
     }
 }
 
-// Ӳλ״̬
+// 新增：硬件复位状态处理。
 void WiFi_State_Hard_Reset(void)
 {
     static uint32_t last_reset_attempt = 0;
     uint32_t current_time = HAL_GetTick();
     
-    // ÿ10볢һӲλ
+    // 每10秒尝试一次硬件复位
     if(current_time - last_reset_attempt > 10000) {
-        usart1_send_cstring("[Ӳλ] ӲλESP8266...\r\n");
+        usart1_send_cstring("[硬复位] 尝试硬件复位ESP8266...\r\n");
         
-        // AT+RSTӲλ
+        // 发送AT+RST命令进行硬件复位
         if(ESP8266_SendATCommand_Enhanced("AT+RST", "ready", 10000) == ESP8266_OK) {
-            usart1_send_cstring("[Ӳλ] ESP8266λɹ\r\n");
-            HAL_Delay(3000);  // ȴģ
+            usart1_send_cstring("[硬复位] ESP8266复位成功\r\n");
+            HAL_Delay(3000);  // 等待模块启动
             hard_reset_count++;
             wifi_state = WIFI_STATE_INIT;
         } else {
-            usart1_send_cstring("[Ӳλ] ESP8266λʧ\r\n");
+            usart1_send_cstring("[硬复位] ESP8266复位失败\r\n");
         }
         
         last_reset_attempt = current_time;
         
-        // 3Ӳλʧܣ״̬
+        // 如果连续3次硬件复位都失败，进入错误状态
         if(hard_reset_count >= 3) {
-            usart1_send_cstring("[Ӳλ] λʧܣ״̬\r\n");
+            usart1_send_cstring("[硬复位] 连续复位失败，进入错误状态\r\n");
             wifi_state = WIFI_STATE_ERROR;
             hard_reset_count = 0;
         }
     }
 }
 
-// ʼ״̬ - ǿ汾
+// 初始化状态处理 - 增强版本
 void WiFi_State_Init(void)
 {
     static uint32_t init_start_time = 0;
     uint32_t current_time = HAL_GetTick();
     
-    // ¼ʼʼʱ
+    // 记录初始化开始时间
     if(init_start_time == 0) {
         init_start_time = current_time;
-        usart1_send_cstring("ʼWiFiģ...\r\n");
+        usart1_send_cstring("初始化WiFi模块...\r\n");
     }
     
-    // ʼʱ30룩
+    // 检查初始化超时（30秒）
     if(current_time - init_start_time > 30000) {
-        usart1_send_cstring("[ʼ] ʱӲλ״̬\r\n");
+        usart1_send_cstring("[初始化] 超时，进入硬件复位状态\r\n");
         init_start_time = 0;
         wifi_state = WIFI_STATE_HARD_RESET;
         return;
     }
     
-    // ùؼ״̬
+    // 重置关键状态变量
     consecutive_failures = 0;
     connection_health = CONNECTION_HEALTHY;
     
     if(ESP8266_Init() == ESP8266_OK) {
         char init_msg[64];
-        snprintf(init_msg, sizeof(init_msg), "WiFiģʼɹСID: %s\r\n", CAR_ID);
+        snprintf(init_msg, sizeof(init_msg), "WiFi模块初始化成功，小车ID: %s\r\n", CAR_ID);
         usart1_send_cstring(init_msg);
         
-        connection_start_time = HAL_GetTick();  // ¼ӿʼʱ
+        connection_start_time = HAL_GetTick();  // 记录连接开始时间
         wifi_state = WIFI_STATE_READY;
-        init_start_time = 0;  // óʼʱ
-        hard_reset_count = 0; // Ӳλ
+        init_start_time = 0;  // 重置初始化计时
+        hard_reset_count = 0; // 重置硬件复位计数
     } else {
-        // ʼʧܣӳٺ
-        vTaskDelay(F2T(RATE_10_HZ)); // 100msӳ
+        // 初始化失败，短暂延迟后重试
+        vTaskDelay(F2T(RATE_10_HZ)); // 100ms延迟
     }
 }
 
-// ״̬ - ȱʧĺ
+// 连接状态处理 - 添加缺失的函数定义
 void WiFi_State_Connecting(void)
 {
     static uint32_t connecting_start_time = 0;
     static uint8_t connecting_attempts = 0;
     uint32_t current_time = HAL_GetTick();
     
-    // ¼ӿʼʱ
+    // 记录连接开始时间
     if(connecting_start_time == 0) {
         connecting_start_time = current_time;
-        usart1_send_cstring("WiFi...\r\n");
+        usart1_send_cstring("WiFi连接中...\r\n");
     }
     
-    // ӳʱ15룩
+    // 检查连接超时（15秒）
     if(current_time - connecting_start_time > 15000) {
-        usart1_send_cstring("[] ӳʱصʼ״̬\r\n");
+        usart1_send_cstring("[连接] 连接超时，回到初始化状态\r\n");
         connecting_start_time = 0;
         connecting_attempts = 0;
         wifi_state = WIFI_STATE_INIT;
         return;
     }
     
-    // ÿ3볢һ
+    // 每3秒尝试一次连接
     if(current_time - connecting_start_time > connecting_attempts * 3000) {
         connecting_attempts++;
-        usart1_send_cstring("[] WiFi...\r\n");
+        usart1_send_cstring("[连接] 尝试连接WiFi网络...\r\n");
         
-        // ӳԵ߼
-        // ʱֱӻصʼ״̬³
+        // 这里可以添加连接尝试的逻辑
+        // 暂时直接回到初始化状态重新尝试
         wifi_state = WIFI_STATE_INIT;
     }
 }
 
-// UDP״̬ - ǿ汾
+// UDP重连状态处理 - 增强版本
 void WiFi_State_UDP_Reconnecting(void)
 {
     static uint32_t last_udp_reconnect = 0;
     static uint8_t reconnect_attempts = 0;
     uint32_t current_time = HAL_GetTick();
     
-    // ÿ3볢³ʼUDP
+    // 每3秒尝试重新初始化UDP
     if(current_time - last_udp_reconnect > 3000) {
         reconnect_attempts++;
-        debug_print("[UDP] ³ʼUDP...\r\n");
+        debug_print("[UDP] 尝试重新初始化UDP连接...\r\n");
         
         if(ESP8266_InitUDP() == ESP8266_OK) {
-            debug_print("[UDP] UDPɹ\r\n");
+            debug_print("[UDP] UDP重连成功\r\n");
             wifi_state = WIFI_STATE_READY;
             connection_health = CONNECTION_HEALTHY;
             consecutive_failures = 0;
             reconnect_attempts = 0;
-            connection_start_time = HAL_GetTick();  // ʱ
+            connection_start_time = HAL_GetTick();  // 重置连接时间
         } else {
-            debug_print("[UDP] UDPʧ\r\n");
+            debug_print("[UDP] UDP重连失败\r\n");
             
-            // 5UDPʧܣȫ³ʼ
+            // 如果连续5次UDP重连失败，尝试完全重新初始化
             if(reconnect_attempts >= 5) {
-                debug_print("[UDP] ʧܣصʼ״̬\r\n");
+                debug_print("[UDP] 连续重连失败，回到初始化状态\r\n");
                 wifi_state = WIFI_STATE_INIT;
                 reconnect_attempts = 0;
             }
@@ -197,7 +198,7 @@ void WiFi_State_UDP_Reconnecting(void)
     }
 }
 
-// WiFi_State_Readyӽ - ǿ汾
+// 在WiFi_State_Ready中增加连接健康检查 - 增强版本
 void WiFi_State_Ready(void)
 {
     uint32_t current_time = HAL_GetTick();
@@ -205,53 +206,53 @@ void WiFi_State_Ready(void)
     static uint32_t last_health_check = 0;
     static uint8_t udp_health_counter = 0;
     
-    // ӳʱ䣬1Сʱ³ʼԤڴй©
-    if(current_time - connection_start_time > 3600000) { // 1Сʱ
-        debug_print("[] ʱ³ʼ\r\n");
+    // 检查连接持续时间，如果超过1小时，主动重新初始化（预防内存泄漏）
+    if(current_time - connection_start_time > 3600000) { // 1小时
+        debug_print("[健康检查] 连接时间过长，主动重新初始化\r\n");
         wifi_state = WIFI_STATE_INIT;
         return;
     }
     
-    // ÿ10һUDPӽ״̬
+    // 每10秒检查一次UDP连接健康状态
     if(current_time - last_health_check > 10000) {
-        // ηʧܣ³ʼUDP
+        // 如果连续多次发送失败，尝试重新初始化UDP
         if(udp_health_counter > 3) {
-            debug_print("[] UDP쳣³ʼ...\r\n");
+            debug_print("[健康检查] UDP连接异常，尝试重新初始化...\r\n");
             esp8266_udp_initialized = 0;
             if(ESP8266_InitUDP() == ESP8266_OK) {
-                debug_print("[] UDP³ʼɹ\r\n");
+                debug_print("[健康检查] UDP重新初始化成功\r\n");
                 udp_health_counter = 0;
             } else {
-                debug_print("[] UDP³ʼʧ\r\n");
+                debug_print("[健康检查] UDP重新初始化失败\r\n");
                 connection_health = CONNECTION_DISCONNECTED;
             }
         }
         last_health_check = current_time;
     }
     
-    // ״̬
+    // 健康状态机处理
     switch(connection_health) {
         case CONNECTION_HEALTHY:
-            // ״̬Ƶͣ50ms
+            // 健康状态：高频发送（50ms）
             if(current_time - last_status_send_time > 100) {
                 ESP8266_Status_t result = ESP8266_SendStatus_UDP_Reliable(
                     position[0], position[1], Yaw, Voltage, 
-                    Current_Vx, Current_Vy, Current_Vz
+                    Current_Vx, Current_Vy, Current_Vz, Mode_Runs_Orca()
                 );
                 
                 if(result == ESP8266_OK) {
-                    // ͳɹʧܼ
+                    // 发送成功，重置失败计数
                     consecutive_failures = 0;
                     udp_health_counter = 0;
                 } else {
-                    // ʧܣʧܼ
+                    // 发送失败，增加失败计数
                     consecutive_failures++;
                     udp_health_counter++;
                     
-                    if(consecutive_failures >= 10) {  // һֵ10
-                        // UDPͨʧܣתΪϿ״̬
+                    if(consecutive_failures >= 10) {  // 进一步降低阈值到10次
+                        // UDP通信失败，转为断开状态
                         connection_health = CONNECTION_DISCONNECTED;
-                        // usart1_send_cstring("[״̬] תΪϿ״̬\r\n");
+                        // usart1_send_cstring("[状态机] 转为断开状态\r\n");
                     }
                 }
                 last_status_send_time = current_time;
@@ -259,35 +260,35 @@ void WiFi_State_Ready(void)
             break;
             
         case CONNECTION_DISCONNECTED:
-            // Ͽ״̬ʼ
-            // usart1_send_cstring("[״̬] ʼUDP\r\n");
-            esp8266_udp_initialized = 0;  // Ҫ³ʼ
+            // 断开状态：开始重连流程
+            // usart1_send_cstring("[状态机] 开始UDP重连流程\r\n");
+            esp8266_udp_initialized = 0;  // 标记需要重新初始化
             wifi_state = WIFI_STATE_UDP_RECONNECTING;
-            connection_health = CONNECTION_HEALTHY;  // Ϊ״̬
-            consecutive_failures = 0;                // ʧܼ
-            udp_health_counter = 0;                  // ý
+            connection_health = CONNECTION_HEALTHY;  // 重置为健康状态
+            consecutive_failures = 0;                // 重置失败计数
+            udp_health_counter = 0;                  // 重置健康计数器
             break;
     }
     
-    // յݣ㲥Ϣ
+    // 处理接收到的数据（包括广播信息）
     ESP8266_Process();
     
-    // // ڴӡ״̬
+    // // 定期打印连接状态
     // static uint32_t last_status_print = 0;
-    // if(current_time - last_status_print > 5000) { // ÿ5ӡһ
+    // if(current_time - last_status_print > 5000) { // 每5秒打印一次
     //     char status_msg[128];
     //     uint32_t connection_duration = (current_time - connection_start_time) / 1000;
     //     snprintf(status_msg, sizeof(status_msg), 
-    //              "[״̬] :%ds, UDP:%s, ʧ:%d, :%d\r\n",
+    //              "[状态] 连接:%ds, UDP:%s, 失败:%d, 健康:%d\r\n",
     //              connection_duration,
-    //              esp8266_udp_initialized ? "ѳʼ" : "δʼ",
+    //              esp8266_udp_initialized ? "已初始化" : "未初始化",
     //              consecutive_failures, udp_health_counter);
     //     debug_print(status_msg);
     //     last_status_print = current_time;
     // }
 }
 
-// ״̬ - ǿ汾
+// 错误状态处理 - 增强版本
 void WiFi_State_Error(void)
 {
     static uint32_t error_start_time = 0;
@@ -297,21 +298,21 @@ void WiFi_State_Error(void)
         error_start_time = current_time;
     }
     
-    // ʱ5
+    // 定时重连（5秒后）
     if(current_time > wifi_reconnect_time) {
-        usart1_send_cstring("WiFi...\r\n");
-        esp8266_udp_initialized = 0; // UDP״̬
+        usart1_send_cstring("尝试重新连接WiFi...\r\n");
+        esp8266_udp_initialized = 0; // 重置UDP状态
         
-        // ״̬60룬Ӳλ
+        // 如果错误状态持续超过60秒，尝试硬件复位
         if(current_time - error_start_time > 60000) {
-            usart1_send_cstring("[] ʱ޷ָӲλ\r\n");
+            usart1_send_cstring("[错误] 长时间无法恢复，尝试硬件复位\r\n");
             wifi_state = WIFI_STATE_HARD_RESET;
             error_start_time = 0;
         } else {
             wifi_state = WIFI_STATE_INIT;
         }
         
-        wifi_reconnect_time = current_time + 5000; // 5
+        wifi_reconnect_time = current_time + 5000; // 5秒后重试
     }
 }
 
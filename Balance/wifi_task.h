@@ -10,20 +10,20 @@
 #define WIFI_TASK_STACK_SIZE    512
 #define WIFI_TASK_PRIORITY      3
 
-// ӽ״̬
+// 连接健康状态
 typedef enum {
-    CONNECTION_HEALTHY = 0,     // ӽ
-    CONNECTION_DISCONNECTED     // ӶϿ
+    CONNECTION_HEALTHY = 0,     // 连接健康
+    CONNECTION_DISCONNECTED     // 连接断开
 } ConnectionHealth_t;
 
-// WiFi
+// WiFi服务函数声明
 void WiFi_Task(void *pvParameters);
 void WiFi_State_Init(void);
 void WiFi_State_Connecting(void);
 void WiFi_State_UDP_Reconnecting(void);
 void WiFi_State_Ready(void);
 void WiFi_State_Error(void);
-void WiFi_State_Hard_Reset(void);  // Ӳλ״̬
+void WiFi_State_Hard_Reset(void);  // 新增：硬件复位状态
 
 
 #endif
@@ -0,0 +1,160 @@
+#include "yaw_control.h"
+#include "MPU6050.h"
+#include "delay.h"
+#include "fast_math.h"
+#include "float_only.h"
+
+static float Yaw_Limit(float value, float limit)
+{
+	if(value > limit)  return limit;
+	if(value < -limit) return -limit;
+	return value;
+}
+
+/**************************************************************************
+Function: Load the default gains and clear the state
+Input   : c: controller
+Output  : none
+函数功能：装载默认增益并清零状态
+入口参数：c：控制器
+返回  值：无
+**************************************************************************/
+void Yaw_Cascade_Init(Yaw_Cascade_t *c)
+{
+	c->Angle_Kp = YAW_ANGLE_KP_DEFAULT;
+	c->Rate_Max = YAW_RATE_MAX_DEFAULT;
+	c->Rate_Kp  = YAW_RATE_KP_DEFAULT;
+	c->Rate_Ki  = YAW_RATE_KI_DEFAULT;
+	c->FF_Gain  = FAST_DEG2RAD;
+	c->Out_Max  = YAW_OUT_MAX_DEFAULT;
+	Yaw_Cascade_Reset(c);
+}
+
+/**************************************************************************
+Function: Clear the state, the next update starts from rest
+Input   : c: controller
+Output  : none
+函数功能：清零状态，下一次更新从静止开始
+入口参数：c：控制器
+返回  值：无
+**************************************************************************/
+void Yaw_Cascade_Reset(Yaw_Cascade_t *c)
+{
+	c->Rate_Target = 0;
+	c->Rate_Measured = 0;
+	c->FF_Rate = 0;
+	c->Integral = 0;
+	c->Output = 0;
+	c->Primed = 0;
+}
+
+/**************************************************************************
+Function: Restart the controller so its first output continues the rotation commanded now
+Input   : c: controller; vz_now: Vz currently applied to Drive_Motor, rad/s
+Output  : none
+函数功能：重启控制器，使其首次输出延续当前的旋转指令
+入口参数：c：控制器；vz_now：当前送入Drive_Motor的Vz，rad/s
+返回  值：无
+**************************************************************************/
+void Yaw_Cascade_Bumpless(Yaw_Cascade_t *c, float vz_now)
+{
+	Yaw_Cascade_Reset(c);
+	//With the rate on target the output is FF_Gain*rate + Integral
+	//角速度到达设定值时输出为FF_Gain*rate + Integral
+	c->Integral = Yaw_Limit(vz_now - c->FF_Gain * Yaw_Rate, c->Out_Max);
+}
+
+//Prime a fresh or stale instance and refresh the gyro rate, returns the tick length
+//初始化新建或超时的实例并更新陀螺仪角速度，返回本次周期长度
+static float Yaw_Cascade_Measure(Yaw_Cascade_t *c, float target_yaw)
+{
+	u32 now = getMicros(), gyro_us;
+	float gyro_angle, dt, gyro_dt;
+
+	IMU_Get_Gyro_Yaw(&gyro_angle, &gyro_us);
+	if(!c->Primed || now - c->Last_us > YAW_CASCADE_TIMEOUT_US)
+	{
+		//A fresh or preloaded instance keeps its integral, a stale one restarts
+		//新建或已预置的实例保留积分，长时间未更新的实例重新开始
+		if(c->Primed) Yaw_Cascade_Reset(c);
+		c->Last_Target = target_yaw;
+		c->Gyro_Angle = gyro_angle;
+		c->Gyro_us = gyro_us;
+		c->Rate_Measured = Yaw_Rate;
+		c->Last_us = now;
+		c->Primed = 1;
+	}
+	dt = (now - c->Last_us) * 1e-6f;
+	c->Last_us = now;
+
+	//Inner loop feedback: mean rate over every gyro sample since the last
+	//update, keeps the IMU rate information without aliasing
+	//内环反馈：自上次更新以来所有陀螺仪样本的平均角速度，保留IMU频率的信息且不混叠
+	gyro_dt = (gyro_us - c->Gyro_us) * 1e-6f;
+	if(gyro_dt > 0.0f)
+	{
+		c->Rate_Measured = Fast_Wrap180(gyro_angle - c->Gyro_Angle) / gyro_dt;
+		c->Gyro_Angle = gyro_angle;
+		c->Gyro_us = gyro_us;
+	}
+	return dt;
+}
+
+//Inner loop: rate PI on the gyro plus the setpoint feedforward
+//内环：基于陀螺仪的角速度PI控制加设定值前馈
+static float Yaw_Cascade_Inner(Yaw_Cascade_t *c, float dt)
+{
+	float rate_error = c->Rate_Target - c->Rate_Measured;
+	float output = c->FF_Gain * c->Rate_Target + c->Rate_Kp * rate_error + c->Integral;
+
+	//Integrate only while the output is not pushing further into its limit
+	//仅在输出未向限幅方向继续饱和时积分
+	if(!((output >= c->Out_Max && rate_error > 0) || (output <= -c->Out_Max && rate_error < 0)))
+		c->Integral = Yaw_Limit(c->Integral + c->Rate_Ki * rate_error * dt, c->Out_Max);
+	c->Output = Yaw_Limit(output, c->Out_Max);
+	return c->Output;
+}
+
+/**************************************************************************
+Function: Run both loops once
+Input   : c: controller; current_yaw: heading, degree; target_yaw: heading setpoint, degree
+Output  : Vz command for Drive_Motor, rad/s
+函数功能：执行一次内外环计算
+入口参数：c：控制器；current_yaw：当前航向，度；target_yaw：目标航向，度
+返回  值：Drive_Motor的Vz指令，rad/s
+**************************************************************************/
+float Yaw_Cascade_Update(Yaw_Cascade_t *c, float current_yaw, float target_yaw)
+{
+	float dt, step;
+
+	dt = Yaw_Cascade_Measure(c, target_yaw);
+	if(dt <= 0.0f) return c->Output;
+
+	//Feedforward of the commanded rotation //指令转动的前馈
+	step = Fast_Wrap180(target_yaw - c->Last_Target);
+	c->Last_Target = target_yaw;
+	if(step > YAW_FF_JUMP_DEG || step < -YAW_FF_JUMP_DEG) step = 0;
+	c->FF_Rate += YAW_FF_ALPHA * (step / dt - c->FF_Rate);
+
+	//Outer loop: heading error to rate setpoint //外环：航向误差转换为角速度设定值
+	c->Rate_Target = Yaw_Limit(c->Angle_Kp * Fast_Wrap180(target_yaw - current_yaw) + c->FF_Rate, c->Rate_Max);
+	return Yaw_Cascade_Inner(c, dt);
+}
+
+/**************************************************************************
+Function: Run the inner loop alone on an external rate setpoint
+Input   : c: controller; rate_target: yaw rate setpoint, degree/s
+Output  : Vz command for Drive_Motor, rad/s
+函数功能：仅运行内环，跟踪外部给定的角速度设定值
+入口参数：c：控制器；rate_target：偏航角速度设定值，度/秒
+返回  值：Drive_Motor的Vz指令，rad/s
+**************************************************************************/
+float Yaw_Cascade_Rate(Yaw_Cascade_t *c, float rate_target)
+{
+	float dt = Yaw_Cascade_Measure(c, c->Last_Target);
+
+	if(dt <= 0.0f) return c->Output;
+	c->FF_Rate = 0;
+	c->Rate_Target = Yaw_Limit(rate_target, c->Rate_Max);
+	return Yaw_Cascade_Inner(c, dt);
+}
@@ -0,0 +1,58 @@
+#ifndef __YAW_CONTROL_H
+#define __YAW_CONTROL_H
+#include <stdint.h>
+
+//Cascaded heading controller. The outer loop turns the heading error into a
+//yaw rate setpoint, the inner loop tracks it on the z gyro and outputs the
+//Vz command of Drive_Motor (rad/s). Each caller owns one instance.
+//串级航向控制器。外环将航向误差转换为偏航角速度设定值，内环根据z轴陀螺仪跟踪该设定值，
+//输出Drive_Motor的Vz指令(rad/s)。每个调用者使用独立的实例
+
+#define YAW_ANGLE_KP_DEFAULT     2.5f     //Rate setpoint per degree of error, 1/s //每度误差对应的角速度设定值，1/s
+#define YAW_RATE_MAX_DEFAULT     45.0f    //Rate setpoint limit, degree/s //角速度设定值限幅，度/秒
+#define YAW_RATE_KP_DEFAULT      0.008f   //Vz per degree/s of rate error //每度/秒角速度误差对应的Vz
+#define YAW_RATE_KI_DEFAULT      0.02f    //Vz per degree of accumulated rate error //每度累积角速度误差对应的Vz
+#define YAW_OUT_MAX_DEFAULT      1.0f     //Vz limit, same as the former single loop PID //Vz限幅，与原单环PID相同
+
+//Feedforward from a moving target heading. Jumps larger than this are new
+//setpoints, not rotation, and are left to the outer loop
+//目标航向变化的前馈。大于该值的跳变视为新的设定值而非转动，交由外环处理
+#define YAW_FF_JUMP_DEG          5.0f
+#define YAW_FF_ALPHA             0.05f    //Smoothing of the target slope, targets arrive over WiFi in steps //目标斜率平滑系数，目标经WiFi分段到达
+
+//An instance not updated for this long starts again from rest
+//超过该时间未更新的实例从静止状态重新开始
+#define YAW_CASCADE_TIMEOUT_US   100000
+
+typedef struct
+{
+	//Gains //增益
+	float Angle_Kp;
+	float Rate_Max;
+	float Rate_Kp, Rate_Ki;
+	float FF_Gain;                //Vz per degree/s of setpoint, PI/180 for an ideal drive //每度/秒设定值对应的Vz，理想驱动为PI/180
+	float Out_Max;
+
+	//State, readable from the debugger //状态，可在调试器中查看
+	float Rate_Target;            //degree/s
+	float Rate_Measured;          //Mean gyro rate since the last update, degree/s //自上次更新以来的平均陀螺仪角速度，度/秒
+	float FF_Rate;                //Slope of the target heading, degree/s //目标航向变化率，度/秒
+	float Integral;               //Inner loop integral, Vz units //内环积分，Vz单位
+	float Output;
+	float Last_Target;
+	float Gyro_Angle;
+	uint32_t Gyro_us, Last_us;
+	uint8_t Primed;
+}Yaw_Cascade_t;
+
+//Static initialiser with the default gains //使用默认增益的静态初始化
+#define YAW_CASCADE_DEFAULT { YAW_ANGLE_KP_DEFAULT, YAW_RATE_MAX_DEFAULT, YAW_RATE_KP_DEFAULT, \
+                              YAW_RATE_KI_DEFAULT, 3.14159265f / 180.0f, YAW_OUT_MAX_DEFAULT }
+
+void  Yaw_Cascade_Init(Yaw_Cascade_t *c);
+void  Yaw_Cascade_Reset(Yaw_Cascade_t *c);
+void  Yaw_Cascade_Bumpless(Yaw_Cascade_t *c, float vz_now);
+float Yaw_Cascade_Update(Yaw_Cascade_t *c, float current_yaw, float target_yaw);
+float Yaw_Cascade_Rate(Yaw_Cascade_t *c, float rate_target);
+
+#endif
@@ -162,6 +162,7 @@
 #define INCLUDE_vTaskDelay				        1
 #define INCLUDE_eTaskGetState			        1
 #define INCLUDE_xTimerPendFunctionCall	        1
+#define INCLUDE_xTaskGetCurrentTaskHandle      1
 
 /***************************************************************************************************************/
 /*                                FreeRTOSжйصѡ                                                  */
@@ -19,6 +19,7 @@
 #include "dmpKey.h"
 #include "dmpmap.h"
 #include "inv_mpu.h"
+#include "i2c_bus.h"
 //#include "./SysTick/bsp_SysTick.h"
 
 /* The following functions must be defined for this platform:
@@ -42,8 +43,8 @@
 #include "msp430_clock.h"
 #include "msp430_interrupt.h" */
 
-#define i2c_write   i2cWrite
-#define i2c_read    i2cRead
+#define i2c_write   I2C_Bus_Write
+#define i2c_read    I2C_Bus_Read
 #define get_ms      myget_ms
 
 //static int reg_int_cb(struct int_param_s *int_param)
@@ -367,6 +368,10 @@ enum lp_accel_rate_e {
 #endif
 };
 
+/* DMP memory bursts: the largest power of two that fits the 8-bit I2C
+ * length, so every transfer stays inside one 256-byte bank. */
+#define LOAD_CHUNK          (128)
+
 #define BIT_I2C_MST_VDDIO   (0x80)
 #define BIT_FIFO_EN         (0x40)
 #define BIT_DMP_EN          (0x80)
@@ -747,34 +752,11 @@ int mpu_read_reg(unsigned char reg, unsigned char *data)
     return i2c_read(st.hw->addr, reg, 1, data);
 }
 
-/**
- *  @brief      Initialize hardware.
- *  Initial configuration:\n
- *  Gyro FSR: +/- 2000DPS\n
- *  Accel FSR +/- 2G\n
- *  DLPF: 42Hz\n
- *  FIFO rate: 50Hz\n
- *  Clock source: Gyro PLL\n
- *  FIFO: Disabled.\n
- *  Data ready interrupt: Disabled, active low, unlatched.
- *  @param[in]  int_param   Platform-specific parameters to interrupt API.
- *  @return     0 if successful.
- */
-int mpu_init(void)
+/* Check the silicon revision, shared by the cold and the warm init. */
+static int mpu_check_revision(void)
 {
     unsigned char data[6], rev;
 
-    /* Reset device. */
-    data[0] = 0x80;//BIT_RESET;
-    if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, &(data[0])))
-        return -1;
-    delay_ms(100);
-
-    /* Wake up chip. */
-    data[0] = 0x00;
-    if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, &(data[0])))
-        return -1;
-
 #if defined MPU6050
     /* Check product revision. */
     if (i2c_read(st.hw->addr, st.reg->accel_offs, 6, data))
@@ -823,6 +805,39 @@ int mpu_init(void)
     if (i2c_write(st.hw->addr, st.reg->accel_cfg2, 1, data))
         return -1;
 #endif
+    return 0;
+}
+
+/**
+ *  @brief      Initialize hardware.
+ *  Initial configuration:\n
+ *  Gyro FSR: +/- 2000DPS\n
+ *  Accel FSR +/- 2G\n
+ *  DLPF: 42Hz\n
+ *  FIFO rate: 50Hz\n
+ *  Clock source: Gyro PLL\n
+ *  FIFO: Disabled.\n
+ *  Data ready interrupt: Disabled, active low, unlatched.
+ *  @param[in]  int_param   Platform-specific parameters to interrupt API.
+ *  @return     0 if successful.
+ */
+int mpu_init(void)
+{
+    unsigned char data[1];
+
+    /* Reset device. */
+    data[0] = 0x80;//BIT_RESET;
+    if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, &(data[0])))
+        return -1;
+    delay_ms(100);
+
+    /* Wake up chip. */
+    data[0] = 0x00;
+    if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, &(data[0])))
+        return -1;
+
+    if (mpu_check_revision())
+        return -1;
 
     /* Set to invalid values to ensure no I2C writes are skipped. */
     st.chip_cfg.sensors = 0xFF;
@@ -875,6 +890,66 @@ int mpu_init(void)
     return 0;
 }
 
+/**
+ *  @brief      Take over a running device without writing to it.
+ *  Reads back the configuration the chip is running with: full scale
+ *  ranges, filter, sample rate, powered sensors, interrupt pin and DMP
+ *  state. Nothing is written, so a running DMP keeps filling the FIFO.
+ *  Use after an MCU reset while the sensor stayed powered and nothing
+ *  reset it (see MPU6050_initialize), then attach the DMP image with
+ *  @e mpu_attach_firmware instead of loading it again.
+ *  @return     0 if successful.
+ */
+int mpu_init_warm(void)
+{
+    unsigned char gyro_cfg, accel_cfg, lpf, rate_div, user_ctrl;
+    unsigned char pwr_mgmt[2], int_enable, int_pin_cfg;
+
+    if (mpu_check_revision())
+        return -1;
+    if (i2c_read(st.hw->addr, st.reg->gyro_cfg, 1, &gyro_cfg) ||
+        i2c_read(st.hw->addr, st.reg->accel_cfg, 1, &accel_cfg) ||
+        i2c_read(st.hw->addr, st.reg->lpf, 1, &lpf) ||
+        i2c_read(st.hw->addr, st.reg->rate_div, 1, &rate_div) ||
+        i2c_read(st.hw->addr, st.reg->user_ctrl, 1, &user_ctrl) ||
+        i2c_read(st.hw->addr, st.reg->pwr_mgmt_1, 2, pwr_mgmt) ||
+        i2c_read(st.hw->addr, st.reg->int_enable, 1, &int_enable) ||
+        i2c_read(st.hw->addr, st.reg->int_pin_cfg, 1, &int_pin_cfg))
+        return -1;
+
+    st.chip_cfg.gyro_fsr = (gyro_cfg >> 3) & 0x03;
+    st.chip_cfg.accel_fsr = (accel_cfg >> 3) & 0x03;
+    st.chip_cfg.lpf = lpf & 0x07;
+    st.chip_cfg.sample_rate = 1000 / (1 + rate_div);
+    st.chip_cfg.clk_src = pwr_mgmt[0] & 0x07;
+    st.chip_cfg.sensors = 0;
+    if (!(pwr_mgmt[0] & BIT_SLEEP)) {
+        if (!(pwr_mgmt[1] & BIT_STBY_XG))
+            st.chip_cfg.sensors |= INV_X_GYRO;
+        if (!(pwr_mgmt[1] & BIT_STBY_YG))
+            st.chip_cfg.sensors |= INV_Y_GYRO;
+        if (!(pwr_mgmt[1] & BIT_STBY_ZG))
+            st.chip_cfg.sensors |= INV_Z_GYRO;
+        if (!(pwr_mgmt[1] & BIT_STBY_XYZA))
+            st.chip_cfg.sensors |= INV_XYZ_ACCEL;
+    }
+    /* FIFO_EN is 0 while the DMP feeds the FIFO, this is what it gets
+     * back when the DMP is turned off.
+     */
+    st.chip_cfg.fifo_enable = st.chip_cfg.sensors & (INV_XYZ_GYRO | INV_XYZ_ACCEL);
+    st.chip_cfg.int_enable = int_enable;
+    st.chip_cfg.bypass_mode = (int_pin_cfg & BIT_BYPASS_EN) ? 1 : 0;
+    st.chip_cfg.active_low_int = (int_pin_cfg & BIT_ACTL) ? 1 : 0;
+    st.chip_cfg.latched_int = (int_pin_cfg & BIT_LATCH_EN) ? 1 : 0;
+    st.chip_cfg.int_motion_only = 0;
+    st.chip_cfg.lp_accel_mode = 0;
+    memset(&st.chip_cfg.cache, 0, sizeof(st.chip_cfg.cache));
+    st.chip_cfg.dmp_on = (user_ctrl & BIT_DMP_EN) ? 1 : 0;
+    st.chip_cfg.dmp_loaded = 0;
+    st.chip_cfg.dmp_sample_rate = st.chip_cfg.dmp_on ? st.chip_cfg.sample_rate : 0;
+    return 0;
+}
+
 /**
  *  @brief      Enter low-power accel-only mode.
  *  In low-power accel mode, the chip goes to sleep and only wakes up to sample
@@ -1814,6 +1889,60 @@ int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     return 0;
 }
 
+/**
+ *  @brief      Get as many whole packets from the FIFO as allowed, in one
+ *  burst read.
+ *  The FIFO count is read once; all complete packets up to @e max_packets
+ *  are then clocked out of FIFO_R_W in a single I2C transaction.
+ *  @param[in]  length      Length of each packet.
+ *  @param[in]  max_packets Maximum number of packets to read.
+ *  @param[out] data        FIFO data, at least length * max_packets bytes.
+ *  @param[out] packets     Number of packets read.
+ *  @param[out] more        Number of remaining packets.
+ *  @return     0 if successful, -2 if the FIFO overflowed and was reset.
+ */
+int mpu_read_fifo_burst(unsigned short length, unsigned char max_packets,
+    unsigned char *data, unsigned char *packets, unsigned char *more)
+{
+    unsigned char tmp[2];
+    unsigned short fifo_count, count;
+    packets[0] = 0;
+    more[0] = 0;
+    if (!st.chip_cfg.dmp_on)
+        return -1;
+    if (!st.chip_cfg.sensors)
+        return -1;
+    if (!length)
+        return -1;
+
+    if (i2c_read(st.hw->addr, st.reg->fifo_count_h, 2, tmp))
+        return -1;
+    fifo_count = (tmp[0] << 8) | tmp[1];
+    if (fifo_count < length)
+        return 0;
+    if (fifo_count > (st.hw->max_fifo >> 1)) {
+        /* FIFO is 50% full, better check overflow bit. */
+        if (i2c_read(st.hw->addr, st.reg->int_status, 1, tmp))
+            return -1;
+        if (tmp[0] & BIT_FIFO_OVERFLOW) {
+            mpu_reset_fifo();
+            return -2;
+        }
+    }
+
+    count = fifo_count / length;
+    if (count > max_packets)
+        count = max_packets;
+    /* i2c_read takes an 8-bit length. */
+    if (count * length > 255)
+        count = 255 / length;
+    if (i2c_read(st.hw->addr, st.reg->fifo_r_w, count * length, data))
+        return -1;
+    packets[0] = count;
+    more[0] = fifo_count / length - count;
+    return 0;
+}
+
 /**
  *  @brief      Set device to bypass mode.
  *  @param[in]  bypass_on   1 to enable bypass mode.
@@ -2343,9 +2472,8 @@ int mpu_load_firmware(unsigned short length, const unsigned char *firmware,
 {
     unsigned short ii;
     unsigned short this_write;
-    /* Must divide evenly into st.hw->bank_size to avoid bank crossings. */
-#define LOAD_CHUNK  (16)
-    unsigned char cur[LOAD_CHUNK], tmp[2];
+    unsigned long crc;
+    unsigned char tmp[2];
 
     if (st.chip_cfg.dmp_loaded)
         /* DMP should only be loaded once. */
@@ -2357,11 +2485,12 @@ int mpu_load_firmware(unsigned short length, const unsigned char *firmware,
         this_write = min(LOAD_CHUNK, length - ii);
         if (mpu_write_mem(ii, this_write, (unsigned char*)&firmware[ii]))
             return -1;
-        if (mpu_read_mem(ii, this_write, cur))
-            return -1;
-        if (memcmp(firmware+ii, cur, this_write))
-            return -2;
     }
+    /* Verify the whole image in one pass instead of after every chunk. */
+    if (mpu_crc_mem(0, length, &crc))
+        return -1;
+    if (crc != mpu_crc32(0, firmware, length))
+        return -2;
 
     /* Set program start address. */
     tmp[0] = start_addr >> 8;
@@ -2374,6 +2503,79 @@ int mpu_load_firmware(unsigned short length, const unsigned char *firmware,
     return 0;
 }
 
+/**
+ *  @brief      Take over a DMP image that is already in memory.
+ *  For use after @e mpu_init_warm. The caller is responsible for checking
+ *  the image, e.g. with @e mpu_crc_mem.
+ *  @param[in]  start_addr  Starting address of DMP code memory.
+ *  @param[in]  sample_rate Fixed sampling rate used when DMP is enabled.
+ *  @return     0 if successful, -1 if the program start address differs.
+ */
+int mpu_attach_firmware(unsigned short start_addr, unsigned short sample_rate)
+{
+    unsigned char tmp[2];
+
+    if (st.chip_cfg.dmp_loaded)
+        return -1;
+    if (i2c_read(st.hw->addr, st.reg->prgm_start_h, 2, tmp))
+        return -1;
+    if (((unsigned short)tmp[0] << 8 | tmp[1]) != start_addr)
+        return -1;
+
+    st.chip_cfg.dmp_loaded = 1;
+    st.chip_cfg.dmp_sample_rate = sample_rate;
+    return 0;
+}
+
+/**
+ *  @brief      CRC-32 (IEEE 802.3), chainable like zlib's crc32().
+ *  @param[in]  crc     0 to start, or the result of the previous block.
+ *  @param[in]  data    Bytes to add.
+ *  @param[in]  length  Number of bytes.
+ *  @return     Updated CRC.
+ */
+unsigned long mpu_crc32(unsigned long crc, const unsigned char *data,
+    unsigned short length)
+{
+    unsigned char ii;
+
+    crc = ~crc & 0xFFFFFFFFUL;
+    while (length--) {
+        crc ^= *data++;
+        for (ii = 0; ii < 8; ii++)
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+    }
+    return ~crc & 0xFFFFFFFFUL;
+}
+
+/**
+ *  @brief      CRC-32 of a range of DMP memory, read in bank sized bursts.
+ *  @param[in]  mem_addr    First byte.
+ *  @param[in]  length      Number of bytes.
+ *  @param[out] crc         CRC as computed by @e mpu_crc32.
+ *  @return     0 if successful.
+ */
+int mpu_crc_mem(unsigned short mem_addr, unsigned short length,
+    unsigned long *crc)
+{
+    unsigned char cur[LOAD_CHUNK];
+    unsigned short this_read;
+
+    *crc = 0;
+    while (length) {
+        /* Stay inside the current bank. */
+        this_read = LOAD_CHUNK - (mem_addr % LOAD_CHUNK);
+        if (this_read > length)
+            this_read = length;
+        if (mpu_read_mem(mem_addr, this_read, cur))
+            return -1;
+        *crc = mpu_crc32(*crc, cur, this_read);
+        mem_addr += this_read;
+        length -= this_read;
+    }
+    return 0;
+}
+
 /**
  *  @brief      Enable/disable DMP support.
  *  @param[in]  enable  1 to turn on the DMP.
@@ -53,6 +53,7 @@ struct int_param_s {
 
 /* Set up APIs */
 int mpu_init(void);
+int mpu_init_warm(void);
 int mpu_init_slave(void);
 int mpu_set_bypass(unsigned char bypass_on);
 
@@ -104,6 +105,8 @@ int mpu_read_fifo(short *gyro, short *accel, unsigned long *timestamp,
     unsigned char *sensors, unsigned char *more);
 int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     unsigned char *more);
+int mpu_read_fifo_burst(unsigned short length, unsigned char max_packets,
+    unsigned char *data, unsigned char *packets, unsigned char *more);
 int mpu_reset_fifo(void);
 
 int mpu_write_mem(unsigned short mem_addr, unsigned short length,
@@ -112,6 +115,11 @@ int mpu_read_mem(unsigned short mem_addr, unsigned short length,
     unsigned char *data);
 int mpu_load_firmware(unsigned short length, const unsigned char *firmware,
     unsigned short start_addr, unsigned short sample_rate);
+int mpu_attach_firmware(unsigned short start_addr, unsigned short sample_rate);
+int mpu_crc_mem(unsigned short mem_addr, unsigned short length,
+    unsigned long *crc);
+unsigned long mpu_crc32(unsigned long crc, const unsigned char *data,
+    unsigned short length);
 
 int mpu_reg_dump(void);
 int mpu_read_reg(unsigned char reg, unsigned char *data);
@@ -457,7 +457,7 @@ static const unsigned short sStartAddress = 0x0400;
 #define DMP_FEATURE_SEND_ANY_GYRO   (DMP_FEATURE_SEND_RAW_GYRO | \
                                      DMP_FEATURE_SEND_CAL_GYRO)
 
-#define MAX_PACKET_LENGTH   (32)
+#define MAX_PACKET_LENGTH   (DMP_MAX_PACKET_LENGTH)
 
 #define DMP_SAMPLE_RATE     (200)
 #define GYRO_SF             (46850825LL * 200 / DMP_SAMPLE_RATE)
@@ -505,6 +505,28 @@ int dmp_load_motion_driver_firmware(void)
         DMP_SAMPLE_RATE);
 }
 
+/**
+ *  @brief  Take over the image a previous boot left in the DMP.
+ *  Use after @e mpu_init_warm, once @e dmp_code_crc has confirmed the image.
+ *  @return 0 if successful.
+ */
+int dmp_attach_motion_driver_firmware(void)
+{
+    return mpu_attach_firmware(sStartAddress, DMP_SAMPLE_RATE);
+}
+
+/**
+ *  @brief      CRC of the DMP code area as it is in memory.
+ *  The code area only changes when features are configured, so the same
+ *  configuration reads back the same CRC until the sensor loses power.
+ *  @param[out] crc CRC as computed by @e mpu_crc32.
+ *  @return     0 if successful.
+ */
+int dmp_code_crc(unsigned long *crc)
+{
+    return mpu_crc_mem(sStartAddress, DMP_CODE_SIZE - sStartAddress, crc);
+}
+
 /**
  *  @brief      Push gyro and accel orientation to the DMP.
  *  The orientation is represented here as the output of
@@ -1259,13 +1281,61 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
     unsigned long *timestamp, short *sensors, unsigned char *more)
 {
     unsigned char fifo_data[MAX_PACKET_LENGTH];
-    unsigned char ii = 0;
     sensors[0] = 0;
 
     /* Get a packet. */
     if (mpu_read_fifo_stream(dmp.packet_length, fifo_data, more))
         return -1;
 
+    if (dmp_decode_packet(fifo_data, gyro, accel, quat, sensors))
+        return -1;
+
+    myget_ms(timestamp);
+    return 0;
+}
+
+/**
+ *  @brief      Size of one DMP FIFO packet for the enabled features.
+ *  @return     Packet length in bytes.
+ */
+unsigned short dmp_get_packet_length(void)
+{
+    return dmp.packet_length;
+}
+
+/**
+ *  @brief      Drain several packets from the FIFO in one transaction.
+ *  Use @e dmp_decode_packet on each @e dmp_get_packet_length sized slice of
+ *  @e fifo_data, oldest packet first.
+ *  @param[out] fifo_data   Raw packets, at least max_packets * packet length.
+ *  @param[in]  max_packets Maximum number of packets to read.
+ *  @param[out] packets     Number of packets read.
+ *  @param[out] more        Number of packets left in the FIFO.
+ *  @return     0 if successful.
+ */
+int dmp_read_fifo_burst(unsigned char *fifo_data, unsigned char max_packets,
+    unsigned char *packets, unsigned char *more)
+{
+    return mpu_read_fifo_burst(dmp.packet_length, max_packets, fifo_data,
+        packets, more);
+}
+
+/**
+ *  @brief      Parse one DMP packet already read from the FIFO.
+ *  Same output convention as @e dmp_read_fifo.
+ *  @param[in]  fifo_data   One packet of @e dmp_get_packet_length bytes.
+ *  @param[out] gyro        Gyro data in hardware units.
+ *  @param[out] accel       Accel data in hardware units.
+ *  @param[out] quat        3-axis quaternion data in hardware units.
+ *  @param[out] sensors     Mask of sensors found in the packet.
+ *  @return     0 if successful, non-zero if the FIFO was found corrupted.
+ */
+int dmp_decode_packet(const unsigned char *fifo_data, short *gyro,
+    short *accel, long *quat, short *sensors)
+{
+    unsigned char ii = 0;
+    sensors[0] = 0;
+
     /* Parse DMP packet. */
     if (dmp.feature_mask & (DMP_FEATURE_LP_QUAT | DMP_FEATURE_6X_LP_QUAT)) {
 #ifdef FIFO_CORRUPTION_CHECK
@@ -1326,9 +1396,8 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
      * the gesture callbacks (if registered).
      */
     if (dmp.feature_mask & (DMP_FEATURE_TAP | DMP_FEATURE_ANDROID_ORIENT))
-        decode_gesture(fifo_data + ii);
+        decode_gesture((unsigned char*)fifo_data + ii);
 
-    myget_ms(timestamp);
     return 0;
 }
 
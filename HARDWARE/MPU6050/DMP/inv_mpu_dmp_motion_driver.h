@@ -44,8 +44,13 @@
 
 #define INV_WXYZ_QUAT       (0x100)
 
+/* Largest FIFO packet, every feature enabled. Size burst buffers with it. */
+#define DMP_MAX_PACKET_LENGTH   (32)
+
 /* Set up functions. */
 int dmp_load_motion_driver_firmware(void);
+int dmp_attach_motion_driver_firmware(void);
+int dmp_code_crc(unsigned long *crc);
 int dmp_set_fifo_rate(unsigned short rate);
 int dmp_get_fifo_rate(unsigned short *rate);
 int dmp_enable_feature(unsigned short mask);
@@ -87,6 +92,11 @@ int dmp_enable_gyro_cal(unsigned char enable);
  */
 int dmp_read_fifo(short *gyro, short *accel, long *quat,
     unsigned long *timestamp, short *sensors, unsigned char *more);
+unsigned short dmp_get_packet_length(void);
+int dmp_read_fifo_burst(unsigned char *fifo_data, unsigned char max_packets,
+    unsigned char *packets, unsigned char *more);
+int dmp_decode_packet(const unsigned char *fifo_data, short *gyro,
+    short *accel, long *quat, short *sensors);
 
 #endif  /* #ifndef _INV_MPU_DMP_MOTION_DRIVER_H_ */
 
@@ -1,5 +1,50 @@
 #include "I2C.h"
 
+// Delay unit of the bit timing in CPU cycles, 0 until IIC_Set_Speed is called
+// (1us units through delay_us). A written bit takes 3 units, a read bit 4.
+static u32 iic_unit_cycles = 0;
+
+static void IIC_Delay(void)
+{
+    u32 start;
+    if(iic_unit_cycles == 0)
+    {
+        delay_us(1);
+        return;
+    }
+    start = getCycleCnt();
+    while(getCycleCnt() - start < iic_unit_cycles);
+}
+
+/**************************************************************************
+ * Set the SCL rate of the bit-bang bus
+ * Input: khz=SCL rate, clamped to IIC_SPEED_FAST_KHZ (MPU6050 maximum)
+ **************************************************************************/
+void IIC_Set_Speed(u32 khz)
+{
+    if(khz > IIC_SPEED_FAST_KHZ) khz = IIC_SPEED_FAST_KHZ;
+    if(khz == 0) khz = IIC_SPEED_STANDARD_KHZ;
+    iic_unit_cycles = SystemCoreClock / (khz * 3000UL);
+}
+
+/**************************************************************************
+ * Release a slave that holds SDA low, e.g. after an MCU reset in the
+ * middle of a read: clock SCL until SDA is high, then send a stop
+ **************************************************************************/
+void IIC_Bus_Recover(void)
+{
+    u8 i;
+    SDA_IN();
+    for(i=0;i<9 && !READ_SDA;i++)
+    {
+        IIC_SCL=0;
+        delay_us(5);
+        IIC_SCL=1;
+        delay_us(5);
+    }
+    IIC_Stop();
+}
+
 /**************************************************************************
  * Initialize IIC GPIO pins (PB10:SCL, PB11:SDA)
  **************************************************************************/
@@ -21,6 +66,7 @@ void I2C_GPIOInit(void)
     /* ??????? */
     HAL_GPIO_WritePin(GPIOB, GPIO_PIN_10, GPIO_PIN_SET);
     HAL_GPIO_WritePin(GPIOB, GPIO_PIN_11, GPIO_PIN_SET);
+    IIC_Bus_Recover();
 }
 
 /**************************************************************************
@@ -33,10 +79,10 @@ int IIC_Start(void)
     IIC_SDA=1;
     if(!READ_SDA)return 0;    
     IIC_SCL=1;
-    delay_us(1);
+    IIC_Delay();
     IIC_SDA=0;       // Start: SDA falls when SCL is high
     if(READ_SDA)return 0;
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=0;       // Hold I2C bus, ready to send/receive data
     return 1;
 }
@@ -49,10 +95,10 @@ void IIC_Stop(void)
     SDA_OUT();       // Set SDA to output
     IIC_SCL=0;
     IIC_SDA=0;       // Stop: SDA rises when SCL is high
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=1; 
     IIC_SDA=1;       // Send stop signal
-    delay_us(1);                   
+    IIC_Delay();                   
 }
 
 /**************************************************************************
@@ -64,9 +110,9 @@ int IIC_Wait_Ack(void)
     u8 ucErrTime=0;
     SDA_IN();        // Set SDA to input
     IIC_SDA=1;
-    delay_us(1);       
+    IIC_Delay();       
     IIC_SCL=1;
-    delay_us(1);     
+    IIC_Delay();     
     while(READ_SDA)  // Wait until SDA is low (ACK)
     {
         ucErrTime++;
@@ -75,7 +121,7 @@ int IIC_Wait_Ack(void)
             IIC_Stop();
             return 0;
         }
-        delay_us(1);
+        IIC_Delay();
     }
     IIC_SCL=0;       // Lower SCL
     return 1;  
@@ -89,9 +135,9 @@ void IIC_Ack(void)
     IIC_SCL=0;
     SDA_OUT();
     IIC_SDA=0;       // ACK: low level
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=1;
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=0;
 }
 
@@ -103,9 +149,9 @@ void IIC_NAck(void)
     IIC_SCL=0;
     SDA_OUT();
     IIC_SDA=1;       // NACK: high level
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=1;
-    delay_us(1);
+    IIC_Delay();
     IIC_SCL=0;
 }
 
@@ -122,11 +168,11 @@ void IIC_Send_Byte(u8 txd)
     {              
         IIC_SDA=(txd&0x80)>>7;  // Send MSB first
         txd<<=1;      
-        delay_us(1);   
+        IIC_Delay();   
         IIC_SCL=1;    // High SCL: slave reads bit
-        delay_us(1); 
+        IIC_Delay(); 
         IIC_SCL=0;    // Lower SCL for next bit
-        delay_us(1);
+        IIC_Delay();
     }     
 } 
 
@@ -201,11 +247,11 @@ u8 IIC_Read_Byte(unsigned char ack)
     for(i=0;i<8;i++ )  // Read 8 bits
     {
         IIC_SCL=0; 
-        delay_us(2);
+        IIC_Delay(); IIC_Delay();
         IIC_SCL=1;      // High SCL: master reads bit
         receive<<=1;
         if(READ_SDA)receive++;   // LSB first
-        delay_us(2); 
+        IIC_Delay(); IIC_Delay();
     }                     
     if (ack)
         IIC_Ack();      // Send ACK
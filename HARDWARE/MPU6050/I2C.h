@@ -27,6 +27,10 @@
 #define  I2C_Direction_Receiver         ((uint8_t)0x01) // Read direction
 #endif
 
+// SCL rates for IIC_Set_Speed
+#define IIC_SPEED_STANDARD_KHZ  333   // 1us delay unit, the original timing
+#define IIC_SPEED_FAST_KHZ      400   // Fast mode limit of the MPU6050
+
 // ACK/NACK definitions
 enum
 {
@@ -58,5 +62,7 @@ int i2cWrite(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data);
 int i2cRead(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf);
 u8 I2C_WriteOneByte(uint8_t DevAddr, uint8_t RegAddr, uint8_t Data);
 void I2C_GPIOInit(void);                // Initialize IIC GPIO pins
+void IIC_Set_Speed(u32 khz);            // Set the SCL rate
+void IIC_Bus_Recover(void);             // Free SDA held low by a slave
 
 #endif
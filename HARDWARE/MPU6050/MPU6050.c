@@ -1,5 +1,9 @@
 #include "MPU6050.h"
 #include "I2C.h"
+#include "i2c_bus.h"
+#include "imu_calib.h"
+#include "fast_math.h"
+#include "float_only.h"
 //#include "usart.h"
 #define PRINT_ACCEL     (0x01)
 #define PRINT_GYRO      (0x02)
@@ -17,16 +21,38 @@ float Roll,Pitch,Yaw;
 float Original_Roll,Original_Pitch,Original_Yaw;
 float Deviation_Roll,Deviation_Pitch,Deviation_Yaw;
 float Initial_Roll = 0, Initial_Pitch = 0, Initial_Yaw = 0;
-int16_t Initial_Gyro_Bias[3] = {0}; // һβɼƯ׼ֵ
-uint8_t gyro_bias_captured = 0;    // Ư׼ֵǷѲ־
-uint8_t angle_calibrated = 0;  // ǶУ׼־
-//ƯƼ
+int16_t Initial_Gyro_Bias[3] = {0}; // 保存第一次采集的零漂基准值
+uint8_t gyro_bias_captured = 0;    // 零漂基准值是否已捕获标志
+uint8_t angle_calibrated = 0;  // 角度校准标志
+//零点漂移计数
 int Deviation_Count;
 // Gyro static error, raw data
-//Ǿԭʼ
+//陀螺仪静差，原始数据
 short Deviation_gyro[3],Original_gyro[3];    
 short Deviation_accel[3],Original_accel[3]; 
 float q0=1.0f,q1=0.0f,q2=0.0f,q3=0.0f;
+//Attitude estimator selection and the Mahony instance fed from raw data
+//姿态解算来源选择，以及使用原始数据的Mahony滤波器实例
+u8 Attitude_Source = ATTITUDE_SOURCE_DMP;
+Mahony_Filter IMU_Mahony;
+float DMP_Yaw;                       //DMP yaw before calibration offset //减去初始值前的DMP偏航角
+static float Initial_Mahony_Yaw = 0;
+IMU_Benchmark_t IMU_Benchmark;
+IMU_Boot_Timing_t IMU_Boot_Timing;
+float Yaw_Rate;                        //Calibrated z gyro, degree/s //校准后的z轴角速度，度/秒
+static float Gyro_Yaw_Angle;
+static u32 Gyro_Yaw_Time_us;
+//DMP sample ring buffer, written only by MPU6050_task
+//DMP样本环形缓冲区，仅由MPU6050_task写入
+static IMU_Sample IMU_Ring[IMU_RING_SIZE];
+static volatile u32 IMU_Ring_Head = 0;   //Total samples pushed //累计写入的样本数
+static unsigned char DMP_Burst_Buffer[IMU_BURST_PACKETS*DMP_MAX_PACKET_LENGTH];
+static u32 Last_Sample_us = 0;
+static int IMU_Temperature = 0;      //Die temperature, 0.1 degC //芯片温度，0.1摄氏度
+static volatile u8 IMU_Calib_Save_Pending = 0;   //Full calibration waiting to be written //完整校准结果等待写入Flash
+#if MPU6050_USE_INT_PIN
+static TaskHandle_t MPU6050_Task_Handle = NULL;
+#endif
 static signed char gyro_orientation[9] = {-1, 0, 0,
                                            0,-1, 0,
                                            0, 0, 1};
@@ -52,24 +78,383 @@ static  unsigned short inv_row_2_scale(const signed char *row)
     return b;
 }
 
+/**************************************************************************
+Function: Whether the car is standing still, judged by the wheel speed
+Input   : none
+Output  : 1: all wheels stopped; 0: moving
+函数功能：根据车轮速度判断小车是否静止
+入口参数：无
+返回  值：1：所有车轮静止；0：运动中
+**************************************************************************/
+static u8 Car_Is_Stationary(void)
+{
+	return (MOTOR_A.Encoder==0)&&(MOTOR_B.Encoder==0)&&(MOTOR_C.Encoder==0)&&(MOTOR_D.Encoder==0);
+}
+
+/**************************************************************************
+Function: Write the result of a full calibration once the car is at rest
+Input   : none
+Output  : none
+The sector erase stalls every task and interrupt for up to 2 s on the
+single bank F407, and the PWM keeps its last value meanwhile. It runs from
+the lowest priority task, only while all wheels are stopped with a zero target.
+函数功能：小车停止时写入完整校准的结果
+入口参数：无
+返回  值：无
+单Bank的F407擦除扇区时所有任务和中断最长停顿2秒，期间PWM保持原值。
+因此在最低优先级任务中调用，且仅在所有车轮静止、目标速度为0时写入
+**************************************************************************/
+void IMU_Calib_Save_Idle(void)
+{
+	char msg[48];
+	int res;
+
+	if(!IMU_Calib_Save_Pending || !Car_Is_Stationary()) return;
+	if(MOTOR_A.Target!=0 || MOTOR_B.Target!=0 || MOTOR_C.Target!=0 || MOTOR_D.Target!=0) return;
+	IMU_Calib_Save_Pending = 0;
+	res = IMU_Calib_Save();
+	snprintf(msg, sizeof(msg), "[IMU] calib saved: %s\r\n", res ? "failed" : "ok");
+	usart1_send_cstring(msg);
+}
+
+/**************************************************************************
+Function: Feed the latest raw gyro/accel sample to the Mahony filter
+Input   : timestamp_us: time the registers were read; gyro_scale: rad/s per LSB
+Output  : none
+函数功能：将最新的原始陀螺仪/加速度计数据送入Mahony滤波器
+入口参数：timestamp_us：读取寄存器的时间；gyro_scale：每LSB对应的rad/s
+返回  值：无
+**************************************************************************/
+static void Mahony_Sample(u32 timestamp_us, float gyro_scale)
+{
+	static u32 last_us = 0;
+	float dt;
+	u32 start;
+
+	dt = (timestamp_us - last_us) * 1e-6f;
+	last_us = timestamp_us;
+	//First call or a stalled task, fall back to the nominal period
+	//首次调用或任务被阻塞时，使用名义周期
+	if(dt <= 0.0f || dt > 0.1f) dt = 1.0f / MPU6050_TASK_RATE;
+
+	//Apply the same mounting matrix as gyro_orientation (x and y inverted)
+	//与gyro_orientation相同的安装矩阵（x、y轴取反）
+	start = getCycleCnt();
+	Mahony_Update(&IMU_Mahony,
+	              -Original_gyro[0] * gyro_scale, -Original_gyro[1] * gyro_scale, Original_gyro[2] * gyro_scale,
+	              -Original_accel[0], -Original_accel[1], Original_accel[2],
+	              dt, Car_Is_Stationary(), timestamp_us);
+	IMU_Benchmark.Mahony_Cycles = getCycleCnt() - start;
+	if(IMU_Benchmark.Mahony_Cycles > IMU_Benchmark.Mahony_Cycles_Max)
+		IMU_Benchmark.Mahony_Cycles_Max = IMU_Benchmark.Mahony_Cycles;
+
+	if(Attitude_Source == ATTITUDE_SOURCE_MAHONY)
+	{
+		float yaw = 0;
+		if(angle_calibrated)
+		{
+			yaw = Fast_Wrap180(IMU_Mahony.Yaw_Unwrapped - Initial_Mahony_Yaw);
+		}
+		Roll = IMU_Mahony.Roll;
+		Pitch = IMU_Mahony.Pitch;
+		Yaw = yaw;
+	}
+	IMU_Benchmark.Mahony_Latency_us = getMicros() - timestamp_us;
+}
+
+/**************************************************************************
+Function: Measure the yaw drift of both estimators while the car stands still
+Input   : none
+Output  : none
+函数功能：小车静止时统计两种姿态解算的偏航角漂移
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void IMU_Benchmark_Drift(void)
+{
+	static u32 start_us = 0;
+	static float start_dmp = 0, start_mahony = 0;
+	static u8 running = 0;
+	float minutes, dmp_delta;
+
+	if(!angle_calibrated || !IMU_Mahony.Bias_Valid || IMU_Mahony.Stationary_Count == 0)
+	{
+		running = 0;
+		return;
+	}
+	if(!running)
+	{
+		start_us = IMU_Mahony.Timestamp_us;
+		start_dmp = DMP_Yaw;
+		start_mahony = IMU_Mahony.Yaw_Unwrapped;
+		running = 1;
+		return;
+	}
+	minutes = (IMU_Mahony.Timestamp_us - start_us) * (1e-6f / 60.0f);
+	if(minutes < (1.0f / 60.0f)) return; //Wait for at least one second //至少统计1秒
+
+	dmp_delta = DMP_Yaw - start_dmp;
+	if(dmp_delta > 180.0f) dmp_delta -= 360.0f;
+	else if(dmp_delta < -180.0f) dmp_delta += 360.0f;
+	IMU_Benchmark.DMP_Drift_dpm = dmp_delta / minutes;
+	IMU_Benchmark.Mahony_Drift_dpm = (IMU_Mahony.Yaw_Unwrapped - start_mahony) / minutes;
+}
+
+/**************************************************************************
+Function: Wake MPU6050_task on the INT pin, call from the EXTI callback
+Input   : none
+Output  : none
+函数功能：MPU6050 INT引脚中断时唤醒MPU6050_task，在EXTI回调中调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void MPU6050_INT_Handler(void)
+{
+#if MPU6050_USE_INT_PIN
+	BaseType_t woken = pdFALSE;
+	if(MPU6050_Task_Handle == NULL) return;
+	vTaskNotifyGiveFromISR(MPU6050_Task_Handle, &woken);
+	portYIELD_FROM_ISR(woken);
+#endif
+}
+
+/**************************************************************************
+Function: Append one DMP sample to the ring buffer
+Input   : quat: DMP quaternion (q30); g, a: gyro/accel; timestamp_us: sample time
+Output  : none
+函数功能：将一个DMP样本写入环形缓冲区
+入口参数：quat：DMP四元数(q30)；g，a：陀螺仪/加速度计；timestamp_us：采样时间
+返回  值：无
+**************************************************************************/
+static void IMU_Ring_Push(const long *quat, const short *g, const short *a, u32 timestamp_us)
+{
+	IMU_Sample *slot = &IMU_Ring[IMU_Ring_Head & (IMU_RING_SIZE-1)];
+	//Sequence lock: readers reject a copy whose Seq changed while they copied
+	//顺序锁：复制期间Seq发生变化的副本被读取者丢弃
+	slot->Seq = IMU_SEQ_WRITING;
+	__DMB();
+	slot->q[0] = quat[0] / q30;
+	slot->q[1] = quat[1] / q30;
+	slot->q[2] = quat[2] / q30;
+	slot->q[3] = quat[3] / q30;
+	slot->gyro[0] = g[0];  slot->gyro[1] = g[1];  slot->gyro[2] = g[2];
+	slot->accel[0] = a[0]; slot->accel[1] = a[1]; slot->accel[2] = a[2];
+	slot->Timestamp_us = timestamp_us;
+	__DMB();
+	slot->Seq = IMU_Ring_Head;
+	//Publish the slot only after it is complete //样本写完后再更新写指针
+	__DMB();
+	IMU_Ring_Head++;
+}
+
+/**************************************************************************
+Function: Copy one ring slot, checking its sequence number before and after the copy
+Input   : seq: sample sequence number; out: sample copy
+Output  : 1: consistent copy of that sample; 0: being written or already overwritten
+函数功能：复制一个缓冲区槽位，在复制前后检查其序号
+入口参数：seq：样本序号；out：样本副本
+返回  值：1：该样本的完整副本；0：正在写入或已被覆盖
+**************************************************************************/
+static u8 IMU_Ring_Copy(u32 seq, IMU_Sample *out)
+{
+	volatile IMU_Sample *slot = &IMU_Ring[seq & (IMU_RING_SIZE-1)];
+
+	if(slot->Seq != seq) return 0;
+	__DMB();
+	*out = *(IMU_Sample *)slot;
+	__DMB();
+	return slot->Seq == seq;
+}
+
+/**************************************************************************
+Function: Copy the newest DMP sample without touching the I2C bus
+Input   : out: sample copy
+Output  : 1: valid sample; 0: no sample yet
+函数功能：在不访问I2C总线的情况下获取最新的DMP样本
+入口参数：out：样本副本
+返回  值：1：样本有效；0：尚无样本
+**************************************************************************/
+u8 IMU_Get_Latest(IMU_Sample *out)
+{
+	u32 head;
+	do
+	{
+		head = IMU_Ring_Head;
+		if(head == 0) return 0;
+	}while(!IMU_Ring_Copy(head-1, out)); //Overwritten while copying, retry //复制期间被覆盖，重试
+	return 1;
+}
+
+/**************************************************************************
+Function: Integrate the calibrated z gyro for yaw rate consumers
+Input   : timestamp_us: sample time; gyro_sens: LSB per degree/s
+Output  : none
+函数功能：积分校准后的z轴陀螺仪数据，供偏航角速度使用者读取
+入口参数：timestamp_us：采样时间；gyro_sens：每度/秒对应的LSB
+返回  值：无
+**************************************************************************/
+static void Gyro_Yaw_Sample(u32 timestamp_us, float gyro_sens)
+{
+	static u32 last_us = 0;
+	float dt, angle;
+
+	dt = (timestamp_us - last_us) * 1e-6f;
+	last_us = timestamp_us;
+	if(dt <= 0.0f || dt > 0.1f) dt = 1.0f / MPU6050_TASK_RATE;
+
+	Yaw_Rate = gyro[2] / gyro_sens;
+	//Kept within +-180 so the float keeps its resolution over long runs
+	//限制在±180度内，长时间运行也能保持浮点精度
+	angle = Gyro_Yaw_Angle + Yaw_Rate * dt;
+	if(angle > 180.0f) angle -= 360.0f;
+	else if(angle < -180.0f) angle += 360.0f;
+	taskENTER_CRITICAL();
+	Gyro_Yaw_Angle = angle;
+	Gyro_Yaw_Time_us = timestamp_us;
+	taskEXIT_CRITICAL();
+}
+
+/**************************************************************************
+Function: Read the integrated z gyro angle, the mean rate between two reads is
+          the angle difference over the time difference
+Input   : angle_deg: integrated angle, wrapped to +-180; timestamp_us: time of the last sample
+Output  : none
+函数功能：读取z轴陀螺仪积分角度，两次读取之间的平均角速度为角度差除以时间差
+入口参数：angle_deg：积分角度，限制在±180度；timestamp_us：最近一个样本的时间
+返回  值：无
+**************************************************************************/
+void IMU_Get_Gyro_Yaw(float *angle_deg, u32 *timestamp_us)
+{
+	taskENTER_CRITICAL();
+	*angle_deg = Gyro_Yaw_Angle;
+	*timestamp_us = Gyro_Yaw_Time_us;
+	taskEXIT_CRITICAL();
+}
+
+/**************************************************************************
+Function: Print where DMP_Init spent its time
+Input   : none
+Output  : none
+函数功能：打印DMP_Init各阶段的耗时
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void IMU_Report_Boot(void)
+{
+    char msg[112];
+    snprintf(msg, sizeof(msg), "[IMU] %s boot %luus: init %lu, fw %lu, cfg %lu, selftest %lu, bus %ukHz x%u\r\n",
+             IMU_Boot_Timing.Warm ? "warm" : "cold", (unsigned long)IMU_Boot_Timing.Total_us,
+             (unsigned long)IMU_Boot_Timing.Init_us, (unsigned long)IMU_Boot_Timing.Firmware_us,
+             (unsigned long)IMU_Boot_Timing.Config_us, (unsigned long)IMU_Boot_Timing.Self_Test_us,
+             (unsigned)IMU_Boot_Timing.Bus_khz, (unsigned)IMU_Boot_Timing.Upload_Tries);
+    usart1_send_cstring(msg);
+}
+
+/**************************************************************************
+Function: Read every DMP sample queued since the caller's cursor, oldest first
+Input   : cursor: caller owned read position; out: sample array; max: array size
+Output  : Number of samples copied
+函数功能：按时间顺序读取调用者游标之后的所有DMP样本
+入口参数：cursor：调用者自己的读位置；out：样本数组；max：数组大小
+返回  值：复制的样本数
+**************************************************************************/
+u32 IMU_Read_Samples(u32 *cursor, IMU_Sample *out, u32 max)
+{
+	u32 head, n = 0;
+
+	while(n < max)
+	{
+		head = IMU_Ring_Head;
+		//Samples older than the ring depth are lost, skip ahead
+		//超出缓冲深度的旧样本已丢失，直接跳过
+		if(head - *cursor > IMU_RING_SIZE) *cursor = head - IMU_RING_SIZE;
+		if(*cursor == head) break;
+		//Keep the copy only if it was not overwritten meanwhile //复制期间未被覆盖才保留
+		if(IMU_Ring_Copy(*cursor, &out[n])) n++;
+		(*cursor)++;
+	}
+	return n;
+}
+
 void MPU6050_task(void *pvParameters)
 {
     u32 lastWakeTime = getSysTickCnt();
+    float gyro_sens = 16.4f;
+    float gyro_scale;
+    u32 i2c_transactions, i2c_busy_ticks, sample_us;
+    u8 motion_ok;
+#if IMU_BENCHMARK_PRINT
+    u32 print_count = 0;
+    char msg[96];
+#endif
+
+    //LSB per degree/s of the range configured by mpu_init
+    //mpu_init所配置量程下每度/秒对应的LSB
+    mpu_get_gyro_sens(&gyro_sens);
+    gyro_scale = (PI / 180.0f) / gyro_sens;
+    Mahony_Init(&IMU_Mahony, MAHONY_KP_DEFAULT, MAHONY_KI_DEFAULT);
+    //DMP_Init runs before the USART is up, report from here
+    //DMP_Init运行时串口尚未初始化，在此处打印
+    IMU_Report_Boot();
+#if MPU6050_USE_INT_PIN
+    MPU6050_Task_Handle = xTaskGetCurrentTaskHandle();
+#endif
+
     while(1)
     {	
-			//This task runs at 50Hz
-			//50HzƵ
-			vTaskDelayUntil(&lastWakeTime, F2T(RATE_50_HZ));	
+#if MPU6050_USE_INT_PIN
+			//Woken by the DMP data ready interrupt, fall back to the tick if it goes quiet
+			//由DMP数据就绪中断唤醒，中断丢失时按周期超时继续运行
+			ulTaskNotifyTake(pdTRUE, F2T(MPU6050_TASK_RATE)*2);
+#else
+			//This task runs at MPU6050_TASK_RATE //此任务以MPU6050_TASK_RATE运行
+			vTaskDelayUntil(&lastWakeTime, F2T(MPU6050_TASK_RATE));	
+#endif
 		
-			//Read the gyroscope zero before starting
-            //ǰȡ			
-		  if(Deviation_Count<CONTROL_DELAY)
-		  {	 
-		  	Deviation_Count++;
-		  }		
+        i2c_transactions = I2C_Bus_Stats.Reads + I2C_Bus_Stats.Writes;
+        i2c_busy_ticks = I2C_Bus_Stats.Busy_Ticks;
+        //Drain every queued DMP packet so the FIFO never backs up
+        //取空DMP FIFO中的全部数据包，避免积压
         Read_DMP();
-        MPU_Get_Gyroscope(); //õ
-        MPU_Get_Accelscope(); //üٶȼֵ(ԭʼֵ)
+
+#if MPU6050_BURST_READ
+        motion_ok = (MPU_Get_Motion6() == 0); //一次读取陀螺仪和加速度计数据
+#else
+        MPU_Get_Gyroscope(); //得到陀螺仪数据
+        MPU_Get_Accelscope(); //获得加速度计值(原始值)
+        motion_ok = 1;
+#endif
+        //A failed burst leaves the last good values, they are not fed again
+        //读取失败时保留上一次的有效数据，不再重复送入滤波器
+        if(motion_ok)
+        {
+            sample_us = getMicros();
+            Mahony_Sample(sample_us, gyro_scale);
+            Gyro_Yaw_Sample(sample_us, gyro_sens);
+        }
+        IMU_Benchmark_Drift();
+
+        //I2C cost of this cycle //本周期的I2C开销
+        IMU_Benchmark.I2C_Transactions = I2C_Bus_Stats.Reads + I2C_Bus_Stats.Writes - i2c_transactions;
+        IMU_Benchmark.I2C_Busy_us = I2C_Bus_Ticks_To_us(I2C_Bus_Stats.Busy_Ticks - i2c_busy_ticks);
+        if(IMU_Benchmark.I2C_Busy_us > IMU_Benchmark.I2C_Busy_us_Max)
+            IMU_Benchmark.I2C_Busy_us_Max = IMU_Benchmark.I2C_Busy_us;
+
+#if IMU_BENCHMARK_PRINT
+        if(++print_count >= 5*MPU6050_TASK_RATE)
+        {
+            print_count = 0;
+            snprintf(msg, sizeof(msg), "[IMU] dmp %luus/%luus mahony %luus/%luus drift %d/%d mdeg/min\r\n",
+                     (unsigned long)CYCLES_TO_US(IMU_Benchmark.DMP_Cycles_Max), (unsigned long)IMU_Benchmark.DMP_Latency_us,
+                     (unsigned long)CYCLES_TO_US(IMU_Benchmark.Mahony_Cycles_Max), (unsigned long)IMU_Benchmark.Mahony_Latency_us,
+                     (int)(IMU_Benchmark.DMP_Drift_dpm*1000), (int)(IMU_Benchmark.Mahony_Drift_dpm*1000));
+            usart1_send_cstring(msg);
+            snprintf(msg, sizeof(msg), "[IMU] i2c %lu trans %luus/%luus per cycle\r\n",
+                     (unsigned long)IMU_Benchmark.I2C_Transactions, (unsigned long)IMU_Benchmark.I2C_Busy_us,
+                     (unsigned long)IMU_Benchmark.I2C_Busy_us_Max);
+            usart1_send_cstring(msg);
+        }
+#endif
     }
 }  
 
@@ -85,6 +470,22 @@ static  unsigned short inv_orientation_matrix_to_scalar(
     return scalar;
 }
 
+static void push_stored_dmp_bias(void)
+{
+    long stored[3];
+
+    if (!IMU_Calib_Stored_Valid || !IMU_Calib_Stored.DMP_Bias_Valid)
+        return;
+    stored[0] = IMU_Calib_Stored.DMP_Gyro_Bias[0];
+    stored[1] = IMU_Calib_Stored.DMP_Gyro_Bias[1];
+    stored[2] = IMU_Calib_Stored.DMP_Gyro_Bias[2];
+    dmp_set_gyro_bias(stored);
+    stored[0] = IMU_Calib_Stored.DMP_Accel_Bias[0];
+    stored[1] = IMU_Calib_Stored.DMP_Accel_Bias[1];
+    stored[2] = IMU_Calib_Stored.DMP_Accel_Bias[2];
+    dmp_set_accel_bias(stored);
+}
+
 static void run_self_test(void)
 {
     int result;
@@ -107,90 +508,31 @@ static void run_self_test(void)
         accel[1] *= accel_sens;
         accel[2] *= accel_sens;
         dmp_set_accel_bias(accel);
+        IMU_Calib_Set_DMP_Bias(gyro, accel);
 		//printf("setting bias succesfully ......\r\n");
     }
+    else {
+        /* Car was moved during the test, fall back to the last good biases. */
+        push_stored_dmp_bias();
+    }
 }
 
 
 
 uint8_t buffer[14];
 
-int16_t  MPU6050_FIFO[6][11];
 int16_t Gx_offset=0,Gy_offset=0,Gz_offset=0;
 
 
 
-/**************************************************************************
-Function: The new ADC data is updated to FIFO array for filtering
-Input   : axayazxy, z-axis acceleration datagxgygzx. Y, z-axis angular acceleration data
-Output  : none
-ܣµADCݸµ FIFO飬˲
-ڲaxayazxyzٶݣgxgygzxyzǼٶ
-  ֵ
-**************************************************************************/
-void  MPU6050_newValues(int16_t ax,int16_t ay,int16_t az,int16_t gx,int16_t gy,int16_t gz)
-{
-unsigned char i ;
-int32_t sum=0;
-for(i=1;i<10;i++){	//FIFO 
-MPU6050_FIFO[0][i-1]=MPU6050_FIFO[0][i];
-MPU6050_FIFO[1][i-1]=MPU6050_FIFO[1][i];
-MPU6050_FIFO[2][i-1]=MPU6050_FIFO[2][i];
-MPU6050_FIFO[3][i-1]=MPU6050_FIFO[3][i];
-MPU6050_FIFO[4][i-1]=MPU6050_FIFO[4][i];
-MPU6050_FIFO[5][i-1]=MPU6050_FIFO[5][i];
-}
-MPU6050_FIFO[0][9]=ax;//µݷõ ݵ
-MPU6050_FIFO[1][9]=ay;
-MPU6050_FIFO[2][9]=az;
-MPU6050_FIFO[3][9]=gx;
-MPU6050_FIFO[4][9]=gy;
-MPU6050_FIFO[5][9]=gz;
-
-sum=0;
-for(i=0;i<10;i++){	//ǰĺͣȡƽֵ
-   sum+=MPU6050_FIFO[0][i];
-}
-MPU6050_FIFO[0][10]=sum/10;
-
-sum=0;
-for(i=0;i<10;i++){
-   sum+=MPU6050_FIFO[1][i];
-}
-MPU6050_FIFO[1][10]=sum/10;
-
-sum=0;
-for(i=0;i<10;i++){
-   sum+=MPU6050_FIFO[2][i];
-}
-MPU6050_FIFO[2][10]=sum/10;
-
-sum=0;
-for(i=0;i<10;i++){
-   sum+=MPU6050_FIFO[3][i];
-}
-MPU6050_FIFO[3][10]=sum/10;
-
-sum=0;
-for(i=0;i<10;i++){
-   sum+=MPU6050_FIFO[4][i];
-}
-MPU6050_FIFO[4][10]=sum/10;
-
-sum=0;
-for(i=0;i<10;i++){
-   sum+=MPU6050_FIFO[5][i];
-}
-MPU6050_FIFO[5][10]=sum/10;
-}
 
 /**************************************************************************
 Function: Setting the clock source of mpu6050
-Input   : sourceClock source number
+Input   : source：Clock source number
 Output  : none
-ܣ  MPU6050 ʱԴ
-ڲsourceʱԴ
-  ֵ
+函数功能：设置  MPU6050 的时钟源
+入口参数：source：时钟源编号
+返回  值：无
  * CLK_SEL | Clock Source
  * --------+--------------------------------------
  * 0       | Internal oscillator
@@ -203,7 +545,7 @@ Output  : none
  * 7       | Stops the clock and keeps the timing generator in reset
 **************************************************************************/
 void MPU6050_setClockSource(uint8_t source){
-    IICwriteBits(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
+    I2C_Bus_Write_Bits(MPU6050_I2C_ADDR, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_CLKSEL_BIT, MPU6050_PWR1_CLKSEL_LENGTH, source);
 
 }
 
@@ -216,49 +558,49 @@ void MPU6050_setClockSource(uint8_t source){
  * @see MPU6050_GCONFIG_FS_SEL_LENGTH
  */
 void MPU6050_setFullScaleGyroRange(uint8_t range) {
-    IICwriteBits(devAddr, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
+    I2C_Bus_Write_Bits(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_CONFIG, MPU6050_GCONFIG_FS_SEL_BIT, MPU6050_GCONFIG_FS_SEL_LENGTH, range);
 }
 
 /**************************************************************************
 Function: Setting the maximum range of mpu6050 accelerometer
-Input   : rangeAcceleration maximum range number
+Input   : range：Acceleration maximum range number
 Output  : none
-ܣ MPU6050 ٶȼƵ
-ڲrangeٶ̱
-  ֵ
-**************************************************************************/
-//#define MPU6050_ACCEL_FS_2          0x00  		//===+-2G
-//#define MPU6050_ACCEL_FS_4          0x01			//===+-4G
-//#define MPU6050_ACCEL_FS_8          0x02			//===+-8G
-//#define MPU6050_ACCEL_FS_16         0x03			//===+-16G
+函数功能：设置 MPU6050 加速度计的最大量程
+入口参数：range：加速度最大量程编号
+返回  值：无
+**************************************************************************/
+//#define MPU6050_ACCEL_FS_2          0x00  		//===最大量程+-2G
+//#define MPU6050_ACCEL_FS_4          0x01			//===最大量程+-4G
+//#define MPU6050_ACCEL_FS_8          0x02			//===最大量程+-8G
+//#define MPU6050_ACCEL_FS_16         0x03			//===最大量程+-16G
 void MPU6050_setFullScaleAccelRange(uint8_t range) {
-    IICwriteBits(devAddr, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
+    I2C_Bus_Write_Bits(MPU6050_I2C_ADDR, MPU6050_RA_ACCEL_CONFIG, MPU6050_ACONFIG_AFS_SEL_BIT, MPU6050_ACONFIG_AFS_SEL_LENGTH, range);
 }
 
 /**************************************************************************
 Function: Set mpu6050 to sleep mode or not
-Input   : enable1sleep0work
+Input   : enable：1，sleep；0，work；
 Output  : none
-ܣ MPU6050 Ƿ˯ģʽ
-ڲenable1˯0
-  ֵ
+函数功能：设置 MPU6050 是否进入睡眠模式
+入口参数：enable：1，睡觉；0，工作；
+返回  值：无
 **************************************************************************/
 void MPU6050_setSleepEnabled(uint8_t enabled) {
-    IICwriteBit(devAddr, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
+    I2C_Bus_Write_Bit(MPU6050_I2C_ADDR, MPU6050_RA_PWR_MGMT_1, MPU6050_PWR1_SLEEP_BIT, enabled);
 }
 
 /**************************************************************************
 Function: Read identity
 Input   : none
 Output  : 0x68
-ܣȡ  MPU6050 WHO_AM_I ʶ
-ڲ
-  ֵ0x68
+函数功能：读取  MPU6050 WHO_AM_I 标识
+入口参数：无
+返回  值：0x68
 **************************************************************************/
 uint8_t MPU6050_getDeviceID(void) {
 
 	
-	return I2C_ReadOneByte(devAddr,MPU6050_RA_WHO_AM_I);
+	return I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_WHO_AM_I);
 	
 //    IICreadBytes(devAddr, MPU6050_RA_WHO_AM_I, 1, buffer);
 //    return buffer[0];
@@ -267,10 +609,10 @@ uint8_t MPU6050_getDeviceID(void) {
 /**************************************************************************
 Function: Check whether mpu6050 is connected
 Input   : none
-Output  : 1Connected0Not connected
-ܣMPU6050 ǷѾ
-ڲ
-  ֵ1ӣ0δ
+Output  : 1：Connected；0：Not connected
+函数功能：检测MPU6050 是否已经连接
+入口参数：无
+返回  值：1：已连接；0：未连接
 **************************************************************************/
 uint8_t MPU6050_testConnection(void) {
    if(MPU6050_getDeviceID() == 0x68)  //0b01101000;
@@ -280,93 +622,198 @@ uint8_t MPU6050_testConnection(void) {
 
 /**************************************************************************
 Function: Setting whether mpu6050 is the host of aux I2C cable
-Input   : enable1yes0;not
+Input   : enable：1，yes；0;not
 Output  : none
-ܣ MPU6050 ǷΪAUX I2Cߵ
-ڲenable1ǣ0
-  ֵ
+函数功能：设置 MPU6050 是否为AUX I2C线的主机
+入口参数：enable：1，是；0：否
+返回  值：无
 **************************************************************************/
 void MPU6050_setI2CMasterModeEnabled(uint8_t enabled) {
-    IICwriteBit(devAddr, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
+    I2C_Bus_Write_Bit(MPU6050_I2C_ADDR, MPU6050_RA_USER_CTRL, MPU6050_USERCTRL_I2C_MST_EN_BIT, enabled);
 }
 
 /**************************************************************************
 Function: Setting whether mpu6050 is the host of aux I2C cable
-Input   : enable1yes0;not
+Input   : enable：1，yes；0;not
 Output  : none
-ܣ MPU6050 ǷΪAUX I2Cߵ
-ڲenable1ǣ0
-  ֵ
+函数功能：设置 MPU6050 是否为AUX I2C线的主机
+入口参数：enable：1，是；0：否
+返回  值：无
 **************************************************************************/
 void MPU6050_setI2CBypassEnabled(uint8_t enabled) {
-    IICwriteBit(devAddr, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
+    I2C_Bus_Write_Bit(MPU6050_I2C_ADDR, MPU6050_RA_INT_PIN_CFG, MPU6050_INTCFG_I2C_BYPASS_EN_BIT, enabled);
 }
 
+static u32 MPU6050_Warm_Signature(void);
+
 /**************************************************************************
 Function: initialization Mpu6050 to enter the available state
 Input   : none
-Output  : none
-ܣʼ	MPU6050 Խ״̬
-ڲ
-  ֵ
+Output  : 0: success; 1: wrong device ID
+A chip that kept its DMP running through an MCU reset is not touched,
+DMP_Init takes it over as it is.
+函数功能：初始化	MPU6050 以进入可用状态
+入口参数：无
+返回  值：0：成功；1：器件ID错误
+MCU复位期间DMP一直运行的芯片不做任何改动，由DMP_Init直接接管
 **************************************************************************/
 u8 MPU6050_initialize(void) 
 	{
 		u8 res;
-	//IIC_Init();  //Initialize the IIC bus //ʼIIC
-	I2C_WriteOneByte(devAddr,MPU6050_RA_PWR_MGMT_1,0X80);	//Reset MPUrobot_select_init.h //λMPUrobot_select_init.h
-  delay_ms(200); //Delay 200 ms //ʱ200ms
-	I2C_WriteOneByte(devAddr,MPU6050_RA_PWR_MGMT_1,0X00);	//Wake mpurobot_select_init.h //MPUrobot_select_init.h
+	//The reset below would wipe the DMP image and the signature //下面的复位会清除DMP固件和签名
+	if(MPU6050_Warm_Signature()) return 0;
+	//IIC_Init();  //Initialize the IIC bus //初始化IIC总线
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_PWR_MGMT_1,0X80);	//Reset MPUrobot_select_init.h //复位MPUrobot_select_init.h
+  delay_ms(200); //Delay 200 ms //延时200ms
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_PWR_MGMT_1,0X00);	//Wake mpurobot_select_init.h //唤醒MPUrobot_select_init.h
 	
-  //MPU6050_Set_Gyro_Fsr(1);  //Gyroscope sensor              //Ǵ,500dps=500/s 32768 (gyro/32768*500)*PI/180(rad/s)=gyro/3754.9(rad/s)
+  //MPU6050_Set_Gyro_Fsr(1);  //Gyroscope sensor              //陀螺仪传感器,±500dps=±500°/s ±32768 (gyro/32768*500)*PI/180(rad/s)=gyro/3754.9(rad/s)
 	MPU6050_setFullScaleGyroRange(MPU6050_GYRO_FS_500);
-	//MPU6050_Set_Accel_Fsr(0);	//Acceleration sensor           //ٶȴ,2g=2*9.8m/s^2 32768 accel/32768*19.6=accel/1671.84
+	//MPU6050_Set_Accel_Fsr(0);	//Acceleration sensor           //加速度传感器,±2g=±2*9.8m/s^2 ±32768 accel/32768*19.6=accel/1671.84
   MPU6050_setFullScaleAccelRange(MPU6050_ACCEL_FS_2);
-	MPU6050_Set_Rate(50);			//Set the sampling rate to 50Hz //ò50Hz
+	MPU6050_Set_Rate(50);			//Set the sampling rate to 50Hz //设置采样率50Hz
 	
-	I2C_WriteOneByte(devAddr,MPU6050_RA_INT_ENABLE,0X00);	  //Turn off all interrupts //رж
-	I2C_WriteOneByte(devAddr,MPU6050_RA_USER_CTRL,0X00);	//The I2C main mode is off //I2Cģʽر
-	I2C_WriteOneByte(devAddr,MPU6050_RA_FIFO_EN,0X00);	  //Close the FIFO //رFIFO
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_INT_ENABLE,0X00);	  //Turn off all interrupts //关闭所有中断
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_USER_CTRL,0X00);	//The I2C main mode is off //I2C主模式关闭
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_FIFO_EN,0X00);	  //Close the FIFO //关闭FIFO
 	//The INT pin is low, enabling bypass mode to read the magnetometer directly
-	//INTŵ͵ƽЧbypassģʽֱӶȡ
-	I2C_WriteOneByte(devAddr,MPU6050_RA_INT_PIN_CFG,0X80);
+	//INT引脚低电平有效，开启bypass模式，可以直接读取磁力计
+	I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_INT_PIN_CFG,0X80);
 	//Read the ID of MPU6050 
-	//ȡMPU6050ID	
-	res=I2C_ReadOneByte(devAddr,MPU6050_RA_WHO_AM_I);
-	if(res==MPU6050_DEFAULT_ADDRESS) //The device ID is correct, The correct device ID depends on the AD pin //IDȷ, IDȷȡAD
+	//读取MPU6050的ID	
+	res=I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_WHO_AM_I);
+	if(res==MPU6050_DEFAULT_ADDRESS) //The device ID is correct, The correct device ID depends on the AD pin //器件ID正确, 器件ID的正确取决于AD引脚
 	{
-		I2C_WriteOneByte(devAddr,MPU6050_RA_PWR_MGMT_1,0X01);	//Set CLKSEL,PLL X axis as reference //CLKSEL,PLL XΪο
-		I2C_WriteOneByte(devAddr,MPU6050_RA_PWR_MGMT_2,0X00);	//Acceleration and gyroscope both work //ٶǶ
-		MPU6050_Set_Rate(50);	                      //Set the sampling rate to 50Hz //òΪ50Hz   
+		I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_PWR_MGMT_1,0X01);	//Set CLKSEL,PLL X axis as reference //设置CLKSEL,PLL X轴为参考
+		I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_PWR_MGMT_2,0X00);	//Acceleration and gyroscope both work //加速度与陀螺仪都工作
+		MPU6050_Set_Rate(50);	                      //Set the sampling rate to 50Hz //设置采样率为50Hz   
  	}else return 1;
 	return 0;
 
 }
 
+//Registers that carry the warm restart signature //保存热启动签名的寄存器
+static const u8 Warm_Signature_Reg[4] = { MPU6050_RA_I2C_SLV0_REG, MPU6050_RA_I2C_SLV1_REG,
+                                          MPU6050_RA_I2C_SLV2_REG, MPU6050_RA_I2C_SLV3_REG };
+
+static u32 MPU6050_Read_Signature(void)
+{
+	u32 sig = 0;
+	u8 i;
+	for(i = 0; i < 4; i++) sig = (sig << 8) | I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, Warm_Signature_Reg[i]);
+	return sig;
+}
+
+static void MPU6050_Write_Signature(u32 sig)
+{
+	u8 i;
+	for(i = 0; i < 4; i++) I2C_Bus_Write_Byte(MPU6050_I2C_ADDR, Warm_Signature_Reg[i], (u8)(sig >> (24 - 8 * i)));
+}
+
+/**************************************************************************
+Function: Check whether the MPU6050 kept running through an MCU reset
+Input   : none
+Output  : Expected CRC of the DMP code area, 0: cold start
+函数功能：检查MCU复位期间MPU6050是否一直保持运行
+入口参数：无
+返回  值：DMP代码区的预期CRC，0：冷启动
+**************************************************************************/
+static u32 MPU6050_Warm_Signature(void)
+{
+	//A powered up chip has the DMP stopped and the signature registers cleared
+	//刚上电的芯片DMP未运行，签名寄存器为0
+	if(!(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_USER_CTRL) & 0x80)) return 0;
+	if(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_PWR_MGMT_1) & 0x40) return 0;
+	return MPU6050_Read_Signature();
+}
+
+/**************************************************************************
+Function: Upload the DMP image at the fastest bus rate that verifies
+Input   : none
+Output  : 0: success; others: failure
+函数功能：以能通过校验的最快总线速率下载DMP固件
+入口参数：无
+返回  值：0：成功；其他：失败
+**************************************************************************/
+static int DMP_Load_Firmware(void)
+{
+	static const u16 speed_khz[2] = { IIC_SPEED_FAST_KHZ, IIC_SPEED_STANDARD_KHZ };
+	int res = -1;
+	u8 i;
+
+	for(i = 0; i < 2; i++)
+	{
+		I2C_Bus_Set_Speed(speed_khz[i]);
+		IMU_Boot_Timing.Bus_khz = speed_khz[i];
+		IMU_Boot_Timing.Upload_Tries = i + 1;
+		res = dmp_load_motion_driver_firmware();
+		//-2 is a CRC mismatch, retry slower. The image is written from
+		//address 0 again, the loaded flag is only set on success
+		//-2为CRC不匹配，降速重试。固件从地址0重新写入，成功后才置位已加载标志
+		if(res != -2) break;
+	}
+	return res;
+}
+
 /**************************************************************************
 Function: Initialization of DMP in mpu6050
 Input   : none
 Output  : none
-ܣMPU6050DMPĳʼ
-ڲ
-  ֵ
+After an MCU reset with the sensor powered, the running DMP is taken over:
+mpu_init_warm only reads the configuration back, the FIFO and the DMP keep
+running and only the feature set is written again.
+函数功能：MPU6050内置DMP的初始化
+入口参数：无
+返回  值：无
+MCU复位而传感器未断电时直接接管正在运行的DMP：mpu_init_warm只读回配置，
+FIFO和DMP保持运行，仅重新写入功能配置
 **************************************************************************/
 void DMP_Init(void)
 { 
-   u8 temp[1]={0};
-   i2cRead(0x68,0x75,1,temp);
+   u8 temp[1]={0}, i;
+   u32 start, t, warm_crc;
+   unsigned long crc = 0;
+
+   start = getMicros();
+   //A glitch on the bus should not cost a full MCU reset //总线偶发错误不应导致整机复位
+   for(i = 0; i < 3 && temp[0] != 0x68; i++)
+   {
+     I2C_Bus_Read(MPU6050_I2C_ADDR,MPU6050_RA_WHO_AM_I,1,temp);
+     if(temp[0] != 0x68) delay_ms(10);
+   }
 	 //printf("mpu_set_sensor complete ......\r\n");
 	if(temp[0]!=0x68)NVIC_SystemReset();
-	if(!mpu_init())
+	IMU_Calib_Load();
+
+	//Warm restart: the DMP is running and its code still matches the signature
+	//热启动：DMP仍在运行且代码区与签名一致
+	t = getMicros();
+	warm_crc = MPU6050_Warm_Signature();
+	IMU_Boot_Timing.Warm = 0;
+	if(warm_crc && !mpu_init_warm() && !dmp_code_crc(&crc) && crc == warm_crc &&
+	   !dmp_attach_motion_driver_firmware())
+		IMU_Boot_Timing.Warm = 1;
+	IMU_Boot_Timing.Firmware_us = getMicros() - t;
+
+	t = getMicros();
+	if(IMU_Boot_Timing.Warm || !mpu_init())
   {
-	  if(!mpu_set_sensors(INV_XYZ_GYRO | INV_XYZ_ACCEL)){}
+	  IMU_Boot_Timing.Init_us = getMicros() - t;
+	  //A running chip keeps its sensors, FIFO and sample rate //运行中的芯片保持原有的传感器、FIFO和采样率配置
+	  if(!IMU_Boot_Timing.Warm)
+	  {
+	    if(!mpu_set_sensors(INV_XYZ_GYRO | INV_XYZ_ACCEL)){}
 	  	 //printf("mpu_set_sensor complete ......\r\n");
-	  if(!mpu_configure_fifo(INV_XYZ_GYRO | INV_XYZ_ACCEL)){}
+	    if(!mpu_configure_fifo(INV_XYZ_GYRO | INV_XYZ_ACCEL)){}
 	  	 //printf("mpu_configure_fifo complete ......\r\n");
-	  if(!mpu_set_sample_rate(DEFAULT_MPU_HZ)){}
+	    if(!mpu_set_sample_rate(DEFAULT_MPU_HZ)){}
 	  	 //printf("mpu_set_sample_rate complete ......\r\n");
-	  if(!dmp_load_motion_driver_firmware()){}
+	    t = getMicros();
+	    if(!DMP_Load_Firmware()){}
 	  	//printf("dmp_load_motion_driver_firmware complete ......\r\n");
+	    IMU_Boot_Timing.Firmware_us += getMicros() - t;
+	  }
+	  t = getMicros();
 	  if(!dmp_set_orientation(inv_orientation_matrix_to_scalar(gyro_orientation))){}
 	  	 //printf("dmp_set_orientation complete ......\r\n");
 	  if(!dmp_enable_feature(DMP_FEATURE_6X_LP_QUAT | DMP_FEATURE_TAP |
@@ -375,19 +822,34 @@ void DMP_Init(void)
 	  	 //printf("dmp_enable_feature complete ......\r\n");
 	  if(!dmp_set_fifo_rate(DEFAULT_MPU_HZ)){}
 	  	 //printf("dmp_set_fifo_rate complete ......\r\n");
-	  run_self_test();
+	  IMU_Boot_Timing.Config_us = getMicros() - t;
+	  t = getMicros();
+	  //The sensor has been running, its biases are already trimmed
+	  //传感器一直在运行，零偏无需重新自检
+	  if(IMU_Boot_Timing.Warm) push_stored_dmp_bias();
+	  else run_self_test();
+	  IMU_Boot_Timing.Self_Test_us = getMicros() - t;
 		if(!mpu_set_dmp_state(1)){}
 			 //printf("mpu_set_dmp_state complete ......\r\n");
+	  //Sign the configured image so the next MCU reset can reuse it
+	  //为配置好的固件签名，下次MCU复位时可直接复用
+	  if(!IMU_Boot_Timing.Warm && !dmp_code_crc(&crc)) MPU6050_Write_Signature((u32)crc);
   }
-
+  else
+  {
+    //The gyro range was not configured, a stored bias would be at the wrong scale
+    //陀螺仪量程未配置，保存的零偏单位不对
+    IMU_Calib_Reject(IMU_CALIB_REJECT_INIT);
+  }
+	IMU_Boot_Timing.Total_us = getMicros() - start;
 }
 /**************************************************************************
 Function: Read the attitude information of DMP in mpu6050
 Input   : none
 Output  : none
-ܣȡMPU6050DMP̬Ϣ
-ڲ
-  ֵ
+函数功能：读取MPU6050内置DMP的姿态信息
+入口参数：无
+返回  值：无
 **************************************************************************/
 //void Read_DMP(void)
 //{	
@@ -395,60 +857,103 @@ Output  : none
 //		unsigned char more;
 //		long quat[4];
 
-//				dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more);		//ȡDMP
+//				dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more);		//读取DMP数据
 //				if (sensors & INV_WXYZ_QUAT )
 //				{    
 //					 q0=quat[0] / q30;
 //					 q1=quat[1] / q30;
 //					 q2=quat[2] / q30;
-//					 q3=quat[3] / q30; 		//Ԫ
-//					 Roll = asin(-2 * q1 * q3 + 2 * q0* q2)* 57.3; 	// 
-//					 Pitch = atan2(2 * q2 * q3 + 2 * q0 * q1, -2 * q1 * q1 - 2 * q2* q2 + 1)* 57.3; // 
-//					 Yaw = atan2(2*(q1*q2 + q0*q3),q0*q0+q1*q1-q2*q2-q3*q3) * 57.3;	 //ƫ
+//					 q3=quat[3] / q30; 		//四元数
+//					 Roll = asin(-2 * q1 * q3 + 2 * q0* q2)* 57.3; 	//计算出横滚角 
+//					 Pitch = atan2(2 * q2 * q3 + 2 * q0 * q1, -2 * q1 * q1 - 2 * q2* q2 + 1)* 57.3; // 计算出俯仰角
+//					 Yaw = atan2(2*(q1*q2 + q0*q3),q0*q0+q1*q1-q2*q2-q3*q3) * 57.3;	 //计算出偏航角
 //				}
 
 
 //}
 void Read_DMP(void)
 {	
-    unsigned long sensor_timestamp;
-    unsigned char more;
-    long quat[4];
+    unsigned char packets, more, i;
+    unsigned short length = dmp_get_packet_length();
+    const u32 period = 1000000UL / DEFAULT_MPU_HZ;
+    long quat[4], sample_quat[4];
+    short sample_gyro[3], sample_accel[3], sample_sensors;
+    u32 now, newest, start;
+    u8 valid = 0;
+    int res;
     
-    dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more);
-    if (sensors & INV_WXYZ_QUAT)
+    start = getCycleCnt();
+    res = dmp_read_fifo_burst(DMP_Burst_Buffer, IMU_BURST_PACKETS, &packets, &more);
+    now = getMicros();
+    IMU_Benchmark.DMP_Cycles = getCycleCnt() - start;
+    if(IMU_Benchmark.DMP_Cycles > IMU_Benchmark.DMP_Cycles_Max)
+        IMU_Benchmark.DMP_Cycles_Max = IMU_Benchmark.DMP_Cycles;
+    if(res == -2) IMU_Benchmark.DMP_Overflows++;
+    IMU_Benchmark.DMP_Packets = packets;
+    if(res || packets == 0) return;
+    //'more' packets are still queued behind the newest one read
+    //最新读出的数据包之后还积压了more个数据包
+    IMU_Benchmark.DMP_Latency_us = (more + 1) * period;
+
+    //Reconstruct sample times on the FIFO rate grid. Keep the previous
+    //timeline while it agrees with the read time, otherwise resync to it.
+    //按FIFO速率重建采样时间：与读取时间一致时沿用上次的时间轴，否则重新同步
+    newest = Last_Sample_us + packets * period;
+    if((int32_t)(now - more * period - newest) < 0 || (now - more * period - newest) > period)
+        newest = now - more * period;
+    Last_Sample_us = newest;
+
+    for(i = 0; i < packets; i++)
+    {
+        //A corrupted packet resets the FIFO, the rest of the burst is misaligned
+        //数据包损坏时FIFO已被复位，本次剩余数据不再可信
+        if(dmp_decode_packet(DMP_Burst_Buffer + i * length, sample_gyro, sample_accel, sample_quat, &sample_sensors))
+            break;
+        if(!(sample_sensors & INV_WXYZ_QUAT)) continue;
+        IMU_Ring_Push(sample_quat, sample_gyro, sample_accel, newest - (packets - 1 - i) * period);
+        memcpy(quat, sample_quat, sizeof(quat));
+        memcpy(gyro, sample_gyro, sizeof(sample_gyro));
+        memcpy(accel, sample_accel, sizeof(sample_accel));
+        sensors = sample_sensors;
+        valid = 1;
+    }
+    if (valid)
     {    
         q0 = quat[0] / q30;
         q1 = quat[1] / q30;
         q2 = quat[2] / q30;
         q3 = quat[3] / q30;
         
-        // ԭʼŷǣλȣ
-        float raw_Roll = asin(-2 * q1 * q3 + 2 * q0 * q2) * 57.3f;
-        float raw_Pitch = atan2(2 * q2 * q3 + 2 * q0 * q1, -2 * q1 * q1 - 2 * q2 * q2 + 1) * 57.3f;
-        float raw_Yaw = atan2(2*(q1*q2 + q0*q3), q0*q0+q1*q1-q2*q2-q3*q3) * 57.3f;
-				Roll = raw_Roll;
-        Pitch = raw_Pitch;
-        // === ؼ޸ === //
-        if(Deviation_Count >= CONTROL_DELAY && !angle_calibrated)
+        // 计算原始欧拉角（单位：度）
+        float raw_Roll = Fast_Asinf(-2 * q1 * q3 + 2 * q0 * q2) * 57.3f;
+        float raw_Pitch = Fast_Atan2f(2 * q2 * q3 + 2 * q0 * q1, -2 * q1 * q1 - 2 * q2 * q2 + 1) * 57.3f;
+        float raw_Yaw = Fast_Atan2f(2*(q1*q2 + q0*q3), q0*q0+q1*q1-q2*q2-q3*q3) * 57.3f;
+        DMP_Yaw = raw_Yaw;
+        // === 关键修改 === //
+        if(gyro_bias_captured && !angle_calibrated)
         {
-            // ȶ¼ʼǶȣһΣ
+            // 稳定后记录初始角度（仅一次）
 //            Initial_Roll = raw_Roll;
 //            Initial_Pitch = raw_Pitch;
             Initial_Yaw = raw_Yaw;
-            angle_calibrated = 1;  // У׼־
+            Initial_Mahony_Yaw = IMU_Mahony.Yaw_Unwrapped; // Mahony同时取零
+            angle_calibrated = 1;  // 设置校准标志
         }
+        // Mahony作为姿态来源时，Roll/Pitch/Yaw由Mahony_Sample输出
+        if(Attitude_Source != ATTITUDE_SOURCE_DMP) return;
+				Roll = raw_Roll;
+        Pitch = raw_Pitch;
         
         if(angle_calibrated)
         {
-            // ӦýǶУ׼
+            // 应用角度校准
 //            Roll = raw_Roll - Initial_Roll;
 //            Pitch = raw_Pitch - Initial_Pitch;
             Yaw = raw_Yaw - Initial_Yaw;
         }
         else
         {
-            // ʼ׶ʹԭʼֵ㣩
+            // 初始阶段使用原始值（或归零）
 //            Roll = 0;
 //            Pitch = 0;
             Yaw = 0;
@@ -459,16 +964,16 @@ void Read_DMP(void)
 Function: Read mpu6050 built-in temperature sensor data
 Input   : none
 Output  : Centigrade temperature
-ܣȡMPU6050¶ȴ
-ڲ
-  ֵ¶
+函数功能：读取MPU6050内置温度传感器数据
+入口参数：无
+返回  值：摄氏温度
 **************************************************************************/
 int Read_Temperature(void)
 {	   
 	  float Temp;
-	  Temp=(I2C_ReadOneByte(devAddr,MPU6050_RA_TEMP_OUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_TEMP_OUT_L);
-		if(Temp>32768) Temp-=65536;	//ת
-		Temp=(36.53f+Temp/340)*10;	  //¶ȷŴʮ
+	  Temp=(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_TEMP_OUT_H)<<8)+I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_TEMP_OUT_L);
+		if(Temp>32768) Temp-=65536;	//数据类型转换
+		Temp=(36.53f+Temp/340)*10;	  //温度放大十倍存放
 	  return (int)Temp;
 }
 
@@ -476,9 +981,9 @@ int Read_Temperature(void)
 Function: Initialize TIM2 as the encoder interface mode
 Input   : LPF: Digital low-pass filtering frequency (Hz)
 Output  : 0: Settings successful, others: Settings failed
-ܣMPUrobot_select_init.hֵͨ˲
-ڲlpf:ֵͨ˲Ƶ(Hz)
-  ֵ0:óɹ, :ʧ
+函数功能：设置MPUrobot_select_init.h的数字低通滤波器
+入口参数：lpf:数字低通滤波频率(Hz)
+返回  值：0:设置成功, 其他:设置失败
 **************************************************************************/
 unsigned char MPU6050_Set_LPF(u16 lpf)
 {
@@ -489,15 +994,15 @@ unsigned char MPU6050_Set_LPF(u16 lpf)
 	else if(lpf>=20)data=4;
 	else if(lpf>=10)data=5;
 	else data=6; 
-	return I2C_WriteOneByte(devAddr,MPU6050_RA_CONFIG,data); //Set the digital lowpass filter//ֵͨ˲  
+	return I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_CONFIG,data); //Set the digital lowpass filter//设置数字低通滤波器  
 }
 /**************************************************************************
 Function: Initialize TIM2 as the encoder interface mode
 Input   : rate:4~1000(Hz)
 Output  : 0: Settings successful, others: Settings failed
-ܣMPUrobot_select_init.hĲ(ٶFs=1KHz)
-ڲrate:4~1000(Hz)
-  ֵ0:óɹ, :ʧ
+函数功能：设置MPUrobot_select_init.h的采样率(假定Fs=1KHz)
+入口参数：rate:4~1000(Hz)
+返回  值：0:设置成功, 其他:设置失败
 **************************************************************************/
 unsigned char MPU6050_Set_Rate(u16 rate)
 {
@@ -505,42 +1010,42 @@ unsigned char MPU6050_Set_Rate(u16 rate)
 	if(rate>1000)rate=1000;
 	if(rate<4)rate=4;
 	data=1000/rate-1;
-	data=I2C_WriteOneByte(devAddr,MPU6050_RA_SMPLRT_DIV,data);	//Set the digital lowpass filter//ֵͨ˲  
- 	return MPU6050_Set_LPF(rate/2);	//Automatically sets LPF to half of the sampling rate //ԶLPFΪʵһ
+	data=I2C_Bus_Write_Byte(MPU6050_I2C_ADDR,MPU6050_RA_SMPLRT_DIV,data);	//Set the digital lowpass filter//设置数字低通滤波器  
+ 	return MPU6050_Set_LPF(rate/2);	//Automatically sets LPF to half of the sampling rate //自动设置LPF为采样率的一半
 }
 
 /**************************************************************************
 Function: Initialize TIM2 as the encoder interface mode
 Input   : Gx, Gy, Gz: raw readings (plus or minus) of the x,y, and z axes of the gyroscope
 Output  : 0: success, others: error code
-ܣֵ(ԭʼֵ)
+函数功能：获得陀螺仪值(原始值)
 **************************************************************************/
 //void MPU_Get_Gyroscope(void)
 //{
-//		gyro[0]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_XOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_XOUT_L);    //ȡX
-//		gyro[1]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_YOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_YOUT_L);    //ȡY
-//		gyro[2]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_ZOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_ZOUT_L);    //ȡZ
+//		gyro[0]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_XOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_XOUT_L);    //读取X轴陀螺仪
+//		gyro[1]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_YOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_YOUT_L);    //读取Y轴陀螺仪
+//		gyro[2]=(I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_ZOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_GYRO_ZOUT_L);    //读取Z轴陀螺仪
 //	
-//	if(Deviation_Count<CONTROL_DELAY) // 10 seconds before starting //ǰ10
+//	if(Deviation_Count<CONTROL_DELAY) // 10 seconds before starting //开机前10秒
 //		{
 
-//			//Led_Count=1; //LED high frequency flashing //LEDƵ˸
-//			Flag_Stop=1; //The software fails to flag location 1 //ʧܱ־λ1		
+//			//Led_Count=1; //LED high frequency flashing //LED高频闪烁
+//			Flag_Stop=1; //The software fails to flag location 1 //软件失能标志位置1		
 //		}
-//	else //10 seconds after starting //10
+//	else //10 seconds after starting //开机10秒后
 //		{  
 //			if(Deviation_Count==CONTROL_DELAY)
-//				Flag_Stop=0; //The software fails to flag location 0 //ʧܱ־λ0
-//			//Led_Count=300; //The LED returns to normal flicker frequency //LEDָ˸Ƶ	
+//				Flag_Stop=0; //The software fails to flag location 0 //软件失能标志位置0
+//			//Led_Count=300; //The LED returns to normal flicker frequency //LED恢复正常闪烁频率	
 //			
 //			//Save the raw data to update zero by clicking the user button
-//			//ԭʼڵû
+//			//保存原始数据用于单击用户按键更新零点
 //			Original_gyro[0] =gyro[0];  
 //			Original_gyro[1] =gyro[1];  
 //			Original_gyro[2]= gyro[2];			
 //			
 //			//Removes zero drift data
-//			//ȥƯƵ
+//			//去除零点漂移的数据
 //			gyro[0] =Original_gyro[0]-Deviation_gyro[0];  
 //			gyro[1] =Original_gyro[1]-Deviation_gyro[1];  
 //			gyro[2]= Original_gyro[2]-Deviation_gyro[2];
@@ -551,60 +1056,132 @@ Output  : 0: success, others: error code
 
 
 
-void MPU_Get_Gyroscope(void)
+/**************************************************************************
+Function: Report how long the IMU took to become ready
+Input   : none
+Output  : none
+函数功能：报告IMU就绪所用的时间
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void IMU_Report_Ready(void)
 {
-    // ȡԭʼ
-    int16_t raw_gyro_x = (I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_XOUT_H) << 8) + 
-                         I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_XOUT_L);
-    int16_t raw_gyro_y = (I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_YOUT_H) << 8) + 
-                         I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_YOUT_L);
-    int16_t raw_gyro_z = (I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_ZOUT_H) << 8) + 
-                         I2C_ReadOneByte(devAddr, MPU6050_RA_GYRO_ZOUT_L);
-
-    // === ǰ10У׼׶ === //
-    if (Deviation_Count < CONTROL_DELAY) 
+    static const char *const reject[] = { "-", "no record", "moving", "temperature", "bias changed", "init failed" };
+    char msg[96];
+    snprintf(msg, sizeof(msg), "[IMU] ready in %lums, %s, stored calib: %s, %d.%dC\r\n",
+             (unsigned long)IMU_Calib.Ready_ms, IMU_Calib.From_Flash ? "fast" : "full",
+             IMU_Calib.From_Flash ? "used" : reject[IMU_Calib.Reject_Reason],
+             IMU_Calib.Temperature / 10, abs(IMU_Calib.Temperature % 10));
+    usart1_send_cstring(msg);
+}
+
+/**************************************************************************
+Function: Boot time gyro zero capture and bias removal on one raw sample
+Input   : raw_gyro_x, raw_gyro_y, raw_gyro_z: raw gyro readings
+Output  : none
+函数功能：对一组原始陀螺仪数据进行开机零漂捕获和零漂去除
+入口参数：raw_gyro_x，raw_gyro_y，raw_gyro_z：陀螺仪原始值
+返回  值：无
+**************************************************************************/
+static void MPU_Gyro_Calibrate(int16_t raw_gyro_x, int16_t raw_gyro_y, int16_t raw_gyro_z)
+{
+    int16_t raw[3];
+
+    // 保存原始数据（含零漂），供Mahony滤波器在线估计零偏
+    Original_gyro[0] = raw_gyro_x;
+    Original_gyro[1] = raw_gyro_y;
+    Original_gyro[2] = raw_gyro_z;
+
+    // === 校准阶段：先用Flash中的零偏做约1秒的静止验证，失败再做完整校准 === //
+    if (!gyro_bias_captured)
     {
-        Flag_Stop = 1; // ʧܱ־λ1
+        Flag_Stop = 1; // 软件失能标志位置1
         
-        // ȫԭʼݣٶǿƹ
+        // 完全舍弃原始数据，角速度输出强制归零
         gyro[0] = 0;
         gyro[1] = 0;
         gyro[2] = 0;
+
+#if !MPU6050_BURST_READ
+        IMU_Temperature = Read_Temperature();
+#endif
+        raw[0] = raw_gyro_x;
+        raw[1] = raw_gyro_y;
+        raw[2] = raw_gyro_z;
+        if (!IMU_Calib_Update(raw, Original_accel, Car_Is_Stationary(), (int16_t)IMU_Temperature, getSysTickCnt()))
+            return;
+
+        // 零漂基准值取静止窗口的均值（仅一次）
+        Initial_Gyro_Bias[0] = IMU_Calib.Gyro_Bias[0];
+        Initial_Gyro_Bias[1] = IMU_Calib.Gyro_Bias[1];
+        Initial_Gyro_Bias[2] = IMU_Calib.Gyro_Bias[2];
+        gyro_bias_captured = 1;
+        Deviation_Count = CONTROL_DELAY;
+        Flag_Stop = 0; // 软件失能标志位置0
+        //Written later by IMU_Calib_Save_Idle, the erase must not stall this task
+        //稍后由IMU_Calib_Save_Idle写入，擦除Flash不能阻塞本任务
+        if (!IMU_Calib.From_Flash) IMU_Calib_Save_Pending = 1;
+        IMU_Report_Ready();
     }
-    // === 10ȶ׶ === //
-    else 
-    {
-        if (Deviation_Count == CONTROL_DELAY) // һνȶ
-        {
-            Flag_Stop = 0; // ʧܱ־λ0
-            
-            // һβɼΪƯ׼ֵһΣ
-            if (!gyro_bias_captured) 
-            {
-                Initial_Gyro_Bias[0] = raw_gyro_x;
-                Initial_Gyro_Bias[1] = raw_gyro_y;
-                Initial_Gyro_Bias[2] = raw_gyro_z;
-                gyro_bias_captured = 1;  
-            }
-        }
-        
-        // ӦƯУ׼ֱӼȥʼƯ׼ֵ
-        gyro[0] = raw_gyro_x - Initial_Gyro_Bias[0];  
-        gyro[1] = raw_gyro_y - Initial_Gyro_Bias[1];  
-        gyro[2] = raw_gyro_z - Initial_Gyro_Bias[2];
-    }
+    
+    // 应用零漂校准：直接减去初始零漂基准值
+    gyro[0] = raw_gyro_x - Initial_Gyro_Bias[0];  
+    gyro[1] = raw_gyro_y - Initial_Gyro_Bias[1];  
+    gyro[2] = raw_gyro_z - Initial_Gyro_Bias[2];
+}
+
+void MPU_Get_Gyroscope(void)
+{
+    // 读取原始陀螺仪数据
+    int16_t raw_gyro_x = (I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_XOUT_H) << 8) + 
+                         I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_XOUT_L);
+    int16_t raw_gyro_y = (I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_YOUT_H) << 8) + 
+                         I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_YOUT_L);
+    int16_t raw_gyro_z = (I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_ZOUT_H) << 8) + 
+                         I2C_Bus_Read_Byte(MPU6050_I2C_ADDR, MPU6050_RA_GYRO_ZOUT_L);
+
+    MPU_Gyro_Calibrate(raw_gyro_x, raw_gyro_y, raw_gyro_z);
 }
 /**************************************************************************
 Function: Initialize TIM2 as the encoder interface mode
 Input   : Gx, Gy, Gz: raw readings (plus or minus) of the x,y, and z axes of the gyroscope
 Output  : 0: success, others: error code
-ܣüٶȼֵ(ԭʼֵ)
+函数功能：获得加速度计值(原始值)
 **************************************************************************/
 void MPU_Get_Accelscope(void)
 {
-		accel[0]=(I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_XOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_XOUT_L); //ȡXٶȼ
-		accel[1]=(I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_YOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_YOUT_L); //ȡYٶȼ
-		accel[2]=(I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_ZOUT_H)<<8)+I2C_ReadOneByte(devAddr,MPU6050_RA_ACCEL_ZOUT_L); //ȡZٶȼ
+		accel[0]=(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_XOUT_H)<<8)+I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_XOUT_L); //读取X轴加速度计
+		accel[1]=(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_YOUT_H)<<8)+I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_YOUT_L); //读取Y轴加速度计
+		accel[2]=(I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_ZOUT_H)<<8)+I2C_Bus_Read_Byte(MPU6050_I2C_ADDR,MPU6050_RA_ACCEL_ZOUT_L); //读取Z轴加速度计
+		//Keep a copy for the Mahony filter //保存一份给Mahony滤波器使用
+		Original_accel[0]=accel[0];
+		Original_accel[1]=accel[1];
+		Original_accel[2]=accel[2];
+}
+
+/**************************************************************************
+Function: Read accel and gyro in one 14 byte burst (ACCEL_XOUT_H..GYRO_ZOUT_L)
+Input   : none
+Output  : 0: success; others: bus error, accel/gyro keep their last values
+函数功能：一次连续读取14字节(ACCEL_XOUT_H..GYRO_ZOUT_L)获得加速度计和陀螺仪值
+入口参数：无
+返回  值：0：成功；其他：总线错误，加速度计/陀螺仪保持上一次的值
+**************************************************************************/
+u8 MPU_Get_Motion6(void)
+{
+		if(I2C_Bus_Read(MPU6050_I2C_ADDR, MPU6050_RA_ACCEL_XOUT_H, 14, buffer)) return 1;
+		accel[0]=(short)((buffer[0]<<8)|buffer[1]);
+		accel[1]=(short)((buffer[2]<<8)|buffer[3]);
+		accel[2]=(short)((buffer[4]<<8)|buffer[5]);
+		Original_accel[0]=accel[0];
+		Original_accel[1]=accel[1];
+		Original_accel[2]=accel[2];
+		//buffer[6..7] is TEMP_OUT, 340 LSB/degC with 36.53 degC at 0 //buffer[6..7]为温度数据
+		IMU_Temperature=(int)(365.3f+(short)((buffer[6]<<8)|buffer[7])/34.0f);
+		MPU_Gyro_Calibrate((short)((buffer[8]<<8)|buffer[9]),
+		                   (short)((buffer[10]<<8)|buffer[11]),
+		                   (short)((buffer[12]<<8)|buffer[13]));
+		return 0;
 }
 
 //------------------End of File----------------------------
@@ -0,0 +1,190 @@
+#include "i2c_bus.h"
+#ifdef I2C_BUS_HOST
+#include <time.h>
+#else
+#include "I2C.h"
+#endif
+
+I2C_Bus_Stats_t I2C_Bus_Stats;
+
+#ifndef I2C_BUS_HOST
+static int BitBang_Write(uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data)
+{
+	return i2cWrite(addr, reg, len, (uint8_t *)data);
+}
+
+static int BitBang_Read(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf)
+{
+	return i2cRead(addr, reg, len, buf);
+}
+
+static void BitBang_Set_Speed(uint32_t khz)
+{
+	IIC_Set_Speed(khz);
+}
+
+const I2C_Bus_Ops I2C_BitBang_Ops = { "bitbang", BitBang_Write, BitBang_Read, BitBang_Set_Speed };
+#endif
+
+#if I2C_BUS_BACKEND == I2C_BUS_SIM
+static const I2C_Bus_Ops *Bus_Ops = &I2C_Sim_Ops;
+#else
+static const I2C_Bus_Ops *Bus_Ops = &I2C_BitBang_Ops;
+#endif
+
+/**************************************************************************
+Function: Free running tick used to time transfers
+Input   : none
+Output  : Tick count, CPU cycles on target, nanoseconds on the host
+函数功能：用于统计传输耗时的自由计数
+入口参数：无
+返回  值：计数值，目标板上为CPU周期，PC上为纳秒
+**************************************************************************/
+uint32_t I2C_Bus_Ticks(void)
+{
+#ifdef I2C_BUS_HOST
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#else
+	return getCycleCnt();
+#endif
+}
+
+uint32_t I2C_Bus_Ticks_To_us(uint32_t ticks)
+{
+#ifdef I2C_BUS_HOST
+	return ticks / 1000;
+#else
+	return CYCLES_TO_US(ticks);
+#endif
+}
+
+/**************************************************************************
+Function: Microsecond time base shared with the simulator
+Input   : none
+Output  : Microseconds
+函数功能：与模拟器共用的微秒时间基准
+入口参数：无
+返回  值：微秒
+**************************************************************************/
+uint32_t I2C_Bus_Micros(void)
+{
+#ifdef I2C_BUS_HOST
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+#else
+	return getMicros();
+#endif
+}
+
+/**************************************************************************
+Function: Switch the backend used by the IMU stack
+Input   : ops: backend, e.g. &I2C_BitBang_Ops or &I2C_Sim_Ops
+Output  : none
+函数功能：切换IMU驱动所使用的总线后端
+入口参数：ops：后端，例如&I2C_BitBang_Ops或&I2C_Sim_Ops
+返回  值：无
+**************************************************************************/
+void I2C_Bus_Select(const I2C_Bus_Ops *ops)
+{
+	if(ops != 0) Bus_Ops = ops;
+}
+
+const I2C_Bus_Ops *I2C_Bus_Current(void)
+{
+	return Bus_Ops;
+}
+
+/**************************************************************************
+Function: Change the clock rate of the current backend
+Input   : khz: SCL rate, the backend clamps it to what the bus supports
+Output  : none
+函数功能：修改当前后端的时钟速率
+入口参数：khz：SCL速率，后端会限制在总线支持的范围内
+返回  值：无
+**************************************************************************/
+void I2C_Bus_Set_Speed(uint32_t khz)
+{
+	if(Bus_Ops->Set_Speed) Bus_Ops->Set_Speed(khz);
+}
+
+static void I2C_Bus_Account(uint32_t start, uint8_t len, int res)
+{
+	uint32_t ticks = I2C_Bus_Ticks() - start;
+	I2C_Bus_Stats.Bytes += len;
+	I2C_Bus_Stats.Busy_Ticks += ticks;
+	if(ticks > I2C_Bus_Stats.Max_Ticks) I2C_Bus_Stats.Max_Ticks = ticks;
+	if(res) I2C_Bus_Stats.Errors++;
+}
+
+/**************************************************************************
+Function: Write len bytes starting at register reg
+Input   : addr: 7-bit device address; reg: first register; len: byte count; data: bytes to write
+Output  : 0: success; others: failure
+函数功能：从寄存器reg开始连续写入len个字节
+入口参数：addr：7位器件地址；reg：起始寄存器；len：字节数；data：待写数据
+返回  值：0：成功；其他：失败
+**************************************************************************/
+int I2C_Bus_Write(uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data)
+{
+	uint32_t start = I2C_Bus_Ticks();
+	int res = Bus_Ops->Write(addr, reg, len, data);
+	I2C_Bus_Stats.Writes++;
+	I2C_Bus_Account(start, len, res);
+	return res;
+}
+
+/**************************************************************************
+Function: Read len bytes starting at register reg in one transaction
+Input   : addr: 7-bit device address; reg: first register; len: byte count; buf: destination
+Output  : 0: success; others: failure
+函数功能：在一次传输中从寄存器reg开始连续读取len个字节
+入口参数：addr：7位器件地址；reg：起始寄存器；len：字节数；buf：接收缓冲区
+返回  值：0：成功；其他：失败
+**************************************************************************/
+int I2C_Bus_Read(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf)
+{
+	uint32_t start = I2C_Bus_Ticks();
+	int res = Bus_Ops->Read(addr, reg, len, buf);
+	I2C_Bus_Stats.Reads++;
+	I2C_Bus_Account(start, len, res);
+	return res;
+}
+
+int I2C_Bus_Write_Byte(uint8_t addr, uint8_t reg, uint8_t data)
+{
+	return I2C_Bus_Write(addr, reg, 1, &data);
+}
+
+uint8_t I2C_Bus_Read_Byte(uint8_t addr, uint8_t reg)
+{
+	uint8_t data = 0;
+	I2C_Bus_Read(addr, reg, 1, &data);
+	return data;
+}
+
+/**************************************************************************
+Function: Read-modify-write a bit field of a register
+Input   : addr: 7-bit device address; reg: register; bit_start: highest bit of the field;
+          length: field width; data: field value
+Output  : 0: success; others: failure
+函数功能：读-改-写寄存器中的一个位段
+入口参数：addr：7位器件地址；reg：寄存器；bit_start：位段最高位；length：位段宽度；data：位段值
+返回  值：0：成功；其他：失败
+**************************************************************************/
+int I2C_Bus_Write_Bits(uint8_t addr, uint8_t reg, uint8_t bit_start, uint8_t length, uint8_t data)
+{
+	uint8_t b, mask;
+	if(I2C_Bus_Read(addr, reg, 1, &b)) return 1;
+	mask = (uint8_t)(((1U << length) - 1) << (bit_start - length + 1));
+	data = (uint8_t)(data << (bit_start - length + 1));
+	b = (uint8_t)((b & ~mask) | (data & mask));
+	return I2C_Bus_Write(addr, reg, 1, &b);
+}
+
+int I2C_Bus_Write_Bit(uint8_t addr, uint8_t reg, uint8_t bit_num, uint8_t data)
+{
+	return I2C_Bus_Write_Bits(addr, reg, bit_num, 1, data ? 1 : 0);
+}
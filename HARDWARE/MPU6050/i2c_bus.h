@@ -0,0 +1,59 @@
+#ifndef __I2C_BUS_H
+#define __I2C_BUS_H
+#include <stdint.h>
+
+//Bus backends //总线后端
+#define I2C_BUS_BITBANG		0     //PB10/PB11 bit-bang driver in I2C.c //I2C.c中的PB10/PB11软件模拟I2C
+#define I2C_BUS_SIM			1     //Register model of the MPU6050 in mpu6050_sim.c //mpu6050_sim.c中的MPU6050寄存器模型
+
+//Backend used after reset. Build with -DI2C_BUS_HOST to compile the bus
+//layer and the simulator on a PC, the simulator is then the only backend.
+//上电后使用的后端。以-DI2C_BUS_HOST编译时可在PC上运行总线层和模拟器，此时只有模拟器后端
+#ifndef I2C_BUS_BACKEND
+#ifdef I2C_BUS_HOST
+#define I2C_BUS_BACKEND		I2C_BUS_SIM
+#else
+#define I2C_BUS_BACKEND		I2C_BUS_BITBANG
+#endif
+#endif
+
+//Register level transfer functions, 7-bit device address, return 0 on success
+//寄存器级传输函数，7位器件地址，成功返回0
+typedef struct
+{
+	const char *Name;
+	int (*Write)(uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data);
+	int (*Read)(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf);
+	void (*Set_Speed)(uint32_t khz);    //Optional, 0 if the backend has no timing //可选，后端无时序时为0
+}I2C_Bus_Ops;
+
+//Traffic and timing of every transfer through I2C_Bus_Read/I2C_Bus_Write
+//经过I2C_Bus_Read/I2C_Bus_Write的所有传输的流量与耗时统计
+typedef struct
+{
+	uint32_t Reads;           //Read transactions //读传输次数
+	uint32_t Writes;          //Write transactions //写传输次数
+	uint32_t Bytes;           //Payload bytes //数据字节数
+	uint32_t Errors;          //Transfers the backend reported as failed //失败的传输次数
+	uint32_t Busy_Ticks;      //Time spent in the backend, see I2C_Bus_Ticks_To_us //后端耗时
+	uint32_t Max_Ticks;       //Longest single transfer //单次传输最长耗时
+}I2C_Bus_Stats_t;
+
+extern const I2C_Bus_Ops I2C_BitBang_Ops;
+extern const I2C_Bus_Ops I2C_Sim_Ops;
+extern I2C_Bus_Stats_t I2C_Bus_Stats;
+
+void I2C_Bus_Select(const I2C_Bus_Ops *ops);
+const I2C_Bus_Ops *I2C_Bus_Current(void);
+void I2C_Bus_Set_Speed(uint32_t khz);
+int I2C_Bus_Write(uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data);
+int I2C_Bus_Read(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf);
+int I2C_Bus_Write_Byte(uint8_t addr, uint8_t reg, uint8_t data);
+uint8_t I2C_Bus_Read_Byte(uint8_t addr, uint8_t reg);
+int I2C_Bus_Write_Bits(uint8_t addr, uint8_t reg, uint8_t bit_start, uint8_t length, uint8_t data);
+int I2C_Bus_Write_Bit(uint8_t addr, uint8_t reg, uint8_t bit_num, uint8_t data);
+uint32_t I2C_Bus_Ticks(void);
+uint32_t I2C_Bus_Ticks_To_us(uint32_t ticks);
+uint32_t I2C_Bus_Micros(void);
+
+#endif
@@ -0,0 +1,273 @@
+#include "imu_calib.h"
+#include "stm32f4xx_hal.h"
+#include "inv_mpu.h"
+#include <string.h>
+
+IMU_Calib_t IMU_Calib;
+IMU_Calib_Record IMU_Calib_Stored;
+uint8_t IMU_Calib_Stored_Valid = 0;
+static uint32_t Calib_Next_Addr = IMU_CALIB_FLASH_ADDR;   //First free slot in the sector //扇区中第一个空闲位置
+static int32_t  Pending_DMP_Gyro[3], Pending_DMP_Accel[3];
+static uint8_t  Pending_DMP_Valid = 0;
+
+static uint8_t Calib_Record_Ok(const IMU_Calib_Record *r)
+{
+	return r->Magic == IMU_CALIB_MAGIC && r->Version == IMU_CALIB_VERSION &&
+	       r->Size == sizeof(IMU_Calib_Record) &&
+	       r->Crc == mpu_crc32(0, (const uint8_t *)r, sizeof(IMU_Calib_Record) - 4);
+}
+
+/**************************************************************************
+Function: Find the newest valid calibration record in flash
+Input   : none
+Output  : none
+函数功能：在Flash中查找最新的有效校准记录
+入口参数：无
+返回  值：无
+**************************************************************************/
+void IMU_Calib_Load(void)
+{
+	uint32_t addr;
+	const IMU_Calib_Record *r;
+
+	IMU_Calib_Stored_Valid = 0;
+	for(addr = IMU_CALIB_FLASH_ADDR; addr + sizeof(IMU_Calib_Record) <= IMU_CALIB_FLASH_ADDR + IMU_CALIB_FLASH_SIZE;
+	    addr += sizeof(IMU_Calib_Record))
+	{
+		r = (const IMU_Calib_Record *)addr;
+		if(r->Magic == 0xFFFFFFFFUL) break;   //Erased, end of the log //已擦除，记录结束
+		if(Calib_Record_Ok(r))
+		{
+			IMU_Calib_Stored = *r;
+			IMU_Calib_Stored_Valid = 1;
+		}
+	}
+	Calib_Next_Addr = addr;
+
+	memset(&IMU_Calib, 0, sizeof(IMU_Calib));
+	IMU_Calib.State = IMU_Calib_Stored_Valid ? IMU_CALIB_FAST_CHECK : IMU_CALIB_FULL;
+	IMU_Calib.Reject_Reason = IMU_Calib_Stored_Valid ? IMU_CALIB_REJECT_NONE : IMU_CALIB_REJECT_NO_RECORD;
+}
+
+/**************************************************************************
+Function: Skip the check of the stored record and run a full calibration
+Input   : reason: IMU_CALIB_REJECT_xxx
+Output  : none
+函数功能：跳过保存记录的验证，直接进行完整校准
+入口参数：reason：IMU_CALIB_REJECT_xxx
+返回  值：无
+**************************************************************************/
+void IMU_Calib_Reject(uint8_t reason)
+{
+	if(IMU_Calib.State != IMU_CALIB_FAST_CHECK) return;
+	IMU_Calib.State = IMU_CALIB_FULL;
+	IMU_Calib.Reject_Reason = reason;
+}
+
+/**************************************************************************
+Function: Remember the biases run_self_test pushed to the DMP, saved with the next record
+Input   : gyro, accel: biases in the format of dmp_set_gyro_bias/dmp_set_accel_bias
+Output  : none
+函数功能：记录run_self_test写入DMP的零偏，随下一条记录一起保存
+入口参数：gyro，accel：dmp_set_gyro_bias/dmp_set_accel_bias格式的零偏
+返回  值：无
+**************************************************************************/
+void IMU_Calib_Set_DMP_Bias(const long gyro[3], const long accel[3])
+{
+	uint8_t i;
+	for(i = 0; i < 3; i++)
+	{
+		Pending_DMP_Gyro[i] = (int32_t)gyro[i];
+		Pending_DMP_Accel[i] = (int32_t)accel[i];
+	}
+	Pending_DMP_Valid = 1;
+}
+
+static void Calib_Window_Reset(uint32_t now_ms)
+{
+	uint8_t i;
+	for(i = 0; i < 3; i++)
+	{
+		IMU_Calib.Sum_Gyro[i] = 0;
+		IMU_Calib.Sum_Accel[i] = 0;
+		IMU_Calib.Min_Gyro[i] = 32767;
+		IMU_Calib.Max_Gyro[i] = -32768;
+	}
+	IMU_Calib.Samples = 0;
+	IMU_Calib.Window_Still = 1;
+	IMU_Calib.Window_ms = now_ms;
+}
+
+static void Calib_Window_Add(const int16_t raw_gyro[3], const int16_t raw_accel[3], uint8_t stationary)
+{
+	uint8_t i;
+	for(i = 0; i < 3; i++)
+	{
+		IMU_Calib.Sum_Gyro[i] += raw_gyro[i];
+		IMU_Calib.Sum_Accel[i] += raw_accel[i];
+		if(raw_gyro[i] < IMU_Calib.Min_Gyro[i]) IMU_Calib.Min_Gyro[i] = raw_gyro[i];
+		if(raw_gyro[i] > IMU_Calib.Max_Gyro[i]) IMU_Calib.Max_Gyro[i] = raw_gyro[i];
+		if(IMU_Calib.Max_Gyro[i] - IMU_Calib.Min_Gyro[i] > IMU_CALIB_STILL_P2P) IMU_Calib.Window_Still = 0;
+	}
+	if(!stationary) IMU_Calib.Window_Still = 0;
+	IMU_Calib.Samples++;
+}
+
+//Rounded mean of the window //窗口均值(四舍五入)
+static int16_t Calib_Mean(int32_t sum)
+{
+	int32_t n = (int32_t)IMU_Calib.Samples;
+	return (int16_t)(sum >= 0 ? (sum + n / 2) / n : (sum - n / 2) / n);
+}
+
+static int32_t Calib_Abs(int32_t v)
+{
+	return v < 0 ? -v : v;
+}
+
+static void Calib_Finish(uint8_t from_flash, uint32_t now_ms)
+{
+	uint8_t i;
+	for(i = 0; i < 3; i++) IMU_Calib.Gyro_Bias[i] = Calib_Mean(IMU_Calib.Sum_Gyro[i]);
+	IMU_Calib.From_Flash = from_flash;
+	IMU_Calib.Ready_ms = now_ms;
+	IMU_Calib.State = IMU_CALIB_READY;
+}
+
+/**************************************************************************
+Function: Feed one raw sample to the boot calibration
+Input   : raw_gyro, raw_accel: raw readings; stationary: 1 if the wheels are stopped;
+          temperature: 0.1 degC; now_ms: system time
+Output  : 1: gyro bias is ready in IMU_Calib.Gyro_Bias; 0: still calibrating
+函数功能：向开机校准输入一组原始数据
+入口参数：raw_gyro，raw_accel：原始数据；stationary：车轮停止时为1；temperature：0.1摄氏度；now_ms：系统时间
+返回  值：1：陀螺仪零偏已就绪，见IMU_Calib.Gyro_Bias；0：仍在校准
+**************************************************************************/
+uint8_t IMU_Calib_Update(const int16_t raw_gyro[3], const int16_t raw_accel[3],
+                         uint8_t stationary, int16_t temperature, uint32_t now_ms)
+{
+	uint8_t i;
+
+	if(IMU_Calib.State == IMU_CALIB_READY) return 1;
+	//IMU_Calib_Load has not run, there is nothing to compare with //IMU_Calib_Load未运行，没有可比较的记录
+	if(!IMU_Calib_Stored_Valid) IMU_Calib_Reject(IMU_CALIB_REJECT_NO_RECORD);
+	if(IMU_Calib.Start_ms == 0)
+	{
+		IMU_Calib.Start_ms = now_ms ? now_ms : 1;
+		Calib_Window_Reset(now_ms);
+	}
+	IMU_Calib.Temperature = temperature;
+	Calib_Window_Add(raw_gyro, raw_accel, stationary);
+
+	if(IMU_Calib.State == IMU_CALIB_FAST_CHECK)
+	{
+		if(now_ms - IMU_Calib.Window_ms < IMU_CALIB_CHECK_MS) return 0;
+
+		//The window mean is a fresh bias estimate, the stored one validates it
+		//窗口均值即为当前零偏估计，用保存值对其进行验证
+		if(!IMU_Calib.Window_Still)
+			IMU_Calib.Reject_Reason = IMU_CALIB_REJECT_MOVING;
+		else if(Calib_Abs((int32_t)temperature - IMU_Calib_Stored.Temperature) > IMU_CALIB_TEMP_TOL)
+			IMU_Calib.Reject_Reason = IMU_CALIB_REJECT_TEMP;
+		else
+		{
+			for(i = 0; i < 3; i++)
+				if(Calib_Abs((int32_t)Calib_Mean(IMU_Calib.Sum_Gyro[i]) - IMU_Calib_Stored.Gyro_Bias[i]) > IMU_CALIB_BIAS_TOL)
+					IMU_Calib.Reject_Reason = IMU_CALIB_REJECT_BIAS;
+		}
+		if(IMU_Calib.Reject_Reason == IMU_CALIB_REJECT_NONE)
+		{
+			Calib_Finish(1, now_ms);
+			return 1;
+		}
+		IMU_Calib.State = IMU_CALIB_FULL;
+		Calib_Window_Reset(now_ms);
+		return 0;
+	}
+
+	//Full calibration: only the last still window before the deadline counts,
+	//and the deadline moves on while the car is being handled
+	//完整校准：只统计截止前最后一段静止窗口，小车被移动时截止时间顺延
+	if(now_ms - IMU_Calib.Start_ms < IMU_CALIB_FULL_MS - IMU_CALIB_AVERAGE_MS)
+	{
+		Calib_Window_Reset(now_ms);
+		return 0;
+	}
+	if(!IMU_Calib.Window_Still)
+	{
+		Calib_Window_Reset(now_ms);
+		return 0;
+	}
+	if(now_ms - IMU_Calib.Window_ms < IMU_CALIB_AVERAGE_MS) return 0;
+	Calib_Finish(0, now_ms);
+	return 1;
+}
+
+/**************************************************************************
+Function: Append the result of a full calibration to flash, with the motors at rest
+Input   : none
+Output  : 0: success; others: HAL error
+函数功能：将完整校准的结果追加写入Flash，需在电机停止时调用
+入口参数：无
+返回  值：0：成功；其他：HAL错误
+**************************************************************************/
+int IMU_Calib_Save(void)
+{
+	IMU_Calib_Record r;
+	FLASH_EraseInitTypeDef erase;
+	uint32_t sector_error, i;
+	const uint32_t *words = (const uint32_t *)&r;
+	HAL_StatusTypeDef res = HAL_OK;
+
+	memset(&r, 0, sizeof(r));
+	r.Magic = IMU_CALIB_MAGIC;
+	r.Version = IMU_CALIB_VERSION;
+	r.Size = sizeof(r);
+	for(i = 0; i < 3; i++)
+	{
+		r.Gyro_Bias[i] = IMU_Calib.Gyro_Bias[i];
+		r.Accel_Still[i] = Calib_Mean(IMU_Calib.Sum_Accel[i]);
+	}
+	//Keep the DMP biases of an earlier boot if this one's self test failed
+	//本次自检未通过时沿用之前保存的DMP零偏
+	if(Pending_DMP_Valid)
+	{
+		memcpy(r.DMP_Gyro_Bias, Pending_DMP_Gyro, sizeof(r.DMP_Gyro_Bias));
+		memcpy(r.DMP_Accel_Bias, Pending_DMP_Accel, sizeof(r.DMP_Accel_Bias));
+		r.DMP_Bias_Valid = 1;
+	}
+	else if(IMU_Calib_Stored_Valid && IMU_Calib_Stored.DMP_Bias_Valid)
+	{
+		memcpy(r.DMP_Gyro_Bias, IMU_Calib_Stored.DMP_Gyro_Bias, sizeof(r.DMP_Gyro_Bias));
+		memcpy(r.DMP_Accel_Bias, IMU_Calib_Stored.DMP_Accel_Bias, sizeof(r.DMP_Accel_Bias));
+		r.DMP_Bias_Valid = 1;
+	}
+	r.Temperature = IMU_Calib.Temperature;
+	r.Sequence = IMU_Calib_Stored_Valid ? IMU_Calib_Stored.Sequence + 1 : 1;
+	r.Uptime_ms = IMU_Calib.Ready_ms;
+	r.Crc = mpu_crc32(0, (const uint8_t *)&r, sizeof(r) - 4);
+
+	HAL_FLASH_Unlock();
+	//Erase only when the log is full, the CPU stalls for the whole sector erase
+	//仅在记录写满时擦除，整个扇区擦除期间CPU会停顿
+	if(Calib_Next_Addr + sizeof(r) > IMU_CALIB_FLASH_ADDR + IMU_CALIB_FLASH_SIZE)
+	{
+		erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+		erase.Sector = FLASH_SECTOR_7;
+		erase.NbSectors = 1;
+		erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+		res = HAL_FLASHEx_Erase(&erase, &sector_error);
+		Calib_Next_Addr = IMU_CALIB_FLASH_ADDR;
+	}
+	for(i = 0; res == HAL_OK && i < sizeof(r) / 4; i++)
+		res = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, Calib_Next_Addr + i * 4, words[i]);
+	HAL_FLASH_Lock();
+	//A half written slot fails its CRC, never program it twice
+	//写了一半的位置CRC校验不通过，不能再次写入
+	Calib_Next_Addr += sizeof(r);
+	if(res != HAL_OK) return (int)res;
+
+	IMU_Calib_Stored = r;
+	IMU_Calib_Stored_Valid = 1;
+	return 0;
+}
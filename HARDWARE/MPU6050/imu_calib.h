@@ -0,0 +1,81 @@
+#ifndef __IMU_CALIB_H
+#define __IMU_CALIB_H
+#include <stdint.h>
+
+//Calibration records are appended to the last flash sector. The linker
+//region in the project stops at 0x08060000 so code never lands there.
+//校准记录追加写入最后一个Flash扇区。工程中链接区域止于0x08060000，代码不会占用该扇区
+#define IMU_CALIB_FLASH_ADDR      0x08060000UL
+#define IMU_CALIB_FLASH_SIZE      0x20000UL      //Sector 7, 128KB //扇区7，128KB
+#define IMU_CALIB_MAGIC           0x494D5543UL   //"IMUC"
+#define IMU_CALIB_VERSION         1
+
+//Boot stationarity check that validates the stored biases
+//开机静止检测，用于验证已保存的零偏
+#define IMU_CALIB_CHECK_MS        1000           //Length of the check window //检测窗口长度
+#define IMU_CALIB_STILL_P2P       30             //Max gyro peak to peak while still, raw LSB //静止时陀螺仪最大峰峰值，原始LSB
+#define IMU_CALIB_BIAS_TOL        12             //Max difference to the stored gyro bias, raw LSB //与保存零偏的最大差值，原始LSB
+#define IMU_CALIB_TEMP_TOL        100            //Max temperature change, 0.1 degC //最大温度变化，0.1摄氏度
+
+//Full calibration, same 15 s hold off as the original CONTROL_DELAY wait
+//完整校准，与原CONTROL_DELAY等待相同的15秒
+#define IMU_CALIB_FULL_MS         15000
+#define IMU_CALIB_AVERAGE_MS      2000           //Bias is the mean of the last still window //零偏取最后一段静止窗口的均值
+
+//Calibration state //校准状态
+#define IMU_CALIB_FAST_CHECK      0
+#define IMU_CALIB_FULL            1
+#define IMU_CALIB_READY           2
+
+//Why the stored record was not used //未使用保存记录的原因
+#define IMU_CALIB_REJECT_NONE     0
+#define IMU_CALIB_REJECT_NO_RECORD 1
+#define IMU_CALIB_REJECT_MOVING   2
+#define IMU_CALIB_REJECT_TEMP     3
+#define IMU_CALIB_REJECT_BIAS     4
+#define IMU_CALIB_REJECT_INIT     5              //mpu_init failed //mpu_init失败
+
+//One flash record, a multiple of 4 bytes //一条Flash记录，长度为4字节的整数倍
+typedef struct
+{
+	uint32_t Magic;
+	uint16_t Version;
+	uint16_t Size;
+	int16_t  Gyro_Bias[3];         //Raw LSB at the configured gyro range //当前陀螺仪量程下的原始LSB
+	int16_t  Accel_Still[3];       //Raw accel while still, raw LSB //静止时加速度计原始值
+	int32_t  DMP_Gyro_Bias[3];     //Biases pushed to the DMP by run_self_test //run_self_test写入DMP的零偏
+	int32_t  DMP_Accel_Bias[3];
+	int16_t  Temperature;          //0.1 degC, Read_Temperature format //0.1摄氏度，与Read_Temperature格式相同
+	uint8_t  DMP_Bias_Valid;
+	uint8_t  Reserved;
+	uint32_t Sequence;             //Incremented on every save //每次保存加1
+	uint32_t Uptime_ms;            //Time since boot at save, the board has no RTC //保存时的开机时间，板上没有RTC
+	uint32_t Crc;                  //CRC32 of all fields above //以上所有字段的CRC32
+}IMU_Calib_Record;
+
+typedef struct
+{
+	uint8_t  State;
+	uint8_t  Reject_Reason;
+	uint8_t  From_Flash;           //1: stored record accepted //1：采用了保存的记录
+	uint8_t  Window_Still;         //0 once the current window saw motion //当前窗口内出现运动后为0
+	uint32_t Start_ms, Window_ms, Ready_ms;
+	int32_t  Sum_Gyro[3], Sum_Accel[3];
+	uint32_t Samples;
+	int16_t  Min_Gyro[3], Max_Gyro[3];
+	int16_t  Gyro_Bias[3];         //Result, valid in IMU_CALIB_READY //结果，IMU_CALIB_READY时有效
+	int16_t  Temperature;
+}IMU_Calib_t;
+
+extern IMU_Calib_t IMU_Calib;
+extern IMU_Calib_Record IMU_Calib_Stored;
+extern uint8_t IMU_Calib_Stored_Valid;
+
+void IMU_Calib_Load(void);
+void IMU_Calib_Reject(uint8_t reason);
+void IMU_Calib_Set_DMP_Bias(const long gyro[3], const long accel[3]);
+uint8_t IMU_Calib_Update(const int16_t raw_gyro[3], const int16_t raw_accel[3],
+                         uint8_t stationary, int16_t temperature, uint32_t now_ms);
+int IMU_Calib_Save(void);
+
+#endif
@@ -0,0 +1,168 @@
+#include "mahony.h"
+#include "fast_math.h"
+#include <math.h>
+#include "float_only.h"
+
+/**************************************************************************
+Function: Initialize a Mahony filter instance
+Input   : f: filter instance; kp, ki: accelerometer correction gains
+Output  : none
+函数功能：初始化Mahony滤波器实例
+入口参数：f：滤波器实例；kp，ki：加速度计修正增益
+返回  值：无
+**************************************************************************/
+void Mahony_Init(Mahony_Filter *f, float kp, float ki)
+{
+	f->q0 = 1.0f; f->q1 = 0.0f; f->q2 = 0.0f; f->q3 = 0.0f;
+	f->Kp = kp;
+	f->Ki = ki;
+	f->integral_x = f->integral_y = f->integral_z = 0.0f;
+	f->bias_x = f->bias_y = f->bias_z = 0.0f;
+	f->Roll = f->Pitch = f->Yaw = 0.0f;
+	f->Yaw_Unwrapped = 0.0f;
+	f->Timestamp_us = 0;
+	f->Stationary_Count = 0;
+	f->Bias_Valid = 0;
+}
+
+/**************************************************************************
+Function: Learn the gyro bias while the car is standing still
+Input   : f: filter instance; gx, gy, gz: raw angular rate, rad/s; stationary: 1 if the wheels are stopped
+Output  : none
+函数功能：小车静止时在线学习陀螺仪零偏
+入口参数：f：滤波器实例；gx，gy，gz：原始角速度，rad/s；stationary：车轮停止时为1
+返回  值：无
+**************************************************************************/
+static void Mahony_Update_Bias(Mahony_Filter *f, float gx, float gy, float gz, uint8_t stationary)
+{
+	float alpha;
+
+	//Wheels stopped is not enough, the car may be lifted or pushed
+	//仅车轮静止还不够，小车可能被拿起或推动
+	if(stationary && f->Bias_Valid)
+	{
+		if(fabsf(gx - f->bias_x) > MAHONY_BIAS_RATE_GATE ||
+		   fabsf(gy - f->bias_y) > MAHONY_BIAS_RATE_GATE ||
+		   fabsf(gz - f->bias_z) > MAHONY_BIAS_RATE_GATE)
+			stationary = 0;
+	}
+	if(!stationary)
+	{
+		f->Stationary_Count = 0;
+		return;
+	}
+
+	f->Stationary_Count++;
+	//Average quickly until the first estimate has settled, then track slowly
+	//首次收敛前快速平均，收敛后缓慢跟踪
+	if(!f->Bias_Valid)
+	{
+		alpha = 1.0f / (float)f->Stationary_Count;
+		if(f->Stationary_Count >= MAHONY_BIAS_SETTLE) f->Bias_Valid = 1;
+	}
+	else alpha = MAHONY_BIAS_ALPHA;
+
+	f->bias_x += alpha * (gx - f->bias_x);
+	f->bias_y += alpha * (gy - f->bias_y);
+	f->bias_z += alpha * (gz - f->bias_z);
+}
+
+/**************************************************************************
+Function: One Mahony filter step on raw gyro/accel data
+Input   : f: filter instance; gx, gy, gz: angular rate, rad/s; ax, ay, az: acceleration, any unit;
+          dt: sample period, s; stationary: 1 if the wheels are stopped; timestamp_us: sample time
+Output  : none
+函数功能：用原始陀螺仪/加速度计数据执行一次Mahony滤波
+入口参数：f：滤波器实例；gx，gy，gz：角速度，rad/s；ax，ay，az：加速度，单位任意；
+          dt：采样周期，秒；stationary：车轮停止时为1；timestamp_us：采样时间
+返回  值：无
+**************************************************************************/
+void Mahony_Update(Mahony_Filter *f, float gx, float gy, float gz,
+                   float ax, float ay, float az, float dt, uint8_t stationary, uint32_t timestamp_us)
+{
+	float recip_norm;
+	float halfvx, halfvy, halfvz;
+	float halfex, halfey, halfez;
+	float qa, qb, qc, sinp, yaw, delta;
+
+	Mahony_Update_Bias(f, gx, gy, gz, stationary);
+	gx -= f->bias_x;
+	gy -= f->bias_y;
+	gz -= f->bias_z;
+
+	//Only correct with the accelerometer when it holds a valid measurement
+	//加速度计数据有效时才进行修正
+	if(!((ax == 0.0f) && (ay == 0.0f) && (az == 0.0f)))
+	{
+		recip_norm = 1.0f / Fast_Sqrtf(ax * ax + ay * ay + az * az);
+		ax *= recip_norm;
+		ay *= recip_norm;
+		az *= recip_norm;
+
+		//Estimated direction of gravity //估计的重力方向
+		halfvx = f->q1 * f->q3 - f->q0 * f->q2;
+		halfvy = f->q0 * f->q1 + f->q2 * f->q3;
+		halfvz = f->q0 * f->q0 - 0.5f + f->q3 * f->q3;
+
+		//Error is the cross product between estimated and measured gravity
+		//误差为估计重力与测量重力的叉积
+		halfex = (ay * halfvz - az * halfvy);
+		halfey = (az * halfvx - ax * halfvz);
+		halfez = (ax * halfvy - ay * halfvx);
+
+		if(f->Ki > 0.0f)
+		{
+			f->integral_x += 2.0f * f->Ki * halfex * dt;
+			f->integral_y += 2.0f * f->Ki * halfey * dt;
+			f->integral_z += 2.0f * f->Ki * halfez * dt;
+			gx += f->integral_x;
+			gy += f->integral_y;
+			gz += f->integral_z;
+		}
+		else
+		{
+			f->integral_x = f->integral_y = f->integral_z = 0.0f;
+		}
+
+		gx += 2.0f * f->Kp * halfex;
+		gy += 2.0f * f->Kp * halfey;
+		gz += 2.0f * f->Kp * halfez;
+	}
+
+	//Integrate the quaternion rate of change //积分四元数变化率
+	gx *= 0.5f * dt;
+	gy *= 0.5f * dt;
+	gz *= 0.5f * dt;
+	qa = f->q0;
+	qb = f->q1;
+	qc = f->q2;
+	f->q0 += (-qb * gx - qc * gy - f->q3 * gz);
+	f->q1 += (qa * gx + qc * gz - f->q3 * gy);
+	f->q2 += (qa * gy - qb * gz + f->q3 * gx);
+	f->q3 += (qa * gz + qb * gy - qc * gx);
+
+	recip_norm = 1.0f / Fast_Sqrtf(f->q0 * f->q0 + f->q1 * f->q1 + f->q2 * f->q2 + f->q3 * f->q3);
+	f->q0 *= recip_norm;
+	f->q1 *= recip_norm;
+	f->q2 *= recip_norm;
+	f->q3 *= recip_norm;
+
+	//Same Euler convention as Read_DMP //与Read_DMP相同的欧拉角定义
+	sinp = -2.0f * f->q1 * f->q3 + 2.0f * f->q0 * f->q2;
+	if(sinp > 1.0f) sinp = 1.0f;
+	else if(sinp < -1.0f) sinp = -1.0f;
+	f->Roll  = Fast_Asinf(sinp) * 57.3f;
+	f->Pitch = Fast_Atan2f(2.0f * f->q2 * f->q3 + 2.0f * f->q0 * f->q1,
+	                       -2.0f * f->q1 * f->q1 - 2.0f * f->q2 * f->q2 + 1.0f) * 57.3f;
+	yaw = Fast_Atan2f(2.0f * (f->q1 * f->q2 + f->q0 * f->q3),
+	                  f->q0 * f->q0 + f->q1 * f->q1 - f->q2 * f->q2 - f->q3 * f->q3) * 57.3f;
+
+	//Unwrap the yaw so consumers never see the +-180 jump
+	//展开偏航角，避免±180度跳变
+	delta = yaw - f->Yaw;
+	if(delta > 180.0f) delta -= 360.0f;
+	else if(delta < -180.0f) delta += 360.0f;
+	f->Yaw_Unwrapped += delta;
+	f->Yaw = yaw;
+	f->Timestamp_us = timestamp_us;
+}
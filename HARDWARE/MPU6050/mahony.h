@@ -0,0 +1,39 @@
+#ifndef __MAHONY_H
+#define __MAHONY_H
+#include <stdint.h>
+
+//Default gains of the accelerometer correction
+//加速度计修正的默认增益
+#define MAHONY_KP_DEFAULT        1.0f
+#define MAHONY_KI_DEFAULT        0.0f
+
+//Gyro bias is only learned when the body rate is below this gate (rad/s)
+//只有角速度低于该门限(rad/s)时才学习陀螺仪零偏
+#define MAHONY_BIAS_RATE_GATE    0.05f
+//First order low pass coefficient of the online bias estimate
+//在线零偏估计的一阶低通系数
+#define MAHONY_BIAS_ALPHA        0.01f
+//Stationary samples required before the bias is trusted
+//零偏可信之前需要的静止样本数
+#define MAHONY_BIAS_SETTLE       100
+
+//Mahony complementary filter state, one instance per IMU
+//Mahony互补滤波器状态，每个IMU一个实例
+typedef struct
+{
+	float q0, q1, q2, q3;                   //Attitude quaternion //姿态四元数
+	float Kp, Ki;                           //Accelerometer correction gains //加速度计修正增益
+	float integral_x, integral_y, integral_z;
+	float bias_x, bias_y, bias_z;           //Online gyro bias, rad/s //在线估计的陀螺仪零偏，rad/s
+	float Roll, Pitch, Yaw;                 //Euler angles, degree //欧拉角，度
+	float Yaw_Unwrapped;                    //Continuous yaw without the +-180 jump, degree //无±180跳变的连续偏航角，度
+	uint32_t Timestamp_us;                  //Sample time of the last update //最近一次更新的采样时间
+	uint32_t Stationary_Count;              //Consecutive stationary samples //连续静止样本数
+	uint8_t  Bias_Valid;                    //1: bias has settled //1：零偏已收敛
+}Mahony_Filter;
+
+void Mahony_Init(Mahony_Filter *f, float kp, float ki);
+void Mahony_Update(Mahony_Filter *f, float gx, float gy, float gz,
+                   float ax, float ay, float az, float dt, uint8_t stationary, uint32_t timestamp_us);
+
+#endif
@@ -5,7 +5,10 @@
 #include "inv_mpu_dmp_motion_driver.h"
 #include "dmpKey.h"
 #include "dmpmap.h"
+#include "mahony.h"
 #define devAddr  0xD0
+//7-bit address used on the I2C_Bus_* interface //I2C_Bus_*接口使用的7位地址
+#define MPU6050_I2C_ADDR  (devAddr>>1)
 
 #define MPU6050_ADDRESS_AD0_LOW     0x68 // address pin low (GND), default for InvenSense evaluation board
 #define MPU6050_ADDRESS_AD0_HIGH    0x69 // address pin high (VCC)
@@ -358,7 +361,78 @@
 #define MPU6050_WHO_AM_I_LENGTH     6
 
 #define MPU6050_TASK_PRIO		3    
-#define MPU6050_STK_SIZE 		256  
+#define MPU6050_STK_SIZE 		256
+//The task samples raw gyro/accel at this rate, the DMP path keeps running at 50Hz
+//任务以该频率采样原始陀螺仪/加速度计，DMP读取仍以50Hz运行
+#define MPU6050_TASK_RATE		RATE_200_HZ
+
+//1: wake the task on the MPU6050 INT pin (call MPU6050_INT_Handler from the EXTI callback)
+//0: poll the DMP FIFO count every task cycle
+//1：由MPU6050 INT引脚唤醒任务(需在EXTI回调中调用MPU6050_INT_Handler)；0：每个任务周期轮询FIFO计数
+#define MPU6050_USE_INT_PIN		0
+
+//DMP samples kept for consumers that must not touch the I2C bus
+//缓存的DMP样本，供不访问I2C总线的模块读取
+#define IMU_RING_SIZE			32     //Must be a power of 2 //必须为2的幂
+#define IMU_BURST_PACKETS		7      //Max DMP packets drained per I2C burst (7*32 bytes) //每次I2C连续读取的最大数据包数
+
+typedef struct
+{
+	float q[4];               //Attitude quaternion //姿态四元数
+	short gyro[3];            //Calibrated gyro, hardware units //校准后的陀螺仪数据，原始单位
+	short accel[3];           //Raw accel, hardware units //原始加速度数据
+	u32 Timestamp_us;         //Reconstructed sample time //重建的采样时间
+	u32 Seq;                  //Sample sequence number //样本序号
+}IMU_Sample;
+
+#define IMU_SEQ_WRITING			0xFFFFFFFFu   //Seq of a slot being written //正在写入的槽位的Seq
+
+//1: read accel+gyro in one 14 byte burst; 0: twelve single byte reads (for comparison)
+//1：一次连续读取14字节加速度计和陀螺仪数据；0：12次单字节读取(用于对比)
+#define MPU6050_BURST_READ		1
+
+//Which estimator publishes Roll/Pitch/Yaw
+//选择由哪个姿态解算结果输出Roll/Pitch/Yaw
+#define ATTITUDE_SOURCE_DMP		0
+#define ATTITUDE_SOURCE_MAHONY	1
+
+//1: print the DMP/Mahony comparison over USART1 every 5 s
+//1：每5秒通过串口1打印DMP/Mahony对比数据
+#define IMU_BENCHMARK_PRINT		0
+
+//DMP vs Mahony latency and drift figures, readable from the debugger
+//DMP与Mahony的延迟和漂移对比数据，可在调试器中查看
+typedef struct
+{
+	u32 Mahony_Cycles;        //CPU cycles of the last Mahony step //最近一次Mahony计算耗时(周期)
+	u32 Mahony_Cycles_Max;
+	u32 Mahony_Latency_us;    //Register read to yaw published //从读寄存器到输出偏航角的延迟
+	u32 DMP_Cycles;           //CPU cycles of the last Read_DMP, I2C included //最近一次Read_DMP耗时(含I2C)
+	u32 DMP_Cycles_Max;
+	u32 DMP_Latency_us;       //Age of the DMP packet, from the FIFO backlog //DMP数据包的滞后时间(由FIFO积压估算)
+	u32 DMP_Packets;          //Packets drained by the last burst //最近一次连续读取的数据包数
+	u32 DMP_Overflows;        //FIFO overflow resets //FIFO溢出复位次数
+	u32 I2C_Transactions;     //I2C transactions of the last task cycle //最近一个任务周期的I2C传输次数
+	u32 I2C_Busy_us;          //I2C bus time of the last task cycle //最近一个任务周期的I2C占用时间
+	u32 I2C_Busy_us_Max;
+	float DMP_Drift_dpm;      //Yaw drift while stationary, degree/min //静止时偏航角漂移，度/分钟
+	float Mahony_Drift_dpm;
+}IMU_Benchmark_t;
+
+//Where DMP_Init spent its time, readable from the debugger
+//DMP_Init各阶段耗时，可在调试器中查看
+typedef struct
+{
+	u32 Init_us;              //mpu_init or mpu_init_warm //mpu_init或mpu_init_warm耗时
+	u32 Firmware_us;          //Upload and CRC check, or the warm signature check //固件下载与CRC校验，或热启动签名校验
+	u32 Config_us;            //Orientation, features, FIFO rate //方向、功能、FIFO速率配置
+	u32 Self_Test_us;
+	u32 Total_us;
+	u16 Bus_khz;              //Bus rate the upload verified at //固件校验通过时的总线速率
+	u8  Warm;                 //1: DMP image kept across an MCU reset //1：MCU复位后沿用了DMP固件
+	u8  Upload_Tries;
+}IMU_Boot_Timing_t;
+  
 
 extern	short gyro[3], accel[3];
 extern int Deviation_Count;
@@ -367,25 +441,37 @@ extern  short Deviation_accel[3],Original_accel[3];
 extern int16_t Gx_offset,Gy_offset,Gz_offset;
 extern float Acc1G_Values;
 extern float Roll,Pitch,Yaw; 
-extern uint8_t gyro_bias_captured;    // Ư׼ֵǷѲ־
+extern uint8_t gyro_bias_captured;    // 零漂基准值是否已捕获标志
 extern uint8_t angle_calibrated;
-//ⲿõAPI
-u8 MPU6050_initialize(void); //ʼ
-uint8_t MPU6050_testConnection(void); //MPU6050Ƿ
-//ȡADCֵ
+extern u8 Attitude_Source;
+extern Mahony_Filter IMU_Mahony;
+extern float DMP_Yaw;
+extern IMU_Benchmark_t IMU_Benchmark;
+extern IMU_Boot_Timing_t IMU_Boot_Timing;
+extern float Yaw_Rate;
+//供外部调用的API
+u8 MPU6050_initialize(void); //初始化
+uint8_t MPU6050_testConnection(void); //检测MPU6050是否存在
+//读取ADC值
 void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
 void MPU6050_getlastMotion6(int16_t* ax, int16_t* ay, 
 		int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
-uint8_t MPU6050_getDeviceID(void); //ȡMPU6050ID
-void MPU6050_InitGyro_Offset(void);//ʼƫ
+uint8_t MPU6050_getDeviceID(void); //读取MPU6050的ID
+void MPU6050_InitGyro_Offset(void);//初始化陀螺仪偏置
 void DMP_Init(void);
 void Read_DMP(void);
+u8 IMU_Get_Latest(IMU_Sample *out);
+void IMU_Get_Gyro_Yaw(float *angle_deg, u32 *timestamp_us);
+u32 IMU_Read_Samples(u32 *cursor, IMU_Sample *out, u32 max);
+void MPU6050_INT_Handler(void);
+void IMU_Calib_Save_Idle(void);
 int Read_Temperature(void);
 void MPU6050_task(void *pvParameters);
 unsigned char MPU6050_Set_LPF(u16 lpf);
 unsigned char MPU6050_Set_Rate(u16 rate);
 void MPU_Get_Gyroscope(void);
 void MPU_Get_Accelscope(void);
+u8 MPU_Get_Motion6(void);
 
 #endif
 
@@ -0,0 +1,343 @@
+#include "mpu6050_sim.h"
+#include "i2c_bus.h"
+#include <string.h>
+#include <math.h>
+
+//Registers the model gives a meaning to //模型中有特殊行为的寄存器
+#define SIM_SMPLRT_DIV      0x19
+#define SIM_FIFO_EN         0x23
+#define SIM_INT_STATUS      0x3A
+#define SIM_ACCEL_XOUT_H    0x3B
+#define SIM_TEMP_OUT_H      0x41
+#define SIM_GYRO_XOUT_H     0x43
+#define SIM_USER_CTRL       0x6A
+#define SIM_PWR_MGMT_1      0x6B
+#define SIM_BANK_SEL        0x6D
+#define SIM_MEM_START_ADDR  0x6E
+#define SIM_MEM_R_W         0x6F
+#define SIM_PRGM_START_H    0x70
+#define SIM_FIFO_COUNT_H    0x72
+#define SIM_FIFO_COUNT_L    0x73
+#define SIM_FIFO_R_W        0x74
+#define SIM_WHO_AM_I        0x75
+
+#define SIM_BIT_RESET       0x80
+#define SIM_BIT_SLEEP       0x40
+#define SIM_BIT_DMP_EN      0x80
+#define SIM_BIT_FIFO_EN     0x40
+#define SIM_BIT_DMP_RST     0x08
+#define SIM_BIT_FIFO_RST    0x04
+#define SIM_BIT_FIFO_OVF    0x10
+#define SIM_BIT_DATA_RDY    0x01
+
+//Gyro full scale of the DMP configuration, LSB per degree/s //DMP配置下陀螺仪量程，LSB/(度/秒)
+#define SIM_GYRO_SENS       16.4f
+
+MPU6050_Sim_Stats_t MPU6050_Sim_Stats;
+
+static struct
+{
+	uint8_t  Reg[128];
+	uint8_t  Mem[MPU6050_SIM_MEM_SIZE];
+	uint8_t  Fifo[MPU6050_SIM_FIFO_SIZE];
+	uint16_t Fifo_Head, Fifo_Count;
+	uint16_t Mem_Addr;
+	uint32_t Last_us, Carry_us;
+	int16_t  Accel[3], Gyro[3];
+	float    Yaw;                 //Heading integrated from Gyro[2], rad //由Gyro[2]积分的航向，rad
+	uint8_t  Started;
+}Sim;
+
+static void Sim_Power_On(void)
+{
+	memset(Sim.Reg, 0, sizeof(Sim.Reg));
+	memset(Sim.Mem, 0, sizeof(Sim.Mem));
+	Sim.Reg[SIM_WHO_AM_I] = MPU6050_SIM_ADDR;
+	Sim.Reg[SIM_PWR_MGMT_1] = SIM_BIT_SLEEP;
+	//Accel offset registers carry the silicon revision mpu_init checks, rev 1 here
+	//加速度偏移寄存器中带有mpu_init检查的芯片版本号，这里为版本1
+	Sim.Reg[0x07] = 0x01;
+	Sim.Reg[0x09] = 0x00;
+	Sim.Reg[0x0B] = 0x00;
+	Sim.Fifo_Head = Sim.Fifo_Count = 0;
+	Sim.Mem_Addr = 0;
+	Sim.Carry_us = 0;
+	Sim.Yaw = 0.0f;
+	Sim.Last_us = I2C_Bus_Micros();
+}
+
+/**************************************************************************
+Function: Power cycle the simulated chip and restore a level, still car
+Input   : none
+Output  : none
+函数功能：模拟芯片重新上电，恢复为水平静止状态
+入口参数：无
+返回  值：无
+**************************************************************************/
+void MPU6050_Sim_Reset(void)
+{
+	static const int16_t accel[3] = { 0, 0, 16384 };  //1 g at +-2 g full scale //±2g量程下的1g
+	static const int16_t gyro[3]  = { 3, -2, 5 };     //Small bias like a real part //与真实芯片类似的小零偏
+	memset(&MPU6050_Sim_Stats, 0, sizeof(MPU6050_Sim_Stats));
+	Sim_Power_On();
+	MPU6050_Sim_Set_Motion(accel, gyro);
+	Sim.Started = 1;
+}
+
+/**************************************************************************
+Function: Set the raw accelerometer and gyroscope readings of the model
+Input   : accel, gyro: raw values in chip LSB, x/y/z
+Output  : none
+函数功能：设置模型的加速度计和陀螺仪原始读数
+入口参数：accel，gyro：芯片LSB单位的原始值，x/y/z
+返回  值：无
+**************************************************************************/
+void MPU6050_Sim_Set_Motion(const int16_t accel[3], const int16_t gyro[3])
+{
+	memcpy(Sim.Accel, accel, sizeof(Sim.Accel));
+	memcpy(Sim.Gyro, gyro, sizeof(Sim.Gyro));
+}
+
+/**************************************************************************
+Function: Copy the chip state out and back in, so a host harness can restart
+          the firmware while the chip stays powered
+Input   : buf: state buffer; size: its size in bytes
+Output  : Save: bytes copied, 0 if buf is too small; Restore: 0: success, -1: size mismatch
+函数功能：导出和恢复芯片状态，使PC测试程序可以在芯片保持上电时重启固件
+入口参数：buf：状态缓冲区；size：缓冲区字节数
+返回  值：Save：复制的字节数，缓冲区不足时为0；Restore：0：成功，-1：大小不符
+**************************************************************************/
+uint32_t MPU6050_Sim_Save(void *buf, uint32_t size)
+{
+	if(size < sizeof(Sim)) return 0;
+	memcpy(buf, &Sim, sizeof(Sim));
+	return sizeof(Sim);
+}
+
+int MPU6050_Sim_Restore(const void *buf, uint32_t size)
+{
+	if(size != sizeof(Sim)) return -1;
+	memcpy(&Sim, buf, sizeof(Sim));
+	return 0;
+}
+
+const uint8_t *MPU6050_Sim_Memory(void)
+{
+	return Sim.Mem;
+}
+
+static void Sim_Put16(uint8_t *p, int16_t v)
+{
+	p[0] = (uint8_t)((uint16_t)v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static void Sim_Put32(uint8_t *p, int32_t v)
+{
+	p[0] = (uint8_t)((uint32_t)v >> 24);
+	p[1] = (uint8_t)((uint32_t)v >> 16);
+	p[2] = (uint8_t)((uint32_t)v >> 8);
+	p[3] = (uint8_t)v;
+}
+
+static void Sim_Fifo_Push(const uint8_t *data, uint16_t len)
+{
+	uint16_t i, tail;
+	if(Sim.Fifo_Count + len > MPU6050_SIM_FIFO_SIZE)
+	{
+		//The chip stops accepting data and raises the overflow flag
+		//芯片停止写入数据并置位溢出标志
+		Sim.Reg[SIM_INT_STATUS] |= SIM_BIT_FIFO_OVF;
+		MPU6050_Sim_Stats.Fifo_Overflows++;
+		return;
+	}
+	tail = (uint16_t)((Sim.Fifo_Head + Sim.Fifo_Count) % MPU6050_SIM_FIFO_SIZE);
+	for(i = 0; i < len; i++)
+	{
+		Sim.Fifo[tail] = data[i];
+		tail = (uint16_t)((tail + 1) % MPU6050_SIM_FIFO_SIZE);
+	}
+	Sim.Fifo_Count += len;
+	MPU6050_Sim_Stats.Fifo_Bytes += len;
+}
+
+static uint8_t Sim_Fifo_Pop(void)
+{
+	uint8_t b;
+	if(Sim.Fifo_Count == 0) return 0;
+	b = Sim.Fifo[Sim.Fifo_Head];
+	Sim.Fifo_Head = (uint16_t)((Sim.Fifo_Head + 1) % MPU6050_SIM_FIFO_SIZE);
+	Sim.Fifo_Count--;
+	return b;
+}
+
+//One DMP packet: Q30 quaternion, raw accel, calibrated gyro, gesture word
+//一个DMP数据包：Q30四元数、原始加速度、校准后的陀螺仪、手势字
+static void Sim_Push_Dmp_Packet(float dt)
+{
+	uint8_t pkt[MPU6050_SIM_DMP_PACKET];
+	float half;
+	memset(pkt, 0, sizeof(pkt));
+	Sim.Yaw += (float)Sim.Gyro[2] / SIM_GYRO_SENS * 0.0174533f * dt;
+	half = 0.5f * Sim.Yaw;
+	Sim_Put32(&pkt[0],  (int32_t)(cosf(half) * 1073741824.0f));
+	Sim_Put32(&pkt[12], (int32_t)(sinf(half) * 1073741824.0f));
+	Sim_Put16(&pkt[16], Sim.Accel[0]);
+	Sim_Put16(&pkt[18], Sim.Accel[1]);
+	Sim_Put16(&pkt[20], Sim.Accel[2]);
+	Sim_Put16(&pkt[22], Sim.Gyro[0]);
+	Sim_Put16(&pkt[24], Sim.Gyro[1]);
+	Sim_Put16(&pkt[26], Sim.Gyro[2]);
+	Sim_Fifo_Push(pkt, sizeof(pkt));
+}
+
+//Sensor samples selected by FIFO_EN, in the order the chip writes them
+//FIFO_EN选中的传感器数据，按芯片写入的顺序
+static void Sim_Push_Sensor_Sample(void)
+{
+	uint8_t pkt[14], len = 0, en = Sim.Reg[SIM_FIFO_EN];
+	if(en & 0x08) { Sim_Put16(&pkt[len], Sim.Accel[0]); Sim_Put16(&pkt[len + 2], Sim.Accel[1]); Sim_Put16(&pkt[len + 4], Sim.Accel[2]); len += 6; }
+	if(en & 0x80) { Sim_Put16(&pkt[len], 0); len += 2; }
+	if(en & 0x40) { Sim_Put16(&pkt[len], Sim.Gyro[0]); len += 2; }
+	if(en & 0x20) { Sim_Put16(&pkt[len], Sim.Gyro[1]); len += 2; }
+	if(en & 0x10) { Sim_Put16(&pkt[len], Sim.Gyro[2]); len += 2; }
+	if(len) Sim_Fifo_Push(pkt, len);
+}
+
+/**************************************************************************
+Function: Produce the samples the chip would have written since the last access
+Input   : none
+Output  : none
+函数功能：补齐自上次访问以来芯片应写入FIFO的样本
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void Sim_Advance(void)
+{
+	uint32_t now = I2C_Bus_Micros(), elapsed, period;
+	uint8_t user = Sim.Reg[SIM_USER_CTRL];
+
+	elapsed = now - Sim.Last_us;
+	Sim.Last_us = now;
+	if(Sim.Reg[SIM_PWR_MGMT_1] & SIM_BIT_SLEEP) { Sim.Carry_us = 0; return; }
+
+	//Internal sample rate is 1 kHz divided by 1+SMPLRT_DIV //内部采样率为1kHz/(1+SMPLRT_DIV)
+	period = 1000U * (1U + Sim.Reg[SIM_SMPLRT_DIV]);
+	Sim.Carry_us += elapsed;
+	if(Sim.Carry_us > 1000000U) Sim.Carry_us = 1000000U;   //Host paused, drop the backlog //主机暂停过，丢弃积压
+	while(Sim.Carry_us >= period)
+	{
+		Sim.Carry_us -= period;
+		Sim.Reg[SIM_INT_STATUS] |= SIM_BIT_DATA_RDY;
+		if(!(user & SIM_BIT_FIFO_EN)) continue;
+		if(user & SIM_BIT_DMP_EN) Sim_Push_Dmp_Packet((float)period * 1e-6f);
+		else Sim_Push_Sensor_Sample();
+	}
+}
+
+static uint8_t Sim_Read_Reg(uint8_t reg)
+{
+	uint8_t b;
+	switch(reg)
+	{
+		case SIM_FIFO_COUNT_H: return (uint8_t)(Sim.Fifo_Count >> 8);
+		case SIM_FIFO_COUNT_L: return (uint8_t)Sim.Fifo_Count;
+		case SIM_FIFO_R_W:     return Sim_Fifo_Pop();
+		case SIM_MEM_R_W:
+			b = Sim.Mem[Sim.Mem_Addr];
+			Sim.Mem_Addr = (uint16_t)((Sim.Mem_Addr + 1) % MPU6050_SIM_MEM_SIZE);
+			return b;
+		case SIM_INT_STATUS:
+			//Cleared on read //读清零
+			b = Sim.Reg[SIM_INT_STATUS];
+			Sim.Reg[SIM_INT_STATUS] = 0;
+			return b;
+		default: break;
+	}
+	if(reg >= SIM_ACCEL_XOUT_H && reg < SIM_ACCEL_XOUT_H + 6)
+		return (uint8_t)((uint16_t)Sim.Accel[(reg - SIM_ACCEL_XOUT_H) >> 1] >> (((reg - SIM_ACCEL_XOUT_H) & 1) ? 0 : 8));
+	if(reg == SIM_TEMP_OUT_H || reg == SIM_TEMP_OUT_H + 1)
+		return 0;   //36.53 degC //36.53摄氏度
+	if(reg >= SIM_GYRO_XOUT_H && reg < SIM_GYRO_XOUT_H + 6)
+		return (uint8_t)((uint16_t)Sim.Gyro[(reg - SIM_GYRO_XOUT_H) >> 1] >> (((reg - SIM_GYRO_XOUT_H) & 1) ? 0 : 8));
+	return Sim.Reg[reg & 0x7F];
+}
+
+static void Sim_Write_Reg(uint8_t reg, uint8_t data)
+{
+	switch(reg)
+	{
+		case SIM_PWR_MGMT_1:
+			if(data & SIM_BIT_RESET)
+			{
+				//A device reset also wipes the DMP memory and the FIFO
+				//器件复位同时清除DMP内存和FIFO
+				Sim_Power_On();
+				MPU6050_Sim_Stats.Resets++;
+				return;
+			}
+			break;
+		case SIM_USER_CTRL:
+			if(data & SIM_BIT_FIFO_RST) { Sim.Fifo_Head = Sim.Fifo_Count = 0; Sim.Carry_us = 0; }
+			data &= (uint8_t)~(SIM_BIT_FIFO_RST | SIM_BIT_DMP_RST);   //Self clearing bits //自清零位
+			break;
+		case SIM_BANK_SEL:
+			Sim.Mem_Addr = (uint16_t)(((uint16_t)data << 8 | (Sim.Mem_Addr & 0xFF)) % MPU6050_SIM_MEM_SIZE);
+			break;
+		case SIM_MEM_START_ADDR:
+			Sim.Mem_Addr = (uint16_t)((Sim.Mem_Addr & 0xFF00) | data);
+			break;
+		case SIM_MEM_R_W:
+			Sim.Mem[Sim.Mem_Addr] = data;
+			Sim.Mem_Addr = (uint16_t)((Sim.Mem_Addr + 1) % MPU6050_SIM_MEM_SIZE);
+			MPU6050_Sim_Stats.Mem_Writes++;
+			return;
+		case SIM_FIFO_R_W:
+		case SIM_FIFO_COUNT_H:
+		case SIM_FIFO_COUNT_L:
+		case SIM_INT_STATUS:
+		case SIM_WHO_AM_I:
+			return;   //Read only for the host //对主机只读
+		default: break;
+	}
+	Sim.Reg[reg & 0x7F] = data;
+}
+
+//Multi-byte transfers auto increment the register address, except on the
+//FIFO and DMP memory ports which stream through a single address
+//多字节传输自动递增寄存器地址，FIFO和DMP内存端口除外
+static uint8_t Sim_Next_Reg(uint8_t reg)
+{
+	if(reg == SIM_FIFO_R_W || reg == SIM_MEM_R_W) return reg;
+	return (uint8_t)((reg + 1) & 0x7F);
+}
+
+static int Sim_Write(uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data)
+{
+	uint8_t i;
+	if(!Sim.Started) MPU6050_Sim_Reset();
+	if(addr != MPU6050_SIM_ADDR) { MPU6050_Sim_Stats.Nacks++; return -1; }
+	Sim_Advance();
+	for(i = 0; i < len; i++)
+	{
+		Sim_Write_Reg(reg, data[i]);
+		reg = Sim_Next_Reg(reg);
+	}
+	return 0;
+}
+
+static int Sim_Read(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf)
+{
+	uint8_t i;
+	if(!Sim.Started) MPU6050_Sim_Reset();
+	if(addr != MPU6050_SIM_ADDR) { MPU6050_Sim_Stats.Nacks++; return -1; }
+	Sim_Advance();
+	for(i = 0; i < len; i++)
+	{
+		buf[i] = Sim_Read_Reg(reg);
+		reg = Sim_Next_Reg(reg);
+	}
+	return 0;
+}
+
+const I2C_Bus_Ops I2C_Sim_Ops = { "sim", Sim_Write, Sim_Read, 0 };
@@ -0,0 +1,33 @@
+#ifndef __MPU6050_SIM_H
+#define __MPU6050_SIM_H
+#include <stdint.h>
+
+//Register model of an MPU6050 behind the I2C_Sim_Ops bus backend. It answers
+//the traffic of mpu_init, the DMP firmware upload and the FIFO reads, so the
+//IMU stack can run without the chip, on a bare board or on a PC.
+//MPU6050寄存器模型，挂在I2C_Sim_Ops总线后端上。它响应mpu_init、DMP固件下载和FIFO读取，
+//使IMU驱动可以脱离芯片运行在空板或PC上
+#define MPU6050_SIM_ADDR        0x68    //7-bit address the model answers to //模型响应的7位地址
+#define MPU6050_SIM_MEM_SIZE    4096    //DMP memory, 16 banks of 256 bytes //DMP内存，16个256字节的bank
+#define MPU6050_SIM_FIFO_SIZE   1024    //Same depth as the chip //与芯片相同的深度
+#define MPU6050_SIM_DMP_PACKET  32      //Quaternion+accel+gyro+gesture, the layout DMP_Init configures //DMP_Init配置的数据包格式
+
+//Model counters, useful to check what the driver did //模型计数，用于检查驱动的行为
+typedef struct
+{
+	uint32_t Resets;          //Device resets through PWR_MGMT_1 //通过PWR_MGMT_1复位的次数
+	uint32_t Mem_Writes;      //Bytes written to DMP memory //写入DMP内存的字节数
+	uint32_t Fifo_Bytes;      //Bytes pushed into the FIFO //压入FIFO的字节数
+	uint32_t Fifo_Overflows;  //FIFO overflows //FIFO溢出次数
+	uint32_t Nacks;           //Transfers to an address nobody answers //无应答地址的传输次数
+}MPU6050_Sim_Stats_t;
+
+extern MPU6050_Sim_Stats_t MPU6050_Sim_Stats;
+
+void MPU6050_Sim_Reset(void);
+void MPU6050_Sim_Set_Motion(const int16_t accel[3], const int16_t gyro[3]);
+uint32_t MPU6050_Sim_Save(void *buf, uint32_t size);
+int MPU6050_Sim_Restore(const void *buf, uint32_t size);
+const uint8_t *MPU6050_Sim_Memory(void);
+
+#endif
@@ -2,8 +2,8 @@
 #define __ADC_H	
 //#include "sys.h"
 #include "system.h"
-#define Battery_Ch    8 //Battery voltage, ADC channel 14 //صѹADCͨ14
-#define Potentiometer 9  //Potentiometer, ADC channel 8 //λADCͨ8
+#define Battery_Ch    8 //Battery voltage, ADC channel 14 //电池电压，ADC通道14
+#define Potentiometer 9  //Potentiometer, ADC channel 8 //电位器，ADC通道8
 
 #define ADC_STK_SIZE   512 
 #define ADC_TASK_PRIO  5
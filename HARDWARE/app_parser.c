@@ -0,0 +1,306 @@
+#include "app_parser.h"
+#include "usartx.h"
+#include "autotune.h"
+#include "formation_control.h"
+#include "collision_avoid.h"
+#include "num_parse.h"
+
+App_Parser_Stats_t App_Parser_Stats;
+
+//Ring written by the USART2 interrupt only, read by the parser task only
+//环形缓冲区只由串口2中断写入，只由解析任务读取
+static volatile u8 App_Rx_Ring[APP_RX_RING_SIZE];
+static volatile u16 App_Rx_Head, App_Rx_Tail;
+
+static TaskHandle_t App_Parser_Handle = NULL;
+static QueueHandle_t App_Command_Queue = NULL;
+
+//Parser state //解析状态
+#define APP_STATE_KEY     0      //Single bytes of the remote control page //遥控页单字节
+#define APP_STATE_TARGET  1      //Inside [x,y,yaw] //在[x,y,yaw]中
+#define APP_STATE_BRACE   2      //Inside {...} //在{...}中
+#define APP_BRACE_MAX     48
+
+/**************************************************************************
+Function: Create the command queue and the parser task
+Input   : none
+Output  : none
+函数功能：创建指令队列和解析任务
+入口参数：无
+返回  值：无
+**************************************************************************/
+void App_Parser_Start(void)
+{
+	if(App_Command_Queue != NULL) return;
+	App_Command_Queue = xQueueCreate(APP_CMD_QUEUE_LEN, sizeof(App_Command_t));
+	if(App_Command_Queue == NULL)
+	{
+		usart1_send_cstring("[APP串口] 创建指令队列失败\r\n");
+		return;
+	}
+	//Out of FreeRTOS heap: no command is parsed, the ring fills and the ISR counts overflows
+	//FreeRTOS堆不足：不解析任何指令，接收缓冲区写满后中断计为溢出
+	if(xTaskCreate(App_Parser_Task, "app_parser_task", APP_PARSER_STK_SIZE, NULL, APP_PARSER_TASK_PRIO, NULL) != pdPASS)
+	{
+		vQueueDelete(App_Command_Queue);
+		App_Command_Queue = NULL;
+		usart1_send_cstring("[APP串口] 创建解析任务失败\r\n");
+	}
+}
+
+/**************************************************************************
+Function: Store one received byte and wake the parser, called from the USART2 receive callback
+Input   : byte: received byte
+Output  : none
+函数功能：保存一个接收字节并唤醒解析任务，在串口2接收回调中调用
+入口参数：byte：接收到的字节
+返回  值：无
+**************************************************************************/
+void App_Rx_Byte_ISR(u8 byte)
+{
+	BaseType_t woken = pdFALSE;
+	u16 next = (App_Rx_Head + 1) & (APP_RX_RING_SIZE - 1);
+
+	App_Parser_Stats.Bytes++;
+	if(next == App_Rx_Tail)
+	{
+		App_Parser_Stats.Overflows++;
+		return;
+	}
+	App_Rx_Ring[App_Rx_Head] = byte;
+	App_Rx_Head = next;     //Published after the byte is stored //字节写入后再更新写指针
+
+	if(App_Parser_Handle == NULL) return;
+	vTaskNotifyGiveFromISR(App_Parser_Handle, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void App_Command_Send(App_Command_t *c)
+{
+	if(xQueueSend(App_Command_Queue, c, 0) == pdPASS) App_Parser_Stats.Commands++;
+	else App_Parser_Stats.Dropped++;
+}
+
+/**************************************************************************
+Function: Decode the body of {...}: "k:digits" or "k:P", "#..." is ignored
+Input   : body: text between the braces; len: its length
+Output  : none
+函数功能：解码{...}中的内容："k:数字"或"k:P"，忽略"#..."
+入口参数：body：花括号之间的文本；len：长度
+返回  值：无
+**************************************************************************/
+static void App_Parse_Brace(const char *body, u8 len)
+{
+	App_Command_t c = { APP_CMD_PARAM };
+	float data = 0.0f;
+	u8 k;
+
+	if(len < 2) return;
+	if(len > 2 && body[2] == 'P')
+	{
+		c.Type = APP_CMD_PARAM_QUERY;
+		App_Command_Send(&c);
+		return;
+	}
+
+	//The APP's bulk parameter frame was never applied, it stays ignored
+	//APP的批量参数帧原先不处理，保持忽略
+	if(body[0] == '#') return;
+
+	//Decimal digits after "k:" //"k:"之后的十进制数字
+	for(k = 2; k < len; k++)
+		if(body[k] >= '0' && body[k] <= '9') data = data * 10.0f + (float)(body[k] - '0');
+	if(body[0] < '0' || body[0] >= '0' + APP_PARAM_KEYS) return;
+	c.Key = body[0] - '0';
+	c.Value[0] = data;
+	App_Command_Send(&c);
+}
+
+/**************************************************************************
+Function: Parser task: turn the received bytes into commands
+Input   : pvParameters: unused
+Output  : none
+函数功能：解析任务：把接收到的字节转换为指令
+入口参数：pvParameters：未使用
+返回  值：无
+**************************************************************************/
+void App_Parser_Task(void *pvParameters)
+{
+	char field[APP_FIELD_MAX + 1], brace[APP_BRACE_MAX];
+	u8 state = APP_STATE_KEY, field_len = 0, brace_len = 0, axis = 0;
+	App_Command_t target = { APP_CMD_TARGET };
+	TickType_t last_report = xTaskGetTickCount();
+	u32 reported_bytes = 0;
+
+	App_Parser_Handle = xTaskGetCurrentTaskHandle();
+
+	while(1)
+	{
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+		while(App_Rx_Tail != App_Rx_Head)
+		{
+			u8 b = App_Rx_Ring[App_Rx_Tail];
+			App_Rx_Tail = (App_Rx_Tail + 1) & (APP_RX_RING_SIZE - 1);
+
+			//'[' and '{' always start a new command //'['和'{'总是开始新指令
+			if(b == '[')
+			{
+				state = APP_STATE_TARGET;
+				axis = field_len = 0;
+				continue;
+			}
+			if(b == '{' && state != APP_STATE_TARGET)
+			{
+				state = APP_STATE_BRACE;
+				brace_len = 0;
+				continue;
+			}
+
+			if(state == APP_STATE_TARGET)
+			{
+				if((b == ',' && axis < 2) || (b == ']' && axis == 2))
+				{
+					//An empty or malformed field reads as 0 like atof did //空字段或格式错误时为0，与atof相同
+					Num_Cursor_t cur;
+					float v = 0.0f;
+
+					Num_Cursor_Init(&cur, field, field_len);
+					Num_Float(&cur, &v);
+					target.Value[axis++] = v;
+					field_len = 0;
+					if(b == ']')
+					{
+						App_Command_Send(&target);
+						state = APP_STATE_KEY;
+					}
+				}
+				else if(field_len < APP_FIELD_MAX && (b == '.' || b == '-' || b == '+' || (b >= '0' && b <= '9')))
+					field[field_len++] = b;
+			}
+			else if(state == APP_STATE_BRACE)
+			{
+				if(b == '}')
+				{
+					App_Parse_Brace(brace, brace_len);
+					state = APP_STATE_KEY;
+				}
+				else if(brace_len < APP_BRACE_MAX) brace[brace_len++] = b;
+				else state = APP_STATE_KEY;     //Too long, not a command //过长，不是指令
+			}
+			else
+			{
+				App_Command_t c = { APP_CMD_KEY, b };
+				App_Command_Send(&c);
+			}
+		}
+
+		//Receive statistics every 10 s while bytes arrive //有数据时每10秒输出一次接收统计
+		if(xTaskGetTickCount() - last_report >= pdMS_TO_TICKS(10000) && App_Parser_Stats.Bytes != reported_bytes)
+		{
+			char msg[128];
+			last_report = xTaskGetTickCount();
+			reported_bytes = App_Parser_Stats.Bytes;
+			snprintf(msg, sizeof(msg), "[APP串口] 字节%lu 溢出%lu 指令%lu 丢弃%lu 中断最长%lu周期\r\n",
+			         (unsigned long)App_Parser_Stats.Bytes, (unsigned long)App_Parser_Stats.Overflows,
+			         (unsigned long)App_Parser_Stats.Commands, (unsigned long)App_Parser_Stats.Dropped,
+			         (unsigned long)App_Parser_Stats.Isr_Cycles_Max);
+			usart1_send_cstring(msg);
+		}
+	}
+}
+
+/**************************************************************************
+Function: Apply one command to the control globals
+Input   : c: command
+Output  : none
+函数功能：把一条指令应用到控制相关全局变量
+入口参数：c：指令
+返回  值：无
+**************************************************************************/
+static void App_Command_Apply(const App_Command_t *c)
+{
+	static u8 Last_Key;
+	u8 key = c->Key;
+
+	switch(c->Type)
+	{
+		case APP_CMD_TARGET:
+			Target_position[0] = c->Value[0];
+			Target_position[1] = c->Value[1];
+			Target_Yaw = c->Value[2];
+			newCoordinateReceived = 1; // 设置新坐标标志
+			Auto_mode = 1;             // 进入自动模式
+			break;
+
+		case APP_CMD_PARAM_QUERY:
+			PID_Send = 1;
+			break;
+
+		case APP_CMD_PARAM:
+			switch(key)
+			{
+				case 0: RC_Velocity = c->Value[0]; break;
+				case 1: Velocity_KP = c->Value[0]; break;
+				case 2: Velocity_KI = c->Value[0]; break;
+				case 3: Autotune_Request((u8)c->Value[0] / 10, (u8)c->Value[0] % 10); break; // {3:LR}：L回路，R规则，{3:0}中止
+				case 4: Formation_Controller = (u8)c->Value[0]; break;     // {4:0}编队MPC，{4:1}原PD控制
+				case 5: Collision_Avoid.Enable = (u8)c->Value[0]; break;   // {5:1}开启车间避碰，{5:0}关闭
+				default: break;
+			}
+			if(RC_Velocity < 0) RC_Velocity = 0;
+			break;
+
+		case APP_CMD_KEY:
+			if(key == 0x41 && Last_Key == 0x41 && APP_ON_Flag == 0) APP_ON_Flag = 1;
+
+			// 接收到任何蓝牙控制指令（方向A-H/1-8、速度X/Y、界面I/J/K、转向C/G）时退出自动模式
+			if((key >= 0x41 && key <= 0x48) || key <= 8 || key == 0x58 || key == 0x59 ||
+			   key == 0x4B || key == 0x49 || key == 0x4A || key == 0x43 || key == 0x47)
+			{
+				Auto_mode = 0;    // 退出自动模式，切换到手动模式
+				APP_ON_Flag = 1;  // 确保手动模式使能
+			}
+			Last_Key = key;
+
+			if(key == 0x4B) Turn_Flag = 1;
+			else if(key == 0x49 || key == 0x4A) Turn_Flag = 0;
+
+			if(Turn_Flag == 0)
+			{
+				if(key >= 0x41 && key <= 0x48) Flag_Direction = key - 0x40;
+				else if(key <= 8) Flag_Direction = key;
+				else Flag_Direction = 0;
+			}
+			else if(Turn_Flag == 1)
+			{
+				if(key == 0x43) Flag_Left = 0, Flag_Right = 1;
+				else if(key == 0x47) Flag_Left = 1, Flag_Right = 0;
+				else Flag_Left = 0, Flag_Right = 0;
+
+				if(key == 0x41 || key == 0x45) Flag_Direction = key - 0x40;
+				else Flag_Direction = 0;
+			}
+
+			if(key == 0x58) RC_Velocity = RC_Velocity + 50;
+			if(key == 0x59) RC_Velocity = RC_Velocity - 50;
+			if(RC_Velocity < 0) RC_Velocity = 0;
+			break;
+	}
+}
+
+/**************************************************************************
+Function: Apply the queued APP commands, called by Balance_task before the control law
+Input   : none
+Output  : none
+函数功能：执行队列中的APP指令，由Balance_task在控制计算之前调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void App_Command_Poll(void)
+{
+	App_Command_t c;
+
+	if(App_Command_Queue == NULL) return;
+	while(xQueueReceive(App_Command_Queue, &c, 0) == pdPASS) App_Command_Apply(&c);
+}
@@ -0,0 +1,55 @@
+#ifndef __APP_PARSER_H
+#define __APP_PARSER_H
+#include "system.h"
+#include "queue.h"
+
+//Bluetooth APP protocol on USART2. The receive interrupt only stores the
+//byte in a single producer/single consumer ring and wakes the parser task.
+//The task turns the three grammars of the APP into typed commands:
+//  [x,y,yaw]          target point, enters the automatic mode
+//  {k:digits} {k:P}   set parameter k / ask for the parameters
+//  {#...}             ignored, as in the former receive interrupt
+//  any other byte     direction or mode key of the remote control page
+//Balance_task applies the queued commands at the start of its cycle, so the
+//control globals only change between two control cycles.
+//蓝牙APP串口2协议。接收中断只把字节存入单生产者/单消费者环形缓冲区并唤醒解析任务，
+//解析任务把APP的三种格式转换为指令放入队列。Balance_task在控制周期开始时执行队列中的指令，
+//因此控制相关全局变量只在两个控制周期之间改变
+
+#define APP_PARSER_TASK_PRIO   2       //Below the control task //低于控制任务
+#define APP_PARSER_STK_SIZE    256
+#define APP_RX_RING_SIZE       128     //Power of two, about 130 ms of bytes at 9600 baud //2的幂，9600波特率下约130ms的数据
+#define APP_CMD_QUEUE_LEN      8
+#define APP_FIELD_MAX          16      //Longest number in a command //指令中数字的最大长度
+#define APP_PARAM_KEYS         9       //Keys '0'..'8' of the parameter page //参数页的按键'0'..'8'
+
+typedef enum
+{
+	APP_CMD_KEY = 0,        //Remote control byte //遥控按键字节
+	APP_CMD_TARGET,         //Target point //目标点
+	APP_CMD_PARAM,          //Set one parameter //设置一个参数
+	APP_CMD_PARAM_QUERY     //Send the parameters to the APP //向APP发送参数
+}App_Cmd_Type;
+
+typedef struct
+{
+	u8 Type;
+	u8 Key;                 //APP_CMD_KEY: byte, APP_CMD_PARAM: parameter index //按键字节或参数序号
+	float Value[3];         //APP_CMD_TARGET: x, y, yaw; APP_CMD_PARAM: value //目标点或参数值
+}App_Command_t;
+
+typedef struct
+{
+	u32 Bytes, Overflows;   //Bytes received / dropped because the ring was full //接收字节数/环形缓冲区满丢弃的字节数
+	u32 Commands, Dropped;  //Commands queued / dropped because the queue was full //入队指令数/队列满丢弃的指令数
+	u32 Isr_Cycles, Isr_Cycles_Max;   //USART2 part of the receive callback, CPU cycles //接收回调中串口2部分的耗时，CPU周期数
+}App_Parser_Stats_t;
+
+extern App_Parser_Stats_t App_Parser_Stats;
+
+void App_Parser_Start(void);
+void App_Rx_Byte_ISR(u8 byte);
+void App_Parser_Task(void *pvParameters);
+void App_Command_Poll(void);
+
+#endif
@@ -0,0 +1,147 @@
+#include "battery.h"
+
+extern ADC_HandleTypeDef hadc1;     //Set up by CubeMX in Core/Src/adc.c //由CubeMX在Core/Src/adc.c中初始化
+
+Battery_t Battery;
+
+static uint16_t Battery_Buffer[BATTERY_DMA_SAMPLES];
+static DMA_HandleTypeDef Battery_Dma;
+
+/**************************************************************************
+Function: Switch ADC1 to continuous conversion of the battery channel into the circular DMA buffer
+Input   : none
+Output  : 1: running, 0: failed
+函数功能：将ADC1切换为连续转换电池通道，结果经DMA循环写入缓冲区
+入口参数：无
+返回  值：1：运行，0：失败
+**************************************************************************/
+static uint8_t Battery_Start_Dma(void)
+{
+	ADC_ChannelConfTypeDef sConfig = {0};
+
+	//ADC1 is served by DMA2 Stream0 Channel0 //ADC1对应DMA2数据流0通道0
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	Battery_Dma.Instance = DMA2_Stream0;
+	Battery_Dma.Init.Channel = DMA_CHANNEL_0;
+	Battery_Dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	Battery_Dma.Init.PeriphInc = DMA_PINC_DISABLE;
+	Battery_Dma.Init.MemInc = DMA_MINC_ENABLE;
+	Battery_Dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	Battery_Dma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	Battery_Dma.Init.Mode = DMA_CIRCULAR;
+	Battery_Dma.Init.Priority = DMA_PRIORITY_LOW;
+	Battery_Dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if(HAL_DMA_Init(&Battery_Dma) != HAL_OK) return 0;
+	__HAL_LINKDMA(&hadc1, DMA_Handle, Battery_Dma);
+
+	hadc1.Init.ScanConvMode = DISABLE;
+	hadc1.Init.ContinuousConvMode = ENABLE;
+	hadc1.Init.DiscontinuousConvMode = DISABLE;
+	hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
+	hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+	hadc1.Init.NbrOfConversion = 1;
+	hadc1.Init.DMAContinuousRequests = ENABLE;
+	hadc1.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
+	if(HAL_ADC_Init(&hadc1) != HAL_OK) return 0;
+
+	sConfig.Channel = BATTERY_ADC_CHANNEL;
+	sConfig.Rank = 1;
+	sConfig.SamplingTime = ADC_SAMPLETIME_480CYCLES;
+	if(HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK) return 0;
+
+	//The DMA interrupts HAL enables here stay masked in the NVIC, nothing runs per buffer
+	//HAL在此打开的DMA中断在NVIC中未使能，每轮缓冲不运行任何代码
+	return HAL_ADC_Start_DMA(&hadc1, (uint32_t *)Battery_Buffer, BATTERY_DMA_SAMPLES) == HAL_OK;
+}
+
+/**************************************************************************
+Function: Measure the former blocking read once, then start the DMA sampling
+Input   : none
+Output  : none
+函数功能：测量一次原来的阻塞读取耗时，然后启动DMA采样
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Battery_Init(void)
+{
+	char msg[128];
+	u32 start = getMicros();
+
+	Battery.Volt = Battery.Volt_Fast = Get_battery_volt();
+	Battery.Blocking_Us = getMicros() - start;
+	Battery.Volt_Min = Battery.Volt;
+
+	Battery.Dma = Battery_Start_Dma();
+	if(Battery.Dma)
+	{
+		//Wait until the buffer has been filled once //等待缓冲区写满一轮
+		delay_ms(10);
+		Battery.Last_Us = 0;
+		Battery.Volt = Battery_Read();
+		Battery.Volt_Min = Battery.Volt_Fast;
+	}
+
+	snprintf(msg, sizeof(msg), "[电池] %s 阻塞读取%luus 当前%.2fV\r\n", Battery.Dma ? "DMA采样" : "DMA启动失败，阻塞读取",
+	         (unsigned long)Battery.Blocking_Us, (double)Battery.Volt);
+	usart1_send_cstring(msg);
+}
+
+/**************************************************************************
+Function: Battery voltage on demand: mean of the DMA buffer, low-pass and sag detection
+Input   : none
+Output  : low-passed battery voltage, V
+函数功能：按需计算电池电压：DMA缓冲区均值、低通滤波和压降检测
+入口参数：无
+返回  值：低通滤波后的电池电压，V
+**************************************************************************/
+float Battery_Read(void)
+{
+	u32 start = getCycleCnt(), now = getMicros(), sum = 0, i;
+	float dt;
+
+	if(Battery.Dma)
+	{
+		//An overrun stops the DMA requests, restart the conversion //溢出会停止DMA请求，重新启动转换
+		if(hadc1.Instance->SR & ADC_SR_OVR)
+		{
+			HAL_ADC_Stop_DMA(&hadc1);
+			HAL_ADC_Start_DMA(&hadc1, (uint32_t *)Battery_Buffer, BATTERY_DMA_SAMPLES);
+		}
+		for(i = 0; i < BATTERY_DMA_SAMPLES; i++) sum += Battery_Buffer[i];
+		Battery.Volt_Fast = (float)sum * (BATTERY_VREF * BATTERY_DIVIDER / 4096.0f / BATTERY_DMA_SAMPLES);
+	}
+	else Battery.Volt_Fast = Get_battery_volt();
+
+	//First order low-pass over the real time between two readings //按两次读取的实际间隔做一阶低通
+	if(Battery.Last_Us == 0) Battery.Volt = Battery.Volt_Fast;
+	else
+	{
+		dt = (float)(now - Battery.Last_Us) * 1e-6f;
+		Battery.Volt += dt / (BATTERY_LPF_TAU_S + dt) * (Battery.Volt_Fast - Battery.Volt);
+	}
+
+	//Sag: the fast mean dips under the slow one while the motors pull current
+	//压降：电机大电流时快速均值低于慢速低通值
+	Battery.Sag = Battery.Volt - Battery.Volt_Fast;
+	if(Battery.Sag > Battery.Sag_Max) Battery.Sag_Max = Battery.Sag;
+	if(Battery.Volt_Fast < Battery.Volt_Min) Battery.Volt_Min = Battery.Volt_Fast;
+	if(!Battery.Sagging && Battery.Sag > BATTERY_SAG_V)
+	{
+		Battery.Sagging = 1;
+		Battery.Sag_Events++;
+	}
+	else if(Battery.Sagging && Battery.Sag < BATTERY_SAG_CLEAR_V) Battery.Sagging = 0;
+
+	Battery.Read_Cycles = getCycleCnt() - start;
+	if(Battery.Last_Us != 0 && now != Battery.Last_Us)
+	{
+		u32 reads_per_second = 1000000u / (now - Battery.Last_Us);
+		u32 read_us = Battery.Read_Cycles / (SystemCoreClock / 1000000);
+		u32 blocking_us = Battery.Blocking_Us * BATTERY_BLOCKING_READS;
+		//Unsigned, a read slower than the blocking one saves nothing instead of wrapping
+		//无符号数，读取比阻塞方式更慢时记为0，不回绕
+		Battery.Freed_Us_Per_Second = blocking_us > read_us * reads_per_second ? blocking_us - read_us * reads_per_second : 0;
+	}
+	Battery.Last_Us = now;
+	return Battery.Volt;
+}
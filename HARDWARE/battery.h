@@ -0,0 +1,45 @@
+#ifndef __BATTERY_H
+#define __BATTERY_H
+#include "system.h"
+
+//Battery voltage from a free running ADC. ADC1 converts the battery channel
+//continuously with the longest sample time and DMA2 Stream0 writes every
+//result into a circular buffer, so no task waits for a conversion. A reading
+//averages the whole buffer (software oversampling, the F407 has no hardware
+//oversampler) and feeds a low-pass, it costs a few microseconds whenever it
+//is asked for. A sag detector compares the buffer average with the low-pass
+//and counts the dips caused by motor load.
+//ADC自由运行采集电池电压。ADC1以最长采样时间连续转换电池通道，DMA2数据流0把结果循环写入缓冲区，
+//没有任务需要等待转换。读取时对整个缓冲区求平均(软件过采样，F407没有硬件过采样)后低通滤波，
+//每次调用仅需几微秒。压降检测比较缓冲区均值与低通值，统计电机负载引起的电压跌落
+
+#define BATTERY_ADC_CHANNEL   ADC_CHANNEL_8   //Same channel as Battery_Ch //与Battery_Ch相同的通道
+#define BATTERY_DMA_SAMPLES   256      //About 6 ms of conversions at 480 cycles each //每次转换480周期时约6ms
+#define BATTERY_DIVIDER       11.0f    //Resistor divider in front of the ADC //ADC前的分压比
+#define BATTERY_VREF          3.3f
+#define BATTERY_LPF_TAU_S     1.0f     //Time constant of Voltage, s //Voltage的低通时间常数，s
+#define BATTERY_SAG_V         0.4f     //Dip below the low-pass counted as a sag, V //低于低通值超过该值视为压降，V
+#define BATTERY_SAG_CLEAR_V   0.2f     //A sag ends when the dip is back below this, V //跌落恢复到该值以下时压降结束，V
+#define BATTERY_BLOCKING_READS 1000    //Blocking conversions per second of the former show_task //原show_task每秒的阻塞转换次数
+
+typedef struct
+{
+	uint8_t Dma;                  //1: DMA running, 0: blocking fallback //1：DMA运行，0：退回阻塞读取
+	float Volt_Fast;              //Mean of the DMA buffer, V //DMA缓冲区均值，V
+	float Volt;                   //Low-pass of Volt_Fast, what the rest of the code uses, V //Volt_Fast的低通值，供其它代码使用，V
+	float Volt_Min;               //Lowest Volt_Fast seen, V //Volt_Fast的最小值，V
+	float Sag, Sag_Max;           //Volt-Volt_Fast now and the deepest one, V //当前及最大压降，V
+	uint8_t Sagging;
+	uint32_t Sag_Events;          //Dips deeper than BATTERY_SAG_V //超过BATTERY_SAG_V的跌落次数
+	uint32_t Last_Us;
+	uint32_t Read_Cycles;         //Cost of one reading, CPU cycles //一次读取的耗时，CPU周期数
+	uint32_t Blocking_Us;         //Cost of one blocking Get_battery_volt, measured at start //一次阻塞读取的耗时，启动时测量
+	uint32_t Freed_Us_Per_Second; //CPU time saved against BATTERY_BLOCKING_READS blocking reads //相对每秒BATTERY_BLOCKING_READS次阻塞读取节省的CPU时间
+}Battery_t;
+
+extern Battery_t Battery;
+
+void Battery_Init(void);
+float Battery_Read(void);
+
+#endif
@@ -4,7 +4,7 @@
 #include "system.h"
 
 // No larger than 65535, because the timer of STM32F103 is 16 bit
-//ɴ65535ΪSTM32F103Ķʱ16λ
+//不可大于65535，因为STM32F103的定时器是16位的
 #define ENCODER_TIM_PERIOD (u16)(65535)   
 
 
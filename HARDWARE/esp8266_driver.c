@@ -1,38 +1,39 @@
 #include "esp8266_driver.h"
-#include "formation_control.h"  // ӱӿͷļ
+#include "formation_control.h"  // 添加编队控制头文件
+#include "num_parse.h"
 
-// ȫֱ
-uint8_t esp8266_udp_initialized = 0;  // UDPʼ״̬
-uint8_t esp8266_broadcast_initialized = 0;  // 㲥ʼ״̬
-char CAR_ID[10] = "CAR0";  // ĬIDڳʼʱ
+// 全局变量定义
+uint8_t esp8266_udp_initialized = 0;  // UDP初始化状态
+uint8_t esp8266_broadcast_initialized = 0;  // 广播初始化状态
+char CAR_ID[10] = "CAR0";  // 默认ID，会在初始化时更新
 
-// ͨȫֱ
+// 通信拓扑全局变量
 uint8_t communication_topology[MAX_CARS][MAX_CARS] = {
-    {0, 1, 1, 1},  // CAR1 Է͸CAR2,CAR3,CAR4
-    {1, 0, 1, 1},  // CAR2 Է͸CAR1,CAR3,CAR4  
-    {1, 1, 0, 1},  // CAR3 Է͸CAR1,CAR2,CAR4
-    {1, 1, 1, 0}   // CAR4 Է͸CAR1,CAR2,CAR3
+    {0, 1, 1, 1},  // CAR1 可以发送给CAR2,CAR3,CAR4
+    {1, 0, 1, 1},  // CAR2 可以发送给CAR1,CAR3,CAR4  
+    {1, 1, 0, 1},  // CAR3 可以发送给CAR1,CAR2,CAR4
+    {1, 1, 1, 0}   // CAR4 可以发送给CAR1,CAR2,CAR3
 };
 uint8_t topology_enabled = 0;
-uint8_t car_index = 0;  // CAR_IDȷ
+uint8_t car_index = 0;  // 根据CAR_ID确定
 
-// ļͷȫֱ
+// 在文件开头添加全局变量
 static uint8_t uart_timeout_count = 0;
 static uint32_t last_successful_communication = 0;
 
-// СϢ
+// 其他小车信息
 OtherCarInfo other_cars[MAX_OTHER_CARS];
 uint8_t other_cars_count = 0;
 
-// ֪ĸСMACַ
+// 已知的四个小车的MAC地址
 const char* known_mac_addresses[] = {
-    "78:1c:3c:8a:a5:00",  // С1MAC
-    "78:1c:3c:8a:9e:49",  // С2MAC  
-    "78:1c:3c:8a:9e:74",  // С3MAC
-    "78:1c:3c:8a:9e:7f"   // С4MAC
+    "78:1c:3c:8a:a5:00",  // 小车1的MAC
+    "78:1c:3c:8a:9e:49",  // 小车2的MAC  
+    "78:1c:3c:8a:9e:74",  // 小车3的MAC
+    "78:1c:3c:8a:9e:7f"   // 小车4的MAC
 };
 
-// Ϣͺ
+// 调试信息发送函数
 void debug_print(const char* message)
 {
     usart1_send_cstring(message);
@@ -40,56 +41,56 @@ void debug_print(const char* message)
 
 void Init_Communication_Topology(void)
 {
-    // CAR_IDȷ
+    // 根据CAR_ID确定本车索引
     char debug_msg[128];
     snprintf(debug_msg, sizeof(debug_msg), 
-             "[] ʼͨˣǰCAR_ID: %s\r\n", CAR_ID);
+             "[拓扑] 初始化通信拓扑，当前CAR_ID: %s\r\n", CAR_ID);
     debug_print(debug_msg);
     
-    // ޼CAR_IDƳܵĻзͿո
+    // 修剪CAR_ID（移除可能的换行符和空格）
     char trimmed_car_id[16];
     strncpy(trimmed_car_id, CAR_ID, sizeof(trimmed_car_id)-1);
     trimmed_car_id[sizeof(trimmed_car_id)-1] = '\0';
     
-    // Ƴзͻس
+    // 移除换行符和回车符
     char* newline = strchr(trimmed_car_id, '\r');
     if (newline) *newline = '\0';
     newline = strchr(trimmed_car_id, '\n');
     if (newline) *newline = '\0';
     
-    // car_index - ޸ӳ
+    // 设置car_index - 修复索引映射
     if(strcmp(trimmed_car_id, "CAR1") == 0) {
         car_index = 0;
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] CAR1Ϊ0\r\n");
+                 "[拓扑] 本车是CAR1，索引设置为0\r\n");
         debug_print(debug_msg);
     }
     else if(strcmp(trimmed_car_id, "CAR2") == 0) {
-        car_index = 1;  // ޸CAR2Ӧ10
+        car_index = 1;  // 修复：CAR2应该是索引1，不是0
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] CAR2Ϊ1\r\n");
+                 "[拓扑] 本车是CAR2，索引设置为1\r\n");
         debug_print(debug_msg);
     }
     else if(strcmp(trimmed_car_id, "CAR3") == 0) {
         car_index = 2;
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] CAR3Ϊ2\r\n");
+                 "[拓扑] 本车是CAR3，索引设置为2\r\n");
         debug_print(debug_msg);
     }
     else if(strcmp(trimmed_car_id, "CAR4") == 0) {
         car_index = 3;
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] CAR4Ϊ3\r\n");
+                 "[拓扑] 本车是CAR4，索引设置为3\r\n");
         debug_print(debug_msg);
     }
     else {
-        car_index = 0;  // Ĭ
+        car_index = 0;  // 默认
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] δ֪CAR_ID: %sʹĬ0\r\n", trimmed_car_id);
+                 "[拓扑] 未知CAR_ID: %s，使用默认索引0\r\n", trimmed_car_id);
         debug_print(debug_msg);
     }
     
-    // ʼΪȫˣԽΪ0ԼܸԼͣ
+    // 初始化为全连接拓扑，但对角线为0（自己不能给自己发送）
     for(int i = 0; i < MAX_CARS; i++) {
         for(int j = 0; j < MAX_CARS; j++) {
             communication_topology[i][j] = (i == j) ? 0 : 1;
@@ -97,51 +98,51 @@ void Init_Communication_Topology(void)
     }
     topology_enabled = 0;
     
-    debug_print("[] ͨ˳ʼ\r\n");
+    debug_print("[拓扑] 通信拓扑初始化完成\r\n");
 }
 
 uint8_t Should_Process_Car_Info(const char* car_id)
 {
-    // ˹δãСϢ
+    // 如果拓扑功能未启用，处理所有小车信息
     if(!topology_enabled) {
         char debug_msg[128];
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] ˹δã %s Ϣ\r\n", car_id);
+                 "[拓扑] 拓扑功能未启用，允许接收 %s 的信息\r\n", car_id);
         debug_print(debug_msg);
         return 1;
     }
     
-    // ȷĿС
+    // 确定目标小车的索引
     uint8_t target_index = 0;
     if(strcmp(car_id, "CAR1") == 0) target_index = 0;
     else if(strcmp(car_id, "CAR2") == 0) target_index = 1;
     else if(strcmp(car_id, "CAR3") == 0) target_index = 2;
     else if(strcmp(car_id, "CAR4") == 0) target_index = 3;
     else {
-        // δ֪СĬ
+        // 未知小车，默认允许接收
         char debug_msg[128];
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[] δ֪СID: %sĬ\r\n", car_id);
+                 "[拓扑] 未知小车ID: %s，默认允许接收\r\n", car_id);
         debug_print(debug_msg);
         return 1;
     }
     
-    // ݹA[i][j] = 1 ʾСiԸСjϢjԿi
-    // Ҫ飺Ŀ공ܷ͸ A[target_index][car_index] == 1?
+    // 根据规则：A[i][j] = 1 表示小车i可以给小车j发送信息（j可以看见i）
+    // 所以我们要检查：目标车能否发送给本车？即 A[target_index][car_index] == 1?
     uint8_t result = communication_topology[target_index][car_index];
     
-    // // ϸĵϢ
+    // // 详细的调试信息
     // char debug_msg[256];
     // snprintf(debug_msg, sizeof(debug_msg), 
-    //          "[] ͨȨ:\r\n"
-    //          "[]   : %s (%d)\r\n"
-    //          "[]   Ŀ공: %s (%d)\r\n"
-    //          "[]   : communication_topology[%d][%d] = %d\r\n"
-    //          "[]   : %s\r\n",
+    //          "[拓扑] 检查通信权限:\r\n"
+    //          "[拓扑]   本车: %s (索引%d)\r\n"
+    //          "[拓扑]   目标车: %s (索引%d)\r\n"
+    //          "[拓扑]   矩阵检查: communication_topology[%d][%d] = %d\r\n"
+    //          "[拓扑]   结果: %s\r\n",
     //          CAR_ID, car_index,
     //          car_id, target_index,
     //          target_index, car_index, communication_topology[target_index][car_index],
-    //          result ? "" : "ֹ");
+    //          result ? "允许接收" : "禁止接收");
     // debug_print(debug_msg);
     
     return result;
@@ -150,36 +151,36 @@ uint8_t Should_Process_Car_Info(const char* car_id)
 
 void Process_Topology_Command(const char* command)
 {
-    // ʽ: "TOPOLOGY_TOGGLE:1"  "TOPOLOGY_TOGGLE:0"  "TOPOLOGY_TOGGLE:True/False"
+    // 格式: "TOPOLOGY_TOGGLE:1" 或 "TOPOLOGY_TOGGLE:0" 或 "TOPOLOGY_TOGGLE:True/False"
     const char* toggle_ptr = strstr(command, "TOPOLOGY_TOGGLE:");
     if(toggle_ptr != NULL) {
-        toggle_ptr += 16;  // "TOPOLOGY_TOGGLE:"
+        toggle_ptr += 16;  // 跳过"TOPOLOGY_TOGGLE:"
         
-        // ֵ True/False  1/0
+        // 处理布尔值 True/False 或 1/0
         if (strstr(toggle_ptr, "True") != NULL || (toggle_ptr[0] == '1' && (toggle_ptr[1] == '\0' || toggle_ptr[1] == '\r' || toggle_ptr[1] == '\n'))) {
             topology_enabled = 1;
-            debug_print("[] ˹\r\n");
+            debug_print("[拓扑] 拓扑功能已启用\r\n");
         } else if (strstr(toggle_ptr, "False") != NULL || (toggle_ptr[0] == '0' && (toggle_ptr[1] == '\0' || toggle_ptr[1] == '\r' || toggle_ptr[1] == '\n'))) {
             topology_enabled = 0;
-            debug_print("[] ˹ѽ\r\n");
+            debug_print("[拓扑] 拓扑功能已禁用\r\n");
         } 
         return;
     }
     
-    // ʽ: "TOPOLOGY:1,1,1,1;1,0,1,0;1,1,0,1;1,0,1,0"
+    // 格式: "TOPOLOGY:1,1,1,1;1,0,1,0;1,1,0,1;1,0,1,0"
     const char* topology_ptr = strstr(command, "TOPOLOGY:");
     if(topology_ptr != NULL) {
-        topology_ptr += 9;  // "TOPOLOGY:"
+        topology_ptr += 9;  // 跳过"TOPOLOGY:"
         
-        // Զ˹
+        // 自动启用拓扑功能
         topology_enabled = 1;
         
-        // ַд
+        // 复制拓扑字符串进行处理
         char topology_str[128];
         strncpy(topology_str, topology_ptr, sizeof(topology_str)-1);
         topology_str[sizeof(topology_str)-1] = '\0';
         
-        // ƳܵĻзͻس
+        // 移除可能的换行符和回车符
         char* newline = strchr(topology_str, '\r');
         if (newline) *newline = '\0';
         newline = strchr(topology_str, '\n');
@@ -189,21 +190,21 @@ void Process_Topology_Command(const char* command)
         return;
     }
     
-    // ʽ: "TOPOLOGY:START"  "TOPOLOGY:ENABLE" - 
+    // 格式: "TOPOLOGY:START" 或 "TOPOLOGY:ENABLE" - 启用拓扑
     if (strstr(command, "TOPOLOGY:START") != NULL || strstr(command, "TOPOLOGY:ENABLE") != NULL) {
         topology_enabled = 1;
-        debug_print("[] ˹\r\n");
+        debug_print("[拓扑] 拓扑功能已启用\r\n");
         return;
     }
     
-    // ʽ: "TOPOLOGY:STOP"  "TOPOLOGY:DISABLE" - 
+    // 格式: "TOPOLOGY:STOP" 或 "TOPOLOGY:DISABLE" - 禁用拓扑
     if (strstr(command, "TOPOLOGY:STOP") != NULL || strstr(command, "TOPOLOGY:DISABLE") != NULL) {
         topology_enabled = 0;
-        debug_print("[] ˹ѽ\r\n");
+        debug_print("[拓扑] 拓扑功能已禁用\r\n");
         return;
     }
     
-    debug_print("[] δָ֪ʽ\r\n");
+    debug_print("[拓扑] 未知拓扑指令格式\r\n");
 }
 
 void Update_Topology_Matrix(const char* topology_str)
@@ -213,33 +214,33 @@ void Update_Topology_Matrix(const char* topology_str)
     strncpy(temp_str, topology_str, sizeof(temp_str)-1);
     temp_str[sizeof(temp_str)-1] = '\0';
     
-    debug_print("[] ʼ˾ַ\r\n");
+    debug_print("[拓扑] 开始解析拓扑矩阵字符串\r\n");
     
     char* row_ptr = temp_str;
     int row = 0;
     
     while (row_ptr != NULL && *row_ptr != '\0' && row < MAX_CARS) {
-        // ҵǰеĽֺŻַ
+        // 找到当前行的结束（分号或字符串结束）
         char* row_end = strchr(row_ptr, ';');
         if (row_end != NULL) {
-            *row_end = '\0'; // ʱֹǰ
+            *row_end = '\0'; // 临时终止当前行
         }
         
-        // Ƶǰеʱ
+        // 复制当前行到临时缓冲区
         strncpy(temp_row, row_ptr, sizeof(temp_row)-1);
         temp_row[sizeof(temp_row)-1] = '\0';
         
         char debug_row[64];
         snprintf(debug_row, sizeof(debug_row), 
-                 "[] %d: %s\r\n", row, temp_row);
+                 "[拓扑] 解析第%d行: %s\r\n", row, temp_row);
         debug_print(debug_row);
         
-        // ǰе
+        // 解析当前行的数字
         char* col_ptr = temp_row;
         int col = 0;
         
         while (col_ptr != NULL && *col_ptr != '\0' && col < MAX_CARS) {
-            // ոͶ
+            // 跳过空格和逗号
             while (*col_ptr == ' ' || *col_ptr == ',') {
                 col_ptr++;
             }
@@ -248,40 +249,40 @@ void Update_Topology_Matrix(const char* topology_str)
                 break;
             }
             
-            // 
-            int value = atoi(col_ptr);
+            // 解析数字
+            int value = Num_Atoi(col_ptr, 8);
             communication_topology[row][col] = (uint8_t)value;
             
             char debug_cell[32];
             snprintf(debug_cell, sizeof(debug_cell), 
-                     "[]  [%d][%d] = %d\r\n", row, col, value);
+                     "[拓扑] 设置 [%d][%d] = %d\r\n", row, col, value);
             debug_print(debug_cell);
             
             col++;
             
-            // ƶһ
+            // 移动到下一个数字
             col_ptr = strchr(col_ptr, ',');
             if (col_ptr != NULL) {
-                col_ptr++; // 
+                col_ptr++; // 跳过逗号
             }
         }
         
         row++;
         
-        // ƶһ
+        // 移动到下一行
         if (row_end != NULL) {
-            row_ptr = row_end + 1; // ֺ
+            row_ptr = row_end + 1; // 跳过分号
         } else {
-            row_ptr = NULL; // ûи
+            row_ptr = NULL; // 没有更多行了
         }
     }
     
-    debug_print("[] ˾\r\n");
+    debug_print("[拓扑] 拓扑矩阵解析完成\r\n");
     
-    // // ӡ˾ڵ
+    // // 打印拓扑矩阵用于调试
     // char debug_msg[256];
     // snprintf(debug_msg, sizeof(debug_msg), 
-    //          "[] ǰ:\r\n"
+    //          "[拓扑] 当前矩阵:\r\n"
     //          "[%d,%d,%d,%d]\r\n"
     //          "[%d,%d,%d,%d]\r\n"
     //          "[%d,%d,%d,%d]\r\n"
@@ -296,43 +297,43 @@ void Update_Topology_Matrix(const char* topology_str)
     //          communication_topology[3][2], communication_topology[3][3]);
     // debug_print(debug_msg);
     
-    // ޸Ȩ֤߼
+    // 修复接收权限验证逻辑
     char car_list[4][8] = {"CAR1", "CAR2", "CAR3", "CAR4"};
-    debug_print("[] Ȩ֤:\r\n");
+    debug_print("[拓扑] 本车接收权限验证:\r\n");
     
-    // ȷϱ
+    // 先确认本车索引
     char index_msg[64];
     snprintf(index_msg, sizeof(index_msg), 
-             "[] : %s, : %d\r\n", CAR_ID, car_index);
+             "[拓扑] 本车: %s, 索引: %d\r\n", CAR_ID, car_index);
     debug_print(index_msg);
     
     for(int i = 0; i < MAX_CARS; i++) {
-        // ݹA[i][j] = 1 ʾСiԸСjϢjԿi
-        // Աcar_indexܷСiϢȡcommunication_topology[i][car_index]
+        // 根据规则：A[i][j] = 1 表示小车i可以给小车j发送信息（j可以看见i）
+        // 所以本车（索引car_index）能否接收小车i的信息，取决于communication_topology[i][car_index]
         uint8_t can_receive = communication_topology[i][car_index];
         
         char perm_msg[64];
         snprintf(perm_msg, sizeof(perm_msg), 
-                 "[]    %s : %s ( communication_topology[%d][%d] = %d)\r\n", 
+                 "[拓扑]   从 %s 接收: %s (检查 communication_topology[%d][%d] = %d)\r\n", 
                  car_list[i], 
-                 can_receive ? "" : "ֹ",
+                 can_receive ? "允许" : "禁止",
                  i, car_index, communication_topology[i][car_index]);
         debug_print(perm_msg);
     }
 }
 
-// 㲥ӳʼ
+// 广播连接初始化函数
 ESP8266_Status_t ESP8266_InitBroadcast(void)
 {
-    debug_print("[㲥] ʼ㲥...\r\n");
+    debug_print("[广播] 初始化广播连接...\r\n");
     
-    // öģʽ
+    // 设置多连接模式
     if(ESP8266_SendATCommand_Enhanced("AT+CIPMUX=1", "OK", 5000) != ESP8266_OK) {
-        debug_print("[㲥] öģʽʧ\r\n");
+        debug_print("[广播] 设置多连接模式失败\r\n");
         return ESP8266_ERROR;
     }
     
-    // 㲥ӣʹ1
+    // 创建广播连接（使用连接1）
     char broadcast_cmd[128];
     snprintf(broadcast_cmd, sizeof(broadcast_cmd), 
              "AT+CIPSTART=1,\"UDP\",\"%s\",%d,%d,0", 
@@ -342,22 +343,22 @@ ESP8266_Status_t ESP8266_InitBroadcast(void)
     
     if(result == ESP8266_OK || result == ESP8266_ALREADY_CONNECTED) {
         esp8266_broadcast_initialized = 1;
-        debug_print("[㲥] 㲥ӳʼɹ\r\n");
+        debug_print("[广播] 广播连接初始化成功\r\n");
         return ESP8266_OK;
     } else {
-        debug_print("[㲥] 㲥ӳʼʧ\r\n");
+        debug_print("[广播] 广播连接初始化失败\r\n");
         return ESP8266_ERROR;
     }
 }
 
-// UDPʼ޸Ϊʹ0
+// UDP初始化函数（修改为使用连接0）
 ESP8266_Status_t ESP8266_InitUDP(void)
 {
-    debug_print("[UDP] ʼUDP...\r\n");
+    debug_print("[UDP] 初始化UDP连接...\r\n");
     
-    // öģʽ
+    // 设置多连接模式
     if(ESP8266_SendATCommand_Enhanced("AT+CIPMUX=1", "OK", 5000) != ESP8266_OK) {
-        debug_print("[UDP] öģʽʧ\r\n");
+        debug_print("[UDP] 设置多连接模式失败\r\n");
         return ESP8266_ERROR;
     }
     
@@ -370,25 +371,26 @@ ESP8266_Status_t ESP8266_InitUDP(void)
     
     if(result == ESP8266_OK || result == ESP8266_ALREADY_CONNECTED) {
         esp8266_udp_initialized = 1;
-        debug_print("[UDP] UDPӳʼɹ\r\n");
+        debug_print("[UDP] UDP连接初始化成功\r\n");
         return ESP8266_OK;
     } else {
-        debug_print("[UDP] UDPӳʼʧ\r\n");
+        debug_print("[UDP] UDP连接初始化失败\r\n");
         return ESP8266_ERROR;
     }
 }
 
 
-ESP8266_Status_t ESP8266_SendStatus_UDP_Reliable(float x, float y, float yaw, float voltage, float vx, float vy, float vz)
+ESP8266_Status_t ESP8266_SendStatus_UDP_Reliable(float x, float y, float yaw, float voltage, float vx, float vy, float vz, uint8_t reciprocal)
 {
     static char status_msg[128];
     static uint8_t retry_count = 0;
     
+    // 最后一个字段：本车是否运行ORCA避碰，其他车据此决定承担一半还是全部避让
     snprintf(status_msg, sizeof(status_msg), 
-             "%s:%.2f,%.2f,%.1f,%.1f,%.3f,%.3f,%.3f", 
-             CAR_ID, x, y, yaw, voltage, vx, vy, vz);
+             "%s:%.2f,%.2f,%.1f,%.1f,%.3f,%.3f,%.3f,%d", 
+             CAR_ID, x, y, yaw, voltage, vx, vy, vz, reciprocal ? 1 : 0);
     
-    // UDPδʼȳʼ
+    // 如果UDP未初始化，先初始化
     if(!esp8266_udp_initialized) {
         if(ESP8266_InitUDP() != ESP8266_OK) {
             return ESP8266_ERROR;
@@ -398,16 +400,16 @@ ESP8266_Status_t ESP8266_SendStatus_UDP_Reliable(float x, float y, float yaw, fl
     char send_cmd[32];  //
     int len = sprintf(send_cmd, "AT+CIPSEND=0,%d\r\n", strlen(status_msg));
     
-    // 2ΣԴ
+    // 发送命令，最多重试2次（减少重试次数）
     for(retry_count = 0; retry_count < 2; retry_count++) {
-        // սջ
+        // 清空接收缓冲区
         esp8266_rx_index = 0;
         memset(esp8266_rx_buffer, 0, sizeof(esp8266_rx_buffer));
         
         HAL_UART_Transmit(&huart6, (uint8_t*)send_cmd, len, 100);
-        HAL_Delay(3);  // ӳ٣ȴӦ
+        HAL_Delay(3);  // 增加延迟，等待响应
         
-        // Ƿյ">"ʾ
+        // 检查是否收到">"提示
         uint32_t wait_start = HAL_GetTick();
         while(HAL_GetTick() - wait_start < 1000) {
             if(esp8266_rx_index > 0 && strstr((char*)esp8266_rx_buffer, ">") != NULL) {
@@ -416,12 +418,12 @@ ESP8266_Status_t ESP8266_SendStatus_UDP_Reliable(float x, float y, float yaw, fl
             HAL_Delay(3);
         }
         
-        // 
+        // 发送数据
         HAL_UART_Transmit(&huart6, (uint8_t*)status_msg, strlen(status_msg), 100);
         HAL_UART_Transmit(&huart6, (uint8_t*)"\r\n", 2, 100);
         
-        // 鷢Ƿɹ
-        HAL_Delay(3);  // ȴӦ
+        // 检查发送是否成功
+        HAL_Delay(3);  // 等待响应
         if(esp8266_rx_index > 0) {
             if(strstr((char*)esp8266_rx_buffer, "SEND OK") != NULL) {
                 last_successful_communication = HAL_GetTick();
@@ -434,88 +436,88 @@ ESP8266_Status_t ESP8266_SendStatus_UDP_Reliable(float x, float y, float yaw, fl
         HAL_Delay(3);
     }
     
-    // ʧܣUDPҪ³ʼ
+    // 发送失败，标记UDP需要重新初始化
     esp8266_udp_initialized = 0;
     esp8266_broadcast_initialized = 0;
     return ESP8266_ERROR;
 }  
 
-// ǿATָͺ
+// 增强的AT指令发送函数
 ESP8266_Status_t ESP8266_SendATCommand_Enhanced(const char* cmd, const char* expected_response, uint32_t timeout)
 {
     uint32_t start_time = HAL_GetTick();
     
-    // սջ
+    // 清空接收缓冲区
     esp8266_rx_index = 0;
     memset(esp8266_rx_buffer, 0, sizeof(esp8266_rx_buffer));
     
-    // UARTջ
+    // 清空UART接收缓冲区
     __HAL_UART_FLUSH_DRREGISTER(&huart6);
     
-    debug_print("[ESP8266] : ");
+    debug_print("[ESP8266] 发送: ");
     debug_print(cmd);
     debug_print("\r\n");
     
-    // 
+    // 发送命令
     HAL_UART_Transmit(&huart6, (uint8_t*)cmd, strlen(cmd), 1000);
     HAL_UART_Transmit(&huart6, (uint8_t*)"\r\n", 2, 1000);
     
     while(HAL_GetTick() - start_time < timeout) {
-        // 
+        // 处理接收数据
         if(esp8266_rx_index > 0) {
             esp8266_rx_buffer[esp8266_rx_index] = '\0';
             
             if(strstr((char*)esp8266_rx_buffer, "ALREADY CONNECTED") != NULL) {
-                debug_print("[ESP8266] ״̬\r\n");
+                debug_print("[ESP8266] 已连接状态\r\n");
                 last_successful_communication = HAL_GetTick();
                 uart_timeout_count = 0;
                 return ESP8266_ALREADY_CONNECTED;
             }
             
             if(strstr((char*)esp8266_rx_buffer, expected_response) != NULL) {
-                debug_print("[ESP8266] յԤӦ\r\n");
+                debug_print("[ESP8266] 收到预期响应\r\n");
                 last_successful_communication = HAL_GetTick();
                 uart_timeout_count = 0;
                 return ESP8266_OK;
             }
             
             if(strstr((char*)esp8266_rx_buffer, "ERROR") != NULL) {
-                debug_print("[ESP8266] Ӧ\r\n");
+                debug_print("[ESP8266] 错误响应\r\n");
                 last_successful_communication = HAL_GetTick();
                 uart_timeout_count = 0;
                 return ESP8266_ERROR;
             }
         }
         
-        // ӳ٣æȴ
+        // 短暂延迟，避免忙等待
         HAL_Delay(3);
     }
     
-    // ʱ
+    // 超时处理
     uart_timeout_count++;
-    debug_print("[ESP8266] ʱյ: ");
+    debug_print("[ESP8266] 超时，收到: ");
     debug_print((char*)esp8266_rx_buffer);
     debug_print("\r\n");
     
-    // ʱΣҪλUART
+    // 如果连续超时多次，可能需要复位UART
     if(uart_timeout_count > 5) {
-        debug_print("[UART] ʱҪӲ\r\n");
+        debug_print("[UART] 连续超时，可能需要检查硬件连接\r\n");
         uart_timeout_count = 0;
     }
     
     return ESP8266_TIMEOUT;
 }
 
-// ȡMACַ
+// 获取MAC地址
 ESP8266_Status_t ESP8266_GetMACAddress(char* mac_buffer, uint32_t buffer_size)
 {
-    debug_print("[MAC] ȡMACַ...\r\n");
+    debug_print("[MAC] 获取MAC地址...\r\n");
     
     esp8266_rx_index = 0;
     memset(esp8266_rx_buffer, 0, sizeof(esp8266_rx_buffer));
     
     if(ESP8266_SendATCommand_Enhanced("AT+CIPSTAMAC?", "OK", 3000) != ESP8266_OK) {
-        debug_print("[MAC] ȡMACַʧ\r\n");
+        debug_print("[MAC] 获取MAC地址失败\r\n");
         return ESP8266_ERROR;
     }
     
@@ -529,18 +531,18 @@ ESP8266_Status_t ESP8266_GetMACAddress(char* mac_buffer, uint32_t buffer_size)
         }
         mac_buffer[i] = '\0';
         
-        debug_print("[MAC] ȡMACַ: ");
+        debug_print("[MAC] 获取到MAC地址: ");
         debug_print(mac_buffer);
         debug_print("\r\n");
         
         return ESP8266_OK;
     }
     
-    debug_print("[MAC] MACַʧ\r\n");
+    debug_print("[MAC] 解析MAC地址失败\r\n");
     return ESP8266_ERROR;
 }
 
-// MACַԶСID
+// 根据MAC地址自动分配小车ID
 void ESP8266_AutoAssignCarID(void)
 {
     char mac_address[18];
@@ -549,7 +551,7 @@ void ESP8266_AutoAssignCarID(void)
         for(int i = 0; i < 4; i++) {
             if(strcmp(mac_address, known_mac_addresses[i]) == 0) {
                 snprintf(CAR_ID, sizeof(CAR_ID), "CAR%d", i + 1);
-                debug_print("[ID] MACַID: ");
+                debug_print("[ID] 根据MAC地址分配ID: ");
                 debug_print(CAR_ID);
                 debug_print("\r\n");
                 return;
@@ -557,19 +559,19 @@ void ESP8266_AutoAssignCarID(void)
         }
         
         snprintf(CAR_ID, sizeof(CAR_ID), "CAR%s", mac_address + 12);
-        debug_print("[ID] ʹMACַID: ");
+        debug_print("[ID] 使用MAC地址生成ID: ");
         debug_print(CAR_ID);
         debug_print("\r\n");
     } else {
         strcpy(CAR_ID, "CAR0");
-        debug_print("[ID] ʹĬID: CAR0\r\n");
+        debug_print("[ID] 使用默认ID: CAR0\r\n");
     }
 }
 
-// ʼСϢ飨4֪СĻϢ
+// 初始化其他小车信息数组（含4辆已知小车的基础信息）
 void Init_Other_Cars_Info(void)
 {
-    // 1. 
+    // 1. 先清空数组
     for (int i = 0; i < MAX_OTHER_CARS; i++) {
         other_cars[i].valid = 0;
         memset(other_cars[i].car_id, 0, sizeof(other_cars[i].car_id));
@@ -577,63 +579,64 @@ void Init_Other_Cars_Info(void)
         other_cars[i].position_y = 0;
         other_cars[i].yaw = 0;
         other_cars[i].last_update = 0;
+        other_cars[i].reciprocal = 0;
     }
     other_cars_count = 0;
 
-    // 2. Ԥ4֪СCAR1~CAR4Ϊ"δ"valid=0
+    // 2. 预先添加4辆已知小车（CAR1~CAR4），标记为"未上线"（valid=0）
     const char* known_car_ids[] = {"CAR1", "CAR2", "CAR3", "CAR4"};
     for (int i = 0; i < 4 && i < MAX_OTHER_CARS; i++) {
         strncpy(other_cars[i].car_id, known_car_ids[i], sizeof(other_cars[i].car_id) - 1);
-        other_cars[i].valid = 0; // ʼΪ"δ"
+        other_cars[i].valid = 0; // 初始为"未上线"
         other_cars[i].position_x = 0;
         other_cars[i].position_y = 0;
         other_cars[i].yaw = 0;
     }
 
-    debug_print("[㲥] СϢʼɣCAR1~CAR4Ϣ\r\n");
+    debug_print("[广播] 其他小车信息数组初始化完成（含CAR1~CAR4基础信息）\r\n");
 }
 
 ESP8266_Status_t ESP8266_Init(void)
 {
-    debug_print("ʼʼESP8266...\r\n");
+    debug_print("开始初始化ESP8266...\r\n");
     
     Init_Other_Cars_Info();
 
     HAL_Delay(1000);
     
-    // ȷAT
+    // 先发送AT命令测试连接
     if(ESP8266_SendATCommand_Enhanced("AT", "OK", 3000) != ESP8266_OK) {
-        debug_print("ESP8266Ӧ\r\n");
+        debug_print("ESP8266无响应，请检查连接\r\n");
         return ESP8266_ERROR;
     }
     
     ESP8266_AutoAssignCarID();
-    Init_Communication_Topology();  // ʼͨ
+    Init_Communication_Topology();  // 初始化通信拓扑
     if(ESP8266_SendATCommand_Enhanced("AT+CWMODE=1", "OK", 3000) != ESP8266_OK) {
-        debug_print("ģʽʧ\r\n");
+        debug_print("设置模式失败\r\n");
         return ESP8266_ERROR;
     }
     
     char wifi_cmd[128];
     snprintf(wifi_cmd, sizeof(wifi_cmd), "AT+CWJAP=\"%s\",\"%s\"", WIFI_SSID, WIFI_PASSWORD);
     if(ESP8266_SendATCommand_Enhanced(wifi_cmd, "OK", 20000) != ESP8266_OK) {
-        debug_print("WiFiʧ\r\n");
+        debug_print("连接WiFi失败\r\n");
         return ESP8266_ERROR;
     }
     
-    // ʼUDPӣ
+    // 初始化UDP连接（单播）
     if(ESP8266_InitUDP() != ESP8266_OK) {
-        debug_print("UDPʼʧ\r\n");
+        debug_print("UDP初始化失败\r\n");
         return ESP8266_ERROR;
     }
     
-    // ʼ㲥
+    // 初始化广播连接
     if(ESP8266_InitBroadcast() != ESP8266_OK) {
-        debug_print("㲥ʼʧ\r\n");
+        debug_print("广播初始化失败\r\n");
         return ESP8266_ERROR;
     }
     
-    debug_print("ESP8266 UDP͹㲥ʼɹСID: ");
+    debug_print("ESP8266 UDP和广播初始化成功！小车ID: ");
     debug_print(CAR_ID);
     debug_print("\r\n");
     
@@ -641,12 +644,12 @@ ESP8266_Status_t ESP8266_Init(void)
     return ESP8266_OK;
 }
 
-// ֶι㲥ݣ޸汾ԭʼJSON汾ݣ
+// 处理精简版分段广播数据（修复版本，原始的JSON版本数据）
 void Process_Segmented_Broadcast(const char* json_data)
 {
-    // debug_print("[㲥] ֶι㲥\r\n");
+    // debug_print("[广播] 处理精简版分段广播数据\r\n");
     
-    // СID
+    // 解析小车ID
     char car_id[16] = {0};
     const char* id_ptr = strstr(json_data, "\"i\":\"");
     if (id_ptr != NULL) {
@@ -662,188 +665,179 @@ void Process_Segmented_Broadcast(const char* json_data)
     }
     
     if (strlen(car_id) == 0) {
-        // debug_print("[㲥] δҵЧСID\r\n");
+        // debug_print("[广播] 未找到有效小车ID\r\n");
         return;
     }
     
-    // ԼϢ
+    // 跳过自己的信息
     if (strcmp(car_id, CAR_ID) == 0) {
         return;
     }
     
-    // λϢ [x,y] ʽ
+    // 解析位置信息 [x,y] 数组格式
     float pos_x = 0, pos_y = 0;
     const char* pos_ptr = strstr(json_data, "\"p\":[");
     if (pos_ptr != NULL) {
-        sscanf(pos_ptr, "\"p\":[%f,%f]", &pos_x, &pos_y);
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, pos_ptr + 5, 64);
+        if (!(Num_Float(&cur, &pos_x) && Num_Expect(&cur, ',') && Num_Float(&cur, &pos_y))) return;
     }
     
-    // 
+    // 解析航向角
     float heading = 0;
     const char* h_ptr = strstr(json_data, "\"h\":");
     if (h_ptr != NULL) {
-        sscanf(h_ptr, "\"h\":%f", &heading);
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, h_ptr + 4, 32);
+        if (!Num_Float(&cur, &heading)) return;
     }
     
-    // ٶϢ [vx,vy,vz] ʽ
+    // 解析速度信息 [vx,vy,vz] 数组格式
     float vel_vx = 0, vel_vy = 0, vel_vz = 0;
     const char* vel_ptr = strstr(json_data, "\"v\":[");
     if (vel_ptr != NULL) {
-        sscanf(vel_ptr, "\"v\":[%f,%f,%f]", &vel_vx, &vel_vy, &vel_vz);
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, vel_ptr + 5, 96);
+        if (!(Num_Float(&cur, &vel_vx) && Num_Expect(&cur, ',') &&
+              Num_Float(&cur, &vel_vy) && Num_Expect(&cur, ',') && Num_Float(&cur, &vel_vz))) return;
     }
     
-    // ˹ˣǷӦôСϢ
+    // 可选的避碰标志，旧格式没有该字段时按不避让处理
+    int32_t reciprocal = 0;
+    const char* o_ptr = strstr(json_data, "\"o\":");
+    if (o_ptr != NULL) {
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, o_ptr + 4, 16);
+        if (!Num_Int(&cur, &reciprocal)) reciprocal = 0;
+    }
+    
+    // 拓扑过滤：检查是否应该处理这辆小车的信息
     if(!Should_Process_Car_Info(car_id)) {
         // char filter_msg[64];
         // snprintf(filter_msg, sizeof(filter_msg), 
-        //          "[]  %s Ϣƣ\r\n", car_id);
+        //          "[拓扑] 过滤 %s 的信息（拓扑限制）\r\n", car_id);
         // debug_print(filter_msg);
         return;
     }
     
-    // СϢ
-    Update_Other_Car_Info(car_id, pos_x, pos_y, vel_vx, vel_vy, vel_vz, heading);
+    // 更新其他小车信息
+    Update_Other_Car_Info(car_id, pos_x, pos_y, vel_vx, vel_vy, vel_vz, heading, (uint8_t)(reciprocal != 0));
     
-    // // ޸ڵϢӺʾ
+    // // 修复：在调试信息中添加航向角显示
     // char debug_msg[128];
     // snprintf(debug_msg, sizeof(debug_msg), 
-    //          "[㲥] С %s: λ(%.2f,%.2f) (%.1f) ٶ(%.3f,%.3f,%.3f)\r\n",
+    //          "[广播] 更新小车 %s: 位置(%.2f,%.2f) 航向(%.1f°) 速度(%.3f,%.3f,%.3f)\r\n",
     //          car_id, pos_x, pos_y, heading, vel_vx, vel_vy, vel_vz);
     // debug_print(debug_msg);
 }
 
-// ϲ㲥ݣ¸ʽȥѹݣ
+// 处理精简合并广播数据（新格式：去掉电压数据）
 void Process_Compact_Broadcast(const char* data)
 {    
-    // ӡԭʼڵ
+    // 打印原始数据用于调试
     char debug_raw[256];
     int data_len = strlen(data);
-    // snprintf(debug_raw, sizeof(debug_raw), "[㲥] ԭʼ(%dֽ): %s\r\n", data_len, data);
+    // snprintf(debug_raw, sizeof(debug_raw), "[广播] 原始数据(%d字节): %s\r\n", data_len, data);
     // debug_print(debug_raw);
     
-    // ϸݸʽ
-    // debug_print("[㲥] ݷ:\r\n");
+    // 详细分析数据格式
+    // debug_print("[广播] 数据分析:\r\n");
     
-    // ʼͽ
+    // 检查数据起始和结束标记
     if(data[0] != '[') {
-        // debug_print("[㲥] ? ݲ'['ͷ\r\n");
+        // debug_print("[广播] ? 数据不是以'['开头\r\n");
         return;
     }
     
     char* end_bracket = strchr(data, ']');
     if(end_bracket == NULL) {
-        // debug_print("[㲥] ? û']'β\r\n");
+        // debug_print("[广播] ? 数据没有以']'结尾\r\n");
         return;
     }
     
-    // debug_print("[㲥] ? ݸʽȷʼͽ\r\n");
+    // debug_print("[广播] ? 数据格式基本正确，有起始和结束标记\r\n");
     
-    // ݸʽ: [ CAR1 x y  vx vy vz CAR2 ...] ȥѹݣ
-    // ʾ: [4 CAR1 1.21 2.32 78.5 0.120 0.080 0.050 CAR2 2.21 3.32 38.2 1.120 4.900 0.080 CAR3 3.33 3.33 33.3 0.333 0.333 0.033 CAR4 4.44 4.44 44.4 0.444 0.444 0.044]
+    // 新数据格式: [数量 CAR1 x y 航向角 vx vy vz [避碰标志] CAR2 ...] （去掉电压数据，避碰标志可省略）
+    // 示例: [4 CAR1 1.21 2.32 78.5 0.120 0.080 0.050 CAR2 2.21 3.32 38.2 1.120 4.900 0.080 CAR3 3.33 3.33 33.3 0.333 0.333 0.033 CAR4 4.44 4.44 44.4 0.444 0.444 0.044]
     
-    // ͷ'['
-    const char* ptr = data + 1;
+    // One pass over the line, every field is read once //单次扫描，每个字段只读取一次
+    Num_Cursor_t cur;
+    Num_Cursor_Init(&cur, data + 1, end_bracket - data - 1);
     
-    // С
-    int car_count = 0;
-    if (sscanf(ptr, "%d", &car_count) != 1) {
-        // debug_print("[㲥] ? Сʧ\r\n");
+    // 解析小车数量
+    int32_t car_count = 0;
+    if (!Num_Int(&cur, &car_count)) {
+        // debug_print("[广播] ? 解析小车数量失败\r\n");
         return;
     }
     
-    char count_msg[32];
-    // snprintf(count_msg, sizeof(count_msg), "[㲥] ? С: %d\r\n", car_count);
-    // debug_print(count_msg);
-    
     if (car_count <= 0 || car_count > MAX_OTHER_CARS) {
-        // debug_print("[㲥] ? СЧ\r\n");
-        return;
-    }
-    
-    // ƶĿո
-    ptr = strchr(ptr, ' ');
-    if (ptr == NULL) {
-        // debug_print("[㲥] ? ݸʽҲĿո\r\n");
+        // debug_print("[广播] ? 小车数量无效\r\n");
         return;
     }
-    ptr++; // ո
     
-    // ÿСݣÿС7ֶΣȥѹ
+    // 解析每辆小车的数据（现在每个小车有7个字段，去掉电压）
     int processed_cars = 0;
     for (int i = 0; i < car_count; i++) {
-        char short_id[4] = {0};  // C1, C2
-        float pos_x = 0, pos_y = 0;
-        float heading = 0;  // ΪfloatͣС
-        float vx = 0, vy = 0, vz = 0;
+        char short_id[8];  // C1, C2等
+        float pos_x, pos_y;
+        float heading;  // 改为float类型，保留小数
+        float vx, vy, vz;
         
-        // Сݣ7ֶΣȥѹ
-        int parsed = sscanf(ptr, "%3s %f %f %f %f %f %f", 
-                           short_id, &pos_x, &pos_y, &heading, 
-                           &vx, &vy, &vz);
+        // 解析单个小车数据（7个字段，去掉电压），缺字段时停止
+        Num_Skip_Spaces(&cur);
+        if (!(Num_Token(&cur, short_id, sizeof(short_id), ' ') &&
+              Num_Float(&cur, &pos_x) && Num_Float(&cur, &pos_y) && Num_Float(&cur, &heading) &&
+              Num_Float(&cur, &vx) && Num_Float(&cur, &vy) && Num_Float(&cur, &vz))) {
+            break;
+        }
         
-        if (parsed == 7) {
-            // תIDΪID
-            char car_id[16];
-            snprintf(car_id, sizeof(car_id), "CAR%c", short_id[1]);
-            
-            // ԼϢ
-            if (strcmp(car_id, CAR_ID) != 0) {
-                // ˹ˣǷӦôСϢ
-                if(Should_Process_Car_Info(car_id)) {
-                    // СϢ
-                    Update_Other_Car_Info(car_id, pos_x, pos_y, vx, vy, vz, heading);
-                    
-                    processed_cars++;
-                } else {
-                }
-            } else {
-            }
-            
-            // ƶһС - ÿС7ֶ
-            for (int j = 0; j < 7; j++) {
-                ptr = strchr(ptr, ' ');
-                if (ptr == NULL) {
-                    if (i < car_count - 1) {
-                        // debug_print("[㲥] ?? ݲǰ\r\n");
-                    }
-                    break;
-                }
-                ptr++; // ո
-            }
-            
-            // Ѿַĩβǰ˳
-            if (ptr == NULL || *ptr == '\0' || *ptr == ']') {
-                break;
-            }
-        } else {
-           
+        // 可选的第8个字段为避碰标志(0/1)，下一辆车的ID以字母开头，据此区分新旧格式
+        int32_t reciprocal = 0;
+        Num_Skip_Spaces(&cur);
+        if (Num_Peek(&cur) >= '0' && Num_Peek(&cur) <= '9' && !Num_Int(&cur, &reciprocal)) {
             break;
         }
+        
+        // 转换短ID为完整ID，C1和CAR1都取最后一位数字
+        char car_id[16];
+        snprintf(car_id, sizeof(car_id), "CAR%c", short_id[strlen(short_id) - 1]);
+        
+        // 跳过自己的信息
+        if (strcmp(car_id, CAR_ID) != 0) {
+            // 拓扑过滤：检查是否应该处理这辆小车的信息
+            if(Should_Process_Car_Info(car_id)) {
+                // 更新其他小车信息
+                Update_Other_Car_Info(car_id, pos_x, pos_y, vx, vy, vz, heading, (uint8_t)(reciprocal != 0));
+                
+                processed_cars++;
+            }
+        }
     }
     
 }
 
 void Process_Broadcast_Data(const char* data)
 {
-    // ȼǷΪָ
+    // 首先检查是否为拓扑指令
     if (strstr(data, "TOPOLOGY") != NULL) {
-        debug_print("[㲥] ⵽ָת˴\r\n");
+        debug_print("[广播] 检测到拓扑指令，转发给拓扑处理函数\r\n");
         Process_Topology_Command(data);
         return;
     }
     
-    // ǷΪָ
+    // 检查是否为编队指令
     if (strstr(data, "FORMATION") != NULL) {
-        debug_print("[㲥] ⵽ָתӴ\r\n");
+        debug_print("[广播] 检测到编队指令，转发给编队处理函数\r\n");
         Process_Formation_Command(data);
         return;
     }
     
-    // ǷΪµľϲʽ
+    // 检查是否为新的精简合并格式
     if (data[0] == '[' && strchr(data, ']') != NULL) {
         Process_Compact_Broadcast(data);
     }
-    // ԭеJSONʽ
+    // 原有的JSON格式处理
     else if (strstr(data, "\"type\":\"broadcast_single\"") != NULL) {
         const char* json_start = strstr(data, "{");
         if (json_start != NULL) {
@@ -851,10 +845,10 @@ void Process_Broadcast_Data(const char* data)
         }
     }
     else {
-        // ʽ
-        debug_print("[㲥] δ֪㲥ݸʽͨô\r\n");
+        // 尝试其他格式
+        debug_print("[广播] 未知广播数据格式，尝试通用处理\r\n");
         
-        // ٴμǷΪ˻ָǰ׺
+        // 再次检查是否为拓扑或编队指令（可能有前缀）
         if (strstr(data, "TOPOLOGY") != NULL) {
             Process_Topology_Command(data);
         }
@@ -862,98 +856,101 @@ void Process_Broadcast_Data(const char* data)
             Process_Formation_Command(data);
         }
         else {
-            debug_print("[㲥] ޷ʶĹ㲥ݸʽ\r\n");
+            debug_print("[广播] 无法识别的广播数据格式\r\n");
         }
     }
 }
 
-// ݣָָָȣ
+// 处理单播数据（控制指令、编队指令、拓扑指令等）
 void Process_Unicast_Data(const char* data)
 {
-    // debug_print("[] \r\n");
+    // debug_print("[单播] 处理单播数据\r\n");
     
-    // ǷΪָ
+    // 检查数据是否为编队指令
     if(strstr(data, "FORMATION:") != NULL) {
-        debug_print("[] ⵽ָ\r\n");
+        debug_print("[单播] 检测到编队指令\r\n");
         Process_Formation_Command(data);
     }
     
-    // 
+    // 检查控制命令
     else if(strstr(data, "CTRL:") != NULL) {
-        debug_print("[] ⵽\r\n");
+        debug_print("[单播] 检测到控制命令\r\n");
         Process_Control_Command(data);
     }
-    // ָ
+    // 检查拓扑指令
     else if(strstr(data, "TOPOLOGY") != NULL) {
-        debug_print("[] ⵽ָ\r\n");
+        debug_print("[单播] 检测到拓扑指令\r\n");
         Process_Topology_Command(data);
     }
     else {
-        debug_print("[] δ֪ݸʽ\r\n");
+        debug_print("[单播] 未知单播数据格式\r\n");
     }
 }
 
-//  - ȷwifi_task.cеĶһ
+// 控制命令处理函数 - 确保与wifi_task.c中的定义一致
 void Process_Control_Command(const char* command)
 {
-    // ӡԭʼָڵ
+    // 打印原始指令用于调试
     char debug_msg[256];
     // snprintf(debug_msg, sizeof(debug_msg), 
-    //          "[WiFi] յԭʼָ: %s\r\n", command);
+    //          "[WiFi] 收到原始指令: %s\r\n", command);
     // debug_print(debug_msg);
     
-    // ʽ: "CTRL:CAR1,TARGET:1.5,2.3,45.0"
-    //  "+IPD,0,31:CTRL:CAR1,TARGET:0.00,0.00,0.0"
+    // 解析控制命令格式: "CTRL:CAR1,TARGET:1.5,2.3,45.0"
+    // 或者 "+IPD,0,31:CTRL:CAR1,TARGET:0.00,0.00,0.0"
     const char* ctrl_ptr = strstr(command, "CTRL:");
     if(ctrl_ptr != NULL) {
         char target_car[16];
         float target_x, target_y, target_yaw;
         
-        // ܵIPDǰ׺
+        // 跳过可能的IPD前缀
         if(ctrl_ptr != command) {
-            // ҵCTRL:֮λ
+            // 找到CTRL:之后的位置
             ctrl_ptr = strstr(command, "CTRL:");
         }
         
-        // ָ
-        if(sscanf(ctrl_ptr, "CTRL:%[^,],TARGET:%f,%f,%f", 
-                  target_car, &target_x, &target_y, &target_yaw) == 4) {
+        // 解析指令
+        Num_Cursor_t cur;
+        Num_Cursor_Init(&cur, ctrl_ptr + 5, 96);
+        if(Num_Token(&cur, target_car, sizeof(target_car), ',') && Num_Expect_Str(&cur, ",TARGET:") &&
+           Num_Float(&cur, &target_x) && Num_Expect(&cur, ',') &&
+           Num_Float(&cur, &target_y) && Num_Expect(&cur, ',') && Num_Float(&cur, &target_yaw)) {
             
-            // ǷǷ
+            // 检查是否是发给本车的命令
             if(strcmp(target_car, CAR_ID) == 0) {
                 // snprintf(debug_msg, sizeof(debug_msg), 
-                //          "[] Ŀλ(%.2f, %.2f), %.1f\r\n", 
+                //          "[控制] 目标位置(%.2f, %.2f), 航向%.1f\r\n", 
                 //          target_x, target_y, target_yaw);
                 // debug_print(debug_msg);
                 
-                // Ŀλúͺ
+                // 设置目标位置和航向
                 Target_position[0] = target_x;
                 Target_position[1] = target_y;
                 Target_Yaw = target_yaw;
                 newCoordinateReceived = 1;
                 Auto_mode = 1;
                 
-                // λõ־
+                // 重置位置到达标志
                 position_reached = 0;
                 
                 // snprintf(debug_msg, sizeof(debug_msg), 
-                //          "[] Զģʽ׼\r\n");
+                //          "[控制] 已设置自动模式，准备导航\r\n");
                 // debug_print(debug_msg);
             } else {
                 // snprintf(debug_msg, sizeof(debug_msg), 
-                //          "[] ָǷ(%s)\r\n", CAR_ID);
+                //          "[控制] 指令不是发给本车(%s)，忽略\r\n", CAR_ID);
                 // debug_print(debug_msg);
             }
         } else {
-            // debug_print("[] ָʽʧ\r\n");
+            // debug_print("[控制] 指令格式解析失败\r\n");
         }
     } else {
-        // debug_print("[] δҵCTRLָ\r\n");
+        // debug_print("[控制] 未找到CTRL指令\r\n");
     }
 }
 
-// СϢ
-void Update_Other_Car_Info(const char* car_id, float x, float y, float vx, float vy, float vz, float yaw)
+// 更新其他小车信息
+void Update_Other_Car_Info(const char* car_id, float x, float y, float vx, float vy, float vz, float yaw, uint8_t reciprocal)
 {
     uint32_t current_time = HAL_GetTick();
     
@@ -965,13 +962,16 @@ void Update_Other_Car_Info(const char* car_id, float x, float y, float vx, float
         }
     }
     
+    // 控制任务与本任务优先级相同，可能在时间片切换时读取车辆表，一行数据在临界区内整体写入
+    taskENTER_CRITICAL();
     if (existing_index >= 0) {
         other_cars[existing_index].position_x = x;
         other_cars[existing_index].position_y = y;
         other_cars[existing_index].velocity_vx = vx;
         other_cars[existing_index].velocity_vy = vy;
         other_cars[existing_index].velocity_vz = vz;
-        other_cars[existing_index].yaw = yaw;   // ͬ
+        other_cars[existing_index].yaw = yaw;   // 同步航向角
+        other_cars[existing_index].reciprocal = reciprocal;
         other_cars[existing_index].last_update = current_time;
     } else {
         for (int i = 0; i < MAX_OTHER_CARS; i++) {
@@ -982,7 +982,8 @@ void Update_Other_Car_Info(const char* car_id, float x, float y, float vx, float
                 other_cars[i].velocity_vx = vx;
                 other_cars[i].velocity_vy = vy;
                 other_cars[i].velocity_vz = vz;
-                other_cars[i].yaw = yaw;       // ʼ
+                other_cars[i].yaw = yaw;       // 初始化航向角
+                other_cars[i].reciprocal = reciprocal;
                 other_cars[i].last_update = current_time;
                 other_cars[i].valid = 1;
                 other_cars_count++;
@@ -990,9 +991,10 @@ void Update_Other_Car_Info(const char* car_id, float x, float y, float vx, float
             }
         }
     }
+    taskEXIT_CRITICAL();
 }
 
-// ӡСϢ
+// 打印所有其他小车信息
 void Print_Other_Cars_Info(void)
 {
     static uint32_t last_print_time = 0;
@@ -1011,7 +1013,7 @@ void Print_Other_Cars_Info(void)
             char debug_msg[256];
             uint32_t time_since_update = (current_time - other_cars[i].last_update) / 1000;
             snprintf(debug_msg, sizeof(debug_msg), 
-                     "[%d] %s: (%.2f,%.2f) (%.3f,%.3f,%.3f) [%luǰ]\r\n",
+                     "[%d] %s: (%.2f,%.2f) (%.3f,%.3f,%.3f) [%lu秒前]\r\n",
                      valid_count + 1, other_cars[i].car_id,
                      other_cars[i].position_x, other_cars[i].position_y,
                      other_cars[i].velocity_vx, other_cars[i].velocity_vy, other_cars[i].velocity_vz,
@@ -1022,17 +1024,17 @@ void Print_Other_Cars_Info(void)
     }
     
     if (valid_count == 0) {
-        debug_print("[㲥] СϢ\r\n");
+        debug_print("[广播] 暂无其他小车信息\r\n");
     } else {
         char count_msg[64];
         snprintf(count_msg, sizeof(count_msg), 
-                 "[㲥] ܼ: %d С\r\n", valid_count);
+                 "[广播] 总计: %d 辆其他小车\r\n", valid_count);
         debug_print(count_msg);
     }
     debug_print("====================\r\n");
 }
 
-// ʱСϢ30δ£
+// 清理过时的小车信息（30秒未更新）
 void Cleanup_Old_Car_Info(void)
 {
     uint32_t current_time = HAL_GetTick();
@@ -1043,7 +1045,7 @@ void Cleanup_Old_Car_Info(void)
             if (current_time - other_cars[i].last_update > 30000) {
                 char debug_msg[64];
                 snprintf(debug_msg, sizeof(debug_msg), 
-                         "[㲥] ƳС: %s\r\n", other_cars[i].car_id);
+                         "[广播] 移除离线小车: %s\r\n", other_cars[i].car_id);
                 debug_print(debug_msg);
                 
                 other_cars[i].valid = 0;
@@ -1056,45 +1058,61 @@ void Cleanup_Old_Car_Info(void)
     if (removed_count > 0) {
         char debug_msg[64];
         snprintf(debug_msg, sizeof(debug_msg), 
-                 "[㲥] Ƴ %d С\r\n", removed_count);
+                 "[广播] 移除了 %d 辆离线小车\r\n", removed_count);
         debug_print(debug_msg);
     }
 }
 
+// 解析+IPD,<link_id>,<data_len>:头部，完整时返回1
+static uint8_t Parse_IPD_Header(const char* ipd_ptr, int* link_id, int* data_len)
+{
+    Num_Cursor_t cur;
+    int32_t id, len;
+    
+    Num_Cursor_Init(&cur, ipd_ptr, 24);
+    if (!(Num_Expect_Str(&cur, "+IPD,") && Num_Int(&cur, &id) && Num_Expect(&cur, ',') &&
+          Num_Int(&cur, &len) && Num_Expect(&cur, ':'))) {
+        return 0;
+    }
+    *link_id = id;
+    *data_len = len;
+    return 1;
+}
+
 void Process_Multiple_IPD_Packets(char* data_start, uint32_t data_length)
 {
     char* current_ptr = data_start;
     uint32_t remaining_length = data_length;
     int processed_packets = 0;
     
-    while (remaining_length > 0 && processed_packets < 10) { // ദ10ֹѭ
-        // һ +IPD ͷ
+    while (remaining_length > 0 && processed_packets < 10) { // 最多处理10个包防止无限循环
+        // 查找下一个 +IPD 开头
         char* ipd_ptr = strstr(current_ptr, "+IPD");
         if (ipd_ptr == NULL) {
-            break; // ûи +IPD 
+            break; // 没有更多 +IPD 包
         }
         
-        // 㵱ǰڻеλ
+        // 计算当前包在缓冲区中的位置
         uint32_t current_offset = ipd_ptr - data_start;
         if (current_offset >= data_length) {
-            break; // Χ
+            break; // 超出范围
         }
         
-        //  +IPD 
+        // 解析这个 +IPD 包
         int link_id = 0;
         int data_len = 0;
         char* colon_ptr = NULL;
         
-        // Խʽ: +IPD,<link_id>,<data_len>:<data>
-        if (sscanf(ipd_ptr, "+IPD,%d,%d:", &link_id, &data_len) == 2) {
+        // 尝试解析格式: +IPD,<link_id>,<data_len>:<data>
+        if (Parse_IPD_Header(ipd_ptr, &link_id, &data_len)) {
             colon_ptr = strchr(ipd_ptr, ':');
             if (colon_ptr != NULL) {
                 char* packet_data_start = colon_ptr + 1;
                 
-                // ȷݳЧҲԽ
+                // 确保数据长度有效且不会越界
                 uint32_t packet_end_offset = (packet_data_start + data_len) - data_start;
                 if (packet_end_offset <= data_length) {
-                    // ʱ浱ǰݰ
+                    // 临时保存当前数据包
                     char temp_packet[256];
                     int copy_len = data_len < (int)sizeof(temp_packet)-1 ? data_len : sizeof(temp_packet)-1;
                     strncpy(temp_packet, packet_data_start, copy_len);
@@ -1102,21 +1120,21 @@ void Process_Multiple_IPD_Packets(char* data_start, uint32_t data_length)
                     
                     char debug_msg[128];
                     // snprintf(debug_msg, sizeof(debug_msg), 
-                    //          "[] ճ %d: ID=%d, Len=%d, Data=%.*s\r\n", 
+                    //          "[多包] 处理粘连包 %d: ID=%d, Len=%d, Data=%.*s\r\n", 
                     //          processed_packets + 1, link_id, data_len, 30, temp_packet);
                     // debug_print(debug_msg);
                     
-                    // ڶУ޸ݴ֣
+                    // 在多包处理函数中，修改数据处理部分：
                     if (link_id == 0) {
-                        // debug_print("[] \r\n");
+                        // debug_print("[多包] 处理单播数据\r\n");
                         Process_Unicast_Data(temp_packet);
                     } else if (link_id == 1) {
-                        // debug_print("[] 㲥\r\n");
+                        // debug_print("[多包] 处理广播数据\r\n");
                         
-                        // رضϵ
+                        // 特别处理截断的拓扑数据
                         if (strstr(temp_packet, "TOPOLOGY:") != NULL && data_len == 40) {
-                            // debug_print("[] ⵽ܱضϵݣ⴦\r\n");
-                            // ߼϶߼¼
+                            // debug_print("[多包] 检测到可能被截断的拓扑数据，尝试特殊处理\r\n");
+                            // 这里可以添加逻辑来组合多个包，或者记录不完整的数据
                         }
                         
                         Process_Broadcast_Data(temp_packet);
@@ -1124,33 +1142,33 @@ void Process_Multiple_IPD_Packets(char* data_start, uint32_t data_length)
                     
                     processed_packets++;
                     
-                    // ƶһ
+                    // 移动到下一个包
                     current_ptr = packet_data_start + data_len;
                     remaining_length = data_length - (current_ptr - data_start);
                     continue;
                 } else {
-                    // debug_print("[] ݳȳΧ\r\n");
+                    // debug_print("[多包] 数据长度超出缓冲区范围\r\n");
                 }
             } else {
-                // debug_print("[] δҵðŷָ\r\n");
+                // debug_print("[多包] 未找到冒号分隔符\r\n");
             }
         } else {
-            // debug_print("[] +IPDʽʧ\r\n");
+            // debug_print("[多包] 解析+IPD格式失败\r\n");
         }
         
-        // ʧܣԱý
+        // 如果解析失败，尝试备用解析
         char* comma1 = strchr(ipd_ptr, ',');
         if (comma1 != NULL) {
             char* comma2 = strchr(comma1 + 1, ',');
             if (comma2 != NULL) {
                 char* colon = strchr(comma2 + 1, ':');
                 if (colon != NULL) {
-                    // ֶ
-                    link_id = atoi(comma1 + 1);
-                    data_len = atoi(comma2 + 1);
+                    // 手动解析
+                    link_id = Num_Atoi(comma1 + 1, 8);
+                    data_len = Num_Atoi(comma2 + 1, 8);
                     char* packet_data_start = colon + 1;
                     
-                    // ȷݳЧ
+                    // 确保数据长度有效
                     uint32_t packet_end_offset = (packet_data_start + data_len) - data_start;
                     if (packet_end_offset <= data_length) {
                         char temp_packet[256];
@@ -1160,7 +1178,7 @@ void Process_Multiple_IPD_Packets(char* data_start, uint32_t data_length)
                         
                         char debug_msg[128];
                         // snprintf(debug_msg, sizeof(debug_msg), 
-                        //          "[] ֶ %d: ID=%d, Len=%d\r\n", 
+                        //          "[多包] 手动解析包 %d: ID=%d, Len=%d\r\n", 
                         //          processed_packets + 1, link_id, data_len);
                         // debug_print(debug_msg);
                         
@@ -1179,14 +1197,14 @@ void Process_Multiple_IPD_Packets(char* data_start, uint32_t data_length)
             }
         }
         
-        // ޷һַ
-        current_ptr = ipd_ptr + 4; //  "+IPD"
+        // 如果都无法解析，跳到下一个字符继续查找
+        current_ptr = ipd_ptr + 4; // 跳过 "+IPD"
         remaining_length = data_length - (current_ptr - data_start);
     }
     
     char result_msg[64];
     // snprintf(result_msg, sizeof(result_msg), 
-    //          "[] ɣ %d \r\n", processed_packets);
+    //          "[多包] 处理完成，共处理 %d 个包\r\n", processed_packets);
     // debug_print(result_msg);
 }
 
@@ -1195,94 +1213,94 @@ void ESP8266_Process(void)
     if(esp8266_rx_index > 0) {
         esp8266_rx_buffer[esp8266_rx_index] = '\0';
         
-        // // ȴӡԭʼڵ
-        // debug_print("\r\n[WiFi] յݣʼ...\r\n");
+        // // 首先打印原始数据用于调试
+        // debug_print("\r\n[WiFi] 收到数据，开始处理...\r\n");
         // ESP8266_PrintRawData((char*)esp8266_rx_buffer, esp8266_rx_index);
         
         char* data_start = (char*)esp8266_rx_buffer;
         uint32_t data_length = esp8266_rx_index;
         
-        // ǷΪ+IPDճ
+        // 检查是否为多个+IPD包粘连的情况
         int ipd_count = 0;
         char* search_ptr = data_start;
         while((search_ptr = strstr(search_ptr, "+IPD")) != NULL) {
             ipd_count++;
-            search_ptr += 4; //  "+IPD"
+            search_ptr += 4; // 跳过 "+IPD"
         }
         
         if(ipd_count > 1) {
             char count_msg[64];
             // snprintf(count_msg, sizeof(count_msg), 
-            //          "[] ⵽ %d ճIPD\r\n", ipd_count);
+            //          "[多包] 检测到 %d 个粘连的IPD包\r\n", ipd_count);
             // debug_print(count_msg);
             
-            // ʹö
+            // 使用多包处理函数
             Process_Multiple_IPD_Packets(data_start, data_length);
         } else {
-            // ԭеĵ߼
+            // 原有的单包处理逻辑
             char* ipd_ptr = strstr(data_start, "+IPD");
             if(ipd_ptr != NULL) {
-                debug_print("[WiFi] ⵽+IPDʽ\r\n");
+                debug_print("[WiFi] 检测到+IPD格式数据\r\n");
                 
                 int link_id = 0;
                 int data_len = 0;
                 
-                // ʽ: +IPD,<link_id>,<data_len>:<data>
-                if(sscanf(ipd_ptr, "+IPD,%d,%d:", &link_id, &data_len) == 2) {
+                // 解析格式: +IPD,<link_id>,<data_len>:<data>
+                if(Parse_IPD_Header(ipd_ptr, &link_id, &data_len)) {
                     char link_msg[64];
                     // snprintf(link_msg, sizeof(link_msg), 
-                    //          "[WiFi] ɹ: ID=%d, ݳ=%d\r\n", link_id, data_len);
+                    //          "[WiFi] 解析成功: 连接ID=%d, 数据长度=%d\r\n", link_id, data_len);
                     // debug_print(link_msg);
                     
-                    // ҵðλ
+                    // 找到冒号位置
                     char* colon_ptr = strchr(ipd_ptr, ':');
                     if(colon_ptr != NULL) {
-                        data_start = colon_ptr + 1; // ð
+                        data_start = colon_ptr + 1; // 跳过冒号
                         
-                        // ȷݳȲ
+                        // 确保数据长度不超过缓冲区
                         if(data_len > 0 && data_len < 1024) {
-                            // IDж
+                            // 根据连接ID判断数据类型
                             if(link_id == 0) {
-                                // 0ݣָָȣ
-                                // debug_print("[WiFi] \r\n");
+                                // 连接0：单播数据（控制指令、编队指令等）
+                                // debug_print("[WiFi] 处理单播数据\r\n");
                                 // Process_Unicast_Data(data_start);
                             } else if(link_id == 1) {
-                                // 1㲥ݣС״̬
-                                // debug_print("[WiFi] 㲥\r\n");
+                                // 连接1：广播数据（其他小车状态）
+                                // debug_print("[WiFi] 处理广播数据\r\n");
                                 // Process_Broadcast_Data(data_start);
                             } else {
                                 char unknown_msg[32];
                                 // snprintf(unknown_msg, sizeof(unknown_msg), 
-                                //          "[WiFi] δ֪ID: %d\r\n", link_id);
+                                //          "[WiFi] 未知连接ID: %d\r\n", link_id);
                                 // debug_print(unknown_msg);
                             }
                         } else {
-                            debug_print("[WiFi] ݳЧ\r\n");
+                            debug_print("[WiFi] 数据长度无效\r\n");
                         }
                     } else {
-                        debug_print("[WiFi] δҵðŷָ\r\n");
+                        debug_print("[WiFi] 未找到冒号分隔符\r\n");
                     }
                 } else {
-                    debug_print("[WiFi] +IPDʽʧܣԱý\r\n");
+                    debug_print("[WiFi] 解析+IPD格式失败，尝试备用解析\r\n");
                     
-                    // ýֶ+IPDʽ
+                    // 备用解析：手动解析+IPD格式
                     char* comma1 = strchr(ipd_ptr, ',');
                     if(comma1 != NULL) {
                         char* comma2 = strchr(comma1 + 1, ',');
                         if(comma2 != NULL) {
                             char* colon = strchr(comma2 + 1, ':');
                             if(colon != NULL) {
-                                // ֶIDݳ
-                                link_id = atoi(comma1 + 1);
-                                data_len = atoi(comma2 + 1);
+                                // 手动解析连接ID和数据长度
+                                link_id = Num_Atoi(comma1 + 1, 8);
+                                data_len = Num_Atoi(comma2 + 1, 8);
                                 data_start = colon + 1;
                                 
                                 char manual_msg[64];
                                 // snprintf(manual_msg, sizeof(manual_msg), 
-                                //          "[WiFi] ֶ: ID=%d, Len=%d\r\n", link_id, data_len);
+                                //          "[WiFi] 手动解析: ID=%d, Len=%d\r\n", link_id, data_len);
                                 // debug_print(manual_msg);
                                 
-                                // ID
+                                // 根据连接ID处理数据
                                 if(link_id == 0) {
                                     Process_Unicast_Data(data_start);
                                 } else if(link_id == 1) {
@@ -1293,59 +1311,59 @@ void ESP8266_Process(void)
                     }
                 }
             }
-            // ǷΪֱӵıָû+IPDǰ׺
+            // 检查是否为直接的编队指令（没有+IPD前缀）
             else if(strstr(data_start, "FORMATION:") != NULL) {
-                // debug_print("[WiFi] ⵽ֱӱָ\r\n");
+                // debug_print("[WiFi] 检测到直接编队指令\r\n");
                 Process_Formation_Command(data_start);
             }
-            // ǷΪֱӵľϲ㲥ʽ ('['ͷ)
+            // 检查是否为直接的精简合并广播格式 (以'['开头)
             else if(data_start[0] == '[') {
-                // debug_print("[WiFi] ⵽ֱӵľϲ㲥ʽ\r\n");
+                // debug_print("[WiFi] 检测到直接的精简合并广播格式\r\n");
                 Process_Compact_Broadcast(data_start);
             }
-            // ǷΪJSONʽ ('{'ͷ)
+            // 检查是否为JSON格式 (以'{'开头)
             else if(data_start[0] == '{') {
-                // debug_print("[WiFi] ⵽JSONʽ\r\n");
+                // debug_print("[WiFi] 检测到JSON格式数据\r\n");
                 Process_Broadcast_Data(data_start);
             }
-            // 
+            // 检查控制命令
             else if(strstr(data_start, "CTRL:") != NULL) {
-                // debug_print("[WiFi] ⵽\r\n");
+                // debug_print("[WiFi] 检测到控制命令\r\n");
                 Process_Control_Command(data_start);
             }
-            // ָ
+            // 检查拓扑指令
             else if(strstr(data_start, "TOPOLOGY") != NULL) {
-                // debug_print("[WiFi] ⵽ָ\r\n");
+                // debug_print("[WiFi] 检测到拓扑指令\r\n");
                 Process_Topology_Command(data_start);
             }
             else {
-                debug_print("[WiFi] δ֪ݸʽ\r\n");
+                debug_print("[WiFi] 未知数据格式\r\n");
                 
-                // δ֪ݣԶֽʽ
-                debug_print("[WiFi] Զֽʽ...\r\n");
+                // 对于未知数据，尝试多种解析方式
+                debug_print("[WiFi] 尝试多种解析方式...\r\n");
                 
-                // 1. Բ+IPDַܱţ
+                // 1. 尝试查找+IPD（可能被其他字符干扰）
                 char* search_ptr = data_start;
                 while((search_ptr = strstr(search_ptr, "IPD")) != NULL) {
                     if(search_ptr > data_start && *(search_ptr - 1) == '+') {
-                        debug_print("[WiFi] ҵŵ+IPDʽ\r\n");
-                        // Ӵ߼
+                        debug_print("[WiFi] 找到被干扰的+IPD格式\r\n");
+                        // 这里可以添加处理逻辑
                         break;
                     }
                     search_ptr++;
                 }
                 
-                // 2. Ϊ㲥ݴ
+                // 2. 尝试作为广播数据处理
                 Process_Broadcast_Data(data_start);
             }
         }
         
-        // 
+        // 清理缓冲区
         esp8266_rx_index = 0;
         memset(esp8266_rx_buffer, 0, sizeof(esp8266_rx_buffer));
     } 
     
-    // ʱϢ
+    // 定期清理过时信息
     static uint32_t last_cleanup_time = 0;
     uint32_t current_time = HAL_GetTick();
     if (current_time - last_cleanup_time > 10000) {
@@ -1354,81 +1372,81 @@ void ESP8266_Process(void)
     }
 }
 
-// ӵԴӡ
+// 添加调试打印函数
 void ESP8266_PrintRawData(const char* data, uint32_t length)
 {
     static uint32_t last_print_time = 0;
     uint32_t current_time = HAL_GetTick();
     
-    // ƴӡƵʣˢ
+    // 限制打印频率，避免刷屏
     if(current_time - last_print_time < 100) {
         return;
     }
     last_print_time = current_time;
     
-    debug_print("\r\n=== ԭʼݿʼ ===\r\n");
+    debug_print("\r\n=== 原始数据开始 ===\r\n");
     
-    // ӡݳ
+    // 打印数据长度
     char len_msg[32];
-    snprintf(len_msg, sizeof(len_msg), "ݳ: %lu ֽ\r\n", length);
+    snprintf(len_msg, sizeof(len_msg), "数据长度: %lu 字节\r\n", length);
     debug_print(len_msg);
     
-    // ӡASCIIַ
+    // 打印ASCII字符
     debug_print("ASCII: ");
     for(uint32_t i = 0; i < length && i < 128; i++) {
-        if(data[i] >= 32 && data[i] <= 126) {  // ɴӡַ
+        if(data[i] >= 32 && data[i] <= 126) {  // 可打印字符
             char ch[2] = {data[i], '\0'};
             debug_print(ch);
         } else {
-            debug_print(".");  // Ǵӡַõʾ
+            debug_print(".");  // 非打印字符用点表示
         }
     }
     debug_print("\r\n");
     
-    // ӡʮ
+    // 打印十六进制
     debug_print("HEX:   ");
     for(uint32_t i = 0; i < length && i < 64; i++) {
         char hex[4];
         snprintf(hex, sizeof(hex), "%02X ", (uint8_t)data[i]);
         debug_print(hex);
         
-        // ÿ16ֽڻ
+        // 每16字节换行
         if((i + 1) % 16 == 0 && i + 1 < length) {
             debug_print("\r\n       ");
         }
     }
     debug_print("\r\n");
     
-    // ַرע
+    // 如果有特殊字符，特别标注
     for(uint32_t i = 0; i < length; i++) {
         if(data[i] == '\r') {
-            debug_print("ֻس(\\r)\r\n");
+            debug_print("发现回车符(\\r)\r\n");
         } else if(data[i] == '\n') {
-            debug_print("ֻз(\\n)\r\n");
+            debug_print("发现换行符(\\n)\r\n");
         } else if(data[i] == '\0') {
-            debug_print("ַֿ(\\0)\r\n");
+            debug_print("发现空字符(\\0)\r\n");
         }
     }
     
-    debug_print("=== ԭʼݽ ===\r\n\r\n");
+    debug_print("=== 原始数据结束 ===\r\n\r\n");
 }
 
-// ӡջ
+// 打印接收缓冲区内容
 void ESP8266_Debug_PrintBuffer(void)
 {
-    debug_print("\r\n=== ջ״̬ ===\r\n");
+    debug_print("\r\n=== 接收缓冲区状态 ===\r\n");
     
     char buf_info[64];
     snprintf(buf_info, sizeof(buf_info), 
-             ": %d, С: %lu\r\n", 
+             "缓冲区索引: %d, 缓冲区大小: %lu\r\n", 
              esp8266_rx_index, sizeof(esp8266_rx_buffer));
     debug_print(buf_info);
     
     if(esp8266_rx_index > 0) {
         ESP8266_PrintRawData((char*)esp8266_rx_buffer, esp8266_rx_index);
     } else {
-        debug_print("ջΪ\r\n");
+        debug_print("接收缓冲区为空\r\n");
     }
     
-    debug_print("=== ״̬ ===\r\n\r\n");
+    debug_print("=== 缓冲区状态结束 ===\r\n\r\n");
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "host_link.h"
+#include "usartx.h"
+#include "balance.h"
+
+Host_Link_t Host_Link;
+
+static UART_HandleTypeDef Host_Uart;
+static DMA_HandleTypeDef Host_Rx_Dma, Host_Tx_Dma;
+static uint8_t Host_Rx_Ring[HOST_LINK_RX_RING];
+static uint16_t Host_Rx_Tail;
+static uint8_t Host_Frame_Len;      //Bytes of the command frame collected so far //已收集的指令帧字节数
+
+static uint8_t Host_Check_Sum(const uint8_t *p, uint8_t len)
+{
+	uint8_t x = 0;
+
+	while(len--) x ^= *p++;
+	return x;
+}
+
+static void Host_Put_Short(uint8_t *p, short v)
+{
+	p[0] = (uint8_t)((uint16_t)v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static short Host_Get_Short(const uint8_t *p)
+{
+	return (short)((p[0] << 8) | p[1]);
+}
+
+static void Host_Dma_Config(DMA_HandleTypeDef *h, DMA_Stream_TypeDef *stream, uint32_t direction, uint32_t mode)
+{
+	h->Instance = stream;
+	h->Init.Channel = HOST_LINK_DMA_CHANNEL;
+	h->Init.Direction = direction;
+	h->Init.PeriphInc = DMA_PINC_DISABLE;
+	h->Init.MemInc = DMA_MINC_ENABLE;
+	h->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	h->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	h->Init.Mode = mode;
+	h->Init.Priority = DMA_PRIORITY_LOW;
+	h->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+}
+
+/**************************************************************************
+Function: Set up the UART, its pins and both DMA streams, start the reception
+Input   : none
+Output  : none
+函数功能：初始化串口、引脚和两个DMA数据流，启动接收
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Link_Init(void)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	HOST_LINK_CLK_ENABLE();
+
+	GPIO_InitStruct.Pin = HOST_LINK_PINS;
+	GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull = GPIO_PULLUP;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	GPIO_InitStruct.Alternate = HOST_LINK_AF;
+	HAL_GPIO_Init(HOST_LINK_PORT, &GPIO_InitStruct);
+
+	Host_Uart.Instance = HOST_LINK_USART;
+	Host_Uart.Init.BaudRate = HOST_LINK_BAUD;
+	Host_Uart.Init.WordLength = UART_WORDLENGTH_8B;
+	Host_Uart.Init.StopBits = UART_STOPBITS_1;
+	Host_Uart.Init.Parity = UART_PARITY_NONE;
+	Host_Uart.Init.Mode = UART_MODE_TX_RX;
+	Host_Uart.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Host_Uart.Init.OverSampling = UART_OVERSAMPLING_16;
+	if(HAL_UART_Init(&Host_Uart) != HAL_OK) return;
+
+	Host_Dma_Config(&Host_Rx_Dma, HOST_LINK_RX_STREAM, DMA_PERIPH_TO_MEMORY, DMA_CIRCULAR);
+	Host_Dma_Config(&Host_Tx_Dma, HOST_LINK_TX_STREAM, DMA_MEMORY_TO_PERIPH, DMA_NORMAL);
+	if(HAL_DMA_Init(&Host_Rx_Dma) != HAL_OK || HAL_DMA_Init(&Host_Tx_Dma) != HAL_OK) return;
+
+	//The streams are driven directly, their interrupts stay off //直接驱动数据流，不开启中断
+	if(HAL_DMA_Start(&Host_Rx_Dma, (uint32_t)&HOST_LINK_USART->DR, (uint32_t)Host_Rx_Ring, HOST_LINK_RX_RING) != HAL_OK) return;
+	SET_BIT(HOST_LINK_USART->CR3, USART_CR3_DMAR | USART_CR3_DMAT);
+	Host_Rx_Tail = 0;
+	Host_Link.Ready = 1;
+}
+
+/**************************************************************************
+Function: Check one collected command frame and take its velocities
+Input   : f: RECEIVE_DATA_SIZE bytes starting with FRAME_HEADER
+Output  : 1: valid frame
+函数功能：校验收集到的指令帧并取出速度
+入口参数：f：以FRAME_HEADER开始的RECEIVE_DATA_SIZE个字节
+返回  值：1：有效帧
+**************************************************************************/
+static uint8_t Host_Take_Command(const uint8_t *f)
+{
+	uint8_t gap;
+
+	if(f[RECEIVE_DATA_SIZE - 1] != FRAME_TAIL || Host_Check_Sum(f, RECEIVE_DATA_SIZE - 2) != f[RECEIVE_DATA_SIZE - 2])
+		return 0;
+
+	Receive_Data.Control_Str.Frame_Header = f[0];
+	Receive_Data.Control_Str.X_speed = Host_Get_Short(&f[3]) * 0.001f;
+	Receive_Data.Control_Str.Y_speed = Host_Get_Short(&f[5]) * 0.001f;
+	Receive_Data.Control_Str.Z_speed = Host_Get_Short(&f[7]) * 0.001f;
+	Receive_Data.Control_Str.Frame_Tail = f[RECEIVE_DATA_SIZE - 1];
+
+	//Missing sequence numbers are lost frames, a repeat is counted as none //缺失的序号为丢失的帧，重复帧不计
+	gap = (uint8_t)(f[1] - Host_Link.Rx_Seq - 1);
+	if(Host_Link.Rx_Frames > 0 && gap < 128) Host_Link.Rx_Lost += gap;
+	Host_Link.Rx_Seq = f[1];
+	Host_Link.Rx_Frames++;
+
+	Host_Link.Vx = Receive_Data.Control_Str.X_speed;
+	Host_Link.Vy = Receive_Data.Control_Str.Y_speed;
+	Host_Link.Vz = Receive_Data.Control_Str.Z_speed;
+	Host_Link.Command_Tick = HAL_GetTick();
+	return 1;
+}
+
+/**************************************************************************
+Function: Read the bytes the DMA stored since the last call and decode the command frames
+Input   : none
+Output  : none
+函数功能：读取上次调用以来DMA存入的字节并解码指令帧
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Link_Poll(void)
+{
+	uint32_t start = getCycleCnt();
+	uint16_t head;
+	uint8_t *f = Receive_Data.buffer, k;
+
+	if(!Host_Link.Ready) return;
+
+	head = HOST_LINK_RX_RING - __HAL_DMA_GET_COUNTER(&Host_Rx_Dma);
+	if(head >= HOST_LINK_RX_RING) head = 0;
+	while(Host_Rx_Tail != head)
+	{
+		uint8_t b = Host_Rx_Ring[Host_Rx_Tail];
+		Host_Rx_Tail = (Host_Rx_Tail + 1) % HOST_LINK_RX_RING;
+
+		if(Host_Frame_Len == 0 && b != FRAME_HEADER) continue;
+		f[Host_Frame_Len++] = b;
+		if(Host_Frame_Len < RECEIVE_DATA_SIZE) continue;
+
+		if(Host_Take_Command(f)) Host_Frame_Len = 0;
+		else
+		{
+			//Resynchronise on the next header inside the bad frame //在错误帧内寻找下一个帧头重新同步
+			Host_Link.Rx_Bad++;
+			for(k = 1; k < RECEIVE_DATA_SIZE && f[k] != FRAME_HEADER; k++);
+			Host_Frame_Len = RECEIVE_DATA_SIZE - k;
+			memmove(f, &f[k], Host_Frame_Len);
+		}
+	}
+	Host_Link.Cycles = getCycleCnt() - start;
+}
+
+/**************************************************************************
+Function: Hand the status frame of this cycle to the DMA, called at the end of Balance_task
+Input   : none
+Output  : none
+函数功能：把本周期的状态帧交给DMA发送，在Balance_task周期末尾调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Link_Send(void)
+{
+	uint32_t start = getCycleCnt();
+	uint8_t *p = Send_Data.buffer;
+
+	if(!Host_Link.Ready) return;
+
+	//The stream clears EN when the last frame is out //上一帧发完后数据流自动清除EN
+	if(Host_Tx_Dma.Instance->CR & DMA_SxCR_EN)
+	{
+		Host_Link.Tx_Busy++;
+		return;
+	}
+	HAL_DMA_PollForTransfer(&Host_Tx_Dma, HAL_DMA_FULL_TRANSFER, 0);
+
+	Send_Data.Sensor_Str.Frame_Header = FRAME_HEADER;
+	Send_Data.Sensor_Str.X_speed = (short)(Current_Vx * 1000.0f);
+	Send_Data.Sensor_Str.Y_speed = (short)(Current_Vy * 1000.0f);
+	Send_Data.Sensor_Str.Z_speed = (short)(Current_Vz * 1000.0f);
+	Send_Data.Sensor_Str.Power_Voltage = (short)(Voltage * 1000.0f);
+	Send_Data.Sensor_Str.Accelerometer.X_data = accel[0];
+	Send_Data.Sensor_Str.Accelerometer.Y_data = accel[1];
+	Send_Data.Sensor_Str.Accelerometer.Z_data = accel[2];
+	Send_Data.Sensor_Str.Gyroscope.X_data = gyro[0];
+	Send_Data.Sensor_Str.Gyroscope.Y_data = gyro[1];
+	Send_Data.Sensor_Str.Gyroscope.Z_data = gyro[2];
+	Send_Data.Sensor_Str.Frame_Tail = FRAME_TAIL;
+
+	p[0] = Send_Data.Sensor_Str.Frame_Header;
+	p[1] = (Host_Link.Tx_Seq++ & 0x7F) | (Flag_Stop ? 0x80 : 0);
+	Host_Put_Short(&p[2], Send_Data.Sensor_Str.X_speed);
+	Host_Put_Short(&p[4], Send_Data.Sensor_Str.Y_speed);
+	Host_Put_Short(&p[6], Send_Data.Sensor_Str.Z_speed);
+	Host_Put_Short(&p[8], Send_Data.Sensor_Str.Accelerometer.X_data);
+	Host_Put_Short(&p[10], Send_Data.Sensor_Str.Accelerometer.Y_data);
+	Host_Put_Short(&p[12], Send_Data.Sensor_Str.Accelerometer.Z_data);
+	Host_Put_Short(&p[14], Send_Data.Sensor_Str.Gyroscope.X_data);
+	Host_Put_Short(&p[16], Send_Data.Sensor_Str.Gyroscope.Y_data);
+	Host_Put_Short(&p[18], Send_Data.Sensor_Str.Gyroscope.Z_data);
+	Host_Put_Short(&p[20], Send_Data.Sensor_Str.Power_Voltage);
+	p[22] = Host_Check_Sum(p, SEND_DATA_SIZE - 2);
+	p[23] = Send_Data.Sensor_Str.Frame_Tail;
+
+	//TC is cleared before the stream is enabled //启动数据流前清除TC标志
+	CLEAR_BIT(HOST_LINK_USART->SR, USART_SR_TC);
+	if(HAL_DMA_Start(&Host_Tx_Dma, (uint32_t)p, (uint32_t)&HOST_LINK_USART->DR, SEND_DATA_SIZE) == HAL_OK)
+		Host_Link.Tx_Frames++;
+
+	Host_Link.Cycles += getCycleCnt() - start;
+	if(Host_Link.Cycles > Host_Link.Cycles_Max) Host_Link.Cycles_Max = Host_Link.Cycles;
+}
+
+/**************************************************************************
+Function: Whether the host is streaming commands
+Input   : none
+Output  : 1: a valid command arrived within HOST_LINK_TIMEOUT_MS
+函数功能：上位机是否正在发送指令
+入口参数：无
+返回  值：1：HOST_LINK_TIMEOUT_MS内收到过有效指令
+**************************************************************************/
+uint8_t Host_Link_Active(void)
+{
+	return Host_Link.Rx_Frames > 0 && (HAL_GetTick() - Host_Link.Command_Tick) < HOST_LINK_TIMEOUT_MS;
+}
+
+/**************************************************************************
+Function: Drive with the host's body velocity command
+Input   : none
+Output  : none
+函数功能：按上位机的车体速度指令运动
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Link_Control(void)
+{
+	Drive_Motor(Host_Link.Vx, Host_Link.Vy, Host_Link.Vz);
+}
@@ -0,0 +1,58 @@
+#ifndef __HOST_LINK_H
+#define __HOST_LINK_H
+#include "system.h"
+
+//Binary link to an onboard computer with the SEND_DATA / RECEIVE_DATA frames
+//of usartx.h, both directions once per control cycle (100 Hz). The UART is
+//served by DMA only: reception runs into a circular buffer that Balance_task
+//reads at the start of the cycle, the status frame is handed to the DMA at
+//the end of the cycle and sent while the next cycle waits. No interrupt is
+//used, the CPU time per cycle is a few microseconds.
+//与上位机之间使用usartx.h中SEND_DATA/RECEIVE_DATA帧的二进制链路，每个控制周期(100Hz)双向各一帧。
+//串口收发只使用DMA：接收数据循环写入缓冲区，由Balance_task在周期开始时读取；状态帧在周期末交给DMA，
+//在等待下一周期时发出。不使用中断，每周期CPU耗时为几微秒
+//
+//Frames, 16 bit values high byte first //帧格式，16位数据高字节在前
+//  SEND_DATA   7B | seq+stop | Vx Vy Vz (mm/s, mrad/s) | accel xyz | gyro xyz | battery mV | XOR | 7D
+//  RECEIVE_DATA 7B | seq | 0 | Vx Vy Vz (mm/s, mrad/s) | XOR | 7D
+//Byte 1 of the status frame carries a 7 bit sequence counter and Flag_Stop in
+//bit 7, byte 1 of the command frame the host's sequence counter. XOR covers
+//every byte in front of it.
+//状态帧第1字节为7位序号，第7位为Flag_Stop；指令帧第1字节为上位机的序号。异或校验覆盖其前面的所有字节
+
+//USART3 on PD8/PD9, PB10/PB11 are the MPU6050 I2C //USART3使用PD8/PD9，PB10/PB11为MPU6050的I2C
+#define HOST_LINK_USART          USART3
+#define HOST_LINK_BAUD           115200
+#define HOST_LINK_PORT           GPIOD
+#define HOST_LINK_PINS           (GPIO_PIN_8 | GPIO_PIN_9)
+#define HOST_LINK_AF             GPIO_AF7_USART3
+#define HOST_LINK_RX_STREAM      DMA1_Stream1
+#define HOST_LINK_TX_STREAM      DMA1_Stream3
+#define HOST_LINK_DMA_CHANNEL    DMA_CHANNEL_4
+#define HOST_LINK_CLK_ENABLE()   do{ __HAL_RCC_USART3_CLK_ENABLE(); __HAL_RCC_GPIOD_CLK_ENABLE(); __HAL_RCC_DMA1_CLK_ENABLE(); }while(0)
+
+#define HOST_LINK_RX_RING        256      //About 22 ms of bytes at full line rate //满速率下约22ms的数据
+#define HOST_LINK_TIMEOUT_MS     200      //Commands older than this stop the host mode //超过该时间无指令则退出上位机模式
+
+typedef struct
+{
+	uint8_t Ready;                //UART and DMA running //串口和DMA已启动
+	float Vx, Vy, Vz;             //Last valid command, m/s, rad/s //最近一条有效指令，m/s，rad/s
+	uint32_t Command_Tick;        //HAL_GetTick of that command //该指令的时刻
+
+	uint8_t Tx_Seq, Rx_Seq;
+	uint32_t Tx_Frames, Tx_Busy;  //Frames sent / skipped because the last one was still going out //已发送帧数/上一帧未发完而跳过的帧数
+	uint32_t Rx_Frames, Rx_Bad;   //Valid frames / frames with a bad checksum or tail //有效帧数/校验或帧尾错误的帧数
+	uint32_t Rx_Lost;             //Command frames missing from the sequence //序号中缺失的指令帧数
+	uint32_t Cycles, Cycles_Max;  //Poll and send per control cycle, CPU cycles //每控制周期接收和发送的耗时，CPU周期数
+}Host_Link_t;
+
+extern Host_Link_t Host_Link;
+
+void Host_Link_Init(void);
+void Host_Link_Poll(void);
+void Host_Link_Send(void);
+uint8_t Host_Link_Active(void);
+void Host_Link_Control(void);
+
+#endif
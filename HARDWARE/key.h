@@ -16,7 +16,7 @@ uint8_t User_Key_Scan(void);
 #define KEY_OFF	1
 	
 	
-//ûֵ״̬
+//用户按键返回值状态
 #define No_Action 					0
 #define Click 						1
 #define Long_Press 					3
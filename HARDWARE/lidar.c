@@ -1,18 +1,18 @@
 /***********************************************
-˾ȤƼݸ޹˾
-ƷƣWHEELTEC
-wheeltec.net
-Ա̣shop114407458.taobao.com 
-ͨ: https://minibalance.aliexpress.com/store/4455017
-汾V1.0
-޸ʱ䣺2022-07-05
+公司：轮趣科技（东莞）有限公司
+品牌：WHEELTEC
+官网：wheeltec.net
+淘宝店铺：shop114407458.taobao.com 
+速卖通: https://minibalance.aliexpress.com/store/4455017
+版本：V1.0
+修改时间：2022-07-05
 
 Brand: WHEELTEC
 Website: wheeltec.net
 Taobao shop: shop114407458.taobao.com 
 Aliexpress: https://minibalance.aliexpress.com/store/4455017
 Version: V1.0
-Update2022-07-05
+Update：2022-07-05
 
 All rights reserved
 ***********************************************/
@@ -20,80 +20,436 @@ All rights reserved
 #include "lidar.h"
 #include <string.h>
 #include "sys.h"
+#include "fast_math.h"
 
-float Diff_Along_Distance_KP = -0.030f,Diff_Along_Distance_KD = -0.245f,Diff_Along_Distance_KI = -0.001f;	//Сֱ߾PID
-float Akm_Along_Distance_KP = -0.115f*1000,Akm_Along_Distance_KD = -1000.245f*1000,Akm_Along_Distance_KI = -0.001f*1000;	//ֱ߾PID
-float FourWheel_Along_Distance_KP = -0.115f*1000,FourWheel_Along_Distance_KD = -100.200f*1000,FourWheel_Along_Distance_KI = -0.001f*1000;	//ֱ߾PID
-float Along_Distance_KP = 0.163f*1000,Along_Distance_KD = 0.123*1000,Along_Distance_KI = 0.001f*1000;	//ֺȫֱ߾PID
+float Diff_Along_Distance_KP = -0.030f,Diff_Along_Distance_KD = -0.245f,Diff_Along_Distance_KI = -0.001f;	//差速小车走直线距离调整PID参数
+float Akm_Along_Distance_KP = -0.115f*1000,Akm_Along_Distance_KD = -1000.245f*1000,Akm_Along_Distance_KI = -0.001f*1000;	//阿克曼走直线距离调整PID参数
+float FourWheel_Along_Distance_KP = -0.115f*1000,FourWheel_Along_Distance_KD = -100.200f*1000,FourWheel_Along_Distance_KI = -0.001f*1000;	//四驱走直线距离调整PID参数
+float Along_Distance_KP = 0.163f*1000,Along_Distance_KD = 0.123*1000,Along_Distance_KI = 0.001f*1000;	//麦轮和全向走直线距离调整PID参数
 
-float Distance_KP = -0.150f,Distance_KD = -0.052f,Distance_KI = -0.001;	//PID
+float Distance_KP = -0.150f,Distance_KD = -0.052f,Distance_KI = -0.001;	//跟随距离调整PID参数
 
-float Follow_KP = -2.566f,Follow_KD = -1.368f,Follow_KI = -0.001f;  //תPID
+float Follow_KP = -2.566f,Follow_KD = -1.368f,Follow_KI = -0.001f;  //转向PID
 float Follow_KP_Akm = -0.550f,Follow_KD_Akm = -0.121f,Follow_KI_Akm = -0.001f;
-//float Distance_KP = 0.653f*1000,Distance_KD = 2.431f*1000,Distance_KI = 0.001*1000;	//PID
+//float Distance_KP = 0.653f*1000,Distance_KD = 2.431f*1000,Distance_KI = 0.001*1000;	//距离调整PID参数
 
-PointDataProcessDef PointDataProcess[1200] ;//225
 LiDARFrameTypeDef Pack_Data;
-PointDataProcessDef Dataprocess[1200];      //Сϡ桢ֱߡELE״ϵ״
+Lidar_t Lidar;
 
+//Bytes of LiDARFrameTypeDef, the shortest frame accepted. The frame length is
+//ver_len: a longer frame has its extra bytes after the timestamp, they are skipped
+//LiDARFrameTypeDef的字节数，即接受的最短帧。帧长取自ver_len，更长的帧在时间戳之后有额外字节，这些字节被跳过
+#define LIDAR_FRAME_SIZE  sizeof(LiDARFrameTypeDef)
+#define LIDAR_LENGTH_OK(n) ((n) >= LIDAR_FRAME_SIZE && (n) <= LIDAR_FRAME_MAX)
 
+static UART_HandleTypeDef Lidar_Uart;
+static DMA_HandleTypeDef Lidar_Rx_Dma;
+static u8 Lidar_Rx_Ring[LIDAR_RX_RING];
+static u8 Lidar_Frame[LIDAR_FRAME_MAX];               //Frame being collected //正在收集的数据帧
+static u16 Lidar_Frame_Len;
+
+//Pose history written by Balance_task, read by the decoder task //位姿历史，由Balance_task写入，解码任务读取
+static Lidar_Pose_t Lidar_Pose_Ring[LIDAR_POSE_HISTORY];
+static volatile u32 Lidar_Pose_Count;
+static Lidar_Pose_t Lidar_Packet_Pose;               //Pose of the packet in Pack_Data //Pack_Data中数据包的位姿
+static u8 Lidar_Need_Pose;
+
+static Lidar_Scan_t Lidar_Scan[2];
+static Lidar_Scan_t *volatile Lidar_Published = 0;    //Scan the consumers read //使用者读取的扫描
+static volatile u32 Lidar_Scan_Seq = 0;
+static u8 Lidar_Fill = 0;                             //Index of the scan being filled //正在填充的缓冲区序号
+static u16 Lidar_Last_Angle = 0;
+static u16 Lidar_Last_Distance = 1;
+static u8 Lidar_Wrapped = 0;                          //The first wrap only starts a full revolution //第一次回绕只作为完整一圈的起点
+
+/**************************************************************************
+Function: Publish the scan being filled and start the next one in the other buffer
+Input   : none
+Output  : none
+函数功能：发布正在填充的扫描，在另一个缓冲区中开始下一圈
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void Lidar_Close_Revolution(void)
+{
+	Lidar_Scan_t *s = &Lidar_Scan[Lidar_Fill];
+
+	if(!Lidar_Wrapped)
+	{
+		Lidar_Wrapped = 1;
+		s->Count = s->Dropped = s->Poses = 0;
+		Lidar_Need_Pose = 1;
+		return;
+	}
+	s->Tick = HAL_GetTick();
+	Lidar.Revolutions++;
+	s->Seq = Lidar_Scan_Seq + 1;
+	__DMB();                                          //Points before the pointer //先写入点再发布指针
+	Lidar_Published = s;
+	Lidar_Scan_Seq = s->Seq;
+
+	Lidar_Fill ^= 1;
+	Lidar_Scan[Lidar_Fill].Count = 0;
+	Lidar_Scan[Lidar_Fill].Dropped = 0;
+	Lidar_Scan[Lidar_Fill].Poses = 0;
+	Lidar_Need_Pose = 1;                              //The rest of the packet starts the new scan //数据包剩余的点从新一圈开始
+}
 
 /**************************************************************************
 Function: data_process
 Input   : none
 Output  : none
-ܣݴ
-ڲ
-  ֵ
+函数功能：把Pack_Data中的32个点加入正在填充的扫描，角度经过0度时结束一圈
+入口参数：无
+返回  值：无
 **************************************************************************/
-int data_cnt = 0;
-void data_process(void) //ݴ
+void data_process(void) //数据处理
 {
-	static int data_cnt = 0;
-	int i,m,n;
-	u32 distance_sum[32]={0};//2ľ͵
-	float start_angle = (((u16)Pack_Data.start_angle_h<<8)+Pack_Data.start_angle_l)/100.0;//32ĿʼǶ
-	float end_angle = (((u16)Pack_Data.end_angle_h<<8)+Pack_Data.end_angle_l)/100.0;//32ĽǶ
-	float area_angle[32]={0};
-	
-	if(start_angle>end_angle)//ǶȺͿʼǶȱ0ȷָ
-		end_angle +=360;
+	Lidar_Scan_t *s;
+	u16 start_angle = ((u16)Pack_Data.start_angle_h<<8)+Pack_Data.start_angle_l;//32个点的开始角度，0.01度
+	u16 end_angle = ((u16)Pack_Data.end_angle_h<<8)+Pack_Data.end_angle_l;//32个点的结束角度，0.01度
+	u32 span, angle;
+	u16 distance;
+	int i;
 
-	for(m=0;m<32;m++)
+	if(start_angle >= 36000 || end_angle >= 36000) return;
+	Lidar_Need_Pose = 1;
+	span = end_angle >= start_angle ? (u32)(end_angle - start_angle) : (u32)(end_angle + 36000u - start_angle);//被0度分割的情况
+
+	for(i=0;i<POINT_PER_PACK;i++)
 	{
-		area_angle[m]=start_angle+(end_angle-start_angle)/32*m;
-		if(area_angle[m]>360)  area_angle[m] -=360;
+		//First and last point on the packet angles //首尾两点分别位于数据包的开始和结束角度
+		angle = start_angle + span * (u32)i / (POINT_PER_PACK - 1);
+		if(angle >= 36000) angle -= 36000;
+		distance = ((u16)Pack_Data.point[i].distance_h<<8)+Pack_Data.point[i].distance_l;//数据高低8位合并
+
+		//Revolution ends where the angle wraps, not after a fixed count //角度回绕时结束一圈，而不是按固定点数
+		if(angle + 18000u < Lidar_Last_Angle) Lidar_Close_Revolution();
+		Lidar_Last_Angle = (u16)angle;
+
+		//A single zero echo is dropped, two in a row mean nothing is there
+		//单个0回波丢弃，连续两次为0表示该方向没有障碍物
+		if(distance == 0 && Lidar_Last_Distance != 0)
+		{
+			Lidar_Last_Distance = 0;
+			continue;
+		}
+		Lidar_Last_Distance = distance;
+
+		s = &Lidar_Scan[Lidar_Fill];
+		if(s->Count >= LIDAR_SCAN_MAX)
+		{
+			s->Dropped++;
+			continue;
+		}
+		if(Lidar_Need_Pose && s->Poses < LIDAR_SCAN_PACKS)
+		{
+			s->Pose[s->Poses] = Lidar_Packet_Pose;
+			s->Pose[s->Poses++].First = s->Count;
+		}
+		Lidar_Need_Pose = 0;
+		s->Point[s->Count].Angle = (u16)angle;
+		s->Point[s->Count].Distance = distance;
+		s->Point[s->Count].Strength = Pack_Data.point[i].Strong;
+		s->Count++;
 	}
-	
-	for(i=0;i<32;i++)
+}
+
+/**************************************************************************
+Function: Newest complete revolution
+Input   : none
+Output  : scan, 0 before the first revolution
+函数功能：获取最新的完整一圈扫描
+入口参数：无
+返回  值：扫描，第一圈完成前为0
+**************************************************************************/
+const Lidar_Scan_t *Lidar_Scan_Get(void)
+{
+	return Lidar_Published;
+}
+
+/**************************************************************************
+Function: Check that a scan taken with Lidar_Scan_Get was not overwritten while it was read
+Input   : seq: Seq of that scan, read before using it
+Output  : 1: the data read is consistent
+函数功能：检查用Lidar_Scan_Get获取的扫描在读取期间没有被覆盖
+入口参数：seq：该扫描的Seq，在使用前读取
+返回  值：1：读取的数据一致
+**************************************************************************/
+u8 Lidar_Scan_Valid(u32 seq)
+{
+	__DMB();
+	return Lidar_Scan_Seq == seq;
+}
+
+/**************************************************************************
+Function: Record the pose of this control cycle, called at the end of Balance_task
+Input   : none
+Output  : none
+函数功能：记录本控制周期的位姿，在Balance_task周期末尾调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Lidar_Pose_Push(void)
+{
+	Lidar_Pose_t *p = &Lidar_Pose_Ring[Lidar_Pose_Count % LIDAR_POSE_HISTORY];
+
+	p->Stamp_Us = getMicros();
+	p->X = position[0];
+	p->Y = position[1];
+	p->Yaw = Yaw;
+	__DMB();
+	Lidar_Pose_Count++;
+}
+
+/**************************************************************************
+Function: Pose at a time, interpolated between the two control cycles around it
+Input   : stamp: getMicros() time; out: pose, First is not set
+Output  : none
+函数功能：某一时刻的位姿，在其前后两个控制周期之间插值
+入口参数：stamp：getMicros()时刻；out：位姿，不设置First
+返回  值：无
+**************************************************************************/
+static void Lidar_Pose_At(u32 stamp, Lidar_Pose_t *out)
+{
+	u32 n = Lidar_Pose_Count, k, depth = n < LIDAR_POSE_HISTORY ? n : LIDAR_POSE_HISTORY - 1;
+	const Lidar_Pose_t *newer = 0, *older;
+	float f;
+
+	out->Stamp_Us = stamp;
+	if(n == 0)
 	{
-		distance_sum[i] +=((u16)Pack_Data.point[i].distance_h<<8)+Pack_Data.point[i].distance_l;//ݸߵ8λϲ
+		out->X = position[0]; out->Y = position[1]; out->Yaw = Yaw;
+		return;
 	}
-	
 
-	for(n=0;n<32;n++)
+	//Newest entry at or before the stamp, the oldest one when it is too old
+	//时间戳之前的最新条目，时间戳过早时取最旧的条目
+	for(k = 1; k <= depth; k++)
 	{
-		PointDataProcess[data_cnt+n].angle = area_angle[n];
-	    PointDataProcess[data_cnt+n].distance = distance_sum[n];  //һ֡Ϊ32
-		
+		older = &Lidar_Pose_Ring[(n - k) % LIDAR_POSE_HISTORY];
+		if((int32_t)(stamp - older->Stamp_Us) >= 0) break;
+		newer = older;
 	}
-	data_cnt +=32;
-	if(data_cnt>=1152) //״תһȦ1152㣨ֵÿȦĵ̶һ֡ԼΪ10ȣһȦԼ36֡=32*36=1152
+	if(k > depth || newer == 0 || newer->Stamp_Us == older->Stamp_Us)
 	{
-		for(i=0,m=0;i<1152;i++)
-		{				
-				if(PointDataProcess[i].distance == 0 &&PointDataProcess[i-1].distance == 0)  //λز0ɼΪ0
-				{
-					Dataprocess[m].angle=PointDataProcess[i].angle;
-					Dataprocess[m++].distance=PointDataProcess[i].distance;  //PointDataProcessλزΪ0ݴ䵽Dataprocess
-				}
-				else if(PointDataProcess[i].distance != 0)  //زϢһ£ֻһݣ0
-				{
-					Dataprocess[m].angle=PointDataProcess[i].angle;
-					Dataprocess[m++].distance=PointDataProcess[i].distance;  //PointDataProcessз0ݴ䵽Dataprocess
-				}
+		out->X = older->X; out->Y = older->Y; out->Yaw = older->Yaw;
+		return;
+	}
+	f = (float)(stamp - older->Stamp_Us) / (float)(newer->Stamp_Us - older->Stamp_Us);
+	out->X = older->X + f * (newer->X - older->X);
+	out->Y = older->Y + f * (newer->Y - older->Y);
+	out->Yaw = Fast_Wrap180(older->Yaw + f * Fast_Wrap180(newer->Yaw - older->Yaw));
+}
+
+//Check byte as the N10 protocol defines it: the low 8 bits of the sum of
+//bytes 0 to ver_len-2, header and ver_len included. See LiDARFrameTypeDef
+//N10协议定义的校验字节：第0至ver_len-2字节(含帧头和ver_len)累加和的低8位，见LiDARFrameTypeDef
+static u8 Lidar_Frame_Check(const u8 *f, u16 n)
+{
+	u8 sum = 0;
+	u16 i;
+
+	for(i = 0; i < n - 1; i++) sum += f[i];
+	return sum == f[n - 1];
+}
+
+/**************************************************************************
+Function: Drop a broken frame up to the next header inside it that can start a frame
+Input   : none
+Output  : none
+函数功能：丢弃错误帧，直到其中下一个可以作为帧起点的帧头
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void Lidar_Resync(void)
+{
+	u16 k, rest;
+
+	//The header must be followed by a valid ver_len that the rest does not
+	//already exceed, a whole frame inside a broken one is not recovered
+	//帧头之后必须是有效的ver_len，且剩余字节未超过该长度，错误帧内的完整帧不再恢复
+	for(k = 1; k < Lidar_Frame_Len; k++)
+	{
+		rest = Lidar_Frame_Len - k;
+		if(Lidar_Frame[k] != HEADER_0) continue;
+		if(rest == 1) break;
+		if(Lidar_Frame[k + 1] != HEADER_1) continue;
+		if(rest == 2 || (LIDAR_LENGTH_OK(Lidar_Frame[k + 2]) && rest < Lidar_Frame[k + 2])) break;
+	}
+	Lidar.Skipped += k;
+	Lidar_Frame_Len -= k;
+	memmove(Lidar_Frame, &Lidar_Frame[k], Lidar_Frame_Len);
+}
+
+/**************************************************************************
+Function: Frame a run of received bytes, check the frames and add their points to the scan
+Input   : data: bytes in the order received; len: count; end_us: getMicros() when the last one was received
+Output  : none
+函数功能：对一段接收字节分帧，校验后把数据帧中的点加入扫描
+入口参数：data：按接收顺序的字节；len：字节数；end_us：最后一个字节接收完成时的getMicros()
+返回  值：无
+**************************************************************************/
+void Lidar_Decode(const u8 *data, u16 len, u32 end_us)
+{
+	u16 i, n;
+
+	for(i = 0; i < len; i++)
+	{
+		u8 b = data[i];
+
+		//Header A5 5A, anything else in front of it is skipped //帧头A5 5A，之前的其他字节丢弃
+		if(Lidar_Frame_Len == 0 && b != HEADER_0) { Lidar.Skipped++; continue; }
+		if(Lidar_Frame_Len == 1 && b != HEADER_1)
+		{
+			Lidar.Skipped++;                          //The A5 in front //前面的A5
+			if(b != HEADER_0)
+			{
+				Lidar.Skipped++;
+				Lidar_Frame_Len = 0;
+			}
+			continue;
+		}
+		Lidar_Frame[Lidar_Frame_Len++] = b;
+		if(Lidar_Frame_Len < 3) continue;
+
+		//Frame length from ver_len, a wrong one is counted apart from the check byte errors
+		//帧长取自ver_len，长度错误与校验错误分开计数
+		n = Lidar_Frame[2];
+		if(Lidar_Frame_Len == 3 && !LIDAR_LENGTH_OK(n))
+		{
+			Lidar.Bad_Length++;
+			Lidar_Resync();
+			continue;
+		}
+		if(Lidar_Frame_Len < n) continue;
+
+		if(Lidar_Frame_Check(Lidar_Frame, n))
+		{
+			//Stamped with the time of the first byte, the packet was measured just before it
+			//时间戳取第一个字节的时刻，数据包在此之前刚刚测得
+			Lidar_Pose_At(end_us - (u32)((float)(len - 1 - i + n - 1) * LIDAR_BYTE_US), &Lidar_Packet_Pose);
+			memcpy(&Pack_Data, Lidar_Frame, LIDAR_FRAME_SIZE - 1);
+			Pack_Data.crc = Lidar_Frame[n - 1];
+			data_process();
+			Lidar.Frames++;
+			Lidar_Frame_Len = 0;
+			continue;
+		}
+
+		//Resynchronise on the next header inside the bad frame //在错误帧内寻找下一个帧头重新同步
+		Lidar.Bad_Crc++;
+		Lidar_Resync();
+	}
+}
+
+/**************************************************************************
+Function: Set up UART4, its pins and the receive DMA, start the decoder task
+Input   : none
+Output  : none
+函数功能：初始化UART4、引脚和接收DMA，启动解码任务
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Lidar_Init(void)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	if(Lidar.Ready) return;
+	LIDAR_CLK_ENABLE();
+
+	GPIO_InitStruct.Pin = LIDAR_PINS;
+	GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull = GPIO_PULLUP;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	GPIO_InitStruct.Alternate = LIDAR_AF;
+	HAL_GPIO_Init(LIDAR_PORT, &GPIO_InitStruct);
+
+	Lidar_Uart.Instance = LIDAR_UART;
+	Lidar_Uart.Init.BaudRate = LIDAR_BAUD;
+	Lidar_Uart.Init.WordLength = UART_WORDLENGTH_8B;
+	Lidar_Uart.Init.StopBits = UART_STOPBITS_1;
+	Lidar_Uart.Init.Parity = UART_PARITY_NONE;
+	Lidar_Uart.Init.Mode = UART_MODE_TX_RX;
+	Lidar_Uart.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	Lidar_Uart.Init.OverSampling = UART_OVERSAMPLING_16;
+	if(HAL_UART_Init(&Lidar_Uart) != HAL_OK) return;
+
+	Lidar_Rx_Dma.Instance = LIDAR_RX_STREAM;
+	Lidar_Rx_Dma.Init.Channel = LIDAR_DMA_CHANNEL;
+	Lidar_Rx_Dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	Lidar_Rx_Dma.Init.PeriphInc = DMA_PINC_DISABLE;
+	Lidar_Rx_Dma.Init.MemInc = DMA_MINC_ENABLE;
+	Lidar_Rx_Dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	Lidar_Rx_Dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	Lidar_Rx_Dma.Init.Mode = DMA_CIRCULAR;
+	Lidar_Rx_Dma.Init.Priority = DMA_PRIORITY_LOW;
+	Lidar_Rx_Dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if(HAL_DMA_Init(&Lidar_Rx_Dma) != HAL_OK) return;
+
+	//The stream is driven directly, its interrupts stay off //直接驱动数据流，不开启中断
+	if(HAL_DMA_Start(&Lidar_Rx_Dma, (uint32_t)&LIDAR_UART->DR, (uint32_t)Lidar_Rx_Ring, LIDAR_RX_RING) != HAL_OK) return;
+	SET_BIT(LIDAR_UART->CR3, USART_CR3_DMAR);
+	//Out of FreeRTOS heap: nothing would read the ring, stop the stream again
+	//FreeRTOS堆不足：没有任务读取接收缓冲区，重新停止数据流
+	if(xTaskCreate(Lidar_Task, "lidar_task", LIDAR_STK_SIZE, NULL, LIDAR_TASK_PRIO, NULL) != pdPASS)
+	{
+		CLEAR_BIT(LIDAR_UART->CR3, USART_CR3_DMAR);
+		HAL_DMA_Abort(&Lidar_Rx_Dma);
+		usart1_send_cstring("[雷达] 创建任务失败\r\n");
+		return;
+	}
+	Lidar.Ready = 1;
+}
+
+/**************************************************************************
+Function: Decoder task: read the bytes the DMA stored since the last poll
+Input   : pvParameters: unused
+Output  : none
+函数功能：解码任务：读取上次以来DMA存入的字节
+入口参数：pvParameters：未使用
+返回  值：无
+**************************************************************************/
+void Lidar_Task(void *pvParameters)
+{
+	TickType_t last_wake = xTaskGetTickCount(), last_report = last_wake;
+	u16 tail = 0, head, pending;
+	u32 start, now, reported_frames = 0;
+
+	for(;;)
+	{
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(LIDAR_POLL_MS));
+		start = getCycleCnt();
+		now = getMicros();
+		head = LIDAR_RX_RING - __HAL_DMA_GET_COUNTER(&Lidar_Rx_Dma);
+		if(head >= LIDAR_RX_RING) head = 0;
+
+		pending = (head + LIDAR_RX_RING - tail) % LIDAR_RX_RING;
+		if(pending > LIDAR_RX_RING * 3 / 4) Lidar.Late++;
+		if(head < tail)
+		{
+			//Wrapped: the part up to the ring end was received head bytes earlier
+			//回绕：缓冲区末尾之前的部分比当前早head个字节接收完
+			Lidar_Decode(&Lidar_Rx_Ring[tail], LIDAR_RX_RING - tail, now - (u32)((float)head * LIDAR_BYTE_US));
+			Lidar_Decode(Lidar_Rx_Ring, head, now);
+		}
+		else Lidar_Decode(&Lidar_Rx_Ring[tail], head - tail, now);
+		tail = head;
+
+		Lidar.Cycles = getCycleCnt() - start;
+		if(Lidar.Cycles > Lidar.Cycles_Max) Lidar.Cycles_Max = Lidar.Cycles;
+
+		if(xTaskGetTickCount() - last_report >= pdMS_TO_TICKS(10000) && Lidar.Frames != reported_frames)
+		{
+			char msg[160];
+
+			last_report = xTaskGetTickCount();
+			reported_frames = Lidar.Frames;
+			snprintf(msg, sizeof(msg), "[雷达] 帧%lu 校验错误%lu 长度错误%lu 丢弃字节%lu 圈%lu 超时%lu 最长%lu周期\r\n",
+			         (unsigned long)Lidar.Frames, (unsigned long)Lidar.Bad_Crc, (unsigned long)Lidar.Bad_Length, (unsigned long)Lidar.Skipped,
+			         (unsigned long)Lidar.Revolutions, (unsigned long)Lidar.Late, (unsigned long)Lidar.Cycles_Max);
+			usart1_send_cstring(msg);
 		}
-		data_cnt = 0;
 	}
 }
 
@@ -101,29 +457,29 @@ void data_process(void) //
 Function: Distance_Adjust_PID
 Input   : Current_Distance;Target_Distance
 Output  : OutPut
-ܣֱ״pid
-ڲ: ǰĿ
-  ֵĿٶ
+函数功能：走直线雷达距离pid
+入口参数: 当前距离和目标距离
+返回  值：电机目标速度
 **************************************************************************/	 	
-//ֱ״pid
+//走直线雷达距离调整pid
 
-float Along_Adjust_PID(float Current_Distance,float Target_Distance)//PID
+float Along_Adjust_PID(float Current_Distance,float Target_Distance)//距离调整PID
 {
 	static float Bias,OutPut,Integral_bias,Last_Bias;
-	Bias=Target_Distance-Current_Distance;                          	//ƫ
-	Integral_bias+=Bias;	                                 			//ƫĻ
+	Bias=Target_Distance-Current_Distance;                          	//计算偏差
+	Integral_bias+=Bias;	                                 			//求出偏差的积分
 	if(Integral_bias>1000) Integral_bias=1000;
 	else if(Integral_bias<-1000) Integral_bias=-1000;
 	if(Car_Mode == FourWheel_Car)
-		OutPut=FourWheel_Along_Distance_KP*Bias/100000+FourWheel_Along_Distance_KI*Integral_bias/100000+FourWheel_Along_Distance_KD*(Bias-Last_Bias)/100000;//λʽPID
+		OutPut=FourWheel_Along_Distance_KP*Bias/100000+FourWheel_Along_Distance_KI*Integral_bias/100000+FourWheel_Along_Distance_KD*(Bias-Last_Bias)/100000;//位置式PID控制器
 	else if(Car_Mode == Akm_Car)
-		OutPut=Akm_Along_Distance_KP*Bias/100000+Akm_Along_Distance_KI*Integral_bias/100000+Akm_Along_Distance_KD*(Bias-Last_Bias)/1000;//λʽPID
+		OutPut=Akm_Along_Distance_KP*Bias/100000+Akm_Along_Distance_KI*Integral_bias/100000+Akm_Along_Distance_KD*(Bias-Last_Bias)/1000;//位置式PID控制器
 	else if(Car_Mode == Diff_Car || Car_Mode == Tank_Car)
-		OutPut=Diff_Along_Distance_KP*Bias/100+Diff_Along_Distance_KI*Integral_bias/100+Diff_Along_Distance_KD*(Bias-Last_Bias);//λʽPID
+		OutPut=Diff_Along_Distance_KP*Bias/100+Diff_Along_Distance_KI*Integral_bias/100+Diff_Along_Distance_KD*(Bias-Last_Bias);//位置式PID控制器
 	else
-	  OutPut=-Along_Distance_KP*Bias/100000-Along_Distance_KI*Integral_bias/100000-Along_Distance_KD*(Bias-Last_Bias)/1000;//λʽPID
-	Last_Bias=Bias;                                       		 			//һƫ
-	if(Turn_Off(Voltage)== 1)								//رգʱ
+	  OutPut=-Along_Distance_KP*Bias/100000-Along_Distance_KI*Integral_bias/100000-Along_Distance_KD*(Bias-Last_Bias)/1000;//位置式PID控制器
+	Last_Bias=Bias;                                       		 			//保存上一次偏差
+	if(Turn_Off(Voltage)== 1)								//电机关闭，此时积分清零
 		Integral_bias = 0;
 	return OutPut;                                          	
 }
@@ -133,21 +489,21 @@ float Along_Adjust_PID(float Current_Distance,float Target_Distance)//
 Function: Distance_Adjust_PID
 Input   : Current_Distance;Target_Distance
 Output  : OutPut
-ܣ״pid
-ڲ: ǰĿ
-  ֵĿٶ
+函数功能：跟随雷达距离pid
+入口参数: 当前距离和目标距离
+返回  值：电机目标速度
 **************************************************************************/	 	
-//״pid
-float Distance_Adjust_PID(float Current_Distance,float Target_Distance)//PID
+//跟随雷达距离调整pid
+float Distance_Adjust_PID(float Current_Distance,float Target_Distance)//距离调整PID
 {
 	static float Bias,OutPut,Integral_bias,Last_Bias;
-	Bias=Target_Distance-Current_Distance;                          	//ƫ
-	Integral_bias+=Bias;	                                 			//ƫĻ
+	Bias=Target_Distance-Current_Distance;                          	//计算偏差
+	Integral_bias+=Bias;	                                 			//求出偏差的积分
 	if(Integral_bias>1000) Integral_bias=1000;
 	else if(Integral_bias<-1000) Integral_bias=-1000;
-	OutPut=Distance_KP*Bias/100+Distance_KI*Integral_bias/100+Distance_KD*(Bias-Last_Bias)/100;//λʽPID
-	Last_Bias=Bias;                                       		 			//һƫ
-	if(Turn_Off(Voltage)== 1)								//رգʱ
+	OutPut=Distance_KP*Bias/100+Distance_KI*Integral_bias/100+Distance_KD*(Bias-Last_Bias)/100;//位置式PID控制器
+	Last_Bias=Bias;                                       		 			//保存上一次偏差
+	if(Turn_Off(Voltage)== 1)								//电机关闭，此时积分清零
 		Integral_bias = 0;
 	return OutPut;                                          	
 }
@@ -156,57 +512,57 @@ float Distance_Adjust_PID(float Current_Distance,float Target_Distance)//
 Function: Follow_Turn_PID
 Input   : Current_Angle;Target_Angle
 Output  : OutPut
-ܣ״תpid
-ڲ: ǰǶȺĿǶ
-  ֵתٶ
+函数功能：跟随雷达转向pid
+入口参数: 当前角度和目标角度
+返回  值：电机转向速度
 **************************************************************************/	 	
-//״תpid
+//跟随雷达转向pid
 float Follow_Turn_PID(float Current_Angle,float Target_Angle)
 {
 	static float Bias,OutPut,Integral_bias,Last_Bias;
-	Bias=Target_Angle-Current_Angle;                         				 //ƫ
-	Integral_bias+=Bias;	                                 				 //ƫĻ
+	Bias=Target_Angle-Current_Angle;                         				 //计算偏差
+	Integral_bias+=Bias;	                                 				 //求出偏差的积分
 	if(Integral_bias>1000) Integral_bias=1000;
 	else if(Integral_bias<-1000) Integral_bias=-1000;
 	if(Car_Mode == Akm_Car || Car_Mode == Omni_Car)
-		OutPut=(Follow_KP_Akm/100)*Bias+(Follow_KI_Akm/100)*Integral_bias+(Follow_KD_Akm/100)*(Bias-Last_Bias);	//λʽPID
+		OutPut=(Follow_KP_Akm/100)*Bias+(Follow_KI_Akm/100)*Integral_bias+(Follow_KD_Akm/100)*(Bias-Last_Bias);	//位置式PID控制器
 	else
-	  OutPut=(Follow_KP/100)*Bias+(Follow_KI/100)*Integral_bias+(Follow_KD/100)*(Bias-Last_Bias);	//λʽPID
-	Last_Bias=Bias;                                       					 		//һƫ
-	if(Turn_Off(Voltage)== 1)								//رգʱ
+	  OutPut=(Follow_KP/100)*Bias+(Follow_KI/100)*Integral_bias+(Follow_KD/100)*(Bias-Last_Bias);	//位置式PID控制器
+	Last_Bias=Bias;                                       					 		//保存上一次偏差
+	if(Turn_Off(Voltage)== 1)								//电机关闭，此时积分清零
 		Integral_bias = 0;
-	return OutPut;                                           					 	//
+	return OutPut;                                           					 	//输出
 	
 }
 
 /**************************************************************************
-ܣPI
-ڲֵĿٶ
-  ֵPWM
-ʽɢPIDʽ 
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
-e(k)ƫ 
-e(k-1)һεƫ  Դ 
-pwm
-ǵٶȿƱջϵͳ棬ֻʹPI
-pwm+=Kp[ek-e(k-1)]+Ki*e(k)
+函数功能：增量PI控制器
+入口参数：编码器测量值，目标速度
+返回  值：电机PWM
+根据增量式离散PID公式 
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)+Kd[e(k)-2e(k-1)+e(k-2)]
+e(k)代表本次偏差 
+e(k-1)代表上一次的偏差  以此类推 
+pwm代表增量输出
+在我们的速度控制闭环系统里面，只使用PI控制
+pwm+=Kp[e（k）-e(k-1)]+Ki*e(k)
 **************************************************************************/
 
 //int Incremental_PI_Left (int Encoder,int Target)
 //{ 	
 //	 static int Bias,Pwm,Last_bias;
-//	 Bias=Target-Encoder;                					//ƫ
-//	 Pwm+=11*(Bias-Last_bias)+10*Bias;   	//ʽPI
-//	 Last_bias=Bias;	                   					//һƫ 
-//	 return Pwm;                         					//
+//	 Bias=Target-Encoder;                					//计算偏差
+//	 Pwm+=11*(Bias-Last_bias)+10*Bias;   	//增量式PI控制器
+//	 Last_bias=Bias;	                   					//保存上一次偏差 
+//	 return Pwm;                         					//增量输出
 //}
 
 
 //int Incremental_PI_Right (int Encoder,int Target)
 //{ 	
 //	 static int Bias,Pwm,Last_bias;
-//	 Bias=Target-Encoder;                					//ƫ
-//	 Pwm+=11*(Bias-Last_bias)+10*Bias;   	//ʽPI
-//	 Last_bias=Bias;	                   					//һƫ 
-//	 return Pwm;                         					//
+//	 Bias=Target-Encoder;                					//计算偏差
+//	 Pwm+=11*(Bias-Last_bias)+10*Bias;   	//增量式PI控制器
+//	 Last_bias=Bias;	                   					//保存上一次偏差 
+//	 return Pwm;                         					//增量输出
 //}
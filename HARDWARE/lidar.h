@@ -1,18 +1,18 @@
 /***********************************************
-˾ȤƼݸ޹˾
-ƷƣWHEELTEC
-wheeltec.net
-Ա̣shop114407458.taobao.com 
-ͨ: https://minibalance.aliexpress.com/store/4455017
-汾V1.0
-޸ʱ䣺2022-07-05
+公司：轮趣科技（东莞）有限公司
+品牌：WHEELTEC
+官网：wheeltec.net
+淘宝店铺：shop114407458.taobao.com 
+速卖通: https://minibalance.aliexpress.com/store/4455017
+版本：V1.0
+修改时间：2022-07-05
 
 Brand: WHEELTEC
 Website: wheeltec.net
 Taobao shop: shop114407458.taobao.com 
 Aliexpress: https://minibalance.aliexpress.com/store/4455017
 Version: V1.0
-Update2022-07-05
+Update：2022-07-05
 
 All rights reserved
 ***********************************************/
@@ -29,10 +29,40 @@ All rights reserved
 
 #define HEADER_0 0xA5
 #define HEADER_1 0x5A
-#define Length_ 0x6C
+#define Length_ 0x6C              //ver_len of the frames the lidar sends, whole frame in bytes //雷达数据帧的ver_len，整帧字节数
 
 #define POINT_PER_PACK 32
 
+//Frame of the WHEELTEC N10 lidar protocol, 108 bytes: header A5 5A (0-1),
+//ver_len = whole frame (2), speed (3-4), start angle in 0.01 degree (5-6),
+//32 points of distance in mm and strength (7-102), end angle (103-104),
+//timestamp in ms (105-106) and the check byte (107). All fields big endian
+//N10雷达协议的数据帧，共108字节：帧头A5 5A(0-1)，ver_len即整帧长度(2)，转速(3-4)，起始角度0.01度(5-6)，
+//32个点的距离mm和强度(7-102)，结束角度(103-104)，时间戳ms(105-106)，校验字节(107)。各字段高字节在前
+
+//Serial port of the lidar, fed by DMA only. UART5 is the UWB tag and PA0/PA1
+//carry an encoder, so the lidar is on UART4 PC10/PC11. The decoder task reads
+//the circular buffer every LIDAR_POLL_MS, finds the frames on their header,
+//checks them and adds the points to the scan.
+//雷达串口只使用DMA接收。UART5为UWB标签，PA0/PA1为编码器，因此雷达接在UART4的PC10/PC11。
+//解码任务每LIDAR_POLL_MS读取一次循环缓冲区，按帧头寻找数据帧，校验后把点加入扫描
+#define LIDAR_UART           UART4
+#define LIDAR_BAUD           230400
+#define LIDAR_PORT           GPIOC
+#define LIDAR_PINS           (GPIO_PIN_10 | GPIO_PIN_11)
+#define LIDAR_AF             GPIO_AF8_UART4
+#define LIDAR_RX_STREAM      DMA1_Stream2
+#define LIDAR_DMA_CHANNEL    DMA_CHANNEL_4
+#define LIDAR_CLK_ENABLE()   do{ __HAL_RCC_UART4_CLK_ENABLE(); __HAL_RCC_GPIOC_CLK_ENABLE(); __HAL_RCC_DMA1_CLK_ENABLE(); }while(0)
+
+#define LIDAR_TASK_PRIO      2         //Below the control task //低于控制任务
+#define LIDAR_STK_SIZE       256
+#define LIDAR_POLL_MS        5
+#define LIDAR_RX_RING        1024      //About 44 ms at 230400 baud //230400波特率下约44ms的数据
+#define LIDAR_BYTE_US        (10.0f * 1000000.0f / LIDAR_BAUD)   //One byte on the line, start and stop bit included //线路上一个字节的时间，含起始位和停止位
+#define LIDAR_POSE_HISTORY   32        //Control cycles of pose kept for the time stamps, 320 ms //为时间戳保留的位姿，控制周期数，320ms
+#define LIDAR_FRAME_MAX      128       //Longest ver_len accepted, bytes //接受的最大ver_len，字节
+
 
 
 
@@ -59,31 +89,88 @@ typedef struct PackData
 	LidarPointStructDef point[POINT_PER_PACK];
 	uint8_t end_angle_h;
 	uint8_t end_angle_l;
+	uint8_t timestamp_h;          //Lidar's own ms counter, the points are stamped by their arrival instead //雷达自身的ms计数，点的时间戳按接收时刻计算
+	uint8_t timestamp_l;
 	uint8_t crc;
 }LiDARFrameTypeDef;
 
-typedef struct PointDataProcess_
+//One revolution in a compact form, angle and distance as integers, 5 bytes per point
+//一圈扫描的紧凑格式，角度和距离为整数，每点5字节
+#define LIDAR_SCAN_MAX      1216    //38 packets, about 8% above the nominal 1152 points //38个数据包，比标称的1152点多约8%
+
+//Robot pose when the first point of a packet was measured, the points from
+//First up to the next pose entry were taken from there (motion correction)
+//数据包第一个点测量时的机器人位姿，从First到下一个位姿条目的点都在该位姿下测得(运动补偿)
+typedef struct
+{
+	u32 Stamp_Us;                 //getMicros() of the measurement //测量时刻
+	float X, Y, Yaw;              //position[], m, and Yaw, degree //position[]，m，及Yaw，度
+	u16 First;                    //Index of the first point in Point[] //在Point[]中的第一个点序号
+}Lidar_Pose_t;
+
+#define LIDAR_SCAN_PACKS    40      //Pose entries per revolution, 36 packets nominal //每圈的位姿条目数，标称36个数据包
+
+#pragma pack(push, 1)
+typedef struct
 {
-	u16 distance;
-	float angle;
-}PointDataProcessDef;
+	u16 Angle;                    //0.01 degree, 0..35999 //0.01度，0..35999
+	u16 Distance;                 //mm, 0: no echo //mm，0表示无回波
+	u8 Strength;
+}Lidar_Point_t;
+#pragma pack(pop)
 
+typedef struct
+{
+	u32 Seq;                      //Revolution number, 0 while never published //圈序号，未发布时为0
+	u32 Tick;                     //HAL_GetTick when the revolution closed //该圈结束时的HAL_GetTick
+	u16 Count;                    //Points in Point[] //Point[]中的点数
+	u16 Dropped;                  //Points of this revolution that did not fit //本圈中放不下的点数
+	u8 Poses;                     //Entries in Pose[] //Pose[]中的条目数
+	Lidar_Pose_t Pose[LIDAR_SCAN_PACKS];
+	Lidar_Point_t Point[LIDAR_SCAN_MAX];
+}Lidar_Scan_t;
+
+typedef struct
+{
+	u8 Ready;                     //UART and DMA running //串口和DMA已启动
+	u32 Frames;                   //Frames with a good check byte //校验正确的帧数
+	u32 Bad_Crc;                  //Frames with a wrong check byte //校验错误的帧数
+	u32 Bad_Length;               //Headers followed by a ver_len out of range //帧头之后ver_len超出范围的次数
+	u32 Skipped;                  //Bytes thrown away while looking for a header //寻找帧头时丢弃的字节数
+	u32 Late;                     //Polls that found the ring more than 3/4 full //读取时缓冲区超过3/4满的次数
+	u32 Revolutions;
+	u32 Cycles, Cycles_Max;       //Decoder time per poll, CPU cycles //每次读取的解码耗时，CPU周期数
+}Lidar_t;
+
+extern Lidar_t Lidar;
 
-extern PointDataProcessDef PointDataProcess[1200];//110
 extern LiDARFrameTypeDef Pack_Data;
-extern PointDataProcessDef Dataprocess[1200];//Сϡ桢ֱߡELE״ϵ״
 
-void  UART5_IRQHandler(void);
+//Double buffer: the decoder fills one scan while the consumers read the
+//other. A revolution is closed when the angle wraps through 0, whatever the
+//number of points. Consumers take the published scan with Lidar_Scan_Get and
+//check Lidar_Scan_Valid when they are done: the buffer is reused for the
+//revolution after the next one, so a reader has one revolution (about 100 ms)
+//双缓冲：解码器填充一个缓冲区，使用者读取另一个。角度经过0度回绕时结束一圈，与点数无关。
+//使用者用Lidar_Scan_Get获取已发布的扫描，用完后调用Lidar_Scan_Valid检查：
+//缓冲区在下下圈才被重新写入，因此读取者有一圈(约100ms)的时间
 void data_process(void);
+const Lidar_Scan_t *Lidar_Scan_Get(void);
+u8 Lidar_Scan_Valid(u32 seq);
+
+void Lidar_Init(void);
+void Lidar_Task(void *pvParameters);
+void Lidar_Decode(const u8 *data, u16 len, u32 end_us);
+void Lidar_Pose_Push(void);
 
-extern float Distance_KP,Distance_KD,Distance_KI;		//PID
-extern float Follow_KP,Follow_KD,Follow_KI;  //תPID
+extern float Distance_KP,Distance_KD,Distance_KI;		//距离调整PID参数
+extern float Follow_KP,Follow_KD,Follow_KI;  //转向PID
 extern float Follow_KP_Akm,Follow_KD_Akm,Follow_KI_Akm;
 
-extern float Diff_Along_Distance_KP,Diff_Along_Distance_KD,Diff_Along_Distance_KI;	//PID
-extern float Akm_Along_Distance_KP,Akm_Along_Distance_KD,Akm_Along_Distance_KI;	//PID
-extern float FourWheel_Along_Distance_KP,FourWheel_Along_Distance_KD,FourWheel_Along_Distance_KI;	//PID
-extern float Along_Distance_KP,Along_Distance_KD,Along_Distance_KI;		//PID
+extern float Diff_Along_Distance_KP,Diff_Along_Distance_KD,Diff_Along_Distance_KI;	//距离调整PID参数
+extern float Akm_Along_Distance_KP,Akm_Along_Distance_KD,Akm_Along_Distance_KI;	//距离调整PID参数
+extern float FourWheel_Along_Distance_KP,FourWheel_Along_Distance_KD,FourWheel_Along_Distance_KI;	//距离调整PID参数
+extern float Along_Distance_KP,Along_Distance_KD,Along_Distance_KI;		//距离调整PID参数
 
 
 float Distance_Adjust_PID(float Current_Distance,float Target_Distance);
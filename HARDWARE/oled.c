@@ -1,34 +1,89 @@
 #include "oled.h"
 #include "stdlib.h"
 #include "oledfont.h"  	 
+#include "delay.h"
 
 u8 OLED_GRAM[128][8];	 
+
+//Changed column span of each page, Dirty_Lo > Dirty_Hi: nothing to send
+//每页中被修改的列范围，Dirty_Lo > Dirty_Hi表示无需发送
+static u8 OLED_Dirty_Lo[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+static u8 OLED_Dirty_Hi[8] = { 127, 127, 127, 127, 127, 127, 127, 127 };
+
+u16 OLED_Refresh_Ms = OLED_REFRESH_MS_DEFAULT;
+//Bumped by OLED_Clear, a field drawn in an older generation is gone //OLED_Clear时加1，较早绘制的字段已被清除
+static u32 OLED_Generation = 1;
+OLED_Stats_t OLED_Stats;
+
+static void OLED_Mark(u8 x,u8 page)
+{
+	if(x<OLED_Dirty_Lo[page])OLED_Dirty_Lo[page]=x;
+	if(x>OLED_Dirty_Hi[page])OLED_Dirty_Hi[page]=x;
+}
 /**************************************************************************
-Function: Refresh the OLED screen
+Function: Send the whole frame buffer at the next refresh, the panel content is unknown
+Input   : none
+Output  : none
+函数功能：下次刷新时发送整个显存，用于屏幕内容未知的情况
+入口参数：无
+返回  值：无
+**************************************************************************/
+void OLED_Invalidate(void)
+{
+	u8 i;
+	for(i=0;i<8;i++)
+	{
+		OLED_Dirty_Lo[i]=0;
+		OLED_Dirty_Hi[i]=127;
+	}
+}
+/**************************************************************************
+Function: Refresh the OLED screen, only the changed column span of each page is sent
 Input   : none
 Output  : none
-ܣˢOLEDĻ
-ڲ
-  ֵ
+函数功能：刷新OLED屏幕，每页只发送被修改的列范围
+入口参数：无
+返回  值：无
 **************************************************************************/
 void OLED_Refresh_Gram(void)
 {
+	static u32 window_start, window_bytes;
+	u32 start=getCycleCnt(), sent=0, now;
 	u8 i,n;		    
 	for(i=0;i<8;i++)  
 	{  
-		OLED_WR_Byte (0xb0+i,OLED_CMD);    //Set page address (0~7) //ҳַ0~7
-		OLED_WR_Byte (0x00,OLED_CMD);      //Set the display location - column low address //ʾλáе͵ַ
-		OLED_WR_Byte (0x10,OLED_CMD);      //Set the display location - column height address //ʾλáиߵַ   
-		for(n=0;n<128;n++)OLED_WR_Byte(OLED_GRAM[n][i],OLED_DATA); 
+		if(OLED_Dirty_Lo[i]>OLED_Dirty_Hi[i])continue;
+		OLED_WR_Byte (0xb0+i,OLED_CMD);    //Set page address (0~7) //设置页地址（0~7）
+		OLED_WR_Byte (0x00|(OLED_Dirty_Lo[i]&0x0f),OLED_CMD);      //Set the display location - column low address //设置显示位置—列低地址
+		OLED_WR_Byte (0x10|(OLED_Dirty_Lo[i]>>4),OLED_CMD);        //Set the display location - column height address //设置显示位置—列高地址   
+		for(n=OLED_Dirty_Lo[i];n<=OLED_Dirty_Hi[i];n++)OLED_WR_Byte(OLED_GRAM[n][i],OLED_DATA); 
+		sent+=3+OLED_Dirty_Hi[i]-OLED_Dirty_Lo[i]+1;
+		OLED_Dirty_Lo[i]=128;
+		OLED_Dirty_Hi[i]=0;
 	}   
+
+	if(sent)OLED_Stats.Cycles_Per_Byte=(getCycleCnt()-start)/sent;
+	OLED_Stats.Bytes_Total+=sent;
+	OLED_Stats.Refresh_Count++;
+	window_bytes+=sent;
+	now=HAL_GetTick();
+	if(now-window_start>=1000)
+	{
+		u32 full=OLED_FULL_FRAME_BYTES*1000/OLED_BASELINE_MS;
+		OLED_Stats.Bytes_Per_Second=window_bytes*1000/(now-window_start);
+		OLED_Stats.Skipped_Per_Second=(full>OLED_Stats.Bytes_Per_Second)?full-OLED_Stats.Bytes_Per_Second:0;
+		OLED_Stats.Saved_Us_Per_Second=OLED_Stats.Skipped_Per_Second*OLED_Stats.Cycles_Per_Byte/(SystemCoreClock/1000000);
+		window_start=now;
+		window_bytes=0;
+	}
 }
 /**************************************************************************
 Function: Refresh the OLED screen
 Input   : Dat: data/command to write, CMD: data/command flag 0, represents the command;1, represents data
 Output  : none
-ܣOLEDдһֽ
-ڲdat:Ҫд/cmd:/־ 0,ʾ;1,ʾ
-  ֵ
+函数功能：向OLED写入一个字节
+入口参数：dat:要写入的数据/命令，cmd:数据/命令标志 0,表示命令;1,表示数据
+返回  值：无
 **************************************************************************/  
 void OLED_WR_Byte(u8 dat,u8 cmd)
 {	
@@ -53,13 +108,13 @@ void OLED_WR_Byte(u8 dat,u8 cmd)
 Function: Turn on the OLED display
 Input   : none
 Output  : none
-ܣOLEDʾ 
-ڲ
-  ֵ
+函数功能：开启OLED显示 
+入口参数：无
+返回  值：无
 **************************************************************************/  
 void OLED_Display_On(void)
 {
-	OLED_WR_Byte(0X8D,OLED_CMD);  //SET DCDC command //SET DCDC
+	OLED_WR_Byte(0X8D,OLED_CMD);  //SET DCDC command //SET DCDC命令
 	OLED_WR_Byte(0X14,OLED_CMD);  //DCDC ON
 	OLED_WR_Byte(0XAF,OLED_CMD);  //DISPLAY ON
 }
@@ -67,13 +122,13 @@ void OLED_Display_On(void)
 Function: Turn off the OLED display
 Input   : none
 Output  : none
-ܣرOLEDʾ 
-ڲ			  
-  ֵ
+函数功能：关闭OLED显示 
+入口参数：无			  
+返回  值：无
 **************************************************************************/  
 void OLED_Display_Off(void)
 {
-	OLED_WR_Byte(0X8D,OLED_CMD);  //SET DCDC command //SET DCDC
+	OLED_WR_Byte(0X8D,OLED_CMD);  //SET DCDC command //SET DCDC命令
 	OLED_WR_Byte(0X10,OLED_CMD);  //DCDC OFF
 	OLED_WR_Byte(0XAE,OLED_CMD);  //DISPLAY OFF
 }	
@@ -81,73 +136,96 @@ void OLED_Display_Off(void)
 Function: Screen clear function, clear the screen, the entire screen is black, and did not light up the same
 Input   : none
 Output  : none
-ܣ,,ĻǺɫģûһ
-ڲ		  
-  ֵ
+函数功能：清屏函数,清完屏,整个屏幕是黑色的，和没点亮一样。只清显存，下次刷新时发送
+入口参数：无		  
+返回  值：无
 **************************************************************************/  
 void OLED_Clear(void)  
 {  
 	u8 i,n;  
-	for(i=0;i<8;i++)for(n=0;n<128;n++)OLED_GRAM[n][i]=0X00;  
-	OLED_Refresh_Gram(); //Update the display //ʾ
+	OLED_Generation++;
+	for(i=0;i<8;i++)for(n=0;n<128;n++)
+	{
+		if(OLED_GRAM[n][i]==0X00)continue;
+		OLED_GRAM[n][i]=0X00;  
+		OLED_Mark(n,i);
+	}
 }
 /**************************************************************************
 Function: Draw point
 Input   : x,y: starting coordinate;T :1, fill,0, empty
 Output  : none
-ܣ 
-ڲx,y :; t:1,,0,			  
-  ֵ
+函数功能：画点 
+入口参数：x,y :起点坐标; t:1,填充,0,清空			  
+返回  值：无
 **************************************************************************/ 
 void OLED_DrawPoint(u8 x,u8 y,u8 t)
 {
 	u8 pos,bx,temp=0;
-	if(x>127||y>63)return;//Χ.
+	if(x>127||y>63)return;//超出范围了.
 	pos=7-y/8;
 	bx=y%8;
 	temp=1<<(7-bx);
-	if(t)OLED_GRAM[x][pos]|=temp;
-	else OLED_GRAM[x][pos]&=~temp;	    
+	if(t)temp=OLED_GRAM[x][pos]|temp;
+	else temp=OLED_GRAM[x][pos]&~temp;	    
+	//Pages are redrawn every cycle, only a real change needs sending //页面每周期重绘，只有实际变化才需要发送
+	if(temp==OLED_GRAM[x][pos])return;
+	OLED_GRAM[x][pos]=temp;
+	OLED_Mark(x,pos);
 }
 /**************************************************************************
 Function: Displays a character, including partial characters, at the specified position
 Input   : x,y: starting coordinate;Len: The number of digits;Size: font size;Mode :0, anti-white display,1, normal display
 Output  : none
-ܣָλʾһַ,ַ
-ڲx,y :; len :ֵλ; size:С; mode:0,ʾ,1,ʾ	   
-  ֵ
+函数功能：在指定位置显示一个字符,包括部分字符。字模按列存放，每列两个字节，
+          整列移位后直接写入所跨的(最多3个)页字节，不再逐点调用OLED_DrawPoint
+入口参数：x,y :起点坐标; len :数字的位数; size:字体大小; mode:0,反白显示,1,正常显示	   
+返回  值：无
 **************************************************************************/
 void OLED_ShowChar(u8 x,u8 y,u8 chr,u8 size,u8 mode)
 {      			    
-	u8 temp,t,t1;
-	u8 y0=y;
-	chr=chr-' '; //Get the offset value //õƫƺֵ				   
-    for(t=0;t<size;t++)
+	const unsigned char *glyph;
+	u32 mask,bits,window;
+	u8 t,k,shift,width;
+	int8_t top;
+	if(chr<' '||chr>'~')chr=' ';
+	chr=chr-' '; //Get the offset value //得到偏移后的值				   
+	if(y>63)return;
+	if(size==12)glyph=oled_asc2_1206[chr];  //Invoke 1206 font   //调用1206字体
+	else glyph=oled_asc2_1608[chr];		      //Invoke the 1608 font //调用1608字体 	                          
+	width=size/2;
+
+	//Pixel y sits at bit 7-y%8 of page 7-y/8. The three pages from the top one
+	//form a 24 bit window, pixel k of the column lands on bit 23-y%8-k
+	//像素y位于第7-y/8页的第7-y%8位。从所在页开始的三个页组成24位窗口，列中第k个像素位于第23-y%8-k位
+	top=7-y/8;
+	shift=8-y%8;
+	mask=(u32)((size==12)?0xFFF0:0xFFFF)<<shift;
+    for(t=0;t<width;t++,x++)
     {   
-		if(size==12)temp=oled_asc2_1206[chr][t];  //Invoke 1206 font   //1206
-		else temp=oled_asc2_1608[chr][t];		      //Invoke the 1608 font //1608 	                          
-        for(t1=0;t1<8;t1++)
+		if(x>127)break;
+		bits=((u32)glyph[2*t]<<8|glyph[2*t+1])<<shift;
+		if(!mode)bits=~bits;
+		window=(u32)OLED_GRAM[x][top]<<16;
+		if(top>=1)window|=(u32)OLED_GRAM[x][top-1]<<8;
+		if(top>=2)window|=OLED_GRAM[x][top-2];
+		window=(window&~mask)|(bits&mask);
+		for(k=0;k<3&&top-k>=0;k++)
 		{
-			if(temp&0x80)OLED_DrawPoint(x,y,mode);
-			else OLED_DrawPoint(x,y,!mode);
-			temp<<=1;
-			y++;
-			if((y-y0)==size)
-			{
-				y=y0;
-				x++;
-				break;
-			}
-		}  	 
+			u8 byte=(u8)(window>>(16-8*k));
+			if(!((mask>>(16-8*k))&0xFF)||OLED_GRAM[x][top-k]==byte)continue;
+			OLED_GRAM[x][top-k]=byte;
+			OLED_Mark(x,top-k);
+		}
     }          
 }
 /**************************************************************************
 Function: Find m to the NTH power
 Input   : m: base number, n: power number
 Output  : none
-ܣmnηĺ
-ڲmnη
-  ֵ
+函数功能：求m的n次方的函数
+入口参数：m：底数，n：次方数
+返回  值：无
 **************************************************************************/
 u32 oled_pow(u8 m,u8 n)
 {
@@ -160,9 +238,9 @@ u32 oled_pow(u8 m,u8 n)
 Function: Displays 2 numbers
 Input   : x,y: starting coordinate;Len: The number of digits;Size: font size;Mode: mode, 0, fill mode, 1, overlay mode;Num: value (0 ~ 4294967295);
 Output  : none
-ܣʾ2
-ڲx,y :; len :ֵλ; size:С; mode:ģʽ, 0,ģʽ, 1,ģʽ; num:ֵ(0~4294967295);	 
-  ֵ
+函数功能：显示2个数字
+入口参数：x,y :起点坐标; len :数字的位数; size:字体大小; mode:模式, 0,填充模式, 1,叠加模式; num:数值(0~4294967295);	 
+返回  值：无
 **************************************************************************/
 void OLED_ShowNumber(u8 x,u8 y,u32 num,u8 len,u8 size)
 {         	
@@ -187,9 +265,9 @@ void OLED_ShowNumber(u8 x,u8 y,u32 num,u8 len,u8 size)
 Function: Display string
 Input   : x,y: starting coordinate;*p: starting address of the string
 Output  : none
-ܣʾַ
-ڲx,y :; *p:ַʼַ 
-  ֵ
+函数功能：显示字符串
+入口参数：x,y :起点坐标; *p:字符串起始地址 
+返回  值：无
 **************************************************************************/
 void OLED_ShowString(u8 x,u8 y,const u8 *p)
 {
@@ -205,12 +283,54 @@ void OLED_ShowString(u8 x,u8 y,const u8 *p)
     }  
 }	 
 /**************************************************************************
+Function: Display a number field, reformatted and redrawn only when the shown value changes
+Input   : f: field, position and format set; value: value to show
+Output  : none
+函数功能：显示数值字段，只有显示值变化时才重新格式化和绘制，不使用sprintf
+入口参数：f：已设置位置和格式的字段；value：要显示的数值
+返回  值：无
+**************************************************************************/
+void OLED_ShowField(OLED_Field_t *f,float value)
+{
+	static const int32_t scale[4]={1,10,100,1000};
+	u8 text[OLED_FIELD_MAX_WIDTH+1];
+	u8 pos,i,width=f->Width,frac=f->Frac&3;
+	int32_t v;
+	u32 a;
+
+	//Compare at display resolution, noise below the last digit does not redraw
+	//按显示精度比较，小于末位的变化不重绘
+	if(!(value<2.0e9f/scale[frac]&&value>-2.0e9f/scale[frac]))value=0;
+	v=(int32_t)(value*scale[frac]+(value>=0?0.5f:-0.5f));
+	if(f->Generation==OLED_Generation&&f->Value==v)return;
+	f->Value=v;
+	f->Generation=OLED_Generation;
+
+	//Right aligned, written from the last digit //右对齐，从最低位开始写
+	if(width>OLED_FIELD_MAX_WIDTH)width=OLED_FIELD_MAX_WIDTH;
+	text[width]='\0';
+	pos=width;
+	a=(v<0)?(u32)(-v):(u32)v;
+	for(i=0;i<frac&&pos>0;i++){text[--pos]='0'+a%10;a/=10;}
+	if(frac&&pos>0)text[--pos]='.';
+	do{if(pos>0)text[--pos]='0'+a%10;else{pos=0xFF;break;}a/=10;}while(a);
+	if(pos!=0xFF&&(v<0||(f->Flags&OLED_FIELD_SIGN)))
+	{
+		if(pos>0)text[--pos]=(v<0)?'-':'+';
+		else pos=0xFF;
+	}
+	//Too wide for the field //超出字段宽度
+	if(pos==0xFF){for(i=0;i<width;i++)text[i]='*';pos=0;}
+	while(pos>0)text[--pos]=' ';
+	OLED_ShowString(f->X,f->Y,text);
+}
+/**************************************************************************
 Function: Initialize the OLED
 Input   : none
 Output  : none
-ܣʼOLED	
-ڲ:  
-  ֵ
+函数功能：初始化OLED	
+入口参数: 无 
+返回  值：无
 **************************************************************************/	    
 void OLED_Init(void)
 { 
@@ -218,36 +338,38 @@ void OLED_Init(void)
 	//delay_ms(100);
 	OLED_RST_Set(); 
 				  
-	OLED_WR_Byte(0xAE,OLED_CMD); //Close display //رʾ
-	OLED_WR_Byte(0xD5,OLED_CMD); //The frequency frequency factor, the frequency of the shock //ʱӷƵ,Ƶ
-	OLED_WR_Byte(80,OLED_CMD);   //[3:0], the frequency dividing factor;[7:4], oscillation frequency //[3:0],Ƶ;[7:4],Ƶ
-	OLED_WR_Byte(0xA8,OLED_CMD); //Set the number of driver paths //·
-	OLED_WR_Byte(0X3F,OLED_CMD); //Default 0x3f(1/64) //Ĭ0X3F(1/64) 
-	OLED_WR_Byte(0xD3,OLED_CMD); //Setting display deviation //ʾƫ
-	OLED_WR_Byte(0X00,OLED_CMD); //Default is 0//ĬΪ0
+	OLED_WR_Byte(0xAE,OLED_CMD); //Close display //关闭显示
+	OLED_WR_Byte(0xD5,OLED_CMD); //The frequency frequency factor, the frequency of the shock //设置时钟分频因子,震荡频率
+	OLED_WR_Byte(80,OLED_CMD);   //[3:0], the frequency dividing factor;[7:4], oscillation frequency //[3:0],分频因子;[7:4],震荡频率
+	OLED_WR_Byte(0xA8,OLED_CMD); //Set the number of driver paths //设置驱动路数
+	OLED_WR_Byte(0X3F,OLED_CMD); //Default 0x3f(1/64) //默认0X3F(1/64) 
+	OLED_WR_Byte(0xD3,OLED_CMD); //Setting display deviation //设置显示偏移
+	OLED_WR_Byte(0X00,OLED_CMD); //Default is 0//默认为0
 
-	OLED_WR_Byte(0x40,OLED_CMD); //Sets the number of rows to display starting line [5:0] //ʾʼ [5:0],
+	OLED_WR_Byte(0x40,OLED_CMD); //Sets the number of rows to display starting line [5:0] //设置显示开始行 [5:0],行数
 													
-	OLED_WR_Byte(0x8D,OLED_CMD); //Charge pump setup //ɱ
-	OLED_WR_Byte(0x14,OLED_CMD); //Bit2, on/off //bit2/ر
-	OLED_WR_Byte(0x20,OLED_CMD); //Set up the memory address mode //ڴַģʽ
-	OLED_WR_Byte(0x02,OLED_CMD); //[1:0],00, column address mode;01, line address mode;10. Page address mode;The default 10; //[1:0],00еַģʽ;01еַģʽ;10,ҳַģʽ;Ĭ10;
-	OLED_WR_Byte(0xA1,OLED_CMD); //Segment redefine setting,bit0:0,0- >;0;1, 0 - & gt;127; //ض,bit0:0,0->0;1,0->127;
-	OLED_WR_Byte(0xC0,OLED_CMD); //Set the COM scan direction;Bit3:0, normal mode;1, Re-define schema COM[n-1]- >;COM0;N: Number of driving paths//COMɨ跽;bit3:0,ͨģʽ;1,ضģʽ COM[N-1]->COM0;N:·
-	OLED_WR_Byte(0xDA,OLED_CMD); //Set the COM hardware pin configuration //COMӲ
-	OLED_WR_Byte(0x12,OLED_CMD); //[5:4]configuration //[5:4]
+	OLED_WR_Byte(0x8D,OLED_CMD); //Charge pump setup //电荷泵设置
+	OLED_WR_Byte(0x14,OLED_CMD); //Bit2, on/off //bit2，开启/关闭
+	OLED_WR_Byte(0x20,OLED_CMD); //Set up the memory address mode //设置内存地址模式
+	OLED_WR_Byte(0x02,OLED_CMD); //[1:0],00, column address mode;01, line address mode;10. Page address mode;The default 10; //[1:0],00，列地址模式;01，行地址模式;10,页地址模式;默认10;
+	OLED_WR_Byte(0xA1,OLED_CMD); //Segment redefine setting,bit0:0,0- >;0;1, 0 - & gt;127; //段重定义设置,bit0:0,0->0;1,0->127;
+	OLED_WR_Byte(0xC0,OLED_CMD); //Set the COM scan direction;Bit3:0, normal mode;1, Re-define schema COM[n-1]- >;COM0;N: Number of driving paths//设置COM扫描方向;bit3:0,普通模式;1,重定义模式 COM[N-1]->COM0;N:驱动路数
+	OLED_WR_Byte(0xDA,OLED_CMD); //Set the COM hardware pin configuration //设置COM硬件引脚配置
+	OLED_WR_Byte(0x12,OLED_CMD); //[5:4]configuration //[5:4]配置
 	 
-	OLED_WR_Byte(0x81,OLED_CMD); //Contrast Settings //Աȶ
-	OLED_WR_Byte(0xEF,OLED_CMD); //1~ 255; Default 0x7f (brightness Settings, the bigger the brighter) //1~255;Ĭ0X7F (,ԽԽ)
-	OLED_WR_Byte(0xD9,OLED_CMD); //Set the pre-charging cycle //Ԥ
+	OLED_WR_Byte(0x81,OLED_CMD); //Contrast Settings //对比度设置
+	OLED_WR_Byte(0xEF,OLED_CMD); //1~ 255; Default 0x7f (brightness Settings, the bigger the brighter) //1~255;默认0X7F (亮度设置,越大越亮)
+	OLED_WR_Byte(0xD9,OLED_CMD); //Set the pre-charging cycle //设置预充电周期
 	OLED_WR_Byte(0xf1,OLED_CMD); //[3:0],PHASE 1;[7:4],PHASE 2;
-	OLED_WR_Byte(0xDB,OLED_CMD); //Setting vcomh voltage multiplier//VCOMH ѹ
+	OLED_WR_Byte(0xDB,OLED_CMD); //Setting vcomh voltage multiplier//设置VCOMH 电压倍率
 	OLED_WR_Byte(0x30,OLED_CMD); //[6:4] 000,0.65*vcc;001,0.77*vcc;011,0.83*vcc;
 
-	OLED_WR_Byte(0xA4,OLED_CMD); //Global display; Bit0:1, open; 0, close; (white screen/black screen)//ȫʾ;bit0:1,;0,ر;(/)
-	OLED_WR_Byte(0xA6,OLED_CMD); //Settings display mode; Bit0:1, anti-phase display; 0, normal display//ʾʽ;bit0:1,ʾ;0,ʾ	    						   
-	OLED_WR_Byte(0xAF,OLED_CMD); //Open display //ʾ	 
+	OLED_WR_Byte(0xA4,OLED_CMD); //Global display; Bit0:1, open; 0, close; (white screen/black screen)//全局显示开启;bit0:1,开启;0,关闭;(白屏/黑屏)
+	OLED_WR_Byte(0xA6,OLED_CMD); //Settings display mode; Bit0:1, anti-phase display; 0, normal display//设置显示方式;bit0:1,反相显示;0,正常显示	    						   
+	OLED_WR_Byte(0xAF,OLED_CMD); //Open display //开启显示	 
 	OLED_Clear();
+	OLED_Invalidate();           //Panel RAM is random after reset //复位后屏幕显存内容随机
+	OLED_Refresh_Gram();
 }  
 
 /**************************************************************************
@@ -258,23 +380,23 @@ Input   : x: indicates the horizontal coordinates displayed; Y: the vertical coo
           font_height: the font is high for the use of the word mold, because my screen pixels are 32hours, 128----0~ 7, and four bits per page
 Output  : none
 Note: this method is used to show that the Chinese character must satisfy the size of the word that the word model generates the software to generate the same size as the dot matrix
-ܣʾ	
-ڲ: xʾʾˮƽ; y: ʾʾĴֱ;
-          no: ʾҪʾĺ֣ģ飩hzk[][]ек,ͨкȷҪʾĺ,
-              Ŀfont_widthֵģģʱĵֵСһ;
-          font_height:Ϊģģʱĸ,ҵΪ32*128-----0~78ҳÿҳ4λ
-  ֵ
-ע⣺ַʾһҪģɵֿСͬУ
+函数功能：显示汉字	
+入口参数: x：表示显示的水平坐标; y: 表示显示的垂直坐标;
+          no: 表示要显示的汉字（模组）在hzk[][]数组中的行号,通过行号来确定在数组中要显示的汉字,
+              这里字体的宽font_width的值必须与用字模制作软件生成字模时的点阵值大小一致;
+          font_height:为用字模制作软件生成字模时字体的高,由于我的屏像素为32*128-----0~7共8页，每页4个位
+返回  值：无
+注意：用这种方法来显示汉字一定要满足用字模生成软件生成的字宽与点阵大小相同才行，否者容易乱码
 **************************************************************************/	    
 void OLED_ShowCHinese(u8 x,u8 y,u8 no,u8 font_width,u8 font_height)
 {     			    
 	 u8 t, i;
    for(i=0;i<(font_height/8);i++)	//The maximum height of font_height is 32. this screen is only 8 pages (line), four digits per page
-	                                //font_heightֵΪ32ֻ8ҳУÿҳ4λ
+	                                //font_height最大值为32，这张屏只有8个页（行），每页4个位
 	 {
 			OLED_Set_Pos(x,y+i);	
 			for(t=0;t<font_width;t++)		//The maximum value of font_width is 128. the screen is only that large 
-		                              //font_widthֵΪ128Ļֻô
+		                              //font_width最大值为128，屏幕只有这么大
 			{	
 					OLED_WR_Byte(Hzk16[(font_height/8)*no+i][t],OLED_DATA);
 			}		
@@ -284,9 +406,9 @@ void OLED_ShowCHinese(u8 x,u8 y,u8 no,u8 font_width,u8 font_height)
 Function: Set the coordinates (position) displayed on the screen.
 Input   : x, y: starting point coordinates
 Output  : none
-ܣúĻʾ꣨λã
-ڲ: x,y :
-  ֵ
+函数功能：设置汉字在屏幕上显示的坐标（位置）
+入口参数: x,y :起点坐标
+返回  值：无
 **************************************************************************/	  
 void OLED_Set_Pos(unsigned char x, unsigned char y)
 { 	
@@ -4,7 +4,7 @@
 
 //Oled port macro definition
 // OLED port macro definition for HAL library
-// OLEDź궨壨HAL汾
+// OLED引脚宏定义（HAL库版本）
 #define OLED_RST_Clr() HAL_GPIO_WritePin(GPIOD, GPIO_PIN_12, GPIO_PIN_RESET)   // RST
 #define OLED_RST_Set() HAL_GPIO_WritePin(GPIOD, GPIO_PIN_12, GPIO_PIN_SET)     // RST
 
@@ -20,18 +20,58 @@
 #define OLED_CMD  0  // Command
 #define OLED_DATA 1 // Data
 
+//Panel refresh period, independent of show_task //屏幕刷新周期，与show_task周期无关
+#define OLED_REFRESH_MS_DEFAULT 100
+
+//Traffic to the panel. Only changed spans are sent, the saving is counted
+//against the former full 8 x (3+128) byte refresh every show_task cycle
+//发送到屏幕的数据量。只发送变化的区域，节省量相对原来每个show_task周期完整刷新(8×(3+128)字节)统计
+#define OLED_FULL_FRAME_BYTES   (8*(3+128))
+#define OLED_BASELINE_MS        10
+typedef struct
+{
+	u32 Bytes_Total;              //Since start-up, commands included //开机以来的字节数，含命令
+	u32 Bytes_Per_Second;
+	u32 Skipped_Per_Second;       //Bytes the former refresh would have sent on top //原刷新方式会额外发送的字节数
+	u32 Cycles_Per_Byte;          //Bit-banging cost of one byte //软件模拟发送一个字节的耗时
+	u32 Saved_Us_Per_Second;      //CPU time show_task no longer spends, us per second //show_task节省的CPU时间，微秒/秒
+	u32 Refresh_Count;
+}OLED_Stats_t;
+
+extern OLED_Stats_t OLED_Stats;
+
+//Number field of a display page. The text is kept on screen until the value
+//changes at the shown resolution or the screen is cleared
+//显示页面中的数值字段。在按显示精度的数值变化或清屏之前，屏幕上的文字保持不变
+#define OLED_FIELD_MAX_WIDTH 10
+#define OLED_FIELD_SIGN      0x01     //Show '+' for positive values //正数显示'+'
+typedef struct
+{
+	u8 X, Y;
+	u8 Width;                     //Characters, right aligned, 8 pixels each //字符数，右对齐，每个字符8像素
+	u8 Frac;                      //Decimal places, 0~3 //小数位数，0~3
+	u8 Flags;
+	int32_t Value;                //Value on screen, scaled by 10^Frac //屏幕上的值，放大10^Frac倍
+	u32 Generation;
+}OLED_Field_t;
+
+#define OLED_FIELD(x,y,width,frac,flags) { x, y, width, frac, flags, 0, 0 }
+extern u16 OLED_Refresh_Ms;
+
 //Oled control function
-//OLEDú
+//OLED控制用函数
 void OLED_WR_Byte(u8 dat,u8 cmd);	    
 void OLED_Display_On(void);
 void OLED_Display_Off(void);
-void OLED_Refresh_Gram(void);		   				   		    
+void OLED_Refresh_Gram(void);
+void OLED_Invalidate(void);		   				   		    
 void OLED_Init(void);
 void OLED_Clear(void);
 void OLED_DrawPoint(u8 x,u8 y,u8 t);
 void OLED_ShowChar(u8 x,u8 y,u8 chr,u8 size,u8 mode);
 void OLED_ShowNumber(u8 x,u8 y,u32 num,u8 len,u8 size);
 void OLED_ShowString(u8 x,u8 y,const u8 *p);
+void OLED_ShowField(OLED_Field_t *f,float value);
 
 #define CNSizeWidth  16
 #define CNSizeHeight 16
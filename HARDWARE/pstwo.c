@@ -4,13 +4,13 @@
 #define DELAY_TIME  delay_us(5); 
 
 //Button value reading, zero time storage
-//ֵȡʱ洢
+//按键值读取，零时存储
 u16 Handkey;	
 //Start the order. Request data
-//ʼ
+//开始命令。请求数据
 u8 Comd[2]={0x01,0x42};	
 //Data store array
-//ݴ洢
+//数据存储数组
 u8 Data[9]={0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}; 
 int Beep_Control_Flag = 0;
 u16 MASK[]={
@@ -30,15 +30,15 @@ u16 MASK[]={
     PSB_RED,
     PSB_BLUE,
     PSB_PINK
-	}; //Key value and key name //ֵ밴
+	}; //Key value and key name //按键值与按键名
 
 /**************************************************************************
 Function: Read the control of the ps2 handle
 Input   : none
 Output  : none
-ܣȡPS2ֱĿ
-ڲ
-  ֵ
+函数功能：读取PS2手柄的控制量
+入口参数：无
+返回  值：无
 **************************************************************************/	
 int Strat = 0;
 
@@ -47,35 +47,35 @@ void PS2_Read(void)
 	//static int Strat;
 
 	//Reading key
-  //ȡֵ
+  //读取按键键值
 	PS2_KEY=PS2_DataKey(); 
 	//Read the analog of the remote sensing x axis on the left
-  //ȡңX᷽ģ	
+  //读取左边遥感X轴方向的模拟量	
 	PS2_LX=PS2_AnologData(PSS_LX); 
 	//Read the analog of the directional direction of remote sensing on the left
-  //ȡңY᷽ģ	
+  //读取左边遥感Y轴方向的模拟量	
 	PS2_LY=PS2_AnologData(PSS_LY);
 	//Read the analog of the remote sensing x axis
-  //ȡұңX᷽ģ  
+  //读取右边遥感X轴方向的模拟量  
 	PS2_RX=PS2_AnologData(PSS_RX);
 	//Read the analog of the directional direction of the remote sensing y axis
-  //ȡұңY᷽ģ  
+  //读取右边遥感Y轴方向的模拟量  
 	PS2_RY=PS2_AnologData(PSS_RY);  
 
 	if(PS2_KEY==4) 
 		//The start button on the // handle is pressed
-		//ֱϵStart
+		//手柄上的Start按键被按下
 		Strat=1; 
 	
 		if(Strat&&(PS2_LY<118)&&PS2_ON_Flag==0)
 	{
 		PS2_ON_Flag=RC_ON;APP_ON_Flag=RC_OFF;
 		PS2_Velocity = Default_Velocity;
-		if(Car_Mode == Akm_Car)//ǰתٶǽǶ
+		if(Car_Mode == Akm_Car)//如果是阿克曼车，转向速度是角度
 		{
 			PS2_Turn_Velocity = PS2_Turn_Angle;
 		}
-		else			//ֲ
+		else			//其他车型是两轮差速
 			PS2_Turn_Velocity = Default_Turn_Bias;
   }
 }
@@ -83,9 +83,9 @@ void PS2_Read(void)
 Function: Send commands to the handle
 Input   : none
 Output  : none
-ܣֱ
-ڲ
-  ֵ
+函数功能：向手柄发送命令
+入口参数：无
+返回  值：无
 **************************************************************************/	
 void PS2_Cmd(u8 CMD)
 {
@@ -95,11 +95,11 @@ void PS2_Cmd(u8 CMD)
 	{
 		if(ref&CMD)
 		{
-			DO_H;     //Output a control bit //һλλ
+			DO_H;     //Output a control bit //输出一位控制位
 		}
 		else DO_L;
     delay_us(16);
-		CLK_H;      //Clock lift //ʱ
+		CLK_H;      //Clock lift //时钟拉高
 		DELAY_TIME;
 		CLK_L;
 		DELAY_TIME;
@@ -114,15 +114,15 @@ void PS2_Cmd(u8 CMD)
 Function: Whether it is a red light mode, 0x41= analog green light, 0x73= analog red light
 Input   : none
 Output  : 0: red light mode, other: other modes
-ܣжǷΪģʽ,0x41=ģ̵ƣ0x73=ģ
-ڲ
-  ֵ0ģʽģʽ
+函数功能：判断是否为红灯模式,0x41=模拟绿灯，0x73=模拟红灯
+入口参数：无
+返回  值：0：红灯模式，其他：其他模式
 **************************************************************************/	
 u8 PS2_RedLight(void)
 {
 	CS_L;
-	PS2_Cmd(Comd[0]);  //Start orders //ʼ
-	PS2_Cmd(Comd[1]);  //Request data //
+	PS2_Cmd(Comd[0]);  //Start orders //开始命令
+	PS2_Cmd(Comd[1]);  //Request data //请求数据
 	CS_H;
 	if( Data[1] == 0X73)   return 0 ;
 	else return 1;
@@ -132,18 +132,18 @@ u8 PS2_RedLight(void)
 Function: Read the handle data
 Input   : none
 Output  : none
-ܣȡֱ
-ڲ
-  ֵ
+函数功能：读取手柄数据
+入口参数：无
+返回  值：无
 **************************************************************************/	
 void PS2_ReadData(void)
 {
 	volatile u8 byte=0;
 	volatile u16 ref=0x01;
 	CS_L;
-	PS2_Cmd(Comd[0]);  //Start orders //ʼ
-	PS2_Cmd(Comd[1]);  //Request data //
-	for(byte=2;byte<9;byte++) //Start receiving data //ʼ
+	PS2_Cmd(Comd[0]);  //Start orders //开始命令
+	PS2_Cmd(Comd[1]);  //Request data //请求数据
+	for(byte=2;byte<9;byte++) //Start receiving data //开始接受数据
 	{
 		for(ref=0x01;ref<0x100;ref<<=1)
 		{
@@ -163,9 +163,9 @@ void PS2_ReadData(void)
 Function: Handle the data of the read 2 and handle only the key parts
 Input   : none
 Output  : 0: only one button presses the next time; No press
-ܣԶPS2ݽд,ֻ 
-ڲ
-  ֵ0: ֻһʱ; 1: δ
+函数功能：对读出来的PS2的数据进行处理,只处理按键部分 
+入口参数：无
+返回  值：0: 只有一个按键按下时按下; 1: 未按下
 **************************************************************************/	
 u8 PS2_DataKey()
 {
@@ -174,21 +174,21 @@ u8 PS2_DataKey()
 	PS2_ClearData();
 	PS2_ReadData();
 
-	Handkey=(Data[4]<<8)|Data[3]; //This is 16 buttons, pressed down to 0, and not pressed for 1  //16Ϊ0δΪ1
+	Handkey=(Data[4]<<8)|Data[3]; //This is 16 buttons, pressed down to 0, and not pressed for 1  //这是16个按键，按下为0，未按下为1
 	for(index=0;index<16;index++)
 	{	    
 		if((Handkey&(1<<(MASK[index]-1)))==0)
 		return index+1;
 	}
-	return 0;  //No buttons //ûκΰ
+	return 0;  //No buttons //没有任何按键按下
 }
 /**************************************************************************
 Function: Get a simulation of a rocker
 Input   : Rocker
 Output  : Simulation of rocker, range 0~ 256
-ܣõһҡ˵ģ
-ڲҡ
-  ֵҡ˵ģ, Χ0~256
+函数功能：得到一个摇杆的模拟量
+入口参数：摇杆
+返回  值：摇杆的模拟量, 范围0~256
 **************************************************************************/
 u8 PS2_AnologData(u8 button)
 {
@@ -198,9 +198,9 @@ u8 PS2_AnologData(u8 button)
 Function: Clear data buffer
 Input   : none
 Output  : none
-ܣݻ
-ڲ
-  ֵ
+函数功能：清除数据缓冲区
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_ClearData()
 {
@@ -213,17 +213,17 @@ Function: Handle vibration function
 Input   : motor1: the right small vibrator, 0x00, other
           motor2: the left big shock motor 0x40~ 0xff motor is open, and the value is greater
 Output  : none
-ܣֱ𶯺
-ڲmotor1:ҲС𶯵 0x00أ
-	        motor2:𶯵 0x40~0xFF ֵԽ Խ
-  ֵ
+函数功能：手柄震动函数
+入口参数：motor1:右侧小震动电机 0x00关，其他开
+	        motor2:左侧大震动电机 0x40~0xFF 电机开，值越大 震动越大
+返回  值：无
 ******************************************************/
 void PS2_Vibration(u8 motor1, u8 motor2)
 {
 	CS_L;
 	delay_us(16);
-  PS2_Cmd(0x01); //Start order //ʼ
-	PS2_Cmd(0x42); //Request data //
+  PS2_Cmd(0x01); //Start order //开始命令
+	PS2_Cmd(0x42); //Request data //请求数据
 	PS2_Cmd(0X00);
 	PS2_Cmd(motor1);
 	PS2_Cmd(motor2);
@@ -238,9 +238,9 @@ void PS2_Vibration(u8 motor1, u8 motor2)
 Function: Short press
 Input   : none
 Output  : none
-ܣ̰
-ڲ
-  ֵ
+函数功能：短按
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_ShortPoll(void)
 {
@@ -258,9 +258,9 @@ void PS2_ShortPoll(void)
 Function: Enter configuration
 Input   : none
 Output  : none
-ܣ
-ڲ
-  ֵ
+函数功能：进入配置
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_EnterConfing(void)
 {
@@ -282,9 +282,9 @@ void PS2_EnterConfing(void)
 Function: Send mode Settings
 Input   : none
 Output  : none
-ܣģʽ
-ڲ
-  ֵ
+函数功能：发送模式设置
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_TurnOnAnalogMode(void)
 {
@@ -292,9 +292,9 @@ void PS2_TurnOnAnalogMode(void)
 	PS2_Cmd(0x01);  
 	PS2_Cmd(0x44);  
 	PS2_Cmd(0X00);
-	PS2_Cmd(0x01); //analog=0x01;digital=0x00  Software Settings send mode ÷ģʽ
-	PS2_Cmd(0x03); //0x03 lock storage setup, which cannot be set by the key "mode" set mode. //0x03ãͨMODEģʽ
-				         //0xee non-locking software Settings can be set by the key "mode" set mode.//0xEEãͨMODEģʽ
+	PS2_Cmd(0x01); //analog=0x01;digital=0x00  Software Settings send mode 软件设置发送模式
+	PS2_Cmd(0x03); //0x03 lock storage setup, which cannot be set by the key "mode" set mode. //0x03锁存设置，即不可通过按键“MODE”设置模式。
+				         //0xee non-locking software Settings can be set by the key "mode" set mode.//0xEE不锁存软件设置，可通过按键“MODE”设置模式。
 	PS2_Cmd(0X00);
 	PS2_Cmd(0X00);
 	PS2_Cmd(0X00);
@@ -306,9 +306,9 @@ void PS2_TurnOnAnalogMode(void)
 Function: Vibration setting
 Input   : none
 Output  : none
-ܣ
-ڲ
-  ֵ
+函数功能：振动设置
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_VibrationMode(void)
 {
@@ -326,9 +326,9 @@ void PS2_VibrationMode(void)
 Function: Complete and save the configuration
 Input   : none
 Output  : none
-ܣɲ
-ڲ
-  ֵ
+函数功能：完成并保存配置
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_ExitConfing(void)
 {
@@ -350,27 +350,27 @@ void PS2_ExitConfing(void)
 Function: Handle configuration initialization
 Input   : none
 Output  : none
-ܣֱóʼ
-ڲ
-  ֵ
+函数功能：手柄配置初始化
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_SetInit(void)
 {
 	PS2_ShortPoll();
 	PS2_ShortPoll();
 	PS2_ShortPoll();
-	PS2_EnterConfing();		  //Enter configuration mode //ģʽ
-	PS2_TurnOnAnalogMode();	//The "traffic light" configuration mode and select whether to save //̵ơģʽѡǷ񱣴
-	//PS2_VibrationMode();	//Open vibration mode //ģʽ
-	PS2_ExitConfing();		  //Complete and save the configuration //ɲ
+	PS2_EnterConfing();		  //Enter configuration mode //进入配置模式
+	PS2_TurnOnAnalogMode();	//The "traffic light" configuration mode and select whether to save //“红绿灯”配置模式，并选择是否保存
+	//PS2_VibrationMode();	//Open vibration mode //开启震动模式
+	PS2_ExitConfing();		  //Complete and save the configuration //完成并保存配置
 }
 /**************************************************************************
 Function: Read the handle information
 Input   : none
 Output  : none
-ܣȡֱϢ
-ڲ
-  ֵ
+函数功能：读取手柄信息
+入口参数：无
+返回  值：无
 **************************************************************************/
 void PS2_Receive (void)
 {
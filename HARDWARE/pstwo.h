@@ -5,16 +5,16 @@
       
 
 
-#define DI   PEin(15)     //Input pin //
+#define DI   PEin(15)     //Input pin //输入引脚
 
-#define DO_H PEout(12)=1   //Command height //λ
-#define DO_L PEout(12)=0   //Command low //λ
+#define DO_H PEout(12)=1   //Command height //命令位高
+#define DO_L PEout(12)=0   //Command low //命令位低
 
-#define CS_H PEout(10)=1  //Cs pull up //CS
-#define CS_L PEout(10)=0  //Cs drawdown //CS
+#define CS_H PEout(10)=1  //Cs pull up //CS拉高
+#define CS_L PEout(10)=0  //Cs drawdown //CS拉低
 
-#define CLK_H PEout(8)=1 //Clock lift //ʱ
-#define CLK_L PEout(8)=0 //Clock down //ʱ
+#define CLK_H PEout(8)=1 //Clock lift //时钟拉高
+#define CLK_L PEout(8)=0 //Clock down //时钟拉低
 
 //These are our button constants
 #define PSB_SELECT      1
@@ -39,14 +39,14 @@
 #define PSB_CROSS       15
 #define PSB_SQUARE      16
 
-#define PSS_RX 5   //Right rocker x shaft data   //ҡX
-#define PSS_RY 6   //The left rocker y axis data //ҡY
-#define PSS_LX 7   //Right rocker x axis data    //ҡX
-#define PSS_LY 8   //The left rocker y axis data //ҡY
+#define PSS_RX 5   //Right rocker x shaft data   //右摇杆X轴数据
+#define PSS_RY 6   //The left rocker y axis data //左摇杆Y轴数据
+#define PSS_LX 7   //Right rocker x axis data    //右摇杆X轴数据
+#define PSS_LY 8   //The left rocker y axis data //左摇杆Y轴数据
 
-#define Default_Velocity					0.2			//Ĭңٶȣλmm/s
-#define Default_Turn_Bias					0.3			//Ĭңٶȣλ/s
-#define PS2_Turn_Angle						PI/4		//ֱĬתǶȣλrad
+#define Default_Velocity					0.2			//默认遥控速度，单位mm/s
+#define Default_Turn_Bias					0.3			//默认遥控速度，单位度/s
+#define PS2_Turn_Angle						PI/4		//阿克曼车手柄默认转向角度，单位rad
 
 extern u8 Data[9];
 extern u16 MASK[16];
@@ -1,13 +1,12 @@
 #include "usartx.h"
+#include "app_parser.h"
+#include "uwb.h"
 SEND_DATA Send_Data;
 RECEIVE_DATA Receive_Data;
 extern int Time_count;
-u8 Usart2_Receive_buf[1];          //2жݴŵĻ
-u8 Usart2_Receive;                 //Ӵ2ȡ
+u8 Usart2_Receive_buf[1];          //串口2接收中断数据存放的缓冲区
+u8 Usart2_Receive;                 //从串口2读取的数据
 
-UWB_Data uwb_data;
-char rx_buffer[256];
-uint16_t rx_index = 0;
 
 char rx6_buffer[256];
 uint16_t rx6_index = 0;
@@ -19,181 +18,43 @@ uint8_t esp8266_rx_buffer[512];
 uint16_t esp8266_rx_index = 0;
 uint8_t esp8266_receive_byte;
 
-uint8_t newCoordinateReceived = 0; // ־λʾյ
+uint8_t newCoordinateReceived = 0; // 标志位表示收到新坐标
 /**************************************************************************
 Function: Refresh the OLED screen
 Input   : none
 Output  : none
-ܣ2ж
-ڲ
-  ֵ
+函数功能：串口2接收中断
+入口参数：无
+返回  值：无
 **************************************************************************/
 
 
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {	
 if (huart->Instance == USART2) {
-    int Usart_Receive;
-    static u8 Flag_PID, i, j, Receive[50], Last_Usart_Receive;
-    static float Data;
-    
-    // ر
-    static uint8_t coordBuffer[32];
-    static uint8_t coordIndex = 0;
-    static uint8_t coordParseState = 0; // 0:ȴʼ 1:X 2:Y 3:Yaw
-    
-    Usart_Receive = USART2->DR;
-
-    // ȳԽ
-    if (Usart_Receive == '[') {
-        coordParseState = 1; // ʼX
-        coordIndex = 0;
-        memset(coordBuffer, 0, sizeof(coordBuffer));
-    } else if (coordParseState > 0) {
-        if (Usart_Receive == ',' && coordParseState == 1) {
-            // յһţX
-            coordBuffer[coordIndex] = '\0';
-            Target_position[0] = atof((char*)coordBuffer);
-            coordIndex = 0;
-            coordParseState = 2; // ʼY
-            memset(coordBuffer, 0, sizeof(coordBuffer));
-        } else if (Usart_Receive == ',' && coordParseState == 2) {
-            // յڶţY
-            coordBuffer[coordIndex] = '\0';
-            Target_position[1] = atof((char*)coordBuffer);
-            coordIndex = 0;
-            coordParseState = 3; // ʼYaw
-            memset(coordBuffer, 0, sizeof(coordBuffer));
-        } else if (Usart_Receive == ']' && coordParseState == 3) {
-            // յYaw
-            coordBuffer[coordIndex] = '\0';
-            Target_Yaw = atof((char*)coordBuffer);
-            coordParseState = 0;
-            newCoordinateReceived = 1; // ־
-            Auto_mode = 1; // Զģʽ
-            // ѡȷϻִ
-            // usart2_send("Coordinate received");
-        } else if (coordParseState > 0) {
-            // 洢ֺС
-            if (coordIndex < sizeof(coordBuffer) - 1 && 
-               (Usart_Receive == '.' || (Usart_Receive >= '0' && Usart_Receive <= '9') || 
-                Usart_Receive == '-' || Usart_Receive == '+')) {
-                coordBuffer[coordIndex++] = Usart_Receive;
-            }
-        }
-    } else {
-        // ԭпָ߼ֲ
-        if (Usart_Receive == 0x41 && Last_Usart_Receive == 0x41 && APP_ON_Flag == 0) {
-            APP_ON_Flag = 1;
-        }
-        
-        // ؼ޸ģյκָʱ˳Զģʽ
-        // ǷЧĿָơٶȿƵȣ
-        if (Usart_Receive >= 0x41 && Usart_Receive <= 0x48 ||  // ָ A-H
-            Usart_Receive <= 8 ||                             // ָ 1-8
-            Usart_Receive == 0x58 || Usart_Receive == 0x59 || // ٶȿ X,Y
-            Usart_Receive == 0x4B ||                          // תƽ K
-            Usart_Receive == 0x49 || Usart_Receive == 0x4A || // ƽ I,J
-            Usart_Receive == 0x43 || Usart_Receive == 0x47)   // ת C,G
-        {
-            Auto_mode = 0; // ˳Զģʽлֶģʽ
-            APP_ON_Flag = 1; // ȷֶģʽʹ
-        }
-        
-        Last_Usart_Receive = Usart_Receive;
-        
-        if(Usart_Receive==0x4B) 
-            Turn_Flag=1;
-        else if(Usart_Receive==0x49||Usart_Receive==0x4A) 
-            Turn_Flag=0;
-        
-        if(Turn_Flag==0) {
-            if(Usart_Receive>=0x41&&Usart_Receive<=0x48) {	
-                Flag_Direction=Usart_Receive-0x40;
-            } else if(Usart_Receive<=8) {			
-                Flag_Direction=Usart_Receive;
-            } else Flag_Direction=0;
-        } else if(Turn_Flag==1) {
-            if(Usart_Receive==0x43) {
-                Flag_Left=0,Flag_Right=1;
-            } else if(Usart_Receive==0x47) {
-                Flag_Left=1,Flag_Right=0;
-            } else Flag_Left=0,Flag_Right=0;
-            
-            if(Usart_Receive==0x41||Usart_Receive==0x45) 
-                Flag_Direction=Usart_Receive-0x40;
-            else Flag_Direction=0;
-        }
-        
-        if(Usart_Receive==0x58) RC_Velocity=RC_Velocity+50;
-        if(Usart_Receive==0x59) RC_Velocity=RC_Velocity-50;
-        
-        if(Usart_Receive==0x7B) Flag_PID=1;
-        if(Usart_Receive==0x7D) Flag_PID=2;
-
-        if(Flag_PID==1) {
-            Receive[i]=Usart_Receive;
-            i++;
-        }
-        
-        if(Flag_PID==2) {
-            if(Receive[3]==0x50) PID_Send=1;
-            else if(Receive[1]!=0x23) {								
-                for(j=i;j>=4;j--) {
-                    Data+=(Receive[j-1]-48)*pow(10,i-j);
-                }
-                switch(Receive[1]) {
-                    case 0x30: RC_Velocity=Data; break;
-                    case 0x31: Velocity_KP=Data; break;
-                    case 0x32: Velocity_KI=Data; break;
-                    case 0x33: break;
-                    case 0x34: break;
-                    case 0x35: break;
-                    case 0x36: break;
-                    case 0x37: break;
-                    case 0x38: break;
-                }
-            }
-            
-            Flag_PID=0;
-            i=0;
-            j=0;
-            Data=0;
-            memset(Receive, 0, sizeof(u8)*50);
-            if(RC_Velocity<0) RC_Velocity=0;
-        }
-    }
+    // 中断中只把字节存入环形缓冲区，APP协议由解析任务处理，见app_parser.c
+    u32 isr_start = getCycleCnt();
 
+    App_Rx_Byte_ISR(Usart2_Receive_buf[0]);
     HAL_UART_Receive_IT(&huart2, Usart2_Receive_buf, sizeof(Usart2_Receive_buf));
-    }else if (huart->Instance == UART5) {  // 跢ͣ$KT1,1.69,2.93,4.98,NULL,LO=[-2.45,5.44,1.43]
-      // ǷյһУԻз
-        if (rx_buffer[rx_index] == '\n') {
-            // 
-            rx_buffer[rx_index + 1] = '\0'; // ַ
-            Parse_UWB_Data(rx_buffer);
-            rx_index = 0;
-        } else {
-            rx_index++;
-            if (rx_index >= sizeof(rx_buffer)) {
-                rx_index = 0; // ֹ
-            }
-        }
-        // 
-        HAL_UART_Receive_IT(&huart5, (uint8_t*)&rx_buffer[rx_index], 1);    
+
+    App_Parser_Stats.Isr_Cycles = getCycleCnt() - isr_start;
+    if (App_Parser_Stats.Isr_Cycles > App_Parser_Stats.Isr_Cycles_Max)
+        App_Parser_Stats.Isr_Cycles_Max = App_Parser_Stats.Isr_Cycles;
 	}else if(huart->Instance == USART6) {
-        // յַ뻺
+        // 将接收到的字符存入缓冲区
         if(esp8266_rx_index < sizeof(esp8266_rx_buffer) - 1) {
             esp8266_rx_buffer[esp8266_rx_index++] = esp8266_receive_byte;
             
-            // ⵽ݰǰ
+            // 如果检测到数据包过长，提前处理
             if(esp8266_rx_index > 300) {
-                ESP8266_Process(); // ǿƴǰ
+                ESP8266_Process(); // 强制处理当前数据
             }
         } else {
-            // 
+            // 缓冲区满，重置
             esp8266_rx_index = 0;
             memset(esp8266_rx_buffer, 0, sizeof(esp8266_rx_buffer));
-            debug_print("[] ջ\r\n");
+            debug_print("[警告] 接收缓冲区溢出，已重置\r\n");
         }
         HAL_UART_Receive_IT(&huart6, &esp8266_receive_byte, 1);
     }
@@ -201,14 +62,44 @@ if (huart->Instance == USART2) {
 	
 }
 
+/**************************************************************************
+Function: Idle line or DMA event of a to-idle reception
+Input   : huart: UART handle; Size: position of the DMA in the receive buffer
+Output  : none
+函数功能：空闲线接收的空闲线或DMA事件
+入口参数：huart：串口句柄；Size：DMA在接收缓冲区中的位置
+返回  值：无
+**************************************************************************/
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart->Instance == UART5) {  // UWB：$KT1,1.69,2.93,4.98,NULL,LO=[-2.45,5.44,1.43]
+        Uwb_Rx_Event_ISR(Size);
+    }
+}
+
+/**************************************************************************
+Function: UART error, a DMA reception is stopped by the HAL and has to be started again
+Input   : huart: UART handle
+Output  : none
+函数功能：串口错误，DMA接收被HAL停止，需要重新启动
+入口参数：huart：串口句柄
+返回  值：无
+**************************************************************************/
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == UART5) {
+        Uwb_Rx_Error_ISR();
+    }
+}
+
 
 /**************************************************************************
 Function: Serial port 1 sends data
 Input   : The data to send
 Output  : none
-ܣ1
-ڲҪ͵
-  ֵ
+函数功能：串口1发送数据
+入口参数：要发送的数据
+返回  值：无
 **************************************************************************/
 void usart1_send(u8 data)
 {
@@ -237,9 +128,9 @@ void usart1_send_cstring(const char *str)
 Function: Serial port 3 sends data
 Input   : The data to send
 Output  : none
-ܣ3
-ڲҪ͵
-  ֵ
+函数功能：串口3发送数据
+入口参数：要发送的数据
+返回  值：无
 **************************************************************************/
 void usart5_send(u8 data)
 {
@@ -263,105 +154,6 @@ void usart5_send_cstring(const char *str)
     }
 }
 
-// UWBݺ
-
-void Parse_UWB_Data(char* data) {
-    // ʼUWBݽṹ
-    memset(&uwb_data, 0, sizeof(uwb_data));
-    for (int i = 0; i < 4; i++) {
-        uwb_data.distances[i] = NAN;
-    }
-    uwb_data.valid_position = 0;
-    
-    // ʼ
-    if (data[0] != '$') {
-        return; // Ч
-    }
-    
-    // // ԣӡԭʼ
-    // char debug_msg[200];
-    // snprintf(debug_msg, sizeof(debug_msg), "ԭʼ: %s\r\n", data);
-    // usart1_send_cstring(debug_msg);
-    
-    // ȡɫ˲ģʽ (KT0еKT0)
-    if (strlen(data) >= 3 && data[1] == 'K') {
-        strncpy(uwb_data.filter_mode, "K", 1);
-        // ȡɫ (T0, T1)
-        if (sscanf(data + 2, "%2s", uwb_data.role) == 1) {
-            uwb_data.role[2] = '\0'; // ȷַ
-        }
-    }
-    
-    // ȡϢ
-    char* distances_start = strchr(data, ',') + 1; // ҵһźλ
-    if (distances_start) {
-        int count = sscanf(distances_start, "%f,%f,%f,%f",
-                         &uwb_data.distances[0],
-                         &uwb_data.distances[1],
-                         &uwb_data.distances[2],
-                         &uwb_data.distances[3]);
-        
-        // Ч
-        uwb_data.valid_distances = 0;
-        for (int i = 0; i < 4; i++) {
-            if (!isnan(uwb_data.distances[i])) {
-                uwb_data.valid_distances++;
-            }
-        }
-    }
-    
-    // ȡϢ
-    char* lo_start = strstr(data, "LO=[");
-    if (lo_start) {
-        lo_start += 4; // "LO=["
-        char* lo_end = strchr(lo_start, ']');
-        if (lo_end) {
-            // ʱ洢ַ
-            char coord_str[50];
-            int len = lo_end - lo_start;
-            if (len < sizeof(coord_str) - 1) {
-                strncpy(coord_str, lo_start, len);
-                coord_str[len] = '\0';
-                
-                // ֵ
-                if (sscanf(coord_str, "%f,%f,%f",
-                         &uwb_data.position[0],
-                         &uwb_data.position[1],
-                         &uwb_data.position[2]) == 3) { // ֵ
-                    uwb_data.valid_position = 1;
-					// 洢λ
-					position[0] = uwb_data.position[0]; // 洢X
-					position[1] = uwb_data.position[1]; // 洢Y
-					position[2] = uwb_data.position[2]; // 洢Z
-                }
-            }
-        }
-    }
-    
-    // // 
-    // char buffer[128];
-    // snprintf(buffer, sizeof(buffer), "Role: %s, Filter: %s\r\n", uwb_data.role, uwb_data.filter_mode);
-    // usart1_send_cstring(buffer);
-    
-    // for (int i = 0; i < 4; i++) {
-    //     if (!isnan(uwb_data.distances[i])) {
-    //         snprintf(buffer, sizeof(buffer), "Distance to A%d: %.2f m\r\n", i, uwb_data.distances[i]);
-    //         usart1_send_cstring(buffer);
-    //     }
-    // }
-    
-    // if (uwb_data.valid_position) {
-    //     snprintf(buffer, sizeof(buffer), "Position: [%.2f, %.2f, %.2f]\r\n", 
-    //             uwb_data.position[0], 
-    //             uwb_data.position[1], 
-    //             uwb_data.position[2]);
-    //     usart1_send_cstring(buffer);
-    // } else {
-    //     usart1_send_cstring("δܽϢ\r\n");
-    // }
-    
-    // usart1_send_cstring("--------------------\r\n");
-}
 
 
 
@@ -11,37 +11,37 @@
 #define DATA_STK_SIZE   512 
 #define DATA_TASK_PRIO  4
 
-#define FRAME_HEADER      0X7B //Frame_header //֡ͷ
-#define FRAME_TAIL        0X7D //Frame_tail   //֡β
+#define FRAME_HEADER      0X7B //Frame_header //帧头
+#define FRAME_TAIL        0X7D //Frame_tail   //帧尾
 #define SEND_DATA_SIZE    24
 #define RECEIVE_DATA_SIZE 11
 
-extern uint8_t newCoordinateReceived; // ձ־λ
+extern uint8_t newCoordinateReceived; // 新坐标接收标志位
 
 /*****A structure for storing triaxial data of a gyroscope accelerometer*****/
-/*****ڴǼٶȼݵĽṹ*********************************/
+/*****用于存放陀螺仪加速度计三轴数据的结构体*********************************/
 typedef struct __Mpu6050_Data_ 
 {
-	short X_data; //2 bytes //2ֽ
-	short Y_data; //2 bytes //2ֽ
-	short Z_data; //2 bytes //2ֽ
+	short X_data; //2 bytes //2个字节
+	short Y_data; //2 bytes //2个字节
+	short Z_data; //2 bytes //2个字节
 }Mpu6050_Data;
 
 /*******The structure of the serial port sending data************/
-/*******ڷݵĽṹ*************************************/
+/*******串口发送数据的结构体*************************************/
 typedef struct _SEND_DATA_  
 {
 	unsigned char buffer[SEND_DATA_SIZE];
 	struct _Sensor_Str_
 	{
-		unsigned char Frame_Header; //1ֽ
-		short X_speed;	            //2 bytes //2ֽ
-		short Y_speed;              //2 bytes //2ֽ
-		short Z_speed;              //2 bytes //2ֽ
-		short Power_Voltage;        //2 bytes //2ֽ
-		Mpu6050_Data Accelerometer; //6 bytes //6ֽ
-		Mpu6050_Data Gyroscope;     //6 bytes //6ֽ	
-		unsigned char Frame_Tail;   //1 bytes //1ֽ
+		unsigned char Frame_Header; //1个字节
+		short X_speed;	            //2 bytes //2个字节
+		short Y_speed;              //2 bytes //2个字节
+		short Z_speed;              //2 bytes //2个字节
+		short Power_Voltage;        //2 bytes //2个字节
+		Mpu6050_Data Accelerometer; //6 bytes //6个字节
+		Mpu6050_Data Gyroscope;     //6 bytes //6个字节	
+		unsigned char Frame_Tail;   //1 bytes //1个字节
 	}Sensor_Str;
 }SEND_DATA;
 
@@ -50,31 +50,19 @@ typedef struct _RECEIVE_DATA_
 	unsigned char buffer[RECEIVE_DATA_SIZE];
 	struct _Control_Str_
 	{
-		unsigned char Frame_Header; //1 bytes //1ֽ
-		float X_speed;	            //4 bytes //4ֽ
-		float Y_speed;              //4 bytes //4ֽ
-		float Z_speed;              //4 bytes //4ֽ
-		unsigned char Frame_Tail;   //1 bytes //1ֽ
+		unsigned char Frame_Header; //1 bytes //1个字节
+		float X_speed;	            //4 bytes //4个字节
+		float Y_speed;              //4 bytes //4个字节
+		float Z_speed;              //4 bytes //4个字节
+		unsigned char Frame_Tail;   //1 bytes //1个字节
 	}Control_Str;
 }RECEIVE_DATA;
 
-extern u8 Usart2_Receive_buf[1];          //2жݴŵĻ
-extern u8 Usart2_Receive;                 //Ӵ2ȡ
+extern SEND_DATA Send_Data;               //Status frame to the onboard computer, see host_link.h //发往上位机的状态帧，见host_link.h
+extern RECEIVE_DATA Receive_Data;         //Command frame from the onboard computer //上位机发来的指令帧
+extern u8 Usart2_Receive_buf[1];          //串口2接收中断数据存放的缓冲区
+extern u8 Usart2_Receive;                 //从串口2读取的数据
 
-/*UWBر*/
-// UWBݽṹ
-typedef struct {
-    char role[4];           // 豸ɫ"T0"
-    char filter_mode[3];    // ˲ģʽ"K""NK"
-    float distances[4];     // ĸվľ룬NULLʾΪNAN
-    float position[3];      // λ[x, y, z]
-    uint8_t valid_distances;// Ч
-    uint8_t valid_position; // ǷЧ
-} UWB_Data;
-
-extern UWB_Data uwb_data;
-extern char rx_buffer[256];
-extern uint16_t rx_index;
 
 extern char rx6_buffer[256];
 extern uint16_t rx6_index;
@@ -91,7 +79,6 @@ void usart1_send(u8 data);
 void usart1_send_cstring(const char *str);
 void usart3_send(u8 data);
 void usart3_send_cstring(const char *str);
-void Parse_UWB_Data(char* data);
 #endif
 
 
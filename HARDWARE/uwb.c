@@ -0,0 +1,457 @@
+#include "uwb.h"
+#include "usartx.h"
+#include "num_parse.h"
+#include <math.h>
+
+Uwb_t Uwb;
+UWB_Data uwb_data;
+uint32_t UWB_Parse_Errors = 0;     //Lines with a malformed field //含错误字段的行数
+uint16_t UWB_Parse_Error_Pos = 0;  //Offset of the error in the last bad line //最近一行错误的位置
+char rx_buffer[256];               //Line being assembled by Uwb_Rx_Drain //Uwb_Rx_Drain正在拼接的行
+uint16_t rx_index = 0;
+
+static DMA_HandleTypeDef Uwb_Rx_Dma;
+static uint8_t Uwb_Rx_Ring[UWB_RX_RING];
+static volatile uint16_t Uwb_Rx_Head;       //Written by the idle line interrupt //由空闲线中断写入
+static volatile uint32_t Uwb_Rx_Stamp;
+static volatile uint8_t Uwb_Rx_Restart;     //The reception was restarted at the ring start //接收已从缓冲区开头重新启动
+static uint16_t Uwb_Rx_Tail;                //Next byte the task reads //任务下一个读取的字节
+static uint8_t Uwb_Skipping;                //1: drop bytes up to the next '\n' //1：丢弃字节直到下一个'\n'
+
+static TaskHandle_t Uwb_Handle = NULL;
+static QueueHandle_t Uwb_Mailbox = NULL;   //One slot, always the newest fix //单槽，总是最新的定位
+
+//Last accepted fix, reference of the jump gate //最近一次接受的定位，作为跳变检查的参考
+static Uwb_Sample_t Uwb_Last;
+static uint8_t Uwb_Jumps;
+
+/**************************************************************************
+Function: Create the UWB task and move UART5 from byte interrupts to circular DMA with idle line events
+Input   : none
+Output  : none
+函数功能：创建UWB任务，把UART5从单字节中断接收改为循环DMA加空闲线事件
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Uwb_Init(void)
+{
+	if(Uwb_Mailbox != NULL) return;
+	Uwb_Mailbox = xQueueCreate(1, sizeof(Uwb_Sample_t));
+	if(Uwb_Mailbox == NULL)
+	{
+		usart1_send_cstring("[UWB] 创建邮箱失败\r\n");
+		return;
+	}
+	//Out of FreeRTOS heap: UART5 stays as main set it up and no fix arrives
+	//FreeRTOS堆不足：UART5保持main中的设置，不会有定位数据
+	if(xTaskCreate(Uwb_Task, "uwb_task", UWB_STK_SIZE, NULL, UWB_TASK_PRIO, &Uwb_Handle) != pdPASS)
+	{
+		vQueueDelete(Uwb_Mailbox);
+		Uwb_Mailbox = NULL;
+		Uwb_Handle = NULL;
+		usart1_send_cstring("[UWB] 创建任务失败\r\n");
+		return;
+	}
+
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	HAL_UART_AbortReceive(&huart5);     //Byte reception started in main //停止main中启动的单字节接收
+
+	Uwb_Rx_Dma.Instance = UWB_RX_STREAM;
+	Uwb_Rx_Dma.Init.Channel = UWB_DMA_CHANNEL;
+	Uwb_Rx_Dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	Uwb_Rx_Dma.Init.PeriphInc = DMA_PINC_DISABLE;
+	Uwb_Rx_Dma.Init.MemInc = DMA_MINC_ENABLE;
+	Uwb_Rx_Dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	Uwb_Rx_Dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	Uwb_Rx_Dma.Init.Mode = DMA_CIRCULAR;
+	Uwb_Rx_Dma.Init.Priority = DMA_PRIORITY_LOW;
+	Uwb_Rx_Dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+	if(HAL_DMA_Init(&Uwb_Rx_Dma) != HAL_OK)
+	{
+		usart1_send_cstring("[UWB] DMA初始化失败\r\n");
+		return;
+	}
+	__HAL_LINKDMA(&huart5, hdmarx, Uwb_Rx_Dma);
+
+	Uwb_Rx_Head = 0;
+	if(HAL_UARTEx_ReceiveToIdle_DMA(&huart5, Uwb_Rx_Ring, UWB_RX_RING) != HAL_OK)
+	{
+		usart1_send_cstring("[UWB] 启动接收失败\r\n");
+		return;
+	}
+	//The stream interrupts are not used, only the idle line wakes the task
+	//不使用数据流中断，只由空闲线唤醒任务
+	__HAL_DMA_DISABLE_IT(&Uwb_Rx_Dma, DMA_IT_HT | DMA_IT_TC);
+	Uwb.Ready = 1;
+}
+
+/**************************************************************************
+Function: Idle line event, called from HAL_UARTEx_RxEventCallback
+Input   : head: bytes the DMA has written into the ring, modulo its size
+Output  : none
+函数功能：空闲线事件，在HAL_UARTEx_RxEventCallback中调用
+入口参数：head：DMA写入缓冲区的位置(对缓冲区大小取模)
+返回  值：无
+**************************************************************************/
+void Uwb_Rx_Event_ISR(uint16_t head)
+{
+	BaseType_t woken = pdFALSE;
+
+	Uwb_Rx_Stamp = getMicros();
+	Uwb_Rx_Head = head < UWB_RX_RING ? head : 0;
+	Uwb.Events++;
+
+	if(Uwb_Handle == NULL) return;
+	vTaskNotifyGiveFromISR(Uwb_Handle, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+/**************************************************************************
+Function: Start the DMA reception again after the HAL ended it on a UART error
+Input   : none
+Output  : none
+函数功能：HAL因串口错误结束DMA接收后，重新启动接收
+入口参数：无
+返回  值：无
+**************************************************************************/
+static void Uwb_Rx_Recover(void)
+{
+	uint32_t wait = 10000;
+
+	Uwb.Errors++;
+	Uwb_Rx_Head = 0;
+	Uwb_Rx_Restart = 1;
+	//The HAL stops the stream with HAL_DMA_Abort_IT. The stream interrupt is not
+	//enabled, so the handle stays in HAL_DMA_STATE_ABORT and the next start would
+	//be refused. Wait for the stream to stop and finish the abort here
+	//HAL用HAL_DMA_Abort_IT停止数据流。数据流中断未启用，句柄停留在HAL_DMA_STATE_ABORT，
+	//下一次启动会被拒绝。在此等待数据流停止并完成中止
+	__HAL_DMA_DISABLE(&Uwb_Rx_Dma);
+	while((Uwb_Rx_Dma.Instance->CR & DMA_SxCR_EN) && --wait) {}
+	Uwb_Rx_Dma.State = HAL_DMA_STATE_READY;
+	if(HAL_UARTEx_ReceiveToIdle_DMA(&huart5, Uwb_Rx_Ring, UWB_RX_RING) == HAL_OK)
+		__HAL_DMA_DISABLE_IT(&Uwb_Rx_Dma, DMA_IT_HT | DMA_IT_TC);
+	else Uwb.Ready = 0;
+}
+
+/**************************************************************************
+Function: UART error reported through HAL_UART_ErrorCallback
+Input   : none
+Output  : none
+函数功能：通过HAL_UART_ErrorCallback报告的串口错误
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Uwb_Rx_Error_ISR(void)
+{
+	//Noise or framing errors alone leave the reception running //仅有噪声或帧错误时接收仍在运行
+	if(huart5.RxState == HAL_UART_STATE_BUSY_RX) Uwb.Errors++;
+	else Uwb_Rx_Recover();
+}
+
+// 解析UWB数据函数，在UWB任务中调用，返回1表示整行没有格式错误
+
+uint8_t Parse_UWB_Data(const char* data, uint16_t len) {
+    // 初始化UWB数据结构
+    memset(&uwb_data, 0, sizeof(uwb_data));
+    for (int i = 0; i < 4; i++) {
+        uwb_data.distances[i] = NAN;
+    }
+    uwb_data.valid_position = 0;
+    
+    // 检查数据起始符
+    if (data[0] != '$') {
+        return 0; // 无效数据
+    }
+    
+    // // 调试：打印原始数据
+    // char debug_msg[200];
+    // snprintf(debug_msg, sizeof(debug_msg), "原始数据: %s\r\n", data);
+    // usart1_send_cstring(debug_msg);
+    
+    // 提取角色和滤波模式 (如KT0中的K和T0)
+    // Role and filter mode, e.g. K and T1 of $KT1 //角色和滤波模式，例如$KT1中的K和T1
+    Num_Cursor_t cur;
+    Num_Cursor_Init(&cur, data, len);
+    cur.Pos++;                                   // 跳过'$'
+    if (Num_Peek(&cur) == 'K') {
+        cur.Pos++;
+        strncpy(uwb_data.filter_mode, "K", 1);
+        Num_Token(&cur, uwb_data.role, sizeof(uwb_data.role), ',');
+    }
+    
+    // 提取距离信息
+    // A NULL anchor leaves NAN without hiding the fields after it
+    // NULL基站保持NAN，不影响其后的字段
+    if (Num_Skip_Past(&cur, ',')) {
+        for (int i = 0; i < 4; i++) {
+            if (Num_Peek(&cur) == 'N') {
+                if (!Num_Expect_Str(&cur, "NULL")) break;
+            } else if (!Num_Float(&cur, &uwb_data.distances[i])) {
+                break;
+            }
+            if (Num_Peek(&cur) != ',') break;    // 行尾，没有坐标
+            cur.Pos++;
+        }
+        
+        // 计算有效距离数量
+        uwb_data.valid_distances = 0;
+        for (int i = 0; i < 4; i++) {
+            if (!isnan(uwb_data.distances[i])) {
+                uwb_data.valid_distances++;
+            }
+        }
+    }
+    
+    // 提取坐标信息 LO=[x,y,z]
+    if (Num_Peek(&cur) == 'L' && Num_Expect_Str(&cur, "LO=[")) {
+        float xyz[3];
+        if (Num_Float(&cur, &xyz[0]) && Num_Expect(&cur, ',') &&
+            Num_Float(&cur, &xyz[1]) && Num_Expect(&cur, ',') &&
+            Num_Float(&cur, &xyz[2]) && Num_Expect(&cur, ']')) { // 解析到了坐标值
+            uwb_data.position[0] = xyz[0];
+            uwb_data.position[1] = xyz[1];
+            uwb_data.position[2] = xyz[2];
+            uwb_data.valid_position = 1;   // position[]由Balance_task在检查后写入，见uwb.c
+        }
+    }
+    if (cur.Error != NUM_OK) {
+        UWB_Parse_Errors++;
+        UWB_Parse_Error_Pos = cur.Error_Pos;
+    }
+    
+    // // 输出解析结果
+    // char buffer[128];
+    // snprintf(buffer, sizeof(buffer), "Role: %s, Filter: %s\r\n", uwb_data.role, uwb_data.filter_mode);
+    // usart1_send_cstring(buffer);
+    
+    // for (int i = 0; i < 4; i++) {
+    //     if (!isnan(uwb_data.distances[i])) {
+    //         snprintf(buffer, sizeof(buffer), "Distance to A%d: %.2f m\r\n", i, uwb_data.distances[i]);
+    //         usart1_send_cstring(buffer);
+    //     }
+    // }
+    
+    // if (uwb_data.valid_position) {
+    //     snprintf(buffer, sizeof(buffer), "Position: [%.2f, %.2f, %.2f]\r\n", 
+    //             uwb_data.position[0], 
+    //             uwb_data.position[1], 
+    //             uwb_data.position[2]);
+    //     usart1_send_cstring(buffer);
+    // } else {
+    //     usart1_send_cstring("未能解析到坐标信息\r\n");
+    // }
+    
+    // usart1_send_cstring("--------------------\r\n");
+    return cur.Error == NUM_OK;
+}
+
+/**************************************************************************
+Function: Parse one line, gate the fix and publish it
+Input   : line: NUL terminated line without '\n'; len: its length; stamp: time of the idle line event
+Output  : none
+函数功能：解析一行，检查定位并发布
+入口参数：line：以NUL结尾、不含'\n'的行；len：长度；stamp：空闲线事件的时刻
+返回  值：无
+**************************************************************************/
+static void Uwb_Take_Line(const char *line, uint16_t len, uint32_t stamp)
+{
+	Uwb_Sample_t s;
+	float dx, dy, allowed;
+	uint8_t i;
+
+	Uwb.Lines++;
+	if(!Parse_UWB_Data(line, len) || !uwb_data.valid_position)
+	{
+		Uwb.Bad_Lines++;
+		return;
+	}
+
+	//Quality: distances that can be real //定位质量：可能真实的距离数
+	s.Anchors = 0;
+	for(i = 0; i < 4; i++)
+	{
+		if(isnan(uwb_data.distances[i])) continue;
+		if(uwb_data.distances[i] < UWB_RANGE_MIN || uwb_data.distances[i] > UWB_RANGE_MAX) Uwb.Range_Rejects++;
+		else s.Anchors++;
+	}
+	if(s.Anchors < UWB_MIN_ANCHORS)
+	{
+		Uwb.Few_Anchors++;
+		return;
+	}
+
+	s.X = uwb_data.position[0];
+	s.Y = uwb_data.position[1];
+	s.Z = uwb_data.position[2];
+	s.Stamp_Us = stamp;
+	if(!(fabsf(s.X) < UWB_FIELD_MAX && fabsf(s.Y) < UWB_FIELD_MAX))   //NaN fails too //NaN同样不通过
+	{
+		Uwb.Bad_Lines++;
+		return;
+	}
+
+	//Jump gate, it widens with the time since the last accepted fix. A jump that
+	//persists is the real position (the tag was carried or the anchors moved)
+	//跳变检查，允许范围随距上次接受定位的时间增大。持续存在的跳变视为真实位置(小车被搬动或基站移动)
+	if(Uwb_Last.Seq != 0)
+	{
+		dx = s.X - Uwb_Last.X;
+		dy = s.Y - Uwb_Last.Y;
+		allowed = UWB_MAX_SPEED * (float)(stamp - Uwb_Last.Stamp_Us) * 1e-6f + UWB_JUMP_MARGIN;
+		if(dx * dx + dy * dy > allowed * allowed)
+		{
+			Uwb.Jump_Rejects++;
+			if(++Uwb_Jumps < UWB_REACQUIRE) return;
+			Uwb.Reacquired++;
+		}
+	}
+	Uwb_Jumps = 0;
+
+	s.Seq = ++Uwb.Accepted;
+	Uwb_Last = s;
+	xQueueOverwrite(Uwb_Mailbox, &s);
+	Uwb.Latency_Us = getMicros() - stamp;
+}
+
+/**************************************************************************
+Function: Cut the bytes received up to the last idle line event into lines and take them, called by the UWB task
+Input   : none
+Output  : none
+函数功能：把截至最近一次空闲线事件接收的字节切分成行并处理，由UWB任务调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Uwb_Rx_Drain(void)
+{
+	uint16_t head;
+	uint32_t stamp;
+
+	if(Uwb_Rx_Restart)
+	{
+		Uwb_Rx_Restart = 0;
+		Uwb_Rx_Tail = 0;
+		rx_index = 0;
+		Uwb_Skipping = 1;     //The line in progress is broken //正在接收的行已损坏
+	}
+	head = Uwb_Rx_Head;
+	stamp = Uwb_Rx_Stamp;
+
+	while(Uwb_Rx_Tail != head)
+	{
+		char b = (char)Uwb_Rx_Ring[Uwb_Rx_Tail];
+		Uwb_Rx_Tail = (Uwb_Rx_Tail + 1) % UWB_RX_RING;
+
+		if(b == '\n')
+		{
+			if(!Uwb_Skipping && rx_index > 0)
+			{
+				rx_buffer[rx_index] = '\0';
+				Uwb_Take_Line(rx_buffer, rx_index, stamp);
+			}
+			rx_index = 0;
+			Uwb_Skipping = 0;
+			continue;
+		}
+		if(Uwb_Skipping) continue;
+		if(rx_index >= sizeof(rx_buffer) - 1)
+		{
+			Uwb.Long_Lines++;
+			Uwb_Skipping = 1;
+			continue;
+		}
+		rx_buffer[rx_index++] = b;
+	}
+}
+
+/**************************************************************************
+Function: UWB task: cut the received bytes into lines and publish the fixes
+Input   : pvParameters: unused
+Output  : none
+函数功能：UWB任务：把接收的字节切分成行并发布定位
+入口参数：pvParameters：未使用
+返回  值：无
+**************************************************************************/
+void Uwb_Task(void *pvParameters)
+{
+	TickType_t last_report = xTaskGetTickCount();
+	uint32_t reported_lines = 0;
+
+	Uwb_Rx_Tail = 0;
+	Uwb_Skipping = 0;
+	rx_index = 0;
+	for(;;)
+	{
+		//The timeout checks the reception and keeps the statistics going without data
+		//超时用于无数据时检查接收并输出统计
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(UWB_RX_CHECK_MS));
+
+		//A UART error (overrun, noise, framing) ends the reception inside
+		//HAL_UART_IRQHandler. With DMA reception the HAL reports it only from the
+		//stream interrupt, which is not used, so it is detected here
+		//串口错误(溢出、噪声、帧错误)在HAL_UART_IRQHandler中结束接收。DMA接收时HAL只在数据流中断中
+		//报告该错误，而数据流中断未使用，因此在此检测
+		if(Uwb.Ready && huart5.RxState != HAL_UART_STATE_BUSY_RX)
+		{
+			taskENTER_CRITICAL();
+			if(huart5.RxState != HAL_UART_STATE_BUSY_RX) Uwb_Rx_Recover();
+			taskEXIT_CRITICAL();
+		}
+
+		Uwb_Rx_Drain();
+
+		if(xTaskGetTickCount() - last_report >= pdMS_TO_TICKS(10000) && Uwb.Lines != reported_lines)
+		{
+			char msg[128];
+
+			last_report = xTaskGetTickCount();
+			reported_lines = Uwb.Lines;
+			snprintf(msg, sizeof(msg), "[UWB] 行%lu 错误%lu 基站不足%lu 跳变%lu 接受%lu 延迟%luus 串口错误%lu\r\n",
+			         (unsigned long)Uwb.Lines, (unsigned long)Uwb.Bad_Lines, (unsigned long)Uwb.Few_Anchors,
+			         (unsigned long)Uwb.Jump_Rejects, (unsigned long)Uwb.Accepted, (unsigned long)Uwb.Latency_Us,
+			         (unsigned long)Uwb.Errors);
+			usart1_send_cstring(msg);
+		}
+	}
+}
+
+/**************************************************************************
+Function: Take the newest fix into position[], called at the start of Balance_task
+Input   : none
+Output  : none
+函数功能：把最新的定位写入position[]，在Balance_task周期开始时调用
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Uwb_Position_Poll(void)
+{
+	Uwb_Sample_t s;
+
+	if(Uwb_Mailbox != NULL && xQueueReceive(Uwb_Mailbox, &s, 0) == pdPASS)
+	{
+		Uwb.Fix = s;
+		position[0] = s.X;
+		position[1] = s.Y;
+		position[2] = s.Z;
+	}
+	Uwb.Age_Ms = (getMicros() - Uwb.Fix.Stamp_Us) / 1000u;
+	Uwb.Stale = (Uwb.Fix.Seq == 0 || Uwb.Age_Ms > UWB_STALE_MS);
+}
+
+/**************************************************************************
+Function: Own position now: the fix in position[] moved on by its age at the velocity driven since
+Input   : vx, vy: world velocity, m/s; x, y: result, m
+Output  : none
+函数功能：当前时刻的本车位置：position[]中的定位按其时长和此后的行驶速度外推
+入口参数：vx，vy：世界坐标系速度，m/s；x，y：结果，m
+返回  值：无
+**************************************************************************/
+void Uwb_Position_Now(float vx, float vy, float *x, float *y)
+{
+	//A stale fix stops the position modes, the extrapolation is bounded by that age
+	//过期定位会使位置模式停车，外推时间以此为上限
+	float age = (float)(Uwb.Age_Ms < UWB_STALE_MS ? Uwb.Age_Ms : UWB_STALE_MS) * 0.001f;
+
+	*x = position[0] + vx * age;
+	*y = position[1] + vy * age;
+}
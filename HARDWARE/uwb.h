@@ -0,0 +1,92 @@
+#ifndef __UWB_H
+#define __UWB_H
+#include "system.h"
+#include "queue.h"
+
+//UWB tag on UART5, one text line per fix:
+//  $KT1,1.69,2.93,4.98,NULL,LO=[-2.45,5.44,1.43]
+//The DMA writes the bytes into a circular buffer, the idle line interrupt
+//only stamps the time and wakes the UWB task. The task cuts the lines, parses
+//them and gates every fix: distances outside the valid range do not count as
+//anchors, too few anchors or a jump faster than the car can drive reject the
+//fix. An accepted fix goes to a one slot mailbox with its time stamp and
+//Balance_task copies it to position[] at the start of its cycle, so the
+//position never changes in the middle of a control cycle.
+//UART5上的UWB标签，每次定位一行文本。DMA把字节写入循环缓冲区，空闲线中断只记录时间并唤醒UWB任务。
+//任务切分行、解析并检查每次定位：超出有效范围的距离不计为基站，基站数过少或跳变速度超过小车能力时
+//拒绝该次定位。通过检查的定位连同时间戳放入单槽邮箱，由Balance_task在周期开始时复制到position[]，
+//因此位置不会在控制周期中途改变
+
+#define UWB_UART              UART5
+#define UWB_RX_STREAM         DMA1_Stream0
+#define UWB_DMA_CHANNEL       DMA_CHANNEL_4
+#define UWB_TASK_PRIO         2       //Below the control task //低于控制任务
+#define UWB_STK_SIZE          256
+#define UWB_RX_RING           256     //Several lines, the task is woken once per line //可容纳数行，每行唤醒任务一次
+#define UWB_RX_CHECK_MS       20      //Without data the task checks this often that the reception still runs //无数据时任务按该周期检查接收是否仍在运行
+
+//Gates of a fix //定位检查
+#define UWB_RANGE_MIN         0.05f   //Shorter distances are multipath or a dead anchor, m //更短的距离为多径或基站故障，m
+#define UWB_RANGE_MAX         30.0f   //Longer than the field, m //超出场地范围，m
+#define UWB_MIN_ANCHORS       3       //Fewer valid distances give no unique position //有效距离少于该值时位置不唯一
+#define UWB_FIELD_MAX         50.0f   //|x|, |y| beyond this are garbage, m //|x|、|y|超过该值为错误数据，m
+#define UWB_MAX_SPEED         1.5f    //Faster than the car can drive, m/s //超过小车的最大速度，m/s
+#define UWB_JUMP_MARGIN       0.20f   //Ranging noise allowed on top of the speed, m //在速度之外允许的测距噪声，m
+#define UWB_REACQUIRE         5       //Consecutive jumps accepted as the new position //连续跳变该次数后接受为新位置
+#define UWB_STALE_MS          500     //Older fixes are stale, AUTO, FOLLOWER and CONSENSUS stop //超过该时间的定位视为过期，AUTO、FOLLOWER和CONSENSUS模式停车
+
+/*UWB解析相关变量*/
+// UWB数据结构体
+typedef struct {
+    char role[4];           // 设备角色，如"T0"
+    char filter_mode[3];    // 滤波模式，"K"或"NK"
+    float distances[4];     // 到四个基站的距离，NULL表示为NAN
+    float position[3];      // 定位坐标[x, y, z]
+    uint8_t valid_distances;// 有效距离数量
+    uint8_t valid_position; // 坐标是否有效
+} UWB_Data;
+
+extern UWB_Data uwb_data;
+extern uint32_t UWB_Parse_Errors;
+extern uint16_t UWB_Parse_Error_Pos;
+extern char rx_buffer[256];
+extern uint16_t rx_index;
+
+typedef struct
+{
+	float X, Y, Z;                //Position, m //位置，m
+	uint32_t Stamp_Us;            //getMicros() of the idle line that ended the line //该行结束时空闲线中断的时刻
+	uint8_t Anchors;              //Distances inside the valid range, quality of the fix //有效范围内的距离数，即定位质量
+	uint32_t Seq;                 //Accepted fixes so far //已接受的定位数
+}Uwb_Sample_t;
+
+typedef struct
+{
+	uint8_t Ready;                //UART and DMA running //串口和DMA已启动
+	Uwb_Sample_t Fix;             //Fix in position[], copied by Balance_task //position[]中的定位，由Balance_task复制
+	uint32_t Age_Ms;              //Age of that fix at the start of the control cycle //控制周期开始时该定位的时长
+	uint8_t Stale;                //1: no fix for UWB_STALE_MS //1：UWB_STALE_MS内没有定位
+
+	uint32_t Events, Errors;      //Idle line events / UART errors that restarted the reception //空闲线事件数/重启接收的串口错误数
+	uint32_t Lines, Long_Lines;   //Lines received / dropped for not fitting the line buffer //接收行数/超出行缓冲区而丢弃的行数
+	uint32_t Bad_Lines;           //Lines with a syntax error or without a position //语法错误或没有位置的行数
+	uint32_t Range_Rejects;       //Distances outside the valid range //超出有效范围的距离数
+	uint32_t Few_Anchors;         //Fixes with too few anchors //基站数过少的定位数
+	uint32_t Jump_Rejects;        //Fixes rejected by the jump gate //被跳变检查拒绝的定位数
+	uint32_t Reacquired;          //Jumps accepted after UWB_REACQUIRE in a row //连续跳变后接受的次数
+	uint32_t Accepted;            //Fixes published //已发布的定位数
+	uint32_t Latency_Us;          //Idle line to published, last fix //最近一次从空闲线到发布的耗时
+}Uwb_t;
+
+extern Uwb_t Uwb;
+
+uint8_t Parse_UWB_Data(const char* data, uint16_t len);
+void Uwb_Init(void);
+void Uwb_Rx_Event_ISR(uint16_t head);
+void Uwb_Rx_Error_ISR(void);
+void Uwb_Task(void *pvParameters);
+void Uwb_Rx_Drain(void);
+void Uwb_Position_Poll(void);
+void Uwb_Position_Now(float vx, float vy, float *x, float *y);
+
+#endif
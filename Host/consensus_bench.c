@@ -0,0 +1,224 @@
+#include "formation_consensus.h"
+#include "fast_math.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//Four cars running formation_consensus.c in virtual time, each on its own
+//view of the broadcast reports. Checks the algebraic connectivity against
+//the closed forms of the chain, complete and split graphs, that a chain
+//gathers into the formation without a leader, and that it translates with
+//a FORMATION:LEADER car driving on its own. The exit status is 0 when all
+//checks pass.
+//在虚拟时间中运行四辆车的formation_consensus.c，每辆车使用各自收到的广播数据。检查代数连通度与
+//链式、全连接和不连通图的解析值一致，链式拓扑在没有领航者时聚成队形，以及在FORMATION:LEADER
+//领航者自行行驶时编队随之平移。全部检查通过时返回0
+
+#define CONTROL_MS        10          //Balance_task period //Balance_task周期
+#define REPORT_MS         100         //Status broadcast period //状态广播周期
+#define V_MAX             0.3f        //Formation_max_speed
+#define SMOOTH_STEP       0.01f       //Smooth_control slew per tick //Smooth_control每周期变化量
+#define YAW_RATE_MAX      60.0f       //Heading loop rate limit, degree/s //航向环角速度限幅
+#define FORMATION_TOL     0.10f       //Largest slot error between two cars at the end, m //结束时两车编队位置误差上限
+
+//Firmware globals formation_consensus.c uses //formation_consensus.c用到的固件全局变量
+uint8_t communication_topology[MAX_CARS][MAX_CARS];
+uint8_t topology_enabled = 1;
+OtherCarInfo other_cars[MAX_OTHER_CARS];
+
+typedef struct
+{
+	float X, Y, Yaw, VX, VY;      //World frame, applied velocity after the slew //世界坐标系，斜率限制后的速度
+	OtherCarInfo Report;          //Last broadcast of this car //本车最近一次广播
+	Formation_Consensus_t C;
+}Car_t;
+
+static Car_t Cars[MAX_CARS];
+static int Failures;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static float Slew(float now, float target)
+{
+	if(target > now + SMOOTH_STEP) return now + SMOOTH_STEP;
+	if(target < now - SMOOTH_STEP) return now - SMOOTH_STEP;
+	return target;
+}
+
+//Undirected edges a-b of the chain 1-2-3-4 and the others //链式1-2-3-4等拓扑的无向边
+static void Topology_Set(const char *edges)
+{
+	memset(communication_topology, 0, sizeof(communication_topology));
+	for(; edges[0] && edges[1]; edges += 2)
+	{
+		communication_topology[edges[0] - '1'][edges[1] - '1'] = 1;
+		communication_topology[edges[1] - '1'][edges[0] - '1'] = 1;
+	}
+}
+
+//What car i hears: every other car's last report //车i收到的数据：其他各车最近一次广播
+static void View_Of(int i)
+{
+	int j, n = 0;
+
+	memset(other_cars, 0, sizeof(other_cars));
+	for(j = 0; j < MAX_CARS; j++)
+		if(j != i && Cars[j].Report.valid) other_cars[n++] = Cars[j].Report;
+}
+
+//Largest distance between the offset corrected positions p-d, slots turned by each car's heading
+//各车去偏移后位置p-d之间的最大距离，编队位置按各车航向旋转
+static float Formation_Spread(void)
+{
+	float ox[MAX_CARS], oy[MAX_CARS], s, c, d, worst = 0;
+	int i, j;
+
+	for(i = 0; i < MAX_CARS; i++)
+	{
+		s = sinf(Cars[i].Yaw * 0.01745329f);
+		c = cosf(Cars[i].Yaw * 0.01745329f);
+		ox[i] = Cars[i].X - (Cars[i].C.Slot_X[i] * c - Cars[i].C.Slot_Y[i] * s);
+		oy[i] = Cars[i].Y - (Cars[i].C.Slot_X[i] * s + Cars[i].C.Slot_Y[i] * c);
+	}
+	for(i = 0; i < MAX_CARS; i++)
+		for(j = i + 1; j < MAX_CARS; j++)
+		{
+			d = hypotf(ox[i] - ox[j], oy[i] - oy[j]);
+			if(d > worst) worst = d;
+		}
+	return worst;
+}
+
+typedef struct
+{
+	float Lambda2, Spread, Leader_Gap, Rate;
+}Run_Result_t;
+
+//leader: index of a FORMATION:LEADER car driving at leader_v along x, -1 none
+//leader：以leader_v沿x方向自行行驶的领航者索引，-1表示没有
+static Run_Result_t Consensus_Run(const char *edges, int leader, float leader_v, float run_s)
+{
+	static const float Start[MAX_CARS][3] = { { 0.0f, 0.0f, 0 }, { -1.2f, 1.5f, 20 }, { 0.8f, -2.0f, -30 }, { -2.5f, -0.5f, 45 } };
+	static const float Slot[MAX_CARS][2] = { { 0.0f, 0.0f }, { -0.8f, 0.0f }, { -1.6f, 0.0f }, { -2.4f, 0.0f } };
+	Run_Result_t r = { 0, 0, 0, 0 };
+	float vx, vy, yaw_target, speed, s, c, dyaw;
+	uint32_t n, steps = (uint32_t)(run_s * 1000.0f / CONTROL_MS);
+	int i, j, watch = (leader == 1) ? 2 : 1;   //A car running the law //运行控制律的一辆车
+
+	Topology_Set(edges);
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	for(i = 0; i < MAX_CARS; i++)
+	{
+		memset(&Cars[i], 0, sizeof(Cars[i]));
+		Cars[i].X = Start[i][0];
+		Cars[i].Y = Start[i][1];
+		Cars[i].Yaw = Start[i][2];
+		Cars[i].C.Gain = CONSENSUS_GAIN;
+		for(j = 0; j < MAX_CARS; j++)
+		{
+			Cars[i].C.Slot_X[j] = Slot[j][0];
+			Cars[i].C.Slot_Y[j] = Slot[j][1];
+		}
+		Formation_Consensus_Reset(&Cars[i].C);
+	}
+
+	for(n = 0; n < steps; n++, Host_Clock_Skip_us(CONTROL_MS * 1000))
+	{
+		//Broadcasts, body frame velocity as ESP8266_SendStatus_UDP_Reliable sends it
+		//广播数据，速度为车体坐标系，与ESP8266_SendStatus_UDP_Reliable相同
+		if(n % (REPORT_MS / CONTROL_MS) == 0)
+			for(i = 0; i < MAX_CARS; i++)
+			{
+				OtherCarInfo *p = &Cars[i].Report;
+
+				s = sinf(Cars[i].Yaw * 0.01745329f);
+				c = cosf(Cars[i].Yaw * 0.01745329f);
+				snprintf(p->car_id, sizeof(p->car_id), "CAR%d", i + 1);
+				p->position_x = Cars[i].X;
+				p->position_y = Cars[i].Y;
+				p->yaw = Cars[i].Yaw;
+				p->velocity_vx =  Cars[i].VX * c + Cars[i].VY * s;
+				p->velocity_vy = -Cars[i].VX * s + Cars[i].VY * c;
+				p->last_update = HAL_GetTick();
+				p->valid = 1;
+			}
+
+		for(i = 0; i < MAX_CARS; i++)
+		{
+			if(i == leader)
+			{
+				vx = leader_v;
+				vy = 0;
+				yaw_target = 0;
+			}
+			else
+			{
+				View_Of(i);
+				Formation_Consensus_Update(&Cars[i].C, (uint8_t)i, Cars[i].X, Cars[i].Y, Cars[i].Yaw,
+				                           CONTROL_MS * 0.001f, &vx, &vy, &yaw_target);
+				//Same limit as Formation_Consensus_Control //与Formation_Consensus_Control相同的限幅
+				speed = hypotf(vx, vy);
+				if(speed > V_MAX)
+				{
+					vx *= V_MAX / speed;
+					vy *= V_MAX / speed;
+				}
+			}
+			Cars[i].VX = Slew(Cars[i].VX, vx);
+			Cars[i].VY = Slew(Cars[i].VY, vy);
+			dyaw = Fast_Wrap180(yaw_target - Cars[i].Yaw) * 2.0f;
+			if(dyaw > YAW_RATE_MAX)  dyaw = YAW_RATE_MAX;
+			if(dyaw < -YAW_RATE_MAX) dyaw = -YAW_RATE_MAX;
+			Cars[i].Yaw = Fast_Wrap180(Cars[i].Yaw + dyaw * CONTROL_MS * 0.001f);
+			Cars[i].X += Cars[i].VX * CONTROL_MS * 0.001f;
+			Cars[i].Y += Cars[i].VY * CONTROL_MS * 0.001f;
+		}
+		if(Cars[watch].C.Rate > r.Rate) r.Rate = Cars[watch].C.Rate;
+	}
+
+	r.Lambda2 = Cars[watch].C.Lambda2;
+	r.Spread = Formation_Spread();
+	if(leader >= 0)
+		for(i = 0; i < MAX_CARS; i++)
+			if(fabsf(Cars[i].VX - leader_v) + fabsf(Cars[i].VY) > r.Leader_Gap) r.Leader_Gap = fabsf(Cars[i].VX - leader_v) + fabsf(Cars[i].VY);
+	return r;
+}
+
+int main(void)
+{
+	Run_Result_t r;
+	float chain = 2.0f - sqrtf(2.0f);   //lambda2 of the path on 4 nodes, 2-2cos(pi/4) //4节点路径图的lambda2
+
+	printf("consensus formation, 4 cars, reports every %d ms\n", REPORT_MS);
+
+	r = Consensus_Run("12233441131424", -1, 0, 1.0f);
+	printf("complete graph: lambda2 %.4f\n", (double)r.Lambda2);
+	Check(fabsf(r.Lambda2 - 4.0f) < 1e-3f, "lambda2 of the complete graph is 4");
+
+	r = Consensus_Run("1234", -1, 0, 1.0f);
+	printf("split graph 1-2, 3-4: lambda2 %.4f\n", (double)r.Lambda2);
+	Check(r.Lambda2 == 0.0f, "lambda2 of a split graph is 0");
+
+	r = Consensus_Run("122334", -1, 0, 40.0f);
+	printf("chain 1-2-3-4, no leader: lambda2 %.4f (exact %.4f), spread %.3f m, peak rate %.2f/s\n",
+	       (double)r.Lambda2, (double)chain, (double)r.Spread, (double)r.Rate);
+	Check(fabsf(r.Lambda2 - chain) < 1e-3f, "lambda2 of the chain is 2-sqrt(2)");
+	Check(r.Spread < FORMATION_TOL, "chain gathers into the formation");
+	Check(r.Rate > 0.0f, "disagreement decays");
+
+	r = Consensus_Run("122334", 0, 0.2f, 40.0f);
+	printf("chain 1-2-3-4, CAR1 leader at 0.2 m/s: spread %.3f m, speed gap %.3f m/s, CAR4 at x %.2f\n",
+	       (double)r.Spread, (double)r.Leader_Gap, (double)Cars[3].X);
+	Check(r.Spread < FORMATION_TOL, "chain holds the formation behind the leader");
+	Check(r.Leader_Gap < 0.02f, "every car drives at the leader speed");
+	Check(Cars[3].X > 5.0f, "the formation translates with the leader");
+
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+#include "stream_filter.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <math.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TICKS() __rdtsc()
+#else
+#define BENCH_TICKS() 0ULL
+#endif
+
+//Benchmark and equivalence check of stream_filter.c against the code it replaced:
+//the six axis shift and re-sum average of MPU6050_newValues, the leader speed
+//average of Detect_Leader_Motion_State and the velocity low pass of
+//Calculate_Car_Velocity. The exit status is 0 when all checks pass.
+//stream_filter.c与其替换的旧代码的性能对比和一致性检查：MPU6050_newValues的六轴移位求和平均、
+//Detect_Leader_Motion_State的领航者速度平均和Calculate_Car_Velocity的速度低通。全部检查通过时返回0
+
+#define BENCH_SAMPLES   1000000
+#define AXES            6
+#define WINDOW          10
+
+static int Failures;
+static volatile int32_t Sink_i;
+static volatile float Sink_f;
+static uint32_t Seed = 12345;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static int16_t Noise(void)
+{
+	Seed = Seed * 1664525U + 1013904223U;
+	return (int16_t)(Seed >> 16);
+}
+
+static void Report(const char *name, uint32_t ns, uint64_t ticks, uint32_t samples)
+{
+	printf("  %-28s %7.2f ns/sample", name, (double)ns / samples);
+	if(ticks) printf(" %7.2f TSC ticks/sample", (double)ticks / samples);
+	printf("\n");
+}
+
+//MPU6050_newValues before the change: zero filled window, shifted and summed every sample
+//修改前的MPU6050_newValues：窗口初值为0，每个样本移位并重新求和
+static int16_t Old_Fifo[AXES][WINDOW + 1];
+
+static void Old_New_Values(const int16_t *s)
+{
+	uint8_t i, a;
+	int32_t sum;
+	for(i = 1; i < WINDOW; i++)
+		for(a = 0; a < AXES; a++) Old_Fifo[a][i - 1] = Old_Fifo[a][i];
+	for(a = 0; a < AXES; a++) Old_Fifo[a][WINDOW - 1] = s[a];
+	for(a = 0; a < AXES; a++)
+	{
+		sum = 0;
+		for(i = 0; i < WINDOW; i++) sum += Old_Fifo[a][i];
+		Old_Fifo[a][WINDOW] = (int16_t)(sum / WINDOW);
+	}
+}
+
+static void Bench_Six_Axis(void)
+{
+	static int16_t input[4096][AXES];
+	int32_t window[AXES][WINDOW];
+	Filter_MA_t ma[AXES];
+	uint32_t i, a, t, warmup_diff = 0, late_diff = 0;
+	uint64_t k;
+
+	printf("six axis 10 point average (MPU6050_newValues)\n");
+	for(i = 0; i < 4096; i++)
+		for(a = 0; a < AXES; a++) input[i][a] = Noise();
+	for(a = 0; a < AXES; a++) Filter_MA_Init(&ma[a], window[a], WINDOW);
+
+	//Sample by sample comparison //逐样本比较
+	for(i = 0; i < 4096; i++)
+	{
+		Old_New_Values(input[i]);
+		for(a = 0; a < AXES; a++)
+		{
+			if((int16_t)Filter_MA_Update(&ma[a], input[i][a]) == Old_Fifo[a][WINDOW]) continue;
+			if(i < WINDOW - 1) warmup_diff++;
+			else late_diff++;
+		}
+	}
+	printf("  %lu outputs differ in the first %d samples, %lu after\n",
+	       (unsigned long)warmup_diff, WINDOW - 1, (unsigned long)late_diff);
+	Check(late_diff == 0, "identical once the window is full");
+	Check(warmup_diff > 0, "warm up differs: mean of the samples so far, not /10");
+
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Old_New_Values(input[i & 4095]);
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Sink_i = Old_Fifo[0][WINDOW];
+	Report("shift and re-sum", t, k, BENCH_SAMPLES);
+
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++)
+		for(a = 0; a < AXES; a++) Sink_i = Filter_MA_Update(&ma[a], input[i & 4095][a]);
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("Filter_MA x6", t, k, BENCH_SAMPLES);
+}
+
+//Detect_Leader_Motion_State before the change: window primed with the first sample
+//修改前的Detect_Leader_Motion_State：窗口用第一个样本填充
+static float Old_History[WINDOW];
+static uint8_t Old_Index;
+
+static float Old_Leader_Average(float v, uint8_t first)
+{
+	float sum = 0;
+	uint8_t i;
+	if(first)
+		for(i = 0; i < WINDOW; i++) Old_History[i] = v;
+	Old_History[Old_Index] = v;
+	Old_Index = (uint8_t)((Old_Index + 1) % WINDOW);
+	for(i = 0; i < WINDOW; i++) sum += Old_History[i];
+	return sum / WINDOW;
+}
+
+static void Bench_Leader_Average(void)
+{
+	float window[WINDOW], err, max_err = 0, v;
+	Filter_MAf_t ma;
+	uint32_t i, t;
+	uint64_t k;
+
+	printf("leader speed average (Detect_Leader_Motion_State)\n");
+	Filter_MAf_Init(&ma, window, WINDOW);
+	for(i = 0; i < 100000; i++)
+	{
+		v = 0.3f + 0.05f * (float)Noise() / 32768.0f;
+		if(i == 0) Filter_MAf_Reset(&ma, v);
+		err = fabsf(Filter_MAf_Update(&ma, v) - Old_Leader_Average(v, i == 0));
+		if(err > max_err) max_err = err;
+	}
+	printf("  max difference %.3g m/s\n", (double)max_err);
+	Check(max_err < 1e-6f, "matches from the first sample (float rounding only)");
+
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Sink_f = Old_Leader_Average((float)(i & 255), 0);
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("loop average", t, k, BENCH_SAMPLES);
+
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Sink_f = Filter_MAf_Update(&ma, (float)(i & 255));
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("Filter_MAf", t, k, BENCH_SAMPLES);
+}
+
+static void Bench_Other(void)
+{
+	Filter_EMA_t ema = { 0.3f, 0.0f, 1 };
+	Filter_Biquad_t bq;
+	Filter_Median_t med;
+	float old = 0, err, max_err = 0, x;
+	uint32_t i, t;
+	uint64_t k;
+
+	printf("velocity low pass (Calculate_Car_Velocity) and other filters\n");
+	for(i = 0; i < 100000; i++)
+	{
+		x = (float)Noise() / 32768.0f;
+		old = old * 0.7f + x * (1.0f - 0.7f);
+		err = fabsf(Filter_EMA_Update(&ema, x) - old);
+		if(err > max_err) max_err = err;
+	}
+	printf("  max difference %.3g\n", (double)max_err);
+	Check(max_err < 1e-5f, "EMA matches the old 0.7/0.3 low pass from zero");
+
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Sink_f = Filter_EMA_Update(&ema, (float)(i & 255));
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("Filter_EMA", t, k, BENCH_SAMPLES);
+
+	Filter_Biquad_Lowpass(&bq, 100.0f, 10.0f, 0.7071f);
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Sink_f = Filter_Biquad_Update(&bq, (float)(i & 255));
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("Filter_Biquad", t, k, BENCH_SAMPLES);
+
+	Filter_Median_Init(&med, 5);
+	t = Host_Ns(); k = BENCH_TICKS();
+	for(i = 0; i < BENCH_SAMPLES; i++) Sink_f = Filter_Median_Update(&med, (float)(i & 255));
+	k = BENCH_TICKS() - k; t = Host_Ns() - t;
+	Report("Filter_Median 5", t, k, BENCH_SAMPLES);
+}
+
+int main(void)
+{
+	Bench_Six_Axis();
+	Bench_Leader_Average();
+	Bench_Other();
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
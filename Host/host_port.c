@@ -0,0 +1,295 @@
+#define _DEFAULT_SOURCE
+#include "host_port.h"
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+
+//"CPU cycles" are nanoseconds on the host, CYCLES_TO_US stays correct
+//PC上"CPU周期"为纳秒，CYCLES_TO_US仍然正确
+uint32_t SystemCoreClock = 1000000000UL;
+
+DMA_Stream_TypeDef Host_DMA1_Stream[8];
+
+static uint64_t Boot_ns;            //Monotonic time of the last Host_Clock_Reset //最近一次Host_Clock_Reset时的单调时间
+static uint64_t Clock_Offset_us;    //Virtual time added by Host_Clock_Skip_us //Host_Clock_Skip_us累加的虚拟时间
+static uint8_t Clock_Frozen;        //1: only Host_Clock_Skip_us moves the clocks //1：时钟只由Host_Clock_Skip_us推进
+static uint8_t *Flash;
+
+static uint64_t Host_Monotonic_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec - Boot_ns;
+}
+
+/**************************************************************************
+Function: Restart the firmware clocks from 0, as after an MCU reset
+Input   : none
+Output  : none
+函数功能：固件时钟从0重新开始计时，相当于MCU复位
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Clock_Reset(void)
+{
+	Boot_ns = 0;
+	Boot_ns = Host_Monotonic_ns();
+	Clock_Offset_us = 0;
+	Clock_Frozen = 0;
+}
+
+/**************************************************************************
+Function: Stop the firmware clocks, from now on they only move with Host_Clock_Skip_us
+Input   : none
+Output  : none
+函数功能：停止固件时钟，此后只由Host_Clock_Skip_us推进，用于按虚拟时间回放数据
+入口参数：无
+返回  值：无
+**************************************************************************/
+void Host_Clock_Freeze(void)
+{
+	Clock_Offset_us += Host_Monotonic_ns() / 1000ULL;
+	Clock_Frozen = 1;
+}
+
+/**************************************************************************
+Function: Move the firmware clocks forward without waiting, for long calibration windows
+Input   : us: microseconds to add
+Output  : none
+函数功能：不等待而直接推进固件时钟，用于较长的校准窗口
+入口参数：us：增加的微秒数
+返回  值：无
+**************************************************************************/
+void Host_Clock_Skip_us(uint32_t us)
+{
+	Clock_Offset_us += us;
+}
+
+uint32_t Host_Ns(void)
+{
+	return (uint32_t)Host_Monotonic_ns();
+}
+
+uint32_t getMicros(void)
+{
+	return (uint32_t)((Clock_Frozen ? 0 : Host_Monotonic_ns() / 1000ULL) + Clock_Offset_us);
+}
+
+uint32_t getCycleCnt(void)
+{
+	return (uint32_t)(Host_Monotonic_ns() + Clock_Offset_us * 1000ULL);
+}
+
+uint32_t getSysTickCnt(void)
+{
+	return getMicros() / 1000U;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return getSysTickCnt();
+}
+
+void Host_Sleep_Until_us(uint32_t t_us)
+{
+	int32_t left = (int32_t)(t_us - getMicros());
+	struct timespec ts;
+
+	if(left <= 0) return;
+	ts.tv_sec = left / 1000000;
+	ts.tv_nsec = (long)(left % 1000000) * 1000L;
+	nanosleep(&ts, NULL);
+}
+
+void delay_us(uint32_t nus)
+{
+	Host_Sleep_Until_us(getMicros() + nus);
+}
+
+void delay_ms(uint32_t nms)
+{
+	delay_us(nms * 1000U);
+}
+
+void usart1_send_cstring(const char *s)
+{
+	fputs(s, stdout);
+}
+
+void NVIC_SystemReset(void)
+{
+	fputs("[HOST] NVIC_SystemReset\n", stdout);
+	exit(3);
+}
+
+/**************************************************************************
+Function: Map the internal flash at its address, erased
+Input   : none
+Output  : 0: success; -1: the address range is taken
+函数功能：在片内Flash的地址上建立映射，内容为已擦除
+入口参数：无
+返回  值：0：成功；-1：地址范围已被占用
+**************************************************************************/
+int Host_Flash_Init(void)
+{
+	void *p = mmap((void *)HOST_FLASH_BASE, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE,
+	               MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+	if(p != (void *)HOST_FLASH_BASE) return -1;
+	Flash = p;
+	Host_Flash_Erase_All();
+	return 0;
+}
+
+/**************************************************************************
+Function: Memory that forked children share with the parent, zeroed
+Input   : size: bytes
+Output  : the memory, NULL on failure
+函数功能：分配fork出的子进程与父进程共享的内存，内容为0
+入口参数：size：字节数
+返回  值：分配的内存，失败时为NULL
+**************************************************************************/
+void *Host_Shared_Alloc(uint32_t size)
+{
+	void *p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	return p == MAP_FAILED ? NULL : p;
+}
+
+void Host_Flash_Erase_All(void)
+{
+	memset(Flash, 0xFF, HOST_FLASH_SIZE);
+}
+
+//Sector layout of the 1 MB F407: 4 x 16 KB, 64 KB, 7 x 128 KB //1MB F407的扇区布局
+static uint32_t Host_Sector_Start(uint32_t sector)
+{
+	if(sector < 4) return sector * 0x4000UL;
+	if(sector == 4) return 0x10000UL;
+	return (sector - 4) * 0x20000UL;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) { return HAL_OK; }
+HAL_StatusTypeDef HAL_FLASH_Lock(void) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *erase, uint32_t *sector_error)
+{
+	uint32_t s, start, end;
+
+	*sector_error = 0xFFFFFFFFUL;
+	for(s = erase->Sector; s < erase->Sector + erase->NbSectors; s++)
+	{
+		if(s > 11) { *sector_error = s; return HAL_ERROR; }
+		start = Host_Sector_Start(s);
+		end = s < 11 ? Host_Sector_Start(s + 1) : HOST_FLASH_SIZE;
+		memset(Flash + start, 0xFF, end - start);
+	}
+	return HAL_OK;
+}
+
+//Programming can only clear bits, like the real array //与真实Flash相同，编程只能把位清零
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uint32_t address, uint64_t data)
+{
+	uint32_t i, len = type == FLASH_TYPEPROGRAM_WORD ? 4 : 1;
+
+	if(address < HOST_FLASH_BASE || address + len > HOST_FLASH_BASE + HOST_FLASH_SIZE) return HAL_ERROR;
+	for(i = 0; i < len; i++) Flash[address - HOST_FLASH_BASE + i] &= (uint8_t)(data >> (8 * i));
+	return HAL_OK;
+}
+
+//UART reception into a buffer the harness fills, as the DMA would
+//UART接收到缓冲区，由测试程序像DMA一样写入
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma) { hdma->State = HAL_DMA_STATE_READY; return HAL_OK; }
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma) { hdma->Instance->CR &= ~DMA_SxCR_EN; return HAL_OK; }
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) { huart->RxState = HAL_UART_STATE_READY; return HAL_OK; }
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+	huart->pRxBuffPtr = data;
+	huart->RxXferSize = size;
+	huart->RxState = HAL_UART_STATE_BUSY_RX;
+	return HAL_OK;
+}
+
+//FreeRTOS without the scheduler: a task is created but never runs, the
+//harness calls its body. Queues never block, one thread uses them
+//不启动调度器的FreeRTOS：任务创建后不运行，由测试程序调用其处理函数。队列不阻塞，只在一个线程中使用
+typedef struct
+{
+	UBaseType_t Length, Size, Count, Head;
+	uint8_t Items[];
+}Host_Queue_t;
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char * const name, const uint16_t stack, void * const arg,
+                       UBaseType_t prio, TaskHandle_t * const handle)
+{
+	(void)code; (void)name; (void)stack; (void)arg; (void)prio;
+	if(handle) *handle = NULL;
+	return pdPASS;
+}
+
+//1 ms ticks, configTICK_RATE_HZ //1ms节拍，与configTICK_RATE_HZ一致
+TickType_t xTaskGetTickCount(void)
+{
+	return HAL_GetTick();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait)
+{
+	(void)clear; (void)wait;
+	return 0;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken)
+{
+	(void)task;
+	if(woken) *woken = pdFALSE;
+}
+
+QueueHandle_t xQueueGenericCreate(const UBaseType_t length, const UBaseType_t size, const uint8_t type)
+{
+	Host_Queue_t *q = calloc(1, sizeof(Host_Queue_t) + length * size);
+
+	(void)type;
+	if(q == NULL) return NULL;
+	q->Length = length;
+	q->Size = size;
+	return q;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t queue, const void * const item, TickType_t wait, const BaseType_t position)
+{
+	Host_Queue_t *q = queue;
+
+	(void)wait;
+	if(position == queueOVERWRITE) q->Count = 0;
+	if(q->Count == q->Length) return errQUEUE_FULL;
+	memcpy(q->Items + (q->Head + q->Count) % q->Length * q->Size, item, q->Size);
+	q->Count++;
+	return pdPASS;
+}
+
+BaseType_t xQueueGenericReceive(QueueHandle_t queue, void * const buffer, TickType_t wait, const BaseType_t peek)
+{
+	Host_Queue_t *q = queue;
+
+	(void)wait;
+	if(q->Count == 0) return errQUEUE_EMPTY;
+	memcpy(buffer, q->Items + q->Head * q->Size, q->Size);
+	if(!peek)
+	{
+		q->Head = (q->Head + 1) % q->Length;
+		q->Count--;
+	}
+	return pdPASS;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+	free(queue);
+}
@@ -0,0 +1,22 @@
+#ifndef __HOST_PORT_H
+#define __HOST_PORT_H
+#include <stdint.h>
+
+//Board services for the host builds: clocks, delays, the debug serial port
+//and the internal flash. The flash is a shared mapping at its real address,
+//so a forked child (a "reboot") sees what its parent programmed.
+//PC编译用的板级服务：时钟、延时、调试串口和片内Flash。Flash映射在真实地址上且为共享映射，
+//fork出的子进程(相当于重启)可以看到父进程写入的内容
+#define HOST_FLASH_BASE     0x08000000UL
+#define HOST_FLASH_SIZE     0x100000UL     //1 MB, STM32F407VE/VG sectors 0..11 //1MB，扇区0..11
+
+int Host_Flash_Init(void);
+void *Host_Shared_Alloc(uint32_t size);
+void Host_Flash_Erase_All(void);
+void Host_Clock_Reset(void);
+void Host_Clock_Skip_us(uint32_t us);
+void Host_Clock_Freeze(void);
+uint32_t Host_Ns(void);
+void Host_Sleep_Until_us(uint32_t t_us);
+
+#endif
@@ -0,0 +1,211 @@
+#include "system.h"
+#include "i2c_bus.h"
+#include "mpu6050_sim.h"
+#include "imu_calib.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//Runs the IMU stack of MPU6050.c against the simulated MPU6050 and times it:
+//DMP_Init, Read_DMP at the task rate and the boot calibration. Every scenario
+//runs in a forked child, which is a fresh MCU reset, the flash stays shared.
+//The exit status is 0 when all checks pass.
+//让MPU6050.c的IMU驱动在模拟MPU6050上运行并计时：DMP_Init、按任务频率调用Read_DMP和开机校准。
+//每个场景在fork出的子进程中运行，相当于MCU复位，Flash内容保持共享。全部检查通过时返回0
+
+//Globals of balance.c the IMU code reads //IMU代码读取的balance.c中的全局变量
+u8 Flag_Stop = 1;
+Motor_parameter MOTOR_A, MOTOR_B, MOTOR_C, MOTOR_D;
+
+#define HOST_STREAM_MS      1000     //Read_DMP run length //Read_DMP运行时长
+#define HOST_CALIB_LIMIT_MS 30000    //Give up on the calibration after this //校准超时
+
+static int Failures;
+
+//Chip state handed from the first boot to the warm restart, shared across fork
+//从第一次启动传给热启动场景的芯片状态，fork后共享
+static struct
+{
+	uint32_t Size;
+	uint8_t  Data[8192];
+}*Chip;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-44s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static void Report_Bus(const char *step, const I2C_Bus_Stats_t *before)
+{
+	printf("  %-10s i2c %5lu reads %5lu writes %6lu bytes %6lu us\n", step,
+	       (unsigned long)(I2C_Bus_Stats.Reads - before->Reads), (unsigned long)(I2C_Bus_Stats.Writes - before->Writes),
+	       (unsigned long)(I2C_Bus_Stats.Bytes - before->Bytes),
+	       (unsigned long)I2C_Bus_Ticks_To_us(I2C_Bus_Stats.Busy_Ticks - before->Busy_Ticks));
+}
+
+//DMP_Init from a powered up chip //芯片上电后执行DMP_Init
+static void Boot(void)
+{
+	I2C_Bus_Stats_t before = I2C_Bus_Stats;
+	uint32_t t = getMicros();
+
+	//Same order as the firmware start up //与固件启动顺序相同
+	MPU6050_initialize();
+	DMP_Init();
+	t = getMicros() - t;
+	printf("  DMP_Init   %lu us (%s: init %lu, firmware %lu, config %lu, self test %lu)\n",
+	       (unsigned long)t, IMU_Boot_Timing.Warm ? "warm" : "cold",
+	       (unsigned long)IMU_Boot_Timing.Init_us, (unsigned long)IMU_Boot_Timing.Firmware_us,
+	       (unsigned long)IMU_Boot_Timing.Config_us, (unsigned long)IMU_Boot_Timing.Self_Test_us);
+	Report_Bus("DMP_Init", &before);
+	printf("  simulator  %lu DMP memory bytes written, %lu resets\n",
+	       (unsigned long)MPU6050_Sim_Stats.Mem_Writes, (unsigned long)MPU6050_Sim_Stats.Resets);
+}
+
+//Read_DMP at the MPU6050_task rate in real time //按MPU6050_task的频率实时调用Read_DMP
+static void Stream(void)
+{
+	I2C_Bus_Stats_t before = I2C_Bus_Stats;
+	IMU_Sample s[IMU_RING_SIZE];
+	uint32_t period = 1000000U / MPU6050_TASK_RATE, next = getMicros(), cursor = 0, samples = 0;
+	uint32_t calls = HOST_STREAM_MS * 1000U / period, i, t, total = 0, worst = 0;
+
+	for(i = 0; i < calls; i++)
+	{
+		next += period;
+		Host_Sleep_Until_us(next);
+		t = Host_Ns();
+		Read_DMP();
+		t = Host_Ns() - t;
+		total += t;
+		if(t > worst) worst = t;
+		samples += IMU_Read_Samples(&cursor, s, IMU_RING_SIZE);
+	}
+	printf("  Read_DMP   %lu calls, %lu ns mean, %lu ns max, %lu samples, %lu overflows\n",
+	       (unsigned long)calls, (unsigned long)(total / calls), (unsigned long)worst,
+	       (unsigned long)samples, (unsigned long)IMU_Benchmark.DMP_Overflows);
+	Report_Bus("Read_DMP", &before);
+	//The DMP runs at 200 Hz, allow for the start of the stream //DMP输出200Hz，允许起始时的偏差
+	Check(samples + 10 >= calls && samples <= calls + 10, "one DMP sample per task cycle");
+	Check(IMU_Benchmark.DMP_Overflows == 0, "no FIFO overflow");
+}
+
+//Boot calibration, the firmware clock is moved in task periods without waiting
+//开机校准，固件时钟按任务周期推进而不实际等待
+static void Calibrate(int moving)
+{
+	static const int16_t accel[3] = { 0, 0, 16384 };
+	int16_t gyro[3] = { 3, -2, 5 };
+	uint32_t period = 1000000U / MPU6050_TASK_RATE, start = getSysTickCnt(), n = 0, t, total = 0;
+
+	while(!gyro_bias_captured && getSysTickCnt() - start < HOST_CALIB_LIMIT_MS)
+	{
+		//Shaken for the first half second //前0.5秒晃动
+		gyro[2] = (moving && getSysTickCnt() - start < 500) ? (int16_t)((n & 1) ? 200 : -200) : 5;
+		MPU6050_Sim_Set_Motion(accel, gyro);
+		Host_Clock_Skip_us(period);
+		t = Host_Ns();
+		MPU_Get_Motion6();
+		total += Host_Ns() - t;
+		n++;
+	}
+	printf("  calibration %s in %lu ms, %lu samples, %lu ns per MPU_Get_Motion6, bias %d %d %d\n",
+	       IMU_Calib.From_Flash ? "fast" : "full", (unsigned long)(getSysTickCnt() - start), (unsigned long)n,
+	       (unsigned long)(n ? total / n : 0), IMU_Calib.Gyro_Bias[0], IMU_Calib.Gyro_Bias[1], IMU_Calib.Gyro_Bias[2]);
+	Check(gyro_bias_captured, "calibration finished");
+	Check(IMU_Calib.Gyro_Bias[0] == 3 && IMU_Calib.Gyro_Bias[1] == -2 && IMU_Calib.Gyro_Bias[2] == 5, "bias equals the simulated bias");
+}
+
+static int Scenario_Cold(void)
+{
+	Boot();
+	Stream();
+	Calibrate(0);
+	Check(!IMU_Calib.From_Flash && IMU_Calib.Reject_Reason == IMU_CALIB_REJECT_NO_RECORD, "full calibration without a record");
+	//The record waits for the car to stop //记录等到小车停止后再写入
+	MOTOR_A.Target = 10;
+	IMU_Calib_Save_Idle();
+	Check(*(const volatile uint32_t *)IMU_CALIB_FLASH_ADDR == 0xFFFFFFFFUL, "no flash write while a wheel has a target");
+	MOTOR_A.Target = 0;
+	IMU_Calib_Save_Idle();
+	IMU_Calib_Load();
+	Check(IMU_Calib_Stored_Valid, "record saved to flash");
+	Chip->Size = MPU6050_Sim_Save(Chip->Data, sizeof(Chip->Data));
+	return Failures;
+}
+
+static int Scenario_Stored(void)
+{
+	Boot();
+	Calibrate(0);
+	Check(IMU_Calib.From_Flash, "stored record accepted after the check");
+	return Failures;
+}
+
+static int Scenario_Moved(void)
+{
+	Boot();
+	Calibrate(1);
+	Check(!IMU_Calib.From_Flash && IMU_Calib.Reject_Reason == IMU_CALIB_REJECT_MOVING, "stored record rejected while moving");
+	return Failures;
+}
+
+//MCU reset with the sensor powered: the DMP must be taken over without a
+//reset or a firmware upload and keep streaming
+//MCU复位而传感器保持上电：DMP应被直接接管，不复位、不重新下载固件，并持续输出数据
+static int Scenario_Warm(void)
+{
+	Check(Chip->Size && !MPU6050_Sim_Restore(Chip->Data, Chip->Size), "chip state of the first boot restored");
+	Boot();
+	Check(IMU_Boot_Timing.Warm, "running DMP taken over");
+	Check(MPU6050_Sim_Stats.Resets == 0, "chip not reset");
+	Check(MPU6050_Sim_Stats.Mem_Writes < 256, "firmware not uploaded again");
+	Stream();
+	Calibrate(0);
+	Check(IMU_Calib.From_Flash, "stored record accepted after the check");
+	return Failures;
+}
+
+//Run a scenario in a child process, which starts from a reset MCU and chip
+//在子进程中运行一个场景，MCU和芯片都从复位状态开始
+static void Run(const char *name, int (*scenario)(void))
+{
+	pid_t pid;
+	int status = 0;
+
+	printf("%s\n", name);
+	fflush(stdout);
+	pid = fork();
+	if(pid == 0)
+	{
+		Host_Clock_Reset();
+		I2C_Bus_Select(&I2C_Sim_Ops);
+		exit(scenario() ? 1 : 0);
+	}
+	waitpid(pid, &status, 0);
+	if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	{
+		printf("  scenario FAILED (status %d)\n", status);
+		Failures++;
+	}
+}
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	Chip = Host_Shared_Alloc(sizeof(*Chip));
+	if(!Chip || Host_Flash_Init())
+	{
+		printf("cannot map the shared memory or the flash at 0x%08lX\n", (unsigned long)HOST_FLASH_BASE);
+		return 2;
+	}
+	Run("cold boot, erased flash", Scenario_Cold);
+	Run("reboot with the stored calibration", Scenario_Stored);
+	Run("reboot, car moved during the check", Scenario_Moved);
+	Run("MCU reset with the sensor powered", Scenario_Warm);
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
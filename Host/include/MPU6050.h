@@ -0,0 +1,3 @@
+//The sources include MPU6050.h, the file is mpu6050.h on a case sensitive file system
+//源文件包含MPU6050.h，在区分大小写的文件系统上文件名为mpu6050.h
+#include "../../HARDWARE/MPU6050/mpu6050.h"
@@ -0,0 +1,3 @@
+//The sources include led.h, the file is LED.H on a case sensitive file system
+//源文件包含led.h，在区分大小写的文件系统上文件名为LED.H
+#include "../../HARDWARE/LED.H"
@@ -0,0 +1,15 @@
+#ifndef __HOST_MAIN_H
+#define __HOST_MAIN_H
+#include "stm32f4xx_hal.h"
+
+//Host stand-in of the CubeMX main.h: the handles and globals it exports
+//CubeMX生成的main.h的PC替身：只包含其导出的句柄和全局变量
+extern UART_HandleTypeDef huart1, huart2, huart3, huart5, huart6;
+extern float position[3];
+extern float Target_position[3];
+extern float Target_Yaw;
+extern float Voltage, Voltage_All;
+extern int Voltage_Show;
+extern int Time_count;
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+#include <stdint.h>
+
+//FreeRTOS port for the host builds: types only, the harnesses run in one
+//thread without the scheduler, so critical sections and yields are empty
+//PC编译用的FreeRTOS移植层：只有类型定义。测试程序单线程运行，不启动调度器，
+//因此临界区和任务切换为空操作
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uint32_t
+#define portBASE_TYPE   long
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+#define portMAX_DELAY                       ((TickType_t)0xffffffffUL)
+#define portTICK_TYPE_IS_ATOMIC             1
+#define portSTACK_GROWTH                    (-1)
+#define portTICK_PERIOD_MS                  ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portBYTE_ALIGNMENT                  8
+#define portYIELD()
+#define portEND_SWITCHING_ISR(x)            (void)(x)
+#define portYIELD_FROM_ISR(x)               (void)(x)
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portSET_INTERRUPT_MASK_FROM_ISR()   0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) (void)(x)
+#define portTASK_FUNCTION_PROTO(f, p)       void f(void *p)
+#define portTASK_FUNCTION(f, p)             void f(void *p)
+#define portNOP()
+#define portINLINE                          inline
+#define portFORCE_INLINE                    inline
+
+#endif
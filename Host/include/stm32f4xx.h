@@ -0,0 +1,57 @@
+#ifndef __HOST_STM32F4XX_H
+#define __HOST_STM32F4XX_H
+#include <stdint.h>
+#include <stddef.h>
+
+//Host stand-in of the CMSIS device header: the register types and core
+//intrinsics the firmware headers mention, no peripheral behind them
+//CMSIS器件头文件的PC替身：只提供固件头文件用到的寄存器类型和内核函数，没有外设实现
+
+#define __IO volatile
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+typedef volatile uint32_t vu32;
+typedef volatile uint16_t vu16;
+typedef volatile uint8_t  vu8;
+typedef int IRQn_Type;
+
+typedef struct { __IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2]; } GPIO_TypeDef;
+typedef struct { __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR; } TIM_TypeDef;
+typedef struct { __IO uint32_t SR, DR, BRR, CR1, CR2, CR3, GTPR; } USART_TypeDef;
+typedef struct { __IO uint32_t CR, NDTR, PAR, M0AR, M1AR, FCR; } DMA_Stream_TypeDef;
+typedef struct { __IO uint32_t SR, CR1, CR2, SMPR1, SMPR2, JOFR1, JOFR2, JOFR3, JOFR4, HTR, LTR, SQR1, SQR2, SQR3, JSQR, JDR1, JDR2, JDR3, JDR4, DR; } ADC_TypeDef;
+
+extern GPIO_TypeDef *GPIOA, *GPIOB, *GPIOC, *GPIOD, *GPIOE;
+extern USART_TypeDef *USART1, *USART2, *USART3, *UART4, *UART5, *USART6;
+extern uint32_t SystemCoreClock;
+
+#define GPIOA_BASE 0x40020000UL
+#define GPIOB_BASE 0x40020400UL
+#define GPIOC_BASE 0x40020800UL
+#define GPIOD_BASE 0x40020C00UL
+#define GPIOE_BASE 0x40021000UL
+#define GPIOF_BASE 0x40021400UL
+#define GPIOG_BASE 0x40021800UL
+#define GPIOH_BASE 0x40021C00UL
+#define GPIOI_BASE 0x40022000UL
+
+#define DMA_SxCR_EN      (1UL << 0)
+#define USART_CR3_DMAR   (1UL << 6)
+#define USART_CR3_DMAT   (1UL << 7)
+#define SET_BIT(r, b)    ((r) |= (b))
+#define CLEAR_BIT(r, b)  ((r) &= ~(b))
+
+//One process, no interrupts: barriers only stop the compiler from reordering
+//单进程且无中断：屏障只需阻止编译器重排
+static inline void __DMB(void) { __asm__ volatile("" ::: "memory"); }
+static inline void __DSB(void) { __asm__ volatile("" ::: "memory"); }
+static inline void __NOP(void) {}
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t x) { (void)x; }
+void NVIC_SystemReset(void);
+
+#include "stm32f4xx_hal.h"
+#endif
@@ -0,0 +1,103 @@
+#ifndef __HOST_STM32F4XX_HAL_H
+#define __HOST_STM32F4XX_HAL_H
+#include "stm32f4xx.h"
+
+//Host stand-in of the HAL: types, constants and prototypes the firmware
+//headers and the host built modules use. Only the functions in host_port.c
+//have a body, the rest are referenced from code the harnesses never run.
+//HAL的PC替身：提供固件头文件和PC编译模块用到的类型、常量和函数声明。
+//只有host_port.c中的函数有实现，其余函数只在测试程序不会运行的代码中被引用
+
+typedef enum { HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+typedef enum { HAL_DMA_STATE_RESET = 0, HAL_DMA_STATE_READY, HAL_DMA_STATE_BUSY, HAL_DMA_STATE_ABORT } HAL_DMA_StateTypeDef;
+
+typedef struct { uint32_t Pin, Mode, Pull, Speed, Alternate; } GPIO_InitTypeDef;
+typedef struct { uint32_t Channel, Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority, FIFOMode; } DMA_InitTypeDef;
+typedef struct { DMA_Stream_TypeDef *Instance; DMA_InitTypeDef Init; void *Parent; HAL_DMA_StateTypeDef State; } DMA_HandleTypeDef;
+typedef struct { uint32_t BaudRate, WordLength, StopBits, Parity, Mode, HwFlowCtl, OverSampling; } UART_InitTypeDef;
+typedef struct { USART_TypeDef *Instance; UART_InitTypeDef Init; DMA_HandleTypeDef *hdmarx, *hdmatx; uint8_t *pRxBuffPtr; uint32_t RxXferSize, RxState; } UART_HandleTypeDef;
+typedef struct { uint32_t ScanConvMode, ContinuousConvMode, DiscontinuousConvMode, ExternalTrigConvEdge, ExternalTrigConv, NbrOfConversion, DMAContinuousRequests, EOCSelection; } ADC_InitTypeDef;
+typedef struct { ADC_TypeDef *Instance; ADC_InitTypeDef Init; DMA_HandleTypeDef *DMA_Handle; } ADC_HandleTypeDef;
+typedef struct { TIM_TypeDef *Instance; } TIM_HandleTypeDef;
+typedef struct { uint32_t TypeErase, Banks, Sector, NbSectors, VoltageRange; } FLASH_EraseInitTypeDef;
+
+#define GPIO_PIN_0                  0x0001U
+#define GPIO_PIN_1                  0x0002U
+#define GPIO_PIN_8                  0x0100U
+#define GPIO_PIN_9                  0x0200U
+#define GPIO_PIN_10                 0x0400U
+#define GPIO_PIN_11                 0x0800U
+#define GPIO_PIN_12                 0x1000U
+#define GPIO_PIN_13                 0x2000U
+#define GPIO_PIN_14                 0x4000U
+#define GPIO_PIN_15                 0x8000U
+#define GPIO_MODE_INPUT             0x0U
+#define GPIO_MODE_OUTPUT_PP         0x1U
+#define GPIO_MODE_AF_PP             0x2U
+#define GPIO_MODE_OUTPUT_OD         0x11U
+#define GPIO_NOPULL                 0x0U
+#define GPIO_PULLUP                 0x1U
+#define GPIO_SPEED_FREQ_HIGH        0x2U
+#define GPIO_SPEED_FREQ_VERY_HIGH   0x3U
+#define GPIO_AF8_UART4              0x8U
+
+#define DMA_CHANNEL_4               0x08000000U
+#define DMA_PERIPH_TO_MEMORY        0x0U
+#define DMA_PINC_DISABLE            0x0U
+#define DMA_MINC_ENABLE             0x400U
+#define DMA_PDATAALIGN_BYTE         0x0U
+#define DMA_MDATAALIGN_BYTE         0x0U
+#define DMA_CIRCULAR                0x100U
+#define DMA_PRIORITY_LOW            0x0U
+#define DMA_FIFOMODE_DISABLE        0x0U
+#define DMA_IT_TC                   0x10U
+#define DMA_IT_HT                   0x08U
+
+#define UART_WORDLENGTH_8B          0x0U
+#define UART_STOPBITS_1             0x0U
+#define UART_PARITY_NONE            0x0U
+#define UART_MODE_TX_RX             0xCU
+#define UART_HWCONTROL_NONE         0x0U
+#define UART_OVERSAMPLING_16        0x0U
+#define HAL_UART_STATE_READY        0x20U
+#define HAL_UART_STATE_BUSY_RX      0x22U
+
+#define FLASH_TYPEERASE_SECTORS     0x0U
+#define FLASH_TYPEPROGRAM_BYTE      0x0U
+#define FLASH_TYPEPROGRAM_WORD      0x2U
+#define FLASH_VOLTAGE_RANGE_3       0x2U
+#define FLASH_SECTOR_7              7U
+
+#define HAL_MAX_DELAY               0xFFFFFFFFU
+#define UNUSED(x)                   ((void)(x))
+//Plain memory in host_port.c, the harness plays the DMA //host_port.c中的普通内存，由测试程序模拟DMA
+extern DMA_Stream_TypeDef Host_DMA1_Stream[8];
+#define DMA1_Stream0                (&Host_DMA1_Stream[0])
+#define DMA1_Stream2                (&Host_DMA1_Stream[2])
+
+#define __HAL_RCC_DMA1_CLK_ENABLE()    do{}while(0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()   do{}while(0)
+#define __HAL_RCC_UART4_CLK_ENABLE()   do{}while(0)
+#define __HAL_DMA_GET_COUNTER(h)       ((h)->Instance->NDTR)
+#define __HAL_DMA_DISABLE_IT(h, i)     ((h)->Instance->CR &= ~(i))
+#define __HAL_DMA_DISABLE(h)           ((h)->Instance->CR &= ~DMA_SxCR_EN)
+#define __HAL_LINKDMA(h, f, d)         do{ (h)->f = &(d); (d).Parent = (h); }while(0)
+
+uint32_t HAL_GetTick(void);
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t src, uint32_t dst, uint32_t len);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t type, uint32_t address, uint64_t data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *erase, uint32_t *sector_error);
+
+#endif
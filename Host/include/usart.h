@@ -0,0 +1,5 @@
+#ifndef __HOST_USART_H
+#define __HOST_USART_H
+//CubeMX peripheral header, nothing of it is used by the host builds
+//CubeMX外设头文件，PC编译不使用其中内容
+#endif
@@ -0,0 +1,57 @@
+# -*- coding: gbk -*-
+# Synthesized lidar capture for lidar_replay: four revolutions of 36 packets in
+# the N10 frame layout (LiDARFrameTypeDef in lidar.h), with the faults the
+# decoder must survive. It is not a recording of the UART4 lidar: it checks
+# Lidar_Decode against the protocol as lidar.h states it, not against the lidar.
+# ϳɵ״ݣlidar_replayʹã4ȦÿȦ36ݰ֡ʽΪN10Э(lidar.hеLiDARFrameTypeDef)
+# ܴĴⲻUART4״¼ݣֻlidar.hеЭLidar_Decodeǰ״ﱾ
+#   python3 lidar_capture.py > lidar_capture.bin
+#
+# Frame: A5 5A ver_len, speed(2), start angle(2), 32 x (distance(2), strength),
+# end angle(2), timestamp in ms(2), check byte = 8 bit sum of the rest.
+# ver_len is the whole frame, 0x6C = 108 (Length_ in lidar.h).
+# ֡A5 5A ver_lenת(2)ʼ(2)32 x ((2)ǿ)(2)
+# ʱms(2)Уֽ = ֽڵ8λۼӺ͡ver_lenΪ֡ȣ0x6C = 108
+
+import sys
+
+FRAME_LEN = 0x6C
+PACKS = 36
+REVOLUTIONS = 4
+FRAME_MS = FRAME_LEN * 10 * 1000 / 230400   # ms per frame on the line at LIDAR_BAUD
+
+
+def frame(start, end, base, stamp, length=FRAME_LEN):
+    f = bytearray([0xA5, 0x5A, length, 0x12, 0x34, start >> 8, start & 255])
+    for i in range(32):
+        d = base + i
+        f += bytes([d >> 8, d & 255, 100])
+    f += bytes([end >> 8, end & 255, stamp >> 8, stamp & 255])
+    f += bytes(length - 1 - len(f))
+    f.append(sum(f) & 255)
+    assert len(f) == length
+    return f
+
+
+out = bytearray()
+n = 0
+for rev in range(REVOLUTIONS):
+    for p in range(PACKS):
+        s = (p * 1000 + rev * 37) % 36000
+        e = (s + 969) % 36000
+        t = int(n * FRAME_MS) & 0xFFFF
+        f = frame(s, e, 1000 + p, t)
+        if n == 20:
+            f[50] ^= 0xFF                          # bad check byte, 1 Bad_Crc
+        if n == 41:
+            out += bytes([0x00, 0xA5, 0x13, 0xA5])  # noise with false headers
+        if n == 60:
+            out += f[:30]                          # truncated frame, 1 Bad_Crc
+        if n == 80:
+            out += bytes([0xA5, 0x5A, 0x20])       # header with a bad ver_len, 1 Bad_Length
+        if n == 100:
+            f = frame(s, e, 1000 + p, t, 110)       # longer frame, length from ver_len
+        out += f
+        n += 1
+
+sys.stdout.buffer.write(out)
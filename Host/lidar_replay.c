@@ -0,0 +1,170 @@
+#include "lidar.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <math.h>
+
+//Replay of a lidar capture through Lidar_Decode at the line rate, in virtual
+//time. The bytes go through a ring of LIDAR_RX_RING read every LIDAR_POLL_MS
+//as in Lidar_Task, the pose is pushed every control cycle while the car
+//drives at 0.5 m/s and turns at 400 degree/s. Checks the frame counters
+//against the faults lidar_capture.py put in the capture, the revolutions and
+//that every pose entry is the pose at the first byte of its packet.
+//lidar_capture.bin is synthesized from the N10 frame layout in lidar.h, a
+//recording of the UART4 lidar can be replayed by its path but has none of
+//those faults. The exit status is 0 when all checks pass.
+//按线路速率在虚拟时间中把雷达数据回放给Lidar_Decode。字节经过LIDAR_RX_RING大小的环形缓冲区，
+//与Lidar_Task相同每LIDAR_POLL_MS读取一次；小车以0.5m/s行驶并以400度/秒旋转，每个控制周期记录位姿。
+//检查帧计数与lidar_capture.py加入的错误一致、圈数正确，且每个位姿条目都是其数据包第一个字节时刻的位姿。
+//lidar_capture.bin按lidar.h中的N10帧格式合成，UART4雷达的录制数据可通过路径回放，但不含这些错误。
+//全部检查通过时返回0
+
+//Faults in lidar_capture.bin //lidar_capture.bin中的错误
+#define CAPTURE_FRAMES       143     //144 frames, one with a bad check byte //144帧，其中一帧校验错误
+#define CAPTURE_BAD_CRC      2       //That one and a truncated frame //该帧及一个截断帧
+#define CAPTURE_BAD_LENGTH   1
+#define CAPTURE_MAX          32768
+
+#define STEP_US              2500    //Virtual time step //虚拟时间步长
+#define POLL_STEPS           (LIDAR_POLL_MS * 1000 / STEP_US)
+#define CONTROL_STEPS        4       //Balance_task every 10 ms, half a poll away from the polls //Balance_task每10ms运行一次，与读取错开半个读取周期
+#define STAMP_TOLERANCE_US   (LIDAR_BYTE_US * 1.5f)
+
+//Firmware globals lidar.c uses //lidar.c用到的固件全局变量
+float position[3], Yaw, Voltage;
+u8 Car_Mode;
+u8 Turn_Off(int voltage) { (void)voltage; return 0; }
+
+static int Failures;
+static u8 Capture[CAPTURE_MAX];
+static u8 Ring[LIDAR_RX_RING];
+static u32 T0;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static float Wrap180(double d)
+{
+	d = fmod(d + 180.0, 360.0);
+	if(d < 0) d += 360.0;
+	return (float)(d - 180.0);
+}
+
+//Motion of the car against time //小车运动与时间的关系
+static float X_At(u32 us)   { return (float)((double)(us - T0) * 1e-6 * 0.5); }
+static float Yaw_At(u32 us) { return Wrap180((double)(us - T0) * 1e-6 * 400.0); }
+
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "lidar_capture.bin";
+	FILE *f = fopen(path, "rb");
+	u32 n, fed = 0, arrived, now, step, last_seq = 0, scans = 0, entries = 0, bad_first = 0, held = 0, j, start = 0;
+	u32 decoded, newest, expect;
+	u16 tail = 0, head, k;
+	double max_dt = 0, max_dx = 0, max_dyaw = 0, best, d;
+
+	if(f == NULL) { printf("cannot open %s\n", path); return 1; }
+	n = (u32)fread(Capture, 1, sizeof(Capture), f);
+	fclose(f);
+	printf("lidar replay of %s, %lu bytes\n", path, (unsigned long)n);
+
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	T0 = getMicros();
+	position[1] = 1.0f;
+
+	for(step = 0; fed < n; step++, Host_Clock_Skip_us(STEP_US))
+	{
+		now = getMicros();
+		//Balance_task records the pose at the end of its cycle //Balance_task在周期末尾记录位姿
+		if(step % CONTROL_STEPS == 1)
+		{
+			position[0] = X_At(now);
+			Yaw = Yaw_At(now);
+			Lidar_Pose_Push();
+		}
+		if(step % POLL_STEPS) continue;
+
+		//Bytes on the line since the last poll, as the DMA would store them
+		//上次读取以来线路上的字节，按DMA的方式存入
+		arrived = (u32)((float)(now - T0) / LIDAR_BYTE_US);
+		//The decoder takes the last byte as received at the poll, true while the
+		//lidar streams. After the end of the capture the line is idle
+		//解码器认为最后一个字节在读取时刻接收完成，雷达持续发送时成立。回放结束后线路空闲
+		if(arrived > n)
+		{
+			arrived = n;
+			now = T0 + (u32)((float)n * LIDAR_BYTE_US);
+		}
+		for(; fed < arrived; fed++) Ring[fed % LIDAR_RX_RING] = Capture[fed];
+
+		//Body of Lidar_Task //Lidar_Task的主体
+		head = (u16)(arrived % LIDAR_RX_RING);
+		if(head < tail)
+		{
+			Lidar_Decode(&Ring[tail], LIDAR_RX_RING - tail, now - (u32)((float)head * LIDAR_BYTE_US));
+			Lidar_Decode(Ring, head, now);
+		}
+		else Lidar_Decode(&Ring[tail], head - tail, now);
+		tail = head;
+
+		const Lidar_Scan_t *s = Lidar_Scan_Get();
+		if(s == 0 || s->Seq == last_seq) continue;
+		last_seq = s->Seq;
+		scans++;
+		printf("  scan %lu: %u points, %u dropped, %u poses\n", (unsigned long)s->Seq, s->Count, s->Dropped, s->Poses);
+		for(k = 0; k < s->Poses; k++)
+		{
+			const Lidar_Pose_t *p = &s->Pose[k];
+
+			entries++;
+			if(k && (p->First <= s->Pose[k - 1].First || p->First - s->Pose[k - 1].First > POINT_PER_PACK)) bad_first++;
+			//The stamp is the end of the first header byte of some frame
+			//时间戳为某一帧第一个帧头字节接收完成的时刻
+			best = 1e9;
+			for(j = 0; j + 2 < n; j++)
+			{
+				if(Capture[j] != HEADER_0 || Capture[j + 1] != HEADER_1) continue;
+				d = fabs(T0 + (j + 1) * (double)LIDAR_BYTE_US - (double)p->Stamp_Us);
+				if(d < best) { best = d; start = j; }
+			}
+			if(best > max_dt) max_dt = best;
+
+			//Lidar_Pose_At interpolates between the poses pushed before the packet was
+			//decoded and holds the newest one after them, it does not extrapolate
+			//Lidar_Pose_At在数据包解码前记录的位姿之间插值，晚于最新位姿时保持该位姿，不做外推
+			decoded = (u32)ceil((start + Capture[start + 2]) * (double)LIDAR_BYTE_US / (POLL_STEPS * STEP_US)) * POLL_STEPS * STEP_US;
+			newest = (decoded - STEP_US) / (CONTROL_STEPS * STEP_US) * (CONTROL_STEPS * STEP_US) + STEP_US;
+			expect = p->Stamp_Us - T0;
+			if(expect > newest)
+			{
+				expect = newest;
+				held++;
+			}
+			d = fabs(p->X - X_At(T0 + expect));
+			if(d > max_dx) max_dx = d;
+			d = fabs(Wrap180(p->Yaw - Yaw_At(T0 + expect)));
+			if(d > max_dyaw) max_dyaw = d;
+		}
+	}
+
+	printf("  frames %lu, bad check byte %lu, bad length %lu, skipped bytes %lu, revolutions %lu\n",
+	       (unsigned long)Lidar.Frames, (unsigned long)Lidar.Bad_Crc, (unsigned long)Lidar.Bad_Length,
+	       (unsigned long)Lidar.Skipped, (unsigned long)Lidar.Revolutions);
+	printf("  %lu pose entries, %lu after the newest pose: stamp within %.1f us of a frame start, x error %.2g m, yaw error %.2g degree\n",
+	       (unsigned long)entries, (unsigned long)held, max_dt, max_dx, max_dyaw);
+	Check(Lidar.Frames == CAPTURE_FRAMES, "every good frame decoded, 108 and 110 byte");
+	//The capture ends with a whole 108 byte frame //数据以一个完整的108字节帧结束
+	Check(n >= Length_ && Capture[n - Length_] == HEADER_0 &&
+	      Pack_Data.timestamp_h == Capture[n - 3] && Pack_Data.timestamp_l == Capture[n - 2], "timestamp taken from bytes 105 and 106");
+	Check(Lidar.Bad_Crc == CAPTURE_BAD_CRC, "bad check byte and truncated frame counted");
+	Check(Lidar.Bad_Length == CAPTURE_BAD_LENGTH, "bad ver_len counted apart from the check byte");
+	Check(scans == 3 && Lidar.Revolutions == 3, "3 revolutions published after the first wrap");
+	Check(bad_first == 0, "pose entries in point order, one per packet");
+	Check(max_dt <= STAMP_TOLERANCE_US, "pose stamped at the first byte of its packet");
+	Check(max_dx < 1e-4 && max_dyaw < 0.05, "pose interpolated, or the newest one held");
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,174 @@
+#include "formation_mpc.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//Closed loop check of formation_mpc.c on a follower model, in virtual time.
+//The follower drives the applied command of Drive_Motor: the MPC output,
+//optionally clipped by an ORCA stand-in, through the Smooth_control slew. Cases
+//are a leader driving straight, turning, and stopping. Checks the slot
+//tracking error, that every command keeps the speed limit and the move limit
+//from the command the car drove last tick, and that MPC_ITERATIONS warm
+//started iterations land the first command near the converged optimum.
+//The exit status is 0 when all checks pass.
+//在虚拟时间中对formation_mpc.c做跟随者闭环检查。跟随者按Drive_Motor实际执行的指令运动：MPC输出，
+//可选地经过模拟ORCA的限制，再经过Smooth_control的斜率限制。工况为领航者直行、转弯和停车。
+//检查编队位置跟踪误差、每条指令满足速度限制和相对上一周期实际执行指令的变化量限制，以及
+//MPC_ITERATIONS次热启动迭代后首个指令与收敛最优值的差距。全部检查通过时返回0
+
+#define CONTROL_DT        0.01f       //Balance_task period //Balance_task周期
+#define SMOOTH_STEP       0.01f       //Smooth_control slew per tick //Smooth_control每周期变化量
+#define V_MAX             0.3f        //Formation_max_speed
+#define CONVERGE_CALLS    400         //Further solves of a copy, each MPC_ITERATIONS long //对副本继续求解的次数
+#define OPTIMUM_TOL       0.001f      //First command within this of the converged one, m/s //首个指令与收敛值之差上限
+#define LIMIT_TOL         1e-4f
+#define ORCA_VX           0.06f       //ORCA stand-in: x speed allowed towards a peer ahead, m/s //模拟ORCA：朝前方邻车允许的x方向速度
+
+static int Failures;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-60s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static float Limit(float v, float limit)
+{
+	if(v > limit)  return limit;
+	if(v < -limit) return -limit;
+	return v;
+}
+
+//Smooth_control on one axis //单轴Smooth_control
+static float Smooth(float smooth, float v)
+{
+	if(v > 0)      smooth += SMOOTH_STEP;
+	else if(v < 0) smooth -= SMOOTH_STEP;
+	else           smooth *= 0.9f;
+	return Limit(smooth, fabsf(v));
+}
+
+typedef struct
+{
+	const char *Name;
+	float Leader_V, Leader_Wz;     //Leader body speed m/s and yaw rate rad/s //领航者车体速度和角速度
+	float Stop_S;                  //Leader stops here, 0 never //领航者在此时刻停车，0表示不停
+	float Orca_From, Orca_To;      //ORCA stand-in clips vx to ORCA_VX in this window //该时间段内模拟ORCA将vx限制为ORCA_VX
+	float Run_S;
+	float Settled_Error;           //Tracking error allowed over the last 2 s, m //最后2秒允许的跟踪误差
+	uint8_t Own_Output;            //1: feed back the MPC output instead of the applied command, as before //1：按修改前的方式反馈MPC输出
+}Mpc_Case_t;
+
+typedef struct
+{
+	float Settled_Error;
+	float Speed_Over, Move_Over;   //Largest excess over the limits, m/s //超出约束的最大量
+	float Optimum_Gap;             //Largest first command distance to the converged plan, m/s //首个指令与收敛结果的最大距离
+	float Mean_Gap;
+	float Mean_ns;                 //Host time per solve //每次求解的PC耗时
+}Mpc_Result_t;
+
+static Mpc_Result_t Mpc_Run(const Mpc_Case_t *k, int check_optimum)
+{
+	static Formation_MPC_t m, copy;
+	Mpc_Result_t r;
+	float lx = 0, ly = 0, lyaw = 0, lv, px = -1.0f, py = 0, ax = 0, ay = 0, vx, vy, cx, cy, gx, gy;
+	float err, t, move, gap_sum = 0, ns_sum = 0;
+	uint32_t n, steps = (uint32_t)(k->Run_S / CONTROL_DT + 0.5f), t0;
+	int i;
+
+	memset(&r, 0, sizeof(r));
+	Formation_MPC_Init(&m);
+	m.V_Max = V_MAX;
+	Host_Clock_Reset();
+	for(n = 0; n < steps; n++)
+	{
+		t = n * CONTROL_DT;
+		lv = (k->Stop_S > 0 && t >= k->Stop_S) ? 0.0f : k->Leader_V;
+
+		//Reports arrive fresh every tick, slot 0.5 m behind and 0.5 m to the left
+		//每周期收到最新数据，编队位置在领航者后方0.5m、左侧0.5m
+		if(!k->Own_Output) Formation_MPC_Applied(&m, ax, ay);
+		Formation_MPC_Reference(&m, lx, ly, lyaw * 57.2957795f, lv, 0, lv > 0 ? k->Leader_Wz : 0, -0.5f, 0.5f, 0);
+		t0 = Host_Ns();
+		Formation_MPC_Solve(&m, px, py, CONTROL_DT, &vx, &vy);
+		t0 = Host_Ns() - t0;
+		ns_sum += t0;
+		if(k->Own_Output) Formation_MPC_Applied(&m, vx, vy);
+
+		//Constraints against what the car drove last tick //相对上一周期实际执行指令检查约束
+		if(sqrtf(vx * vx + vy * vy) - V_MAX > r.Speed_Over) r.Speed_Over = sqrtf(vx * vx + vy * vy) - V_MAX;
+		move = sqrtf((vx - ax) * (vx - ax) + (vy - ay) * (vy - ay)) - m.A_Max * CONTROL_DT;
+		if(move > r.Move_Over) r.Move_Over = move;
+
+		//Converged plan of the same problem: keep solving a copy from this plan
+		//同一问题的收敛结果：从当前规划继续求解副本
+		if(check_optimum)
+		{
+			copy = m;
+			for(i = 0; i < CONVERGE_CALLS; i++) Formation_MPC_Solve(&copy, px, py, CONTROL_DT, &cx, &cy);
+			gx = vx - cx; gy = vy - cy;
+			if(sqrtf(gx * gx + gy * gy) > r.Optimum_Gap) r.Optimum_Gap = sqrtf(gx * gx + gy * gy);
+			gap_sum += sqrtf(gx * gx + gy * gy);
+		}
+
+		//ORCA stand-in, then Smooth_control //模拟ORCA，然后Smooth_control
+		if(t >= k->Orca_From && t < k->Orca_To && vx > ORCA_VX) ax = Smooth(ax, ORCA_VX);
+		else                                                    ax = Smooth(ax, vx);
+		ay = Smooth(ay, vy);
+		px += ax * CONTROL_DT;
+		py += ay * CONTROL_DT;
+
+		//Leader //领航者
+		lx += lv * cosf(lyaw) * CONTROL_DT;
+		ly += lv * sinf(lyaw) * CONTROL_DT;
+		if(lv > 0) lyaw += k->Leader_Wz * CONTROL_DT;
+
+		if(t >= k->Run_S - 2.0f)
+		{
+			err = m.Error;
+			if(err > r.Settled_Error) r.Settled_Error = err;
+		}
+	}
+	r.Mean_Gap = gap_sum / steps;
+	r.Mean_ns = ns_sum / steps;
+	return r;
+}
+
+static const Mpc_Case_t Cases[] =
+{
+	//Name                                    v     wz    stop  orca      run   error own
+	{ "leader straight at 0.2 m/s",           0.2f, 0,    0,    0, 0,     12.0f, 0.02f, 0 },
+	{ "leader turning, 0.2 m/s at 0.3 rad/s", 0.2f, 0.3f, 0,    0, 0,     12.0f, 0.05f, 0 },
+	{ "leader stops after 5 s",               0.2f, 0,    5.0f, 0, 0,     12.0f, 0.05f, 0 },
+	{ "straight, ORCA holds vx for 1 s",      0.2f, 0,    0,    4.0f, 5.0f, 16.0f, 0.02f, 0 },
+};
+static const Mpc_Case_t Orca_Own = { "same, MPC output fed back as before", 0.2f, 0, 0, 4.0f, 5.0f, 16.0f, 0.02f, 1 };
+
+int main(void)
+{
+	Mpc_Result_t r;
+	unsigned i;
+
+	printf("formation MPC, %d iterations per tick, horizon %d x %.1f s\n", MPC_ITERATIONS, MPC_HORIZON, (double)MPC_STEP_S);
+	for(i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+	{
+		r = Mpc_Run(&Cases[i], 1);
+		printf("%s\n", Cases[i].Name);
+		printf("  settled error %.4f m, over speed %.2g, over move %.2g m/s, first command %.2g m/s from the optimum (mean %.2g), %.0f ns per solve\n",
+		       (double)r.Settled_Error, (double)r.Speed_Over, (double)r.Move_Over, (double)r.Optimum_Gap, (double)r.Mean_Gap,
+		       (double)r.Mean_ns);
+		Check(r.Settled_Error <= Cases[i].Settled_Error, "slot tracked once settled");
+		Check(r.Speed_Over <= LIMIT_TOL, "every command within V_Max");
+		Check(r.Move_Over <= LIMIT_TOL, "every command within A_Max*dt of the applied one");
+		Check(r.Optimum_Gap <= OPTIMUM_TOL, "MPC_ITERATIONS land the first command near the optimum");
+	}
+
+	r = Mpc_Run(&Orca_Own, 0);
+	printf("%s\n", Orca_Own.Name);
+	printf("  first command up to %.4f m/s beyond A_Max*dt from what the car drove\n", (double)r.Move_Over);
+	Check(r.Move_Over > 0.01f, "the applied command feedback matters with ORCA");
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
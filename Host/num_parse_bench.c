@@ -0,0 +1,269 @@
+#include "num_parse.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//Accuracy and speed check of num_parse.c against the sscanf code it replaced.
+//Num_Float is compared with strtof on random decimal and exponent strings, the
+//ingest lines are parsed the old way (sscanf) and the new way (Num_*) with the
+//same field layout as Parse_UWB_Data, Process_Compact_Broadcast and
+//Process_Control_Command. The exit status is 0 when all checks pass.
+//num_parse.c与其替换的sscanf代码的精度和速度检查。Num_Float与strtof在随机十进制和指数字符串上比较，
+//接收行分别用旧方式(sscanf)和新方式(Num_*)解析，字段格式与Parse_UWB_Data、
+//Process_Compact_Broadcast和Process_Control_Command相同。全部检查通过时返回0
+
+#define ACCURACY_STRINGS  4000000
+#define MAX_ULP           3         //Reached with large negative exponents, each division step rounds once //出现在较大的负指数，每步除法舍入一次
+#define BENCH_LINES       200000
+
+static int Failures;
+static volatile float Sink_f;
+static uint32_t Seed = 12345;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static uint32_t Rand(void)
+{
+	Seed = Seed * 1664525U + 1013904223U;
+	return Seed >> 8;
+}
+
+//Distance in representable floats, both values finite //两个有限值之间相差的可表示浮点数个数
+static uint32_t Ulp_Distance(float a, float b)
+{
+	int32_t ia, ib;
+	memcpy(&ia, &a, 4);
+	memcpy(&ib, &b, 4);
+	if(ia < 0) ia = (int32_t)0x80000000 - ia;
+	if(ib < 0) ib = (int32_t)0x80000000 - ib;
+	return ia > ib ? (uint32_t)(ia - ib) : (uint32_t)(ib - ia);
+}
+
+//Random number text: sign, 1 to 12 digits, a decimal point anywhere, an exponent one time in four
+//随机数字文本：符号、1到12位数字、任意位置的小数点、四分之一的概率带指数
+static int Random_Number(char *s)
+{
+	int n = 0, digits = 1 + (int)(Rand() % 12), point = (int)(Rand() % (digits + 1)), i;
+
+	if(Rand() & 1) s[n++] = '-';
+	for(i = 0; i < digits; i++)
+	{
+		if(i == point && i) s[n++] = '.';
+		s[n++] = (char)('0' + Rand() % 10);
+	}
+	if((Rand() & 3) == 0) n += sprintf(s + n, "e%d", (int)(Rand() % 61) - 30);
+	s[n] = '\0';
+	return n;
+}
+
+static void Test_Accuracy(void)
+{
+	char s[32];
+	Num_Cursor_t c;
+	float v, ref;
+	uint32_t i, ulp, worst = 0, wrong_end = 0;
+	int n;
+
+	printf("Num_Float against strtof\n");
+	for(i = 0; i < ACCURACY_STRINGS; i++)
+	{
+		char *end;
+		n = Random_Number(s);
+		ref = strtof(s, &end);
+		Num_Cursor_Init(&c, s, (uint16_t)n);
+		//Beyond FLT_MAX strtof returns inf, Num_Float reports a range error
+		//超过FLT_MAX时strtof返回inf，Num_Float报告范围错误
+		if(isinf(ref))
+		{
+			if(Num_Float(&c, &v) || c.Error != NUM_ERR_RANGE) wrong_end++;
+			continue;
+		}
+		if(!Num_Float(&c, &v) || c.Pos != end) { wrong_end++; continue; }
+		ulp = Ulp_Distance(v, ref);
+		if(ulp > worst)
+		{
+			worst = ulp;
+			if(ulp > MAX_ULP) printf("  %s: %.9g, strtof %.9g\n", s, (double)v, (double)ref);
+		}
+	}
+	printf("  %d strings, largest error %lu ulp\n", ACCURACY_STRINGS, (unsigned long)worst);
+	Check(wrong_end == 0, "accepted where strtof is, stops where it stops");
+	Check(worst <= MAX_ULP, "within MAX_ULP of strtof");
+
+	Num_Cursor_Init(&c, "1e39", 4);
+	Check(!Num_Float(&c, &v) && c.Error == NUM_ERR_RANGE, "overflow reported as NUM_ERR_RANGE");
+	Num_Cursor_Init(&c, "", 0);
+	Check(!Num_Float(&c, &v) && c.Error == NUM_ERR_END, "empty input reported as NUM_ERR_END");
+	Num_Cursor_Init(&c, "NULL,1.5", 8);
+	Check(!Num_Float(&c, &v) && c.Error == NUM_ERR_DIGIT && c.Error_Pos == 0, "NULL reported as NUM_ERR_DIGIT at 0");
+	Num_Cursor_Init(&c, "1.25,", 3);
+	Check(Num_Float(&c, &v) && v == 1.2f && c.Pos == c.Start + 3, "read bounded by the end pointer");
+}
+
+static const char Uwb_Line[]     = "$KT1,1.234,NULL,2.456,3.789,LO=[1.21,2.32,0.00]";
+static const char Compact_Line[] = "[4 C1 1.21 2.32 78.5 0.120 0.080 0.050 C2 2.21 3.32 38.2 1.120 4.900 0.080 "
+                                   "C3 3.33 3.33 33.3 0.333 0.333 0.033 C4 4.44 4.44 44.4 0.444 0.444 0.044]";
+static const char Ctrl_Line[]    = "CTRL:CAR1,TARGET:1.50,2.30,45.0";
+
+//Old Parse_UWB_Data, without the globals //旧Parse_UWB_Data，去掉全局变量
+static int Old_Uwb(const char *data, float *d, float *p)
+{
+	char role[3], coord[50];
+	const char *lo, *lo_end;
+
+	sscanf(data + 2, "%2s", role);
+	sscanf(strchr(data, ',') + 1, "%f,%f,%f,%f", &d[0], &d[1], &d[2], &d[3]);
+	lo = strstr(data, "LO=[");
+	if(lo == NULL || (lo_end = strchr(lo + 4, ']')) == NULL || lo_end - lo - 4 >= (int)sizeof(coord) - 1) return 0;
+	memcpy(coord, lo + 4, lo_end - lo - 4);
+	coord[lo_end - lo - 4] = '\0';
+	return sscanf(coord, "%f,%f,%f", &p[0], &p[1], &p[2]) == 3;
+}
+
+//Parse_UWB_Data now //现在的Parse_UWB_Data
+static int New_Uwb(const char *data, uint16_t len, float *d, float *p)
+{
+	char role[3];
+	Num_Cursor_t c;
+	int i;
+
+	Num_Cursor_Init(&c, data, len);
+	c.Pos += 2;
+	Num_Token(&c, role, sizeof(role), ',');
+	if(Num_Skip_Past(&c, ','))
+		for(i = 0; i < 4; i++)
+		{
+			if(Num_Peek(&c) == 'N') { if(!Num_Expect_Str(&c, "NULL")) break; }
+			else if(!Num_Float(&c, &d[i])) break;
+			if(Num_Peek(&c) != ',') break;
+			c.Pos++;
+		}
+	return Num_Peek(&c) == 'L' && Num_Expect_Str(&c, "LO=[") &&
+	       Num_Float(&c, &p[0]) && Num_Expect(&c, ',') && Num_Float(&c, &p[1]) && Num_Expect(&c, ',') &&
+	       Num_Float(&c, &p[2]) && Num_Expect(&c, ']');
+}
+
+//Old Process_Compact_Broadcast: sscanf then strchr to step over the seven fields
+//旧Process_Compact_Broadcast：sscanf后再用strchr跳过七个字段
+static int Old_Compact(const char *data, float *f)
+{
+	const char *ptr = data + 1;
+	char id[4];
+	int count, i, j;
+
+	if(sscanf(ptr, "%d", &count) != 1 || (ptr = strchr(ptr, ' ')) == NULL) return 0;
+	ptr++;
+	for(i = 0; i < count; i++)
+	{
+		if(sscanf(ptr, "%3s %f %f %f %f %f %f", id, &f[0], &f[1], &f[2], &f[3], &f[4], &f[5]) != 7) break;
+		for(j = 0; j < 7 && ptr; j++)
+		{
+			ptr = strchr(ptr, ' ');
+			if(ptr) ptr++;
+		}
+		if(ptr == NULL) { i++; break; }
+	}
+	return i;
+}
+
+//Process_Compact_Broadcast now //现在的Process_Compact_Broadcast
+static int New_Compact(const char *data, float *f)
+{
+	const char *end = strchr(data, ']');
+	char id[8];
+	Num_Cursor_t c;
+	int32_t count;
+	int i;
+
+	Num_Cursor_Init(&c, data + 1, (uint16_t)(end - data - 1));
+	if(!Num_Int(&c, &count)) return 0;
+	for(i = 0; i < count; i++)
+	{
+		Num_Skip_Spaces(&c);
+		if(!(Num_Token(&c, id, sizeof(id), ' ') && Num_Float(&c, &f[0]) && Num_Float(&c, &f[1]) &&
+		     Num_Float(&c, &f[2]) && Num_Float(&c, &f[3]) && Num_Float(&c, &f[4]) && Num_Float(&c, &f[5]))) break;
+	}
+	return i;
+}
+
+static int Old_Ctrl(const char *data, float *f)
+{
+	char car[16];
+	return sscanf(strstr(data, "CTRL:"), "CTRL:%15[^,],TARGET:%f,%f,%f", car, &f[0], &f[1], &f[2]) == 4;
+}
+
+static int New_Ctrl(const char *data, float *f)
+{
+	char car[16];
+	Num_Cursor_t c;
+
+	Num_Cursor_Init(&c, strstr(data, "CTRL:") + 5, 96);
+	return Num_Token(&c, car, sizeof(car), ',') && Num_Expect_Str(&c, ",TARGET:") &&
+	       Num_Float(&c, &f[0]) && Num_Expect(&c, ',') && Num_Float(&c, &f[1]) && Num_Expect(&c, ',') &&
+	       Num_Float(&c, &f[2]);
+}
+
+static void Report(const char *name, uint32_t ns_old, uint32_t ns_new)
+{
+	printf("  %-24s %6.2fM lines/s with sscanf, %6.2fM with Num_*\n", name,
+	       BENCH_LINES / (double)ns_old * 1e3, BENCH_LINES / (double)ns_new * 1e3);
+}
+
+static void Bench_Lines(void)
+{
+	float d_old[4] = { NAN, NAN, NAN, NAN }, d_new[4] = { NAN, NAN, NAN, NAN };
+	float p_old[6] = { 0 }, p_new[6] = { 0 };
+	uint32_t i, t_old, t_new;
+	int ok;
+
+	printf("ingest lines, same fields both ways\n");
+	ok = Old_Uwb(Uwb_Line, d_old, p_old) && New_Uwb(Uwb_Line, sizeof(Uwb_Line) - 1, d_new, p_new) &&
+	     memcmp(p_old, p_new, 3 * sizeof(float)) == 0;
+	//sscanf stops at the NULL anchor, the cursor keeps the distances after it
+	//sscanf在NULL基站处停止，游标保留其后的距离
+	Check(ok && d_old[0] == d_new[0] && isnan(d_old[2]) && d_new[2] == 2.456f && d_new[3] == 3.789f,
+	      "UWB: same position, distances after NULL kept");
+	Check(Old_Compact(Compact_Line, p_old) == 4 && New_Compact(Compact_Line, p_new) == 4 &&
+	      memcmp(p_old, p_new, sizeof(p_old)) == 0, "compact broadcast: 4 cars, same fields");
+	Check(Old_Ctrl(Ctrl_Line, p_old) && New_Ctrl(Ctrl_Line, p_new) &&
+	      memcmp(p_old, p_new, 3 * sizeof(float)) == 0, "CTRL: same target");
+
+	t_old = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) Old_Uwb(Uwb_Line, d_old, p_old);
+	t_old = Host_Ns() - t_old;
+	t_new = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) New_Uwb(Uwb_Line, sizeof(Uwb_Line) - 1, d_new, p_new);
+	t_new = Host_Ns() - t_new;
+	Report("UWB line", t_old, t_new);
+
+	t_old = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) Old_Compact(Compact_Line, p_old);
+	t_old = Host_Ns() - t_old;
+	t_new = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) New_Compact(Compact_Line, p_new);
+	t_new = Host_Ns() - t_new;
+	Report("compact broadcast, 4 cars", t_old, t_new);
+
+	t_old = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) Old_Ctrl(Ctrl_Line, p_old);
+	t_old = Host_Ns() - t_old;
+	t_new = Host_Ns();
+	for(i = 0; i < BENCH_LINES; i++) New_Ctrl(Ctrl_Line, p_new);
+	t_new = Host_Ns() - t_new;
+	Report("CTRL command", t_old, t_new);
+	Sink_f = p_old[0] + p_new[0] + d_old[0] + d_new[0];
+}
+
+int main(void)
+{
+	Test_Accuracy();
+	Bench_Lines();
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,269 @@
+#include "collision_avoid.h"
+#include "esp8266_driver.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//Cars running collision_avoid.c in virtual time, each on its own view of the
+//broadcast reports. Cases are the six car antipodal swap, a remote controlled
+//car driving head on at one running ORCA, and a full peer table closing in on
+//one car, the worst case of the linear program. Checks the smallest distance
+//between two cars, that every car reaches its goal, and the time per call.
+//The exit status is 0 when all checks pass.
+//在虚拟时间中运行多辆车的collision_avoid.c，每辆车使用各自收到的广播数据。工况为六车对向换位、
+//遥控车辆与运行ORCA的车辆对向行驶，以及车辆表全满且全部向一辆车靠近的最坏情况。检查两车最小距离、
+//每辆车到达目标，以及每次调用的耗时。全部检查通过时返回0
+
+#define CARS_MAX          6
+#define CIRCLE_R          2.0f        //Start circle, goals opposite //起点所在圆，目标在对面
+#define CONTROL_MS        10          //Balance_task period //Balance_task周期
+#define REPORT_MS         100         //Status broadcast period //状态广播周期
+#define V_PREF            0.3f        //Planner speed //规划速度
+#define SMOOTH_STEP       0.01f       //Smooth_control slew per tick //Smooth_control每周期变化量
+#define RUN_S             40.0f
+#define GOAL_TOL          0.10f
+#define SEPARATION_MIN    (2.0f * ORCA_RADIUS)   //Bodies touch below this //小于该距离车身相碰
+#define WORST_CALLS       2000
+//Host time per call, mean over the calls of the min of repeats. The 168 MHz M4 is slower than the host,
+//Collision_Avoid.Cycles_Max gives its number on the car; this bound and the
+//table size ratio catch a change of the complexity
+//PC上每次调用的耗时(每次调用重复多次取最小值，再对所有调用取平均)。168MHz的M4比PC慢，实车耗时见Collision_Avoid.Cycles_Max；
+//该上限和车辆表大小的比值用于发现复杂度的变化
+#define WORST_BUDGET_NS   50000
+#define TABLE_RATIO_MAX   1.5f        //Full table against ORCA_MAX_PEERS peers //满车辆表与ORCA_MAX_PEERS辆车的耗时比上限
+
+//Firmware globals collision_avoid.c uses //collision_avoid.c用到的固件全局变量
+OtherCarInfo other_cars[MAX_OTHER_CARS];
+float position[3], Yaw, Current_Vx, Current_Vy;
+
+typedef struct
+{
+	float X, Y, VX, VY, Goal_X, Goal_Y;
+	uint8_t Rc;                   //Drives straight to its goal, does not avoid //直接驶向目标，不避让
+	OtherCarInfo Report;
+	Collision_Avoid_t Ca;
+}Car_t;
+
+static Car_t Cars[CARS_MAX];
+static int Failures;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static float Slew(float now, float target)
+{
+	if(target > now + SMOOTH_STEP) return now + SMOOTH_STEP;
+	if(target < now - SMOOTH_STEP) return now - SMOOTH_STEP;
+	return target;
+}
+
+typedef struct
+{
+	float Separation;             //Smallest distance between two cars, m //两车最小距离
+	float Goal_Miss;              //Largest distance to the goal at the end //结束时与目标的最大距离
+}Swap_Result_t;
+
+//cars: on a circle, goals opposite; rc: index of the remote controlled car, -1 none;
+//rc_flag: reciprocal flag it broadcasts
+//cars：车辆位于圆上，目标在对面；rc：遥控车辆的索引，-1表示没有；rc_flag：其广播的避碰标志
+static Swap_Result_t Swap_Run(int cars, int rc, uint8_t rc_flag)
+{
+	Swap_Result_t r = { 1e9f, 0 };
+	float vx, vy, dx, dy, d, a;
+	uint32_t n, steps = (uint32_t)(RUN_S * 1000.0f / CONTROL_MS);
+	int i, j, m;
+
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	for(i = 0; i < cars; i++)
+	{
+		Car_t init = { 0 };
+		Collision_Avoid_t ca = COLLISION_AVOID_DEFAULT;
+
+		a = 6.2831853f * i / cars;
+		Cars[i] = init;
+		Cars[i].X = CIRCLE_R * cosf(a);
+		Cars[i].Y = CIRCLE_R * sinf(a);
+		Cars[i].Goal_X = -Cars[i].X;
+		Cars[i].Goal_Y = -Cars[i].Y;
+		Cars[i].Rc = (i == rc);
+		Cars[i].Ca = ca;
+		Cars[i].Ca.V_Max = V_PREF;
+	}
+
+	for(n = 0; n < steps; n++, Host_Clock_Skip_us(CONTROL_MS * 1000))
+	{
+		//Broadcasts, yaw 0 so body and world frame agree //广播数据，航向为0，车体与世界坐标系一致
+		if(n % (REPORT_MS / CONTROL_MS) == 0)
+			for(i = 0; i < cars; i++)
+			{
+				OtherCarInfo *p = &Cars[i].Report;
+
+				snprintf(p->car_id, sizeof(p->car_id), "CAR%d", i + 1);
+				p->position_x = Cars[i].X;
+				p->position_y = Cars[i].Y;
+				p->velocity_vx = Cars[i].VX;
+				p->velocity_vy = Cars[i].VY;
+				p->yaw = 0;
+				p->last_update = HAL_GetTick();
+				p->reciprocal = Cars[i].Rc ? rc_flag : 1;
+				p->valid = 1;
+			}
+
+		for(i = 0; i < cars; i++)
+		{
+			//Planner: straight to the goal, slowing down in the last metre
+			//规划：直接驶向目标，最后1米减速
+			dx = Cars[i].Goal_X - Cars[i].X;
+			dy = Cars[i].Goal_Y - Cars[i].Y;
+			d = hypotf(dx, dy);
+			vx = d > 1e-3f ? dx / d * fminf(V_PREF, d) : 0;
+			vy = d > 1e-3f ? dy / d * fminf(V_PREF, d) : 0;
+			if(!Cars[i].Rc)
+			{
+				memset(other_cars, 0, sizeof(other_cars));
+				for(j = 0, m = 0; j < cars; j++)
+					if(j != i) other_cars[m++] = Cars[j].Report;
+				Collision_Avoid_Filter(&Cars[i].Ca, Cars[i].X, Cars[i].Y, Cars[i].VX, Cars[i].VY, &vx, &vy);
+			}
+			Cars[i].VX = Slew(Cars[i].VX, vx);
+			Cars[i].VY = Slew(Cars[i].VY, vy);
+		}
+		for(i = 0; i < cars; i++)
+		{
+			Cars[i].X += Cars[i].VX * CONTROL_MS * 0.001f;
+			Cars[i].Y += Cars[i].VY * CONTROL_MS * 0.001f;
+		}
+		for(i = 0; i < cars; i++)
+			for(j = i + 1; j < cars; j++)
+			{
+				d = hypotf(Cars[i].X - Cars[j].X, Cars[i].Y - Cars[j].Y);
+				if(d < r.Separation) r.Separation = d;
+			}
+	}
+	for(i = 0; i < cars; i++)
+	{
+		d = hypotf(Cars[i].Goal_X - Cars[i].X, Cars[i].Goal_Y - Cars[i].Y);
+		if(d > r.Goal_Miss) r.Goal_Miss = d;
+	}
+	return r;
+}
+
+//One call against a peer coming head on that keeps its velocity. Returns the
+//time until the two come within the ORCA clearance at the filtered velocity,
+//1e9 if never
+//对向驶来且保持速度的一辆车，调用一次滤波器。返回按滤波后速度两车进入ORCA间距以内所需的时间，永不相碰时为1e9
+static float Head_On_Ttc(uint8_t reciprocal)
+{
+	Collision_Avoid_t ca = COLLISION_AVOID_DEFAULT;
+	float vx = V_PREF, vy = 0, px = 1.5f, py = 0.05f, rvx, rvy, a, b, c, disc;
+	float r = 2.0f * ORCA_RADIUS + ORCA_MARGIN;
+
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	Host_Clock_Skip_us(1000000);
+	memset(other_cars, 0, sizeof(other_cars));
+	strcpy(other_cars[0].car_id, "CAR2");
+	other_cars[0].position_x = px;
+	other_cars[0].position_y = py;
+	other_cars[0].velocity_vx = -V_PREF;
+	other_cars[0].last_update = HAL_GetTick();
+	other_cars[0].reciprocal = reciprocal;
+	other_cars[0].valid = 1;
+	Collision_Avoid_Filter(&ca, 0, 0, V_PREF, 0, &vx, &vy);
+
+	rvx = -V_PREF - vx;
+	rvy = -vy;
+	a = rvx * rvx + rvy * rvy;
+	b = px * rvx + py * rvy;
+	c = px * px + py * py - r * r;
+	disc = b * b - a * c;
+	if(b >= 0 || disc <= 0 || a < 1e-9f) return 1e9f;
+	return (-b - sqrtf(disc)) / a;
+}
+
+//Full peer table closing in on a car at the origin that wants to go through them
+//车辆表全满，全部向原点处的车辆靠近，该车想从中间穿过
+static uint32_t Worst_Run(int peers, uint32_t *infeasible)
+{
+	Collision_Avoid_t ca = COLLISION_AVOID_DEFAULT;
+	uint32_t best;
+	float vx, vy, a, d;
+	int i, k, rep;
+	float sum = 0;
+
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	Host_Clock_Skip_us(1000000);
+	for(k = 0; k < WORST_CALLS; k++)
+	{
+		memset(other_cars, 0, sizeof(other_cars));
+		for(i = 0; i < peers; i++)
+		{
+			a = 6.2831853f * i / peers + 0.37f * k;
+			d = 0.55f + 1.3f * (float)((i * 7 + k) % peers) / peers;
+			snprintf(other_cars[i].car_id, sizeof(other_cars[i].car_id), "CAR%d", i + 1);
+			other_cars[i].position_x = d * cosf(a);
+			other_cars[i].position_y = d * sinf(a);
+			other_cars[i].velocity_vx = -V_PREF * cosf(a);
+			other_cars[i].velocity_vy = -V_PREF * sinf(a);
+			other_cars[i].last_update = HAL_GetTick() - (uint32_t)(i * 40 % 300);
+			other_cars[i].reciprocal = (uint8_t)(i & 1);
+			other_cars[i].valid = 1;
+		}
+		best = 0xFFFFFFFFu;
+		for(rep = 0; rep < 5; rep++)
+		{
+			vx = V_PREF * cosf(0.11f * k);
+			vy = V_PREF * sinf(0.11f * k);
+			Collision_Avoid_Filter(&ca, 0, 0, vx * 0.5f, vy * 0.5f, &vx, &vy);
+			if(ca.Cycles < best) best = ca.Cycles;
+		}
+		sum += best;
+	}
+	*infeasible = ca.Infeasible / 5;
+	return (uint32_t)(sum / WORST_CALLS);
+}
+
+int main(void)
+{
+	Swap_Result_t r, old;
+	uint32_t full_ns, max_ns, full_inf, max_inf;
+	float rc_ttc, orca_ttc;
+
+	printf("ORCA, reports every %d ms, bodies touch below %.2f m\n", REPORT_MS, (double)SEPARATION_MIN);
+
+	r = Swap_Run(CARS_MAX, -1, 0);
+	printf("%d car antipodal swap: separation %.3f m, goal miss %.3f m\n", CARS_MAX, (double)r.Separation, (double)r.Goal_Miss);
+	Check(r.Separation >= SEPARATION_MIN, "no two cars touch");
+	Check(r.Goal_Miss <= GOAL_TOL, "every car reaches its goal");
+
+	r = Swap_Run(2, 0, 0);
+	old = Swap_Run(2, 0, 1);
+	printf("head on with a remote controlled car: separation %.3f m (%.3f m when it claims to avoid)\n",
+	       (double)r.Separation, (double)old.Separation);
+	Check(r.Separation >= SEPARATION_MIN, "the cars do not touch");
+	Check(r.Goal_Miss <= GOAL_TOL, "both cars reach their goals");
+	rc_ttc = Head_On_Ttc(0);
+	orca_ttc = Head_On_Ttc(1);
+	printf("one call head on: time to collision %.2f s against a remote controlled car, %.2f s against one running ORCA\n",
+	       (double)fminf(rc_ttc, 99.0f), (double)fminf(orca_ttc, 99.0f));
+	Check(rc_ttc >= ORCA_TIME_HORIZON * 0.99f, "a car that does not avoid is avoided over the whole look-ahead");
+	Check(orca_ttc < ORCA_TIME_HORIZON, "a car running ORCA takes its half");
+
+	max_ns = Worst_Run(ORCA_MAX_PEERS, &max_inf);
+	full_ns = Worst_Run(MAX_OTHER_CARS, &full_inf);
+	printf("closing in: %d peers %lu ns per call (%lu infeasible), %d peers %lu ns (%lu infeasible)\n",
+	       ORCA_MAX_PEERS, (unsigned long)max_ns, (unsigned long)max_inf,
+	       MAX_OTHER_CARS, (unsigned long)full_ns, (unsigned long)full_inf);
+	Check(full_inf > 0, "the least violation fallback runs");
+	Check(full_ns <= WORST_BUDGET_NS, "full table within the time budget");
+	Check(full_ns <= TABLE_RATIO_MAX * max_ns, "time does not grow with the table size");
+
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,153 @@
+#include "uwb.h"
+#include "mode_manager.h"
+#include "formation_control.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//UWB lines written into the UART5 ring as the DMA would, the idle line event
+//and the UWB task's line cutting, then Uwb_Position_Poll and Mode_Select once
+//per control cycle in virtual time. The stream stops for a while in every
+//position mode. Checks that the car stops within UWB_STALE_MS of the last
+//fix, drives again with the first new fix, that remote control does not
+//depend on the fixes, and that Uwb_Position_Now takes the age of the fix out
+//of the position. The exit status is 0 when all checks pass.
+//像DMA一样把UWB数据行写入UART5接收缓冲区，经过空闲线事件和UWB任务的切分行处理，
+//在虚拟时间中每个控制周期调用一次Uwb_Position_Poll和Mode_Select。每种位置模式下数据流中断一段时间。
+//检查最后一次定位后UWB_STALE_MS内停车、收到新定位后立即恢复、遥控不依赖定位，
+//以及Uwb_Position_Now消除了定位时长带来的位置滞后。全部检查通过时返回0
+
+#define CONTROL_MS        10          //Balance_task period //Balance_task周期
+#define FIX_MS            100         //Tag update period //标签定位周期
+#define RUN_MS            8000
+#define STALL_FROM_MS     3000        //The stream stops here... //数据流在此中断...
+#define STALL_TO_MS       5000        //...and comes back here //...并在此恢复
+#define CAR_VX            0.3f        //Car driving along x, m/s //小车沿x方向行驶，m/s
+#define NOW_ERROR_MAX     0.005f      //Uwb_Position_Now against the true position, m //Uwb_Position_Now与真实位置的误差上限，m
+
+//Firmware globals Mode_Select and uwb.c use //Mode_Select和uwb.c用到的固件全局变量
+UART_HandleTypeDef huart5;
+float position[3];
+uint8_t Formation_mode, Auto_mode, newCoordinateReceived;
+u8 APP_ON_Flag;
+uint8_t Autotune_Active(void) { return 0; }
+uint8_t Host_Link_Active(void) { return 0; }
+
+static int Failures;
+static uint16_t Dma_Head;
+static int Run_Base_Ms;           //Virtual time at the start of the run, the car keeps driving //本次运行开始时的虚拟时间，小车持续行驶
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+//One line through the DMA ring and the idle line event //一行数据经过DMA缓冲区和空闲线事件
+static void Uwb_Send_Line(float x, float y)
+{
+	char line[96];
+	int i, n;
+
+	n = snprintf(line, sizeof(line), "$KT1,1.69,2.93,4.98,NULL,LO=[%.3f,%.3f,0.00]\n", (double)x, (double)y);
+	for(i = 0; i < n; i++)
+	{
+		huart5.pRxBuffPtr[Dma_Head] = (uint8_t)line[i];
+		Dma_Head = (uint16_t)((Dma_Head + 1) % huart5.RxXferSize);
+	}
+	Uwb_Rx_Event_ISR(Dma_Head);
+	Uwb_Rx_Drain();
+}
+
+typedef struct
+{
+	int Early_Stops;              //Cycles stopped while fixes arrived //有定位时停车的周期数
+	int Stop_Ms;                  //Last fix to the first stopped cycle, -1 never //最后一次定位到首次停车的时间，-1表示未停车
+	int Resume_Ms;                //First new fix to the first moving cycle, -1 never //首个新定位到首次恢复的时间，-1表示未恢复
+	float Raw_Error, Now_Error;   //Largest error of position[] and Uwb_Position_Now, m //position[]和Uwb_Position_Now的最大误差，m
+}Stall_Result_t;
+
+static Stall_Result_t Stall_Run(uint8_t expected)
+{
+	Stall_Result_t r = { 0, -1, -1, 0, 0 };
+	int t, last_fix = -1, first_new = -1;
+	uint8_t mode, stalled;
+	float truth, x, y;
+
+	for(t = 0; t < RUN_MS; t += CONTROL_MS, Host_Clock_Skip_us(CONTROL_MS * 1000))
+	{
+		truth = 1.0f + CAR_VX * (Run_Base_Ms + t) * 0.001f;
+		stalled = (t >= STALL_FROM_MS && t < STALL_TO_MS);
+		if(t % FIX_MS == 0 && !stalled)
+		{
+			Uwb_Send_Line(truth, 2.0f);
+			last_fix = t;
+			if(t >= STALL_TO_MS && first_new < 0) first_new = t;
+		}
+
+		Uwb_Position_Poll();
+		mode = Mode_Select();
+
+		if(last_fix >= 0 && t < STALL_FROM_MS)
+		{
+			if(mode != expected) r.Early_Stops++;
+			Uwb_Position_Now(CAR_VX, 0, &x, &y);
+			if(fabsf(position[0] - truth) > r.Raw_Error) r.Raw_Error = fabsf(position[0] - truth);
+			if(fabsf(x - truth) > r.Now_Error) r.Now_Error = fabsf(x - truth);
+		}
+		if(stalled && r.Stop_Ms < 0 && mode == CTRL_MODE_STOP) r.Stop_Ms = t - last_fix;
+		if(first_new >= 0 && r.Resume_Ms < 0 && mode == expected) r.Resume_Ms = t - first_new;
+	}
+	Run_Base_Ms += RUN_MS;
+	return r;
+}
+
+int main(void)
+{
+	static const struct { const char *Name; uint8_t Formation, Auto, Expected; } cases[] =
+	{
+		{ "AUTO",      FORMATION_MODE_NONE,      1, CTRL_MODE_AUTO },
+		{ "FOLLOWER",  FORMATION_MODE_FOLLOWER,  0, CTRL_MODE_FOLLOWER },
+		{ "CONSENSUS", FORMATION_MODE_CONSENSUS, 0, CTRL_MODE_CONSENSUS },
+	};
+	Stall_Result_t r;
+	char what[64];
+	unsigned k;
+
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	Uwb_Init();
+	printf("UWB fix every %d ms, stream stalled from %.1f s to %.1f s, stale after %d ms\n",
+	       FIX_MS, STALL_FROM_MS * 0.001, STALL_TO_MS * 0.001, UWB_STALE_MS);
+	Check(Uwb.Ready && huart5.pRxBuffPtr != NULL, "UART5 reception started");
+
+	for(k = 0; k < sizeof(cases) / sizeof(cases[0]); k++)
+	{
+		Formation_mode = cases[k].Formation;
+		Auto_mode = cases[k].Auto;
+		newCoordinateReceived = cases[k].Auto;
+		APP_ON_Flag = 0;
+		r = Stall_Run(cases[k].Expected);
+		printf("%s: stopped %d ms after the last fix, moving %d ms after the first new one, position error %.4f m (%.4f m without the age)\n",
+		       cases[k].Name, r.Stop_Ms, r.Resume_Ms, (double)r.Now_Error, (double)r.Raw_Error);
+		snprintf(what, sizeof(what), "%s never stops while fixes arrive", cases[k].Name);
+		Check(r.Early_Stops == 0, what);
+		snprintf(what, sizeof(what), "%s stops within the stale time", cases[k].Name);
+		Check(r.Stop_Ms >= 0 && r.Stop_Ms <= UWB_STALE_MS + CONTROL_MS, what);
+		snprintf(what, sizeof(what), "%s drives again with the first new fix", cases[k].Name);
+		Check(r.Resume_Ms == 0, what);
+	}
+	Check(r.Now_Error <= NOW_ERROR_MAX && r.Now_Error < r.Raw_Error, "the position is moved on by the age of the fix");
+
+	//Remote control keeps driving without fixes //遥控在没有定位时继续行驶
+	Formation_mode = FORMATION_MODE_NONE;
+	Auto_mode = 0;
+	newCoordinateReceived = 0;
+	APP_ON_Flag = 1;
+	r = Stall_Run(CTRL_MODE_RC);
+	Check(r.Early_Stops == 0 && r.Stop_Ms < 0, "remote control does not stop");
+
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+#include "wheel_sync.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <math.h>
+
+//Closed loop check of wheel_sync.c on a Mecanum chassis model, against the
+//four uncoupled Incremental_PI loops. Each wheel speed follows its PWM with a
+//first order motor lag, the encoders count whole pulses every control tick
+//and the chassis moves with the least squares fit of the wheels in ground
+//contact. Checks that the cross coupling cuts the heading, sideways and null
+//space error of a straight leg with a saturated or loaded wheel, and that a
+//spinning wheel is reported within WHEEL_SLIP_TICKS, once, without turning
+//the car more than the uncoupled loops do, with no report in normal driving.
+//The exit status is 0 when all checks pass.
+//在麦轮底盘模型上对wheel_sync.c做闭环检查，并与四个独立的Incremental_PI环对比。每个车轮速度按
+//一阶电机滞后跟随PWM，编码器每个控制周期按整脉冲计数，车体按着地车轮的最小二乘拟合运动。
+//检查交叉耦合能减小车轮饱和或负载时直线行驶的航向、侧向和零空间误差，且打滑车轮在
+//WHEEL_SLIP_TICKS内被报告一次、小车转向不多于独立速度环，正常行驶时不误报。全部检查通过时返回0
+
+#define PLANT_STEP_S      0.001f
+#define CONTROL_STEPS     10               //100 Hz Balance_task
+#define CONTROL_DT        (PLANT_STEP_S * CONTROL_STEPS)
+#define LEVER             (0.0930f + 0.085f) //MEC_wheelspacing + MEC_axlespacing
+#define MOTOR_TAU_S       0.05f
+#define MOTOR_V_MAX       1.2f             //Wheel speed at PWM 1500, m/s //PWM为1500时的车轮速度
+#define PWM_MAX           1500.0f
+#define VELOCITY_KP       700.0f           //Velocity_KP, Velocity_KI of system.c
+#define VELOCITY_KI       700.0f
+#define ENCODER_M         (0.075f * 3.14159265f / (4 * 13 * 30)) //Metres per count, Mecanum_75, Hall_13, HALL_30F //每个脉冲对应的米数
+#define SMOOTH_STEP       0.01f            //Smooth_control slew per tick //Smooth_control每周期变化量
+#define RAD2DEG           57.2957795f
+
+static int Failures;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+typedef struct
+{
+	const char *Name;
+	float Vx, Vz;                  //Command, m/s and rad/s //指令
+	float Run_S;
+	float Gain_A;                  //Wheel A speed per PWM relative to the others //A轮单位PWM速度相对其他车轮的比例
+	float Load_From, Load_To;      //Wheel A gain drops to Load_Gain in this window, s //该时间段内A轮增益降为Load_Gain
+	float Load_Gain;
+	float Slip_From, Slip_To;      //Wheel A spins in this window, s //该时间段内A轮打滑空转
+	float Slip_Speed;              //Encoder speed of A above its ground speed, m/s //A轮编码器速度高于其对地速度的量
+}Sync_Case_t;
+
+typedef struct
+{
+	float Heading_Deg;             //Final heading error, degree //最终航向误差
+	float Heading_Max_Deg;
+	float Side_M;                  //Final sideways error, m //最终侧向误差
+	float Null_Rms;                //Null space wheel error, m/s //零空间车轮误差
+	int   Detect_Ticks;            //Ticks from the slip start to the report, -1 none //从打滑开始到报告的周期数，-1表示未报告
+	uint32_t Slip_Events;
+}Sync_Result_t;
+
+static float Limit(float v, float limit)
+{
+	if(v > limit)  return limit;
+	if(v < -limit) return -limit;
+	return v;
+}
+
+//Incremental_PI_A..D //增量式PI
+typedef struct
+{
+	float Pwm, Last_Bias;
+}Pi_t;
+
+static float Incremental_PI(Pi_t *p, float encoder, float target)
+{
+	float bias = target - encoder;
+	p->Pwm = Limit(p->Pwm + VELOCITY_KP * (bias - p->Last_Bias) + VELOCITY_KI * bias, PWM_MAX);
+	p->Last_Bias = bias;
+	return p->Pwm;
+}
+
+//Drive_Motor kinematics, row i maps (vx, vy, vz) to wheel i //Drive_Motor运动学
+static const float Kin[4][3] =
+{
+	{ 1,  1, -LEVER }, { 1, -1, -LEVER }, { 1,  1, LEVER }, { 1, -1, LEVER }
+};
+
+//Chassis velocity, least squares over the wheels with weight 1, slipping ones 0
+//车体速度：对着地车轮做最小二乘，打滑车轮权重为0
+static void Chassis_Velocity(const float w[4], const float weight[4], float v[3])
+{
+	float a[3][4] = { { 0 } }, f, t;
+	int i, j, k, r;
+
+	for(i = 0; i < 4; i++)
+		for(j = 0; j < 3; j++)
+		{
+			for(k = 0; k < 3; k++) a[j][k] += weight[i] * Kin[i][j] * Kin[i][k];
+			a[j][3] += weight[i] * Kin[i][j] * w[i];
+		}
+	for(i = 0; i < 3; i++)
+	{
+		for(r = i, j = i + 1; j < 3; j++) if(fabsf(a[j][i]) > fabsf(a[r][i])) r = j;
+		for(k = 0; k < 4; k++) { t = a[i][k]; a[i][k] = a[r][k]; a[r][k] = t; }
+		for(j = 0; j < 3; j++)
+		{
+			if(j == i) continue;
+			f = a[j][i] / a[i][i];
+			for(k = i; k < 4; k++) a[j][k] -= f * a[i][k];
+		}
+	}
+	for(i = 0; i < 3; i++) v[i] = a[i][3] / a[i][i];
+}
+
+static Sync_Result_t Sync_Run(const Sync_Case_t *k, int coupled)
+{
+	Wheel_Sync_t s = { { 0 } };
+	Pi_t pi[4] = { { 0 } };
+	Sync_Result_t r = { 0 };
+	float w[4] = { 0 }, ground[4], weight[4], v[3] = { 0 }, gain[4], count[4] = { 0 }, last_count[4] = { 0 };
+	float smooth[2] = { 0 }, target[4], measured[4], corr[4] = { 0 }, pwm[4] = { 0 };
+	float heading = 0, y = 0, t, null_sum = 0;
+	uint32_t n, steps = (uint32_t)(k->Run_S / PLANT_STEP_S), ticks = 0;
+	int i, slipping, slip_tick = -1;
+
+	r.Detect_Ticks = -1;
+	for(n = 0; n < steps; n++)
+	{
+		t = n * PLANT_STEP_S;
+		slipping = t >= k->Slip_From && t < k->Slip_To;
+
+		//Balance_task tick //Balance_task周期
+		if(n % CONTROL_STEPS == 0)
+		{
+			//Smooth_control then Drive_Motor //先Smooth_control后Drive_Motor
+			smooth[0] = Limit(smooth[0] + (k->Vx > 0 ? SMOOTH_STEP : -SMOOTH_STEP), fabsf(k->Vx));
+			smooth[1] = Limit(smooth[1] + (k->Vz > 0 ? SMOOTH_STEP : -SMOOTH_STEP), fabsf(k->Vz));
+			for(i = 0; i < 4; i++)
+			{
+				target[i] = Kin[i][0] * smooth[0] + Kin[i][2] * smooth[1];
+				//Whole encoder pulses over the tick //本周期内的整脉冲数
+				measured[i] = (floorf(count[i]) - floorf(last_count[i])) * ENCODER_M / CONTROL_DT;
+				last_count[i] = count[i];
+			}
+			if(slipping && slip_tick < 0) slip_tick = (int)ticks;
+
+			if(coupled)
+			{
+				Wheel_Sync_Update(&s, target, measured, v[2] * RAD2DEG, LEVER, CONTROL_DT);
+				for(i = 0; i < 4; i++) corr[i] = s.Correction[i];
+				if(s.Slip && r.Detect_Ticks < 0 && slip_tick >= 0) r.Detect_Ticks = (int)ticks - slip_tick;
+			}
+			for(i = 0; i < 4; i++) pwm[i] = Incremental_PI(&pi[i], measured[i], target[i] + corr[i]);
+			null_sum += powf((target[0] - measured[0] - target[1] + measured[1] - target[2] + measured[2] + target[3] - measured[3]) * 0.25f, 2);
+			ticks++;
+		}
+
+		//Motors and chassis //电机和车体
+		for(i = 0; i < 4; i++)
+		{
+			gain[i] = MOTOR_V_MAX;
+			weight[i] = 1.0f;
+		}
+		gain[0] *= k->Gain_A;
+		if(t >= k->Load_From && t < k->Load_To) gain[0] *= k->Load_Gain;
+		for(i = 0; i < 4; i++) w[i] += (gain[i] * pwm[i] / PWM_MAX - w[i]) * (PLANT_STEP_S / MOTOR_TAU_S);
+		for(i = 0; i < 4; i++) ground[i] = w[i];
+		if(slipping) weight[0] = 0;
+		Chassis_Velocity(ground, weight, v);
+		//A spinning wheel turns faster than the ground under it //空转车轮转得比其下方地面快
+		if(slipping) w[0] = Kin[0][0] * v[0] + Kin[0][1] * v[1] + Kin[0][2] * v[2] + k->Slip_Speed;
+
+		for(i = 0; i < 4; i++) count[i] += w[i] * PLANT_STEP_S / ENCODER_M;
+		heading += v[2] * PLANT_STEP_S;
+		y += (v[0] * sinf(heading) + v[1] * cosf(heading)) * PLANT_STEP_S;
+		if(k->Vz == 0 && fabsf(heading) * RAD2DEG > r.Heading_Max_Deg) r.Heading_Max_Deg = fabsf(heading) * RAD2DEG;
+	}
+	r.Heading_Deg = heading * RAD2DEG;
+	r.Side_M = y;
+	r.Null_Rms = sqrtf(null_sum / ticks);
+	r.Slip_Events = s.Slip_Events;
+	return r;
+}
+
+static const Sync_Case_t Straight_Saturated = { "0.9 m/s, wheel A saturates at 0.8 m/s", 0.9f, 0, 10.0f, 0.8f / MOTOR_V_MAX, 0, 0, 1, 0, 0, 0 };
+static const Sync_Case_t Straight_Load      = { "0.5 m/s, wheel A loaded to 60% for 2 s", 0.5f, 0, 10.0f, 1.0f, 2.0f, 4.0f, 0.6f, 0, 0, 0 };
+static const Sync_Case_t Turn               = { "0.5 m/s turning at 1 rad/s",               0.5f, 1.0f, 10.0f, 1.0f, 0, 0, 1, 0, 0, 0 };
+static const Sync_Case_t Slip_Cases[] =
+{
+	{ "wheel A spins 0.3 m/s over ground", 0.5f, 0, 4.0f, 1.0f, 0, 0, 1, 2.0f, 2.5f, 0.3f },
+	{ "wheel A spins 0.6 m/s over ground", 0.5f, 0, 4.0f, 1.0f, 0, 0, 1, 2.0f, 2.5f, 0.6f },
+	{ "wheel A spins 1.0 m/s over ground", 0.5f, 0, 4.0f, 1.0f, 0, 0, 1, 2.0f, 2.5f, 1.0f },
+};
+
+static void Report(const char *name, const Sync_Result_t *r)
+{
+	printf("  %-14s heading %7.2f deg (max %6.2f), sideways %7.3f m, null space rms %.3f m/s\n", name,
+	       (double)r->Heading_Deg, (double)r->Heading_Max_Deg, (double)r->Side_M, (double)r->Null_Rms);
+}
+
+//Straight leg with a disturbance, coupled against uncoupled. reduction: required
+//drift ratio, null_reduction: required null space error ratio
+//带扰动的直线行驶，耦合与独立对比。reduction：要求的漂移减小倍数，null_reduction：要求的零空间误差减小倍数
+static void Test_Straight(const Sync_Case_t *k, float reduction, float null_reduction)
+{
+	Sync_Result_t off = Sync_Run(k, 0), on = Sync_Run(k, 1);
+
+	printf("%s\n", k->Name);
+	Report("uncoupled", &off);
+	Report("Wheel_Sync", &on);
+	Check(fabsf(on.Heading_Max_Deg) * reduction <= fabsf(off.Heading_Max_Deg), "heading drift cut by the cross coupling");
+	Check(fabsf(on.Side_M) * reduction <= fabsf(off.Side_M), "sideways drift cut by the cross coupling");
+	Check(on.Null_Rms * null_reduction <= off.Null_Rms, null_reduction > 1.0f ? "null space error cut by the cross coupling" : "null space error not made larger");
+	Check(on.Slip_Events == 0, "no slip reported");
+}
+
+int main(void)
+{
+	Sync_Result_t off, on;
+	unsigned i;
+
+	Test_Straight(&Straight_Saturated, 10.0f, 4.0f);
+	//The wheel PI takes most of a load that does not saturate it //未饱和的负载大部分由车轮PI承担
+	Test_Straight(&Straight_Load, 1.4f, 1.0f);
+
+	printf("%s\n", Turn.Name);
+	on = Sync_Run(&Turn, 1);
+	printf("  odometry and gyro agree, %lu slip events\n", (unsigned long)on.Slip_Events);
+	Check(on.Slip_Events == 0, "no slip reported while turning");
+
+	printf("single wheel slip at 0.5 m/s for 0.5 s\n");
+	for(i = 0; i < sizeof(Slip_Cases) / sizeof(Slip_Cases[0]); i++)
+	{
+		off = Sync_Run(&Slip_Cases[i], 0);
+		on = Sync_Run(&Slip_Cases[i], 1);
+		printf("  %-36s reported after %d ticks, heading change %.2f deg (uncoupled %.2f)\n", Slip_Cases[i].Name,
+		       on.Detect_Ticks, (double)on.Heading_Max_Deg, (double)off.Heading_Max_Deg);
+		Check(on.Detect_Ticks >= 0 && on.Detect_Ticks <= WHEEL_SLIP_TICKS, "reported within WHEEL_SLIP_TICKS");
+		Check(on.Slip_Events == 1, "one slip event");
+		Check(on.Heading_Max_Deg <= off.Heading_Max_Deg + 0.05f, "turns the car no more than the uncoupled loops");
+	}
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -0,0 +1,191 @@
+#include "yaw_control.h"
+#include "MPU6050.h"
+#include "host_port.h"
+#include <stdio.h>
+#include <math.h>
+
+//Settling time of the heading loop on a plant model, the single loop PID the
+//cascade replaced against Yaw_Cascade_t, in virtual time. The plant is the
+//path of a Vz command on the car: the Smooth_control slew of Drive_Motor, a
+//first order wheel lag and the IMU task integrating the z gyro at 200 Hz.
+//The controllers run at the 100 Hz of Balance_task. Cases are heading steps
+//as Auto_Adjust_Yaw sees them and the formation follower, whose target is
+//the turning leader heading plus Formation_offset_yaw, when the offset
+//changes. The exit status is 0 when all checks pass.
+//在虚拟时间中用被控对象模型比较航向环的调节时间：被替换的单环PID与Yaw_Cascade_t。被控对象为Vz指令
+//在小车上的路径：Drive_Motor中Smooth_control的斜率限制、一阶车轮滞后，以及IMU任务以200Hz积分z轴陀螺仪。
+//控制器按Balance_task的100Hz运行。工况为Auto_Adjust_Yaw看到的航向阶跃，以及编队跟随者在
+//Formation_offset_yaw变化时的响应，其目标航向为转动中的领航者航向加偏移。全部检查通过时返回0
+
+#define PLANT_STEP_US     1000        //Plant integration step //被控对象积分步长
+#define IMU_STEPS         5           //200 Hz IMU task //200Hz IMU任务
+#define CONTROL_STEPS     10          //100 Hz Balance_task
+#define WHEEL_TAU_S       0.08f       //Wheel speed lag behind the target //车轮速度滞后于目标的时间常数
+#define SMOOTH_STEP       0.01f       //Smooth_control slew per control cycle //Smooth_control每周期的变化量
+#define RUN_S             10.0f
+#define SETTLE_BAND       0.02f       //2% of the step //阶跃的2%
+#define SETTLE_MIN_DEG    0.5f        //Band floor, the heading resolution that matters //误差带下限
+
+//Firmware globals yaw_control.c uses, fed by the plant //yaw_control.c用到的固件全局变量，由被控对象提供
+float Yaw_Rate;
+static float Gyro_Angle;
+static u32 Gyro_us;
+
+void IMU_Get_Gyro_Yaw(float *angle_deg, u32 *timestamp_us)
+{
+	*angle_deg = Gyro_Angle;
+	*timestamp_us = Gyro_us;
+}
+
+static int Failures;
+
+static void Check(int ok, const char *what)
+{
+	printf("  %-52s %s\n", what, ok ? "ok" : "FAILED");
+	if(!ok) Failures++;
+}
+
+static float Wrap180(float d)
+{
+	while(d > 180.0f) d -= 360.0f;
+	while(d < -180.0f) d += 360.0f;
+	return d;
+}
+
+static float Limit(float v, float limit)
+{
+	if(v > limit)  return limit;
+	if(v < -limit) return -limit;
+	return v;
+}
+
+//Yaw_PID_Control before the change, static state kept in a struct so each run starts clean
+//修改前的Yaw_PID_Control，静态状态放入结构体，每次运行从零开始
+typedef struct
+{
+	float Integral, Last_Error;
+}Old_Pid_t;
+
+static float Old_Yaw_Pid(Old_Pid_t *s, float current_yaw, float target_yaw)
+{
+	const float kp = 0.12f, ki = 0.001f, kd = 0.05f;
+	float error = Wrap180(target_yaw - current_yaw), out;
+
+	s->Integral = Limit(s->Integral + error, 1.0f / ki);
+	out = kp * error + ki * s->Integral + kd * (error - s->Last_Error);
+	s->Last_Error = error;
+	return Limit(out, 1.0f);
+}
+
+//Smooth_control on Vz alone //仅Vz的Smooth_control
+static float Smooth_Vz(float smooth, float vz)
+{
+	if(vz > 0)      smooth += SMOOTH_STEP;
+	else if(vz < 0) smooth -= SMOOTH_STEP;
+	else            smooth *= 0.9f;
+	return Limit(smooth, fabsf(vz));
+}
+
+typedef struct
+{
+	const char *Name;
+	float Start_Yaw;
+	float Leader_Yaw, Leader_Rate;  //Leader heading and its turn rate, degree/s //领航者航向及其转动速度
+	float Offset;                   //Formation_offset_yaw after the change, the car starts on the old target //变化后的偏移，小车从旧目标开始
+	float Yaw_Gain;                 //Follower outer loop scale, 1.2 outside speed following //跟随者外环缩放
+}Yaw_Case_t;
+
+typedef struct
+{
+	float Settle_S, Overshoot;
+}Yaw_Result_t;
+
+//One run of a case, cascade = 0 runs the old PID //运行一个工况，cascade = 0时运行旧PID
+static Yaw_Result_t Yaw_Run(const Yaw_Case_t *k, int cascade)
+{
+	Yaw_Cascade_t c;
+	Old_Pid_t pid = { 0, 0 };
+	Yaw_Result_t r = { 0, 0 };
+	float yaw = k->Start_Yaw, rate = 0, smooth = 0, vz = 0, target, error, band, step, t, over;
+	u32 n, steps = (u32)(RUN_S * 1e6f / PLANT_STEP_US);
+
+	Yaw_Cascade_Init(&c);
+	c.Angle_Kp *= k->Yaw_Gain;
+	Host_Clock_Reset();
+	Host_Clock_Freeze();
+	Gyro_Angle = yaw;
+	Gyro_us = getMicros();
+	Yaw_Rate = 0;
+
+	//The target changes at t = 0, the car starts at rest //t = 0时目标改变，小车从静止开始
+	step = fabsf(Wrap180(k->Leader_Yaw + k->Offset - k->Start_Yaw));
+	band = SETTLE_BAND * step;
+	if(band < SETTLE_MIN_DEG) band = SETTLE_MIN_DEG;
+
+	for(n = 0; n < steps; n++, Host_Clock_Skip_us(PLANT_STEP_US))
+	{
+		t = n * (PLANT_STEP_US * 1e-6f);
+		target = Wrap180(k->Leader_Yaw + k->Leader_Rate * t + k->Offset);
+
+		if(n % CONTROL_STEPS == 0)
+		{
+			if(cascade) vz = Yaw_Cascade_Update(&c, yaw, target);
+			else        vz = Old_Yaw_Pid(&pid, yaw, target) * k->Yaw_Gain;
+			smooth = Smooth_Vz(smooth, vz);
+		}
+
+		//Wheel lag, Vz in rad/s turns the car at Vz*180/PI degree/s //车轮滞后，Vz单位rad/s
+		rate += (smooth * 57.2957795f - rate) * (PLANT_STEP_US * 1e-6f / WHEEL_TAU_S);
+		yaw = Wrap180(yaw + rate * (PLANT_STEP_US * 1e-6f));
+		if(n % IMU_STEPS == 0)
+		{
+			Yaw_Rate = rate;
+			Gyro_Angle = yaw;
+			Gyro_us = getMicros();
+		}
+
+		error = Wrap180(target - yaw);
+		if(fabsf(error) > band) r.Settle_S = t;
+		//Overshoot: past the target in the direction of the step //超调：沿阶跃方向越过目标的量
+		over = -error * (Wrap180(target - k->Start_Yaw) >= 0 ? 1.0f : -1.0f);
+		if(t > 0.05f && over > r.Overshoot) r.Overshoot = over;
+	}
+	if(r.Settle_S >= RUN_S - 0.01f) r.Settle_S = INFINITY;
+	return r;
+}
+
+static const Yaw_Case_t Cases[] =
+{
+	//Name                                        start  leader  rate  offset  gain
+	{ "Auto_Adjust_Yaw 30 degree step",               0,     30,    0,     0,  1.0f },
+	{ "Auto_Adjust_Yaw 90 degree step",               0,     90,    0,     0,  1.0f },
+	{ "Auto_Adjust_Yaw -150 degree step",            20,   -130,    0,     0,  1.0f },
+	{ "follower offset 0 to 45, leader still",        0,      0,    0,    45,  1.2f },
+	{ "follower offset 0 to 45, leader 10 deg/s",     0,      0,   10,    45,  1.2f },
+	{ "follower offset 45 to -45, leader 10 deg/s",  45,      0,   10,   -45,  1.2f },
+};
+
+int main(void)
+{
+	Yaw_Result_t old_r, new_r;
+	unsigned i;
+	int faster = 1, settled = 1, low_over = 1;
+
+	printf("heading loop settling time, single loop PID against Yaw_Cascade\n");
+	printf("  %-44s %-19s %s\n", "", "PID s / overshoot", "cascade s / overshoot");
+	for(i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+	{
+		old_r = Yaw_Run(&Cases[i], 0);
+		new_r = Yaw_Run(&Cases[i], 1);
+		printf("  %-44s %6.2f s %6.1f deg %6.2f s %6.1f deg\n", Cases[i].Name,
+		       (double)old_r.Settle_S, (double)old_r.Overshoot, (double)new_r.Settle_S, (double)new_r.Overshoot);
+		if(!isfinite(new_r.Settle_S)) settled = 0;
+		if(new_r.Settle_S > old_r.Settle_S) faster = 0;
+		if(new_r.Overshoot > 2.0f) low_over = 0;
+	}
+	Check(settled, "cascade settles within the run in every case");
+	Check(faster, "cascade settles no later than the PID in every case");
+	Check(low_over, "cascade overshoot below 2 degree");
+	printf("%s\n", Failures ? "FAILED" : "all checks passed");
+	return Failures ? 1 : 0;
+}
@@ -3,46 +3,46 @@
 #include "system.h"
 #include "main.h"
 ////////////////////////////////////////////////////////////////////////////////// 	 
-//ʹOS,ͷļ
+//如果使用OS,则包括下面的头文件即可
 #if SYSTEM_SUPPORT_OS
-#include "FreeRTOS.h"					//FreeRTOSʹ		  
+#include "FreeRTOS.h"					//FreeRTOS使用		  
 #include "task.h"
 #include "stm32f4xx_hal.h"
 #include "FreeRTOSConfig.h"  // ?? configTICK_RATE_HZ ??
 #endif
 
 
-static uint32_t fac_us=0;							//usʱ			   
-static uint32_t fac_ms=0;							//msʱ,os,ÿĵms
+static uint32_t fac_us=0;							//us延时倍乘数			   
+static uint32_t fac_ms=0;							//ms延时倍乘数,在os下,代表每个节拍的ms数
 
 static u32 sysTickCnt=0;
 extern void xPortSysTickHandler(void);
  
-//systickжϷ,ʹOSʱõ
+//systick中断服务函数,使用OS时用到
 //void SysTick_Handler(void)
 //{	
-//    if(xTaskGetSchedulerState()!=taskSCHEDULER_NOT_STARTED)//ϵͳѾ
+//    if(xTaskGetSchedulerState()!=taskSCHEDULER_NOT_STARTED)//系统已经运行
 //    {
 //        xPortSysTickHandler();	
 //    }
 //}
 	/********************************************************
 *getSysTickCnt()
-*ȿ֮ǰ  sysTickCnt
-*ȿ֮ǰ  xTaskGetTickCount()
+*调度开启之前 返回 sysTickCnt
+*调度开启之前 返回 xTaskGetTickCount()
 *********************************************************/
 u32 getSysTickCnt(void)
 {
-	if(xTaskGetSchedulerState()!=taskSCHEDULER_NOT_STARTED)	/*ϵͳѾ*/
+	if(xTaskGetSchedulerState()!=taskSCHEDULER_NOT_STARTED)	/*系统已经运行*/
 		return xTaskGetTickCount();
 	else
 		return sysTickCnt;
 }		   
 
-//ʼӳٺ
-//SYSTICKʱӹ̶ΪAHBʱӣSYSTICKʱƵΪAHB/8
-//Ϊ˼FreeRTOSԽSYSTICKʱƵʸΪAHBƵʣ
-//SYSCLK:ϵͳʱƵ
+//初始化延迟函数
+//SYSTICK的时钟固定为AHB时钟，基础例程里面SYSTICK时钟频率为AHB/8
+//这里为了兼容FreeRTOS，所以将SYSTICK的时钟频率改为AHB的频率！
+//SYSCLK:系统时钟频率
 /**
  * @brief  Initialize SysTick for delay and FreeRTOS Tick.
  *         - Set SysTick clock source to AHB (system clock).
@@ -57,7 +57,7 @@ void delay_init(void)
 
     // 2. Calculate fac_us: SysTick ticks per microsecond
     //    SysTick clock = SystemCoreClock (since source is AHB)
-    //    Example: SystemCoreClock=16MHz ? fac_us=16 (16 ticks per s)
+    //    Example: SystemCoreClock=16MHz ? fac_us=16 (16 ticks per 祍)
     fac_us = SystemCoreClock / 1000000UL;  
 
     // 3. Calculate SysTick reload value for FreeRTOS Tick
@@ -70,13 +70,61 @@ void delay_init(void)
     SysTick->VAL  = 0;                       // Clear current count
     SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;  // Enable SysTick interrupt
     SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;   // Start SysTick timer
+
+    // 5. Start the DWT cycle counter used for timestamps and profiling
+    DWT_Init();
+}
+
+/**
+ * @brief  Enable the DWT cycle counter (CYCCNT).
+ * @note   Runs at SystemCoreClock, wraps every ~25 s at 168 MHz.
+ *         使能DWT周期计数器，用于时间戳和耗时统计
+ */
+void DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief  Raw DWT cycle count, for measuring short code sections.
+ */
+u32 getCycleCnt(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief  Free running microsecond timestamp extended from CYCCNT.
+ * @note   Must be called at least once per CYCCNT wrap (~25 s), the
+ *         IMU task does so at its sample rate.
+ *         微秒时间戳，需保证至少每25秒调用一次
+ */
+u32 getMicros(void)
+{
+    static u32 last_cycle = 0, micros = 0, cycle_rem = 0;
+    u32 primask, now, result;
+
+    if (fac_us == 0) return 0;  // delay_init() not called yet
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    now = DWT->CYCCNT;
+    cycle_rem += now - last_cycle;
+    last_cycle = now;
+    micros += cycle_rem / fac_us;
+    cycle_rem %= fac_us;
+    result = micros;
+    __set_PRIMASK(primask);
+    return result;
 }
 						    
 
 /**
  * @brief  Microsecond delay using SysTick counter.
  * @param  nus: Delay time in microseconds.
- * @note   Requires fac_us to be initialized (ticks per s).
+ * @note   Requires fac_us to be initialized (ticks per 祍).
  */
 void delay_us(uint32_t nus)
 {
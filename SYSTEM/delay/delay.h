@@ -7,6 +7,11 @@ void delay_init(void);
 void delay_us(u32 nus);
 void delay_ms(u32 nms);
 void delay_xms(u32 nms);
+void DWT_Init(void);
+u32 getCycleCnt(void);
+u32 getMicros(void);
+//Convert a DWT cycle count to microseconds //DWT周期数转换为微秒
+#define CYCLES_TO_US(c)  ((c)/(SystemCoreClock/1000000UL))
 #endif
 
 
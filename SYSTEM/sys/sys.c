@@ -1,26 +1,26 @@
 #include "sys.h"  
 
 
-//THUMBָֻ֧
-//·ʵִлָWFI  
+//THUMB指令不支持汇编内联
+//采用如下方法实现执行汇编指令WFI  
 __asm void WFI_SET(void)
 {
 	WFI;		  
 }
-//رж(ǲfaultNMIж)
+//关闭所有中断(但是不包括fault和NMI中断)
 __asm void INTX_DISABLE(void)
 {
 	CPSID   I
 	BX      LR	  
 }
-//ж
+//开启所有中断
 __asm void INTX_ENABLE(void)
 {
 	CPSIE   I
 	BX      LR  
 }
-//ջַ
-//addr:ջַ
+//设置栈顶地址
+//addr:栈顶地址
 __asm void MSR_MSP(u32 addr) 
 {
 	MSR MSP, r0 			//set Main Stack value
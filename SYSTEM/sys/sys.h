@@ -3,21 +3,21 @@
 #include "stm32f4xx.h" 
 #include "system.h" 
 
-//0,֧ucos
-//1,֧ucos
-#define SYSTEM_SUPPORT_OS		1		//ϵͳļǷ֧OS
+//0,不支持ucos
+//1,支持ucos
+#define SYSTEM_SUPPORT_OS		1		//定义系统文件夹是否支持OS
  		
 																	    
 #define PI 3.14159265358979f
 																	    
 	 
-//λ,ʵ51ƵGPIOƹ
-//ʵ˼,ο<<CM3Ȩָ>>(87ҳ~92ҳ).M4ͬM3,ֻǼĴַ.
-//IOڲ궨
+//位带操作,实现51类似的GPIO控制功能
+//具体实现思想,参考<<CM3权威指南>>第五章(87页~92页).M4同M3类似,只是寄存器地址变了.
+//IO口操作宏定义
 #define BITBAND(addr, bitnum) ((addr & 0xF0000000)+0x2000000+((addr &0xFFFFF)<<5)+(bitnum<<2)) 
 #define MEM_ADDR(addr)  *((volatile unsigned long  *)(addr)) 
 #define BIT_ADDR(addr, bitnum)   MEM_ADDR(BITBAND(addr, bitnum)) 
-//IOڵַӳ
+//IO口地址映射
 #define GPIOA_ODR_Addr    (GPIOA_BASE+20) //0x40020014
 #define GPIOB_ODR_Addr    (GPIOB_BASE+20) //0x40020414 
 #define GPIOC_ODR_Addr    (GPIOC_BASE+20) //0x40020814 
@@ -38,40 +38,40 @@
 #define GPIOH_IDR_Addr    (GPIOH_BASE+16) //0x40021C10 
 #define GPIOI_IDR_Addr    (GPIOI_BASE+16) //0x40022010 
  
-//IOڲ,ֻԵһIO!
-//ȷnֵС16!
-#define PAout(n)   BIT_ADDR(GPIOA_ODR_Addr,n)  // 
-#define PAin(n)    BIT_ADDR(GPIOA_IDR_Addr,n)  // 
+//IO口操作,只对单一的IO口!
+//确保n的值小于16!
+#define PAout(n)   BIT_ADDR(GPIOA_ODR_Addr,n)  //输出 
+#define PAin(n)    BIT_ADDR(GPIOA_IDR_Addr,n)  //输入 
 
-#define PBout(n)   BIT_ADDR(GPIOB_ODR_Addr,n)  // 
-#define PBin(n)    BIT_ADDR(GPIOB_IDR_Addr,n)  // 
+#define PBout(n)   BIT_ADDR(GPIOB_ODR_Addr,n)  //输出 
+#define PBin(n)    BIT_ADDR(GPIOB_IDR_Addr,n)  //输入 
 
-#define PCout(n)   BIT_ADDR(GPIOC_ODR_Addr,n)  // 
-#define PCin(n)    BIT_ADDR(GPIOC_IDR_Addr,n)  // 
+#define PCout(n)   BIT_ADDR(GPIOC_ODR_Addr,n)  //输出 
+#define PCin(n)    BIT_ADDR(GPIOC_IDR_Addr,n)  //输入 
 
-#define PDout(n)   BIT_ADDR(GPIOD_ODR_Addr,n)  // 
-#define PDin(n)    BIT_ADDR(GPIOD_IDR_Addr,n)  // 
+#define PDout(n)   BIT_ADDR(GPIOD_ODR_Addr,n)  //输出 
+#define PDin(n)    BIT_ADDR(GPIOD_IDR_Addr,n)  //输入 
 
-#define PEout(n)   BIT_ADDR(GPIOE_ODR_Addr,n)  // 
-#define PEin(n)    BIT_ADDR(GPIOE_IDR_Addr,n)  //
+#define PEout(n)   BIT_ADDR(GPIOE_ODR_Addr,n)  //输出 
+#define PEin(n)    BIT_ADDR(GPIOE_IDR_Addr,n)  //输入
 
-#define PFout(n)   BIT_ADDR(GPIOF_ODR_Addr,n)  // 
-#define PFin(n)    BIT_ADDR(GPIOF_IDR_Addr,n)  //
+#define PFout(n)   BIT_ADDR(GPIOF_ODR_Addr,n)  //输出 
+#define PFin(n)    BIT_ADDR(GPIOF_IDR_Addr,n)  //输入
 
-#define PGout(n)   BIT_ADDR(GPIOG_ODR_Addr,n)  // 
-#define PGin(n)    BIT_ADDR(GPIOG_IDR_Addr,n)  //
+#define PGout(n)   BIT_ADDR(GPIOG_ODR_Addr,n)  //输出 
+#define PGin(n)    BIT_ADDR(GPIOG_IDR_Addr,n)  //输入
 
-#define PHout(n)   BIT_ADDR(GPIOH_ODR_Addr,n)  // 
-#define PHin(n)    BIT_ADDR(GPIOH_IDR_Addr,n)  //
+#define PHout(n)   BIT_ADDR(GPIOH_ODR_Addr,n)  //输出 
+#define PHin(n)    BIT_ADDR(GPIOH_IDR_Addr,n)  //输入
 
-#define PIout(n)   BIT_ADDR(GPIOI_ODR_Addr,n)  // 
-#define PIin(n)    BIT_ADDR(GPIOI_IDR_Addr,n)  //
+#define PIout(n)   BIT_ADDR(GPIOI_ODR_Addr,n)  //输出 
+#define PIin(n)    BIT_ADDR(GPIOI_IDR_Addr,n)  //输入
 
-//Ϊຯ
-void WFI_SET(void);		//ִWFIָ
-void INTX_DISABLE(void);//رж
-void INTX_ENABLE(void);	//ж
-void MSR_MSP(u32 addr);	//öջַ 
+//以下为汇编函数
+void WFI_SET(void);		//执行WFI指令
+void INTX_DISABLE(void);//关闭所有中断
+void INTX_ENABLE(void);	//开启所有中断
+void MSR_MSP(u32 addr);	//设置堆栈地址 
 #endif
 
 
@@ -1,91 +1,91 @@
 #include "usart.h"	
 ////////////////////////////////////////////////////////////////////////////////// 	 
-//ʹucos,ͷļ.
+//如果使用ucos,则包括下面的头文件即可.
 #if SYSTEM_SUPPORT_OS
-#include "FreeRTOS.h"					//FreeRTOSʹ	  
+#include "FreeRTOS.h"					//FreeRTOS使用	  
 #endif  
  
 
 //////////////////////////////////////////////////////////////////
-//´,֧printf,Ҫѡuse MicroLIB	  
+//加入以下代码,支持printf函数,而不需要选择use MicroLIB	  
 #if 1
 #pragma import(__use_no_semihosting)             
-//׼Ҫֺ֧                 
+//标准库需要的支持函数                 
 struct __FILE 
 { 
 	int handle; 
 }; 
 
 FILE __stdout;       
-//_sys_exit()Աʹðģʽ    
+//定义_sys_exit()以避免使用半主机模式    
 void _sys_exit(int x) 
 { 
 	x = x; 
 } 
-//ضfputc 
+//重定义fputc函数 
 int fputc(int ch, FILE *f)
 { 	
-	while((USART2->SR&0X40)==0);//ѭ,ֱ   
+	while((USART2->SR&0X40)==0);//循环发送,直到发送完毕   
 	USART2->DR = (u8) ch;      
 	return ch;
 }
 #endif
  
-#if EN_USART1_RX   //ʹ˽
-//1жϷ
-//ע,ȡUSARTx->SRܱĪĴ   	
-u8 USART_RX_BUF[USART_REC_LEN];     //ջ,USART_REC_LENֽ.
-//״̬
-//bit15	ɱ־
-//bit14	յ0x0d
-//bit13~0	յЧֽĿ
-u16 USART_RX_STA=0;       //״̬	
+#if EN_USART1_RX   //如果使能了接收
+//串口1中断服务程序
+//注意,读取USARTx->SR能避免莫名其妙的错误   	
+u8 USART_RX_BUF[USART_REC_LEN];     //接收缓冲,最大USART_REC_LEN个字节.
+//接收状态
+//bit15，	接收完成标志
+//bit14，	接收到0x0d
+//bit13~0，	接收到的有效字节数目
+u16 USART_RX_STA=0;       //接收状态标记	
 
-//ʼIO 1 
-//bound:
+//初始化IO 串口1 
+//bound:波特率
 void uart_init(u32 bound){
-	//GPIO˿
+	//GPIO端口设置
 	GPIO_InitTypeDef GPIO_InitStructure;
 	USART_InitTypeDef USART_InitStructure;
 	NVIC_InitTypeDef NVIC_InitStructure;
 	
-	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOA,ENABLE); //ʹGPIOAʱ
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1,ENABLE);//ʹUSART1ʱ
+	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOA,ENABLE); //使能GPIOA时钟
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1,ENABLE);//使能USART1时钟
  
-	//1ӦŸӳ
-	GPIO_PinAFConfig(GPIOA,GPIO_PinSource9,GPIO_AF_USART1); //GPIOA9ΪUSART1
-	GPIO_PinAFConfig(GPIOA,GPIO_PinSource10,GPIO_AF_USART1); //GPIOA10ΪUSART1
+	//串口1对应引脚复用映射
+	GPIO_PinAFConfig(GPIOA,GPIO_PinSource9,GPIO_AF_USART1); //GPIOA9复用为USART1
+	GPIO_PinAFConfig(GPIOA,GPIO_PinSource10,GPIO_AF_USART1); //GPIOA10复用为USART1
 	
-	//USART1˿
-	GPIO_InitStructure.GPIO_Pin = GPIO_Pin_9 | GPIO_Pin_10; //GPIOA9GPIOA10
-	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;//ù
-	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;	//ٶ50MHz
-	GPIO_InitStructure.GPIO_OType = GPIO_OType_PP; //츴
-	GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP; //
-	GPIO_Init(GPIOA,&GPIO_InitStructure); //ʼPA9PA10
+	//USART1端口配置
+	GPIO_InitStructure.GPIO_Pin = GPIO_Pin_9 | GPIO_Pin_10; //GPIOA9与GPIOA10
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;//复用功能
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;	//速度50MHz
+	GPIO_InitStructure.GPIO_OType = GPIO_OType_PP; //推挽复用输出
+	GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP; //上拉
+	GPIO_Init(GPIOA,&GPIO_InitStructure); //初始化PA9，PA10
 
-   //USART1 ʼ
-	USART_InitStructure.USART_BaudRate = bound;//
-	USART_InitStructure.USART_WordLength = USART_WordLength_8b;//ֳΪ8λݸʽ
-	USART_InitStructure.USART_StopBits = USART_StopBits_1;//һֹͣλ
-	USART_InitStructure.USART_Parity = USART_Parity_No;//żУλ
-	USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;//Ӳ
-	USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;	//շģʽ
-	USART_Init(USART1, &USART_InitStructure); //ʼ1
+   //USART1 初始化设置
+	USART_InitStructure.USART_BaudRate = bound;//波特率设置
+	USART_InitStructure.USART_WordLength = USART_WordLength_8b;//字长为8位数据格式
+	USART_InitStructure.USART_StopBits = USART_StopBits_1;//一个停止位
+	USART_InitStructure.USART_Parity = USART_Parity_No;//无奇偶校验位
+	USART_InitStructure.USART_HardwareFlowControl = USART_HardwareFlowControl_None;//无硬件数据流控制
+	USART_InitStructure.USART_Mode = USART_Mode_Rx | USART_Mode_Tx;	//收发模式
+	USART_Init(USART1, &USART_InitStructure); //初始化串口1
 	
-	USART_Cmd(USART1, ENABLE);  //ʹܴ1 
+	USART_Cmd(USART1, ENABLE);  //使能串口1 
 	
 	//USART_ClearFlag(USART1, USART_FLAG_TC);
 	
 	
-	USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);//ж
+	USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);//开启相关中断
 
-	//Usart1 NVIC 
-	NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQn;//1жͨ
-	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority=3;//ռȼ3
-	NVIC_InitStructure.NVIC_IRQChannelSubPriority =3;		//ȼ3
-	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;			//IRQͨʹ
-	NVIC_Init(&NVIC_InitStructure);	//ָĲʼVICĴ
+	//Usart1 NVIC 配置
+	NVIC_InitStructure.NVIC_IRQChannel = USART1_IRQn;//串口1中断通道
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority=3;//抢占优先级3
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority =3;		//子优先级3
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;			//IRQ通道使能
+	NVIC_Init(&NVIC_InitStructure);	//根据指定的参数初始化VIC寄存器、
 
 
 	